@@ -205,7 +205,13 @@
 
 #define PRINT_ERROR_STATUS(tag, status) printf("\r\n%s %s:%d: 0x%x \r\n", tag, __FILE__, __LINE__, (unsigned int)status)
 
-#ifdef PRINT_DEBUG_LOG
+#ifdef SL_DEBUG_LOG_DEFERRED
+extern void sl_debug_log_deferred(const char *format, ...);
+#define SL_DEBUG_LOG(format, ...)                                                                   \
+  do {                                                                                              \
+    sl_debug_log_deferred("%s:%s:%d:" format "\r\n", __FILE__, __func__, __LINE__, ##__VA_ARGS__); \
+  } while (0)
+#elif defined(PRINT_DEBUG_LOG)
 extern void sl_debug_log(const char *format, ...);
 #define SL_DEBUG_LOG(format, ...)                                                         \
   do {                                                                                    \
@@ -27,6 +27,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <strings.h>
 #include <stdlib.h>
 /******************************************************
  *                      Macros
@@ -63,8 +64,6 @@ typedef struct {
  *               Static Function Declarations
  ******************************************************/
 
-static inline uint8_t parse_enum_arg(const char *line, const char *const *options);
-
 char *string_token(register char *s, register const char *delim, char **lasts);
 sl_status_t console_tokenize(char *start,
                              const char *end,
@@ -95,6 +94,7 @@ uint32_t console_history_end   = 0;
 
 extern const arg_list_t console_argument_types[];
 extern const value_list_t console_argument_values[];
+extern const uint8_t console_argument_counts[];
 
 /******************************************************
  *               Function Definitions
@@ -244,7 +244,26 @@ void console_add_to_history(const char *line, uint8_t line_length)
   console_history_end                         = (console_history_end + 1) % sizeof(console_history_buffer);
 }
 
-// Simple linear database search. This function could be replaced with a more complicated version
+// Returns the index of the first entry whose key is not less than the given key, compared with strcasecmp().
+// Only meaningful for databases flagged with CONSOLE_DATABASE_SORTED. Keys that start with the given key, in any
+// case, directly follow the returned index
+uint32_t console_database_lower_bound(const console_database_t *db, const char *key)
+{
+  uint32_t low  = 0;
+  uint32_t high = db->length;
+
+  while (low < high) {
+    uint32_t mid = low + ((high - low) / 2);
+    if (strcasecmp(db->entries[mid].key, key) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+// Database search. Sorted databases use a binary search, otherwise fall back to a linear scan
 sl_status_t console_find_command(char **string,
                                  const char *string_end,
                                  const console_database_t *db,
@@ -272,15 +291,33 @@ sl_status_t console_find_command(char **string,
 
     size_t token_length = strlen(token);
 
-    for (uint32_t i = 0; i < db->length; i++) {
-      if (strncmp(token, db->entries[i].key, token_length) == 0) {
-        *entry          = &(db->entries[i]);
-        *starting_index = i;
-
-        if (strlen(db->entries[i].key) == token_length) {
+    if (db->flags & CONSOLE_DATABASE_SORTED) {
+      // Commands are case-sensitive, as with the linear scan. Only the keys that match the token ignoring case
+      // are compared, and an exact match sorts before the longer keys it is a prefix of
+      for (uint32_t i = console_database_lower_bound(db, token);
+           (i < db->length) && (strncasecmp(token, db->entries[i].key, token_length) == 0);
+           i++) {
+        if (strncmp(token, db->entries[i].key, token_length) == 0) {
+          *entry          = &(db->entries[i]);
+          *starting_index = i;
+
+          if (db->entries[i].key[token_length] != '\0') {
+            return SL_STATUS_COMMAND_INCOMPLETE;
+          }
           break;
-        } else {
-          return SL_STATUS_COMMAND_INCOMPLETE;
+        }
+      }
+    } else {
+      for (uint32_t i = 0; i < db->length; i++) {
+        if (strncmp(token, db->entries[i].key, token_length) == 0) {
+          *entry          = &(db->entries[i]);
+          *starting_index = i;
+
+          if (strlen(db->entries[i].key) == token_length) {
+            break;
+          } else {
+            return SL_STATUS_COMMAND_INCOMPLETE;
+          }
         }
       }
     }
@@ -314,7 +351,8 @@ sl_status_t console_parse_arg(console_argument_type_t type, char *line, uint32_t
 
   if (type & CONSOLE_ARG_ENUM) {
     uint8_t enum_index  = type & CONSOLE_ARG_ENUM_INDEX_MASK;
-    uint8_t value_index = parse_enum_arg(line, console_argument_types[enum_index]);
+    uint8_t value_index =
+      console_find_enum_option(line, console_argument_types[enum_index], console_argument_counts[enum_index]);
     if (value_index == 0xFF) {
       return SL_STATUS_COMMAND_IS_INVALID;
     }
@@ -366,39 +404,41 @@ sl_status_t console_parse_arg(console_argument_type_t type, char *line, uint32_t
   return SL_STATUS_OK;
 }
 
-static inline uint8_t parse_enum_arg(const char *line, const char *const *options)
+// Binary search of an enum option list sorted in strcmp() order, such as the generated ones.
+// The caller supplies the option count (see console_argument_counts) so the list is never walked
+uint8_t console_find_enum_option(const char *line, const char *const *options, uint8_t count)
 {
-  for (uint8_t a = 0; options[a] != NULL; ++a) {
-    if (strcmp(line, options[a]) == 0) {
-      return a;
+  uint8_t low  = 0;
+  uint8_t high = count;
+  while (low < high) {
+    uint8_t mid = (uint8_t)(low + ((high - low) / 2));
+    int result  = strcmp(line, options[mid]);
+    if (result == 0) {
+      return mid;
+    } else if (result > 0) {
+      low = (uint8_t)(mid + 1);
+    } else {
+      high = mid;
     }
   }
   return 0xFF;
 }
 
-static bool escape(char *i, const char *end)
+static inline bool is_escapable(char c)
 {
-  // Check if next character is one of the escaped ones
-  if (i[1] == '"' || i[1] == '{' || i[1] == '\\') {
-    // Next input matches, so shift array
-    memmove(i, i + 1, (size_t)(end - i));
-    return true;
-  } else {
-    // Unknown sequence
-    return false;
-  }
+  return (c == '"' || c == '{' || c == '\\');
 }
 
+// Single pass tokenizer. Escape sequences are collapsed by copying through a write cursor that trails the read
+// cursor, so the rest of the line is never shifted and each character is visited once
 sl_status_t console_tokenize(char *start,
                              const char *end,
                              char **token,
                              char **token_end,
                              sl_console_tokenize_options_t options)
 {
-  // Get size of string and declare variables
-  //  uint32_t input_size = strlen( input );
-  //  uint32_t i = 0;
-  char *i = start;
+  char *i = start; // Read cursor
+  char *w;         // Write cursor
 
   // Ignore preceding space or null
   while (*i == ' ' || *i == '\0') {
@@ -408,71 +448,83 @@ sl_status_t console_tokenize(char *start,
     }
   }
   *token = i;
-  while (i < end) {
-    if (*i == '{' || *i == '"') {
-      // Start of segment where splitting should not be performed
-      char end_char;
-      if (*i == '{') {
-        end_char = '}';
-        *token   = i;
-      } else {
-        end_char = '"';
-        // Token ignores " character
-        *token = i + 1;
-      }
-      // Verify that preceding character is space or end of string
-      if (i > start && (i[-1] != ' ' && i[-1] != '\0')) {
+
+  if (*i == '{' || *i == '"') {
+    // Start of segment where splitting should not be performed
+    char end_char;
+    if (*i == '{') {
+      end_char = '}';
+      w        = i + 1;
+    } else {
+      end_char = '"';
+      // Token ignores " character
+      *token = i + 1;
+      w      = i + 1;
+    }
+
+    // Loop through input to find end character
+    for (++i; *i != end_char; ++i) {
+      if (i >= end) {
+        // End character not found, return error
         return SL_STATUS_INVALID_PARAMETER;
       }
-
-      // Loop through input to find end character
-      i++;
-      while (*i != end_char) {
-        if (*i == '\\') {
-          // Next character should be escaped
-          if (!escape(i, end)) {
-            // Escape error
-            return SL_STATUS_INVALID_PARAMETER;
-          }
-          --end;
-        }
-        ++i;
-        if (i >= end) {
-          // End character not found, return error
+      if (*i == '\\') {
+        // Next character should be escaped
+        if (!is_escapable(i[1])) {
+          // Escape error
           return SL_STATUS_INVALID_PARAMETER;
         }
+        ++i;
       }
-      // Verify that next character is space or end of string
-      if (i[1] != ' ' && i[1] != '\0' && &i[1] != end) {
-        return SL_STATUS_INVALID_PARAMETER;
-      }
+      *w++ = *i;
+    }
+
+    // Verify that next character is space or end of string
+    if (i[1] != ' ' && i[1] != '\0' && &i[1] != end) {
+      return SL_STATUS_INVALID_PARAMETER;
+    }
+    if (end_char == '"') {
       // Remove " from string end
-      if (end_char == '"') {
-        *i         = '\0';
-        *token_end = i;
-      } else {
-        *token_end = i + 1;
-      }
-      return SL_STATUS_OK;
-    } // Escape symbol encountered
-    else if (*i == '\\') {
-      if (!escape(i, end)) {
+      *w         = '\0';
+      *i         = '\0';
+      *token_end = i;
+    } else {
+      *w++       = '}';
+      *w         = '\0';
+      *token_end = i + 1;
+    }
+    return SL_STATUS_OK;
+  }
+
+  w = i;
+  while (i < end) {
+    if (*i == '{' || *i == '"') {
+      // Segments where splitting should not be performed must start the token
+      return SL_STATUS_INVALID_PARAMETER;
+    } else if (*i == '\\') {
+      // Escape symbol encountered
+      if (!is_escapable(i[1])) {
         // Escape error
         return SL_STATUS_INVALID_PARAMETER;
       }
-      --end;
-
-      // Ordinary splitting
+      ++i;
+      *w++ = *i;
     } else if (((options & SL_CONSOLE_TOKENIZE_ON_SPACE) && *i == ' ')
                || ((options & SL_CONSOLE_TOKENIZE_ON_DOT) && *i == '.')) {
-      // Turn space into '\0' to indicate end of string
+      // Ordinary splitting. Turn the delimiter into '\0' to indicate end of string
+      *w         = '\0';
       *i         = '\0';
       *token_end = i;
       return SL_STATUS_OK;
+    } else {
+      *w++ = *i;
     }
     ++i;
   }
 
+  if (w != i) {
+    *w = '\0';
+  }
   *token_end = i;
   return SL_STATUS_OK;
 }
@@ -51,6 +51,8 @@ sl_status_t console_find_command(char **string,
                                  const console_database_t *db,
                                  const console_database_entry_t **entry,
                                  uint32_t *starting_index);
+uint32_t console_database_lower_bound(const console_database_t *db, const char *key);
+uint8_t console_find_enum_option(const char *line, const char *const *options, uint8_t count);
 
 sl_status_t console_parse_arg(console_argument_type_t type, char *line, uint32_t *arg_result);
 void console_add_to_history(const char *line, uint8_t line_length);
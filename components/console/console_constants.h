@@ -37,6 +37,10 @@ extern "C" {
   .length  = sizeof((console_database_entry_t[]){ __VA_ARGS__ }) / sizeof(console_database_entry_t), \
   .entries = { __VA_ARGS__ }
 
+// Same as CONSOLE_DATABASE_ENTRIES but marks the entries as sorted by strcasecmp() so lookups use binary search.
+// The AT command parser matches keys case-insensitively, console_find_command() keeps matching them case-sensitively
+#define CONSOLE_SORTED_DATABASE_ENTRIES(...) .flags = CONSOLE_DATABASE_SORTED, CONSOLE_DATABASE_ENTRIES(__VA_ARGS__)
+
 #define CONSOLE_VARIABLE(name_string, var, ...)                   \
   {                                                               \
     .name = name_string, .variable = var, .type = { __VA_ARGS__ } \
@@ -165,6 +169,10 @@ typedef enum {
   SL_CONSOLE_VARIABLE_SET,
 } console_variable_action_t;
 
+typedef enum {
+  CONSOLE_DATABASE_SORTED = (1 << 0), // Entries are ordered by strcasecmp() on the key
+} console_database_flags_t;
+
 typedef enum {
   SL_CONSOLE_TOKENIZE_ON_SPACE = (1 << 0),
   SL_CONSOLE_TOKENIZE_ON_DOT   = (1 << 1),
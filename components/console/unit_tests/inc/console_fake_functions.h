@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#pragma once
+#include "fff.h"
+#include "sl_status.h"
+#include "sl_utility.h"
+#include "console.h"
+
+// Enum argument types of the test console, option lists are in strcmp() order
+#define TEST_MODE_TYPE      0 // Mapped to console_argument_values
+#define TEST_DIRECTION_TYPE 1 // No values, the option index is the value
+
+// Not exported by console.h, the command parser is its only caller
+sl_status_t console_tokenize(char *start,
+                             const char *end,
+                             char **token,
+                             char **token_end,
+                             sl_console_tokenize_options_t options);
+
+DECLARE_FAKE_VALUE_FUNC1(size_t, sl_strlen, char *);
+DECLARE_FAKE_VALUE_FUNC2(sl_status_t, convert_string_to_mac_address, const char *, sl_mac_address_t *);
+DECLARE_FAKE_VALUE_FUNC2(sl_status_t, convert_string_to_sl_ipv4_address, char *, sl_ipv4_address_t *);
+
+// Same commands, in the order the generator emits them and in a hand written order
+extern const console_database_t sorted_test_database;
+extern const console_database_t unsorted_test_database;
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include "console_fake_functions.h"
+
+DEFINE_FFF_GLOBALS;
+
+DEFINE_FAKE_VALUE_FUNC1(size_t, sl_strlen, char *);
+DEFINE_FAKE_VALUE_FUNC2(sl_status_t, convert_string_to_mac_address, const char *, sl_mac_address_t *);
+DEFINE_FAKE_VALUE_FUNC2(sl_status_t, convert_string_to_sl_ipv4_address, char *, sl_ipv4_address_t *);
+
+static const console_descriptive_command_t test_command = { .description   = "test command",
+                                                            .argument_help = NULL,
+                                                            .handler       = NULL,
+                                                            .argument_list = { CONSOLE_ARG_END } };
+
+// Keys are ordered by strcasecmp(), the way the generator sorts them
+const console_database_t sorted_test_database = { CONSOLE_SORTED_DATABASE_ENTRIES({ "ap", &test_command },
+                                                                                  { "Scan", &test_command },
+                                                                                  { "scan", &test_command },
+                                                                                  { "scan_results", &test_command },
+                                                                                  { "wifi", &test_command }) };
+
+// The linear scan stops at the first key the token starts, so a command precedes the longer ones it starts
+const console_database_t unsorted_test_database = { CONSOLE_DATABASE_ENTRIES({ "wifi", &test_command },
+                                                                             { "scan", &test_command },
+                                                                             { "scan_results", &test_command },
+                                                                             { "ap", &test_command },
+                                                                             { "Scan", &test_command }) };
+
+static const char *test_mode_type[]      = { "Client", "ap", "client", "eap", NULL };
+static const char *test_direction_type[] = { "rx", "tx", NULL };
+
+const arg_list_t console_argument_types[] = {
+  [TEST_MODE_TYPE]      = test_mode_type,
+  [TEST_DIRECTION_TYPE] = test_direction_type,
+};
+
+const value_list_t console_argument_values[] = {
+  [TEST_MODE_TYPE]      = (const uint32_t[]){ 10, 20, 30, 40 },
+  [TEST_DIRECTION_TYPE] = NULL,
+};
+
+const uint8_t console_argument_counts[] = {
+  [TEST_MODE_TYPE]      = 4,
+  [TEST_DIRECTION_TYPE] = 2,
+};
@@ -0,0 +1,242 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "fff.h"
+
+extern "C" {
+#include "console_fake_functions.h"
+}
+
+class console_test : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    FFF_RESET_HISTORY();
+    RESET_FAKE(sl_strlen);
+    RESET_FAKE(convert_string_to_mac_address);
+    RESET_FAKE(convert_string_to_sl_ipv4_address);
+  }
+
+  // Looks a command line up, returns the key of the matched entry in key
+  static sl_status_t find_command(const console_database_t *db, const char *command, std::string *key)
+  {
+    std::vector<char> line(command, command + strlen(command) + 1);
+    char *string                          = line.data();
+    const console_database_entry_t *entry = NULL;
+    uint32_t index                        = 0;
+
+    sl_status_t status = console_find_command(&string, line.data() + strlen(command), db, &entry, &index);
+    key->assign((entry != NULL) ? entry->key : "");
+    return status;
+  }
+
+  static sl_status_t parse_enum(uint8_t enum_type, const char *option, uint32_t *value)
+  {
+    std::vector<char> line(option, option + strlen(option) + 1);
+    return console_parse_arg((console_argument_type_t)(CONSOLE_ARG_ENUM | enum_type), line.data(), value);
+  }
+
+  // Splits a line the way console_parse_command() does, returns the status that ended the split. The line is
+  // copied into a buffer that ends with its terminator, so a read past the end trips the address sanitizer.
+  static sl_status_t tokenize(const char *text, std::vector<std::string> *tokens)
+  {
+    std::vector<char> line(text, text + strlen(text) + 1);
+    char *command_line = line.data();
+    const char *end    = line.data() + strlen(text);
+    char *token;
+    sl_status_t status;
+
+    tokens->clear();
+    while ((status = console_tokenize(command_line, end, &token, &command_line, SL_CONSOLE_TOKENIZE_ON_SPACE))
+           == SL_STATUS_OK) {
+      tokens->push_back(token);
+    }
+    return status;
+  }
+};
+
+// Test case: The lower bound of a sorted database is the first key not below the given one, ignoring case
+TEST_F(console_test, LowerBoundIgnoresCase)
+{
+  EXPECT_EQ(0u, console_database_lower_bound(&sorted_test_database, "a"));
+  EXPECT_EQ(0u, console_database_lower_bound(&sorted_test_database, "AP"));
+  EXPECT_EQ(1u, console_database_lower_bound(&sorted_test_database, "b"));
+  EXPECT_EQ(1u, console_database_lower_bound(&sorted_test_database, "SCAN"));
+  EXPECT_EQ(3u, console_database_lower_bound(&sorted_test_database, "scan_"));
+  EXPECT_EQ(4u, console_database_lower_bound(&sorted_test_database, "wifi"));
+  EXPECT_EQ(5u, console_database_lower_bound(&sorted_test_database, "zz"));
+}
+
+// Test case: Commands of a sorted database are matched case-sensitively, like the linear scan
+TEST_F(console_test, SortedLookupIsCaseSensitive)
+{
+  std::string key;
+
+  EXPECT_EQ(SL_STATUS_OK, find_command(&sorted_test_database, "scan", &key));
+  EXPECT_EQ("scan", key);
+  EXPECT_EQ(SL_STATUS_OK, find_command(&sorted_test_database, "Scan", &key));
+  EXPECT_EQ("Scan", key);
+  EXPECT_EQ(SL_STATUS_FAIL, find_command(&sorted_test_database, "SCAN", &key));
+  EXPECT_EQ(SL_STATUS_FAIL, find_command(&sorted_test_database, "AP", &key));
+  EXPECT_EQ(SL_STATUS_FAIL, find_command(&sorted_test_database, "Wifi", &key));
+}
+
+// Test case: A token that only starts a command reports the command as incomplete
+TEST_F(console_test, SortedLookupReportsIncompleteCommands)
+{
+  std::string key;
+
+  EXPECT_EQ(SL_STATUS_COMMAND_INCOMPLETE, find_command(&sorted_test_database, "a", &key));
+  EXPECT_EQ("ap", key);
+  EXPECT_EQ(SL_STATUS_COMMAND_INCOMPLETE, find_command(&sorted_test_database, "sc", &key));
+  EXPECT_EQ("scan", key);
+  EXPECT_EQ(SL_STATUS_COMMAND_INCOMPLETE, find_command(&sorted_test_database, "scan_", &key));
+  EXPECT_EQ("scan_results", key);
+  EXPECT_EQ(SL_STATUS_FAIL, find_command(&sorted_test_database, "zz", &key));
+  EXPECT_EQ(SL_STATUS_FAIL, find_command(&sorted_test_database, "scan_resultsx", &key));
+}
+
+// Test case: A sorted database finds the same commands as the linear scan of an unsorted one
+TEST_F(console_test, SortedLookupMatchesLinearScan)
+{
+  const char *commands[] = { "ap", "Scan", "scan", "scan_results", "wifi", "SCAN", "Ap", "wifi2", "x", "sc", "w" };
+
+  for (const char *command : commands) {
+    std::string sorted_key;
+    std::string unsorted_key;
+    sl_status_t sorted_status   = find_command(&sorted_test_database, command, &sorted_key);
+    sl_status_t unsorted_status = find_command(&unsorted_test_database, command, &unsorted_key);
+
+    EXPECT_EQ(unsorted_status, sorted_status) << command;
+    if (unsorted_status == SL_STATUS_OK) {
+      EXPECT_EQ(unsorted_key, sorted_key) << command;
+    }
+  }
+}
+
+// Test case: Enum options are found by binary search over the strcmp() ordered list
+TEST_F(console_test, FindEnumOptionSearchesSortedList)
+{
+  const char *const options[] = { "Client", "ap", "client", "eap", NULL };
+
+  EXPECT_EQ(0, console_find_enum_option("Client", options, 4));
+  EXPECT_EQ(1, console_find_enum_option("ap", options, 4));
+  EXPECT_EQ(2, console_find_enum_option("client", options, 4));
+  EXPECT_EQ(3, console_find_enum_option("eap", options, 4));
+  EXPECT_EQ(0xFF, console_find_enum_option("CLIENT", options, 4));
+  EXPECT_EQ(0xFF, console_find_enum_option("a", options, 4));
+  EXPECT_EQ(0xFF, console_find_enum_option("zz", options, 4));
+  EXPECT_EQ(0xFF, console_find_enum_option("ap", options, 0));
+}
+
+// Test case: Enum arguments resolve to their mapped value, or to the option index when the type has no values
+TEST_F(console_test, ParseArgUsesEnumOptionLookup)
+{
+  uint32_t value = 0;
+
+  EXPECT_EQ(SL_STATUS_OK, parse_enum(TEST_MODE_TYPE, "client", &value));
+  EXPECT_EQ(30u, value);
+  EXPECT_EQ(SL_STATUS_OK, parse_enum(TEST_MODE_TYPE, "Client", &value));
+  EXPECT_EQ(10u, value);
+  EXPECT_EQ(SL_STATUS_OK, parse_enum(TEST_DIRECTION_TYPE, "tx", &value));
+  EXPECT_EQ(1u, value);
+  EXPECT_EQ(SL_STATUS_COMMAND_IS_INVALID, parse_enum(TEST_MODE_TYPE, "CLIENT", &value));
+  EXPECT_EQ(SL_STATUS_COMMAND_IS_INVALID, parse_enum(TEST_DIRECTION_TYPE, "echo", &value));
+}
+
+// Test case: Tokens are split on spaces, repeated spaces are skipped and the end of the line ends the split
+TEST_F(console_test, TokenizeSplitsOnSpace)
+{
+  std::vector<std::string> tokens;
+
+  EXPECT_EQ(SL_STATUS_FAIL, tokenize("  scan   -c 6 ssid", &tokens));
+  EXPECT_EQ((std::vector<std::string>{ "scan", "-c", "6", "ssid" }), tokens);
+  EXPECT_EQ(SL_STATUS_FAIL, tokenize("", &tokens));
+  EXPECT_TRUE(tokens.empty());
+  EXPECT_EQ(SL_STATUS_FAIL, tokenize("   ", &tokens));
+  EXPECT_TRUE(tokens.empty());
+}
+
+// Test case: Quoted and brace arguments keep their spaces, quotes are dropped and braces are kept
+TEST_F(console_test, TokenizeKeepsQuotedArguments)
+{
+  std::vector<std::string> tokens;
+
+  EXPECT_EQ(SL_STATUS_FAIL, tokenize("join \"my network\" {\"a\": 1} pass", &tokens));
+  EXPECT_EQ((std::vector<std::string>{ "join", "my network", "{\"a\": 1}", "pass" }), tokens);
+  EXPECT_EQ(SL_STATUS_FAIL, tokenize("\"\" x", &tokens));
+  EXPECT_EQ((std::vector<std::string>{ "", "x" }), tokens);
+}
+
+// Test case: Escapes are collapsed in place and leave the following tokens intact
+TEST_F(console_test, TokenizeCollapsesEscapes)
+{
+  std::vector<std::string> tokens;
+
+  EXPECT_EQ(SL_STATUS_FAIL, tokenize("a\\\"b\\\\c next", &tokens));
+  EXPECT_EQ((std::vector<std::string>{ "a\"b\\c", "next" }), tokens);
+  EXPECT_EQ(SL_STATUS_FAIL, tokenize("\"say \\\"hi\\\"\" {x\\{y} \\\"\\\"\\\"", &tokens));
+  EXPECT_EQ((std::vector<std::string>{ "say \"hi\"", "{x{y}", "\"\"\"" }), tokens);
+}
+
+// Test case: Unterminated segments, unknown escapes and misplaced quotes are rejected without reading past the line
+TEST_F(console_test, TokenizeRejectsMalformedLines)
+{
+  std::vector<std::string> tokens;
+
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER, tokenize("\"abc", &tokens));
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER, tokenize("{abc", &tokens));
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER, tokenize("\"abc\\", &tokens));
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER, tokenize("abc\\", &tokens));
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER, tokenize("a\\nb", &tokens));
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER, tokenize("ab\"c\"", &tokens));
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER, tokenize("\"ab\"c", &tokens));
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER, tokenize("ok \"bad", &tokens));
+  EXPECT_EQ((std::vector<std::string>{ "ok" }), tokens);
+}
+
+// Test case: A line with the largest number of arguments a command takes is split into every token
+TEST_F(console_test, TokenizeMaximumArgumentCount)
+{
+  std::vector<std::string> expected;
+  std::vector<std::string> tokens;
+  std::string line = "command";
+
+  expected.push_back("command");
+  for (int n = 0; n < SL_SI91X_CLI_CONSOLE_MAX_ARG_COUNT; n++) {
+    expected.push_back((n % 2) ? "\"arg " + std::to_string(n) + "\"" : "arg\\\"" + std::to_string(n));
+    line += " " + ((n % 2) ? "\"\\\"arg " + std::to_string(n) + "\\\"\"" : "arg\\\\\\\"" + std::to_string(n));
+  }
+
+  EXPECT_EQ(SL_STATUS_FAIL, tokenize(line.c_str(), &tokens));
+  EXPECT_EQ(expected, tokens);
+}
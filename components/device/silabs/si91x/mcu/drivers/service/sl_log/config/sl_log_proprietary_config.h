@@ -91,6 +91,51 @@ extern "C" {
  */
 #define SL_LOG_CONFIG_MODE SL_LOG_CONFIG_MODE_HOST
 
+// <o SL_LOG_BACKEND_BATCH_SIZE> Backend batch size (bytes) <64-4096>
+/**
+ * @brief Maximum number of bytes handed to the transport in one send.
+ *
+ * The backend splits a drain into batches of whole events no larger than
+ * this, which keeps each transfer within a single DMA descriptor.
+ *
+ * @note Default: 1024
+ */
+#ifndef SL_LOG_BACKEND_BATCH_SIZE
+#define SL_LOG_BACKEND_BATCH_SIZE 1024
+#endif
+
+// <o SL_LOG_BACKEND_DRAIN_INTERVAL_MAX_MS> Drain interval when idle (ms) <1-10000>
+/**
+ * @brief Drain interval suggested while the ring buffer is empty.
+ *
+ * @note Default: 100
+ */
+#ifndef SL_LOG_BACKEND_DRAIN_INTERVAL_MAX_MS
+#define SL_LOG_BACKEND_DRAIN_INTERVAL_MAX_MS 100
+#endif
+
+// <o SL_LOG_BACKEND_DRAIN_INTERVAL_MIN_MS> Drain interval under load (ms) <0-1000>
+/**
+ * @brief Drain interval suggested once the fill level reaches the threshold.
+ *
+ * @note Default: 1
+ */
+#ifndef SL_LOG_BACKEND_DRAIN_INTERVAL_MIN_MS
+#define SL_LOG_BACKEND_DRAIN_INTERVAL_MIN_MS 1
+#endif
+
+// <o SL_LOG_BACKEND_DRAIN_THRESHOLD_PERCENT> Fill level for fastest draining (%) <1-100>
+/**
+ * @brief Ring buffer fill level at which the minimum drain interval is used.
+ *
+ * Below this level the interval shrinks linearly from the idle interval.
+ *
+ * @note Default: 50
+ */
+#ifndef SL_LOG_BACKEND_DRAIN_THRESHOLD_PERCENT
+#define SL_LOG_BACKEND_DRAIN_THRESHOLD_PERCENT 50
+#endif
+
 /** @} (end addtogroup sl_log_uc_proprietary_config) */
 
 /** @} (end addtogroup sl_log_proprietary_config) */
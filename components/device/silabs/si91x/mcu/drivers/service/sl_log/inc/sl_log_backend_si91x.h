@@ -0,0 +1,121 @@
+/***************************************************************************/ /**
+* @file sl_log_backend_si91x.h
+* @brief SL Log backend statistics and drain pacing for si91x
+*******************************************************************************
+* # License
+* <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+*******************************************************************************
+*
+* SPDX-License-Identifier: Zlib
+*
+* The licensor of this software is Silicon Laboratories Inc.
+*
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+******************************************************************************/
+
+#ifndef SL_LOG_BACKEND_SI91X_H
+#define SL_LOG_BACKEND_SI91X_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @addtogroup sl_log_backend_si91x SL Log Backend Statistics
+ * @brief Counters and drain pacing for the si91x logging backend
+ * @{
+ */
+
+/**
+ * @brief Backend statistics.
+ *
+ * All counters are cumulative since boot or the last call to
+ * sl_log_backend_si91x_reset_statistics().
+ */
+typedef struct {
+  uint32_t events_written; ///< Events handed to the transport successfully
+  uint32_t batches;        ///< Physical sends issued to the transport
+  uint32_t write_errors;   ///< Sends that failed; the events of a failed send are not counted as written
+  uint32_t dropped_events; ///< Events rejected because the ring buffer was full
+  uint32_t high_water;     ///< Largest number of events held by the ring buffer after a write
+} sl_log_backend_si91x_statistics_t;
+
+/**
+ * @brief Copy the current backend statistics.
+ *
+ * @param[out] statistics Destination for the counters
+ */
+void sl_log_backend_si91x_get_statistics(sl_log_backend_si91x_statistics_t *statistics);
+
+/**
+ * @brief Clear all backend statistics.
+ */
+void sl_log_backend_si91x_reset_statistics(void);
+
+/**
+ * @brief Account for events that could not be written to the ring buffer.
+ *
+ * Safe to call from interrupt context.
+ *
+ * @param[in] count Number of events dropped
+ */
+void sl_log_backend_si91x_record_dropped(uint32_t count);
+
+/**
+ * @brief Suggest the delay before the next drain for a given backlog.
+ *
+ * The interval shrinks linearly from SL_LOG_BACKEND_DRAIN_INTERVAL_MAX_MS for
+ * an empty ring buffer to SL_LOG_BACKEND_DRAIN_INTERVAL_MIN_MS once
+ * SL_LOG_BACKEND_DRAIN_THRESHOLD_PERCENT of the buffer is in use, so a quiet
+ * system drains in large batches and a busy one drains before it overflows.
+ *
+ * @param[in] pending_events Events currently waiting in the ring buffer
+ * @return Delay in milliseconds
+ */
+uint32_t sl_log_backend_si91x_get_drain_interval(uint32_t pending_events);
+
+/**
+ * @brief Flush the ring buffer and return the delay before the next flush.
+ *
+ * Intended as the body of a low-priority drain loop:
+ * @code
+ * for (;;) {
+ *   osDelay(sl_log_backend_si91x_drain());
+ * }
+ * @endcode
+ * The delay is sl_log_backend_si91x_get_drain_interval() applied to the
+ * backlog this flush found, so the loop speeds up as the producers do. It
+ * grows back towards the idle interval by at most doubling per call.
+ *
+ * @return Delay in milliseconds before the next call
+ */
+uint32_t sl_log_backend_si91x_drain(void);
+
+/** @} (end addtogroup sl_log_backend_si91x) */
+
+// Internal hooks used by the ring buffer and the backend to update the counters
+void sli_log_backend_si91x_record_batch(uint32_t events, bool success);
+void sli_log_backend_si91x_record_fill_level(uint32_t pending_events);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_LOG_BACKEND_SI91X_H
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * @file sl_log_backend_statistics.c
+ * @brief Backend statistics and drain pacing for the logging subsystem (SI91x)
+ *
+ * Counters are updated from the ring buffer write path, which may run in
+ * interrupt context, and from the single backend consumer. They are kept
+ * lock-free with atomic read-modify-write operations so neither path has to
+ * extend its critical section.
+ */
+
+#include "sl_log_backend_si91x.h"
+#include "sl_log.h"
+#include "sl_log_platform_specific.h"
+#include "sl_log_proprietary_config.h"
+#include <stddef.h>
+
+/*******************************************************************************
+ *                               GLOBAL VARIABLES
+ ******************************************************************************/
+static sl_log_backend_si91x_statistics_t sl_log_backend_statistics;
+static uint32_t sl_log_backend_drain_interval; // Interval returned by the previous sl_log_backend_si91x_drain()
+
+/**
+ * @brief Account for events handed to the transport by the backend.
+ *
+ * @param[in] events  Number of events in the send
+ * @param[in] success true if the transport accepted the send
+ */
+void sli_log_backend_si91x_record_batch(uint32_t events, bool success)
+{
+  __atomic_fetch_add(&sl_log_backend_statistics.batches, 1, __ATOMIC_RELAXED);
+  if (success) {
+    __atomic_fetch_add(&sl_log_backend_statistics.events_written, events, __ATOMIC_RELAXED);
+  } else {
+    __atomic_fetch_add(&sl_log_backend_statistics.write_errors, 1, __ATOMIC_RELAXED);
+  }
+}
+
+/**
+ * @brief Track the largest number of events held by the ring buffer.
+ *
+ * @param[in] pending_events Events currently held by the ring buffer
+ */
+void sli_log_backend_si91x_record_fill_level(uint32_t pending_events)
+{
+  uint32_t high_water = __atomic_load_n(&sl_log_backend_statistics.high_water, __ATOMIC_RELAXED);
+
+  while ((pending_events > high_water)
+         && !__atomic_compare_exchange_n(&sl_log_backend_statistics.high_water,
+                                         &high_water,
+                                         pending_events,
+                                         true,
+                                         __ATOMIC_RELAXED,
+                                         __ATOMIC_RELAXED)) {
+  }
+}
+
+void sl_log_backend_si91x_record_dropped(uint32_t count)
+{
+  __atomic_fetch_add(&sl_log_backend_statistics.dropped_events, count, __ATOMIC_RELAXED);
+}
+
+void sl_log_backend_si91x_get_statistics(sl_log_backend_si91x_statistics_t *statistics)
+{
+  if (statistics == NULL) {
+    return;
+  }
+  statistics->events_written = __atomic_load_n(&sl_log_backend_statistics.events_written, __ATOMIC_RELAXED);
+  statistics->batches        = __atomic_load_n(&sl_log_backend_statistics.batches, __ATOMIC_RELAXED);
+  statistics->write_errors   = __atomic_load_n(&sl_log_backend_statistics.write_errors, __ATOMIC_RELAXED);
+  statistics->dropped_events = __atomic_load_n(&sl_log_backend_statistics.dropped_events, __ATOMIC_RELAXED);
+  statistics->high_water     = __atomic_load_n(&sl_log_backend_statistics.high_water, __ATOMIC_RELAXED);
+}
+
+void sl_log_backend_si91x_reset_statistics(void)
+{
+  __atomic_store_n(&sl_log_backend_statistics.events_written, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&sl_log_backend_statistics.batches, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&sl_log_backend_statistics.write_errors, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&sl_log_backend_statistics.dropped_events, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&sl_log_backend_statistics.high_water, 0, __ATOMIC_RELAXED);
+}
+
+uint32_t sl_log_backend_si91x_get_drain_interval(uint32_t pending_events)
+{
+  const uint32_t threshold = ((uint32_t)SL_LOG_NUMBER_OF_EVENTS * SL_LOG_BACKEND_DRAIN_THRESHOLD_PERCENT) / 100;
+
+  if ((threshold == 0) || (pending_events >= threshold)) {
+    return SL_LOG_BACKEND_DRAIN_INTERVAL_MIN_MS;
+  }
+  return SL_LOG_BACKEND_DRAIN_INTERVAL_MAX_MS
+         - (((SL_LOG_BACKEND_DRAIN_INTERVAL_MAX_MS - SL_LOG_BACKEND_DRAIN_INTERVAL_MIN_MS) * pending_events) / threshold);
+}
+
+uint32_t sl_log_backend_si91x_drain(void)
+{
+  // Pace on the backlog that built up since the previous drain, which follows the producers' rate.
+  // The backlog left after the flush is near zero and would always select the idle interval
+  uint32_t pending_events = sl_log_get_ring_buffer_config()->event_count;
+  uint32_t interval       = sl_log_backend_si91x_get_drain_interval(pending_events);
+
+  // Shorten at once but lengthen by at most doubling, so a drain that happened to find little backlog
+  // right after a fast one does not jump back to the idle interval while the producers are still busy
+  uint32_t limit = (sl_log_backend_drain_interval > 0) ? (2 * sl_log_backend_drain_interval) : 1;
+  if (interval > limit) {
+    interval = limit;
+  }
+  sl_log_backend_drain_interval = interval;
+
+  sl_log_flush();
+  return interval;
+}
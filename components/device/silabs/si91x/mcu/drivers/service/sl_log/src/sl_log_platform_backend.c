@@ -13,8 +13,14 @@
 
 #include "sl_log_platform_specific.h"
 #include "sl_log.h"
+#include "sl_log_backend_si91x.h"
+#include "sl_log_proprietary_config.h"
 #include "sl_si91x_usart.h"
 
+// Whole events that fit in one transport send
+#define SL_LOG_BACKEND_BATCH_EVENTS \
+  ((SL_LOG_BACKEND_BATCH_SIZE >= sizeof(sl_log_event_t)) ? (SL_LOG_BACKEND_BATCH_SIZE / sizeof(sl_log_event_t)) : 1)
+
 /*******************************************************************************
  *                               GLOBAL VARIABLES
  ******************************************************************************/
@@ -113,11 +119,38 @@ sl_status_t sl_log_hal_backend_init(void)
   return status;
 }
 
+/**
+ * @brief Sends a contiguous run of events in batches of at most
+ *        SL_LOG_BACKEND_BATCH_EVENTS, updating the backend statistics.
+ *
+ * @param[in] events Pointer to the first event
+ * @param[in] count  Number of events in the run
+ *
+ * @return SL_STATUS_OK on success or the status of the first failed send.
+ */
+static sl_status_t sl_log_hal_backend_send_run(const sl_log_event_t *events, uint32_t count)
+{
+  sl_status_t status = SL_STATUS_OK;
+
+  while (count > 0) {
+    uint32_t batch = (count < SL_LOG_BACKEND_BATCH_EVENTS) ? count : SL_LOG_BACKEND_BATCH_EVENTS;
+    status         = sli_si91x_usart_send_data_blocking(uart_handle, events, batch * sizeof(sl_log_event_t));
+    sli_log_backend_si91x_record_batch(batch, status == SL_STATUS_OK);
+    if (status != SL_STATUS_OK) {
+      return status;
+    }
+    events += batch;
+    count -= batch;
+  }
+  return status;
+}
+
 /**
  * @brief Writes log events from the circular buffer to the backend transport.
  *
  * Sends up to @p event_count events starting at @p read_index. Handles
- * wrap-around by performing up to two physical send operations.
+ * wrap-around by splitting the drain into the run up to the end of the buffer
+ * and the run from its start; each run goes out in DMA-sized batches.
  *
  * @param[in] buffer      Pointer to the circular buffer containing events
  * @param[in] read_index  Index (0..SL_LOG_NUMBER_OF_EVENTS-1) of first event
@@ -141,20 +174,17 @@ sl_status_t sl_log_hal_backend_write(sl_log_event_t *buffer, uint32_t read_index
 
   if (event_count <= SL_LOG_NUMBER_OF_EVENTS - read_index) {
     /* contiguous block */
-    status = sli_si91x_usart_send_data_blocking(uart_handle, &buffer[read_index], event_count * sizeof(sl_log_event_t));
-    return status;
-  } else {
-    /* first chunk: from read_index to end */
-    uint32_t first_chunk = SL_LOG_NUMBER_OF_EVENTS - read_index;
-    status = sli_si91x_usart_send_data_blocking(uart_handle, &buffer[read_index], first_chunk * sizeof(sl_log_event_t));
-    if (status != SL_STATUS_OK) {
-      return status;
-    }
-    /* remaining events after wrap-around */
-    uint32_t second_chunk = event_count - first_chunk; /* equals event_count + read_index - SL_LOG_NUMBER_OF_EVENTS */
-    status = sli_si91x_usart_send_data_blocking(uart_handle, buffer, second_chunk * sizeof(sl_log_event_t));
+    return sl_log_hal_backend_send_run(&buffer[read_index], event_count);
+  }
+
+  /* first chunk: from read_index to end */
+  uint32_t first_chunk = SL_LOG_NUMBER_OF_EVENTS - read_index;
+  status               = sl_log_hal_backend_send_run(&buffer[read_index], first_chunk);
+  if (status != SL_STATUS_OK) {
     return status;
   }
+  /* remaining events after wrap-around */
+  return sl_log_hal_backend_send_run(buffer, event_count - first_chunk);
 }
 
 /**
@@ -10,6 +10,7 @@
 
 #include "sl_log_platform_specific.h"
 #include "sl_log_helper.h"
+#include "sl_log_backend_si91x.h"
 #include "sl_si91x_ulp_timer.h"
 #define SL_SI91X_HOST_CORE_ID     0       // Host core identifier
 #define SL_SI91X_LOG_TIMER_FREQ   1000000 // 1 MHz timer frequency for microsecond resolution
@@ -533,6 +534,7 @@ sl_status_t sl_log_write_multiple_to_ring_buffer(const sl_log_event_t *events, u
   // If backend busy and we went negative, reject
   if ((new_available < 0) && (sl_log_backend_status.backend_transfer_done == 0)) {
     __enable_irq();
+    sl_log_backend_si91x_record_dropped(count);
     return SL_STATUS_NOT_AVAILABLE;
   }
 
@@ -581,5 +583,10 @@ sl_status_t sl_log_write_multiple_to_ring_buffer(const sl_log_event_t *events, u
 
   __enable_irq();
 
+  if (overwritten > 0) {
+    sl_log_backend_si91x_record_dropped(overwritten);
+  }
+  sli_log_backend_si91x_record_fill_level(new_count);
+
   return SL_STATUS_OK;
 }
\ No newline at end of file
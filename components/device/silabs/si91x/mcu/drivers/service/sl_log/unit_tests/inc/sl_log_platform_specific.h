@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * @file
+ * @brief 
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// Host stand-in for the GSDK logging core header; only what the si91x backend and platform code use
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include "sl_status.h"
+
+#ifndef SL_LOG_NUMBER_OF_EVENTS
+#define SL_LOG_NUMBER_OF_EVENTS 512
+#endif
+
+typedef struct {
+  uint32_t header;
+  uint32_t timestamp;
+  uint32_t arg1;
+  uint32_t arg2;
+} sl_log_event_t;
+
+typedef struct {
+  sl_status_t (*backend_init)(void);
+  sl_status_t (*backend_write)(sl_log_event_t *buffer, uint32_t read_index, uint32_t event_count);
+  sl_status_t (*backend_deinit)(void);
+} sl_log_api_backend_t;
+
+sl_log_api_backend_t *sl_log_get_api_backend(void);
+
+typedef struct {
+  sl_status_t (*platform_core_init)(void);
+  sl_status_t (*platform_core_deinit)(void);
+  uint32_t (*get_timestamp)(uint8_t core_id);
+  uint32_t (*get_timestamp_timer_frequency)(uint8_t core_id);
+  sl_status_t (*post_sleep_process)(void *config);
+  sl_status_t (*pre_sleep_process)(void *config);
+  sl_status_t (*set_configuration)(void *args, uint8_t core_id);
+  sl_status_t (*get_configuration)(void *args, uint8_t core_id);
+  sl_status_t (*time_sync)(void *args, uint8_t core_id);
+} sl_log_api_core_t;
+
+typedef struct {
+  sl_log_event_t sl_log_buffer[SL_LOG_NUMBER_OF_EVENTS];
+  uint32_t read_index;
+  uint32_t write_index;
+  uint32_t event_count;
+  int32_t available_event_slots;
+} sl_log_ring_buffer_t;
+
+typedef struct {
+  volatile uint32_t backend_transfer_done;
+} sl_log_backend_status_t;
+
+sl_log_ring_buffer_t *sl_log_get_ring_buffer_config(void);
+sl_status_t sl_log_write_multiple_to_ring_buffer(const sl_log_event_t *events, uint32_t count);
+
+// The tests provide the interrupt masking used by the ring buffer write path
+void __disable_irq(void);
+void __enable_irq(void);
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * @file
+ * @brief 
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// Host stand-in for the ULP timer driver header; only what the logging platform code uses
+#pragma once
+#include <stdint.h>
+#include "sl_status.h"
+
+typedef enum { ULP_TIMER_0, ULP_TIMER_1, ULP_TIMER_2, ULP_TIMER_3 } ulp_timer_instance_t;
+typedef enum { ULP_TIMER_MODE_ONESHOT, ULP_TIMER_MODE_PERIODIC } ulp_timer_mode_t;
+typedef enum { ULP_TIMER_TYP_DEFAULT, ULP_TIMER_TYP_1US } ulp_timer_type_t;
+typedef enum { DOWN_COUNTER, UP_COUNTER } ulp_timer_direction_t;
+
+#define ENABLE_STATIC_CLK     1
+#define ULP_TIMER_REF_CLK_SRC 0
+
+typedef struct {
+  uint8_t ulp_timer_clk_type;
+  uint8_t ulp_timer_sync_to_ulpss_pclk;
+  uint8_t ulp_timer_clk_input_src;
+  uint8_t ulp_timer_skip_switch_time;
+} ulp_timer_clk_src_config_t;
+
+typedef struct {
+  uint8_t timer_num;
+  uint8_t timer_mode;
+  uint8_t timer_type;
+  uint32_t timer_match_value;
+  uint8_t timer_direction;
+} ulp_timer_config_t;
+
+typedef void (*ulp_timer_callback_t)(void);
+
+typedef struct {
+  struct {
+    uint32_t MCUULP_TMR_MATCH;
+  } MATCH_CTRL[4];
+} ulp_timer_registers_t;
+
+extern ulp_timer_registers_t sl_log_test_ulp_timers;
+#define TIMERS (&sl_log_test_ulp_timers)
+
+sl_status_t sl_si91x_ulp_timer_init(ulp_timer_clk_src_config_t *timer_clk_ptr);
+sl_status_t sl_si91x_ulp_timer_set_configuration(ulp_timer_config_t *timer_config_ptr);
+sl_status_t sl_si91x_ulp_timer_register_timeout_callback(ulp_timer_instance_t instance,
+                                                         ulp_timer_callback_t on_timeout_callback);
+sl_status_t sl_si91x_ulp_timer_unregister_timeout_callback(ulp_timer_instance_t instance);
+sl_status_t sl_si91x_ulp_timer_start(ulp_timer_instance_t instance);
+sl_status_t sl_si91x_ulp_timer_stop(ulp_timer_instance_t instance);
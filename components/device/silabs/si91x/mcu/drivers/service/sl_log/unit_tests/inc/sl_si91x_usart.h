@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * @file
+ * @brief 
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// Host stand-in for the USART driver header; only what the logging backend uses
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "sl_status.h"
+
+typedef void *sl_usart_handle_t;
+typedef enum { USART_0, UART_1, ULPUART } usart_peripheral_t;
+typedef struct {
+  uint32_t baudrate;
+} sl_si91x_usart_control_config_t;
+typedef struct {
+  uint32_t reserved;
+} ARM_DRIVER_USART;
+
+#define ULPSS_UART_IRQn        0
+#define NVIC_DisableIRQ(irq_n) ((void)(irq_n))
+
+sl_status_t sl_si91x_usart_init(usart_peripheral_t usart_instance, sl_usart_handle_t *usart_handle);
+sl_status_t sl_si91x_usart_set_configuration(sl_usart_handle_t usart_handle,
+                                             sl_si91x_usart_control_config_t *control_configuration);
+sl_status_t sl_si91x_usart_deinit(sl_usart_handle_t usart_handle);
+sl_status_t sli_si91x_usart_send_data_blocking(sl_usart_handle_t usart_handle, const void *data, uint32_t data_length);
@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * @file
+ * @brief 
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include "sl_log_fake_functions.h"
+DEFINE_FFF_GLOBALS
+
+DEFINE_FAKE_VALUE_FUNC2(sl_status_t, sl_si91x_usart_init, usart_peripheral_t, sl_usart_handle_t *);
+DEFINE_FAKE_VALUE_FUNC2(sl_status_t,
+                        sl_si91x_usart_set_configuration,
+                        sl_usart_handle_t,
+                        sl_si91x_usart_control_config_t *);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sl_si91x_usart_deinit, sl_usart_handle_t);
+DEFINE_FAKE_VALUE_FUNC3(sl_status_t, sli_si91x_usart_send_data_blocking, sl_usart_handle_t, const void *, uint32_t);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sl_si91x_ulp_timer_init, ulp_timer_clk_src_config_t *);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sl_si91x_ulp_timer_set_configuration, ulp_timer_config_t *);
+DEFINE_FAKE_VALUE_FUNC2(sl_status_t,
+                        sl_si91x_ulp_timer_register_timeout_callback,
+                        ulp_timer_instance_t,
+                        ulp_timer_callback_t);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sl_si91x_ulp_timer_unregister_timeout_callback, ulp_timer_instance_t);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sl_si91x_ulp_timer_start, ulp_timer_instance_t);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sl_si91x_ulp_timer_stop, ulp_timer_instance_t);
+
+ulp_timer_registers_t sl_log_test_ulp_timers;
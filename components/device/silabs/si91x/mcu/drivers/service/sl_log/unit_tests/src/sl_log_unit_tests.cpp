@@ -0,0 +1,374 @@
+/*******************************************************************************
+ * @file
+ * @brief 
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+extern "C" {
+#include "sl_log.h"
+#include "sl_log_backend_si91x.h"
+#include "sl_log_proprietary_config.h"
+#include "sl_log_fake_functions.h"
+}
+
+#define BATCH_EVENTS (SL_LOG_BACKEND_BATCH_SIZE / sizeof(sl_log_event_t))
+
+static sl_log_event_t ring[SL_LOG_NUMBER_OF_EVENTS];
+
+/*
+ * Stand-ins for the GSDK logging core: the ring buffer written by
+ * sl_log_write_multiple_to_ring_buffer() and an sl_log_flush() that hands the
+ * whole backlog to the backend in one transfer, like the core's flush path.
+ */
+static sl_log_ring_buffer_t core_ring;
+
+// Masking interrupts keeps every other context out, which a lock does for producer threads on the host
+static std::mutex irq_lock;
+
+extern "C" {
+sl_log_backend_status_t sl_log_backend_status = { 1 };
+
+sl_log_ring_buffer_t *sl_log_get_ring_buffer_config(void)
+{
+  return &core_ring;
+}
+
+void __disable_irq(void)
+{
+  irq_lock.lock();
+}
+
+void __enable_irq(void)
+{
+  irq_lock.unlock();
+}
+
+void sl_log_flush(void)
+{
+  uint32_t pending = core_ring.event_count;
+  if (pending == 0) {
+    return;
+  }
+  sl_log_backend_status.backend_transfer_done = 0;
+  sl_log_get_api_backend()->backend_write(core_ring.sl_log_buffer, core_ring.read_index, pending);
+  core_ring.read_index                        = (core_ring.read_index + pending) % SL_LOG_NUMBER_OF_EVENTS;
+  core_ring.event_count                       = core_ring.event_count - pending;
+  core_ring.available_event_slots             = SL_LOG_NUMBER_OF_EVENTS - core_ring.event_count;
+  sl_log_backend_status.backend_transfer_done = 1;
+}
+}
+
+// Load test transport: checks per-producer ordering and counts what reached the wire
+static std::vector<uint32_t> next_sequence;
+static uint64_t delivered_events;
+static bool sequence_error;
+
+static sl_status_t fake_send_data_checked(sl_usart_handle_t handle, const void *data, uint32_t length)
+{
+  (void)handle;
+  const sl_log_event_t *events = (const sl_log_event_t *)data;
+  if (length % sizeof(sl_log_event_t) != 0 || length > SL_LOG_BACKEND_BATCH_SIZE) {
+    sequence_error = true;
+  }
+  for (uint32_t i = 0; i < length / sizeof(sl_log_event_t); i++) {
+    uint32_t producer = events[i].header;
+    if (producer >= next_sequence.size() || events[i].arg1 < next_sequence[producer]) {
+      sequence_error = true;
+      continue;
+    }
+    next_sequence[producer] = events[i].arg1 + 1;
+  }
+  delivered_events += length / sizeof(sl_log_event_t);
+  return SL_STATUS_OK;
+}
+
+static void sl_log_reset_fake(void)
+{
+  sli_si91x_usart_send_data_blocking_reset();
+  sl_log_backend_si91x_reset_statistics();
+  memset(&core_ring, 0, sizeof(core_ring));
+  core_ring.available_event_slots             = SL_LOG_NUMBER_OF_EVENTS;
+  sl_log_backend_status.backend_transfer_done = 1;
+}
+
+static sl_status_t write_events(uint32_t producer, uint32_t first_sequence, uint32_t count)
+{
+  sl_log_event_t events[8];
+  for (uint32_t i = 0; i < count; i++) {
+    events[i] = { producer, 0, first_sequence + i, 0 };
+  }
+  return sl_log_write_multiple_to_ring_buffer(events, count);
+}
+
+TEST(sl_log_si91x, backend_write_rejects_invalid_parameters)
+{
+  sl_log_api_backend_t *api = sl_log_get_api_backend();
+  sl_log_reset_fake();
+  EXPECT_EQ(api->backend_write(ring, 0, 0), SL_STATUS_INVALID_PARAMETER);
+  EXPECT_EQ(api->backend_write(NULL, 0, 1), SL_STATUS_INVALID_PARAMETER);
+  EXPECT_EQ(api->backend_write(ring, SL_LOG_NUMBER_OF_EVENTS, 1), SL_STATUS_INVALID_PARAMETER);
+  EXPECT_EQ(sli_si91x_usart_send_data_blocking_fake.call_count, 0u);
+}
+
+TEST(sl_log_si91x, backend_write_splits_into_batches)
+{
+  sl_log_api_backend_t *api = sl_log_get_api_backend();
+  sl_log_backend_si91x_statistics_t stats;
+  sl_log_reset_fake();
+  sli_si91x_usart_send_data_blocking_fake.return_val = SL_STATUS_OK;
+
+  EXPECT_EQ(api->backend_write(ring, 0, 2 * BATCH_EVENTS + 1), SL_STATUS_OK);
+  EXPECT_EQ(sli_si91x_usart_send_data_blocking_fake.call_count, 3u);
+  EXPECT_EQ(sli_si91x_usart_send_data_blocking_fake.arg2_history[0], BATCH_EVENTS * sizeof(sl_log_event_t));
+  EXPECT_EQ(sli_si91x_usart_send_data_blocking_fake.arg2_history[2], sizeof(sl_log_event_t));
+
+  sl_log_backend_si91x_get_statistics(&stats);
+  EXPECT_EQ(stats.batches, 3u);
+  EXPECT_EQ(stats.events_written, 2 * BATCH_EVENTS + 1);
+  EXPECT_EQ(stats.write_errors, 0u);
+}
+
+TEST(sl_log_si91x, backend_write_handles_wrap_around)
+{
+  sl_log_api_backend_t *api = sl_log_get_api_backend();
+  sl_log_reset_fake();
+  sli_si91x_usart_send_data_blocking_fake.return_val = SL_STATUS_OK;
+
+  EXPECT_EQ(api->backend_write(ring, SL_LOG_NUMBER_OF_EVENTS - 2, 4), SL_STATUS_OK);
+  EXPECT_EQ(sli_si91x_usart_send_data_blocking_fake.call_count, 2u);
+  EXPECT_EQ(sli_si91x_usart_send_data_blocking_fake.arg1_history[0], &ring[SL_LOG_NUMBER_OF_EVENTS - 2]);
+  EXPECT_EQ(sli_si91x_usart_send_data_blocking_fake.arg1_history[1], &ring[0]);
+  EXPECT_EQ(sli_si91x_usart_send_data_blocking_fake.arg2_history[1], 2 * sizeof(sl_log_event_t));
+}
+
+TEST(sl_log_si91x, backend_write_stops_on_transport_error)
+{
+  sl_log_api_backend_t *api = sl_log_get_api_backend();
+  sl_log_backend_si91x_statistics_t stats;
+  sl_log_reset_fake();
+  sli_si91x_usart_send_data_blocking_fake.return_val = SL_STATUS_FAIL;
+
+  EXPECT_EQ(api->backend_write(ring, 0, 3 * BATCH_EVENTS), SL_STATUS_FAIL);
+  EXPECT_EQ(sli_si91x_usart_send_data_blocking_fake.call_count, 1u);
+  sl_log_backend_si91x_get_statistics(&stats);
+  EXPECT_EQ(stats.write_errors, 1u);
+  EXPECT_EQ(stats.events_written, 0u);
+}
+
+TEST(sl_log_si91x, drain_interval_shrinks_with_fill_level)
+{
+  const uint32_t threshold = (SL_LOG_NUMBER_OF_EVENTS * SL_LOG_BACKEND_DRAIN_THRESHOLD_PERCENT) / 100;
+  uint32_t previous        = sl_log_backend_si91x_get_drain_interval(0);
+
+  EXPECT_EQ(previous, (uint32_t)SL_LOG_BACKEND_DRAIN_INTERVAL_MAX_MS);
+  for (uint32_t pending = 1; pending <= SL_LOG_NUMBER_OF_EVENTS; pending++) {
+    uint32_t interval = sl_log_backend_si91x_get_drain_interval(pending);
+    EXPECT_LE(interval, previous);
+    previous = interval;
+  }
+  EXPECT_EQ(sl_log_backend_si91x_get_drain_interval(threshold), (uint32_t)SL_LOG_BACKEND_DRAIN_INTERVAL_MIN_MS);
+}
+
+TEST(sl_log_si91x, statistics_track_drops_and_high_water)
+{
+  sl_log_backend_si91x_statistics_t stats;
+  sl_log_reset_fake();
+
+  sl_log_backend_si91x_record_dropped(3);
+  sli_log_backend_si91x_record_fill_level(10);
+  sli_log_backend_si91x_record_fill_level(4);
+  sl_log_backend_si91x_get_statistics(&stats);
+  EXPECT_EQ(stats.dropped_events, 3u);
+  EXPECT_EQ(stats.high_water, 10u);
+}
+
+TEST(sl_log_si91x, ring_write_counts_rejected_and_overwritten_events)
+{
+  sl_log_backend_si91x_statistics_t stats;
+  sl_log_reset_fake();
+
+  EXPECT_EQ(sl_log_write_multiple_to_ring_buffer(NULL, 1), SL_STATUS_INVALID_PARAMETER);
+  for (uint32_t i = 0; i < SL_LOG_NUMBER_OF_EVENTS / 8; i++) {
+    ASSERT_EQ(write_events(0, i * 8, 8), SL_STATUS_OK);
+  }
+
+  // Full ring while a transfer is in flight: the write is rejected
+  sl_log_backend_status.backend_transfer_done = 0;
+  EXPECT_EQ(write_events(0, SL_LOG_NUMBER_OF_EVENTS, 2), SL_STATUS_NOT_AVAILABLE);
+  sl_log_backend_si91x_get_statistics(&stats);
+  EXPECT_EQ(stats.dropped_events, 2u);
+
+  // Full ring with the backend idle: the oldest events are overwritten
+  sl_log_backend_status.backend_transfer_done = 1;
+  EXPECT_EQ(write_events(0, SL_LOG_NUMBER_OF_EVENTS, 3), SL_STATUS_OK);
+  sl_log_backend_si91x_get_statistics(&stats);
+  EXPECT_EQ(stats.dropped_events, 5u);
+  EXPECT_EQ(stats.high_water, (uint32_t)SL_LOG_NUMBER_OF_EVENTS);
+  EXPECT_EQ(core_ring.read_index, 3u);
+  EXPECT_EQ(core_ring.sl_log_buffer[core_ring.read_index].arg1, 3u);
+}
+
+TEST(sl_log_si91x, drain_flushes_and_paces_on_backlog)
+{
+  sl_log_backend_si91x_statistics_t stats;
+  sl_log_reset_fake();
+  sli_si91x_usart_send_data_blocking_fake.return_val = SL_STATUS_OK;
+
+  // A quiet system backs off to the idle interval by doubling
+  uint32_t previous = 0;
+  for (uint32_t i = 0; i < 16; i++) {
+    uint32_t interval = sl_log_backend_si91x_drain();
+    EXPECT_LE(interval, (previous > 0) ? 2 * previous : 1);
+    previous = interval;
+  }
+  EXPECT_EQ(previous, (uint32_t)SL_LOG_BACKEND_DRAIN_INTERVAL_MAX_MS);
+  EXPECT_EQ(sli_si91x_usart_send_data_blocking_fake.call_count, 0u);
+
+  // A backlog shortens the next interval at once
+  for (uint32_t i = 0; i < 32; i++) {
+    ASSERT_EQ(write_events(0, i * 8, 8), SL_STATUS_OK);
+  }
+  EXPECT_EQ(sl_log_backend_si91x_drain(), sl_log_backend_si91x_get_drain_interval(256));
+  EXPECT_EQ(core_ring.event_count, 0u);
+  sl_log_backend_si91x_get_statistics(&stats);
+  EXPECT_EQ(stats.events_written, 256u);
+  EXPECT_EQ(stats.high_water, 256u);
+}
+
+/*
+ * Four producer threads each write a burst of one to four events every
+ * millisecond through sl_log_write_multiple_to_ring_buffer(), all at the same
+ * time. Between two milliseconds a drain loop calls sl_log_backend_si91x_drain()
+ * and sleeps for the interval it returns. The load starts on a quiet system
+ * whose drain loop has backed off to the idle interval. Time is simulated and
+ * the threads meet at a barrier every millisecond, so the counts do not depend
+ * on host scheduling. Returns the wall-clock time spent in the write and drain
+ * paths.
+ */
+static double run_load(uint32_t duration_ms, bool adaptive, uint64_t *produced)
+{
+  const uint32_t producers = 4;
+  uint32_t next_drain      = 0;
+  std::vector<uint64_t> written(producers, 0);
+  std::vector<std::thread> threads;
+  pthread_barrier_t tick_start;
+  pthread_barrier_t tick_end;
+
+  sl_log_reset_fake();
+  sli_si91x_usart_send_data_blocking_fake.custom_fake = fake_send_data_checked;
+  next_sequence.assign(producers, 0);
+  delivered_events = 0;
+  sequence_error   = false;
+  *produced        = 0;
+  for (uint32_t i = 0; i < 16; i++) {
+    sl_log_backend_si91x_drain();
+  }
+
+  pthread_barrier_init(&tick_start, NULL, producers + 1);
+  pthread_barrier_init(&tick_end, NULL, producers + 1);
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t id = 0; id < producers; id++) {
+    threads.emplace_back([&, id] {
+      uint32_t sequence = 0;
+      for (uint32_t now = 0; now < duration_ms; now++) {
+        pthread_barrier_wait(&tick_start);
+        uint32_t burst = 1 + ((now + id) % 4);
+        write_events(id, sequence, burst);
+        sequence += burst;
+        written[id] += burst;
+        pthread_barrier_wait(&tick_end);
+      }
+    });
+  }
+  for (uint32_t now = 0; now < duration_ms; now++) {
+    pthread_barrier_wait(&tick_start);
+    pthread_barrier_wait(&tick_end);
+    if (now >= next_drain) {
+      uint32_t interval = sl_log_backend_si91x_drain();
+      next_drain        = now + (adaptive ? interval : (uint32_t)SL_LOG_BACKEND_DRAIN_INTERVAL_MAX_MS);
+    }
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  sl_log_flush();
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  pthread_barrier_destroy(&tick_start);
+  pthread_barrier_destroy(&tick_end);
+  for (uint64_t count : written) {
+    *produced += count;
+  }
+
+  sli_si91x_usart_send_data_blocking_fake.custom_fake = NULL;
+  return seconds;
+}
+
+TEST(sl_log_si91x, adaptive_drain_keeps_up_with_producers)
+{
+  const uint32_t duration_ms = 10000;
+  sl_log_backend_si91x_statistics_t stats;
+  uint64_t produced;
+
+  double seconds = run_load(duration_ms, true, &produced);
+  sl_log_backend_si91x_get_statistics(&stats);
+  printf("sl_log load: %llu events over %u ms simulated, %.0f events/s through the write and drain paths, "
+         "%.2f%% dropped, %u batches, high water %u\n",
+         (unsigned long long)produced,
+         duration_ms,
+         produced / seconds,
+         100.0 * stats.dropped_events / produced,
+         stats.batches,
+         stats.high_water);
+
+  // Only the first idle interval, before the drain loop has seen the load, may overflow the ring
+  EXPECT_FALSE(sequence_error);
+  EXPECT_LT(stats.dropped_events, (uint32_t)SL_LOG_NUMBER_OF_EVENTS);
+  EXPECT_EQ(delivered_events + stats.dropped_events, produced);
+  EXPECT_EQ(stats.events_written, delivered_events);
+  EXPECT_GE(stats.batches, delivered_events / BATCH_EVENTS);
+}
+
+TEST(sl_log_si91x, fixed_idle_drain_overflows_under_same_load)
+{
+  sl_log_backend_si91x_statistics_t stats;
+  uint64_t produced;
+
+  run_load(10000, false, &produced);
+  sl_log_backend_si91x_get_statistics(&stats);
+
+  // The idle interval lets about twice the ring size build up between drains
+  EXPECT_FALSE(sequence_error);
+  EXPECT_GT(stats.dropped_events, produced / 4);
+  EXPECT_EQ(delivered_events + stats.dropped_events, produced);
+}
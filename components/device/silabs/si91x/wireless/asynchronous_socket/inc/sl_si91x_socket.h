@@ -118,6 +118,11 @@ int sl_si91x_socket_async(int family, int type, int protocol, sl_si91x_socket_re
  *   - @ref SL_SI91X_SO_TLS_SNI
  *   - @ref SL_SI91X_SO_TLS_ALPN
  *   - @ref SL_SI91X_SO_MAX_RETRANSMISSION_TIMEOUT_VALUE
+ *   - @ref SL_SI91X_SO_TX_WEIGHT
+ *   - @ref SL_SI91X_SO_TX_PRIORITY
+ *   - @ref SL_SI91X_SO_RCV_READ_AHEAD
+ *   - @ref SL_SI91X_SO_TCP_NODELAY
+ *   - @ref SL_SI91X_SO_TCP_CORK
  *
  * @param[in] option_value 
  *   The value of the parameter.
@@ -138,6 +143,11 @@ int sl_si91x_socket_async(int family, int type, int protocol, sl_si91x_socket_re
  *   | @ref SL_SI91X_SO_TLS_SNI                          | sl_si91x_socket_type_length_value_t       | Server Name Indication (SNI)                                                                                               |
  *   | @ref SL_SI91X_SO_TLS_ALPN                         | sl_si91x_socket_type_length_value_t       | Application-Layer Protocol Negotiation (ALPN)                                                                              |
  *   | @ref SL_SI91X_SO_MAX_RETRANSMISSION_TIMEOUT_VALUE | uint8_t                                   | Maximum retransmission timeout value for TCP                                                                               |
+ *   | @ref SL_SI91X_SO_TX_WEIGHT                        | uint8_t                                   | Share of the bus given to this socket's data relative to other sockets of the same TX priority class, 1 to 16              |
+ *   | @ref SL_SI91X_SO_TX_PRIORITY                      | uint8_t                                   | TX priority class, one of SL_SI91X_SOCKET_TX_PRIORITY_LOW, _NORMAL (default) or _HIGH                                      |
+ *   | @ref SL_SI91X_SO_RCV_READ_AHEAD                   | uint16_t                                  | Host receive read-ahead window of a stream socket in bytes, 0 disables read-ahead                                          |
+ *   | @ref SL_SI91X_SO_TCP_NODELAY                      | uint8_t                                   | 1 (default) sends each write as its own frame, 0 appends small writes to a frame still queued behind another one           |
+ *   | @ref SL_SI91X_SO_TCP_CORK                         | uint8_t                                   | 1 holds partly filled frames until they reach the MSS or SL_SI91X_SOCKET_CORK_FLUSH_TIMEOUT_MS expires, 0 sends them now   |
  *
  * @param[in] option_len 
  *   The length of the parameter of type @ref socklen_t.
@@ -149,9 +159,30 @@ int sl_si91x_socket_async(int family, int type, int protocol, sl_si91x_socket_re
  * This function is used only for the SiWx91x socket API.
  * The options set in this function will not be effective if called after `sl_si91x_connect()` or `sl_si91x_listen()` for TCP, or after `sl_si91x_sendto()`, `sl_si91x_recvfrom()`, or `sl_si91x_connect()` for UDP.
  * The value of the option SL_SI91X_SO_MAX_RETRANSMISSION_TIMEOUT_VALUE should be a power of 2 between 1 and 128.
+ * SL_SI91X_SO_TX_WEIGHT and SL_SI91X_SO_TX_PRIORITY only affect host side scheduling of queued data and take effect at any time.
+ * SL_SI91X_SO_RCV_READ_AHEAD fails with EBUSY while received data is still buffered on the host.
+ * SL_SI91X_SO_TCP_NODELAY and SL_SI91X_SO_TCP_CORK only apply to stream sockets, take effect at any time and are not
+ * applied to WebSocket connections. Writes saved this way are counted in @ref sl_si91x_socket_tx_statistics_t.
  */
 int sl_si91x_setsockopt(int32_t socket, int level, int option_name, const void *option_value, socklen_t option_len);
 
+/**
+ * @brief Retrieves the transmit counters of a socket.
+ *
+ * @details
+ * The counters cover socket data written to the bus by the host, since the socket was created.
+ *
+ * @param[in] socket 
+ *   The socket ID or file descriptor for the specified socket.
+ *
+ * @param[out] statistics 
+ *   Pointer to @ref sl_si91x_socket_tx_statistics_t that receives the counters.
+ *
+ * @return 
+ *   Returns 0 on success, or -1 on failure.
+ */
+int sl_si91x_get_socket_tx_statistics(int32_t socket, sl_si91x_socket_tx_statistics_t *statistics);
+
 /**
  * @brief Assigns a local protocol address to a socket.
  *
@@ -381,6 +412,51 @@ int sl_si91x_sendto_async(int socket,
                           socklen_t to_addr_len,
                           sl_si91x_socket_data_transfer_complete_handler_t callback);
 
+/**
+ * @brief 
+ * Sends a message gathered from multiple buffers.
+ * 
+ * @details
+ * The buffers described by `message->msg_iov` are copied in order straight into the transmit frame behind the request header,
+ * like a single @ref sl_si91x_sendto of their combined length.
+ * 
+ * @param[in] socket 
+ * The socket ID or file descriptor for the specified socket.
+ * @param[in] message 
+ *  Message to send. `msg_name` and `msg_namelen` are used like `addr` and `addr_len` of @ref sl_si91x_sendto. Ancillary data is ignored.
+ * @param[in] flags 
+ *  Controls the transmission of the data.
+ * @return int 
+ *  Returns the number of bytes sent on success, or -1 on failure with errno set.
+ * @note The flags parameter is not currently supported.
+ * @note The combined length is limited like the buffer length of @ref sl_si91x_sendto.
+ */
+int sl_si91x_sendmsg(int socket, const struct msghdr *message, int32_t flags);
+
+/**
+ * @brief 
+ * Sends multiple messages with one wakeup of the transmit path.
+ * 
+ * @details
+ * Each message is sent like @ref sl_si91x_sendmsg. All frames are built before any of them is queued and they are then 
+ * queued together, under one critical section. Frames built so far are queued early only when the host runs out of buffers.
+ * 
+ * @param[in] socket 
+ * The socket ID or file descriptor for the specified socket.
+ * @param[in] messages 
+ *  Array of messages to send.
+ * @param[in] count 
+ *  Number of entries in messages.
+ * @param[in] flags 
+ *  Controls the transmission of the data.
+ * @return int 
+ *  Returns the number of messages sent. Returns -1 with errno set only if no message was sent.
+ * @note The flags parameter is not currently supported.
+ * @note Stream sockets that append small writes to queued frames, see @ref SL_SI91X_SO_TCP_NODELAY, send each message separately.
+ * @note A TCP socket with @ref SL_SI91x_SO_TCP_ACK_INDICATION enabled sends only the first message, as it waits for its acknowledgment.
+ */
+int sl_si91x_sendmmsg(int socket, const struct msghdr *messages, unsigned int count, int32_t flags);
+
 /**
  * @brief Sends data that is larger than the Maximum Segment Size (MSS).
  *
@@ -403,6 +479,9 @@ int sl_si91x_sendto_async(int socket,
  *
  * @return 
  *   Returns the number of bytes sent on success, or -1 on failure.
+ *
+ * @note
+ *   The socket is validated once and the chunks are queued for transmission together, see @ref sl_si91x_sendmmsg.
  */
 int sl_si91x_send_large_data(int socket, const uint8_t *buffer, size_t buffer_length, int32_t flags);
 
@@ -429,7 +508,9 @@ int sl_si91x_send_large_data(int socket, const uint8_t *buffer, size_t buffer_le
  *   The length of the buffer pointed to by the buffer parameter.
  *
  * @param[in] flags 
- *   Controls the reception of the data. Note that the flags parameter are not currently supported.
+ *   Controls the reception of the data. For stream sockets, MSG_PEEK returns buffered data without consuming it and MSG_WAITALL
+ *   blocks until bufferLength bytes are received, the peer closes or the read times out. Both use the host receive ring,
+ *   which is also used for every read once read-ahead is enabled with @ref SL_SI91X_SO_RCV_READ_AHEAD.
  *
  * @return 
  *   Returns the number of bytes received on success, or -1 on failure.
@@ -459,7 +540,10 @@ int sl_si91x_recv(int socket, uint8_t *buffer, size_t bufferLength, int32_t flag
  *   The size of the buffer pointed to by the buffer parameter.
  *
  * @param[in] flags 
- *   Controls the reception of the data. Note that the flags parameter is not currently supported.
+ *   Controls the reception of the data. For stream sockets, MSG_PEEK returns buffered data without consuming it and MSG_WAITALL
+ *   blocks until buffersize bytes are received, the peer closes or the read times out. Both use the host receive ring,
+ *   which is also used for every read once read-ahead is enabled with @ref SL_SI91X_SO_RCV_READ_AHEAD.
+ *   MSG_PEEK is not supported for datagram sockets.
  *
  * @param[out] fromAddr 
  *   Pointer to a @ref sockaddr that will hold the address of the remote peer from which the current packet was received.
@@ -478,6 +562,47 @@ int sl_si91x_recvfrom(int socket,
                       struct sockaddr *fromAddr,
                       socklen_t *fromAddrLen);
 
+/**
+ * @brief Registers a receive callback that can keep the buffers holding the received data.
+ *
+ * @details
+ * Instead of copying the data out before returning, the callback may return true to keep the buffer and hand
+ * it back later with @ref sl_si91x_release_receive_buffer. Until then the buffer counts against the quota of the
+ * socket and against SL_SI91X_SOCKET_MAX_RX_BUFFER_LOANS for all sockets, as kept buffers are taken from the
+ * shared receive pool. Once a quota is used up, the callback is called with a NULL buffer and the data is only
+ * valid until it returns.
+ *
+ * @param[in] socket
+ *   The socket ID of a socket created with @ref sl_si91x_socket_async.
+ *
+ * @param[in] callback
+ *   Callback of type @ref sl_si91x_socket_receive_buffer_callback_t, or NULL to go back to the receive data
+ *   callback of the socket.
+ *
+ * @param[in] quota
+ *   Number of buffers the application may keep at the same time for this socket, at most
+ *   SL_SI91X_SOCKET_MAX_RX_BUFFER_LOANS. 0 lends every buffer only for the duration of the callback.
+ *
+ * @return
+ *   Returns 0 on success, or -1 on failure with errno set to EBADF or EINVAL.
+ *
+ * @note
+ *   Buffers kept when the socket is closed stay valid until they are released.
+ */
+int sl_si91x_set_receive_buffer_callback(int socket, sl_si91x_socket_receive_buffer_callback_t callback, uint8_t quota);
+
+/**
+ * @brief Returns a buffer kept by a receive buffer callback.
+ *
+ * @param[in] buffer
+ *   Buffer passed to the callback registered with @ref sl_si91x_set_receive_buffer_callback that returned true.
+ *
+ * @return
+ *   Returns 0 on success, or -1 with errno set to EINVAL if the buffer is not held by the application,
+ *   for example because it was already released.
+ */
+int sl_si91x_release_receive_buffer(sl_wifi_buffer_t *buffer);
+
 /**
  * @brief Disables send or receive operations on a socket.
  *
@@ -284,6 +284,41 @@ int sl_si91x_setsockopt(int32_t sockID, int level, int option_name, const void *
       break;
     }
 
+    case SL_SI91X_SO_TX_WEIGHT: {
+      // Set the share of the bus given to this socket within its TX priority class
+      uint8_t weight = *(const uint8_t *)option_value;
+      SLI_SET_ERRNO_AND_RETURN_IF_TRUE((weight == 0) || (weight > SL_SI91X_SOCKET_TX_MAX_WEIGHT), EINVAL);
+      si91x_socket->tx_weight = weight;
+      break;
+    }
+
+    case SL_SI91X_SO_TX_PRIORITY: {
+      // Set the TX priority class of the socket
+      uint8_t priority = *(const uint8_t *)option_value;
+      SLI_SET_ERRNO_AND_RETURN_IF_TRUE(priority > SL_SI91X_SOCKET_TX_PRIORITY_HIGH, EINVAL);
+      si91x_socket->tx_priority = priority;
+      break;
+    }
+
+    case SL_SI91X_SO_RCV_READ_AHEAD: {
+      // Set the host receive read-ahead window of a stream socket
+      uint16_t window = 0;
+      memcpy(&window, option_value, SLI_GET_SAFE_MEMCPY_LENGTH(sizeof(window), option_len));
+      return sli_si91x_socket_set_read_ahead(si91x_socket, window);
+    }
+
+    case SL_SI91X_SO_TCP_NODELAY: {
+      // Send each write as its own frame, or append small writes to a frame still queued on the host
+      SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type != SOCK_STREAM, EOPNOTSUPP);
+      si91x_socket->tx_nodelay = (*(const uint8_t *)option_value != 0);
+      break;
+    }
+
+    case SL_SI91X_SO_TCP_CORK: {
+      // Hold partly filled frames back until they reach the MSS
+      return sli_si91x_socket_set_cork(si91x_socket, *(const uint8_t *)option_value != 0);
+    }
+
     default: {
       // Invalid socket option
       SLI_SET_ERROR_AND_RETURN(ENOPROTOOPT);
@@ -292,6 +327,38 @@ int sl_si91x_setsockopt(int32_t sockID, int level, int option_name, const void *
   return SLI_SI91X_NO_ERROR;
 }
 
+int sl_si91x_get_socket_tx_statistics(int32_t socket, sl_si91x_socket_tx_statistics_t *statistics)
+{
+  const sli_si91x_socket_t *si91x_socket = sli_get_si91x_socket(socket);
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(statistics == NULL, EFAULT);
+
+  statistics->tx_bytes     = si91x_socket->tx_bytes;
+  statistics->tx_frames    = si91x_socket->tx_frames;
+  statistics->tx_coalesced = si91x_socket->tx_coalesced;
+  return SLI_SI91X_NO_ERROR;
+}
+
+int sl_si91x_set_receive_buffer_callback(int socket, sl_si91x_socket_receive_buffer_callback_t callback, uint8_t quota)
+{
+  sli_si91x_socket_t *si91x_socket = sli_get_si91x_socket(socket);
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
+  // Only sockets created with a receive callback get their data pushed by the driver
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->recv_data_callback == NULL, EINVAL);
+
+  return sli_si91x_socket_set_receive_buffer_callback(si91x_socket, callback, quota);
+}
+
+int sl_si91x_release_receive_buffer(sl_wifi_buffer_t *buffer)
+{
+  sl_status_t status = sli_si91x_socket_release_receive_buffer(buffer);
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(status != SL_STATUS_OK, EINVAL);
+  return SLI_SI91X_NO_ERROR;
+}
+
 int sl_si91x_send(int socket, const uint8_t *buffer, size_t buffer_length, int32_t flags)
 {
   return sl_si91x_send_async(socket, buffer, buffer_length, flags, NULL);
@@ -316,44 +383,16 @@ int sl_si91x_sendto(int socket,
   return sl_si91x_sendto_async(socket, buffer, buffer_length, flags, addr, addr_len, NULL);
 }
 
-int sl_si91x_send_large_data(int socket, const uint8_t *buffer, size_t buffer_length, int32_t flags)
+// Helper: Validate the socket and destination of a send
+static int sli_si91x_validate_send_socket(const sli_si91x_socket_t *si91x_socket, const struct sockaddr *to_addr)
 {
-  const sli_si91x_socket_t *si91x_socket = sli_get_si91x_socket(socket);
-  int bsd_ret_code                       = 0;
-  size_t offset                          = 0;
-  size_t chunk_size                      = 0;
-  size_t max_len                         = 0;
-
   SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
-  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->state == RESET || si91x_socket->state == INITIALIZED, EBADF);
-  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(buffer == NULL, EFAULT);
-
-  // Find maximum limit based on the protocol
-  if (si91x_socket->type == SOCK_STREAM && si91x_socket->ssl_bitmap & SL_SI91X_ENABLE_TLS) {
-    max_len = (si91x_socket->local_address.sin6_family == AF_INET) ? si91x_socket->mss - SLI_SI91X_SSL_HEADER_SIZE_IPV4
-                                                                   : si91x_socket->mss - SLI_SI91X_SSL_HEADER_SIZE_IPV6;
-  } else if (si91x_socket->type == SOCK_DGRAM) {
-    max_len = (si91x_socket->local_address.sin6_family == AF_INET) ? SLI_DEFAULT_DATAGRAM_MSS_SIZE_IPV4
-                                                                   : SLI_DEFAULT_DATAGRAM_MSS_SIZE_IPV6;
-  } else {
-    // In case of IPv6, maximum payload size is 1440 bytes (1460 bytes excluding IPv4 header - 20 bytes overhead for IPv6 compared to IPv4).
-    max_len = (si91x_socket->local_address.sin6_family == AF_INET)
-                ? si91x_socket->mss
-                : si91x_socket->mss - (SLI_TCP_V6_HEADER_LENGTH - SLI_TCP_HEADER_LENGTH);
-  }
-
-  while (offset < buffer_length) {
-    chunk_size = (max_len < (buffer_length - offset)) ? max_len : (buffer_length - offset);
-    // Send chunk of data and return the total data sent in successful case
-    bsd_ret_code = sl_si91x_send_async(socket, buffer + offset, chunk_size, flags, NULL);
-    if (bsd_ret_code < 0) {
-      SL_DEBUG_LOG("\n Send failed with error code 0x%X \n", errno);
-      break;
-    } else {
-      offset += bsd_ret_code;
-    }
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type == SOCK_STREAM && si91x_socket->state != CONNECTED, ENOTCONN);
+  if (si91x_socket->socket_bitmap & SLI_SI91X_SOCKET_FEAT_TCP_ACK_INDICATION) {
+    SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->is_waiting_on_ack == true, EWOULDBLOCK);
   }
-  return offset;
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->state != CONNECTED && to_addr == NULL, EFAULT);
+  return 0;
 }
 
 // Helper: Validate socket and buffer arguments
@@ -361,13 +400,11 @@ static int sli_si91x_validate_sendto_async_args(const sli_si91x_socket_t *si91x_
                                                 const uint8_t *buffer,
                                                 const struct sockaddr *to_addr)
 {
-  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
-  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type == SOCK_STREAM && si91x_socket->state != CONNECTED, ENOTCONN);
-  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(buffer == NULL, EFAULT);
-  if (si91x_socket->socket_bitmap & SLI_SI91X_SOCKET_FEAT_TCP_ACK_INDICATION) {
-    SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->is_waiting_on_ack == true, EWOULDBLOCK);
+  int err = sli_si91x_validate_send_socket(si91x_socket, to_addr);
+  if (err) {
+    return err;
   }
-  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->state != CONNECTED && to_addr == NULL, EFAULT);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(buffer == NULL, EFAULT);
   return 0;
 }
 
@@ -473,6 +510,71 @@ static void sli_si91x_setup_request_address(const sli_si91x_socket_t *si91x_sock
                          : si91x_socket->remote_address.sin6_port;
 }
 
+// Helper: Check the message size and build the send request for a validated socket
+static int sli_si91x_prepare_send_request(sli_si91x_socket_t *si91x_socket,
+                                          int socket,
+                                          const struct sockaddr *to_addr,
+                                          socklen_t to_addr_len,
+                                          size_t length,
+                                          sli_si91x_socket_send_request_t *request)
+{
+  // Check message size depending on socket type
+  size_t max_size = sli_si91x_get_max_message_size(si91x_socket);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(length > max_size, EMSGSIZE);
+
+  // Prepare and validate UDP socket state/address
+  int err = sli_si91x_prepare_and_validate_udp_socket(si91x_socket, socket, to_addr_len);
+  if (err) {
+    return err;
+  }
+
+  // Setup request address
+  sli_si91x_setup_request_address(si91x_socket, to_addr, to_addr_len, request);
+  request->length = length;
+  return 0;
+}
+
+// Helper: Validate a gather array and return the combined length of its buffers
+static int sli_si91x_get_iov_length(const struct iovec *iov, int iovcnt, size_t *length)
+{
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(iov == NULL || iovcnt <= 0, EFAULT);
+
+  *length = 0;
+  for (int i = 0; i < iovcnt; i++) {
+    SLI_SET_ERRNO_AND_RETURN_IF_TRUE(iov[i].iov_base == NULL && iov[i].iov_len != 0, EFAULT);
+    *length += iov[i].iov_len;
+  }
+  return 0;
+}
+
+// Helper: Validate one message of a socket and build its send request
+static int sli_si91x_prepare_message(sli_si91x_socket_t *si91x_socket,
+                                     int socket,
+                                     const struct msghdr *message,
+                                     size_t *length,
+                                     sli_si91x_socket_send_request_t *request)
+{
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(message == NULL, EFAULT);
+
+  int err = sli_si91x_validate_send_socket(si91x_socket, (const struct sockaddr *)message->msg_name);
+  if (err) {
+    return err;
+  }
+
+  // The gather array takes the place of the data buffer
+  err = sli_si91x_get_iov_length(message->msg_iov, (int)message->msg_iovlen, length);
+  if (err) {
+    return err;
+  }
+
+  return sli_si91x_prepare_send_request(si91x_socket,
+                                        socket,
+                                        (const struct sockaddr *)message->msg_name,
+                                        message->msg_namelen,
+                                        *length,
+                                        request);
+}
+
 int sl_si91x_sendto_async(int socket,
                           const uint8_t *buffer,
                           size_t buffer_length,
@@ -496,22 +598,17 @@ int sl_si91x_sendto_async(int socket,
   // Set the data transfer callback for this socket
   si91x_socket->data_transfer_callback = callback;
 
-  // Check message size depending on socket type
-  size_t max_size = sli_si91x_get_max_message_size(si91x_socket);
-  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(buffer_length > max_size, EMSGSIZE);
-
-  // Prepare and validate UDP socket state/address
-  err = sli_si91x_prepare_and_validate_udp_socket(si91x_socket, socket, to_addr_len);
+  err = sli_si91x_prepare_send_request(si91x_socket, socket, to_addr, to_addr_len, buffer_length, &request);
   if (err) {
     return err;
   }
 
-  // Setup request address
-  sli_si91x_setup_request_address(si91x_socket, to_addr, to_addr_len, &request);
-  request.length = buffer_length;
-
-  // Send the socket data
-  status = sli_si91x_driver_send_socket_data(&request, buffer, 0);
+  // Send the socket data. Coalesced writes go through the socket's own queue, where they can share a frame.
+  if (sli_si91x_socket_coalesces_writes(si91x_socket)) {
+    status = sli_si91x_send_socket_data(si91x_socket, &request, buffer);
+  } else {
+    status = sli_si91x_driver_send_socket_data(&request, buffer, 0);
+  }
   if (status != SL_STATUS_OK && (si91x_socket->socket_bitmap & SLI_SI91X_SOCKET_FEAT_TCP_ACK_INDICATION)) {
     si91x_socket->is_waiting_on_ack = false;
   }
@@ -520,6 +617,157 @@ int sl_si91x_sendto_async(int socket,
   return buffer_length;
 }
 
+int sl_si91x_sendmsg(int socket, const struct msghdr *message, int32_t flags)
+{
+  UNUSED_PARAMETER(flags);
+  sl_status_t status                      = SL_STATUS_OK;
+  sli_si91x_socket_t *si91x_socket        = sli_get_si91x_socket(socket);
+  sli_si91x_socket_send_request_t request = { 0 };
+  sli_si91x_socket_send_batch_t batch;
+  size_t length = 0;
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
+  int err = sli_si91x_prepare_message(si91x_socket, socket, message, &length, &request);
+  if (err) {
+    return err;
+  }
+  si91x_socket->data_transfer_callback = NULL;
+
+  // The buffers are gathered straight into the frame behind the request header
+  if (sli_si91x_socket_coalesces_writes(si91x_socket)) {
+    status = sli_si91x_send_socket_data_vector(si91x_socket, &request, message->msg_iov, (int)message->msg_iovlen);
+  } else {
+    sli_si91x_socket_batch_init(&batch, si91x_socket, false);
+    status = sli_si91x_socket_batch_add(&batch, &request, message->msg_iov, (int)message->msg_iovlen);
+    sli_si91x_socket_batch_flush(&batch);
+  }
+  if (status != SL_STATUS_OK && (si91x_socket->socket_bitmap & SLI_SI91X_SOCKET_FEAT_TCP_ACK_INDICATION)) {
+    si91x_socket->is_waiting_on_ack = false;
+  }
+  SLI_SOCKET_VERIFY_STATUS_AND_RETURN(status, SL_STATUS_OK, ENOBUFS);
+
+  return length;
+}
+
+int sl_si91x_sendmmsg(int socket, const struct msghdr *messages, unsigned int count, int32_t flags)
+{
+  UNUSED_PARAMETER(flags);
+  sl_status_t status                      = SL_STATUS_OK;
+  sli_si91x_socket_t *si91x_socket        = sli_get_si91x_socket(socket);
+  sli_si91x_socket_send_request_t request = { 0 };
+  sli_si91x_socket_send_batch_t batch;
+  unsigned int sent = 0;
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(messages == NULL && count != 0, EFAULT);
+  si91x_socket->data_transfer_callback = NULL;
+
+  // All frames are built first and queued together, unless the socket appends small writes to queued frames
+  const bool coalesce = sli_si91x_socket_coalesces_writes(si91x_socket);
+  sli_si91x_socket_batch_init(&batch, si91x_socket, false);
+
+  for (; sent < count; sent++) {
+    const struct msghdr *message = &messages[sent];
+    size_t length                = 0;
+
+    memset(&request, 0, sizeof(request));
+    if (sli_si91x_prepare_message(si91x_socket, socket, message, &length, &request) != 0) {
+      break;
+    }
+    if (coalesce) {
+      status = sli_si91x_send_socket_data_vector(si91x_socket, &request, message->msg_iov, (int)message->msg_iovlen);
+    } else {
+      status = sli_si91x_socket_batch_add(&batch, &request, message->msg_iov, (int)message->msg_iovlen);
+    }
+    if (status != SL_STATUS_OK) {
+      if (si91x_socket->socket_bitmap & SLI_SI91X_SOCKET_FEAT_TCP_ACK_INDICATION) {
+        si91x_socket->is_waiting_on_ack = false;
+      }
+      errno = ENOBUFS;
+      break;
+    }
+  }
+  sli_si91x_socket_batch_flush(&batch);
+
+  // An error is only reported if no message was sent
+  if (sent == 0 && count != 0) {
+    return -1;
+  }
+  return (int)sent;
+}
+
+int sl_si91x_send_large_data(int socket, const uint8_t *buffer, size_t buffer_length, int32_t flags)
+{
+  UNUSED_PARAMETER(flags);
+  sli_si91x_socket_t *si91x_socket        = sli_get_si91x_socket(socket);
+  sli_si91x_socket_send_request_t request = { 0 };
+  sli_si91x_socket_send_batch_t batch;
+  sl_status_t status = SL_STATUS_OK;
+  size_t offset      = 0;
+  size_t chunk_size  = 0;
+  size_t max_len     = 0;
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->state == RESET || si91x_socket->state == INITIALIZED, EBADF);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(buffer == NULL, EFAULT);
+
+  // Find maximum limit based on the protocol
+  if (si91x_socket->type == SOCK_STREAM && si91x_socket->ssl_bitmap & SL_SI91X_ENABLE_TLS) {
+    max_len = (si91x_socket->local_address.sin6_family == AF_INET) ? si91x_socket->mss - SLI_SI91X_SSL_HEADER_SIZE_IPV4
+                                                                   : si91x_socket->mss - SLI_SI91X_SSL_HEADER_SIZE_IPV6;
+  } else if (si91x_socket->type == SOCK_DGRAM) {
+    max_len = (si91x_socket->local_address.sin6_family == AF_INET) ? SLI_DEFAULT_DATAGRAM_MSS_SIZE_IPV4
+                                                                   : SLI_DEFAULT_DATAGRAM_MSS_SIZE_IPV6;
+  } else {
+    // In case of IPv6, maximum payload size is 1440 bytes (1460 bytes excluding IPv4 header - 20 bytes overhead for IPv6 compared to IPv4).
+    max_len = (si91x_socket->local_address.sin6_family == AF_INET)
+                ? si91x_socket->mss
+                : si91x_socket->mss - (SLI_TCP_V6_HEADER_LENGTH - SLI_TCP_HEADER_LENGTH);
+  }
+
+  // The socket is validated and the request built once, only the length changes between chunks
+  chunk_size = (max_len < buffer_length) ? max_len : buffer_length;
+  if (sli_si91x_validate_sendto_async_args(si91x_socket, buffer, NULL) != 0
+      || sli_si91x_prepare_send_request(si91x_socket, socket, NULL, 0, chunk_size, &request) != 0) {
+    SL_DEBUG_LOG("\n Send failed with error code 0x%X \n", errno);
+    return offset;
+  }
+  si91x_socket->data_transfer_callback = NULL;
+
+  // Chunks are built into frames and queued together instead of one enqueue and wakeup per chunk
+  const bool coalesce = sli_si91x_socket_coalesces_writes(si91x_socket);
+  sli_si91x_socket_batch_init(&batch, si91x_socket, false);
+
+  while (offset < buffer_length) {
+    // A socket waiting for the TCP acknowledgment of its first chunk cannot send another one
+    if (offset > 0 && (si91x_socket->socket_bitmap & SLI_SI91X_SOCKET_FEAT_TCP_ACK_INDICATION)) {
+      errno = EWOULDBLOCK;
+      break;
+    }
+    chunk_size     = (max_len < (buffer_length - offset)) ? max_len : (buffer_length - offset);
+    request.length = chunk_size;
+
+    const struct iovec iov = { .iov_base = (void *)(buffer + offset), .iov_len = chunk_size };
+    if (coalesce) {
+      status = sli_si91x_send_socket_data_vector(si91x_socket, &request, &iov, 1);
+    } else {
+      status = sli_si91x_socket_batch_add(&batch, &request, &iov, 1);
+    }
+    if (status != SL_STATUS_OK) {
+      if (si91x_socket->socket_bitmap & SLI_SI91X_SOCKET_FEAT_TCP_ACK_INDICATION) {
+        si91x_socket->is_waiting_on_ack = false;
+      }
+      errno = ENOBUFS;
+      SL_DEBUG_LOG("\n Send failed with error code 0x%X \n", errno);
+      break;
+    }
+    offset += chunk_size;
+  }
+  sli_si91x_socket_batch_flush(&batch);
+
+  return offset;
+}
+
 int sl_si91x_recv(int socket, uint8_t *buf, size_t buf_len, int32_t flags)
 {
   return sl_si91x_recvfrom(socket, buf, buf_len, flags, NULL, NULL);
@@ -532,8 +780,6 @@ int sl_si91x_recvfrom(int socket,
                       struct sockaddr *addr,
                       socklen_t *addr_len)
 {
-  UNUSED_PARAMETER(flags);
-
   // Initialize variables for socket communication
   sli_wifi_wait_period_t wait_time     = 0;
   sli_si91x_req_socket_read_t request  = { 0 };
@@ -566,6 +812,16 @@ int sl_si91x_recvfrom(int socket,
   SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->state != CONNECTED && si91x_socket->state != UDP_UNCONNECTED_READY,
                                    EBADF);
 
+  // Stream data goes through the host receive ring when read-ahead is enabled or the flags need buffering
+  if ((si91x_socket->type == SOCK_STREAM)
+      && ((si91x_socket->rx_ring_size != 0) || ((flags & (MSG_PEEK | MSG_WAITALL)) != 0))) {
+    if ((addr != NULL) && (addr_len != NULL)) {
+      *addr_len = 0;
+    }
+    return sli_si91x_socket_buffered_recv(si91x_socket, buf, buf_len, flags);
+  }
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE((flags & MSG_PEEK) != 0, EOPNOTSUPP);
+
   // Limit the buffer length based on the socket type
   if (si91x_socket->local_address.sin6_family == AF_INET) {
     if (si91x_socket->type == SOCK_STREAM) {
@@ -69,6 +69,35 @@ DECLARE_FAKE_VALUE_FUNC3(sl_status_t,
                          const sli_si91x_socket_send_request_t *,
                          const void *,
                          uint32_t);
+DECLARE_FAKE_VALUE_FUNC3(sl_status_t,
+                         sli_si91x_send_socket_data,
+                         sli_si91x_socket_t *,
+                         const sli_si91x_socket_send_request_t *,
+                         const void *);
+DECLARE_FAKE_VALUE_FUNC1(bool, sli_si91x_socket_coalesces_writes, const sli_si91x_socket_t *);
+DECLARE_FAKE_VALUE_FUNC4(sl_status_t,
+                         sli_si91x_send_socket_data_vector,
+                         sli_si91x_socket_t *,
+                         const sli_si91x_socket_send_request_t *,
+                         const struct iovec *,
+                         int);
+DECLARE_FAKE_VOID_FUNC3(sli_si91x_socket_batch_init, sli_si91x_socket_send_batch_t *, sli_si91x_socket_t *, bool);
+DECLARE_FAKE_VALUE_FUNC4(sl_status_t,
+                         sli_si91x_socket_batch_add,
+                         sli_si91x_socket_send_batch_t *,
+                         const sli_si91x_socket_send_request_t *,
+                         const struct iovec *,
+                         int);
+DECLARE_FAKE_VOID_FUNC1(sli_si91x_socket_batch_flush, sli_si91x_socket_send_batch_t *);
+DECLARE_FAKE_VALUE_FUNC2(int, sli_si91x_socket_set_cork, sli_si91x_socket_t *, bool);
+DECLARE_FAKE_VALUE_FUNC3(int,
+                         sli_si91x_socket_set_receive_buffer_callback,
+                         sli_si91x_socket_t *,
+                         sl_si91x_socket_receive_buffer_callback_t,
+                         uint8_t);
+DECLARE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_socket_release_receive_buffer, sl_wifi_buffer_t *);
+DECLARE_FAKE_VALUE_FUNC2(int, sli_si91x_socket_set_read_ahead, sli_si91x_socket_t *, uint16_t);
+DECLARE_FAKE_VALUE_FUNC4(ssize_t, sli_si91x_socket_buffered_recv, sli_si91x_socket_t *, uint8_t *, size_t, int32_t);
 DECLARE_FAKE_VALUE_FUNC2(sl_status_t,
                          sli_si91x_add_tls_extension,
                          sli_si91x_tls_extensions_t *,
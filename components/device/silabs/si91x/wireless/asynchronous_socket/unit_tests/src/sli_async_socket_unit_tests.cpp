@@ -396,3 +396,77 @@ TEST(sli_async_socket_unit_tests, invalid_buffer_length)
   EXPECT_EQ(result, -1);
   EXPECT_EQ(errno, EMSGSIZE);
 }
+
+// Test Case: sendmmsg builds every datagram into one batch that is queued once
+TEST(sli_async_socket_unit_tests, sendmmsg_batches_datagrams)
+{
+  RESET_FAKE(sli_get_si91x_socket);
+  RESET_FAKE(sli_si91x_socket_coalesces_writes);
+  RESET_FAKE(sli_si91x_socket_batch_add);
+  RESET_FAKE(sli_si91x_socket_batch_flush);
+  RESET_FAKE(sli_si91x_driver_send_socket_data);
+
+  sli_si91x_socket_t mock_socket;
+  memset(&mock_socket, 0, sizeof(mock_socket));
+  mock_socket.type                                  = SOCK_DGRAM;
+  mock_socket.state                                 = CONNECTED;
+  mock_socket.local_address.sin6_family             = AF_INET;
+  sli_get_si91x_socket_fake.return_val              = &mock_socket;
+  sli_si91x_socket_coalesces_writes_fake.return_val = false;
+  sli_si91x_socket_batch_add_fake.return_val        = SL_STATUS_OK;
+
+  uint8_t header[4]  = { 0 };
+  uint8_t payload[8] = { 0 };
+  struct iovec iov[2];
+  iov[0].iov_base = header;
+  iov[0].iov_len  = sizeof(header);
+  iov[1].iov_base = payload;
+  iov[1].iov_len  = sizeof(payload);
+
+  struct msghdr messages[3];
+  memset(messages, 0, sizeof(messages));
+  for (int i = 0; i < 3; i++) {
+    messages[i].msg_iov    = iov;
+    messages[i].msg_iovlen = 2;
+  }
+
+  int result = sl_si91x_sendmmsg(1, messages, 3, 0);
+
+  EXPECT_EQ(result, 3);
+  EXPECT_EQ(sli_si91x_socket_batch_add_fake.call_count, 3);
+  EXPECT_EQ(sli_si91x_socket_batch_flush_fake.call_count, 1);
+  EXPECT_EQ(sli_si91x_driver_send_socket_data_fake.call_count, 0);
+}
+
+// Test Case: sendmsg validates the socket first and then the gather array in place of a data buffer
+TEST(sli_async_socket_unit_tests, sendmsg_validates_gather_array)
+{
+  RESET_FAKE(sli_get_si91x_socket);
+  RESET_FAKE(sli_si91x_socket_batch_add);
+
+  sli_si91x_socket_t mock_socket;
+  memset(&mock_socket, 0, sizeof(mock_socket));
+  mock_socket.type                     = SOCK_STREAM;
+  mock_socket.state                    = INITIALIZED;
+  sli_get_si91x_socket_fake.return_val = &mock_socket;
+
+  struct msghdr message;
+  memset(&message, 0, sizeof(message));
+  message.msg_iov    = NULL;
+  message.msg_iovlen = 1;
+
+  EXPECT_EQ(sl_si91x_sendmsg(1, &message, 0), -1);
+  EXPECT_EQ(errno, ENOTCONN);
+
+  mock_socket.state = CONNECTED;
+  EXPECT_EQ(sl_si91x_sendmsg(1, &message, 0), -1);
+  EXPECT_EQ(errno, EFAULT);
+
+  struct iovec iov   = { NULL, 4 };
+  message.msg_iov    = &iov;
+  message.msg_iovlen = 1;
+  EXPECT_EQ(sl_si91x_sendmsg(1, &message, 0), -1);
+  EXPECT_EQ(errno, EFAULT);
+  EXPECT_EQ(sli_si91x_socket_batch_add_fake.call_count, 0);
+}
+
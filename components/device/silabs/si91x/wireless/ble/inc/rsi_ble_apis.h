@@ -3874,6 +3874,72 @@ int32_t rsi_ble_set_wo_resp_notify_buf_info(const uint8_t *dev_addr, uint8_t buf
  */
 int32_t rsi_ble_notify_value(const uint8_t *dev_addr, uint16_t handle, uint16_t data_len, const uint8_t *p_data);
 
+/**
+ * @typedef    void (*rsi_ble_on_notify_complete_t)(const uint8_t *dev_addr, uint16_t handle, int32_t status,
+ *                                                 void *context);
+ * @brief      Callback function for queued notifications.
+ *
+ * This callback function is called from the notification task once for every notification queued with
+ * \ref rsi_ble_notify_value_async(), after it has been handed to the controller or dropped.
+ * It has to be registered using the \ref rsi_ble_notify_queue_init API.
+ * @param[out] dev_addr - remote device address (6 bytes)
+ * @param[out] handle   - local attribute handle
+ * @param[out] status   - 0 on success, otherwise the error returned for the notify command.
+ *                        0x4D04 if the link went down before the notification was sent.
+ * @param[out] context  - context passed to \ref rsi_ble_notify_value_async()
+ */
+typedef void (*rsi_ble_on_notify_complete_t)(const uint8_t *dev_addr, uint16_t handle, int32_t status, void *context);
+
+/*==============================================*/
+/**
+ * @fn         int32_t rsi_ble_notify_queue_init(rsi_ble_on_notify_complete_t complete_callback)
+ * @brief      Initialize the queued notification path and start its task. This is a blocking API.
+ * @param[in]  complete_callback - Called once for every queued notification. May be NULL.
+ * @return The following values are returned:
+ *             - 0		-	Success 
+ *             - Non-Zero Value	-	Failure 
+ * @note       The host queue holds RSI_BLE_NOTIFY_QUEUE_DEPTH notifications shared by all connections.
+ */
+int32_t rsi_ble_notify_queue_init(rsi_ble_on_notify_complete_t complete_callback);
+
+/*==============================================*/
+/**
+ * @fn         int32_t rsi_ble_notify_value_async(const uint8_t *dev_addr, uint16_t handle,
+ *                                                uint16_t data_len, const uint8_t *p_data, void *context)
+ * @brief      Queue a notification of the local value to the remote device. This is a non-blocking API.
+ *             Queued notifications are submitted by the notification task, which keeps the controller's buffers
+ *             full and resumes on the \ref rsi_ble_on_le_more_data_req_t event, so the application does not need
+ *             to retry on RSI_ERROR_BLE_DEV_BUF_FULL.
+ * @pre Pre-conditions:
+ *        - \ref rsi_ble_notify_queue_init() and \ref rsi_ble_connect() APIs need to be called before this API.
+ * @param[in]  dev_addr - remote device address
+ * @param[in]  handle 	- local attribute handle
+ * @param[in]  data_len - attribute value length
+ * @param[in]  p_data 	- attribute value, copied before the API returns
+ * @param[in]  context  - passed back in \ref rsi_ble_on_notify_complete_t
+ * @return The following values are returned:
+ *             - 0		-	Success 
+ *             - Non-Zero Value	-	Failure 
+ *             - -2  -  Invalid parameters or the remote device is not connected 
+ *             - -31  -  Host notification queue is full 
+ * @note       Notifications of one connection complete in the order they were queued. Do not mix this API with
+ *             \ref rsi_ble_notify_value() on the same connection.
+ */
+int32_t rsi_ble_notify_value_async(const uint8_t *dev_addr,
+                                   uint16_t handle,
+                                   uint16_t data_len,
+                                   const uint8_t *p_data,
+                                   void *context);
+
+/*==============================================*/
+/**
+ * @fn         uint8_t rsi_ble_notify_queue_count(const uint8_t *dev_addr)
+ * @brief      Get the number of notifications queued on the host for a remote device. This is a non-blocking API.
+ * @param[in]  dev_addr - remote device address
+ * @return     Number of queued notifications
+ */
+uint8_t rsi_ble_notify_queue_count(const uint8_t *dev_addr);
+
 /*==============================================*/
 /**
  * @fn         int32_t rsi_ble_indicate_value(const uint8_t *dev_addr, uint16_t handle,
@@ -40,6 +40,9 @@
 #ifndef NO_OF_ADV_REPORTS
 #define NO_OF_ADV_REPORTS 10 ///< Maximum number of advertise reports to hold.
 #endif
+#ifndef RSI_BLE_NOTIFY_QUEUE_DEPTH
+#define RSI_BLE_NOTIFY_QUEUE_DEPTH 16 ///< Number of notifications queued on the host by rsi_ble_notify_value_async().
+#endif
 #ifndef BLE_CP_BUFF_SIZE_512
 #define BLE_CP_BUFF_SIZE_512 0 ///< Enabled for BLE PER Test.
 #endif
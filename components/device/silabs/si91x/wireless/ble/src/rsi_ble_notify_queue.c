@@ -0,0 +1,384 @@
+/*******************************************************************************
+ * @file  rsi_ble_notify_queue.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifdef __ZEPHYR__
+#include "rsi_bt_common_config.h"
+#else
+#include "ble_config.h"
+#endif
+
+#include "rsi_ble_common_config.h"
+#include "rsi_ble_apis.h"
+#include "rsi_ble.h"
+#include "rsi_bt_common_apis.h"
+#include "rsi_common.h"
+#include "sl_additional_status.h"
+#include "cmsis_os2.h"
+#include <string.h>
+
+/*
+ * Queued notifications
+ *
+ * Notifications passed to rsi_ble_notify_value_async() are copied into a shared pool of slots and chained into a
+ * FIFO per connection. A dedicated task submits them to the controller until the controller reports that the
+ * connection's buffers are full, then parks that connection until the RSI_BLE_EVENT_LE_MORE_DATA_REQ event tops the
+ * buffers up again. The application never polls or retries and is told about every notification through the
+ * completion callback.
+ *
+ * Each notification is still submitted with its own blocking RSI_BLE_CMD_NOTIFY command, as the controller has no
+ * command taking several notifications. Queuing takes that round trip off the application thread, not off the bus.
+ */
+
+#ifndef RSI_BLE_NOTIFY_TASK_STACK_SIZE
+#define RSI_BLE_NOTIFY_TASK_STACK_SIZE 1024
+#endif
+
+#ifndef RSI_BLE_NOTIFY_TASK_PRIORITY
+#define RSI_BLE_NOTIFY_TASK_PRIORITY osPriorityAboveNormal
+#endif
+
+#define RSI_BLE_NOTIFY_MAX_CONNECTIONS (RSI_BLE_MAX_NBR_PERIPHERALS + RSI_BLE_MAX_NBR_CENTRALS)
+#define RSI_BLE_NOTIFY_INVALID_SLOT    0xFF
+
+#define RSI_BLE_NOTIFY_PENDING_EVENT (1 << 0)
+
+typedef struct {
+  rsi_ble_notify_att_value_t notification;
+  void *context;
+  uint8_t next;
+} rsi_ble_notify_slot_t;
+
+typedef struct {
+  uint8_t head;
+  uint8_t tail;
+  uint8_t stalled; // Controller reported no free buffers, wait for the more data event
+  uint8_t resumed; // More data event received while a notification was being submitted
+  uint8_t queued;
+} rsi_ble_notify_conn_queue_t;
+
+static rsi_ble_notify_slot_t notify_slots[RSI_BLE_NOTIFY_QUEUE_DEPTH];
+static rsi_ble_notify_conn_queue_t notify_queues[RSI_BLE_NOTIFY_MAX_CONNECTIONS];
+static uint8_t notify_free_head = RSI_BLE_NOTIFY_INVALID_SLOT;
+
+static osMutexId_t notify_mutex;
+static osEventFlagsId_t notify_events;
+static osThreadId_t notify_thread;
+static rsi_ble_on_notify_complete_t notify_complete_callback;
+
+static int8_t rsi_ble_notify_find_connection(const uint8_t *dev_addr)
+{
+  const rsi_bt_cb_t *le_cb = rsi_driver_cb->ble_cb;
+
+  for (uint8_t inx = 0; inx < RSI_BLE_NOTIFY_MAX_CONNECTIONS; inx++) {
+    if (le_cb->remote_ble_info[inx].used
+        && !memcmp(le_cb->remote_ble_info[inx].remote_dev_bd_addr, dev_addr, RSI_DEV_ADDR_LEN)) {
+      return (int8_t)inx;
+    }
+  }
+  return -1;
+}
+
+// Removes the head of a connection queue and returns its slot, must be called with notify_mutex held
+static uint8_t rsi_ble_notify_pop(rsi_ble_notify_conn_queue_t *queue)
+{
+  uint8_t slot = queue->head;
+
+  if (slot != RSI_BLE_NOTIFY_INVALID_SLOT) {
+    queue->head = notify_slots[slot].next;
+    if (queue->head == RSI_BLE_NOTIFY_INVALID_SLOT) {
+      queue->tail = RSI_BLE_NOTIFY_INVALID_SLOT;
+    }
+    queue->queued--;
+  }
+  return slot;
+}
+
+// Returns a slot to the free list, must be called with notify_mutex held
+static void rsi_ble_notify_release(uint8_t slot)
+{
+  notify_slots[slot].next = notify_free_head;
+  notify_free_head        = slot;
+}
+
+static void rsi_ble_notify_complete(uint8_t slot, int32_t status)
+{
+  if (notify_complete_callback != NULL) {
+    notify_complete_callback(notify_slots[slot].notification.dev_addr,
+                             notify_slots[slot].notification.handle,
+                             status,
+                             notify_slots[slot].context);
+  }
+  osMutexAcquire(notify_mutex, osWaitForever);
+  rsi_ble_notify_release(slot);
+  osMutexRelease(notify_mutex);
+}
+
+// Submits queued notifications for one connection until its queue is empty or the controller is out of buffers
+static void rsi_ble_notify_drain_connection(uint8_t inx)
+{
+  rsi_ble_notify_conn_queue_t *queue = &notify_queues[inx];
+
+  const rsi_remote_ble_info_t *remote = &rsi_driver_cb->ble_cb->remote_ble_info[inx];
+
+  while (queue->head != RSI_BLE_NOTIFY_INVALID_SLOT) {
+    uint8_t slot = queue->head;
+    int32_t status;
+
+    if (!remote->used
+        || memcmp(remote->remote_dev_bd_addr, notify_slots[slot].notification.dev_addr, RSI_DEV_ADDR_LEN)) {
+      // The link went down after this notification was queued
+      status = SL_STATUS_SI91X_BLE_NOT_CONNECTED;
+      osMutexAcquire(notify_mutex, osWaitForever);
+      queue->stalled = 0;
+      osMutexRelease(notify_mutex);
+    } else if (queue->stalled) {
+      break;
+    } else {
+      osMutexAcquire(notify_mutex, osWaitForever);
+      queue->resumed = 0;
+      osMutexRelease(notify_mutex);
+      status = rsi_bt_driver_send_cmd(RSI_BLE_CMD_NOTIFY, &notify_slots[slot].notification, NULL);
+    }
+
+    if ((status == RSI_ERROR_BLE_DEV_BUF_FULL) || (status == RSI_ERROR_BLE_DEV_BUF_IS_IN_PROGRESS)) {
+      // Keep the notification at the head and resume once the controller frees buffers. If the buffers were
+      // already topped up while the command was in flight, the pending event flag retries straight away.
+      osMutexAcquire(notify_mutex, osWaitForever);
+      if (!queue->resumed) {
+        queue->stalled = 1;
+      }
+      osMutexRelease(notify_mutex);
+      break;
+    }
+
+    osMutexAcquire(notify_mutex, osWaitForever);
+    rsi_ble_notify_pop(queue);
+    osMutexRelease(notify_mutex);
+    rsi_ble_notify_complete(slot, status);
+  }
+}
+
+static void rsi_ble_notify_task(void *argument)
+{
+  UNUSED_PARAMETER(argument);
+
+  while (1) {
+    osEventFlagsWait(notify_events, RSI_BLE_NOTIFY_PENDING_EVENT, osFlagsWaitAny, osWaitForever);
+
+    // A stalled connection is skipped so it cannot hold back the others
+    for (uint8_t inx = 0; inx < RSI_BLE_NOTIFY_MAX_CONNECTIONS; inx++) {
+      rsi_ble_notify_drain_connection(inx);
+    }
+  }
+}
+
+/** @addtogroup BT-LOW-ENERGY7
+* @{
+*/
+/*==============================================*/
+/**
+ * @fn         int32_t rsi_ble_notify_queue_init(rsi_ble_on_notify_complete_t complete_callback)
+ * @brief      Initialize the queued notification path used by \ref rsi_ble_notify_value_async().
+ * @param[in]  complete_callback - Called once for every queued notification after it has been handed to the
+ *                                 controller or dropped. May be NULL.
+ * @return     0              - Success \n
+ *             Non-Zero Value - Failure
+ */
+int32_t rsi_ble_notify_queue_init(rsi_ble_on_notify_complete_t complete_callback)
+{
+  notify_complete_callback = complete_callback;
+
+  if (notify_thread != NULL) {
+    return RSI_SUCCESS;
+  }
+
+  notify_mutex  = osMutexNew(NULL);
+  notify_events = osEventFlagsNew(NULL);
+  if ((notify_mutex == NULL) || (notify_events == NULL)) {
+    return RSI_ERROR_PKT_ALLOCATION_FAILURE;
+  }
+
+  notify_free_head = RSI_BLE_NOTIFY_INVALID_SLOT;
+  for (uint8_t slot = 0; slot < RSI_BLE_NOTIFY_QUEUE_DEPTH; slot++) {
+    rsi_ble_notify_release(slot);
+  }
+  for (uint8_t inx = 0; inx < RSI_BLE_NOTIFY_MAX_CONNECTIONS; inx++) {
+    notify_queues[inx].head    = RSI_BLE_NOTIFY_INVALID_SLOT;
+    notify_queues[inx].tail    = RSI_BLE_NOTIFY_INVALID_SLOT;
+    notify_queues[inx].stalled = 0;
+    notify_queues[inx].resumed = 0;
+    notify_queues[inx].queued  = 0;
+  }
+
+  const osThreadAttr_t attr = {
+    .name       = "ble_notify",
+    .priority   = RSI_BLE_NOTIFY_TASK_PRIORITY,
+    .stack_mem  = 0,
+    .stack_size = RSI_BLE_NOTIFY_TASK_STACK_SIZE,
+    .cb_mem     = 0,
+    .cb_size    = 0,
+    .attr_bits  = 0u,
+    .tz_module  = 0u,
+  };
+  notify_thread = osThreadNew(&rsi_ble_notify_task, NULL, &attr);
+  if (notify_thread == NULL) {
+    return RSI_ERROR_PKT_ALLOCATION_FAILURE;
+  }
+  return RSI_SUCCESS;
+}
+
+/*==============================================*/
+/**
+ * @fn         int32_t rsi_ble_notify_value_async(const uint8_t *dev_addr, uint16_t handle,
+ *                                                uint16_t data_len, const uint8_t *p_data, void *context)
+ * @brief      Queue a notification of the local value to the remote device. This is a non-blocking API.
+ *             The value is copied, so the caller may reuse p_data as soon as the API returns.
+ * @pre        \ref rsi_ble_notify_queue_init() and \ref rsi_ble_connect() need to be called before this API.
+ * @param[in]  dev_addr - remote device address
+ * @param[in]  handle   - local attribute handle
+ * @param[in]  data_len - attribute value length
+ * @param[in]  p_data   - attribute value
+ * @param[in]  context  - passed back unchanged in the completion callback
+ * @return     0              - Success \n
+ *             Non-Zero Value - Failure \n
+ *             -31            - RSI_ERROR_BLE_DEV_BUF_FULL, every slot of the host queue is in use
+ * @note       Notifications for one connection complete in the order they were queued. Do not mix this API with
+ *             \ref rsi_ble_notify_value() on the same connection.
+ */
+int32_t rsi_ble_notify_value_async(const uint8_t *dev_addr,
+                                   uint16_t handle,
+                                   uint16_t data_len,
+                                   const uint8_t *p_data,
+                                   void *context)
+{
+  uint8_t addr[RSI_DEV_ADDR_LEN];
+
+  if ((notify_thread == NULL) || (dev_addr == NULL) || (p_data == NULL && data_len != 0)) {
+    return RSI_ERROR_INVALID_PARAM;
+  }
+
+#ifdef BD_ADDR_IN_ASCII
+  rsi_ascii_dev_address_to_6bytes_rev(addr, dev_addr);
+#else
+  memcpy(addr, dev_addr, RSI_DEV_ADDR_LEN);
+#endif
+
+  int8_t inx = rsi_ble_notify_find_connection(addr);
+  if (inx < 0) {
+    return RSI_ERROR_INVALID_PARAM;
+  }
+
+  osMutexAcquire(notify_mutex, osWaitForever);
+  uint8_t slot = notify_free_head;
+  if (slot == RSI_BLE_NOTIFY_INVALID_SLOT) {
+    osMutexRelease(notify_mutex);
+    return RSI_ERROR_BLE_DEV_BUF_FULL;
+  }
+  notify_free_head = notify_slots[slot].next;
+  // Unused bytes of the command must not leak a previous notification's data
+  memset(&notify_slots[slot], 0, sizeof(notify_slots[slot]));
+
+  rsi_ble_notify_att_value_t *notification = &notify_slots[slot].notification;
+  memcpy(notification->dev_addr, addr, RSI_DEV_ADDR_LEN);
+  notification->handle   = handle;
+  notification->data_len = (uint16_t)(RSI_MIN(data_len, sizeof(notification->data)));
+  memcpy(notification->data, p_data, notification->data_len);
+  notify_slots[slot].context = context;
+  notify_slots[slot].next    = RSI_BLE_NOTIFY_INVALID_SLOT;
+
+  rsi_ble_notify_conn_queue_t *queue = &notify_queues[inx];
+  if (queue->tail == RSI_BLE_NOTIFY_INVALID_SLOT) {
+    queue->head = slot;
+  } else {
+    notify_slots[queue->tail].next = slot;
+  }
+  queue->tail = slot;
+  queue->queued++;
+  osMutexRelease(notify_mutex);
+
+  osEventFlagsSet(notify_events, RSI_BLE_NOTIFY_PENDING_EVENT);
+  return RSI_SUCCESS;
+}
+
+/*==============================================*/
+/**
+ * @fn         uint8_t rsi_ble_notify_queue_count(const uint8_t *dev_addr)
+ * @brief      Return the number of notifications queued on the host for a connection.
+ * @param[in]  dev_addr - remote device address
+ * @return     Number of queued notifications
+ */
+uint8_t rsi_ble_notify_queue_count(const uint8_t *dev_addr)
+{
+  uint8_t addr[RSI_DEV_ADDR_LEN];
+
+  if ((notify_thread == NULL) || (dev_addr == NULL)) {
+    return 0;
+  }
+#ifdef BD_ADDR_IN_ASCII
+  rsi_ascii_dev_address_to_6bytes_rev(addr, dev_addr);
+#else
+  memcpy(addr, dev_addr, RSI_DEV_ADDR_LEN);
+#endif
+  int8_t inx = rsi_ble_notify_find_connection(addr);
+  return (inx < 0) ? 0 : notify_queues[inx].queued;
+}
+/** @} */
+
+/**
+ * @brief       Resume a connection's queued notifications after the controller reported free buffers.
+ *              Called from the RSI_BLE_EVENT_LE_MORE_DATA_REQ handler.
+ * @param[in]   remote_dev_bd_addr - remote device address (6 bytes)
+ * @return      void
+ */
+void rsi_ble_notify_queue_resume(const uint8_t *remote_dev_bd_addr)
+{
+  if (notify_thread == NULL) {
+    return;
+  }
+  int8_t inx = rsi_ble_notify_find_connection(remote_dev_bd_addr);
+  if (inx < 0) {
+    return;
+  }
+  osMutexAcquire(notify_mutex, osWaitForever);
+  notify_queues[inx].stalled = 0;
+  notify_queues[inx].resumed = 1;
+  osMutexRelease(notify_mutex);
+  osEventFlagsSet(notify_events, RSI_BLE_NOTIFY_PENDING_EVENT);
+}
+
+/**
+ * @brief       Wake the notification task after a disconnection so it completes the connection's queued
+ *              notifications with SL_STATUS_SI91X_BLE_NOT_CONNECTED. Called from the RSI_BLE_EVENT_DISCONNECT handler.
+ * @return      void
+ */
+void rsi_ble_notify_queue_disconnect(void)
+{
+  if (notify_thread != NULL) {
+    osEventFlagsSet(notify_events, RSI_BLE_NOTIFY_PENDING_EVENT);
+  }
+}
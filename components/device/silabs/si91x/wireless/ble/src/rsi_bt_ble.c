@@ -75,6 +75,8 @@ uint16_t rsi_bt_prepare_common_pkt(uint16_t cmd_type, void *cmd_struct, sl_wifi_
 uint16_t rsi_bt_prepare_le_pkt(uint16_t cmd_type, void *cmd_struct, sl_wifi_system_packet_t *pkt);
 static void rsi_ble_allocate_tx_buffer_check(rsi_bt_cb_t *le_cb, uint8_t inx);
 static void rsi_ble_update_buff_for_err_resp(int32_t status);
+void rsi_ble_notify_queue_resume(const uint8_t *remote_dev_bd_addr);
+void rsi_ble_notify_queue_disconnect(void);
 
 /*
  Global Variables
@@ -1087,6 +1089,7 @@ void rsi_ble_callbacks_handler(rsi_bt_cb_t *ble_cb, uint16_t rsp_type, uint8_t *
         ble_specific_cb->ble_on_disconnect_event((rsi_ble_event_disconnect_t *)payload, status);
       }
       rsi_remove_remote_ble_dev_info((rsi_ble_event_disconnect_t *)payload);
+      rsi_ble_notify_queue_disconnect();
     } break;
     case RSI_BLE_EVENT_GATT_ERROR_RESPONSE: {
       if (ble_specific_cb->ble_on_gatt_error_resp_event != NULL) {
@@ -1366,6 +1369,7 @@ void rsi_ble_callbacks_handler(rsi_bt_cb_t *ble_cb, uint16_t rsp_type, uint8_t *
     } break;
     case RSI_BLE_EVENT_LE_MORE_DATA_REQ: {
       rsi_ble_update_le_dev_buf((rsi_ble_event_le_dev_buf_ind_t *)payload);
+      rsi_ble_notify_queue_resume(((rsi_ble_event_le_dev_buf_ind_t *)payload)->remote_dev_bd_addr);
       if (ble_specific_cb->ble_on_le_more_data_req_event != NULL) {
         ble_specific_cb->ble_on_le_more_data_req_event((rsi_ble_event_le_dev_buf_ind_t *)payload);
       }
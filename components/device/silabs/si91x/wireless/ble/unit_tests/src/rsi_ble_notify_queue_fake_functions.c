@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include "rsi_ble_notify_queue_fake_functions.h"
+
+DEFINE_FFF_GLOBALS;
+
+const uint8_t test_remote_address[RSI_DEV_ADDR_LEN] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+
+static rsi_bt_cb_t ble_cb;
+static rsi_driver_cb_t driver_cb = { .ble_cb = &ble_cb };
+rsi_driver_cb_t *rsi_driver_cb   = &driver_cb;
+
+DEFINE_FAKE_VALUE_FUNC3(int32_t, rsi_bt_driver_send_cmd, uint16_t, void *, void *);
+DEFINE_FAKE_VALUE_FUNC1(osMutexId_t, osMutexNew, const osMutexAttr_t *);
+DEFINE_FAKE_VALUE_FUNC2(osStatus_t, osMutexAcquire, osMutexId_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osMutexRelease, osMutexId_t);
+DEFINE_FAKE_VALUE_FUNC1(osEventFlagsId_t, osEventFlagsNew, const osEventFlagsAttr_t *);
+DEFINE_FAKE_VALUE_FUNC2(uint32_t, osEventFlagsSet, osEventFlagsId_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC4(uint32_t, osEventFlagsWait, osEventFlagsId_t, uint32_t, uint32_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC3(osThreadId_t, osThreadNew, osThreadFunc_t, void *, const osThreadAttr_t *);
@@ -0,0 +1,292 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <csetjmp>
+#include <cstring>
+#include <deque>
+#include <vector>
+#include "fff.h"
+
+extern "C" {
+#include "rsi_ble_notify_queue_fake_functions.h"
+}
+
+#define TEST_NOTIFY_TASK ((osThreadId_t)(uintptr_t)0x1)
+
+typedef struct {
+  uint16_t handle;
+  int32_t status;
+  void *context;
+} test_completion_t;
+
+// The notification task never returns, so a run is left with a long jump once its pending events are handled
+static jmp_buf task_exit;
+static osThreadFunc_t notify_task;
+static uint32_t pending_events;
+
+static std::vector<rsi_ble_notify_att_value_t> sent_notifications;
+static std::deque<int32_t> send_status;
+static std::vector<test_completion_t> completions;
+
+static osThreadId_t thread_new_record(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr)
+{
+  (void)argument;
+  (void)attr;
+  notify_task = func;
+  return TEST_NOTIFY_TASK;
+}
+
+static uint32_t event_flags_set(osEventFlagsId_t ef_id, uint32_t flags)
+{
+  (void)ef_id;
+  pending_events |= flags;
+  return pending_events;
+}
+
+static uint32_t event_flags_wait(osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  (void)ef_id;
+  (void)options;
+  (void)timeout;
+  uint32_t set = pending_events & flags;
+  if (set == 0) {
+    longjmp(task_exit, 1);
+  }
+  pending_events &= ~set;
+  return set;
+}
+
+// Hands the notification to the controller, which answers with the next queued status or success
+static int32_t send_cmd_record(uint16_t cmd, void *cmd_struct, void *resp)
+{
+  (void)resp;
+  EXPECT_EQ(cmd, RSI_BLE_CMD_NOTIFY);
+  sent_notifications.push_back(*(const rsi_ble_notify_att_value_t *)cmd_struct);
+  if (send_status.empty()) {
+    return RSI_SUCCESS;
+  }
+  int32_t status = send_status.front();
+  send_status.pop_front();
+  return status;
+}
+
+static void notify_complete_record(const uint8_t *dev_addr, uint16_t handle, int32_t status, void *context)
+{
+  EXPECT_EQ(0, memcmp(dev_addr, test_remote_address, RSI_DEV_ADDR_LEN));
+  completions.push_back({ handle, status, context });
+}
+
+class rsi_ble_notify_queue_test : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    FFF_RESET_HISTORY();
+    RESET_FAKE(rsi_bt_driver_send_cmd);
+    RESET_FAKE(osMutexNew);
+    RESET_FAKE(osEventFlagsNew);
+    RESET_FAKE(osEventFlagsSet);
+    RESET_FAKE(osEventFlagsWait);
+    RESET_FAKE(osThreadNew);
+    osMutexNew_fake.return_val              = (osMutexId_t)&pending_events;
+    osEventFlagsNew_fake.return_val         = (osEventFlagsId_t)&pending_events;
+    osThreadNew_fake.custom_fake            = thread_new_record;
+    osEventFlagsSet_fake.custom_fake        = event_flags_set;
+    osEventFlagsWait_fake.custom_fake       = event_flags_wait;
+    rsi_bt_driver_send_cmd_fake.custom_fake = send_cmd_record;
+    pending_events                          = 0;
+    sent_notifications.clear();
+    send_status.clear();
+    completions.clear();
+
+    connect();
+    ASSERT_EQ(RSI_SUCCESS, rsi_ble_notify_queue_init(notify_complete_record));
+    ASSERT_TRUE(notify_task != NULL);
+  }
+
+  void TearDown() override
+  {
+    // Completes whatever a test left queued, so every slot is free for the next test
+    send_status.clear();
+    disconnect();
+    rsi_ble_notify_queue_disconnect();
+    run_notify_task();
+    connect();
+    EXPECT_EQ(0, rsi_ble_notify_queue_count(test_remote_address));
+  }
+
+  static void connect(void)
+  {
+    rsi_driver_cb->ble_cb->remote_ble_info[0].used = 1;
+    memcpy(rsi_driver_cb->ble_cb->remote_ble_info[0].remote_dev_bd_addr, test_remote_address, RSI_DEV_ADDR_LEN);
+  }
+
+  static void disconnect(void)
+  {
+    rsi_driver_cb->ble_cb->remote_ble_info[0].used = 0;
+  }
+
+  // Runs the notification task until it has handled every pending event
+  static void run_notify_task(void)
+  {
+    if (setjmp(task_exit) == 0) {
+      notify_task(NULL);
+    }
+  }
+
+  static int32_t notify(uint16_t handle, uint16_t data_len, const uint8_t *data)
+  {
+    return rsi_ble_notify_value_async(test_remote_address, handle, data_len, data, (void *)(uintptr_t)handle);
+  }
+};
+
+// Test case: Notifications are handed to the controller and completed in the order they were queued
+TEST_F(rsi_ble_notify_queue_test, NotificationsCompleteInQueuedOrder)
+{
+  const uint8_t data[] = { 0x01, 0x02 };
+
+  for (uint16_t handle = 1; handle <= 3; handle++) {
+    ASSERT_EQ(RSI_SUCCESS, notify(handle, sizeof(data), data));
+  }
+  EXPECT_EQ(3, rsi_ble_notify_queue_count(test_remote_address));
+  EXPECT_EQ(rsi_bt_driver_send_cmd_fake.call_count, 0);
+
+  run_notify_task();
+
+  ASSERT_EQ(3U, sent_notifications.size());
+  ASSERT_EQ(3U, completions.size());
+  for (uint16_t n = 0; n < 3; n++) {
+    EXPECT_EQ(n + 1, sent_notifications[n].handle);
+    EXPECT_EQ(0, memcmp(sent_notifications[n].data, data, sizeof(data)));
+    EXPECT_EQ(n + 1, completions[n].handle);
+    EXPECT_EQ(RSI_SUCCESS, completions[n].status);
+    EXPECT_EQ((void *)(uintptr_t)(n + 1), completions[n].context);
+  }
+  EXPECT_EQ(0, rsi_ble_notify_queue_count(test_remote_address));
+}
+
+// Test case: A notification is refused once every slot of the host queue is in use
+TEST_F(rsi_ble_notify_queue_test, FullQueueIsReported)
+{
+  const uint8_t data[] = { 0x01 };
+
+  for (uint16_t handle = 1; handle <= RSI_BLE_NOTIFY_QUEUE_DEPTH; handle++) {
+    ASSERT_EQ(RSI_SUCCESS, notify(handle, sizeof(data), data));
+  }
+  EXPECT_EQ(RSI_ERROR_BLE_DEV_BUF_FULL, notify(RSI_BLE_NOTIFY_QUEUE_DEPTH + 1, sizeof(data), data));
+  EXPECT_EQ(RSI_BLE_NOTIFY_QUEUE_DEPTH, rsi_ble_notify_queue_count(test_remote_address));
+
+  // Completed notifications free their slots again
+  run_notify_task();
+  EXPECT_EQ((size_t)RSI_BLE_NOTIFY_QUEUE_DEPTH, completions.size());
+  EXPECT_EQ(RSI_SUCCESS, notify(RSI_BLE_NOTIFY_QUEUE_DEPTH + 1, sizeof(data), data));
+}
+
+// Test case: A reused slot does not send bytes of the notification it held before
+TEST_F(rsi_ble_notify_queue_test, ReusedSlotIsCleared)
+{
+  uint8_t long_data[10];
+  const uint8_t short_data[] = { 0x01, 0x02 };
+  memset(long_data, 0xAA, sizeof(long_data));
+
+  ASSERT_EQ(RSI_SUCCESS, notify(1, sizeof(long_data), long_data));
+  run_notify_task();
+  ASSERT_EQ(RSI_SUCCESS, notify(2, sizeof(short_data), short_data));
+  run_notify_task();
+
+  ASSERT_EQ(2U, sent_notifications.size());
+  const rsi_ble_notify_att_value_t *sent = &sent_notifications[1];
+  EXPECT_EQ(sizeof(short_data), sent->data_len);
+  EXPECT_EQ(0, memcmp(sent->data, short_data, sizeof(short_data)));
+  for (size_t n = sizeof(short_data); n < sizeof(long_data); n++) {
+    EXPECT_EQ(0, sent->data[n]) << "byte " << n;
+  }
+}
+
+// Test case: A connection out of controller buffers keeps its order and resumes on the more data event
+TEST_F(rsi_ble_notify_queue_test, StalledConnectionResumesInOrder)
+{
+  const uint8_t data[] = { 0x01 };
+
+  for (uint16_t handle = 1; handle <= 3; handle++) {
+    ASSERT_EQ(RSI_SUCCESS, notify(handle, sizeof(data), data));
+  }
+  send_status.push_back(RSI_SUCCESS);
+  send_status.push_back(RSI_ERROR_BLE_DEV_BUF_FULL);
+
+  run_notify_task();
+  ASSERT_EQ(1U, completions.size());
+  EXPECT_EQ(2, rsi_ble_notify_queue_count(test_remote_address));
+
+  // Another notification does not retry the stalled connection
+  ASSERT_EQ(RSI_SUCCESS, notify(4, sizeof(data), data));
+  run_notify_task();
+  EXPECT_EQ(2U, sent_notifications.size());
+
+  rsi_ble_notify_queue_resume(test_remote_address);
+  run_notify_task();
+
+  ASSERT_EQ(4U, completions.size());
+  for (uint16_t n = 0; n < 4; n++) {
+    EXPECT_EQ(n + 1, completions[n].handle);
+    EXPECT_EQ(RSI_SUCCESS, completions[n].status);
+  }
+  EXPECT_EQ(2, sent_notifications[2].handle);
+}
+
+// Test case: Notifications queued when the link goes down complete with an error and are not sent
+TEST_F(rsi_ble_notify_queue_test, DisconnectCompletesQueuedNotifications)
+{
+  const uint8_t data[] = { 0x01 };
+
+  ASSERT_EQ(RSI_SUCCESS, notify(1, sizeof(data), data));
+  ASSERT_EQ(RSI_SUCCESS, notify(2, sizeof(data), data));
+  disconnect();
+  rsi_ble_notify_queue_disconnect();
+  run_notify_task();
+
+  EXPECT_EQ(rsi_bt_driver_send_cmd_fake.call_count, 0);
+  ASSERT_EQ(2U, completions.size());
+  EXPECT_EQ(1, completions[0].handle);
+  EXPECT_EQ(SL_STATUS_SI91X_BLE_NOT_CONNECTED, completions[0].status);
+  EXPECT_EQ(2, completions[1].handle);
+  EXPECT_EQ(SL_STATUS_SI91X_BLE_NOT_CONNECTED, completions[1].status);
+}
+
+// Test case: Notifications for an unknown device or without data are refused
+TEST_F(rsi_ble_notify_queue_test, InvalidNotificationIsRefused)
+{
+  const uint8_t unknown_address[RSI_DEV_ADDR_LEN] = { 0 };
+  const uint8_t data[]                            = { 0x01 };
+
+  EXPECT_EQ(RSI_ERROR_INVALID_PARAM, rsi_ble_notify_value_async(unknown_address, 1, sizeof(data), data, NULL));
+  EXPECT_EQ(RSI_ERROR_INVALID_PARAM, rsi_ble_notify_value_async(NULL, 1, sizeof(data), data, NULL));
+  EXPECT_EQ(RSI_ERROR_INVALID_PARAM, notify(1, sizeof(data), NULL));
+  EXPECT_EQ(0, rsi_ble_notify_queue_count(test_remote_address));
+}
@@ -32,7 +32,11 @@
 #include "sl_si91x_protocol_types.h"
 #include "sl_si91x_host_interface.h"
 #include "sl_si91x_driver.h"
+#include "sl_si91x_core_utilities.h"
+#include "sl_rsi_utility.h"
+#include "sl_cmsis_utility.h"
 #include <string.h>
+#include <stdlib.h>
 #include "firmware_upgradation.h"
 #include <sl_string.h>
 
@@ -367,19 +371,318 @@ sl_status_t sl_si91x_fwup_abort()
   return status;
 }
 
+/******************************************************
+ *               Firmware Update Loader
+ ******************************************************/
+
+// Loader whose queued chunks are acknowledged by the WLAN event handler
+static sl_si91x_fwup_loader_t *volatile active_fwup_loader = NULL;
+
+// Records the response to the oldest queued chunk. Runs in the WLAN event handler context.
+static void sli_fwup_loader_handle_response(sl_status_t status)
+{
+  sl_si91x_fwup_loader_t *loader = active_fwup_loader;
+
+  if (loader == NULL) {
+    return;
+  }
+
+  loader->chunk_status[loader->received_chunks % SL_SI91X_FWUP_LOADER_MAX_WINDOW] = status;
+  loader->received_chunks++;
+  osSemaphoreRelease(loader->response_semaphore);
+}
+
+// Reads the next chunk of the firmware file straight into a command buffer and queues it to the NWP
+static sl_status_t sli_fwup_loader_submit(sl_si91x_fwup_loader_t *loader)
+{
+  const sl_si91x_fwup_loader_configuration_t *configuration = &loader->configuration;
+  sl_wifi_buffer_t *buffer                                  = NULL;
+  sl_wifi_system_packet_t *packet                           = NULL;
+  sli_si91x_req_fwup_t *fwup                                = NULL;
+  uint32_t offset                                           = loader->submitted_offset;
+  uint32_t remaining                                        = configuration->image_size - offset;
+  uint16_t type                                             = SL_FWUP_RPS_CONTENT;
+  uint16_t length                                           = SLI_RPS_HEADER_SIZE;
+  sl_status_t status;
+
+  // The RPS header is sent in a chunk of its own
+  if (offset == 0) {
+    type = SL_FWUP_RPS_HEADER;
+  } else {
+    length = (uint16_t)((remaining < SLI_MAX_FWUP_CHUNK_SIZE) ? remaining : SLI_MAX_FWUP_CHUNK_SIZE);
+  }
+
+  status = sli_si91x_allocate_command_buffer(&buffer,
+                                             (void **)&packet,
+                                             sizeof(sl_wifi_system_packet_t) + sizeof(sli_si91x_req_fwup_t),
+                                             SLI_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME);
+  VERIFY_STATUS_AND_RETURN(status);
+
+  fwup   = (sli_si91x_req_fwup_t *)packet->data;
+  status = configuration->read(offset, fwup->content, length, configuration->context);
+
+  // A chunk read again after an error was already added to the integrity check
+  if ((status == SL_STATUS_OK) && (configuration->hash_update != NULL) && (offset + length > loader->hashed_offset)) {
+    uint32_t hashed = loader->hashed_offset - offset;
+    configuration->hash_update(&fwup->content[hashed], (uint16_t)(length - hashed), configuration->context);
+    loader->hashed_offset = offset + length;
+  }
+
+  // The NWP installs the firmware once it has the last chunk, so check the image before sending it
+  if ((status == SL_STATUS_OK) && (configuration->verify != NULL) && (length == remaining)) {
+    status = configuration->verify(configuration->context);
+  }
+
+  if (status != SL_STATUS_OK) {
+    sli_si91x_host_free_buffer(buffer);
+    return status;
+  }
+
+  // Fill packet type and length
+  memcpy(&fwup->type, &type, sizeof(fwup->type));
+  memcpy(&fwup->length, &length, sizeof(fwup->length));
+  memset(&fwup->content[length], 0, SLI_MAX_FWUP_CHUNK_SIZE - length);
+
+  memset(packet->desc, 0, sizeof(packet->desc));
+  packet->length  = sizeof(sli_si91x_req_fwup_t) & 0xFFF;
+  packet->command = SLI_WLAN_REQ_FWUP;
+
+  // The response is passed to sli_fwup_loader_handle_response()
+  status = sli_si91x_driver_send_command_packet(SLI_WLAN_REQ_FWUP,
+                                                SLI_WIFI_WLAN_CMD,
+                                                buffer,
+                                                SLI_WIFI_RETURN_IMMEDIATELY,
+                                                NULL,
+                                                NULL);
+  if (status != SL_STATUS_IN_PROGRESS) {
+    return status;
+  }
+
+  loader->chunk_length[loader->submitted_chunks % SL_SI91X_FWUP_LOADER_MAX_WINDOW] = length;
+  loader->submitted_chunks++;
+  loader->submitted_offset += length;
+
+  return SL_STATUS_OK;
+}
+
+// Waits for the response to the oldest queued chunk
+static sl_status_t sli_fwup_loader_process_response(sl_si91x_fwup_loader_t *loader)
+{
+  uint32_t index = loader->processed_chunks % SL_SI91X_FWUP_LOADER_MAX_WINDOW;
+
+  if (osSemaphoreAcquire(loader->response_semaphore, SLI_SYSTEM_MS_TO_TICKS(SLI_WLAN_RSP_FWUP_WAIT_TIME)) != osOK) {
+    return SL_STATUS_TIMEOUT;
+  }
+  loader->processed_chunks++;
+
+  // Chunks do not carry their offset, so nothing after a rejected chunk counts
+  if (loader->error != SL_STATUS_OK) {
+    return SL_STATUS_OK;
+  }
+
+  // The NWP reports SL_STATUS_SI91X_FW_UPDATE_DONE for the last chunk
+  if ((loader->chunk_status[index] == SL_STATUS_OK)
+      || (loader->chunk_status[index] == SL_STATUS_SI91X_FW_UPDATE_DONE)) {
+    loader->acknowledged_offset += loader->chunk_length[index];
+  } else {
+    loader->error = loader->chunk_status[index];
+  }
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_si91x_fwup_loader_init(sl_si91x_fwup_loader_t *loader,
+                                      const sl_si91x_fwup_loader_configuration_t *configuration)
+{
+  SL_VERIFY_POINTER_OR_RETURN(loader, SL_STATUS_NULL_POINTER);
+  SL_VERIFY_POINTER_OR_RETURN(configuration, SL_STATUS_NULL_POINTER);
+  SL_VERIFY_POINTER_OR_RETURN(configuration->read, SL_STATUS_NULL_POINTER);
+
+  if ((configuration->image_size <= SLI_RPS_HEADER_SIZE) || (configuration->window == 0)
+      || (configuration->window > SL_SI91X_FWUP_LOADER_MAX_WINDOW)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  if (active_fwup_loader != NULL) {
+    return SL_STATUS_BUSY;
+  }
+
+  memset(loader, 0, sizeof(sl_si91x_fwup_loader_t));
+  loader->configuration      = *configuration;
+  loader->response_semaphore = osSemaphoreNew(SL_SI91X_FWUP_LOADER_MAX_WINDOW, 0, NULL);
+  if (loader->response_semaphore == NULL) {
+    return SL_STATUS_ALLOCATION_FAILED;
+  }
+
+  active_fwup_loader = loader;
+  sli_si91x_set_fwup_response_handler(sli_fwup_loader_handle_response);
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_si91x_fwup_loader_run(sl_si91x_fwup_loader_t *loader)
+{
+  SL_VERIFY_POINTER_OR_RETURN(loader, SL_STATUS_NULL_POINTER);
+
+  if (loader != active_fwup_loader) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  sl_status_t status  = SL_STATUS_OK;
+  uint32_t image_size = loader->configuration.image_size;
+
+  // A rejected chunk ends the update
+  if ((loader->error != SL_STATUS_OK) && (loader->submitted_chunks == loader->processed_chunks)) {
+    return loader->error;
+  }
+
+  while (loader->acknowledged_offset < image_size) {
+    // Keep the window full, the NWP gets the next chunk as soon as it acknowledges the previous one
+    while ((loader->error == SL_STATUS_OK) && (loader->submitted_offset < image_size)
+           && ((loader->submitted_chunks - loader->processed_chunks) < loader->configuration.window)) {
+      status = sli_fwup_loader_submit(loader);
+      VERIFY_STATUS_AND_RETURN(status);
+    }
+
+    status = sli_fwup_loader_process_response(loader);
+    VERIFY_STATUS_AND_RETURN(status);
+
+    // Return the rejection once every chunk queued after it is answered
+    if ((loader->error != SL_STATUS_OK) && (loader->submitted_chunks == loader->processed_chunks)) {
+      return loader->error;
+    }
+  }
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_si91x_fwup_loader_deinit(sl_si91x_fwup_loader_t *loader)
+{
+  SL_VERIFY_POINTER_OR_RETURN(loader, SL_STATUS_NULL_POINTER);
+
+  if (loader != active_fwup_loader) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  sli_si91x_set_fwup_response_handler(NULL);
+  active_fwup_loader = NULL;
+  osSemaphoreDelete(loader->response_semaphore);
+  loader->response_semaphore = NULL;
+
+  return SL_STATUS_OK;
+}
+
 #ifndef SLI_SI91X_MCU_INTERFACE /* Only for NCP mode */
+// Next PING or PONG buffer state of the bootloader, kept between chunks of sl_si91x_bl_upgrade_firmware()
+static uint16_t bl_boot_cmd = 0;
+
+// Issues a boot instruction, retrying failed bus transfers with a growing pause
+static sl_status_t sli_si91x_bl_boot_instruction(uint8_t type, uint16_t *data)
+{
+  sl_status_t status;
+  uint32_t delay_ms = 1;
+
+  for (uint8_t retry = 0;; retry++) {
+    status = sli_si91x_boot_instruction(type, data);
+    if ((status == SL_STATUS_OK) || (retry >= SL_SI91X_BL_BUS_RETRY_COUNT)) {
+      return status;
+    }
+    sl_si91x_host_delay_ms(delay_ms);
+    delay_ms *= 2;
+  }
+}
+
+// Waits for the bootloader to report the expected state. The bootloader has no interrupt for this,
+// so the pause between reads doubles up to SL_SI91X_BL_POLL_MAX_INTERVAL_MS to leave the bus and CPU free.
+static sl_status_t sli_si91x_bl_wait_for_state(uint16_t state, uint32_t timeout_ms)
+{
+  sl_status_t status;
+  uint16_t read_value                 = 0;
+  uint32_t interval_ms                = 1;
+  sl_si91x_host_timestamp_t timestamp = sl_si91x_host_get_timestamp();
+
+  while (1) {
+    status = sli_si91x_bl_boot_instruction(SLI_REG_READ, &read_value);
+    VERIFY_STATUS_AND_RETURN(status);
+
+    if (read_value == (SLI_HOST_INTERACT_REG_VALID | state)) {
+      return SL_STATUS_OK;
+    }
+    if (sl_si91x_host_elapsed_time(timestamp) >= timeout_ms) {
+      return SL_STATUS_TIMEOUT;
+    }
+
+    sl_si91x_host_delay_ms(interval_ms);
+    if (interval_ms < SL_SI91X_BL_POLL_MAX_INTERVAL_MS) {
+      interval_ms *= 2;
+    }
+  }
+}
+
+// Writes a 4 KB chunk to the free PING or PONG buffer and returns the state that reports it taken
+static sl_status_t sli_si91x_bl_send_chunk(const uint8_t *chunk, uint16_t *poll_resp)
+{
+  sl_status_t status;
+  uint32_t boot_insn = 0;
+  uint16_t next_cmd  = 0;
+
+  switch (bl_boot_cmd) {
+    case (SLI_HOST_INTERACT_REG_VALID | SLI_PING_VALID):
+      boot_insn  = SLI_PONG_WRITE;
+      *poll_resp = SLI_PING_AVAIL;
+      next_cmd   = SLI_HOST_INTERACT_REG_VALID | SLI_PONG_VALID;
+      break;
+
+    case (SLI_HOST_INTERACT_REG_VALID | SLI_PONG_VALID):
+      boot_insn  = SLI_PING_WRITE;
+      *poll_resp = SLI_PONG_AVAIL;
+      next_cmd   = SLI_HOST_INTERACT_REG_VALID | SLI_PING_VALID;
+      break;
+
+    default:
+      return SL_STATUS_FAIL;
+  }
+
+  status = sli_si91x_bl_boot_instruction((uint8_t)boot_insn, (uint16_t *)chunk);
+  VERIFY_STATUS_AND_RETURN(status);
+
+  bl_boot_cmd = next_cmd;
+  return SL_STATUS_OK;
+}
+
+// Marks the end of the file and waits for the bootloader to install the firmware
+static sl_status_t sli_si91x_bl_finish(void)
+{
+  sl_status_t status;
+
+  bl_boot_cmd = SLI_HOST_INTERACT_REG_VALID | SLI_EOF_REACHED;
+  status      = sli_si91x_bl_boot_instruction(SLI_REG_WRITE, &bl_boot_cmd);
+  VERIFY_STATUS_AND_RETURN(status);
+
+  return sli_si91x_bl_wait_for_state(SLI_FWUP_SUCCESSFUL, SL_SI91X_BL_UPGRADE_TIMEOUT_MS);
+}
+
+// Reads one chunk of the firmware file, padding the last one with zeros
+static sl_status_t sli_si91x_bl_read_chunk(const sl_si91x_bl_upgrade_configuration_t *configuration,
+                                           uint32_t offset,
+                                           uint8_t *chunk)
+{
+  uint32_t remaining = configuration->image_size - offset;
+  uint16_t length    = (uint16_t)((remaining < SLI_SI91X_MIN_CHUNK_SIZE) ? remaining : SLI_SI91X_MIN_CHUNK_SIZE);
+
+  memset(&chunk[length], 0, SLI_SI91X_MIN_CHUNK_SIZE - length);
+  return configuration->read(offset, chunk, length, configuration->context);
+}
+
 sl_status_t sl_si91x_bl_upgrade_firmware(uint8_t *firmware_image, uint32_t fw_image_size, uint8_t flags)
 {
-  static uint16_t boot_cmd = 0;
-  uint16_t read_value      = 0;
-  uint32_t offset          = 0;
-  uint32_t retval          = 0;
-  uint32_t boot_insn       = 0;
-  uint32_t poll_resp       = 0;
+  sl_status_t retval = SL_STATUS_OK;
+  uint32_t offset    = 0;
+  uint16_t poll_resp = 0;
 
   //! If it is a start of file set the boot cmd to pong valid
   if (flags & SLI_SI91X_FW_START_OF_FILE) {
-    boot_cmd = SLI_HOST_INTERACT_REG_VALID | SLI_PONG_VALID;
+    bl_boot_cmd = SLI_HOST_INTERACT_REG_VALID | SLI_PONG_VALID;
   }
 
   //! check for invalid packet
@@ -389,52 +692,70 @@ sl_status_t sl_si91x_bl_upgrade_firmware(uint8_t *firmware_image, uint32_t fw_im
 
   //! loop to execute multiple of 4K chunks
   while (offset < fw_image_size) {
-    switch (boot_cmd) {
-      case (SLI_HOST_INTERACT_REG_VALID | SLI_PING_VALID):
-        boot_insn = SLI_PONG_WRITE;
-        poll_resp = SLI_PING_AVAIL;
-        boot_cmd  = SLI_HOST_INTERACT_REG_VALID | SLI_PONG_VALID;
-        break;
-
-      case (SLI_HOST_INTERACT_REG_VALID | SLI_PONG_VALID):
-        boot_insn = SLI_PING_WRITE;
-        poll_resp = SLI_PONG_AVAIL;
-        boot_cmd  = SLI_HOST_INTERACT_REG_VALID | SLI_PING_VALID;
-        break;
-
-      default:
-        return SL_STATUS_FAIL;
-    }
-
-    retval = sli_si91x_boot_instruction((uint8_t)boot_insn, (uint16_t *)(firmware_image + offset));
+    retval = sli_si91x_bl_send_chunk(firmware_image + offset, &poll_resp);
     VERIFY_STATUS_AND_RETURN(retval);
 
-    while (1) {
-      retval = sli_si91x_boot_instruction(SLI_REG_READ, &read_value);
-      VERIFY_STATUS_AND_RETURN(retval);
+    retval = sli_si91x_bl_wait_for_state(poll_resp, SL_SI91X_BL_CHUNK_TIMEOUT_MS);
+    VERIFY_STATUS_AND_RETURN(retval);
 
-      if (read_value == (SLI_HOST_INTERACT_REG_VALID | poll_resp)) {
-        break;
-      }
-    }
     offset += SLI_SI91X_MIN_CHUNK_SIZE;
   }
 
-  //! For last chunk set boot cmd as End of file reached
+  //! For last chunk set boot cmd as End of file reached and check for successful firmware upgrade
   if (flags & SLI_SI91X_FW_END_OF_FILE) {
-    boot_cmd = SLI_HOST_INTERACT_REG_VALID | SLI_EOF_REACHED;
+    retval = sli_si91x_bl_finish();
+  }
+  return retval;
+}
 
-    retval = sli_si91x_boot_instruction(SLI_REG_WRITE, &boot_cmd);
-    VERIFY_STATUS_AND_RETURN(retval);
+sl_status_t sl_si91x_bl_upgrade_firmware_from_source(const sl_si91x_bl_upgrade_configuration_t *configuration)
+{
+  sl_status_t status = SL_STATUS_OK;
+  uint32_t offset    = 0;
+  uint16_t poll_resp = 0;
+  uint8_t *chunk     = NULL;
+
+  SL_VERIFY_POINTER_OR_RETURN(configuration, SL_STATUS_NULL_POINTER);
+  SL_VERIFY_POINTER_OR_RETURN(configuration->read, SL_STATUS_NULL_POINTER);
+  if (configuration->image_size == 0) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  chunk = (uint8_t *)malloc(SLI_SI91X_MIN_CHUNK_SIZE);
+  if (chunk == NULL) {
+    return SL_STATUS_ALLOCATION_FAILED;
+  }
 
-    //! check for successful firmware upgrade
-    do {
-      retval = sli_si91x_boot_instruction(SLI_REG_READ, &read_value);
-      VERIFY_STATUS_AND_RETURN(retval);
+  bl_boot_cmd = SLI_HOST_INTERACT_REG_VALID | SLI_PONG_VALID;
+  status      = sli_si91x_bl_read_chunk(configuration, 0, chunk);
 
-    } while (read_value != (SLI_HOST_INTERACT_REG_VALID | SLI_FWUP_SUCCESSFUL));
+  while ((status == SL_STATUS_OK) && (offset < configuration->image_size)) {
+    status = sli_si91x_bl_send_chunk(chunk, &poll_resp);
+    if (status != SL_STATUS_OK) {
+      break;
+    }
+
+    // The chunk is in the bootloader's PING or PONG buffer now, read the next one while it is written to flash
+    offset += SLI_SI91X_MIN_CHUNK_SIZE;
+    if (offset < configuration->image_size) {
+      status = sli_si91x_bl_read_chunk(configuration, offset, chunk);
+      if (status != SL_STATUS_OK) {
+        break;
+      }
+    } else {
+      offset = configuration->image_size;
+    }
+
+    status = sli_si91x_bl_wait_for_state(poll_resp, SL_SI91X_BL_CHUNK_TIMEOUT_MS);
+    if ((status == SL_STATUS_OK) && (configuration->progress != NULL)) {
+      configuration->progress(offset, configuration->image_size, configuration->context);
+    }
   }
-  return retval;
+
+  free(chunk);
+  VERIFY_STATUS_AND_RETURN(status);
+
+  return sli_si91x_bl_finish();
 }
 
 sl_status_t sl_si91x_set_fast_fw_up(void)
@@ -31,6 +31,32 @@
 
 #include "sl_status.h"
 #include "sl_constants.h"
+#include "cmsis_os2.h"
+
+/// Maximum number of firmware chunks the firmware update loader keeps queued to the NWP.
+#ifndef SL_SI91X_FWUP_LOADER_MAX_WINDOW
+#define SL_SI91X_FWUP_LOADER_MAX_WINDOW 4
+#endif
+
+/// Time in milliseconds the bootloader gets to take a 4 KB chunk before a bootloader upgrade fails with SL_STATUS_TIMEOUT.
+#ifndef SL_SI91X_BL_CHUNK_TIMEOUT_MS
+#define SL_SI91X_BL_CHUNK_TIMEOUT_MS 5000
+#endif
+
+/// Time in milliseconds the bootloader gets to install the firmware after the last chunk.
+#ifndef SL_SI91X_BL_UPGRADE_TIMEOUT_MS
+#define SL_SI91X_BL_UPGRADE_TIMEOUT_MS 60000
+#endif
+
+/// Longest pause in milliseconds between two reads of the bootloader state.
+#ifndef SL_SI91X_BL_POLL_MAX_INTERVAL_MS
+#define SL_SI91X_BL_POLL_MAX_INTERVAL_MS 4
+#endif
+
+/// Number of times a failed bus transfer with the bootloader is retried.
+#ifndef SL_SI91X_BL_BUS_RETRY_COUNT
+#define SL_SI91X_BL_BUS_RETRY_COUNT 3
+#endif
 
 /** \addtogroup SL_SI91X_TYPES
  * @{
@@ -171,7 +197,7 @@ sl_status_t sl_si91x_fwup_abort(void);
  * @details
  *   This function flashes the firmware to the Wi-Fi module using the bootloader. The firmware image, its size, and the position flags are provided as parameters.
  * 
- *  This is a blocking API.
+ *  This is a blocking API. It waits at most SL_SI91X_BL_CHUNK_TIMEOUT_MS for each 4 KB chunk and SL_SI91X_BL_UPGRADE_TIMEOUT_MS for the installation.
  * 
  * @param[in] firmware_image
  *   Pointer to the firmware image.
@@ -222,6 +248,210 @@ sl_status_t sl_si91x_bl_upgrade_firmware(uint8_t *firmware_image, uint32_t fw_im
 sl_status_t sl_si91x_set_fast_fw_up(void);
 #endif
 
+/***************************************************************************/ /**
+ * @brief
+ *   Read part of the firmware file for the firmware update loader.
+ * @param[in] offset
+ *   Offset of the data in the firmware file, including the RPS header.
+ * @param[out] buffer
+ *   Buffer to write the data to.
+ * @param[in] length
+ *   Number of bytes to read.
+ * @param[in] context
+ *   Context from @ref sl_si91x_fwup_loader_configuration_t.
+ * @return
+ *   SL_STATUS_OK when the whole length was read. Any other status stops the loader, which returns it.
+ ******************************************************************************/
+typedef sl_status_t (*sl_si91x_fwup_read_t)(uint32_t offset, uint8_t *buffer, uint16_t length, void *context);
+
+/***************************************************************************/ /**
+ * @brief
+ *   Add data to the integrity check of the firmware file.
+ * @details
+ *   Every byte of the firmware file is passed exactly once and in order, also when a chunk is read again after an error.
+ * @param[in] data
+ *   Next part of the firmware file.
+ * @param[in] length
+ *   Length of the data in bytes.
+ * @param[in] context
+ *   Context from @ref sl_si91x_fwup_loader_configuration_t.
+ ******************************************************************************/
+typedef void (*sl_si91x_fwup_hash_update_t)(const uint8_t *data, uint16_t length, void *context);
+
+/***************************************************************************/ /**
+ * @brief
+ *   Check the integrity of the firmware file.
+ * @details
+ *   Called once the whole file is passed to @ref sl_si91x_fwup_hash_update_t, before the last chunk is sent.
+ *   The NWP only installs the firmware after it receives the last chunk.
+ * @param[in] context
+ *   Context from @ref sl_si91x_fwup_loader_configuration_t.
+ * @return
+ *   SL_STATUS_OK to send the last chunk. Any other status stops the loader, which returns it.
+ ******************************************************************************/
+typedef sl_status_t (*sl_si91x_fwup_verify_t)(void *context);
+
+/// Firmware update loader configuration
+typedef struct {
+  uint32_t image_size;                     ///< Size of the firmware file in bytes, including the RPS header
+  uint8_t window;                          ///< Chunks queued to the NWP at once, 1 to SL_SI91X_FWUP_LOADER_MAX_WINDOW
+  sl_si91x_fwup_read_t read;               ///< Reads the firmware file
+  sl_si91x_fwup_hash_update_t hash_update; ///< Adds the firmware file to the integrity check. Can be NULL.
+  sl_si91x_fwup_verify_t verify;           ///< Checks the integrity before the last chunk is sent. Can be NULL.
+  void *context;                           ///< Passed to the callbacks
+} sl_si91x_fwup_loader_configuration_t;
+
+/// Firmware update loader state. Only read acknowledged_offset, the other members are private.
+typedef struct {
+  sl_si91x_fwup_loader_configuration_t configuration;
+  osSemaphoreId_t response_semaphore;
+  uint32_t acknowledged_offset; ///< Bytes of the firmware file accepted by the NWP
+  uint32_t submitted_offset;
+  uint32_t hashed_offset;
+  uint32_t submitted_chunks;
+  uint32_t processed_chunks;
+  volatile uint32_t received_chunks;
+  uint16_t chunk_length[SL_SI91X_FWUP_LOADER_MAX_WINDOW];
+  sl_status_t chunk_status[SL_SI91X_FWUP_LOADER_MAX_WINDOW];
+  sl_status_t error;
+} sl_si91x_fwup_loader_t;
+
+/***************************************************************************/ /**
+ * @brief
+ *   Prepare a firmware update loader.
+ *
+ * @details
+ *   The loader sends a firmware file read through a callback. It keeps up to window chunks queued to the NWP,
+ *   so the next chunk is sent as soon as the previous one is acknowledged, and reads the following chunks
+ *   while the NWP writes the queued ones to flash.
+ *
+ *   Only one loader can be prepared at a time.
+ *
+ * @param[out] loader
+ *   Loader state, must stay valid until @ref sl_si91x_fwup_loader_deinit.
+ *
+ * @param[in] configuration
+ *   Loader configuration, copied into the loader.
+ *
+ * @return
+ *   sl_status_t. See [Status Codes](https://docs.silabs.com/gecko-platform/latest/platform-common/status) and [WiSeConnect Status Codes](../wiseconnect-api-reference-guide-err-codes/wiseconnect-status-codes) for details.
+ *
+ * @note
+ *  The following table summarizes the support for different modes and network stacks:
+ * 
+ *  | Mode      | Hosted Network Stack | Offload Network Stack |
+ *  |-----------|----------------------|-----------------------|
+ *  | SoC       | Supported            | Supported             |
+ *  | NCP       | Supported            | Supported             |
+ ******************************************************************************/
+sl_status_t sl_si91x_fwup_loader_init(sl_si91x_fwup_loader_t *loader,
+                                      const sl_si91x_fwup_loader_configuration_t *configuration);
+
+/***************************************************************************/ /**
+ * @brief
+ *   Send the firmware file with the firmware update loader.
+ *
+ * @details
+ *   This is a blocking API. It returns when the NWP has acknowledged the whole file or when sending stops.
+ *
+ *   After a read error, a failed integrity check or a timeout, calling it again continues from where it stopped.
+ *   Chunks that are still queued stay queued and are accounted for by the next call.
+ *
+ *   Chunks do not carry their offset, so the update cannot continue after the NWP rejects a chunk.
+ *   The API then keeps returning the rejection status. Use @ref sl_si91x_fwup_abort to cancel the update.
+ *
+ * @pre Pre-conditions:
+ * - @ref sl_si91x_fwup_loader_init should be called before this API.
+ *
+ * @param[in] loader
+ *   Loader state.
+ *
+ * @return
+ *   sl_status_t. See [Status Codes](https://docs.silabs.com/gecko-platform/latest/platform-common/status) and [WiSeConnect Status Codes](../wiseconnect-api-reference-guide-err-codes/wiseconnect-status-codes) for details.
+ *   SL_STATUS_OK when the whole file is acknowledged.
+ *
+ * @note
+ *  The following table summarizes the support for different modes and network stacks:
+ * 
+ *  | Mode      | Hosted Network Stack | Offload Network Stack |
+ *  |-----------|----------------------|-----------------------|
+ *  | SoC       | Supported            | Supported             |
+ *  | NCP       | Supported            | Supported             |
+ ******************************************************************************/
+sl_status_t sl_si91x_fwup_loader_run(sl_si91x_fwup_loader_t *loader);
+
+/***************************************************************************/ /**
+ * @brief
+ *   Release a firmware update loader.
+ *
+ * @details
+ *   Responses to chunks that are still queued are ignored after this call.
+ *   Use @ref sl_si91x_fwup_abort to cancel an update that was not completed.
+ *
+ * @param[in] loader
+ *   Loader state.
+ *
+ * @return
+ *   sl_status_t. See [Status Codes](https://docs.silabs.com/gecko-platform/latest/platform-common/status) and [WiSeConnect Status Codes](../wiseconnect-api-reference-guide-err-codes/wiseconnect-status-codes) for details.
+ *
+ * @note
+ *  The following table summarizes the support for different modes and network stacks:
+ * 
+ *  | Mode      | Hosted Network Stack | Offload Network Stack |
+ *  |-----------|----------------------|-----------------------|
+ *  | SoC       | Supported            | Supported             |
+ *  | NCP       | Supported            | Supported             |
+ ******************************************************************************/
+sl_status_t sl_si91x_fwup_loader_deinit(sl_si91x_fwup_loader_t *loader);
+
+/***************************************************************************/ /**
+ * @brief
+ *   Report the progress of a bootloader upgrade.
+ * @param[in] written
+ *   Bytes of the firmware file taken by the bootloader.
+ * @param[in] image_size
+ *   Size of the firmware file in bytes.
+ * @param[in] context
+ *   Context from @ref sl_si91x_bl_upgrade_configuration_t.
+ ******************************************************************************/
+typedef void (*sl_si91x_bl_progress_t)(uint32_t written, uint32_t image_size, void *context);
+
+/// Bootloader upgrade configuration
+typedef struct {
+  uint32_t image_size;             ///< Size of the firmware file in bytes
+  sl_si91x_fwup_read_t read;       ///< Reads the firmware file, at most 4 KB at a time
+  sl_si91x_bl_progress_t progress; ///< Called each time the bootloader takes a chunk. Can be NULL.
+  void *context;                   ///< Passed to the callbacks
+} sl_si91x_bl_upgrade_configuration_t;
+
+/***************************************************************************/ /**
+ * @brief
+ *   Flash a firmware file read through a callback to the Wi-Fi module via the bootloader.
+ *
+ * @details
+ *   This function sends the whole firmware file in 4 KB chunks through the PING and PONG buffers of the bootloader.
+ *   The next chunk is read while the bootloader writes the previous one to flash, so only 4 KB of the file is held in RAM.
+ *
+ *   This is a blocking API. It waits at most SL_SI91X_BL_CHUNK_TIMEOUT_MS for each chunk and SL_SI91X_BL_UPGRADE_TIMEOUT_MS for the installation.
+ *
+ * @param[in] configuration
+ *   Firmware file and callbacks.
+ *
+ * @return
+ *   sl_status_t. See [Status Codes](https://docs.silabs.com/gecko-platform/latest/platform-common/status) and [WiSeConnect Status Codes](../wiseconnect-api-reference-guide-err-codes/wiseconnect-status-codes) for details.
+ *
+ * @note
+ *  The following table summarizes the support for different modes and network stacks:
+ * 
+ *  | Mode      | Hosted Network Stack | Offload Network Stack |
+ *  |-----------|----------------------|-----------------------|
+ *  | SoC       | Not-Supported        | Not-Supported         |
+ *  | NCP       | Supported            | Supported             |
+ ******************************************************************************/
+#if !defined(SLI_SI91X_MCU_INTERFACE) || defined(DOXYGEN)
+sl_status_t sl_si91x_bl_upgrade_firmware_from_source(const sl_si91x_bl_upgrade_configuration_t *configuration);
+#endif
+
 /** @} */
 
 /** \addtogroup SI91X_FIRMWARE_UPDATE_FROM_MODULE_FUNCTIONS 
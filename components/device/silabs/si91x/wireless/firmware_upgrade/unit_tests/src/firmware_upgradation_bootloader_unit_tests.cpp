@@ -0,0 +1,317 @@
+/*******************************************************************************
+ * @file
+ * @brief 
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "fff.h"
+
+extern "C" {
+#include "firmware_upgradation_fake_functions.h"
+}
+
+#define TEST_BL_IMAGE_SIZE  (10 * SLI_SI91X_MIN_CHUNK_SIZE + 1000)
+#define TEST_BL_CHUNK_COUNT 11
+
+namespace {
+
+// Simulated NWP bootloader behind sli_si91x_boot_instruction(). The host writes a 4 KB chunk to the PING or
+// PONG buffer, and after flash_time_ms the bootloader reports the other buffer free in its state register.
+struct simulated_bootloader_t {
+  std::vector<uint8_t> flash;
+  std::vector<std::string> log;
+  uint16_t state                = SLI_HOST_INTERACT_REG_VALID;
+  uint16_t next_state           = SLI_HOST_INTERACT_REG_VALID;
+  uint32_t ready_at             = 0;
+  uint32_t flash_time_ms        = 20;
+  uint32_t failed_bus_transfers = 0;
+  uint32_t register_reads       = 0;
+  bool expect_ping              = true;
+  bool hang                     = false;
+  bool installed                = false;
+};
+
+simulated_bootloader_t *bootloader;
+uint32_t simulated_time_ms;
+std::vector<uint32_t> delays;
+
+sl_status_t simulated_boot_instruction(uint8_t type, uint16_t *data)
+{
+  if (bootloader->failed_bus_transfers > 0) {
+    bootloader->failed_bus_transfers--;
+    return SL_STATUS_FAIL;
+  }
+
+  switch (type) {
+    case SLI_REG_READ:
+      bootloader->register_reads++;
+      if (!bootloader->hang && (simulated_time_ms >= bootloader->ready_at)
+          && (bootloader->state != bootloader->next_state)) {
+        bootloader->state = bootloader->next_state;
+        if (bootloader->state == (SLI_HOST_INTERACT_REG_VALID | SLI_FWUP_SUCCESSFUL)) {
+          bootloader->installed = true;
+          bootloader->log.push_back("S");
+        } else {
+          bootloader->log.push_back("A" + std::to_string(bootloader->flash.size() / SLI_SI91X_MIN_CHUNK_SIZE - 1));
+        }
+      }
+      *data = bootloader->state;
+      break;
+
+    case SLI_PING_WRITE:
+    case SLI_PONG_WRITE:
+      EXPECT_EQ(type, bootloader->expect_ping ? SLI_PING_WRITE : SLI_PONG_WRITE);
+      EXPECT_EQ(bootloader->state, bootloader->next_state) << "chunk written before the previous one was taken";
+      bootloader->expect_ping = !bootloader->expect_ping;
+      bootloader->log.push_back("W" + std::to_string(bootloader->flash.size() / SLI_SI91X_MIN_CHUNK_SIZE));
+      bootloader->flash.insert(bootloader->flash.end(),
+                               reinterpret_cast<uint8_t *>(data),
+                               reinterpret_cast<uint8_t *>(data) + SLI_SI91X_MIN_CHUNK_SIZE);
+      bootloader->next_state = SLI_HOST_INTERACT_REG_VALID
+                               | ((type == SLI_PING_WRITE) ? SLI_PONG_AVAIL : SLI_PING_AVAIL);
+      bootloader->ready_at = simulated_time_ms + bootloader->flash_time_ms;
+      break;
+
+    case SLI_REG_WRITE:
+      EXPECT_EQ(*data, SLI_HOST_INTERACT_REG_VALID | SLI_EOF_REACHED);
+      bootloader->log.push_back("E");
+      bootloader->next_state = SLI_HOST_INTERACT_REG_VALID | SLI_FWUP_SUCCESSFUL;
+      bootloader->ready_at   = simulated_time_ms + bootloader->flash_time_ms;
+      break;
+
+    default:
+      ADD_FAILURE() << "unexpected boot instruction " << (int)type;
+      return SL_STATUS_FAIL;
+  }
+  return SL_STATUS_OK;
+}
+
+sl_si91x_host_timestamp_t simulated_get_timestamp(void)
+{
+  return simulated_time_ms;
+}
+
+sl_si91x_host_timestamp_t simulated_elapsed_time(uint32_t starting_timestamp)
+{
+  return simulated_time_ms - starting_timestamp;
+}
+
+void simulated_delay_ms(uint32_t delay_milliseconds)
+{
+  delays.push_back(delay_milliseconds);
+  simulated_time_ms += delay_milliseconds;
+}
+
+struct test_file_t {
+  std::vector<uint8_t> data;
+  std::vector<uint32_t> progress;
+  uint32_t fail_read_at = UINT32_MAX;
+};
+
+sl_status_t test_file_read(uint32_t offset, uint8_t *buffer, uint16_t length, void *context)
+{
+  test_file_t *file = static_cast<test_file_t *>(context);
+  if (offset == file->fail_read_at) {
+    return SL_STATUS_IO;
+  }
+  EXPECT_LE(offset + length, file->data.size());
+  bootloader->log.push_back("R" + std::to_string(offset / SLI_SI91X_MIN_CHUNK_SIZE));
+  memcpy(buffer, &file->data[offset], length);
+  return SL_STATUS_OK;
+}
+
+void test_file_progress(uint32_t written, uint32_t image_size, void *context)
+{
+  test_file_t *file = static_cast<test_file_t *>(context);
+  EXPECT_EQ(image_size, file->data.size());
+  file->progress.push_back(written);
+}
+
+} // namespace
+
+class firmware_upgradation_bootloader_unit_tests : public ::testing::Test {
+protected:
+  simulated_bootloader_t simulated_bootloader;
+  test_file_t file;
+  sl_si91x_bl_upgrade_configuration_t configuration;
+
+  void SetUp() override
+  {
+    RESET_FAKE(sli_si91x_boot_instruction);
+    RESET_FAKE(sl_si91x_host_get_timestamp);
+    RESET_FAKE(sl_si91x_host_elapsed_time);
+    RESET_FAKE(sl_si91x_host_delay_ms);
+    FFF_RESET_HISTORY();
+
+    sli_si91x_boot_instruction_fake.custom_fake  = simulated_boot_instruction;
+    sl_si91x_host_get_timestamp_fake.custom_fake = simulated_get_timestamp;
+    sl_si91x_host_elapsed_time_fake.custom_fake  = simulated_elapsed_time;
+    sl_si91x_host_delay_ms_fake.custom_fake      = simulated_delay_ms;
+
+    bootloader        = &simulated_bootloader;
+    simulated_time_ms = 1000;
+    delays.clear();
+
+    file.data.resize(TEST_BL_IMAGE_SIZE);
+    for (size_t i = 0; i < file.data.size(); i++) {
+      file.data[i] = (uint8_t)(i * 7 + (i >> 12));
+    }
+
+    configuration.image_size = TEST_BL_IMAGE_SIZE;
+    configuration.read       = test_file_read;
+    configuration.progress   = test_file_progress;
+    configuration.context    = &file;
+  }
+
+  void expect_image_installed()
+  {
+    ASSERT_EQ(simulated_bootloader.flash.size(), (size_t)(TEST_BL_CHUNK_COUNT * SLI_SI91X_MIN_CHUNK_SIZE));
+    EXPECT_TRUE(std::equal(file.data.begin(), file.data.end(), simulated_bootloader.flash.begin()));
+    for (size_t i = file.data.size(); i < simulated_bootloader.flash.size(); i++) {
+      EXPECT_EQ(simulated_bootloader.flash[i], 0);
+    }
+    EXPECT_TRUE(simulated_bootloader.installed);
+  }
+};
+
+// Test case: Stream the whole file through the PING and PONG buffers
+TEST_F(firmware_upgradation_bootloader_unit_tests, StreamsImageThroughPingPong)
+{
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware_from_source(&configuration), SL_STATUS_OK);
+  expect_image_installed();
+
+  ASSERT_EQ(file.progress.size(), (size_t)TEST_BL_CHUNK_COUNT);
+  for (size_t i = 0; i + 1 < file.progress.size(); i++) {
+    EXPECT_EQ(file.progress[i], (i + 1) * SLI_SI91X_MIN_CHUNK_SIZE);
+  }
+  EXPECT_EQ(file.progress.back(), (uint32_t)TEST_BL_IMAGE_SIZE);
+}
+
+// Test case: Read the next chunk while the bootloader writes the previous one to flash
+TEST_F(firmware_upgradation_bootloader_unit_tests, ReadsNextChunkWhileBootloaderWrites)
+{
+  std::vector<std::string> expected = { "R0" };
+
+  for (int chunk = 0; chunk < TEST_BL_CHUNK_COUNT; chunk++) {
+    expected.push_back("W" + std::to_string(chunk));
+    if (chunk + 1 < TEST_BL_CHUNK_COUNT) {
+      expected.push_back("R" + std::to_string(chunk + 1));
+    }
+    expected.push_back("A" + std::to_string(chunk));
+  }
+  expected.push_back("E");
+  expected.push_back("S");
+
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware_from_source(&configuration), SL_STATUS_OK);
+  EXPECT_EQ(simulated_bootloader.log, expected);
+}
+
+// Test case: Back off between state reads instead of spinning on the bus
+TEST_F(firmware_upgradation_bootloader_unit_tests, BacksOffWhileBootloaderIsBusy)
+{
+  simulated_bootloader.flash_time_ms = 100;
+  configuration.image_size           = SLI_SI91X_MIN_CHUNK_SIZE;
+  file.data.resize(SLI_SI91X_MIN_CHUNK_SIZE);
+
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware_from_source(&configuration), SL_STATUS_OK);
+
+  ASSERT_GE(delays.size(), 3u);
+  EXPECT_EQ(delays[0], 1u);
+  EXPECT_EQ(delays[1], 2u);
+  for (uint32_t delay : delays) {
+    EXPECT_LE(delay, (uint32_t)SL_SI91X_BL_POLL_MAX_INTERVAL_MS);
+  }
+
+  // Two waits of 100 ms, one for the chunk and one for the installation
+  EXPECT_LE(simulated_bootloader.register_reads, 2 * (100 / SL_SI91X_BL_POLL_MAX_INTERVAL_MS + 4));
+}
+
+// Test case: Give up when the bootloader stops responding
+TEST_F(firmware_upgradation_bootloader_unit_tests, TimesOutWhenBootloaderHangs)
+{
+  simulated_bootloader.hang = true;
+
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware_from_source(&configuration), SL_STATUS_TIMEOUT);
+  EXPECT_GE(simulated_time_ms - 1000, (uint32_t)SL_SI91X_BL_CHUNK_TIMEOUT_MS);
+  EXPECT_LE(simulated_time_ms - 1000, (uint32_t)(SL_SI91X_BL_CHUNK_TIMEOUT_MS + SL_SI91X_BL_POLL_MAX_INTERVAL_MS));
+  EXPECT_EQ(simulated_bootloader.flash.size(), (size_t)SLI_SI91X_MIN_CHUNK_SIZE);
+  EXPECT_TRUE(file.progress.empty());
+}
+
+// Test case: Retry failed bus transfers
+TEST_F(firmware_upgradation_bootloader_unit_tests, RetriesFailedBusTransfers)
+{
+  simulated_bootloader.failed_bus_transfers = SL_SI91X_BL_BUS_RETRY_COUNT;
+
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware_from_source(&configuration), SL_STATUS_OK);
+  expect_image_installed();
+
+  simulated_bootloader_t second_bootloader;
+  bootloader                             = &second_bootloader;
+  second_bootloader.failed_bus_transfers = SL_SI91X_BL_BUS_RETRY_COUNT + 1;
+
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware_from_source(&configuration), SL_STATUS_FAIL);
+  EXPECT_TRUE(second_bootloader.flash.empty());
+}
+
+// Test case: Stop when the firmware file cannot be read
+TEST_F(firmware_upgradation_bootloader_unit_tests, StopsOnReadError)
+{
+  file.fail_read_at = 3 * SLI_SI91X_MIN_CHUNK_SIZE;
+
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware_from_source(&configuration), SL_STATUS_IO);
+  EXPECT_EQ(simulated_bootloader.flash.size(), (size_t)(3 * SLI_SI91X_MIN_CHUNK_SIZE));
+  EXPECT_FALSE(simulated_bootloader.installed);
+  EXPECT_EQ(std::count(simulated_bootloader.log.begin(), simulated_bootloader.log.end(), "E"), 0);
+}
+
+// Test case: The chunk API keeps the PING and PONG order across calls and times out on a hung bootloader
+TEST_F(firmware_upgradation_bootloader_unit_tests, ChunkApiUsesPingPong)
+{
+  file.data.resize(TEST_BL_CHUNK_COUNT * SLI_SI91X_MIN_CHUNK_SIZE);
+  uint8_t *image = file.data.data();
+
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware(image, 4 * SLI_SI91X_MIN_CHUNK_SIZE, SLI_SI91X_FW_START_OF_FILE),
+            SL_STATUS_OK);
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware(image + 4 * SLI_SI91X_MIN_CHUNK_SIZE, 3 * SLI_SI91X_MIN_CHUNK_SIZE, 0),
+            SL_STATUS_OK);
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware(image + 7 * SLI_SI91X_MIN_CHUNK_SIZE,
+                                         4 * SLI_SI91X_MIN_CHUNK_SIZE,
+                                         SLI_SI91X_FW_END_OF_FILE),
+            SL_STATUS_OK);
+  expect_image_installed();
+
+  simulated_bootloader_t second_bootloader;
+  bootloader             = &second_bootloader;
+  second_bootloader.hang = true;
+  EXPECT_EQ(sl_si91x_bl_upgrade_firmware(image, SLI_SI91X_MIN_CHUNK_SIZE, SLI_SI91X_FW_START_OF_FILE),
+            SL_STATUS_TIMEOUT);
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * @file
+ * @brief 
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include "firmware_upgradation_fake_functions.h"
+
+DEFINE_FFF_GLOBALS;
+
+DEFINE_FAKE_VALUE_FUNC7(sl_status_t,
+                        sli_si91x_driver_send_command,
+                        uint32_t,
+                        sli_wifi_command_type_t,
+                        const void *,
+                        uint32_t,
+                        sli_wifi_wait_period_t,
+                        void *,
+                        sl_wifi_buffer_t **);
+DEFINE_FAKE_VALUE_FUNC6(sl_status_t,
+                        sli_si91x_driver_send_command_packet,
+                        uint32_t,
+                        sli_wifi_command_type_t,
+                        sl_wifi_buffer_t *,
+                        sli_wifi_wait_period_t,
+                        void *,
+                        sl_wifi_buffer_t **);
+DEFINE_FAKE_VALUE_FUNC4(sl_status_t,
+                        sli_si91x_allocate_command_buffer,
+                        sl_wifi_buffer_t **,
+                        void **,
+                        uint32_t,
+                        uint32_t);
+DEFINE_FAKE_VOID_FUNC1(sli_si91x_host_free_buffer, sl_wifi_buffer_t *);
+DEFINE_FAKE_VOID_FUNC1(sli_si91x_set_fwup_response_handler, sli_si91x_fwup_response_handler_t);
+DEFINE_FAKE_VALUE_FUNC2(sl_status_t, sli_si91x_boot_instruction, uint8_t, uint16_t *);
+DEFINE_FAKE_VALUE_FUNC3(sl_status_t, sl_si91x_bus_read_memory, uint32_t, uint16_t, const uint8_t *);
+DEFINE_FAKE_VALUE_FUNC3(sl_status_t, sl_si91x_bus_write_memory, uint32_t, uint16_t, const uint8_t *);
+DEFINE_FAKE_VALUE_FUNC0(sl_si91x_host_timestamp_t, sl_si91x_host_get_timestamp);
+DEFINE_FAKE_VALUE_FUNC1(sl_si91x_host_timestamp_t, sl_si91x_host_elapsed_time, uint32_t);
+DEFINE_FAKE_VOID_FUNC1(sl_si91x_host_delay_ms, uint32_t);
+DEFINE_FAKE_VALUE_FUNC3(osSemaphoreId_t, osSemaphoreNew, uint32_t, uint32_t, const osSemaphoreAttr_t *);
+DEFINE_FAKE_VALUE_FUNC2(osStatus_t, osSemaphoreAcquire, osSemaphoreId_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osSemaphoreRelease, osSemaphoreId_t);
+DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osSemaphoreDelete, osSemaphoreId_t);
+DEFINE_FAKE_VALUE_FUNC0(uint32_t, osKernelGetTickFreq);
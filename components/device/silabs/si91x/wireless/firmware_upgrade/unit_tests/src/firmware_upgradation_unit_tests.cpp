@@ -0,0 +1,530 @@
+/*******************************************************************************
+ * @file
+ * @brief 
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "fff.h"
+
+extern "C" {
+#include "firmware_upgradation_fake_functions.h"
+}
+
+#define TEST_IMAGE_SIZE  (SLI_RPS_HEADER_SIZE + 127 * SLI_MAX_FWUP_CHUNK_SIZE + 100)
+#define TEST_CHUNK_COUNT 129
+
+namespace {
+
+// Simulated time. The host and the NWP each keep their own timeline: the NWP flashes a chunk once it is free
+// and the host has sent the chunk, and the host catches up with the NWP when it takes the chunk's response.
+struct fake_clock_t {
+  std::mutex mutex;
+  std::chrono::microseconds host{ 0 };
+  std::chrono::microseconds nwp{ 0 };
+  std::deque<std::chrono::microseconds> responses;
+
+  void reset()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    host = std::chrono::microseconds(0);
+    nwp  = std::chrono::microseconds(0);
+    responses.clear();
+  }
+};
+
+fake_clock_t fake_clock;
+
+// Counting semaphore behind the osSemaphore fakes
+struct fake_semaphore_t {
+  std::mutex mutex;
+  std::condition_variable condition;
+  uint32_t count;
+};
+
+osSemaphoreId_t fake_semaphore_new(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr)
+{
+  (void)max_count;
+  (void)attr;
+  fake_semaphore_t *semaphore = new fake_semaphore_t;
+  semaphore->count            = initial_count;
+  return semaphore;
+}
+
+osStatus_t fake_semaphore_acquire(osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+  fake_semaphore_t *semaphore = static_cast<fake_semaphore_t *>(semaphore_id);
+  std::unique_lock<std::mutex> lock(semaphore->mutex);
+  if (!semaphore->condition.wait_for(lock, std::chrono::milliseconds(timeout), [semaphore] {
+        return semaphore->count > 0;
+      })) {
+    return osErrorTimeout;
+  }
+  semaphore->count--;
+
+  // Every release is a chunk response, taken in the order the NWP sent them
+  std::lock_guard<std::mutex> clock_lock(fake_clock.mutex);
+  if (!fake_clock.responses.empty()) {
+    fake_clock.host = std::max(fake_clock.host, fake_clock.responses.front());
+    fake_clock.responses.pop_front();
+  }
+  return osOK;
+}
+
+osStatus_t fake_semaphore_release(osSemaphoreId_t semaphore_id)
+{
+  fake_semaphore_t *semaphore = static_cast<fake_semaphore_t *>(semaphore_id);
+  std::lock_guard<std::mutex> lock(semaphore->mutex);
+  semaphore->count++;
+  semaphore->condition.notify_one();
+  return osOK;
+}
+
+osStatus_t fake_semaphore_delete(osSemaphoreId_t semaphore_id)
+{
+  delete static_cast<fake_semaphore_t *>(semaphore_id);
+  return osOK;
+}
+
+// The command buffer and the packet share the same allocation
+sl_status_t fake_allocate_command_buffer(sl_wifi_buffer_t **host_buffer,
+                                         void **buffer,
+                                         uint32_t requested_buffer_size,
+                                         uint32_t wait_duration_ms)
+{
+  (void)wait_duration_ms;
+  *buffer      = malloc(requested_buffer_size);
+  *host_buffer = static_cast<sl_wifi_buffer_t *>(*buffer);
+  return SL_STATUS_OK;
+}
+
+void fake_free_buffer(sl_wifi_buffer_t *buffer)
+{
+  free(buffer);
+}
+
+// Simulated NWP. Like the command engine it handles one queued chunk at a time, in order, and takes
+// flash_time of simulated time to write each chunk before it acknowledges it.
+class fake_nwp_t {
+public:
+  std::chrono::microseconds flash_time{ 0 };
+  int reject_chunk          = -1;
+  sl_status_t reject_status = SL_STATUS_FAIL;
+  std::vector<uint8_t> image;
+  std::vector<uint16_t> chunk_types;
+  std::atomic<size_t> received_chunks{ 0 };
+  sli_si91x_fwup_response_handler_t response_handler = NULL;
+
+  void start()
+  {
+    running = true;
+    worker  = std::thread(&fake_nwp_t::run, this);
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      running = false;
+    }
+    condition.notify_one();
+    worker.join();
+    for (queued_chunk_t &chunk : queue) {
+      free(chunk.packet);
+    }
+    queue.clear();
+  }
+
+  void push(sl_wifi_system_packet_t *packet)
+  {
+    std::chrono::microseconds sent_at;
+    {
+      std::lock_guard<std::mutex> lock(fake_clock.mutex);
+      sent_at = fake_clock.host;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.push_back({ packet, sent_at });
+    }
+    condition.notify_one();
+  }
+
+private:
+  struct queued_chunk_t {
+    sl_wifi_system_packet_t *packet;
+    std::chrono::microseconds sent_at;
+  };
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<queued_chunk_t> queue;
+  std::thread worker;
+  bool running = false;
+
+  void run()
+  {
+    while (true) {
+      queued_chunk_t chunk;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] {
+          return !running || !queue.empty();
+        });
+        if (!running) {
+          return;
+        }
+        chunk = queue.front();
+        queue.pop_front();
+      }
+      {
+        std::lock_guard<std::mutex> lock(fake_clock.mutex);
+        fake_clock.nwp = std::max(fake_clock.nwp, chunk.sent_at) + flash_time;
+        fake_clock.responses.push_back(fake_clock.nwp);
+      }
+      sl_wifi_system_packet_t *packet = chunk.packet;
+      sl_status_t status              = handle_chunk(packet);
+      if (response_handler != NULL) {
+        response_handler(status);
+      }
+      free(packet);
+    }
+  }
+
+  sl_status_t handle_chunk(const sl_wifi_system_packet_t *packet)
+  {
+    const sli_si91x_req_fwup_t *fwup = reinterpret_cast<const sli_si91x_req_fwup_t *>(packet->data);
+    int index                        = (int)chunk_types.size();
+
+    EXPECT_EQ(packet->command, SLI_WLAN_REQ_FWUP);
+    EXPECT_EQ(packet->length, sizeof(sli_si91x_req_fwup_t));
+    chunk_types.push_back(fwup->type);
+    received_chunks++;
+    if (index == reject_chunk) {
+      return reject_status;
+    }
+    for (uint32_t i = fwup->length; i < SLI_MAX_FWUP_CHUNK_SIZE; i++) {
+      EXPECT_EQ(fwup->content[i], 0);
+    }
+    image.insert(image.end(), fwup->content, fwup->content + fwup->length);
+    return (image.size() == TEST_IMAGE_SIZE) ? SL_STATUS_SI91X_FW_UPDATE_DONE : SL_STATUS_OK;
+  }
+};
+
+fake_nwp_t *nwp;
+
+sl_status_t fake_send_command_packet(uint32_t command,
+                                     sli_wifi_command_type_t command_type,
+                                     sl_wifi_buffer_t *buffer,
+                                     sli_wifi_wait_period_t wait_period,
+                                     void *sdk_context,
+                                     sl_wifi_buffer_t **data_buffer)
+{
+  (void)command;
+  (void)command_type;
+  (void)sdk_context;
+  (void)data_buffer;
+  EXPECT_EQ(wait_period, SLI_WIFI_RETURN_IMMEDIATELY);
+  nwp->push(reinterpret_cast<sl_wifi_system_packet_t *>(buffer));
+  return SL_STATUS_IN_PROGRESS;
+}
+
+void fake_set_fwup_response_handler(sli_si91x_fwup_response_handler_t handler)
+{
+  nwp->response_handler = handler;
+}
+
+// Firmware file source. Takes read_time of simulated time to read each chunk and hashes with FNV-1a.
+struct test_source_t {
+  std::vector<uint8_t> file;
+  std::chrono::microseconds read_time{ 0 };
+  uint32_t fail_read_at = UINT32_MAX;
+  uint32_t hash         = 2166136261u;
+  uint32_t hashed       = 0;
+  uint32_t verify_calls = 0;
+  size_t chunks_at_verify;
+  bool corrupt = false;
+};
+
+sl_status_t test_read(uint32_t offset, uint8_t *buffer, uint16_t length, void *context)
+{
+  test_source_t *source = static_cast<test_source_t *>(context);
+  if (offset == source->fail_read_at) {
+    source->fail_read_at = UINT32_MAX;
+    return SL_STATUS_IO;
+  }
+  {
+    std::lock_guard<std::mutex> lock(fake_clock.mutex);
+    fake_clock.host += source->read_time;
+  }
+  memcpy(buffer, &source->file[offset], length);
+  return SL_STATUS_OK;
+}
+
+void test_hash_update(const uint8_t *data, uint16_t length, void *context)
+{
+  test_source_t *source = static_cast<test_source_t *>(context);
+  for (uint16_t i = 0; i < length; i++) {
+    source->hash = (source->hash ^ data[i]) * 16777619u;
+  }
+  source->hashed += length;
+}
+
+uint32_t expected_hash(const std::vector<uint8_t> &file)
+{
+  uint32_t hash = 2166136261u;
+  for (uint8_t byte : file) {
+    hash = (hash ^ byte) * 16777619u;
+  }
+  return hash;
+}
+
+sl_status_t test_verify(void *context)
+{
+  test_source_t *source = static_cast<test_source_t *>(context);
+  source->verify_calls++;
+  source->chunks_at_verify = nwp->received_chunks;
+  if (source->corrupt || (source->hash != expected_hash(source->file))) {
+    return SL_STATUS_SI91X_FW_UPDATE_FAILED;
+  }
+  return SL_STATUS_OK;
+}
+
+} // namespace
+
+class firmware_upgradation_unit_tests : public ::testing::Test {
+protected:
+  fake_nwp_t fake_nwp;
+  test_source_t source;
+  sl_si91x_fwup_loader_t loader;
+  sl_si91x_fwup_loader_configuration_t configuration;
+
+  void SetUp() override
+  {
+    RESET_FAKE(sli_si91x_driver_send_command_packet);
+    RESET_FAKE(sli_si91x_allocate_command_buffer);
+    RESET_FAKE(sli_si91x_host_free_buffer);
+    RESET_FAKE(sli_si91x_set_fwup_response_handler);
+    RESET_FAKE(osSemaphoreNew);
+    RESET_FAKE(osSemaphoreAcquire);
+    RESET_FAKE(osSemaphoreRelease);
+    RESET_FAKE(osSemaphoreDelete);
+    RESET_FAKE(osKernelGetTickFreq);
+    FFF_RESET_HISTORY();
+
+    sli_si91x_driver_send_command_packet_fake.custom_fake = fake_send_command_packet;
+    sli_si91x_allocate_command_buffer_fake.custom_fake    = fake_allocate_command_buffer;
+    sli_si91x_host_free_buffer_fake.custom_fake           = fake_free_buffer;
+    sli_si91x_set_fwup_response_handler_fake.custom_fake  = fake_set_fwup_response_handler;
+    osSemaphoreNew_fake.custom_fake                       = fake_semaphore_new;
+    osSemaphoreAcquire_fake.custom_fake                   = fake_semaphore_acquire;
+    osSemaphoreRelease_fake.custom_fake                   = fake_semaphore_release;
+    osSemaphoreDelete_fake.custom_fake                    = fake_semaphore_delete;
+    osKernelGetTickFreq_fake.return_val                   = 1000;
+    fake_clock.reset();
+
+    source.file.resize(TEST_IMAGE_SIZE);
+    for (size_t i = 0; i < source.file.size(); i++) {
+      source.file[i] = (uint8_t)(i * 31 + (i >> 8));
+    }
+
+    memset(&configuration, 0, sizeof(configuration));
+    configuration.image_size  = TEST_IMAGE_SIZE;
+    configuration.window      = SL_SI91X_FWUP_LOADER_MAX_WINDOW;
+    configuration.read        = test_read;
+    configuration.hash_update = test_hash_update;
+    configuration.verify      = test_verify;
+    configuration.context     = &source;
+
+    nwp = &fake_nwp;
+    fake_nwp.start();
+  }
+
+  void TearDown() override
+  {
+    fake_nwp.stop();
+    sl_si91x_fwup_loader_deinit(&loader);
+  }
+
+  void expect_image_installed()
+  {
+    EXPECT_EQ(loader.acknowledged_offset, (uint32_t)TEST_IMAGE_SIZE);
+    EXPECT_EQ(fake_nwp.image, source.file);
+    ASSERT_EQ(fake_nwp.chunk_types.size(), (size_t)TEST_CHUNK_COUNT);
+    EXPECT_EQ(fake_nwp.chunk_types[0], SL_FWUP_RPS_HEADER);
+    for (size_t i = 1; i < fake_nwp.chunk_types.size(); i++) {
+      EXPECT_EQ(fake_nwp.chunk_types[i], SL_FWUP_RPS_CONTENT);
+    }
+    EXPECT_EQ(source.hashed, (uint32_t)TEST_IMAGE_SIZE);
+    EXPECT_EQ(source.hash, expected_hash(source.file));
+  }
+};
+
+// Test case: Reject invalid configurations and a second loader
+TEST_F(firmware_upgradation_unit_tests, InitValidatesConfiguration)
+{
+  sl_si91x_fwup_loader_t other;
+
+  EXPECT_EQ(sl_si91x_fwup_loader_init(NULL, &configuration), SL_STATUS_NULL_POINTER);
+  EXPECT_EQ(sl_si91x_fwup_loader_init(&loader, NULL), SL_STATUS_NULL_POINTER);
+
+  configuration.window = 0;
+  EXPECT_EQ(sl_si91x_fwup_loader_init(&loader, &configuration), SL_STATUS_INVALID_PARAMETER);
+  configuration.window = SL_SI91X_FWUP_LOADER_MAX_WINDOW + 1;
+  EXPECT_EQ(sl_si91x_fwup_loader_init(&loader, &configuration), SL_STATUS_INVALID_PARAMETER);
+  configuration.window     = 1;
+  configuration.image_size = SLI_RPS_HEADER_SIZE;
+  EXPECT_EQ(sl_si91x_fwup_loader_init(&loader, &configuration), SL_STATUS_INVALID_PARAMETER);
+  configuration.image_size = TEST_IMAGE_SIZE;
+  configuration.read       = NULL;
+  EXPECT_EQ(sl_si91x_fwup_loader_init(&loader, &configuration), SL_STATUS_NULL_POINTER);
+  configuration.read = test_read;
+
+  EXPECT_EQ(sl_si91x_fwup_loader_run(&loader), SL_STATUS_NOT_INITIALIZED);
+  ASSERT_EQ(sl_si91x_fwup_loader_init(&loader, &configuration), SL_STATUS_OK);
+  EXPECT_EQ(sl_si91x_fwup_loader_init(&other, &configuration), SL_STATUS_BUSY);
+  EXPECT_EQ(sli_si91x_set_fwup_response_handler_fake.call_count, 1u);
+}
+
+// Test case: Send the whole file through every window size
+TEST_F(firmware_upgradation_unit_tests, SendsImageInOrder)
+{
+  for (uint8_t window = 1; window <= SL_SI91X_FWUP_LOADER_MAX_WINDOW; window++) {
+    fake_nwp.image.clear();
+    fake_nwp.chunk_types.clear();
+    fake_nwp.received_chunks = 0;
+    source.hash              = 2166136261u;
+    source.hashed            = 0;
+    source.verify_calls      = 0;
+    configuration.window     = window;
+
+    ASSERT_EQ(sl_si91x_fwup_loader_init(&loader, &configuration), SL_STATUS_OK);
+    EXPECT_EQ(sl_si91x_fwup_loader_run(&loader), SL_STATUS_OK);
+    expect_image_installed();
+
+    // The image is checked before the last chunk reaches the NWP
+    EXPECT_EQ(source.verify_calls, 1u);
+    EXPECT_LT(source.chunks_at_verify, (size_t)TEST_CHUNK_COUNT);
+
+    // Running again after completion sends nothing
+    EXPECT_EQ(sl_si91x_fwup_loader_run(&loader), SL_STATUS_OK);
+    EXPECT_EQ(fake_nwp.chunk_types.size(), (size_t)TEST_CHUNK_COUNT);
+    EXPECT_EQ(sl_si91x_fwup_loader_deinit(&loader), SL_STATUS_OK);
+  }
+  EXPECT_EQ(sli_si91x_host_free_buffer_fake.call_count, 0u);
+}
+
+// Test case: Continue after a read error without sending or hashing any byte twice
+TEST_F(firmware_upgradation_unit_tests, ResumesAfterReadError)
+{
+  uint32_t fail_read_at = SLI_RPS_HEADER_SIZE + 40 * SLI_MAX_FWUP_CHUNK_SIZE;
+  source.fail_read_at   = fail_read_at;
+
+  ASSERT_EQ(sl_si91x_fwup_loader_init(&loader, &configuration), SL_STATUS_OK);
+  EXPECT_EQ(sl_si91x_fwup_loader_run(&loader), SL_STATUS_IO);
+  EXPECT_LE(loader.acknowledged_offset, fail_read_at);
+  EXPECT_EQ(loader.submitted_offset, fail_read_at);
+  EXPECT_EQ(sli_si91x_host_free_buffer_fake.call_count, 1u);
+
+  EXPECT_EQ(sl_si91x_fwup_loader_run(&loader), SL_STATUS_OK);
+  expect_image_installed();
+}
+
+// Test case: Keep the last chunk when the integrity check fails
+TEST_F(firmware_upgradation_unit_tests, HoldsLastChunkOnVerifyFailure)
+{
+  source.corrupt = true;
+
+  ASSERT_EQ(sl_si91x_fwup_loader_init(&loader, &configuration), SL_STATUS_OK);
+  EXPECT_EQ(sl_si91x_fwup_loader_run(&loader), SL_STATUS_SI91X_FW_UPDATE_FAILED);
+  EXPECT_EQ(loader.submitted_offset, (uint32_t)(TEST_IMAGE_SIZE - 100));
+
+  // Queued chunks are acknowledged while the caller decides, the last one is only sent after a good check
+  source.corrupt = false;
+  EXPECT_EQ(sl_si91x_fwup_loader_run(&loader), SL_STATUS_OK);
+  expect_image_installed();
+  EXPECT_EQ(source.verify_calls, 2u);
+}
+
+// Test case: A rejected chunk ends the update, later acknowledgements do not count
+TEST_F(firmware_upgradation_unit_tests, StopsOnRejectedChunk)
+{
+  fake_nwp.reject_chunk  = 10;
+  fake_nwp.reject_status = SL_STATUS_SI91X_FW_UPDATE_FAILED;
+
+  ASSERT_EQ(sl_si91x_fwup_loader_init(&loader, &configuration), SL_STATUS_OK);
+  EXPECT_EQ(sl_si91x_fwup_loader_run(&loader), SL_STATUS_SI91X_FW_UPDATE_FAILED);
+  EXPECT_EQ(loader.acknowledged_offset, (uint32_t)(SLI_RPS_HEADER_SIZE + 9 * SLI_MAX_FWUP_CHUNK_SIZE));
+  EXPECT_LE(fake_nwp.chunk_types.size(), (size_t)(10 + SL_SI91X_FWUP_LOADER_MAX_WINDOW));
+
+  size_t sent = fake_nwp.chunk_types.size();
+  EXPECT_EQ(sl_si91x_fwup_loader_run(&loader), SL_STATUS_SI91X_FW_UPDATE_FAILED);
+  EXPECT_EQ(fake_nwp.chunk_types.size(), sent);
+}
+
+// Test case: Simulated time of an update against the window size
+TEST_F(firmware_upgradation_unit_tests, WindowOverlapsReadsWithFlashWrites)
+{
+  std::chrono::microseconds elapsed[SL_SI91X_FWUP_LOADER_MAX_WINDOW + 1];
+
+  source.read_time    = std::chrono::microseconds(300);
+  fake_nwp.flash_time = std::chrono::microseconds(300);
+
+  for (uint8_t window = 1; window <= SL_SI91X_FWUP_LOADER_MAX_WINDOW; window++) {
+    fake_nwp.image.clear();
+    fake_nwp.chunk_types.clear();
+    fake_nwp.received_chunks = 0;
+    source.hash              = 2166136261u;
+    source.hashed            = 0;
+    configuration.window     = window;
+
+    fake_clock.reset();
+
+    ASSERT_EQ(sl_si91x_fwup_loader_init(&loader, &configuration), SL_STATUS_OK);
+    EXPECT_EQ(sl_si91x_fwup_loader_run(&loader), SL_STATUS_OK);
+    elapsed[window] = fake_clock.host;
+    expect_image_installed();
+    EXPECT_EQ(sl_si91x_fwup_loader_deinit(&loader), SL_STATUS_OK);
+
+    std::cout << "window " << (int)window << ": "
+              << elapsed[window].count() << " us for "
+              << TEST_CHUNK_COUNT << " chunks" << std::endl;
+  }
+
+  // With one chunk queued the NWP waits for every read, with more the reads hide behind the flash writes
+  EXPECT_EQ(elapsed[1], TEST_CHUNK_COUNT * (source.read_time + fake_nwp.flash_time));
+  EXPECT_EQ(elapsed[SL_SI91X_FWUP_LOADER_MAX_WINDOW], TEST_CHUNK_COUNT * source.read_time + fake_nwp.flash_time);
+}
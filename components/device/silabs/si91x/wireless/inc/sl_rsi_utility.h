@@ -82,11 +82,47 @@ typedef struct {
 #ifndef SL_SI91X_EVENT_HANDLER_STACK_SIZE
 #define SL_SI91X_EVENT_HANDLER_STACK_SIZE 1536
 #endif
+
+/**
+ * Number of RX dispatch worker threads. With 0, all asynchronous callbacks run on the event handler thread.
+ * Otherwise the event handler thread only sorts events into per-protocol queues, see
+ * sl_si91x_set_rx_dispatch_queue_configuration(). At most 4 workers are used, as socket events and socket data
+ * share one.
+ */
+#ifndef SL_SI91X_RX_DISPATCH_WORKER_COUNT
+#define SL_SI91X_RX_DISPATCH_WORKER_COUNT 0
+#endif
+
+/// Priority of the RX dispatch worker threads, below the event handler and command engine threads
+#ifndef SL_SI91X_RX_DISPATCH_WORKER_PRIORITY
+#define SL_SI91X_RX_DISPATCH_WORKER_PRIORITY osPriorityHigh
+#endif
+
+/// Stack size of each RX dispatch worker thread, which runs the application callbacks
+#ifndef SL_SI91X_RX_DISPATCH_WORKER_STACK_SIZE
+#define SL_SI91X_RX_DISPATCH_WORKER_STACK_SIZE SL_SI91X_EVENT_HANDLER_STACK_SIZE
+#endif
+
+/// Largest depth of an RX dispatch queue, which sizes the storage of every queue
+#ifndef SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH
+#define SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH 8
+#endif
+
+/// Depth each RX dispatch queue starts with
+#ifndef SL_SI91X_RX_DISPATCH_DEFAULT_QUEUE_DEPTH
+#define SL_SI91X_RX_DISPATCH_DEFAULT_QUEUE_DEPTH SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH
+#endif
 typedef bool (*sli_si91x_wifi_buffer_comparator)(const sl_wifi_buffer_t *buffer, const void *userdata);
 typedef uint32_t sl_si91x_host_timestamp_t;
 
 void sli_handle_wifi_beacon(sl_wifi_system_packet_t *packet);
 
+// Receives the converted status of each firmware chunk sent with SLI_WIFI_RETURN_IMMEDIATELY
+typedef void (*sli_si91x_fwup_response_handler_t)(sl_status_t status);
+
+void sli_handle_fwup_response(uint16_t frame_status);
+void sli_si91x_set_fwup_response_handler(sli_si91x_fwup_response_handler_t handler);
+
 typedef void (*sli_si91x_host_atomic_action_function_t)(void *user_data);
 typedef uint8_t (*sli_si91x_compare_function_t)(sl_wifi_buffer_t *node, void *user_data);
 typedef void (*sli_si91x_node_free_function_t)(sl_wifi_buffer_t *node);
@@ -373,6 +409,15 @@ sl_status_t sli_si91x_add_to_queue(sli_wifi_buffer_queue_t *queue, sl_wifi_buffe
 /* Function dequeues responses from Asynch response queues */
 sl_status_t sli_si91x_remove_from_queue(sli_wifi_buffer_queue_t *queue, sl_wifi_buffer_t **buffer);
 
+/* Function starts the RX dispatch worker threads, if SL_SI91X_RX_DISPATCH_WORKER_COUNT is not 0 */
+sl_status_t sli_si91x_rx_dispatch_init(void);
+
+/* Function stops the RX dispatch worker threads and frees the events still queued */
+void sli_si91x_rx_dispatch_deinit(void);
+
+/* Function sorts the notified events into the RX dispatch queues */
+void sli_si91x_rx_dispatch_events(uint32_t event);
+
 /* Function used to flush the pending TX packets from the specified queue */
 sl_status_t sli_si91x_flush_nodes_from_queue(sli_wifi_command_queue_t *queue,
                                              sli_si91x_node_free_function_t node_free_function);
@@ -171,6 +171,24 @@
 #ifndef SLI_BLE_BUFFER_FULL
 #define SLI_BLE_BUFFER_FULL (1 << 4)
 #endif
+
+// Frames the NCP host may write per packet type after the NWP last reported free buffers, before the
+// interrupt status has to be read again. A clear buffer-full bit only guarantees room for one more frame, so the
+// default reads the interrupt status before every frame. Raise it only for NWP firmware known to buffer more.
+#ifndef SLI_SI91X_NWP_TX_CREDITS
+#define SLI_SI91X_NWP_TX_CREDITS 1
+#endif
+
+// Time the NCP host keeps the NWP awake after a TX burst drained the queues, so back-to-back sends in power save
+// profiles share one wakeup handshake
+#ifndef SLI_SI91X_WAKE_LOCK_LINGER_MS
+#define SLI_SI91X_WAKE_LOCK_LINGER_MS 5
+#endif
+
+// Frames written under one wakeup before the NWP is allowed to sleep again
+#ifndef SLI_SI91X_WAKE_LOCK_TX_BUDGET
+#define SLI_SI91X_WAKE_LOCK_TX_BUDGET 32
+#endif
 // Wi-Fi buffer empty indication register value from NWP module
 #define SLI_BUFFER_EMPTY 0x02
 // RX packet pending register value from NWP module
@@ -150,6 +150,35 @@ sl_status_t sli_si91x_driver_send_command(uint32_t command,
                                           void *sdk_context,
                                           sl_wifi_buffer_t **data_buffer);
 
+/***************************************************************************/ /**
+ * @brief
+ *   Send a command that is already built in a command buffer to the NWP firmware.
+ * @param[in] command
+ *   Command type to be sent to NWP firmware.
+ * @param[in] command_type
+ *   @ref sli_wifi_command_type_t Command type
+ * @param[in] buffer
+ *   Command buffer from @ref sli_si91x_allocate_command_buffer with the packet descriptor and payload filled in.
+ *   The driver owns the buffer after this call, also when it fails.
+ * @param[in] wait_period
+ *   @ref sli_wifi_wait_period_t Timeout for the command response.
+ * @param[in] sdk_context
+ *   Pointer to the context.
+ * @param[in] data_buffer
+ *   [sl_wifi_buffer_t](../wiseconnect-api-reference-guide-wi-fi/sl-wifi-buffer-t) Pointer to a data buffer pointer for the response data to be returned in.
+ * @pre Pre-conditions:
+ * - 
+ *   @ref sl_si91x_driver_init should be called before this API.
+ * @return
+ *   sl_status_t. See https://docs.silabs.com/gecko-platform/latest/platform-common/status for details.
+ ******************************************************************************/
+sl_status_t sli_si91x_driver_send_command_packet(uint32_t command,
+                                                 sli_wifi_command_type_t command_type,
+                                                 sl_wifi_buffer_t *buffer,
+                                                 sli_wifi_wait_period_t wait_period,
+                                                 void *sdk_context,
+                                                 sl_wifi_buffer_t **data_buffer);
+
 /***************************************************************************/ /**
  * @brief
  *   Register a function and optional argument for scan results callback.
@@ -223,6 +252,17 @@ sl_status_t sli_si91x_driver_send_socket_data(const sli_si91x_socket_send_reques
                                               const void *data,
                                               uint32_t wait_time);
 
+/***************************************************************************/ /**
+ * @brief
+ *   Queue a chain of socket data frames for transmission in one step.
+ * @param[in,out] frames
+ *   Frames built by the caller and linked in order. The queue is left empty.
+ * @pre Pre-conditions:
+ * - 
+ *   @ref sl_si91x_driver_init should be called before this API.
+ ******************************************************************************/
+void sli_si91x_driver_queue_socket_data_frames(sli_wifi_buffer_queue_t *frames);
+
 /***************************************************************************/ /**
  * @brief
  *   Send a Bluetooth command.
@@ -323,6 +363,46 @@ typedef struct {
   sl_si91x_assertion_type_t assert_type;   ///< Assertion type. It must be in the range of 0 to 15 (both included).
   sl_si91x_assertion_level_t assert_level; ///< Assertion level. It must be in the range of 0 to 15 (both included).
 } sl_si91x_assertion_t;
+
+/// Host bus transaction counters of the command engine. The bus transactions spent per payload byte are (interrupt_status_reads + frames_written) / payload_bytes.
+typedef struct {
+  uint32_t interrupt_status_reads; ///< Interrupt status register reads issued by the command engine
+  uint32_t frames_written;         ///< Command and data frames written to the NWP
+  uint32_t payload_bytes;          ///< Bytes carried by the frames written, excluding the frame descriptor
+} sl_si91x_bus_statistics_t;
+
+/// Queues of the RX dispatch worker pool. Events of one queue are handled in the order they were received.
+typedef enum {
+  SL_SI91X_RX_DISPATCH_WIFI_QUEUE,        ///< Wi-Fi events passed to the Wi-Fi event handler
+  SL_SI91X_RX_DISPATCH_NETWORK_QUEUE,     ///< Network events, such as IP address changes and MQTT or HTTP client events
+  SL_SI91X_RX_DISPATCH_SOCKET_QUEUE,      ///< Socket events, such as accept, remote termination and TCP acknowledgment
+  SL_SI91X_RX_DISPATCH_SOCKET_DATA_QUEUE, ///< Data received on asynchronous sockets, passed to their receive callbacks
+  SL_SI91X_RX_DISPATCH_BLE_QUEUE,         ///< BLE events
+  SL_SI91X_RX_DISPATCH_QUEUE_COUNT,       ///< Number of queues
+} sl_si91x_rx_dispatch_queue_t;
+
+/// What the RX event thread does with an event when the dispatch queue it belongs to is full
+typedef enum {
+  SL_SI91X_RX_DISPATCH_HOLD,        ///< Keep the event and the ones after it with the driver until the queue has room
+  SL_SI91X_RX_DISPATCH_DROP_NEWEST, ///< Drop the event
+  SL_SI91X_RX_DISPATCH_DROP_OLDEST, ///< Drop the oldest event of the queue to make room for the event
+} sl_si91x_rx_dispatch_overload_policy_t;
+
+/// Configuration of an RX dispatch queue
+typedef struct {
+  uint8_t depth;                                          ///< Queue depth, at most SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH
+  sl_si91x_rx_dispatch_overload_policy_t overload_policy; ///< Policy applied once depth events are queued
+} sl_si91x_rx_dispatch_queue_configuration_t;
+
+/// Counters of an RX dispatch queue. Latency is the time from the event reaching the queue until a worker picks it up.
+typedef struct {
+  uint32_t dispatched;       ///< Events handled by a worker
+  uint32_t dropped;          ///< Events dropped by the overload policy
+  uint32_t held;             ///< Times the queue was full and events were kept with the driver
+  uint32_t total_latency_ms; ///< Sum of the latencies of the dispatched events, divide by dispatched for the average
+  uint32_t max_latency_ms;   ///< Largest latency of a dispatched event
+  uint8_t high_watermark;    ///< Largest number of events queued at the same time
+} sl_si91x_rx_dispatch_queue_statistics_t;
 /** @} */
 
 /** \addtogroup SI91X_DRIVER_FUNCTIONS 
@@ -1109,6 +1189,76 @@ sl_status_t sl_si91x_disable_radio(void);
  ******************************************************************************/
 void sl_si91x_set_listen_interval(uint32_t listen_interval) SL_DEPRECATED_API_WISECONNECT_3_5;
 
+/***************************************************************************/ /**
+ * @brief
+ *   Retrieves the host bus transaction counters of the command engine.
+ *
+ * @details
+ *   On NCP hosts, the command engine tracks NWP TX buffer credits and only reads the interrupt status
+ *   register when the credits for a packet type run out or the NWP raises an interrupt. These counters
+ *   make that saving measurable. The counters are cumulative since initialization or the last call to
+ *   @ref sl_si91x_reset_bus_statistics.
+ *
+ * @param[out] statistics
+ *   Pointer to an @ref sl_si91x_bus_statistics_t structure that receives the counters.
+ ******************************************************************************/
+void sl_si91x_get_bus_statistics(sl_si91x_bus_statistics_t *statistics);
+
+/***************************************************************************/ /**
+ * @brief
+ *   Clears the host bus transaction counters of the command engine.
+ ******************************************************************************/
+void sl_si91x_reset_bus_statistics(void);
+
+/***************************************************************************/ /**
+ * @brief
+ *   Configures the depth and overload policy of an RX dispatch queue.
+ *
+ * @details
+ *   When SL_SI91X_RX_DISPATCH_WORKER_COUNT is greater than 0, the RX event thread only sorts asynchronous
+ *   events into one queue per protocol, and a pool of worker threads calls the application callbacks. Each
+ *   queue is always handled by the same worker, so events of a socket or connection keep their order, while
+ *   a slow callback of one protocol no longer delays the others. Socket events and socket data share a worker.
+ *
+ * @param[in] queue
+ *   Queue to configure.
+ * @param[in] configuration
+ *   Pointer to an @ref sl_si91x_rx_dispatch_queue_configuration_t structure with the new configuration.
+ *
+ * @return
+ *   sl_status_t. SL_STATUS_NOT_SUPPORTED if SL_SI91X_RX_DISPATCH_WORKER_COUNT is 0, SL_STATUS_INVALID_PARAMETER
+ *   for a depth out of range, or for a drop policy on @ref SL_SI91X_RX_DISPATCH_SOCKET_DATA_QUEUE, as dropping
+ *   stream data would corrupt it.
+ *
+ * @note
+ *   The socket data queue holds data already accepted by the receive window of the socket, so holding it back
+ *   only delays the window update sent to the peer.
+ ******************************************************************************/
+sl_status_t sl_si91x_set_rx_dispatch_queue_configuration(
+  sl_si91x_rx_dispatch_queue_t queue,
+  const sl_si91x_rx_dispatch_queue_configuration_t *configuration);
+
+/***************************************************************************/ /**
+ * @brief
+ *   Retrieves the counters of an RX dispatch queue.
+ *
+ * @param[in] queue
+ *   Queue to query.
+ * @param[out] statistics
+ *   Pointer to an @ref sl_si91x_rx_dispatch_queue_statistics_t structure that receives the counters.
+ *
+ * @return
+ *   sl_status_t. SL_STATUS_NOT_SUPPORTED if SL_SI91X_RX_DISPATCH_WORKER_COUNT is 0.
+ ******************************************************************************/
+sl_status_t sl_si91x_get_rx_dispatch_queue_statistics(sl_si91x_rx_dispatch_queue_t queue,
+                                                      sl_si91x_rx_dispatch_queue_statistics_t *statistics);
+
+/***************************************************************************/ /**
+ * @brief
+ *   Clears the counters of all RX dispatch queues.
+ ******************************************************************************/
+void sl_si91x_reset_rx_dispatch_statistics(void);
+
 /** @} */
 
 /***************************************************************************/ /**
@@ -37,6 +37,7 @@
 #include "sl_core.h"
 #include <string.h>
 #include "sl_rsi_utility.h"
+#include "sli_wifi_utility.h"
 
 #define SLI_BUFFER_TYPE    4
 #define SLI_WATERMARKLEVEL 10
@@ -45,6 +46,8 @@ static const sl_wifi_buffer_configuration_t *configuration;
 void *allocated_wifi_buffer                       = NULL;
 static uint8_t buffer_allocation[SLI_BUFFER_TYPE] = { 0, 0, 0, 0 };
 static uint8_t quota[SLI_BUFFER_TYPE];
+// Threads waiting for the quota of each buffer type, served in arrival order
+static sli_wifi_wait_queue_t buffer_waiters[SLI_BUFFER_TYPE];
 
 #ifndef SL_WIFI_BUFFERS_FREE_WAIT_TIME
 #define SL_WIFI_BUFFERS_FREE_WAIT_TIME 1000 // wait for 1 second to free all the wi-fi buffer
@@ -54,6 +57,7 @@ static uint8_t quota[SLI_BUFFER_TYPE];
 static void sl_si91x_convert_config_structure_to_array(const sl_wifi_buffer_configuration_t *config);
 static sl_status_t sl_si91x_check_for_valid_config(const sl_wifi_buffer_configuration_t *config);
 static bool sl_si91x_check_for_buffer_empty(void);
+static osThreadId_t sli_si91x_release_buffer_quota(uint8_t type);
 /*---------------------------------------------------------------------------------*/
 
 sl_status_t sli_si91x_host_init_buffer_manager(const sl_wifi_buffer_configuration_t *config)
@@ -122,32 +126,46 @@ sl_status_t sli_si91x_host_allocate_buffer(sl_wifi_buffer_t **buffer,
   if (buffer == NULL) {
     return SL_STATUS_INVALID_PARAMETER;
   }
-  uint32_t start_time = osKernelGetTickCount();
-  uint32_t delay      = 2;
-  *buffer             = NULL;
-  do {
-    CORE_DECLARE_IRQ_STATE;
-    CORE_ENTER_CRITICAL();
-    // Atomically check quota, allocate, and update counter
-    if (buffer_allocation[type] < quota[type]) {
-      *buffer = sli_mem_pool_alloc(&mem_pool);
-      if (*buffer != NULL) {
-        buffer_allocation[type]++; // Update counter immediately
-        CORE_EXIT_CRITICAL();
-        // Initialize buffer outside critical section
-        (*buffer)->type      = (uint8_t)type;
-        (*buffer)->node.node = NULL;
-        (*buffer)->length    = configuration->block_size - sizeof(sl_wifi_buffer_t);
-        break;
-      }
+  sli_wifi_waiter_t waiter;
+  bool reserved = false;
+  *buffer       = NULL;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  // Take a slot of the quota only if nobody is queued for it, so waiters are served in order
+  if ((buffer_allocation[type] < quota[type]) && (buffer_waiters[type].head == NULL)) {
+    buffer_allocation[type]++;
+    reserved = true;
+  } else if (wait_duration_ms != 0) {
+    sli_wifi_wait_queue_append(&buffer_waiters[type], &waiter);
+  }
+  CORE_EXIT_CRITICAL();
+
+  if (!reserved) {
+    // Sleep until sli_si91x_host_free_buffer() hands over the slot of a released buffer of this type
+    if ((wait_duration_ms == 0)
+        || (sli_wifi_wait_queue_wait(&buffer_waiters[type], &waiter, SLI_SYSTEM_MS_TO_TICKS(wait_duration_ms))
+            != SL_STATUS_OK)) {
+      return SL_STATUS_ALLOCATION_FAILED;
     }
-    CORE_EXIT_CRITICAL();
-    osDelay(SLI_SYSTEM_MS_TO_TICKS(delay));
-    delay = (delay < 50) ? delay * 2 : 50;
-  } while (sl_si91x_host_elapsed_time(start_time) <= wait_duration_ms);
+  }
+
+  // The pool holds one block per slot of every quota, so a reserved slot always has a block behind it
+  osThreadId_t woken = NULL;
+  CORE_ENTER_CRITICAL();
+  *buffer = sli_mem_pool_alloc(&mem_pool);
   if (*buffer == NULL) {
+    woken = sli_si91x_release_buffer_quota((uint8_t)type);
+  }
+  CORE_EXIT_CRITICAL();
+  if (*buffer == NULL) {
+    sli_wifi_wait_queue_notify(woken);
     return SL_STATUS_ALLOCATION_FAILED;
   }
+
+  (*buffer)->type      = (uint8_t)type;
+  (*buffer)->node.node = NULL;
+  (*buffer)->length    = configuration->block_size - sizeof(sl_wifi_buffer_t);
   return SL_STATUS_OK;
 }
 
@@ -167,14 +185,29 @@ void sli_si91x_host_free_buffer(sl_wifi_buffer_t *buffer)
   if (buffer == NULL) {
     return;
   }
+  uint8_t type = buffer->type;
   CORE_DECLARE_IRQ_STATE;
   CORE_ENTER_CRITICAL();
   sli_mem_pool_free(&mem_pool, buffer);
+  osThreadId_t woken = sli_si91x_release_buffer_quota(type);
+  CORE_EXIT_CRITICAL();
+  // Woken outside the critical section, the thread already owns the slot
+  sli_wifi_wait_queue_notify(woken);
+}
+
+// Must be called with interrupts disabled, returns the thread to wake with sli_wifi_wait_queue_notify() or NULL
+static osThreadId_t sli_si91x_release_buffer_quota(uint8_t type)
+{
+  // A queued thread takes over the slot, so the allocation count of the type stays unchanged
+  osThreadId_t woken = sli_wifi_wait_queue_grant_one(&buffer_waiters[type]);
+  if (woken != NULL) {
+    return woken;
+  }
   // Decreasing the count of the current allocation of the buffer type
-  if (buffer_allocation[buffer->type] > 0) {
-    buffer_allocation[buffer->type]--;
+  if (buffer_allocation[type] > 0) {
+    buffer_allocation[type]--;
   }
-  CORE_EXIT_CRITICAL();
+  return NULL;
 }
 
 static void sl_si91x_convert_config_structure_to_array(const sl_wifi_buffer_configuration_t *config)
@@ -112,6 +112,58 @@
 #define SL_SI91X_SO_DTLS_ENABLE                      51 ///< To enable DTLS
 #define SL_SI91X_SO_DTLS_V_1_0_ENABLE                52 ///< To enable DTLS 1.0
 #define SL_SI91X_SO_DTLS_V_1_2_ENABLE                53 ///< To enable DTLS 1.2
+#define SL_SI91X_SO_TX_WEIGHT                        54 ///< To configure the TX scheduling weight (uint8_t, 1 to SL_SI91X_SOCKET_TX_MAX_WEIGHT)
+#define SL_SI91X_SO_TX_PRIORITY                      55 ///< To configure the TX priority class (uint8_t, SL_SI91X_SOCKET_TX_PRIORITY_*)
+#define SL_SI91X_SO_RCV_READ_AHEAD                   56 ///< To configure the host receive read-ahead window of a stream socket (uint16_t bytes, 0 disables)
+#define SL_SI91X_SO_TCP_NODELAY                      57 ///< To send each write of a stream socket as its own frame (uint8_t, 1 by default) or, when 0, append small writes to a frame still queued on the host
+#define SL_SI91X_SO_TCP_CORK                         58 ///< To hold partly filled frames of a stream socket until they reach the MSS, the option is cleared or the flush timeout expires (uint8_t)
+/** @} */
+
+/**
+ * @addtogroup SI91X_SOCKET_TX_PRIORITY SiWx91x Socket TX Priority Class
+ * @ingroup SI91X_SOCKET_FUNCTIONS
+ * @{ 
+ */
+#define SL_SI91X_SOCKET_TX_PRIORITY_LOW    0 ///< Sent only when no socket of a higher class has data queued
+#define SL_SI91X_SOCKET_TX_PRIORITY_NORMAL 1 ///< Default class for new sockets
+#define SL_SI91X_SOCKET_TX_PRIORITY_HIGH   2 ///< Sent before sockets of any other class
+#define SL_SI91X_SOCKET_TX_MAX_WEIGHT      16 ///< Largest accepted TX scheduling weight
+/** @} */
+
+#define SLI_SI91X_SOCKET_TX_PRIORITY_CLASSES 3
+#define SLI_SI91X_SOCKET_TX_DEFAULT_WEIGHT   1
+
+// Bytes of socket data credited per unit of weight in each deficit round-robin round
+#ifndef SLI_SI91X_SOCKET_TX_QUANTUM
+#define SLI_SI91X_SOCKET_TX_QUANTUM 1500
+#endif
+
+// Longest time a corked stream socket holds back a partly filled frame
+#ifndef SL_SI91X_SOCKET_CORK_FLUSH_TIMEOUT_MS
+#define SL_SI91X_SOCKET_CORK_FLUSH_TIMEOUT_MS 200
+#endif
+
+// Receive buffers the application may hold across all sockets at once, kept below the RX buffer quota so the
+// driver can still receive while they are held
+#ifndef SL_SI91X_SOCKET_MAX_RX_BUFFER_LOANS
+#define SL_SI91X_SOCKET_MAX_RX_BUFFER_LOANS 4
+#endif
+
+/**
+ * @addtogroup SI91X_SOCKET_RECEIVE_FLAGS
+ * @{
+ */
+#ifndef SL_SI91X_SOCKET_READ_AHEAD_WINDOW
+#define SL_SI91X_SOCKET_READ_AHEAD_WINDOW 0 ///< Default host receive read-ahead window in bytes for new stream sockets, 0 disables read-ahead
+#endif
+
+#ifndef MSG_PEEK
+#define MSG_PEEK 0x02 ///< Return buffered stream data without removing it from the socket
+#endif
+
+#ifndef MSG_WAITALL
+#define MSG_WAITALL 0x40 ///< Block until the full request is satisfied, the peer closes or the read times out
+#endif
 /** @} */
 
 /**
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * @file  sl_si91x_socket_epoll.h
+ * @brief Host-side socket readiness notification for si91x sockets
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @addtogroup SI91X_SOCKET_EPOLL SiWx91x Socket Readiness Notification
+ * @ingroup SI91X_SOCKET_FUNCTIONS
+ * @{
+ */
+
+#ifndef SL_SI91X_EPOLL_MAX_INSTANCES
+#define SL_SI91X_EPOLL_MAX_INSTANCES 2 ///< Number of epoll instances that can be open at the same time
+#endif
+
+// Interval at which sl_si91x_epoll_wait() polls the firmware for sockets it cannot track on the host
+#ifndef SL_SI91X_EPOLL_FIRMWARE_POLL_INTERVAL_MS
+#define SL_SI91X_EPOLL_FIRMWARE_POLL_INTERVAL_MS 100
+#endif
+
+#define SL_SI91X_EPOLLIN  0x001U        ///< Data can be read, or an asynchronous accept completed on a listening socket
+#define SL_SI91X_EPOLLOUT 0x004U        ///< Data can be queued for transmission without blocking
+#define SL_SI91X_EPOLLERR 0x008U        ///< Error condition, always reported
+#define SL_SI91X_EPOLLHUP 0x010U        ///< Connection closed by the peer, always reported
+#define SL_SI91X_EPOLLET  (1UL << 31)   ///< Edge-triggered: report each transition once instead of while it persists
+
+#define SL_SI91X_EPOLL_CTL_ADD 1 ///< Register a socket with an epoll instance
+#define SL_SI91X_EPOLL_CTL_DEL 2 ///< Remove a socket from an epoll instance
+#define SL_SI91X_EPOLL_CTL_MOD 3 ///< Change the events and user data of a registered socket
+
+/// User data returned with an event
+typedef union {
+  void *ptr;    ///< Pointer
+  int fd;       ///< Socket
+  uint32_t u32; ///< 32-bit value
+} sl_si91x_epoll_data_t;
+
+/// Epoll event
+typedef struct {
+  uint32_t events;            ///< Bit mask of SL_SI91X_EPOLL* events
+  sl_si91x_epoll_data_t data; ///< User data, returned unchanged by sl_si91x_epoll_wait()
+} sl_si91x_epoll_event_t;
+
+/**
+ * @brief
+ *   Create an epoll instance.
+ *
+ * @details
+ *   Readiness is tracked on the host from the receive, accept, TCP acknowledgment, remote termination and
+ *   transmit completion indications the driver already handles, so waiting on many sockets does not cost a
+ *   firmware select per call and sockets do not have to be re-registered before each wait.
+ *
+ * @return
+ *   Epoll instance descriptor on success, or -1 on failure with errno set to ENOMEM if all instances are in use.
+ */
+int sl_si91x_epoll_create(void);
+
+/**
+ * @brief
+ *   Add, modify or remove a socket in the interest list of an epoll instance.
+ *
+ * @param[in] epfd   Epoll instance descriptor returned by @ref sl_si91x_epoll_create.
+ * @param[in] op     One of SL_SI91X_EPOLL_CTL_ADD, SL_SI91X_EPOLL_CTL_MOD or SL_SI91X_EPOLL_CTL_DEL.
+ * @param[in] socket Socket to register.
+ * @param[in] event  Events of interest and user data. Ignored for SL_SI91X_EPOLL_CTL_DEL.
+ *
+ * @return
+ *   0 on success, or -1 on failure with errno set to EBADF, EINVAL, EEXIST, ENOENT or ENOMEM.
+ *
+ * @note
+ *   A socket that is already ready when it is added or modified is reported by the next wait, in both modes.
+ *   Closing a socket removes it from every epoll instance.
+ */
+int sl_si91x_epoll_ctl(int epfd, int op, int socket, const sl_si91x_epoll_event_t *event);
+
+/**
+ * @brief
+ *   Wait for events on the sockets registered with an epoll instance.
+ *
+ * @param[in]  epfd       Epoll instance descriptor.
+ * @param[out] events     Array receiving the ready sockets.
+ * @param[in]  max_events Number of entries in events, must be greater than 0.
+ * @param[in]  timeout_ms Time to wait in milliseconds, 0 to return immediately or -1 to wait forever.
+ *
+ * @return
+ *   Number of entries written to events, 0 on timeout, or -1 on failure with errno set to EBADF, EINVAL, or
+ *   the error of the firmware select.
+ *
+ * @note
+ *   Only sockets that became ready are visited, so the cost of a wait does not grow with the number of
+ *   registered sockets.
+ *   Synchronous stream sockets receive data only when they ask the firmware for it. While no other socket
+ *   is ready, readiness for reading on those sockets is polled with a non-blocking firmware select limited to
+ *   them, at most every SL_SI91X_EPOLL_FIRMWARE_POLL_INTERVAL_MS, and data the firmware reports is pulled into the
+ *   receive ring before SL_SI91X_EPOLLIN is reported. Sockets with data in their receive ring never need the
+ *   firmware. Data handed to a receive callback is consumed there and does not raise SL_SI91X_EPOLLIN.
+ *   Only one task may wait on an epoll instance at a time.
+ */
+int sl_si91x_epoll_wait(int epfd, sl_si91x_epoll_event_t *events, int max_events, int timeout_ms);
+
+/**
+ * @brief
+ *   Close an epoll instance and release its registrations.
+ *
+ * @param[in] epfd Epoll instance descriptor.
+ *
+ * @return
+ *   0 on success, or -1 on failure with errno set to EBADF.
+ *
+ * @note
+ *   The instance must not be closed while a task is waiting on it.
+ */
+int sl_si91x_epoll_close(int epfd);
+
+/** @} */
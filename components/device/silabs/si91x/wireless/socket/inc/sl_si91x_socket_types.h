@@ -110,6 +110,41 @@ typedef void (*sl_si91x_socket_receive_data_callback_t)(uint32_t socket,
                                                         uint32_t length,
                                                         const sl_si91x_socket_metadata_t *firmware_socket_response);
 
+/**
+ * @typedef sl_si91x_socket_receive_buffer_callback_t
+ * @brief Callback function that receives asynchronous data together with the buffer holding it.
+ *
+ * @details
+ * The callback is registered with sl_si91x_set_receive_buffer_callback and replaces the receive data callback
+ * of the socket. It may keep the buffer to process the data later, on another thread, without copying it.
+ * A kept buffer must be handed back with sl_si91x_release_receive_buffer.
+ *
+ * @param socket
+ *   Socket ID.
+ *
+ * @param buffer
+ *   Buffer holding the data, or NULL if the socket already holds its quota of buffers. When NULL, the data is
+ *   only valid until the callback returns.
+ *
+ * @param data
+ *   Pointer to the received data inside the buffer.
+ *
+ * @param length
+ *   Length of the received data.
+ *
+ * @param firmware_socket_response
+ *   Metadata of the received packet, stored in the same buffer.
+ *
+ * @return
+ *   true if the application keeps the buffer, false to let the driver free it when the callback returns.
+ *   Ignored when buffer is NULL.
+ */
+typedef bool (*sl_si91x_socket_receive_buffer_callback_t)(uint32_t socket,
+                                                          sl_wifi_buffer_t *buffer,
+                                                          uint8_t *data,
+                                                          uint32_t length,
+                                                          const sl_si91x_socket_metadata_t *firmware_socket_response);
+
 /**
  * @typedef sl_si91x_socket_accept_callback_t
  * @brief Callback functions for new asynchronous accepted connection.
@@ -258,6 +293,13 @@ typedef struct {
 
 #pragma pack()
 
+/// Per-socket transmit counters
+typedef struct {
+  uint32_t tx_bytes;     ///< Bytes of socket data written to the bus
+  uint32_t tx_frames;    ///< Socket data frames written to the bus
+  uint32_t tx_coalesced; ///< Writes appended to a frame already on the host, each saving one buffer and one bus frame
+} sl_si91x_socket_tx_statistics_t;
+
 /// Internal si91x socket handle
 typedef struct {
   int32_t id;                          ///< Socket ID
@@ -288,6 +330,7 @@ typedef struct {
   uint8_t opcode;                                                          ///< Opcode used in websocket
   sli_si91x_websocket_info_t *websocket_info;                              ///< Pointer to WebSocket info
   sl_si91x_socket_receive_data_callback_t recv_data_callback;              ///< Receive data callback
+  sl_si91x_socket_receive_buffer_callback_t recv_buffer_callback;          ///< Receive callback that can keep buffers
   sl_si91x_socket_data_transfer_complete_handler_t data_transfer_callback; ///< Data transfer callback
   sl_si91x_socket_accept_callback_t user_accept_callback;                  ///< Async Accept callback
   osEventFlagsId_t socket_events;                                          ///< Event Flags for sockets
@@ -295,6 +338,25 @@ typedef struct {
   uint8_t socket_bitmap;                                                   ///< Socket Bitmap
   uint8_t data_buffer_count;              ///< Number of queued data buffers allocated by this socket
   uint8_t data_buffer_limit;              ///< Maximum number of queued data buffers permitted for this socket
+  uint8_t tx_priority;                    ///< TX priority class, one of SL_SI91X_SOCKET_TX_PRIORITY_*
+  uint8_t tx_weight;                      ///< TX scheduling weight, in quanta per round
+  int32_t tx_deficit;                     ///< Deficit round-robin credit in bytes
+  uint32_t tx_bytes;                      ///< Bytes of socket data written to the bus
+  uint32_t tx_frames;                     ///< Socket data frames written to the bus
+  uint32_t tx_coalesced;                  ///< Writes appended to a frame already on the host
+  bool tx_nodelay;                        ///< Send each write as its own frame, cleared to append writes to a queued frame
+  bool tx_cork;                           ///< Hold partly filled frames back from the scheduler
+  sl_wifi_buffer_t *tx_cork_buffer;       ///< Partly filled frame held back while the socket is corked
+  osTimerId_t tx_cork_timer;              ///< Releases tx_cork_buffer once the cork flush timeout expires
+  uint8_t *rx_ring;                       ///< Host receive ring for stream read-ahead, allocated on first use
+  uint16_t rx_ring_size;                  ///< Read-ahead window in bytes, 0 when read-ahead is disabled
+  uint16_t rx_ring_head;                  ///< Offset of the oldest buffered byte in rx_ring
+  uint16_t rx_ring_count;                 ///< Number of bytes buffered in rx_ring
+  bool rx_ring_on_demand;                 ///< rx_ring only serves MSG_PEEK or MSG_WAITALL and is released once drained
+  uint8_t rx_buffer_quota;                ///< Receive buffers the application may hold for this socket
+  uint8_t rx_buffers_held;                ///< Receive buffers currently held by the application
+  uint32_t rx_buffer_quota_exceeded;      ///< Receive buffers lent only for the callback because a quota was used up
+  sli_wifi_wait_queue_t tx_waiters;       ///< Senders waiting for a data buffer slot, in arrival order
   sli_wifi_command_queue_t command_queue; ///< Command queue
   sli_wifi_buffer_queue_t tx_data_queue;  ///< Transmit data queue
   sli_wifi_buffer_queue_t rx_data_queue;  ///< Receive data queue
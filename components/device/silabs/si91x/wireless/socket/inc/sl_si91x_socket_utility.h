@@ -108,6 +108,9 @@
 
 extern sli_si91x_socket_t *sli_si91x_sockets[SLI_NUMBER_OF_SOCKETS];
 
+// Incremented each time a socket index is freed, so that data queued for a closed socket is not given to its successor
+extern uint8_t sli_si91x_socket_generations[SLI_NUMBER_OF_SOCKETS];
+
 sl_status_t sli_si91x_socket_init(uint8_t max_select_count);
 
 sl_status_t sli_si91x_socket_deinit(void);
@@ -316,6 +319,18 @@ sli_si91x_socket_t *sli_si91x_get_socket_from_id(int socket_id,
 sl_status_t sli_si91x_send_socket_data(sli_si91x_socket_t *si91x_socket,
                                        const sli_si91x_socket_send_request_t *request,
                                        const void *data);
+
+/**
+ * A internal function to send a payload gathered from several buffers as one frame of a socket
+ * @param si91x_socket Socket to send on
+ * @param request Request header, its length is the combined length of the buffers
+ * @param iov Buffers copied into the frame in order
+ * @param iovcnt Number of entries in iov
+ */
+sl_status_t sli_si91x_send_socket_data_vector(sli_si91x_socket_t *si91x_socket,
+                                              const sli_si91x_socket_send_request_t *request,
+                                              const struct iovec *iov,
+                                              int iovcnt);
 int32_t sli_get_socket_command_from_host_packet(sl_wifi_buffer_t *buffer);
 
 void sli_si91x_set_socket_event(uint32_t event_mask);
@@ -327,6 +342,159 @@ sl_status_t sli_si91x_udp_connect_if_unconnected(sli_si91x_socket_t *si91x_socke
                                                  socklen_t to_addr_len,
                                                  int socket_id);
 
+/**
+ * A internal function to request up to length bytes of received data from the firmware
+ * @param si91x_socket Socket to read from
+ * @param length Number of bytes requested
+ * @param response_buffer Buffer holding the sl_si91x_socket_metadata_t response, owned by the caller
+ */
+sl_status_t sli_si91x_socket_read_data(sli_si91x_socket_t *si91x_socket,
+                                       size_t length,
+                                       sl_wifi_buffer_t **response_buffer);
+
+/**
+ * A internal function to set the read-ahead window of a stream socket. The window can only change while no data is buffered.
+ * @param si91x_socket Stream socket
+ * @param window Window size in bytes, 0 disables read-ahead and releases the receive ring
+ */
+int sli_si91x_socket_set_read_ahead(sli_si91x_socket_t *si91x_socket, uint16_t window);
+
+/**
+ * A internal function to receive stream data through the host receive ring, honouring MSG_PEEK and MSG_WAITALL
+ * @param si91x_socket Connected stream socket
+ * @param buf Destination buffer
+ * @param buf_len Size of the destination buffer
+ * @param flags Receive flags
+ */
+ssize_t sli_si91x_socket_buffered_recv(sli_si91x_socket_t *si91x_socket, uint8_t *buf, size_t buf_len, int32_t flags);
+
+/**
+ * A internal function to return a data buffer slot of a socket, handing it to the oldest blocked sender if there is one
+ * @param si91x_socket Socket whose queued data buffer was written to the bus or dropped
+ */
+void sli_si91x_socket_release_tx_slot(sli_si91x_socket_t *si91x_socket);
+
+/**
+ * A internal function to check whether small writes to a socket are appended to a frame still waiting on the host
+ * @param si91x_socket Socket
+ */
+bool sli_si91x_socket_coalesces_writes(const sli_si91x_socket_t *si91x_socket);
+
+/**
+ * A internal function to cork or uncork a stream socket. Uncorking sends a partly filled frame at once.
+ * @param si91x_socket Stream socket
+ * @param cork true to hold partly filled frames back until they are full or the flush timeout expires
+ */
+int sli_si91x_socket_set_cork(sli_si91x_socket_t *si91x_socket, bool cork);
+
+/**
+ * A internal function to hand a frame held back by the cork to the scheduler
+ * @param si91x_socket Stream socket
+ */
+void sli_si91x_socket_flush_corked_data(sli_si91x_socket_t *si91x_socket);
+
+/**
+ * A internal function to register a receive callback that can keep the buffers it is given
+ * @param si91x_socket Socket
+ * @param callback Callback, NULL to go back to the receive data callback
+ * @param quota Receive buffers the application may hold for this socket, at most SL_SI91X_SOCKET_MAX_RX_BUFFER_LOANS
+ */
+int sli_si91x_socket_set_receive_buffer_callback(sli_si91x_socket_t *si91x_socket,
+                                                 sl_si91x_socket_receive_buffer_callback_t callback,
+                                                 uint8_t quota);
+
+/**
+ * A internal function to hand a received data buffer to the receive callback of a socket
+ * @param host_socket Host socket index
+ * @param buffer Buffer holding the sl_si91x_socket_metadata_t and the data
+ * @return true if the application kept the buffer, false if the caller still has to free it
+ */
+bool sli_si91x_socket_deliver_received_data(int32_t host_socket, sl_wifi_buffer_t *buffer);
+
+/**
+ * A internal function to take back a receive buffer kept by the application and free it
+ * @param buffer Buffer passed to a receive buffer callback that returned true
+ */
+sl_status_t sli_si91x_socket_release_receive_buffer(sl_wifi_buffer_t *buffer);
+
+/// Frames built for one socket and queued together
+typedef struct {
+  sli_si91x_socket_t *socket;     ///< Socket the frames belong to
+  sli_wifi_buffer_queue_t frames; ///< Frames not queued yet, in order
+  bool socket_queue;              ///< true for the socket transmit queue, false for the generic data queue
+} sli_si91x_socket_send_batch_t;
+
+/**
+ * A internal function to reserve a data buffer slot of a socket
+ * @param si91x_socket Socket
+ * @param wait false to return SL_STATUS_WOULD_BLOCK instead of waiting for a slot
+ */
+sl_status_t sli_si91x_socket_reserve_tx_slot(sli_si91x_socket_t *si91x_socket, bool wait);
+
+/**
+ * A internal function to allocate a data frame and fill it with a request header and a gathered payload
+ * @param request Request header
+ * @param iov Buffers copied into the frame in order
+ * @param iovcnt Number of entries in iov
+ * @param payload_room Payload capacity of the frame, at least the length of the request
+ * @param wait_time Time to wait for a buffer
+ * @param frame Allocated frame
+ */
+sl_status_t sli_si91x_socket_build_data_frame(const sli_si91x_socket_send_request_t *request,
+                                              const struct iovec *iov,
+                                              int iovcnt,
+                                              uint32_t payload_room,
+                                              uint32_t wait_time,
+                                              sl_wifi_buffer_t **frame);
+
+/**
+ * A internal function to append a chain of frames to the transmit queue of a socket with one wakeup of the scheduler
+ * @param si91x_socket Socket holding a data buffer slot for each frame
+ * @param frames Frames linked in order, left empty
+ */
+void sli_si91x_socket_queue_data_frames(sli_si91x_socket_t *si91x_socket, sli_wifi_buffer_queue_t *frames);
+
+/**
+ * A internal function to start an empty batch
+ * @param batch Batch
+ * @param si91x_socket Socket the frames are sent on
+ * @param socket_queue true to queue the frames on the socket, false to queue them on the generic data queue
+ */
+void sli_si91x_socket_batch_init(sli_si91x_socket_send_batch_t *batch,
+                                 sli_si91x_socket_t *si91x_socket,
+                                 bool socket_queue);
+
+/**
+ * A internal function to build one frame of a batch. Frames already built are queued first if the frame would otherwise wait for resources.
+ * @param batch Batch
+ * @param request Request header
+ * @param iov Buffers copied into the frame in order
+ * @param iovcnt Number of entries in iov
+ */
+sl_status_t sli_si91x_socket_batch_add(sli_si91x_socket_send_batch_t *batch,
+                                       const sli_si91x_socket_send_request_t *request,
+                                       const struct iovec *iov,
+                                       int iovcnt);
+
+/**
+ * A internal function to queue the frames of a batch
+ * @param batch Batch, left empty
+ */
+void sli_si91x_socket_batch_flush(sli_si91x_socket_send_batch_t *batch);
+
+/**
+ * A internal function to report readiness events of a socket to the epoll instances it is registered with
+ * @param socket Host socket index
+ * @param events Bit mask of SL_SI91X_EPOLL* events that occurred
+ */
+void sli_si91x_epoll_notify(int socket, uint32_t events);
+
+/**
+ * A internal function to drop a socket from every epoll instance when it is freed
+ * @param socket Host socket index
+ */
+void sli_si91x_epoll_remove_socket(int socket);
+
 /**
  * @addtogroup SOCKET_CONFIGURATION_FUNCTION
  * @{
@@ -0,0 +1,519 @@
+/*******************************************************************************
+ * @file  sl_si91x_socket_epoll.c
+ * @brief Host-side socket readiness notification for si91x sockets
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include "sl_si91x_socket_epoll.h"
+#include "sl_si91x_socket_utility.h"
+#include "sl_si91x_socket_types.h"
+#include "sl_si91x_socket_constants.h"
+#include "sl_status.h"
+#include "sl_constants.h"
+#include "sl_core.h"
+#include "sl_cmsis_utility.h"
+#include "sl_rsi_utility.h"
+#include "cmsis_os2.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/*
+ * Each instance keeps one registration per host socket, indexed by the socket, and an intrusive list of the
+ * registrations that have something to report. The socket event handler marks a registration ready with
+ * sli_si91x_epoll_notify() and wakes the waiter, so a wait only ever visits ready sockets.
+ *
+ * Edge-triggered registrations report the events accumulated since the last wait. Level-triggered
+ * registrations additionally re-check the socket state and stay on the ready list while it persists.
+ */
+
+/******************************************************
+ *               Macro Definitions
+ ******************************************************/
+#define SLI_SI91X_EPOLL_WAKE_EVENT (1 << 0)
+
+// Conditions reported whether or not they were requested
+#define SLI_SI91X_EPOLL_ALWAYS_REPORTED (SL_SI91X_EPOLLERR | SL_SI91X_EPOLLHUP)
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+typedef struct sli_si91x_epoll_registration_s {
+  struct sli_si91x_epoll_registration_s *next; ///< Next registration on the ready list
+  sl_si91x_epoll_event_t event;                ///< Events of interest and user data
+  uint32_t pending;                            ///< Events signalled since the last report
+  int32_t socket;                              ///< Host socket index
+  bool queued;                                 ///< Registration is on the ready list
+} sli_si91x_epoll_registration_t;
+
+typedef struct {
+  bool in_use;
+  osEventFlagsId_t wake_event;
+  sli_si91x_epoll_registration_t *registrations[SLI_NUMBER_OF_SOCKETS];
+  sli_si91x_epoll_registration_t *ready_head;
+  sli_si91x_epoll_registration_t *ready_tail;
+} sli_si91x_epoll_instance_t;
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+static sli_si91x_epoll_instance_t sli_si91x_epoll_instances[SL_SI91X_EPOLL_MAX_INSTANCES];
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+static sli_si91x_epoll_instance_t *sli_si91x_get_epoll_instance(int epfd)
+{
+  if ((epfd < 0) || (epfd >= SL_SI91X_EPOLL_MAX_INSTANCES) || !sli_si91x_epoll_instances[epfd].in_use) {
+    return NULL;
+  }
+  return &sli_si91x_epoll_instances[epfd];
+}
+
+// Current readiness of a socket, derived from the state the driver keeps for it
+static uint32_t sli_si91x_epoll_socket_level(const sli_si91x_socket_t *socket)
+{
+  uint32_t events = 0;
+
+  if (socket == NULL) {
+    return SL_SI91X_EPOLLERR | SL_SI91X_EPOLLHUP;
+  }
+
+  if (socket->rx_ring_count > 0) {
+    events |= SL_SI91X_EPOLLIN;
+  }
+
+  if (socket->state == DISCONNECTED) {
+    // A closed connection reads end of stream without blocking
+    return events | SL_SI91X_EPOLLIN | SL_SI91X_EPOLLHUP;
+  }
+
+  bool can_send = (socket->state == CONNECTED)
+                  || ((socket->type == SOCK_DGRAM) && (socket->state != RESET) && (socket->state != LISTEN));
+  bool has_buffer =
+    (socket->data_buffer_limit == 0) || (socket->data_buffer_count < socket->data_buffer_limit);
+
+  if (can_send && has_buffer && !socket->is_waiting_on_ack) {
+    events |= SL_SI91X_EPOLLOUT;
+  }
+  return events;
+}
+
+// Must be called with interrupts disabled; the caller wakes the waiter once interrupts are enabled again
+static void sli_si91x_epoll_queue(sli_si91x_epoll_instance_t *instance,
+                                  sli_si91x_epoll_registration_t *registration,
+                                  uint32_t events)
+{
+  registration->pending |= events;
+  if (registration->queued) {
+    return;
+  }
+  registration->queued = true;
+  registration->next   = NULL;
+  if (instance->ready_tail == NULL) {
+    instance->ready_head = registration;
+  } else {
+    instance->ready_tail->next = registration;
+  }
+  instance->ready_tail = registration;
+}
+
+// Must be called with interrupts disabled
+static void sli_si91x_epoll_unlink(sli_si91x_epoll_instance_t *instance,
+                                   const sli_si91x_epoll_registration_t *registration)
+{
+  sli_si91x_epoll_registration_t *previous = NULL;
+
+  if (!registration->queued) {
+    return;
+  }
+  for (sli_si91x_epoll_registration_t *entry = instance->ready_head; entry != NULL; entry = entry->next) {
+    if (entry != registration) {
+      previous = entry;
+      continue;
+    }
+    if (previous == NULL) {
+      instance->ready_head = entry->next;
+    } else {
+      previous->next = entry->next;
+    }
+    if (instance->ready_tail == entry) {
+      instance->ready_tail = previous;
+    }
+    break;
+  }
+}
+
+void sli_si91x_epoll_notify(int socket, uint32_t events)
+{
+  if ((socket < 0) || (socket >= SLI_NUMBER_OF_SOCKETS)) {
+    return;
+  }
+
+  for (uint8_t index = 0; index < SL_SI91X_EPOLL_MAX_INSTANCES; index++) {
+    sli_si91x_epoll_instance_t *instance = &sli_si91x_epoll_instances[index];
+
+    osEventFlagsId_t wake_event                  = NULL;
+    CORE_irqState_t state                        = CORE_EnterAtomic();
+    sli_si91x_epoll_registration_t *registration = instance->in_use ? instance->registrations[socket] : NULL;
+    if ((registration != NULL)
+        && ((events & (registration->event.events | SLI_SI91X_EPOLL_ALWAYS_REPORTED)) != 0)) {
+      sli_si91x_epoll_queue(instance, registration, events);
+      wake_event = instance->wake_event;
+    }
+    CORE_ExitAtomic(state);
+
+    if (wake_event != NULL) {
+      osEventFlagsSet(wake_event, SLI_SI91X_EPOLL_WAKE_EVENT);
+    }
+  }
+}
+
+void sli_si91x_epoll_remove_socket(int socket)
+{
+  if ((socket < 0) || (socket >= SLI_NUMBER_OF_SOCKETS)) {
+    return;
+  }
+
+  for (uint8_t index = 0; index < SL_SI91X_EPOLL_MAX_INSTANCES; index++) {
+    sli_si91x_epoll_instance_t *instance = &sli_si91x_epoll_instances[index];
+
+    CORE_irqState_t state                        = CORE_EnterAtomic();
+    sli_si91x_epoll_registration_t *registration = instance->registrations[socket];
+    if (registration != NULL) {
+      sli_si91x_epoll_unlink(instance, registration);
+      instance->registrations[socket] = NULL;
+    }
+    CORE_ExitAtomic(state);
+
+    free(registration);
+  }
+}
+
+int sl_si91x_epoll_create(void)
+{
+  for (int epfd = 0; epfd < SL_SI91X_EPOLL_MAX_INSTANCES; epfd++) {
+    sli_si91x_epoll_instance_t *instance = &sli_si91x_epoll_instances[epfd];
+
+    CORE_irqState_t state = CORE_EnterAtomic();
+    bool available        = !instance->in_use;
+    if (available) {
+      memset(instance, 0, sizeof(*instance));
+      instance->in_use = true;
+    }
+    CORE_ExitAtomic(state);
+
+    if (!available) {
+      continue;
+    }
+
+    instance->wake_event = osEventFlagsNew(NULL);
+    if (instance->wake_event == NULL) {
+      instance->in_use = false;
+      SLI_SET_ERROR_AND_RETURN(ENOMEM);
+    }
+    return epfd;
+  }
+
+  SLI_SET_ERROR_AND_RETURN(ENOMEM);
+}
+
+int sl_si91x_epoll_ctl(int epfd, int op, int socket, const sl_si91x_epoll_event_t *event)
+{
+  sli_si91x_epoll_instance_t *instance = sli_si91x_get_epoll_instance(epfd);
+  const sli_si91x_socket_t *si91x_socket = sli_get_si91x_socket(socket);
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE((instance == NULL) || (si91x_socket == NULL), EBADF);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE((op != SL_SI91X_EPOLL_CTL_DEL) && (event == NULL), EINVAL);
+
+  sli_si91x_epoll_registration_t *registration = instance->registrations[socket];
+
+  switch (op) {
+    case SL_SI91X_EPOLL_CTL_ADD: {
+      SLI_SET_ERRNO_AND_RETURN_IF_TRUE(registration != NULL, EEXIST);
+
+      registration = malloc(sizeof(sli_si91x_epoll_registration_t));
+      SLI_SET_ERRNO_AND_RETURN_IF_TRUE(registration == NULL, ENOMEM);
+      memset(registration, 0, sizeof(sli_si91x_epoll_registration_t));
+      registration->socket = socket;
+      registration->event  = *event;
+
+      CORE_irqState_t state = CORE_EnterAtomic();
+      instance->registrations[socket] = registration;
+      uint32_t ready = sli_si91x_epoll_socket_level(si91x_socket)
+                       & (event->events | SLI_SI91X_EPOLL_ALWAYS_REPORTED);
+      if (ready != 0) {
+        sli_si91x_epoll_queue(instance, registration, ready);
+      }
+      CORE_ExitAtomic(state);
+
+      if (ready != 0) {
+        osEventFlagsSet(instance->wake_event, SLI_SI91X_EPOLL_WAKE_EVENT);
+      }
+      break;
+    }
+
+    case SL_SI91X_EPOLL_CTL_MOD: {
+      SLI_SET_ERRNO_AND_RETURN_IF_TRUE(registration == NULL, ENOENT);
+
+      CORE_irqState_t state = CORE_EnterAtomic();
+      registration->event = *event;
+      uint32_t ready = sli_si91x_epoll_socket_level(si91x_socket)
+                       & (event->events | SLI_SI91X_EPOLL_ALWAYS_REPORTED);
+      if (ready != 0) {
+        sli_si91x_epoll_queue(instance, registration, ready);
+      }
+      CORE_ExitAtomic(state);
+
+      if (ready != 0) {
+        osEventFlagsSet(instance->wake_event, SLI_SI91X_EPOLL_WAKE_EVENT);
+      }
+      break;
+    }
+
+    case SL_SI91X_EPOLL_CTL_DEL: {
+      SLI_SET_ERRNO_AND_RETURN_IF_TRUE(registration == NULL, ENOENT);
+
+      CORE_irqState_t state = CORE_EnterAtomic();
+      sli_si91x_epoll_unlink(instance, registration);
+      instance->registrations[socket] = NULL;
+      CORE_ExitAtomic(state);
+
+      free(registration);
+      break;
+    }
+
+    default:
+      SLI_SET_ERROR_AND_RETURN(EINVAL);
+  }
+
+  return 0;
+}
+
+// Moves up to max_events ready registrations into events, re-queueing level-triggered ones that are still ready
+static int sli_si91x_epoll_collect(sli_si91x_epoll_instance_t *instance,
+                                   sl_si91x_epoll_event_t *events,
+                                   int max_events)
+{
+  sli_si91x_epoll_registration_t *requeue_head = NULL;
+  sli_si91x_epoll_registration_t *requeue_tail = NULL;
+  int count                                    = 0;
+
+  CORE_irqState_t state = CORE_EnterAtomic();
+  while ((instance->ready_head != NULL) && (count < max_events)) {
+    sli_si91x_epoll_registration_t *registration = instance->ready_head;
+
+    instance->ready_head = registration->next;
+    if (instance->ready_head == NULL) {
+      instance->ready_tail = NULL;
+    }
+    registration->next   = NULL;
+    registration->queued = false;
+
+    uint32_t interest = registration->event.events | SLI_SI91X_EPOLL_ALWAYS_REPORTED;
+    uint32_t level    = sli_si91x_epoll_socket_level(sli_get_si91x_socket(registration->socket)) & interest;
+    bool edge         = (registration->event.events & SL_SI91X_EPOLLET) != 0;
+    uint32_t ready    = (registration->pending & interest) | (edge ? 0 : level);
+
+    registration->pending = 0;
+    if (ready == 0) {
+      continue;
+    }
+
+    events[count].events = ready & ~SL_SI91X_EPOLLET;
+    events[count].data   = registration->event.data;
+    count++;
+
+    if (!edge && (level != 0)) {
+      registration->queued = true;
+      if (requeue_tail == NULL) {
+        requeue_head = registration;
+      } else {
+        requeue_tail->next = registration;
+      }
+      requeue_tail = registration;
+    }
+  }
+
+  // Still-ready sockets go behind the ones not yet reported, so a busy socket cannot starve the others
+  if (requeue_head != NULL) {
+    if (instance->ready_tail == NULL) {
+      instance->ready_head = requeue_head;
+    } else {
+      instance->ready_tail->next = requeue_head;
+    }
+    instance->ready_tail = requeue_tail;
+  }
+  CORE_ExitAtomic(state);
+
+  return count;
+}
+
+// Asks the firmware whether synchronous sockets with no host-side receive indication are readable. The select
+// does not wait, so the caller blocks on the wake event between polls and a socket event ends the wait at once.
+// Returns 1 once the firmware was polled, 0 if there was nothing to poll, or -1 with errno set if the select failed.
+static int sli_si91x_epoll_poll_firmware(sli_si91x_epoll_instance_t *instance)
+{
+#ifndef __ZEPHYR__
+  fd_set read_fds;
+  FD_ZERO(&read_fds);
+#else
+  sl_si91x_fdset_t read_fds;
+  SL_SI91X_FD_ZERO(&read_fds);
+#endif
+  int nfds = 0;
+
+  for (int socket = 0; socket < SLI_NUMBER_OF_SOCKETS; socket++) {
+    const sli_si91x_epoll_registration_t *registration = instance->registrations[socket];
+    const sli_si91x_socket_t *si91x_socket             = sli_get_si91x_socket(socket);
+
+    if ((registration == NULL) || (si91x_socket == NULL) || ((registration->event.events & SL_SI91X_EPOLLIN) == 0)
+        || (si91x_socket->recv_data_callback != NULL) || (si91x_socket->rx_ring_count > 0)
+        || ((si91x_socket->state != CONNECTED) && (si91x_socket->state != UDP_UNCONNECTED_READY))) {
+      continue;
+    }
+#ifndef __ZEPHYR__
+    FD_SET(socket, &read_fds);
+#else
+    SL_SI91X_FD_SET(socket, &read_fds);
+#endif
+    nfds = socket + 1;
+  }
+
+  if (nfds == 0) {
+    return 0;
+  }
+
+  const struct timeval timeout = { 0 };
+  int result                   = sli_si91x_select(nfds, &read_fds, NULL, NULL, &timeout, NULL);
+  if (result < 0) {
+    return -1;
+  }
+
+  for (int socket = 0; socket < nfds; socket++) {
+#ifndef __ZEPHYR__
+    if ((result == 0) || !FD_ISSET(socket, &read_fds)) {
+#else
+    if ((result == 0) || !SL_SI91X_FD_ISSET(socket, &read_fds)) {
+#endif
+      continue;
+    }
+
+    // Stream data is pulled into the host receive ring first, so EPOLLIN is only reported for data a read
+    // returns without asking the firmware again. Datagrams have no host ring and are reported as they stand.
+    sli_si91x_socket_t *si91x_socket = sli_get_si91x_socket(socket);
+    uint8_t first_byte               = 0;
+    if ((si91x_socket != NULL) && (si91x_socket->type == SOCK_STREAM)
+        && (sli_si91x_socket_buffered_recv(si91x_socket, &first_byte, sizeof(first_byte), MSG_PEEK) <= 0)) {
+      continue;
+    }
+    sli_si91x_epoll_notify(socket, SL_SI91X_EPOLLIN);
+  }
+  return 1;
+}
+
+int sl_si91x_epoll_wait(int epfd, sl_si91x_epoll_event_t *events, int max_events, int timeout_ms)
+{
+  sli_si91x_epoll_instance_t *instance = sli_si91x_get_epoll_instance(epfd);
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(instance == NULL, EBADF);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE((events == NULL) || (max_events <= 0) || (timeout_ms < -1), EINVAL);
+
+  uint32_t start_time    = osKernelGetTickCount();
+  uint32_t timeout_ticks = (timeout_ms > 0) ? SLI_SYSTEM_MS_TO_TICKS(timeout_ms) : 0;
+  uint32_t poll_ticks    = SLI_SYSTEM_MS_TO_TICKS(SL_SI91X_EPOLL_FIRMWARE_POLL_INTERVAL_MS);
+  uint32_t poll_time     = 0;
+  bool polled            = false;
+
+  while (true) {
+    int count = sli_si91x_epoll_collect(instance, events, max_events);
+    if (count > 0) {
+      return count;
+    }
+
+    uint32_t remaining_ticks = osWaitForever;
+    if (timeout_ms >= 0) {
+      uint32_t elapsed_ticks = sl_si91x_host_elapsed_time(start_time);
+      if (elapsed_ticks >= timeout_ticks) {
+        return 0;
+      }
+      remaining_ticks = timeout_ticks - elapsed_ticks;
+    }
+
+    // The firmware is polled at most once per interval, a socket event wakes the wait in between
+    uint32_t wait_ticks = remaining_ticks;
+    if (polled) {
+      uint32_t since_poll = sl_si91x_host_elapsed_time(poll_time);
+      if (since_poll < poll_ticks) {
+        wait_ticks = ((poll_ticks - since_poll) < remaining_ticks) ? (poll_ticks - since_poll) : remaining_ticks;
+      } else {
+        polled = false;
+      }
+    }
+    if (!polled) {
+      int result = sli_si91x_epoll_poll_firmware(instance);
+      if (result < 0) {
+        return -1;
+      }
+      if (result > 0) {
+        polled    = true;
+        poll_time = osKernelGetTickCount();
+        continue;
+      }
+    }
+
+    // Sleep until a socket event arrives, or until the next firmware poll is due
+    osEventFlagsWait(instance->wake_event, SLI_SI91X_EPOLL_WAKE_EVENT, osFlagsWaitAny, wait_ticks);
+  }
+}
+
+int sl_si91x_epoll_close(int epfd)
+{
+  sli_si91x_epoll_instance_t *instance = sli_si91x_get_epoll_instance(epfd);
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(instance == NULL, EBADF);
+
+  CORE_irqState_t state = CORE_EnterAtomic();
+  instance->in_use     = false;
+  instance->ready_head = NULL;
+  instance->ready_tail = NULL;
+  CORE_ExitAtomic(state);
+
+  // Detach each registration atomically, a concurrent close of the socket may be releasing it too
+  for (int socket = 0; socket < SLI_NUMBER_OF_SOCKETS; socket++) {
+    state                                        = CORE_EnterAtomic();
+    sli_si91x_epoll_registration_t *registration = instance->registrations[socket];
+    instance->registrations[socket]              = NULL;
+    CORE_ExitAtomic(state);
+
+    free(registration);
+  }
+  osEventFlagsDelete(instance->wake_event);
+  instance->wake_event = NULL;
+
+  return 0;
+}
@@ -31,6 +31,7 @@
 #include "sli_wifi_utility.h"
 #include "sl_si91x_socket_types.h"
 #include "sl_si91x_socket_callback_framework.h"
+#include "sl_si91x_socket_epoll.h"
 #include "sl_status.h"
 #include "sl_constants.h"
 #include "sl_si91x_driver.h"
@@ -56,6 +57,14 @@
 #define SL_SOCKET_DEFAULT_BUFFER_LIMIT 3
 #endif
 
+#define SLI_TCP_HEADER_LENGTH          56
+#define SLI_TCP_V6_HEADER_LENGTH       76
+#define SLI_SI91X_SSL_HEADER_SIZE_IPV4 90
+#define SLI_SI91X_SSL_HEADER_SIZE_IPV6 110
+
+// Owner of a receive buffer lent to a socket that was closed before the buffer came back
+#define SLI_SI91X_RX_LOAN_ORPHANED 0xFF
+
 /******************************************************
  *                    Structures
  ******************************************************/
@@ -64,18 +73,30 @@ typedef struct {
   uint8_t in_use;
   uint8_t select_id;
   uint16_t frame_status;
+  uint32_t buffered_read_sockets; // Host sockets already readable from their receive ring
   union {
     sl_si91x_socket_select_callback_t select_callback;
     sli_si91x_socket_select_rsp_t *response_data;
   };
 } sli_si91x_select_request_t;
 
+// Receive buffer held by the application and the host socket it was delivered to
+typedef struct {
+  sl_wifi_buffer_t *buffer;
+  uint8_t socket_index;
+} sli_si91x_rx_buffer_loan_t;
+
 /******************************************************
  *               Static Function Declarations
  ******************************************************/
 
 static void sli_si91x_clear_select_id(uint8_t flag);
 static sli_si91x_select_request_t *sli_si91x_get_available_select_id(void);
+#ifndef __ZEPHYR__
+static int32_t sli_si91x_mark_buffered_sockets(uint32_t buffered_sockets, fd_set *readfds);
+#else
+static int32_t sli_si91x_mark_buffered_sockets(uint32_t buffered_sockets, sl_si91x_fdset_t *readfds);
+#endif
 
 /**
  * A internal function to check whether a particular port is available or not.
@@ -84,16 +105,32 @@ static sli_si91x_select_request_t *sli_si91x_get_available_select_id(void);
  */
 static bool sli_is_port_available(uint16_t port_number);
 
+static void sli_si91x_socket_queue_corked_frame(sli_si91x_socket_t *si91x_socket);
+static void sli_si91x_socket_cork_timeout(void *argument);
+static uint32_t sli_si91x_socket_coalesce_limit(const sli_si91x_socket_t *si91x_socket);
+static bool sli_si91x_socket_coalesce_data(sli_si91x_socket_t *si91x_socket,
+                                           uint16_t header_length,
+                                           const struct iovec *iov,
+                                           int iovcnt,
+                                           uint32_t data_length,
+                                           uint32_t limit);
+static void sli_si91x_socket_gather(uint8_t *destination, const struct iovec *iov, int iovcnt, uint32_t length);
+static int sli_si91x_socket_take_rx_loan(sli_si91x_socket_t *si91x_socket, sl_wifi_buffer_t *buffer);
+static void sli_si91x_socket_orphan_rx_loans(uint8_t socket_index);
+
 /******************************************************
  *               Variable Definitions
  ******************************************************/
 sli_si91x_socket_t *sli_si91x_sockets[SLI_NUMBER_OF_SOCKETS]                                 = { 0 };
+uint8_t sli_si91x_socket_generations[SLI_NUMBER_OF_SOCKETS]                                  = { 0 };
 static sl_si91x_socket_remote_termination_callback_t user_remote_socket_termination_callback = NULL;
 static osMutexId_t sli_si91x_socket_mutex                                                    = NULL;
 static uint8_t sli_si91x_max_select_count                                                    = 0;
 
 static sli_si91x_select_request_t *select_request_table = NULL;
 
+static sli_si91x_rx_buffer_loan_t sli_si91x_rx_buffer_loans[SL_SI91X_SOCKET_MAX_RX_BUFFER_LOANS];
+
 sli_wifi_buffer_queue_t sli_si91x_select_response_queue;
 
 extern sli_wifi_command_queue_t cmd_queues[SI91X_CMD_MAX];
@@ -289,6 +326,7 @@ sl_status_t sli_si91x_socket_deinit(void)
     free(select_request_table);
     select_request_table = NULL;
   }
+  sli_si91x_max_select_count = 0;
   return SL_STATUS_OK;
 }
 
@@ -374,6 +412,9 @@ void sli_si91x_free_socket(int socket)
     return;
   }
 
+  // Stop reporting readiness for the socket before its index can be reused
+  sli_si91x_epoll_remove_socket(socket);
+
   // Check if the socket has associated OS event flags.
   if (si91x_socket->socket_events != NULL) {
     // Delete the OS event flags associated with the socket to free resources.
@@ -389,10 +430,32 @@ void sli_si91x_free_socket(int socket)
     si91x_socket->domain_name = NULL;
   }
 
+  // Free the receive ring along with any data still buffered in it
+  free(si91x_socket->rx_ring);
+  si91x_socket->rx_ring = NULL;
+
+  // Drop a frame still held back by the cork and stop its flush timer
+  CORE_irqState_t state           = CORE_EnterAtomic();
+  sl_wifi_buffer_t *corked_buffer = si91x_socket->tx_cork_buffer;
+  si91x_socket->tx_cork_buffer    = NULL;
+  CORE_ExitAtomic(state);
+  if (corked_buffer != NULL) {
+    sli_si91x_host_free_buffer(corked_buffer);
+  }
+  if (si91x_socket->tx_cork_timer != NULL) {
+    osTimerDelete(si91x_socket->tx_cork_timer);
+    si91x_socket->tx_cork_timer = NULL;
+  }
+
+  // Receive buffers still held by the application are freed when it releases them
+  sli_si91x_socket_orphan_rx_loans((uint8_t)socket);
+
   // Free the memory allocated for the socket structure.
   free(si91x_socket);
 
-  // Set the global socket pointer to NULL to prevent future use of freed memory.
+  // Set the global socket pointer to NULL to prevent future use of freed memory. Data still waiting in the RX
+  // dispatch queue for this index is dropped once the generation no longer matches.
+  sli_si91x_socket_generations[socket]++;
   sli_si91x_sockets[socket] = NULL;
 }
 
@@ -464,6 +527,10 @@ void sli_get_free_socket(sli_si91x_socket_t **socket, int *socket_fd)
       sli_si91x_sockets[socket_index]->id                = -1;
       sli_si91x_sockets[socket_index]->index             = socket_index;
       sli_si91x_sockets[socket_index]->data_buffer_limit = SL_SOCKET_DEFAULT_BUFFER_LIMIT;
+      sli_si91x_sockets[socket_index]->tx_priority       = SL_SI91X_SOCKET_TX_PRIORITY_NORMAL;
+      sli_si91x_sockets[socket_index]->tx_weight         = SLI_SI91X_SOCKET_TX_DEFAULT_WEIGHT;
+      sli_si91x_sockets[socket_index]->rx_ring_size      = SL_SI91X_SOCKET_READ_AHEAD_WINDOW;
+      sli_si91x_sockets[socket_index]->tx_nodelay        = true;
 
       // If a free socket is found, set the socket pointer to point to it
       *socket = sli_si91x_sockets[socket_index];
@@ -891,6 +958,9 @@ int sli_si91x_shutdown(int socket, int how)
     return SLI_SI91X_NO_ERROR;
   }
 
+  // Data held back by the cork is sent before the socket closes
+  sli_si91x_socket_flush_corked_data(si91x_socket);
+
   // Continuously checks if the transmit data queue of the specified socket is empty.
   // If the queue is not empty, it waits for 2 milliseconds before checking again.
   while (!sli_si91x_buffer_queue_empty(&si91x_socket->tx_data_queue)) {
@@ -966,6 +1036,10 @@ static sl_status_t sli_handle_socket_accept_request(sl_wifi_system_packet_t *rx_
 
   sli_handle_accept_response(client_socket, accept_response);
 
+  // The listening socket completed an accept and the new connection can send
+  sli_si91x_epoll_notify(server_socket->index, SL_SI91X_EPOLLIN);
+  sli_si91x_epoll_notify(client_socket_id, SL_SI91X_EPOLLOUT);
+
   if (server_socket->user_accept_callback != NULL) {
     server_socket->user_accept_callback(client_socket_id,
                                         (struct sockaddr *)&server_socket->remote_address,
@@ -998,6 +1072,8 @@ static void sli_handle_remote_terminate(sl_wifi_system_packet_t *rx_packet)
     sli_si91x_flush_socket_command_queues_based_on_queue_type(index, frame_status);
     sli_si91x_flush_socket_data_queues_based_on_queue_type(index);
 
+    sli_si91x_epoll_notify(index, SL_SI91X_EPOLLIN | SL_SI91X_EPOLLHUP);
+
     if (user_remote_socket_termination_callback != NULL) {
       user_remote_socket_termination_callback(socket->id,
                                               socket->local_address.sin6_port,
@@ -1034,15 +1110,25 @@ static sl_status_t sli_handle_raw_data_receive(sl_wifi_system_packet_t *rx_packe
   int32_t host_socket = sli_find_host_socket_by_firmware_id(firmware_socket_response->socket_id);
 
   // Retrieve the client socket
-  const sli_si91x_socket_t *client_socket = sli_get_si91x_socket(host_socket);
+  sli_si91x_socket_t *client_socket = sli_get_si91x_socket(host_socket);
 
   if (client_socket == NULL) {
     SL_CLEANUP_MALLOC(sdk_context);
     return SL_STATUS_FAIL;
   }
 
-  // Call the user-defined receive data callback
-  client_socket->recv_data_callback(host_socket, data, firmware_socket_response->length, firmware_socket_response);
+  // The packet is freed by the event dispatcher, so its buffer can only be lent for the duration of the callback
+  if (client_socket->recv_buffer_callback != NULL) {
+    client_socket->recv_buffer_callback(host_socket,
+                                        NULL,
+                                        data,
+                                        firmware_socket_response->length,
+                                        firmware_socket_response);
+  } else {
+    // Call the user-defined receive data callback
+    client_socket->recv_data_callback(host_socket, data, firmware_socket_response->length, firmware_socket_response);
+  }
+  // The data went straight to the callback, so nothing is left for a read and EPOLLIN is not raised
   return SL_STATUS_OK;
 }
 
@@ -1145,6 +1231,7 @@ static sl_status_t sli_handle_select_request(sl_wifi_system_packet_t *rx_packet,
 
     // This function handles responses received from the SI91X socket driver
     sli_handle_select_response(socket_select_rsp, read_fd, write_fd, exception_fd);
+    sli_si91x_mark_buffered_sockets(select_request->buffered_read_sockets, read_fd);
 
     // Call the user-defined select callback function with the updated file descriptor sets and status
     select_request->select_callback(read_fd, write_fd, exception_fd, select_request->frame_status);
@@ -1185,6 +1272,7 @@ static int sli_handle_tcp_ack_indication(sl_wifi_system_packet_t *rx_packet, sli
   // Check if the SLI_SI91X_SOCKET_FEAT_TCP_ACK_INDICATION bit is set move the socket to CONNECTED state.
   if (si91x_socket->socket_bitmap & SLI_SI91X_SOCKET_FEAT_TCP_ACK_INDICATION) {
     si91x_socket->is_waiting_on_ack = false;
+    sli_si91x_epoll_notify(host_socket, SL_SI91X_EPOLLOUT);
   }
 
   // Check if the SI91X socket and its data transfer callback function exist
@@ -1384,33 +1472,128 @@ sl_status_t sli_si91x_send_socket_data(sli_si91x_socket_t *si91x_socket,
                                        const sli_si91x_socket_send_request_t *request,
                                        const void *data)
 {
-  sl_wifi_buffer_t *buffer        = NULL;
-  sl_wifi_system_packet_t *packet = NULL;
-  sli_si91x_socket_send_request_t *send;
-
-  sl_status_t status     = SL_STATUS_OK;
-  uint16_t header_length = (request->data_offset - sizeof(sli_si91x_socket_send_request_t));
-  uint32_t data_length   = request->length;
-
   if (data == NULL) {
     return SL_STATUS_NULL_POINTER;
   }
 
-  uint32_t start = osKernelGetTickCount();
-  while (si91x_socket->data_buffer_limit != 0 && si91x_socket->data_buffer_count >= si91x_socket->data_buffer_limit) {
-    osDelay(SLI_SYSTEM_MS_TO_TICKS(2));
-    if ((osKernelGetTickCount() - start) > SLI_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME) {
-      return SL_STATUS_WIFI_BUFFER_ALLOC_FAIL;
+  const struct iovec iov = { .iov_base = (void *)data, .iov_len = request->length };
+  return sli_si91x_send_socket_data_vector(si91x_socket, request, &iov, 1);
+}
+
+sl_status_t sli_si91x_send_socket_data_vector(sli_si91x_socket_t *si91x_socket,
+                                              const sli_si91x_socket_send_request_t *request,
+                                              const struct iovec *iov,
+                                              int iovcnt)
+{
+  sl_wifi_buffer_t *buffer = NULL;
+  sl_status_t status       = SL_STATUS_OK;
+  uint16_t header_length   = (request->data_offset - sizeof(sli_si91x_socket_send_request_t));
+  uint32_t data_length     = request->length;
+
+  // A small write to a socket that coalesces writes goes into a frame still waiting on the host, if one has room
+  const bool coalesce   = sli_si91x_socket_coalesces_writes(si91x_socket);
+  const uint32_t limit  = coalesce ? sli_si91x_socket_coalesce_limit(si91x_socket) : 0;
+  uint32_t payload_room = data_length;
+  if (coalesce && (data_length < limit)) {
+    if (sli_si91x_socket_coalesce_data(si91x_socket, header_length, iov, iovcnt, data_length, limit)) {
+      return SL_STATUS_OK;
+    }
+    // Leave room for later writes in a frame that will be corked or may end up queued behind another one
+    if (si91x_socket->tx_cork || !sli_si91x_buffer_queue_empty(&si91x_socket->tx_data_queue)) {
+      payload_room = limit;
     }
   }
 
+  status = sli_si91x_socket_reserve_tx_slot(si91x_socket, true);
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+
+  status = sli_si91x_socket_build_data_frame(request,
+                                             iov,
+                                             iovcnt,
+                                             payload_room,
+                                             SLI_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME,
+                                             &buffer);
+  if (status != SL_STATUS_OK) {
+    sli_si91x_socket_release_tx_slot(si91x_socket);
+    return status;
+  }
+
+  // A corked socket holds a partly filled frame back. The frame it replaces, if any, is queued first to keep the
+  // stream in order.
+  const bool hold       = coalesce && si91x_socket->tx_cork && (data_length < limit);
+  CORE_irqState_t state = CORE_EnterAtomic();
+  sli_si91x_socket_queue_corked_frame(si91x_socket);
+  if (hold) {
+    si91x_socket->tx_cork_buffer = buffer;
+  } else {
+    sli_wifi_append_to_buffer_queue(&si91x_socket->tx_data_queue, buffer);
+    tx_socket_data_queues_status |= (1 << si91x_socket->index);
+    sli_wifi_set_event(SL_SI91X_SOCKET_DATA_TX_PENDING_EVENT);
+  }
+  CORE_ExitAtomic(state);
+
+  if (hold && (si91x_socket->tx_cork_timer != NULL)) {
+    osTimerStart(si91x_socket->tx_cork_timer, SLI_SYSTEM_MS_TO_TICKS(SL_SI91X_SOCKET_CORK_FLUSH_TIMEOUT_MS));
+  }
+
+  return SL_STATUS_OK;
+}
+
+sl_status_t sli_si91x_socket_reserve_tx_slot(sli_si91x_socket_t *si91x_socket, bool wait)
+{
+  // Take a free slot only if no earlier sender is queued for it, otherwise sleep until the event handler hands
+  // over the slot of a frame written to the bus.
+  sli_wifi_waiter_t waiter;
+  bool reserved         = false;
+  CORE_irqState_t state = CORE_EnterAtomic();
+  if ((si91x_socket->data_buffer_limit == 0)
+      || ((si91x_socket->data_buffer_count < si91x_socket->data_buffer_limit)
+          && (si91x_socket->tx_waiters.head == NULL))) {
+    ++si91x_socket->data_buffer_count;
+    reserved = true;
+  } else if (wait) {
+    sli_wifi_wait_queue_append(&si91x_socket->tx_waiters, &waiter);
+  }
+  CORE_ExitAtomic(state);
+
+  if (reserved) {
+    return SL_STATUS_OK;
+  }
+  if (!wait) {
+    return SL_STATUS_WOULD_BLOCK;
+  }
+  if (sli_wifi_wait_queue_wait(&si91x_socket->tx_waiters, &waiter, SLI_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME)
+      != SL_STATUS_OK) {
+    return SL_STATUS_WIFI_BUFFER_ALLOC_FAIL;
+  }
+  return SL_STATUS_OK;
+}
+
+sl_status_t sli_si91x_socket_build_data_frame(const sli_si91x_socket_send_request_t *request,
+                                              const struct iovec *iov,
+                                              int iovcnt,
+                                              uint32_t payload_room,
+                                              uint32_t wait_time,
+                                              sl_wifi_buffer_t **frame)
+{
+  sl_wifi_buffer_t *buffer        = NULL;
+  sl_wifi_system_packet_t *packet = NULL;
+  sli_si91x_socket_send_request_t *send;
+
+  uint16_t header_length = (request->data_offset - sizeof(sli_si91x_socket_send_request_t));
+  uint32_t data_length   = request->length;
+
   // Allocate a buffer for the socket data with appropriate size
-  status = sli_si91x_host_allocate_buffer(
+  sl_status_t status = sli_si91x_host_allocate_buffer(
     &buffer,
     SL_WIFI_TX_FRAME_BUFFER,
-    sizeof(sl_wifi_system_packet_t) + sizeof(sli_si91x_socket_send_request_t) + header_length + data_length,
-    SLI_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME);
-  VERIFY_STATUS_AND_RETURN(status);
+    sizeof(sl_wifi_system_packet_t) + sizeof(sli_si91x_socket_send_request_t) + header_length + payload_room,
+    wait_time);
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
 
   packet = sli_wifi_host_get_buffer_data(buffer, 0, NULL);
   if (packet == NULL) {
@@ -1418,29 +1601,369 @@ sl_status_t sli_si91x_send_socket_data(sli_si91x_socket_t *si91x_socket,
     return SL_STATUS_WIFI_BUFFER_ALLOC_FAIL;
   }
 
-  // Atomic protection for data_buffer_count to prevent race condition
-  CORE_irqState_t state1 = CORE_EnterAtomic();
-  ++si91x_socket->data_buffer_count;
-  CORE_ExitAtomic(state1);
-
   memset(packet->desc, 0, sizeof(packet->desc));
 
+  // The request header and every fragment of the payload are copied straight into the frame
   send = (sli_si91x_socket_send_request_t *)packet->data;
   memcpy(send, request, sizeof(sli_si91x_socket_send_request_t));
-  memcpy((send->send_buffer + header_length), data, data_length);
+  sli_si91x_socket_gather(send->send_buffer + header_length, iov, iovcnt, data_length);
 
   // Fill frame type
   packet->length = (sizeof(sli_si91x_socket_send_request_t) + header_length + data_length) & 0xFFF;
 
+  *frame = buffer;
+  return SL_STATUS_OK;
+}
+
+void sli_si91x_socket_queue_data_frames(sli_si91x_socket_t *si91x_socket, sli_wifi_buffer_queue_t *frames)
+{
+  if (frames->head == NULL) {
+    return;
+  }
+
+  // The whole chain joins the socket queue at once, behind any frame held back by the cork
   CORE_irqState_t state = CORE_EnterAtomic();
-  sli_wifi_append_to_buffer_queue(&si91x_socket->tx_data_queue, buffer);
+  sli_si91x_socket_queue_corked_frame(si91x_socket);
+  if (si91x_socket->tx_data_queue.tail == NULL) {
+    si91x_socket->tx_data_queue.head = frames->head;
+  } else {
+    si91x_socket->tx_data_queue.tail->node.node = &frames->head->node;
+  }
+  si91x_socket->tx_data_queue.tail = frames->tail;
   tx_socket_data_queues_status |= (1 << si91x_socket->index);
   sli_wifi_set_event(SL_SI91X_SOCKET_DATA_TX_PENDING_EVENT);
   CORE_ExitAtomic(state);
 
+  frames->head = NULL;
+  frames->tail = NULL;
+}
+
+void sli_si91x_socket_batch_init(sli_si91x_socket_send_batch_t *batch,
+                                 sli_si91x_socket_t *si91x_socket,
+                                 bool socket_queue)
+{
+  batch->socket       = si91x_socket;
+  batch->frames.head  = NULL;
+  batch->frames.tail  = NULL;
+  batch->socket_queue = socket_queue;
+}
+
+sl_status_t sli_si91x_socket_batch_add(sli_si91x_socket_send_batch_t *batch,
+                                       const sli_si91x_socket_send_request_t *request,
+                                       const struct iovec *iov,
+                                       int iovcnt)
+{
+  sl_wifi_buffer_t *buffer = NULL;
+  sl_status_t status       = SL_STATUS_OK;
+
+  // Frames of the batch hold their slot and buffer until they are queued, so they are handed over before waiting
+  // for either, otherwise a batch could wait for resources only its own frames can free
+  if (batch->socket_queue) {
+    status = sli_si91x_socket_reserve_tx_slot(batch->socket, false);
+    if (status == SL_STATUS_WOULD_BLOCK) {
+      sli_si91x_socket_batch_flush(batch);
+      status = sli_si91x_socket_reserve_tx_slot(batch->socket, true);
+    }
+    if (status != SL_STATUS_OK) {
+      return status;
+    }
+  }
+
+  // An empty batch holds no buffers, so it waits for one right away
+  uint32_t wait_time = (batch->frames.head != NULL) ? 0 : SLI_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME;
+  status             = sli_si91x_socket_build_data_frame(request, iov, iovcnt, request->length, wait_time, &buffer);
+  if ((status != SL_STATUS_OK) && (batch->frames.head != NULL)) {
+    sli_si91x_socket_batch_flush(batch);
+    status = sli_si91x_socket_build_data_frame(request,
+                                               iov,
+                                               iovcnt,
+                                               request->length,
+                                               SLI_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME,
+                                               &buffer);
+  }
+  if (status != SL_STATUS_OK) {
+    if (batch->socket_queue) {
+      sli_si91x_socket_release_tx_slot(batch->socket);
+    }
+    return status;
+  }
+
+  // The batch is private to the caller until it is flushed, so linking needs no critical section
+  buffer->node.node = NULL;
+  if (batch->frames.tail == NULL) {
+    batch->frames.head = buffer;
+  } else {
+    batch->frames.tail->node.node = &buffer->node;
+  }
+  batch->frames.tail = buffer;
   return SL_STATUS_OK;
 }
 
+void sli_si91x_socket_batch_flush(sli_si91x_socket_send_batch_t *batch)
+{
+  if (batch->socket_queue) {
+    sli_si91x_socket_queue_data_frames(batch->socket, &batch->frames);
+  } else {
+    sli_si91x_driver_queue_socket_data_frames(&batch->frames);
+  }
+}
+
+// Copies length bytes gathered from the fragments described by iov to destination
+static void sli_si91x_socket_gather(uint8_t *destination, const struct iovec *iov, int iovcnt, uint32_t length)
+{
+  for (int i = 0; (i < iovcnt) && (length > 0); i++) {
+    uint32_t chunk = (iov[i].iov_len < length) ? (uint32_t)iov[i].iov_len : length;
+    memcpy(destination, iov[i].iov_base, chunk);
+    destination += chunk;
+    length -= chunk;
+  }
+}
+
+bool sli_si91x_socket_coalesces_writes(const sli_si91x_socket_t *si91x_socket)
+{
+  // WebSocket frames carry their own header, so only plain stream data can be merged
+  return (si91x_socket->type == SOCK_STREAM) && !(si91x_socket->ssl_bitmap & SLI_SI91X_WEBSOCKET_FEAT)
+         && (si91x_socket->tx_cork || !si91x_socket->tx_nodelay);
+}
+
+int sli_si91x_socket_set_cork(sli_si91x_socket_t *si91x_socket, bool cork)
+{
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type != SOCK_STREAM, EOPNOTSUPP);
+
+  if (cork && (si91x_socket->tx_cork_timer == NULL)) {
+    // The timer looks the socket up by index, so it never touches a socket that was closed meanwhile
+    si91x_socket->tx_cork_timer =
+      osTimerNew(sli_si91x_socket_cork_timeout, osTimerOnce, (void *)(uintptr_t)si91x_socket->index, NULL);
+    SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->tx_cork_timer == NULL, ENOMEM);
+  }
+
+  si91x_socket->tx_cork = cork;
+  if (!cork) {
+    // Removing the cork sends a partly filled frame at once
+    sli_si91x_socket_flush_corked_data(si91x_socket);
+  }
+  return SLI_SI91X_NO_ERROR;
+}
+
+void sli_si91x_socket_flush_corked_data(sli_si91x_socket_t *si91x_socket)
+{
+  CORE_irqState_t state = CORE_EnterAtomic();
+  sli_si91x_socket_queue_corked_frame(si91x_socket);
+  CORE_ExitAtomic(state);
+
+  if (si91x_socket->tx_cork_timer != NULL) {
+    osTimerStop(si91x_socket->tx_cork_timer);
+  }
+}
+
+// Hands the frame held back by the cork to the scheduler. Must be called with interrupts disabled.
+static void sli_si91x_socket_queue_corked_frame(sli_si91x_socket_t *si91x_socket)
+{
+  if (si91x_socket->tx_cork_buffer == NULL) {
+    return;
+  }
+  sli_wifi_append_to_buffer_queue(&si91x_socket->tx_data_queue, si91x_socket->tx_cork_buffer);
+  si91x_socket->tx_cork_buffer = NULL;
+  tx_socket_data_queues_status |= (1 << si91x_socket->index);
+  sli_wifi_set_event(SL_SI91X_SOCKET_DATA_TX_PENDING_EVENT);
+}
+
+static void sli_si91x_socket_cork_timeout(void *argument)
+{
+  const uint32_t index  = (uint32_t)(uintptr_t)argument;
+  CORE_irqState_t state = CORE_EnterAtomic();
+  if ((index < SLI_NUMBER_OF_SOCKETS) && (sli_si91x_sockets[index] != NULL)) {
+    sli_si91x_socket_queue_corked_frame(sli_si91x_sockets[index]);
+  }
+  CORE_ExitAtomic(state);
+}
+
+// Largest payload of a coalesced frame, the same bound the send APIs apply to a single write
+static uint32_t sli_si91x_socket_coalesce_limit(const sli_si91x_socket_t *si91x_socket)
+{
+  const bool ipv4   = (si91x_socket->local_address.sin6_family == AF_INET);
+  uint32_t mss      = (si91x_socket->mss != 0) ? si91x_socket->mss : SLI_DEFAULT_STREAM_MSS_SIZE_IPV4;
+  uint32_t overhead = 0;
+
+  if (si91x_socket->ssl_bitmap & SL_SI91X_ENABLE_TLS) {
+    overhead = ipv4 ? SLI_SI91X_SSL_HEADER_SIZE_IPV4 : SLI_SI91X_SSL_HEADER_SIZE_IPV6;
+  } else if (!ipv4) {
+    overhead = SLI_TCP_V6_HEADER_LENGTH - SLI_TCP_HEADER_LENGTH;
+  }
+  return (mss > overhead) ? (mss - overhead) : 0;
+}
+
+/*
+ * Appends a write to the frame held back by the cork or, failing that, to the last frame of the socket queue
+ * as long as another frame is ahead of it. The frame at the head is never touched, because the scheduler may
+ * be writing it to the bus. A corked frame that reaches the limit is handed to the scheduler.
+ *
+ * Returns true if the data was appended.
+ */
+static bool sli_si91x_socket_coalesce_data(sli_si91x_socket_t *si91x_socket,
+                                           uint16_t header_length,
+                                           const struct iovec *iov,
+                                           int iovcnt,
+                                           uint32_t data_length,
+                                           uint32_t limit)
+{
+  bool appended         = false;
+  CORE_irqState_t state = CORE_EnterAtomic();
+
+  sl_wifi_buffer_t *buffer = si91x_socket->tx_cork_buffer;
+  if ((buffer == NULL) && (si91x_socket->tx_data_queue.tail != si91x_socket->tx_data_queue.head)) {
+    buffer = si91x_socket->tx_data_queue.tail;
+  }
+
+  if (buffer != NULL) {
+    uint16_t capacity                     = 0;
+    sl_wifi_system_packet_t *packet       = sli_wifi_host_get_buffer_data(buffer, 0, &capacity);
+    sli_si91x_socket_send_request_t *send = (sli_si91x_socket_send_request_t *)packet->data;
+    uint32_t length                       = send->length + data_length;
+    uint32_t frame_length                 = sizeof(sli_si91x_socket_send_request_t) + header_length + length;
+
+    if ((length <= limit) && ((sizeof(sl_wifi_system_packet_t) + frame_length) <= capacity)) {
+      sli_si91x_socket_gather(send->send_buffer + header_length + send->length, iov, iovcnt, data_length);
+      send->length   = length;
+      packet->length = frame_length & 0xFFF;
+      si91x_socket->tx_coalesced++;
+      appended = true;
+
+      if ((buffer == si91x_socket->tx_cork_buffer) && (length == limit)) {
+        sli_si91x_socket_queue_corked_frame(si91x_socket);
+      }
+    }
+  }
+  CORE_ExitAtomic(state);
+
+  return appended;
+}
+
+void sli_si91x_socket_release_tx_slot(sli_si91x_socket_t *si91x_socket)
+{
+  // Atomic protection for data_buffer_count to prevent race condition
+  CORE_irqState_t state = CORE_EnterAtomic();
+  // A blocked sender takes over the slot, so the count stays unchanged
+  osThreadId_t woken = sli_wifi_wait_queue_grant_one(&si91x_socket->tx_waiters);
+  if ((woken == NULL) && (si91x_socket->data_buffer_count > 0)) {
+    --si91x_socket->data_buffer_count;
+  }
+  CORE_ExitAtomic(state);
+  sli_wifi_wait_queue_notify(woken);
+}
+
+int sli_si91x_socket_set_receive_buffer_callback(sli_si91x_socket_t *si91x_socket,
+                                                 sl_si91x_socket_receive_buffer_callback_t callback,
+                                                 uint8_t quota)
+{
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(quota > SL_SI91X_SOCKET_MAX_RX_BUFFER_LOANS, EINVAL);
+
+  CORE_irqState_t state              = CORE_EnterAtomic();
+  si91x_socket->recv_buffer_callback = callback;
+  si91x_socket->rx_buffer_quota      = (callback != NULL) ? quota : 0;
+  CORE_ExitAtomic(state);
+  return SLI_SI91X_NO_ERROR;
+}
+
+bool sli_si91x_socket_deliver_received_data(int32_t host_socket, sl_wifi_buffer_t *buffer)
+{
+  sli_si91x_socket_t *si91x_socket     = sli_get_si91x_socket(host_socket);
+  sl_wifi_system_packet_t *packet      = (sl_wifi_system_packet_t *)sli_wifi_host_get_buffer_data(buffer, 0, NULL);
+  sl_si91x_socket_metadata_t *metadata = (sl_si91x_socket_metadata_t *)packet->data;
+  uint8_t *data                        = &packet->data[metadata->offset];
+
+  if (si91x_socket->recv_buffer_callback == NULL) {
+    if (si91x_socket->recv_data_callback != NULL) {
+      si91x_socket->recv_data_callback(host_socket, data, metadata->length, metadata);
+    }
+    return false;
+  }
+
+  // Past the quota of the socket or of all sockets, the buffer is only lent for the duration of the callback
+  int loan = sli_si91x_socket_take_rx_loan(si91x_socket, buffer);
+  if (loan < 0) {
+    si91x_socket->rx_buffer_quota_exceeded++;
+    si91x_socket->recv_buffer_callback(host_socket, NULL, data, metadata->length, metadata);
+    return false;
+  }
+
+  if (si91x_socket->recv_buffer_callback(host_socket, buffer, data, metadata->length, metadata)) {
+    return true;
+  }
+
+  // The data was consumed in the callback, the loan ends here and the caller frees the buffer
+  CORE_irqState_t state                  = CORE_EnterAtomic();
+  sli_si91x_rx_buffer_loans[loan].buffer = NULL;
+  if (si91x_socket->rx_buffers_held > 0) {
+    --si91x_socket->rx_buffers_held;
+  }
+  CORE_ExitAtomic(state);
+  return false;
+}
+
+sl_status_t sli_si91x_socket_release_receive_buffer(sl_wifi_buffer_t *buffer)
+{
+  if (buffer == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  bool found            = false;
+  CORE_irqState_t state = CORE_EnterAtomic();
+  for (uint8_t i = 0; i < SL_SI91X_SOCKET_MAX_RX_BUFFER_LOANS; i++) {
+    if (sli_si91x_rx_buffer_loans[i].buffer != buffer) {
+      continue;
+    }
+    uint8_t socket_index                = sli_si91x_rx_buffer_loans[i].socket_index;
+    sli_si91x_rx_buffer_loans[i].buffer = NULL;
+    if ((socket_index != SLI_SI91X_RX_LOAN_ORPHANED) && (sli_si91x_sockets[socket_index] != NULL)
+        && (sli_si91x_sockets[socket_index]->rx_buffers_held > 0)) {
+      --sli_si91x_sockets[socket_index]->rx_buffers_held;
+    }
+    found = true;
+    break;
+  }
+  CORE_ExitAtomic(state);
+
+  // Only buffers that are currently lent can be released, so a second release of the same buffer is refused
+  if (!found) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  sli_si91x_host_free_buffer(buffer);
+  return SL_STATUS_OK;
+}
+
+// Records a loan of buffer to the socket, returns its slot or -1 if a quota is used up
+static int sli_si91x_socket_take_rx_loan(sli_si91x_socket_t *si91x_socket, sl_wifi_buffer_t *buffer)
+{
+  int loan              = -1;
+  CORE_irqState_t state = CORE_EnterAtomic();
+  if (si91x_socket->rx_buffers_held < si91x_socket->rx_buffer_quota) {
+    for (int i = 0; i < SL_SI91X_SOCKET_MAX_RX_BUFFER_LOANS; i++) {
+      if (sli_si91x_rx_buffer_loans[i].buffer == NULL) {
+        sli_si91x_rx_buffer_loans[i].buffer       = buffer;
+        sli_si91x_rx_buffer_loans[i].socket_index = si91x_socket->index;
+        ++si91x_socket->rx_buffers_held;
+        loan = i;
+        break;
+      }
+    }
+  }
+  CORE_ExitAtomic(state);
+  return loan;
+}
+
+// Detaches the buffers lent to a closing socket, so their release does not touch a socket reusing its index
+static void sli_si91x_socket_orphan_rx_loans(uint8_t socket_index)
+{
+  CORE_irqState_t state = CORE_EnterAtomic();
+  for (uint8_t i = 0; i < SL_SI91X_SOCKET_MAX_RX_BUFFER_LOANS; i++) {
+    if ((sli_si91x_rx_buffer_loans[i].buffer != NULL) && (sli_si91x_rx_buffer_loans[i].socket_index == socket_index)) {
+      sli_si91x_rx_buffer_loans[i].socket_index = SLI_SI91X_RX_LOAN_ORPHANED;
+    }
+  }
+  CORE_ExitAtomic(state);
+}
+
 /**
  * @brief Helper: Find socket ID by port number and LISTEN state
  * */
@@ -1753,6 +2276,86 @@ int32_t sli_handle_select_result(const sli_si91x_select_request_t *select_reques
   return total_fd_set_count;
 }
 
+// Returns a mask of the host sockets in readfds that have data in their receive ring
+#ifndef __ZEPHYR__
+static uint32_t sli_si91x_buffered_read_sockets(int nfds, const fd_set *readfds)
+#else
+static uint32_t sli_si91x_buffered_read_sockets(int nfds, const sl_si91x_fdset_t *readfds)
+#endif
+{
+  uint32_t buffered_sockets = 0;
+
+  if (readfds == NULL) {
+    return 0;
+  }
+
+  for (int host_socket_index = 0; (host_socket_index < nfds) && (host_socket_index < SLI_NUMBER_OF_SOCKETS);
+       host_socket_index++) {
+    const sli_si91x_socket_t *socket = sli_get_si91x_socket(host_socket_index);
+#ifndef __ZEPHYR__
+    if ((socket != NULL) && (socket->rx_ring_count > 0) && FD_ISSET(host_socket_index, readfds)) {
+#else
+    if ((socket != NULL) && (socket->rx_ring_count > 0) && SL_SI91X_FD_ISSET(host_socket_index, readfds)) {
+#endif
+      buffered_sockets |= BIT(host_socket_index);
+    }
+  }
+  return buffered_sockets;
+}
+
+// Marks the buffered sockets readable and returns how many were not already set
+#ifndef __ZEPHYR__
+static int32_t sli_si91x_mark_buffered_sockets(uint32_t buffered_sockets, fd_set *readfds)
+#else
+static int32_t sli_si91x_mark_buffered_sockets(uint32_t buffered_sockets, sl_si91x_fdset_t *readfds)
+#endif
+{
+  int32_t count = 0;
+
+  if (readfds == NULL) {
+    return 0;
+  }
+
+  for (int host_socket_index = 0; host_socket_index < SLI_NUMBER_OF_SOCKETS; host_socket_index++) {
+    if ((buffered_sockets & BIT(host_socket_index)) == 0) {
+      continue;
+    }
+#ifndef __ZEPHYR__
+    if (!FD_ISSET(host_socket_index, readfds)) {
+      FD_SET(host_socket_index, readfds);
+#else
+    if (!SL_SI91X_FD_ISSET(host_socket_index, readfds)) {
+      SL_SI91X_FD_SET(host_socket_index, readfds);
+#endif
+      count++;
+    }
+  }
+  return count;
+}
+
+// Returns true if writefds asks about any socket below nfds
+#ifndef __ZEPHYR__
+static bool sli_si91x_has_write_interest(int nfds, const fd_set *writefds)
+#else
+static bool sli_si91x_has_write_interest(int nfds, const sl_si91x_fdset_t *writefds)
+#endif
+{
+  if (writefds == NULL) {
+    return false;
+  }
+
+  for (int host_socket_index = 0; host_socket_index < nfds; host_socket_index++) {
+#ifndef __ZEPHYR__
+    if (FD_ISSET(host_socket_index, writefds)) {
+#else
+    if (SL_SI91X_FD_ISSET(host_socket_index, writefds)) {
+#endif
+      return true;
+    }
+  }
+  return false;
+}
+
 #ifndef __ZEPHYR__
 int sli_si91x_select(int nfds,
                      fd_set *readfds,
@@ -1780,13 +2383,30 @@ int sli_si91x_select(int nfds,
     SLI_SET_ERROR_AND_RETURN(EINVAL);
   }
 
+  // Data already held in a host receive ring makes a socket readable without asking the firmware
+  uint32_t buffered_read_sockets = sli_si91x_buffered_read_sockets(nfds, readfds);
+  if ((buffered_read_sockets != 0) && !sli_si91x_has_write_interest(nfds, writefds)) {
+    SLI_SI91X_NULL_SAFE_FD_ZERO(readfds);
+    SLI_SI91X_NULL_SAFE_FD_ZERO(exceptfds);
+    int32_t buffered_fd_count = sli_si91x_mark_buffered_sockets(buffered_read_sockets, readfds);
+    if (callback != NULL) {
+      callback(readfds, writefds, exceptfds, SL_STATUS_OK);
+      return SLI_WIFI_RETURN_IMMEDIATELY;
+    }
+    return buffered_fd_count;
+  }
+
   // Prepare the select request structure
   uint8_t error = sli_prepare_select_request(nfds, readfds, writefds, &request);
   if (error != 0) {
     SLI_SET_ERROR_AND_RETURN(EBADF);
   }
 
-  if (timeout != NULL) {
+  if (buffered_read_sockets != 0) {
+    // Some sockets are already readable, so only poll the firmware for the write set
+    const struct timeval poll_timeout = { 0 };
+    sli_handle_timeout(&poll_timeout, &request, &select_response_wait_time);
+  } else if (timeout != NULL) {
     sli_handle_timeout(timeout, &request, &select_response_wait_time);
   } else {
     // If no timeout is specified, set the request to indicate no timeout and wait indefinitely
@@ -1799,7 +2419,8 @@ int sli_si91x_select(int nfds,
   // If no select ID is available, return an error
   SLI_SET_ERRNO_AND_RETURN_IF_TRUE((select_request == NULL), EPERM);
   // Assign the callback function for this select request
-  select_request->select_callback = callback;
+  select_request->select_callback       = callback;
+  select_request->buffered_read_sockets = buffered_read_sockets;
   // Set the select_id in the request structure
   request.select_id = select_request->select_id;
 
@@ -1829,7 +2450,11 @@ int sli_si91x_select(int nfds,
 
   sli_convert_and_save_firmware_status(select_request_table[request.select_id].frame_status);
 
-  return sli_handle_select_result(select_request, readfds, writefds, exceptfds);
+  int32_t total_fd_set_count = sli_handle_select_result(select_request, readfds, writefds, exceptfds);
+  if (total_fd_set_count >= 0) {
+    total_fd_set_count += sli_si91x_mark_buffered_sockets(buffered_read_sockets, readfds);
+  }
+  return total_fd_set_count;
 }
 
 static sli_si91x_select_request_t *sli_si91x_get_available_select_id(void)
@@ -1936,6 +2561,175 @@ sl_status_t sli_si91x_udp_connect_if_unconnected(sli_si91x_socket_t *si91x_socke
   return status;
 }
 
+sl_status_t sli_si91x_socket_read_data(sli_si91x_socket_t *si91x_socket,
+                                       size_t length,
+                                       sl_wifi_buffer_t **response_buffer)
+{
+  sli_si91x_req_socket_read_t request = { 0 };
+
+  request.socket_id = (uint8_t)si91x_socket->id;
+  memcpy(request.requested_bytes, &length, sizeof(request.requested_bytes));
+  memcpy(request.read_timeout, &si91x_socket->read_timeout, sizeof(request.read_timeout));
+
+  sl_status_t status = sli_si91x_send_socket_command(si91x_socket,
+                                                     SLI_WLAN_REQ_SOCKET_READ_DATA,
+                                                     &request,
+                                                     sizeof(request),
+                                                     SLI_WIFI_WAIT_FOR_EVER | SLI_WIFI_WAIT_FOR_RESPONSE_BIT,
+                                                     response_buffer);
+
+  // On failure the caller gets no buffer to release
+  if ((status != SL_STATUS_OK) && (*response_buffer != NULL)) {
+    sli_si91x_host_free_buffer(*response_buffer);
+    *response_buffer = NULL;
+  }
+  return status;
+}
+
+int sli_si91x_socket_set_read_ahead(sli_si91x_socket_t *si91x_socket, uint16_t window)
+{
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type != SOCK_STREAM, EOPNOTSUPP);
+
+  // Read-ahead is still disabled, the on-demand ring goes away once drained
+  if (si91x_socket->rx_ring_on_demand && (window == 0)) {
+    return SLI_SI91X_NO_ERROR;
+  }
+  if (window == si91x_socket->rx_ring_size) {
+    si91x_socket->rx_ring_on_demand = false;
+    return SLI_SI91X_NO_ERROR;
+  }
+
+  // Buffered data would be lost or reordered by a resize
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->rx_ring_count != 0, EBUSY);
+
+  // The ring is allocated with the new size on the next receive
+  free(si91x_socket->rx_ring);
+  si91x_socket->rx_ring           = NULL;
+  si91x_socket->rx_ring_size      = window;
+  si91x_socket->rx_ring_head      = 0;
+  si91x_socket->rx_ring_on_demand = false;
+  return SLI_SI91X_NO_ERROR;
+}
+
+// Copies up to length buffered bytes out of the receive ring, removing them unless the caller only peeks
+static size_t sli_si91x_rx_ring_read(sli_si91x_socket_t *si91x_socket, uint8_t *data, size_t length, bool consume)
+{
+  size_t count = (length < si91x_socket->rx_ring_count) ? length : si91x_socket->rx_ring_count;
+  size_t first = si91x_socket->rx_ring_size - si91x_socket->rx_ring_head;
+
+  if (first > count) {
+    first = count;
+  }
+  memcpy(data, &si91x_socket->rx_ring[si91x_socket->rx_ring_head], first);
+  memcpy(data + first, si91x_socket->rx_ring, count - first);
+
+  if (consume) {
+    si91x_socket->rx_ring_head  = (uint16_t)((si91x_socket->rx_ring_head + count) % si91x_socket->rx_ring_size);
+    si91x_socket->rx_ring_count = (uint16_t)(si91x_socket->rx_ring_count - count);
+  }
+  return count;
+}
+
+// Appends data to the receive ring; length must not exceed the free space
+static void sli_si91x_rx_ring_write(sli_si91x_socket_t *si91x_socket, const uint8_t *data, size_t length)
+{
+  size_t tail  = (si91x_socket->rx_ring_head + si91x_socket->rx_ring_count) % si91x_socket->rx_ring_size;
+  size_t first = si91x_socket->rx_ring_size - tail;
+
+  if (first > length) {
+    first = length;
+  }
+  memcpy(&si91x_socket->rx_ring[tail], data, first);
+  memcpy(si91x_socket->rx_ring, data + first, length - first);
+  si91x_socket->rx_ring_count = (uint16_t)(si91x_socket->rx_ring_count + length);
+}
+
+// Receives through a receive ring of rx_ring_size bytes, allocating it if needed
+static ssize_t sli_si91x_rx_ring_recv(sli_si91x_socket_t *si91x_socket, uint8_t *buf, size_t buf_len, int32_t flags)
+{
+  const bool peek  = (flags & MSG_PEEK) != 0;
+  size_t max_fetch = (si91x_socket->local_address.sin6_family == AF_INET6) ? SLI_DEFAULT_STREAM_MSS_SIZE_IPV6
+                                                                           : SLI_DEFAULT_STREAM_MSS_SIZE_IPV4;
+  size_t copied    = 0;
+  size_t needed    = (flags & MSG_WAITALL) ? buf_len : 1;
+
+  if (si91x_socket->rx_ring == NULL) {
+    si91x_socket->rx_ring      = malloc(si91x_socket->rx_ring_size);
+    si91x_socket->rx_ring_head = 0;
+    SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->rx_ring == NULL, ENOMEM);
+  }
+
+  // A peek cannot wait for more data than the ring holds
+  if (peek && (needed > si91x_socket->rx_ring_size)) {
+    needed = si91x_socket->rx_ring_size;
+  }
+
+  while (1) {
+    if (!peek) {
+      copied += sli_si91x_rx_ring_read(si91x_socket, buf + copied, buf_len - copied, true);
+      if (copied >= needed) {
+        return (ssize_t)copied;
+      }
+    } else if (si91x_socket->rx_ring_count >= needed) {
+      return (ssize_t)sli_si91x_rx_ring_read(si91x_socket, buf, buf_len, false);
+    }
+
+    // Fetch as much as fits in the ring in one command, up to one segment
+    size_t space             = (size_t)(si91x_socket->rx_ring_size - si91x_socket->rx_ring_count);
+    sl_wifi_buffer_t *buffer = NULL;
+    sl_status_t status = sli_si91x_socket_read_data(si91x_socket, (space < max_fetch) ? space : max_fetch, &buffer);
+    if (status != SL_STATUS_OK) {
+      // Report what was already received and leave the error for the next call
+      if (copied > 0) {
+        return (ssize_t)copied;
+      }
+      if (peek && (si91x_socket->rx_ring_count > 0)) {
+        return (ssize_t)sli_si91x_rx_ring_read(si91x_socket, buf, buf_len, false);
+      }
+      SLI_SET_ERRNO_AND_RETURN_IF_TRUE(status == SL_STATUS_SI91X_SOCKET_CLOSED, ENOTCONN);
+      SLI_SET_ERROR_AND_RETURN(SLI_SI91X_UNDEFINED_ERROR);
+    }
+
+    const sl_wifi_system_packet_t *packet      = sli_wifi_host_get_buffer_data(buffer, 0, NULL);
+    const sl_si91x_socket_metadata_t *response = (const sl_si91x_socket_metadata_t *)packet->data;
+    size_t length                              = (response->length <= space) ? response->length : space;
+
+    sli_si91x_rx_ring_write(si91x_socket, (const uint8_t *)response + response->offset, length);
+    sli_si91x_host_free_buffer(buffer);
+
+    // Nothing more is coming, return whatever is available
+    if (length == 0) {
+      if (!peek) {
+        return (ssize_t)copied;
+      }
+      return (ssize_t)sli_si91x_rx_ring_read(si91x_socket, buf, buf_len, false);
+    }
+  }
+}
+
+ssize_t sli_si91x_socket_buffered_recv(sli_si91x_socket_t *si91x_socket, uint8_t *buf, size_t buf_len, int32_t flags)
+{
+  // MSG_PEEK and MSG_WAITALL need a ring even when read-ahead is disabled, so set one up for a single segment
+  if (si91x_socket->rx_ring_size == 0) {
+    si91x_socket->rx_ring_size      = (si91x_socket->local_address.sin6_family == AF_INET6)
+                                        ? SLI_DEFAULT_STREAM_MSS_SIZE_IPV6
+                                        : SLI_DEFAULT_STREAM_MSS_SIZE_IPV4;
+    si91x_socket->rx_ring_on_demand = true;
+  }
+
+  ssize_t bytes_read = sli_si91x_rx_ring_recv(si91x_socket, buf, buf_len, flags);
+
+  // Once drained, an on-demand ring is released so later reads go straight to the firmware again
+  if (si91x_socket->rx_ring_on_demand && (si91x_socket->rx_ring_count == 0)) {
+    free(si91x_socket->rx_ring);
+    si91x_socket->rx_ring           = NULL;
+    si91x_socket->rx_ring_size      = 0;
+    si91x_socket->rx_ring_head      = 0;
+    si91x_socket->rx_ring_on_demand = false;
+  }
+  return bytes_read;
+}
+
 void sl_si91x_set_socket_cipherlist(uint32_t cipher_list)
 {
   sl_si91x_socket_selected_ciphers = cipher_list;
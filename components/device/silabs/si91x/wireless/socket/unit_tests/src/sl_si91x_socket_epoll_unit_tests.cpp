@@ -0,0 +1,295 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cstring> // For memset
+#include "fff.h"
+
+extern "C" {
+#include "sl_si91x_socket_utility_fake_function.h"
+#include "sl_si91x_socket_epoll.h"
+#include "sl_si91x_socket_callback_framework.h"
+}
+
+static int atomic_depth;
+static int wake_atomic_depth;
+
+static uint32_t enter_atomic(void)
+{
+  atomic_depth++;
+  return 0;
+}
+
+static void exit_atomic(uint32_t state)
+{
+  (void)state;
+  atomic_depth--;
+}
+
+static uint32_t record_wake(void *event_flags, uint32_t flags)
+{
+  (void)event_flags;
+  wake_atomic_depth = atomic_depth;
+  return flags;
+}
+
+static uint32_t received_length;
+
+static void consume_received_data(uint32_t socket,
+                                  uint8_t *data,
+                                  uint32_t length,
+                                  const sl_si91x_socket_metadata_t *firmware_socket_response)
+{
+  (void)socket;
+  (void)data;
+  (void)firmware_socket_response;
+  received_length = length;
+}
+
+class sl_si91x_socket_epoll_unit_tests : public ::testing::Test {
+protected:
+  sli_si91x_socket_t mock_socket;
+  int epfd;
+
+  void SetUp() override
+  {
+    RESET_FAKE(osEventFlagsNew);
+    RESET_FAKE(osEventFlagsSet);
+    RESET_FAKE(sl_si91x_host_elapsed_time);
+    osEventFlagsNew_fake.return_val = (osEventFlagsId_t)&mock_socket;
+
+    memset(&mock_socket, 0, sizeof(mock_socket));
+    mock_socket.type              = SOCK_STREAM;
+    mock_socket.state             = CONNECTED;
+    mock_socket.data_buffer_limit = 1;
+    mock_socket.data_buffer_count = 1;
+    sli_si91x_sockets[0]          = &mock_socket;
+
+    epfd = sl_si91x_epoll_create();
+  }
+
+  void TearDown() override
+  {
+    sl_si91x_epoll_close(epfd);
+    sli_si91x_sockets[0] = NULL;
+  }
+};
+
+// Test case: A socket that is already writable is reported as soon as it is added
+TEST_F(sl_si91x_socket_epoll_unit_tests, AddReportsCurrentReadiness)
+{
+  sl_si91x_epoll_event_t ready[2];
+  sl_si91x_epoll_event_t event = {};
+
+  event.events  = SL_SI91X_EPOLLOUT;
+  event.data.fd = 0;
+
+  mock_socket.data_buffer_count = 0;
+  ASSERT_GE(epfd, 0);
+  EXPECT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+  EXPECT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), -1);
+  EXPECT_EQ(errno, EEXIST);
+
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 1);
+  EXPECT_EQ(ready[0].events, SL_SI91X_EPOLLOUT);
+  EXPECT_EQ(ready[0].data.fd, 0);
+}
+
+// Test case: Edge-triggered events are reported once per notification
+TEST_F(sl_si91x_socket_epoll_unit_tests, EdgeTriggeredReportsOnce)
+{
+  sl_si91x_epoll_event_t ready[2];
+  sl_si91x_epoll_event_t event = {};
+
+  event.events   = SL_SI91X_EPOLLIN | SL_SI91X_EPOLLET;
+  event.data.u32 = 7;
+
+  ASSERT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 0);
+
+  mock_socket.rx_ring_count = 10;
+  sli_si91x_epoll_notify(0, SL_SI91X_EPOLLIN);
+  EXPECT_EQ(osEventFlagsSet_fake.call_count, 1);
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 1);
+  EXPECT_EQ(ready[0].events, SL_SI91X_EPOLLIN);
+  EXPECT_EQ(ready[0].data.u32, 7U);
+
+  // The data is still buffered but nothing new arrived
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 0);
+}
+
+// Test case: Level-triggered events are reported while the condition persists
+TEST_F(sl_si91x_socket_epoll_unit_tests, LevelTriggeredReportsWhileReady)
+{
+  sl_si91x_epoll_event_t ready[2];
+  sl_si91x_epoll_event_t event = {};
+
+  event.events  = SL_SI91X_EPOLLIN;
+  event.data.fd = 0;
+
+  ASSERT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+  mock_socket.rx_ring_count = 10;
+  sli_si91x_epoll_notify(0, SL_SI91X_EPOLLIN);
+
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 1);
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 1);
+
+  mock_socket.rx_ring_count = 0;
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 0);
+}
+
+// Test case: Remote termination is reported even when only writes were of interest
+TEST_F(sl_si91x_socket_epoll_unit_tests, HangupAlwaysReported)
+{
+  sl_si91x_epoll_event_t ready[2];
+  sl_si91x_epoll_event_t event = {};
+
+  event.events  = SL_SI91X_EPOLLOUT;
+  event.data.fd = 0;
+
+  ASSERT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+  mock_socket.state = DISCONNECTED;
+  sli_si91x_epoll_notify(0, SL_SI91X_EPOLLIN | SL_SI91X_EPOLLHUP);
+
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 1);
+  EXPECT_EQ(ready[0].events, SL_SI91X_EPOLLHUP);
+}
+
+// Test case: Removed and freed sockets are no longer reported
+TEST_F(sl_si91x_socket_epoll_unit_tests, DeleteStopsReporting)
+{
+  sl_si91x_epoll_event_t ready[2];
+  sl_si91x_epoll_event_t event = {};
+
+  event.events  = SL_SI91X_EPOLLIN;
+  event.data.fd = 0;
+
+  ASSERT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+  sli_si91x_epoll_notify(0, SL_SI91X_EPOLLIN);
+  EXPECT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_DEL, 0, NULL), 0);
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 0);
+  EXPECT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_DEL, 0, NULL), -1);
+  EXPECT_EQ(errno, ENOENT);
+
+  ASSERT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+  sli_si91x_epoll_notify(0, SL_SI91X_EPOLLIN);
+  sli_si91x_epoll_remove_socket(0);
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 0);
+}
+
+// Test case: Invalid descriptors and arguments are rejected
+TEST_F(sl_si91x_socket_epoll_unit_tests, InvalidArguments)
+{
+  sl_si91x_epoll_event_t ready[2];
+  sl_si91x_epoll_event_t event = {};
+
+  event.events  = SL_SI91X_EPOLLIN;
+  event.data.fd = 0;
+
+  EXPECT_EQ(sl_si91x_epoll_ctl(SL_SI91X_EPOLL_MAX_INSTANCES, SL_SI91X_EPOLL_CTL_ADD, 0, &event), -1);
+  EXPECT_EQ(errno, EBADF);
+  EXPECT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 1, &event), -1);
+  EXPECT_EQ(errno, EBADF);
+  EXPECT_EQ(sl_si91x_epoll_ctl(epfd, 0, 0, &event), -1);
+  EXPECT_EQ(errno, EINVAL);
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 0, 0), -1);
+  EXPECT_EQ(errno, EINVAL);
+}
+
+// Test case: The waiter is woken only after the atomic section is left
+TEST_F(sl_si91x_socket_epoll_unit_tests, NotifyWakesWaiterOutsideAtomicSection)
+{
+  sl_si91x_epoll_event_t event = {};
+
+  event.events  = SL_SI91X_EPOLLIN;
+  event.data.fd = 0;
+  ASSERT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+
+  RESET_FAKE(CORE_EnterAtomic);
+  RESET_FAKE(CORE_ExitAtomic);
+  CORE_EnterAtomic_fake.custom_fake = enter_atomic;
+  CORE_ExitAtomic_fake.custom_fake  = exit_atomic;
+  osEventFlagsSet_fake.custom_fake  = record_wake;
+  atomic_depth                      = 0;
+  wake_atomic_depth                 = -1;
+
+  mock_socket.rx_ring_count = 10;
+  sli_si91x_epoll_notify(0, SL_SI91X_EPOLLIN);
+
+  EXPECT_EQ(osEventFlagsSet_fake.call_count, 1);
+  EXPECT_EQ(wake_atomic_depth, 0);
+
+  CORE_EnterAtomic_fake.custom_fake = NULL;
+  CORE_ExitAtomic_fake.custom_fake  = NULL;
+  osEventFlagsSet_fake.custom_fake  = NULL;
+}
+
+// Test case: Data handed to the receive callback does not make the socket readable
+TEST_F(sl_si91x_socket_epoll_unit_tests, CallbackReceiveDoesNotRaiseEpollIn)
+{
+  sl_si91x_epoll_event_t ready[2];
+  sl_si91x_epoll_event_t event = {};
+
+  event.events  = SL_SI91X_EPOLLIN;
+  event.data.fd = 0;
+  ASSERT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+  mock_socket.recv_data_callback = consume_received_data;
+  received_length                = 0;
+
+  uint8_t frame[sizeof(sl_wifi_system_packet_t) + sizeof(sl_si91x_socket_metadata_t) + 4] = {};
+  sl_wifi_system_packet_t *packet      = (sl_wifi_system_packet_t *)frame;
+  sl_si91x_socket_metadata_t *metadata = (sl_si91x_socket_metadata_t *)packet->data;
+  packet->command                      = SLI_RECEIVE_RAW_DATA;
+  metadata->socket_id                  = (uint16_t)mock_socket.id;
+  metadata->offset                     = sizeof(sl_si91x_socket_metadata_t);
+  metadata->length                     = 4;
+
+  EXPECT_EQ(sli_si91x_socket_event_handler(SL_STATUS_OK, NULL, packet), SL_STATUS_OK);
+  EXPECT_EQ(received_length, 4U);
+  EXPECT_EQ(osEventFlagsSet_fake.call_count, 0);
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, 0), 0);
+}
+
+// Test case: A failed firmware poll ends the wait with the select error instead of waiting for the timeout
+TEST_F(sl_si91x_socket_epoll_unit_tests, FirmwarePollErrorIsReturned)
+{
+  sl_si91x_epoll_event_t ready[2];
+  sl_si91x_epoll_event_t event = {};
+
+  event.events  = SL_SI91X_EPOLLIN;
+  event.data.fd = 0;
+  ASSERT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+  RESET_FAKE(osEventFlagsWait);
+
+  // No select request can be issued before sli_si91x_socket_init()
+  errno = 0;
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, ready, 2, -1), -1);
+  EXPECT_EQ(errno, EPERM);
+  EXPECT_EQ(osEventFlagsWait_fake.call_count, 0);
+}
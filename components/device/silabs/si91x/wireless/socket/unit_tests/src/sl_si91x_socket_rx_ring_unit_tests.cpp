@@ -0,0 +1,358 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cstring> // For memset
+#include <deque>
+#include <string>
+#include "fff.h"
+
+extern "C" {
+#include "sl_si91x_socket_utility_fake_function.h"
+#include "sl_si91x_socket_callback_framework.h"
+#include "sl_si91x_socket_epoll.h"
+}
+
+// Segments the fake firmware returns to successive read commands; the socket is closed once they run out
+static std::deque<std::string> firmware_segments;
+static sli_si91x_socket_select_req_t sent_select_request;
+static uint32_t select_read_ready;
+static uint32_t select_write_ready;
+
+static uint8_t command_frames[2][256];
+static sl_wifi_buffer_t command_buffers[2];
+static uint8_t response_frame[sizeof(sl_wifi_system_packet_t) + sizeof(sl_si91x_socket_metadata_t) + 256];
+static sl_wifi_buffer_t response_buffer;
+
+static sl_status_t allocate_command_buffer(sl_wifi_buffer_t **buffer, void **data, uint32_t length, uint32_t wait)
+{
+  (void)length;
+  (void)wait;
+  uint32_t index = sli_si91x_allocate_command_buffer_fake.call_count % 2;
+  *buffer        = &command_buffers[index];
+  *data          = command_frames[index];
+  return SL_STATUS_OK;
+}
+
+static sl_status_t wait_for_read_response(sli_wifi_buffer_queue_t *queue,
+                                          osEventFlagsId_t events,
+                                          uint32_t event_mask,
+                                          uint16_t packet_id,
+                                          sli_wifi_wait_period_t wait_period,
+                                          sl_wifi_buffer_t **buffer)
+{
+  (void)queue;
+  (void)events;
+  (void)event_mask;
+  (void)packet_id;
+  (void)wait_period;
+  if (firmware_segments.empty()) {
+    *buffer = NULL;
+    return SL_STATUS_SI91X_SOCKET_CLOSED;
+  }
+
+  std::string segment = firmware_segments.front();
+  firmware_segments.pop_front();
+
+  memset(response_frame, 0, sizeof(response_frame));
+  sl_wifi_system_packet_t *packet      = (sl_wifi_system_packet_t *)response_frame;
+  sl_si91x_socket_metadata_t *metadata = (sl_si91x_socket_metadata_t *)packet->data;
+  metadata->offset                     = sizeof(sl_si91x_socket_metadata_t);
+  metadata->length                     = (uint16_t)segment.size();
+  memcpy(packet->data + sizeof(sl_si91x_socket_metadata_t), segment.data(), segment.size());
+  *buffer = &response_buffer;
+  return SL_STATUS_OK;
+}
+
+static void *get_response_data(sl_wifi_buffer_t *buffer, uint16_t offset, uint16_t *data_length)
+{
+  (void)buffer;
+  (void)offset;
+  (void)data_length;
+  return response_frame;
+}
+
+static sl_status_t capture_select_request(uint32_t command,
+                                          sli_wifi_command_type_t command_type,
+                                          void *data,
+                                          uint32_t data_length)
+{
+  (void)command;
+  (void)command_type;
+  (void)data_length;
+  memcpy(&sent_select_request, data, sizeof(sent_select_request));
+  return SL_STATUS_OK;
+}
+
+// Delivers the firmware select response while the caller waits for it
+static uint32_t deliver_select_response(osEventFlagsId_t events, uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  (void)events;
+  (void)options;
+  (void)timeout;
+  uint8_t frame[sizeof(sl_wifi_system_packet_t) + sizeof(sli_si91x_socket_select_rsp_t)] = {};
+  sl_wifi_system_packet_t *packet         = (sl_wifi_system_packet_t *)frame;
+  sli_si91x_socket_select_rsp_t *response = (sli_si91x_socket_select_rsp_t *)packet->data;
+  packet->command                         = SLI_WLAN_RSP_SELECT_REQUEST;
+  response->select_id                     = sent_select_request.select_id;
+  response->read_fds.fd_array[0]          = select_read_ready;
+  response->write_fds.fd_array[0]         = select_write_ready;
+
+  sli_si91x_socket_event_handler(SL_STATUS_OK, NULL, packet);
+  return flags;
+}
+
+class sl_si91x_socket_rx_ring_unit_tests : public ::testing::Test {
+protected:
+  sli_si91x_socket_t mock_socket;
+  sli_si91x_socket_t other_socket;
+  uint8_t buffer[16];
+
+  void SetUp() override
+  {
+    RESET_FAKE(sli_si91x_allocate_command_buffer);
+    RESET_FAKE(sli_wifi_wait_for_response_packet);
+    RESET_FAKE(sli_wifi_host_get_buffer_data);
+    RESET_FAKE(sli_si91x_host_free_buffer);
+    RESET_FAKE(sli_si91x_driver_send_async_command);
+    RESET_FAKE(osEventFlagsWait);
+    RESET_FAKE(osMutexNew);
+    RESET_FAKE(osEventFlagsNew);
+    RESET_FAKE(osKernelGetTickFreq);
+    RESET_FAKE(sl_si91x_host_elapsed_time);
+    sli_si91x_allocate_command_buffer_fake.custom_fake = allocate_command_buffer;
+    sli_wifi_wait_for_response_packet_fake.custom_fake = wait_for_read_response;
+    sli_wifi_host_get_buffer_data_fake.custom_fake     = get_response_data;
+    osMutexNew_fake.return_val                         = (osMutexId_t)&mock_socket;
+    osEventFlagsNew_fake.return_val                    = (osEventFlagsId_t)&mock_socket;
+    osKernelGetTickFreq_fake.return_val                = 1000;
+    select_read_ready                                  = 0;
+    select_write_ready                                 = 0;
+    firmware_segments.clear();
+    memset(buffer, 0, sizeof(buffer));
+
+    memset(&mock_socket, 0, sizeof(mock_socket));
+    mock_socket.type                      = SOCK_STREAM;
+    mock_socket.state                     = CONNECTED;
+    mock_socket.local_address.sin6_family = AF_INET;
+    mock_socket.index                     = 0;
+    mock_socket.id                        = 0;
+    sli_si91x_sockets[0]                  = &mock_socket;
+
+    memset(&other_socket, 0, sizeof(other_socket));
+    other_socket.type    = SOCK_STREAM;
+    other_socket.state   = CONNECTED;
+    other_socket.index   = 1;
+    other_socket.id      = 1;
+    sli_si91x_sockets[1] = &other_socket;
+
+    ASSERT_EQ(sli_si91x_socket_init(1), SL_STATUS_OK);
+  }
+
+  void TearDown() override
+  {
+    sli_si91x_socket_deinit();
+    free(mock_socket.rx_ring);
+    sli_si91x_sockets[0]                               = NULL;
+    sli_si91x_sockets[1]                               = NULL;
+    sli_si91x_allocate_command_buffer_fake.custom_fake = NULL;
+    sli_wifi_wait_for_response_packet_fake.custom_fake = NULL;
+    sli_wifi_host_get_buffer_data_fake.custom_fake     = NULL;
+  }
+};
+
+// Test case: A peek leaves the data in the ring for the following reads
+TEST_F(sl_si91x_socket_rx_ring_unit_tests, PeekLeavesDataForNextRead)
+{
+  firmware_segments = { "hello" };
+  ASSERT_EQ(sli_si91x_socket_set_read_ahead(&mock_socket, 64), 0);
+
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, 5, MSG_PEEK), 5);
+  EXPECT_EQ(memcmp(buffer, "hello", 5), 0);
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, 3, 0), 3);
+  EXPECT_EQ(memcmp(buffer, "hel", 3), 0);
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, sizeof(buffer), 0), 2);
+  EXPECT_EQ(memcmp(buffer, "lo", 2), 0);
+
+  // Everything came from a single firmware read and the configured ring stays allocated
+  EXPECT_EQ(sli_wifi_wait_for_response_packet_fake.call_count, 1);
+  EXPECT_EQ(mock_socket.rx_ring_size, 64);
+  EXPECT_TRUE(mock_socket.rx_ring != NULL);
+}
+
+// Test case: MSG_WAITALL keeps reading until the buffer is full
+TEST_F(sl_si91x_socket_rx_ring_unit_tests, WaitAllCollectsSegments)
+{
+  firmware_segments = { "abc", "defg" };
+
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, 7, MSG_WAITALL), 7);
+  EXPECT_EQ(memcmp(buffer, "abcdefg", 7), 0);
+  EXPECT_EQ(sli_wifi_wait_for_response_packet_fake.call_count, 2);
+}
+
+// Test case: MSG_WAITALL returns what arrived before the connection closed
+TEST_F(sl_si91x_socket_rx_ring_unit_tests, WaitAllReturnsPartialDataOnClose)
+{
+  firmware_segments = { "ab" };
+
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, 5, MSG_WAITALL), 2);
+  EXPECT_EQ(memcmp(buffer, "ab", 2), 0);
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, 5, MSG_WAITALL), -1);
+  EXPECT_EQ(errno, ENOTCONN);
+}
+
+// Test case: A ring set up for MSG_PEEK without read-ahead is released once drained
+TEST_F(sl_si91x_socket_rx_ring_unit_tests, OnDemandRingReleasedOnceDrained)
+{
+  firmware_segments = { "hello" };
+
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, 5, MSG_PEEK), 5);
+  EXPECT_TRUE(mock_socket.rx_ring_on_demand);
+  EXPECT_EQ(mock_socket.rx_ring_count, 5);
+
+  // Disabling read-ahead while the peeked data is pending is not an error
+  EXPECT_EQ(sli_si91x_socket_set_read_ahead(&mock_socket, 0), 0);
+
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, 5, 0), 5);
+  EXPECT_FALSE(mock_socket.rx_ring_on_demand);
+  EXPECT_TRUE(mock_socket.rx_ring == NULL);
+  EXPECT_EQ(mock_socket.rx_ring_size, 0);
+}
+
+// Test case: The read-ahead window cannot change while data is buffered
+TEST_F(sl_si91x_socket_rx_ring_unit_tests, ReadAheadResizeRefusedWhileBuffered)
+{
+  firmware_segments = { "hello" };
+  ASSERT_EQ(sli_si91x_socket_set_read_ahead(&mock_socket, 64), 0);
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, 5, MSG_PEEK), 5);
+
+  EXPECT_EQ(sli_si91x_socket_set_read_ahead(&mock_socket, 128), -1);
+  EXPECT_EQ(errno, EBUSY);
+
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, 5, 0), 5);
+  EXPECT_EQ(sli_si91x_socket_set_read_ahead(&mock_socket, 128), 0);
+  EXPECT_EQ(mock_socket.rx_ring_size, 128);
+}
+
+// Test case: Select answers from the ring alone when only read readiness is asked for
+TEST_F(sl_si91x_socket_rx_ring_unit_tests, SelectReportsBufferedReadersWithoutFirmware)
+{
+  fd_set readfds;
+  FD_ZERO(&readfds);
+  FD_SET(0, &readfds);
+  FD_SET(1, &readfds);
+  mock_socket.rx_ring_count = 1;
+
+  EXPECT_EQ(sli_si91x_select(2, &readfds, NULL, NULL, NULL, NULL), 1);
+  EXPECT_TRUE(FD_ISSET(0, &readfds));
+  EXPECT_FALSE(FD_ISSET(1, &readfds));
+  EXPECT_EQ(sli_si91x_driver_send_async_command_fake.call_count, 0);
+}
+
+// Test case: Select still polls the firmware for writability and merges the buffered readers
+TEST_F(sl_si91x_socket_rx_ring_unit_tests, SelectKeepsWriteSetWithBufferedReaders)
+{
+  sli_si91x_driver_send_async_command_fake.custom_fake = capture_select_request;
+  osEventFlagsWait_fake.custom_fake                    = deliver_select_response;
+  select_write_ready                                   = 1U << other_socket.id;
+
+  fd_set readfds;
+  fd_set writefds;
+  FD_ZERO(&readfds);
+  FD_ZERO(&writefds);
+  FD_SET(0, &readfds);
+  FD_SET(1, &writefds);
+  mock_socket.rx_ring_count = 1;
+
+  EXPECT_EQ(sli_si91x_select(2, &readfds, &writefds, NULL, NULL, NULL), 2);
+  EXPECT_TRUE(FD_ISSET(0, &readfds));
+  EXPECT_TRUE(FD_ISSET(1, &writefds));
+
+  // The firmware is only polled, since a socket is already readable
+  EXPECT_EQ(sli_si91x_driver_send_async_command_fake.call_count, 1);
+  EXPECT_EQ(sent_select_request.no_timeout, 0);
+  EXPECT_EQ(sent_select_request.select_timeout.tv_sec, 0U);
+  EXPECT_EQ(sent_select_request.select_timeout.tv_usec, 0U);
+
+  sli_si91x_driver_send_async_command_fake.custom_fake = NULL;
+  osEventFlagsWait_fake.custom_fake                    = NULL;
+}
+
+// Test case: epoll reports a stream the firmware finds readable only once its data is in the receive ring
+TEST_F(sl_si91x_socket_rx_ring_unit_tests, EpollReportsFirmwareReadableStreamOnceBuffered)
+{
+  sli_si91x_driver_send_async_command_fake.custom_fake = capture_select_request;
+  osEventFlagsWait_fake.custom_fake                    = deliver_select_response;
+  select_read_ready                                    = 1U << mock_socket.id;
+  firmware_segments                                    = { "hi" };
+
+  int epfd                     = sl_si91x_epoll_create();
+  sl_si91x_epoll_event_t event = {};
+  sl_si91x_epoll_event_t ready = {};
+  event.events                 = SL_SI91X_EPOLLIN;
+  event.data.fd                = 0;
+  ASSERT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, &ready, 1, 100), 1);
+  EXPECT_EQ(ready.events, SL_SI91X_EPOLLIN);
+  EXPECT_EQ(mock_socket.rx_ring_count, 2);
+
+  // The reported data is read back from the ring without another firmware read
+  EXPECT_EQ(sli_si91x_socket_buffered_recv(&mock_socket, buffer, sizeof(buffer), 0), 2);
+  EXPECT_EQ(memcmp(buffer, "hi", 2), 0);
+  EXPECT_EQ(sli_wifi_wait_for_response_packet_fake.call_count, 1);
+
+  sl_si91x_epoll_close(epfd);
+  sli_si91x_driver_send_async_command_fake.custom_fake = NULL;
+  osEventFlagsWait_fake.custom_fake                    = NULL;
+}
+
+// Test case: A firmware readable indication that yields no data is not reported as EPOLLIN
+TEST_F(sl_si91x_socket_rx_ring_unit_tests, EpollSkipsFirmwareReadableStreamWithoutData)
+{
+  static sl_si91x_host_timestamp_t elapsed[] = { 0, 100 };
+  SET_RETURN_SEQ(sl_si91x_host_elapsed_time, elapsed, 2);
+  sli_si91x_driver_send_async_command_fake.custom_fake = capture_select_request;
+  osEventFlagsWait_fake.custom_fake                    = deliver_select_response;
+  select_read_ready                                    = 1U << mock_socket.id;
+
+  int epfd                     = sl_si91x_epoll_create();
+  sl_si91x_epoll_event_t event = {};
+  sl_si91x_epoll_event_t ready = {};
+  event.events                 = SL_SI91X_EPOLLIN;
+  event.data.fd                = 0;
+  ASSERT_EQ(sl_si91x_epoll_ctl(epfd, SL_SI91X_EPOLL_CTL_ADD, 0, &event), 0);
+
+  EXPECT_EQ(sl_si91x_epoll_wait(epfd, &ready, 1, 100), 0);
+  EXPECT_EQ(mock_socket.rx_ring_count, 0);
+
+  sl_si91x_epoll_close(epfd);
+  sli_si91x_driver_send_async_command_fake.custom_fake = NULL;
+  osEventFlagsWait_fake.custom_fake                    = NULL;
+}
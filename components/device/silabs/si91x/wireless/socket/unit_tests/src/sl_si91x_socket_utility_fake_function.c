@@ -82,6 +82,10 @@ DEFINE_FAKE_VALUE_FUNC3(sl_status_t,
 
 DEFINE_FAKE_VALUE_FUNC1(osMutexId_t, osMutexNew, const osMutexAttr_t *);
 DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osEventFlagsDelete, osEventFlagsId_t);
+DEFINE_FAKE_VALUE_FUNC4(osTimerId_t, osTimerNew, osTimerFunc_t, osTimerType_t, void *, const osTimerAttr_t *);
+DEFINE_FAKE_VALUE_FUNC2(osStatus_t, osTimerStart, osTimerId_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osTimerStop, osTimerId_t);
+DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osTimerDelete, osTimerId_t);
 DEFINE_FAKE_VALUE_FUNC2(osStatus_t, osMutexAcquire, osMutexId_t, uint32_t);
 DEFINE_FAKE_VALUE_FUNC1(osEventFlagsId_t, osEventFlagsNew, const osEventFlagsAttr_t *);
 DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osDelay, uint32_t);
@@ -94,6 +98,15 @@ DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osMutexDelete, osMutexId_t);
 DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osMutexRelease, osMutexId_t);
 DEFINE_FAKE_VOID_FUNC_VARARG(sl_redirect_log, const char *, ...);
 DEFINE_FAKE_VOID_FUNC1(sli_wifi_set_event, uint32_t);
+DEFINE_FAKE_VOID_FUNC1(sli_si91x_driver_queue_socket_data_frames, sli_wifi_buffer_queue_t *);
 DEFINE_FAKE_VOID_FUNC2(sli_wifi_append_to_buffer_queue, sli_wifi_buffer_queue_t *, sl_wifi_buffer_t *);
 DEFINE_FAKE_VALUE_FUNC2(size_t, sl_strnlen, char *, size_t);
 DEFINE_FAKE_VALUE_FUNC0(uint32_t, osKernelGetTickFreq);
+DEFINE_FAKE_VOID_FUNC2(sli_wifi_wait_queue_append, sli_wifi_wait_queue_t *, sli_wifi_waiter_t *);
+DEFINE_FAKE_VALUE_FUNC1(osThreadId_t, sli_wifi_wait_queue_grant_one, sli_wifi_wait_queue_t *);
+DEFINE_FAKE_VOID_FUNC1(sli_wifi_wait_queue_notify, osThreadId_t);
+DEFINE_FAKE_VALUE_FUNC3(sl_status_t,
+                        sli_wifi_wait_queue_wait,
+                        sli_wifi_wait_queue_t *,
+                        sli_wifi_waiter_t *,
+                        uint32_t);
@@ -35,6 +35,7 @@
 extern "C" {
 #include "sl_si91x_socket_utility_fake_function.h"
 #include "sl_string.h"
+#include "sl_si91x_driver.h"
 void sli_si91x_create_socket_request(sli_si91x_socket_t *si91x_bsd_socket,
                                      sli_si91x_socket_create_request_t *socket_create_request,
                                      int type,
@@ -382,4 +383,231 @@ TEST(sl_si91x_socket_utility_unit_tests, DriverSendCommandFails)
   // Verify the results
   EXPECT_EQ(status, SL_STATUS_FAIL);
   EXPECT_EQ(sli_si91x_driver_send_command_fake.call_count, 1);
-}
\ No newline at end of file
+}
+
+// Frame storage handed out by the sli_wifi_host_get_buffer_data fake in the coalescing tests
+static uint8_t coalesce_frame[sizeof(sl_wifi_system_packet_t) + sizeof(sli_si91x_socket_send_request_t) + 64];
+
+static void *coalesce_get_buffer_data(sl_wifi_buffer_t *buffer, uint16_t offset, uint16_t *data_length)
+{
+  (void)buffer;
+  (void)offset;
+  if (data_length != NULL) {
+    *data_length = sizeof(coalesce_frame);
+  }
+  return coalesce_frame;
+}
+
+// Test case: A small write is appended to a frame queued behind another one
+TEST(sl_si91x_socket_utility_unit_tests, CoalesceWriteIntoQueuedFrame)
+{
+  RESET_FAKE(sli_wifi_host_get_buffer_data);
+  RESET_FAKE(sli_si91x_host_allocate_buffer);
+  sli_wifi_host_get_buffer_data_fake.custom_fake = coalesce_get_buffer_data;
+
+  sli_si91x_socket_t mock_socket;
+  memset(&mock_socket, 0, sizeof(mock_socket));
+  mock_socket.type                      = SOCK_STREAM;
+  mock_socket.mss                       = SLI_DEFAULT_STREAM_MSS_SIZE_IPV4;
+  mock_socket.local_address.sin6_family = AF_INET;
+  mock_socket.data_buffer_limit         = 1;
+  mock_socket.data_buffer_count         = 1;
+  mock_socket.tx_nodelay                = false;
+  sl_wifi_buffer_t head_frame           = {};
+  sl_wifi_buffer_t tail_frame           = {};
+  mock_socket.tx_data_queue.head        = &head_frame;
+  mock_socket.tx_data_queue.tail        = &tail_frame;
+
+  // The queued tail frame already carries "abc"
+  memset(coalesce_frame, 0, sizeof(coalesce_frame));
+  sl_wifi_system_packet_t *packet       = (sl_wifi_system_packet_t *)coalesce_frame;
+  sli_si91x_socket_send_request_t *send = (sli_si91x_socket_send_request_t *)packet->data;
+  send->length                          = 3;
+  memcpy(send->send_buffer, "abc", 3);
+
+  sli_si91x_socket_send_request_t request = {};
+  request.data_offset                     = sizeof(sli_si91x_socket_send_request_t);
+  request.length                          = 2;
+
+  sl_status_t status = sli_si91x_send_socket_data(&mock_socket, &request, "de");
+
+  EXPECT_EQ(status, SL_STATUS_OK);
+  EXPECT_EQ(send->length, 5U);
+  EXPECT_EQ(memcmp(send->send_buffer, "abcde", 5), 0);
+  EXPECT_EQ(packet->length, sizeof(sli_si91x_socket_send_request_t) + 5);
+  EXPECT_EQ(mock_socket.tx_coalesced, 1U);
+  // Neither a buffer nor a data buffer slot was taken for the write
+  EXPECT_EQ(sli_si91x_host_allocate_buffer_fake.call_count, 0);
+  EXPECT_EQ(mock_socket.data_buffer_count, 1);
+
+  sli_wifi_host_get_buffer_data_fake.custom_fake = NULL;
+}
+
+// Test case: Writes are only merged once TCP_NODELAY is cleared or the socket is corked
+TEST(sl_si91x_socket_utility_unit_tests, CoalesceWritesOnlyWhenEnabled)
+{
+  sli_si91x_socket_t mock_socket;
+  memset(&mock_socket, 0, sizeof(mock_socket));
+  mock_socket.type       = SOCK_STREAM;
+  mock_socket.tx_nodelay = true;
+  EXPECT_FALSE(sli_si91x_socket_coalesces_writes(&mock_socket));
+
+  mock_socket.tx_cork = true;
+  EXPECT_TRUE(sli_si91x_socket_coalesces_writes(&mock_socket));
+
+  mock_socket.ssl_bitmap = SLI_SI91X_WEBSOCKET_FEAT;
+  EXPECT_FALSE(sli_si91x_socket_coalesces_writes(&mock_socket));
+
+  mock_socket.ssl_bitmap = 0;
+  mock_socket.type       = SOCK_DGRAM;
+  mock_socket.tx_cork    = false;
+  mock_socket.tx_nodelay = false;
+  EXPECT_FALSE(sli_si91x_socket_coalesces_writes(&mock_socket));
+}
+
+// Test case: A batch of frames joins the socket queue behind the queued frames with a single wakeup
+TEST(sl_si91x_socket_utility_unit_tests, QueueDataFramesSplicesBatch)
+{
+  RESET_FAKE(sli_wifi_set_event);
+
+  sli_si91x_socket_t mock_socket;
+  memset(&mock_socket, 0, sizeof(mock_socket));
+  mock_socket.index              = 2;
+  sl_wifi_buffer_t queued_frame  = {};
+  sl_wifi_buffer_t first_frame   = {};
+  sl_wifi_buffer_t second_frame  = {};
+  mock_socket.tx_data_queue.head = &queued_frame;
+  mock_socket.tx_data_queue.tail = &queued_frame;
+  first_frame.node.node          = &second_frame.node;
+  sli_wifi_buffer_queue_t frames = {};
+  frames.head                    = &first_frame;
+  frames.tail                    = &second_frame;
+  tx_socket_data_queues_status   = 0;
+
+  sli_si91x_socket_queue_data_frames(&mock_socket, &frames);
+
+  EXPECT_EQ(mock_socket.tx_data_queue.head, &queued_frame);
+  EXPECT_EQ(queued_frame.node.node, &first_frame.node);
+  EXPECT_EQ(mock_socket.tx_data_queue.tail, &second_frame);
+  EXPECT_EQ(tx_socket_data_queues_status, 1U << 2);
+  EXPECT_EQ(sli_wifi_set_event_fake.call_count, 1);
+  EXPECT_EQ(sli_wifi_set_event_fake.arg0_val, SL_SI91X_SOCKET_DATA_TX_PENDING_EVENT);
+  EXPECT_TRUE(frames.head == NULL);
+  EXPECT_TRUE(frames.tail == NULL);
+}
+
+static sl_wifi_buffer_t batch_buffers[2];
+static uint32_t batch_buffers_taken;
+
+// Hands out the test buffers, but only to a caller that waits once the first one is taken
+static sl_status_t batch_allocate_buffer(sl_wifi_buffer_t **buffer,
+                                         sl_wifi_buffer_type_t type,
+                                         uint32_t length,
+                                         uint32_t wait_time)
+{
+  (void)type;
+  (void)length;
+  if ((batch_buffers_taken > 0) && (wait_time == 0)) {
+    return SL_STATUS_ALLOCATION_FAILED;
+  }
+  *buffer = &batch_buffers[batch_buffers_taken++];
+  return SL_STATUS_OK;
+}
+
+// Test case: The first frame of a batch waits for a buffer, a later one hands the batch over before waiting
+TEST(sl_si91x_socket_utility_unit_tests, BatchAddWaitsForBufferOnlyWhenEmpty)
+{
+  RESET_FAKE(sli_wifi_host_get_buffer_data);
+  RESET_FAKE(sli_si91x_host_allocate_buffer);
+  RESET_FAKE(sli_si91x_driver_queue_socket_data_frames);
+  sli_wifi_host_get_buffer_data_fake.custom_fake  = coalesce_get_buffer_data;
+  sli_si91x_host_allocate_buffer_fake.custom_fake = batch_allocate_buffer;
+  memset(batch_buffers, 0, sizeof(batch_buffers));
+  batch_buffers_taken = 0;
+
+  sli_si91x_socket_t mock_socket;
+  memset(&mock_socket, 0, sizeof(mock_socket));
+  sli_si91x_socket_send_batch_t batch = {};
+  batch.socket                        = &mock_socket;
+  batch.socket_queue                  = false;
+
+  sli_si91x_socket_send_request_t request = {};
+  request.data_offset                     = sizeof(sli_si91x_socket_send_request_t);
+  request.length                          = 4;
+  uint8_t data[4]                         = { 1, 2, 3, 4 };
+  struct iovec iov                        = { data, sizeof(data) };
+
+  EXPECT_EQ(sli_si91x_socket_batch_add(&batch, &request, &iov, 1), SL_STATUS_OK);
+  EXPECT_EQ(sli_si91x_host_allocate_buffer_fake.call_count, 1);
+  EXPECT_EQ(sli_si91x_host_allocate_buffer_fake.arg3_history[0], (uint32_t)SLI_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME);
+  EXPECT_EQ(sli_si91x_driver_queue_socket_data_frames_fake.call_count, 0);
+
+  EXPECT_EQ(sli_si91x_socket_batch_add(&batch, &request, &iov, 1), SL_STATUS_OK);
+  EXPECT_EQ(sli_si91x_host_allocate_buffer_fake.call_count, 3);
+  EXPECT_EQ(sli_si91x_host_allocate_buffer_fake.arg3_history[1], 0U);
+  EXPECT_EQ(sli_si91x_driver_queue_socket_data_frames_fake.call_count, 1);
+  EXPECT_EQ(sli_si91x_host_allocate_buffer_fake.arg3_history[2], (uint32_t)SLI_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME);
+  EXPECT_EQ(batch.frames.tail, &batch_buffers[1]);
+
+  sli_wifi_host_get_buffer_data_fake.custom_fake  = NULL;
+  sli_si91x_host_allocate_buffer_fake.custom_fake = NULL;
+}
+
+static sl_wifi_buffer_t *kept_receive_buffer;
+
+static bool keep_receive_buffer(uint32_t socket,
+                                sl_wifi_buffer_t *buffer,
+                                uint8_t *data,
+                                uint32_t length,
+                                const sl_si91x_socket_metadata_t *firmware_socket_response)
+{
+  (void)socket;
+  (void)data;
+  (void)length;
+  (void)firmware_socket_response;
+  kept_receive_buffer = buffer;
+  return buffer != NULL;
+}
+
+// Test case: A receive buffer kept by the callback counts against the quota until it is released, only once
+TEST(sl_si91x_socket_utility_unit_tests, KeptReceiveBufferIsReleasedOnce)
+{
+  RESET_FAKE(sli_wifi_host_get_buffer_data);
+  RESET_FAKE(sli_si91x_host_free_buffer);
+  sli_wifi_host_get_buffer_data_fake.custom_fake = coalesce_get_buffer_data;
+
+  memset(coalesce_frame, 0, sizeof(coalesce_frame));
+  sl_wifi_system_packet_t *packet      = (sl_wifi_system_packet_t *)coalesce_frame;
+  sl_si91x_socket_metadata_t *metadata = (sl_si91x_socket_metadata_t *)packet->data;
+  metadata->offset                     = sizeof(sl_si91x_socket_metadata_t);
+  metadata->length                     = 4;
+
+  sli_si91x_socket_t mock_socket;
+  memset(&mock_socket, 0, sizeof(mock_socket));
+  mock_socket.index              = 0;
+  sli_si91x_sockets[0]           = &mock_socket;
+  sl_wifi_buffer_t first_buffer  = {};
+  sl_wifi_buffer_t second_buffer = {};
+
+  EXPECT_EQ(sli_si91x_socket_set_receive_buffer_callback(&mock_socket, keep_receive_buffer, 1), 0);
+
+  EXPECT_TRUE(sli_si91x_socket_deliver_received_data(0, &first_buffer));
+  EXPECT_EQ(kept_receive_buffer, &first_buffer);
+  EXPECT_EQ(mock_socket.rx_buffers_held, 1);
+
+  // The quota is used up, so the next buffer is only lent for the duration of the callback
+  EXPECT_FALSE(sli_si91x_socket_deliver_received_data(0, &second_buffer));
+  EXPECT_TRUE(kept_receive_buffer == NULL);
+  EXPECT_EQ(mock_socket.rx_buffer_quota_exceeded, 1U);
+
+  EXPECT_EQ(sli_si91x_socket_release_receive_buffer(&first_buffer), SL_STATUS_OK);
+  EXPECT_EQ(mock_socket.rx_buffers_held, 0);
+  EXPECT_EQ(sli_si91x_host_free_buffer_fake.call_count, 1);
+  EXPECT_EQ(sli_si91x_host_free_buffer_fake.arg0_val, &first_buffer);
+
+  EXPECT_EQ(sli_si91x_socket_release_receive_buffer(&first_buffer), SL_STATUS_INVALID_PARAMETER);
+  EXPECT_EQ(sli_si91x_host_free_buffer_fake.call_count, 1);
+
+  sli_si91x_sockets[0]                           = NULL;
+  sli_wifi_host_get_buffer_data_fake.custom_fake = NULL;
+}
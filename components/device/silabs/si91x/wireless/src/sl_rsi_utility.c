@@ -55,11 +55,13 @@
 #include "sli_wifi_utility.h"
 #include "sli_wifi_power_profile.h"
 #include "sli_wifi_memory_manager.h"
+#include "sli_wifi_scan_database.h"
 #include "sli_wifi.h"
 #include "sl_string.h"
 
-static bool sli_si91x_tx_command_status              = false;
-static volatile bool power_save_sequence_in_progress = false;
+static bool sli_si91x_tx_command_status                         = false;
+static volatile bool power_save_sequence_in_progress            = false;
+static sli_si91x_fwup_response_handler_t fwup_response_handler = NULL;
 extern bool global_queue_block;
 
 /******************************************************
@@ -535,83 +537,6 @@ sl_status_t sli_fw_status_storage_index_init(void)
   return status;
 }
 
-// Function to update a existing entry or create new entry for scan results database
-static sli_scan_info_t *sli_update_or_create_scan_info_element(const sli_scan_info_t *info)
-{
-  sli_scan_info_t **scan_db_head = sli_get_scan_info_database();
-  sli_scan_info_t *element       = NULL;
-
-  element = *scan_db_head;
-  while (NULL != element) {
-    if (0 == memcmp(info->bssid, element->bssid, SLI_WIFI_HARDWARE_ADDRESS_LENGTH)) {
-      element->channel       = info->channel;
-      element->security_mode = info->security_mode;
-      element->rssi          = info->rssi;
-      element->network_type  = info->network_type;
-      memcpy(element->ssid, info->ssid, 34);
-      break;
-    }
-    element = element->next;
-  }
-
-  if (NULL == element) {
-    element = (sli_scan_info_t *)malloc(sizeof(sli_scan_info_t));
-    if (element == NULL) {
-      return NULL;
-    }
-    memcpy(element, info, sizeof(sli_scan_info_t));
-    element->next = NULL;
-    return element;
-  }
-
-  return NULL;
-}
-
-// Function to store a given scan info element in scan results database
-static void sli_store_scan_info_element(const sli_scan_info_t *info)
-{
-  sli_scan_info_t *element       = NULL;
-  sli_scan_info_t *head          = NULL;
-  sli_scan_info_t *tail          = NULL;
-  sli_scan_info_t **scan_db_head = sli_get_scan_info_database();
-
-  if (NULL == info) {
-    return;
-  }
-
-  element = sli_update_or_create_scan_info_element(info);
-  if (NULL == element) {
-    return;
-  }
-
-  if (NULL == *scan_db_head) {
-    *scan_db_head = element;
-    return;
-  }
-
-  tail = *scan_db_head;
-  while (NULL != tail) {
-    if (element->rssi < tail->rssi) {
-      element->next = tail;
-      if (NULL == head) {
-        *scan_db_head = element;
-      } else {
-        head->next = element;
-      }
-      break;
-    }
-
-    head = tail;
-    tail = tail->next;
-
-    if (NULL == tail) {
-      head->next = element;
-    }
-  }
-
-  return;
-}
-
 // Function to identify Authentication Key Management Type
 static uint32_t sli_get_key_management_info(const sli_wlan_cipher_suite_t *akms, uint16_t akmsc)
 {
@@ -782,7 +707,7 @@ void sli_handle_wifi_beacon(sl_wifi_system_packet_t *packet)
         }
       }
 
-      sli_store_scan_info_element(&scan_info);
+      sli_wifi_scan_database_update(&scan_info);
     } break;
     default:
       return;
@@ -791,6 +716,20 @@ void sli_handle_wifi_beacon(sl_wifi_system_packet_t *packet)
   return;
 }
 
+// Function to pass the response of a firmware chunk sent without waiting for it
+void sli_handle_fwup_response(uint16_t frame_status)
+{
+  sli_si91x_fwup_response_handler_t handler = fwup_response_handler;
+  if (handler != NULL) {
+    handler((frame_status == SL_STATUS_OK) ? SL_STATUS_OK : (frame_status | BIT(16)));
+  }
+}
+
+void sli_si91x_set_fwup_response_handler(sli_si91x_fwup_response_handler_t handler)
+{
+  fwup_response_handler = handler;
+}
+
 /******************************************************
  *               Function Declarations
  ******************************************************/
@@ -941,6 +880,11 @@ sl_status_t sl_si91x_platform_init(void)
   // Create and start Command Engine thread
   sli_wifi_command_engine_init();
 
+  // Create and start the RX dispatch workers, if any are configured. The queues they serve must be set up before
+  // the event thread can hand them the first event.
+  status = sli_si91x_rx_dispatch_init();
+  VERIFY_STATUS_AND_RETURN(status);
+
   // Create and start SI91X event handler thread
   if (NULL == si91x_event_thread) {
     const osThreadAttr_t attr = {
@@ -1000,6 +944,9 @@ sl_status_t sli_si91x_platform_deinit(void)
     si91x_event_thread = NULL;
   }
 
+  // Terminate the RX dispatch workers
+  sli_si91x_rx_dispatch_deinit();
+
   // Delete event flags
   if (NULL != sli_wifi_events) {
     osEventFlagsDelete(sli_wifi_events);
@@ -1638,6 +1585,12 @@ sl_status_t sli_si91x_flush_socket_data_queues_based_on_queue_type(uint8_t index
   socket->tx_data_queue.head = NULL;
   socket->tx_data_queue.tail = NULL;
 
+  // Drop a partly filled frame held back by the cork as well
+  if (socket->tx_cork_buffer != NULL) {
+    sli_si91x_host_free_buffer(socket->tx_cork_buffer);
+    socket->tx_cork_buffer = NULL;
+  }
+
   // Clear the socket data queue status
   tx_socket_data_queues_status &= ~(1 << socket->index);
 
@@ -1390,6 +1390,28 @@ static sl_status_t sl_si91x_driver_send_data_packet(sl_wifi_buffer_t *buffer, ui
   return SL_STATUS_OK;
 }
 
+void sli_si91x_driver_queue_socket_data_frames(sli_wifi_buffer_queue_t *frames)
+{
+  if (frames->head == NULL) {
+    return;
+  }
+
+  // Splice the whole chain into the data queue with a single critical section and wakeup
+  CORE_irqState_t state = CORE_EnterAtomic();
+  if (sli_tx_data_queue.tail == NULL) {
+    sli_tx_data_queue.head = frames->head;
+  } else {
+    sli_tx_data_queue.tail->node.node = &frames->head->node;
+  }
+  sli_tx_data_queue.tail = frames->tail;
+  tx_generic_socket_data_queues_status |= SL_SI91X_GENERIC_DATA_TX_PENDING_EVENT;
+  sli_wifi_set_event(SL_SI91X_GENERIC_DATA_TX_PENDING_EVENT);
+  CORE_ExitAtomic(state);
+
+  frames->head = NULL;
+  frames->tail = NULL;
+}
+
 sl_status_t sli_si91x_driver_send_async_command(uint32_t command,
                                                 sli_wifi_command_type_t command_type,
                                                 void *data,
@@ -32,7 +32,47 @@
 #include <stdio.h>
 #include "cmsis_compiler.h"
 
-#ifdef PRINT_DEBUG_LOG
+#ifdef SL_DEBUG_LOG_DEFERRED
+#include <stdint.h>
+
+// Size of the deferred log ring buffer in 32-bit words, must be a power of two
+#ifndef SL_DEBUG_LOG_DEFERRED_BUFFER_WORDS
+#define SL_DEBUG_LOG_DEFERRED_BUFFER_WORDS 1024
+#endif
+
+// Maximum argument words captured per record, arguments past this are dropped and the record is flagged truncated
+#ifndef SL_DEBUG_LOG_DEFERRED_MAX_ARG_WORDS
+#define SL_DEBUG_LOG_DEFERRED_MAX_ARG_WORDS 16
+#endif
+
+/**
+ * Captures the format string address and raw arguments into the deferred log ring buffer.
+ * Formatting is left to sl_debug_log_deferred_output() or to log_decoder.py --deferred on the host.
+ * Records are dropped, and counted, when the buffer is full.
+ */
+extern void sl_debug_log_deferred(const char *format, ...);
+
+/**
+ * Hands every published record to sl_debug_log_deferred_output() and frees its space.
+ * Must be called from a single context, typically a low priority task or the idle hook.
+ * Returns the number of records drained.
+ */
+extern uint32_t sl_debug_log_deferred_flush(void);
+
+/// Returns the number of records dropped because the ring buffer was full
+extern uint32_t sl_debug_log_deferred_get_dropped(void);
+
+/// Weak sink for drained records; the default prints each one as a "#@D" hex line
+extern void sl_debug_log_deferred_output(const uint8_t *record, uint32_t length);
+
+/// Weak timestamp source stored with each record; the default returns 0
+extern uint32_t sl_debug_log_deferred_timestamp(void);
+
+#define SL_DEBUG_LOG(format, ...)                                                                   \
+  do {                                                                                              \
+    sl_debug_log_deferred("%s:%s:%d:" format "\r\n", __FILE__, __func__, __LINE__, ##__VA_ARGS__); \
+  } while (0)
+#elif defined(PRINT_DEBUG_LOG)
 extern void sl_debug_log(const char *format, ...);
 #define SL_DEBUG_LOG(format, ...)                                                              \
   do {                                                                                         \
@@ -0,0 +1,301 @@
+/***************************************************************************/ /**
+ * @file sl_debug_log_deferred.c
+ * @brief Binary, deferred-format backend for SL_DEBUG_LOG
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include "sl_wlan_logger.h"
+
+#ifdef SL_DEBUG_LOG_DEFERRED
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Every SL_DEBUG_LOG call is captured as a small record of 32-bit words:
+ *
+ *   word 0   : header (magic, flags, argument word count, record word count)
+ *   word 1   : address of the format string
+ *   word 2   : timestamp from sl_debug_log_deferred_timestamp()
+ *   word 3.. : raw argument words, in format string order
+ *
+ * No formatting happens at the call site. The format string stays in flash and
+ * is resolved by address, either on the host with log_decoder.py --deferred
+ * against the application ELF, or by whatever sl_debug_log_deferred_output()
+ * chooses to do with the record. Strings passed with %s are captured by address
+ * as well, so they must outlive the record (literals, __func__, __FILE__).
+ *
+ * The ring buffer is multi-producer, single-consumer and lock-free: producers
+ * reserve space with a compare-and-swap on the write index and publish the
+ * record by storing its header last. sl_debug_log_deferred_flush() must only
+ * be called from one context, typically a low priority task or the idle hook.
+ */
+
+#define SLI_DEBUG_LOG_RECORD_MAGIC        0xA5000000UL
+#define SLI_DEBUG_LOG_RECORD_MAGIC_MASK   0xFF000000UL
+#define SLI_DEBUG_LOG_RECORD_TRUNCATED    (1UL << 23)
+#define SLI_DEBUG_LOG_RECORD_HEADER_WORDS 3
+#define SLI_DEBUG_LOG_RECORD_MAX_WORDS    (SLI_DEBUG_LOG_RECORD_HEADER_WORDS + SL_DEBUG_LOG_DEFERRED_MAX_ARG_WORDS)
+#define SLI_DEBUG_LOG_BUFFER_MASK         (SL_DEBUG_LOG_DEFERRED_BUFFER_WORDS - 1)
+
+#if (SL_DEBUG_LOG_DEFERRED_BUFFER_WORDS & SLI_DEBUG_LOG_BUFFER_MASK) != 0
+#error "SL_DEBUG_LOG_DEFERRED_BUFFER_WORDS must be a power of two"
+#endif
+
+#if SLI_DEBUG_LOG_RECORD_MAX_WORDS > 0xFF
+#error "SL_DEBUG_LOG_DEFERRED_MAX_ARG_WORDS must fit in the record header"
+#endif
+
+static uint32_t sli_debug_log_buffer[SL_DEBUG_LOG_DEFERRED_BUFFER_WORDS];
+static volatile uint32_t sli_debug_log_write_index;
+static volatile uint32_t sli_debug_log_read_index;
+static volatile uint32_t sli_debug_log_dropped;
+
+__WEAK uint32_t sl_debug_log_deferred_timestamp(void)
+{
+  return 0;
+}
+
+__WEAK void sl_debug_log_deferred_output(const uint8_t *record, uint32_t length)
+{
+  // Default sink prints the record as a hex line that log_decoder.py --deferred picks out of a console capture
+  printf("#@D");
+  for (uint32_t i = 0; i < length; i++) {
+    printf(" %02x", record[i]);
+  }
+  printf("\r\n");
+}
+
+static uint32_t sli_debug_log_store_value(uint32_t *words,
+                                          uint32_t count,
+                                          uint64_t value,
+                                          size_t size,
+                                          bool *truncated)
+{
+  uint32_t needed = (size > sizeof(uint32_t)) ? 2 : 1;
+
+  if (count + needed > SL_DEBUG_LOG_DEFERRED_MAX_ARG_WORDS) {
+    *truncated = true;
+    return count;
+  }
+  words[count++] = (uint32_t)value;
+  if (needed == 2) {
+    words[count++] = (uint32_t)(value >> 32);
+  }
+  return count;
+}
+
+// Walks the conversion specifiers only to fetch each argument with its promoted type; nothing is formatted.
+static uint32_t sli_debug_log_capture_args(const char *format, va_list args, uint32_t *words, bool *truncated)
+{
+  uint32_t count = 0;
+
+  for (const char *p = format; (*p != '\0') && !(*truncated); p++) {
+    if (*p != '%') {
+      continue;
+    }
+    p++;
+    if (*p == '%') {
+      continue;
+    }
+
+    while ((*p == '-') || (*p == '+') || (*p == ' ') || (*p == '#') || (*p == '0')) {
+      p++;
+    }
+    // Field width and precision may each come from an int argument
+    for (int field = 0; field < 2; field++) {
+      if (*p == '*') {
+        count = sli_debug_log_store_value(words, count, (uint32_t)va_arg(args, int), sizeof(int), truncated);
+        p++;
+      } else {
+        while ((*p >= '0') && (*p <= '9')) {
+          p++;
+        }
+      }
+      if ((field == 0) && (*p == '.')) {
+        p++;
+      } else {
+        break;
+      }
+    }
+
+    size_t size = sizeof(int);
+    switch (*p) {
+      case 'h':
+        p += (p[1] == 'h') ? 2 : 1;
+        break;
+      case 'l':
+        if (p[1] == 'l') {
+          size = sizeof(long long);
+          p += 2;
+        } else {
+          size = sizeof(long);
+          p++;
+        }
+        break;
+      case 'j':
+        size = sizeof(intmax_t);
+        p++;
+        break;
+      case 'z':
+        size = sizeof(size_t);
+        p++;
+        break;
+      case 't':
+        size = sizeof(ptrdiff_t);
+        p++;
+        break;
+      default:
+        break;
+    }
+
+    switch (*p) {
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'o':
+      case 'c':
+        if (size > sizeof(uint32_t)) {
+          count = sli_debug_log_store_value(words, count, va_arg(args, unsigned long long), size, truncated);
+        } else if (size == sizeof(long)) {
+          count = sli_debug_log_store_value(words, count, va_arg(args, unsigned long), size, truncated);
+        } else {
+          count = sli_debug_log_store_value(words, count, va_arg(args, unsigned int), size, truncated);
+        }
+        break;
+      case 'p':
+      case 's':
+        count = sli_debug_log_store_value(words,
+                                          count,
+                                          (uintptr_t)va_arg(args, const void *),
+                                          sizeof(uintptr_t),
+                                          truncated);
+        break;
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A': {
+        union {
+          double d;
+          uint64_t u;
+        } value;
+        value.d = va_arg(args, double);
+        count   = sli_debug_log_store_value(words, count, value.u, sizeof(double), truncated);
+        break;
+      }
+      case 'n':
+        (void)va_arg(args, void *);
+        break;
+      case '\0':
+        return count;
+      default:
+        break;
+    }
+  }
+  return count;
+}
+
+void sl_debug_log_deferred(const char *format, ...)
+{
+  uint32_t args[SL_DEBUG_LOG_DEFERRED_MAX_ARG_WORDS];
+  bool truncated = false;
+  va_list list;
+
+  va_start(list, format);
+  uint32_t arg_words = sli_debug_log_capture_args(format, list, args, &truncated);
+  va_end(list);
+
+  uint32_t length = SLI_DEBUG_LOG_RECORD_HEADER_WORDS + arg_words;
+  uint32_t head   = __atomic_load_n(&sli_debug_log_write_index, __ATOMIC_RELAXED);
+
+  do {
+    uint32_t used = head - __atomic_load_n(&sli_debug_log_read_index, __ATOMIC_ACQUIRE);
+    if ((used + length) > SL_DEBUG_LOG_DEFERRED_BUFFER_WORDS) {
+      __atomic_fetch_add(&sli_debug_log_dropped, 1, __ATOMIC_RELAXED);
+      return;
+    }
+  } while (!__atomic_compare_exchange_n(&sli_debug_log_write_index,
+                                        &head,
+                                        head + length,
+                                        true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED));
+
+  sli_debug_log_buffer[(head + 1) & SLI_DEBUG_LOG_BUFFER_MASK] = (uint32_t)(uintptr_t)format;
+  sli_debug_log_buffer[(head + 2) & SLI_DEBUG_LOG_BUFFER_MASK] = sl_debug_log_deferred_timestamp();
+  for (uint32_t i = 0; i < arg_words; i++) {
+    sli_debug_log_buffer[(head + SLI_DEBUG_LOG_RECORD_HEADER_WORDS + i) & SLI_DEBUG_LOG_BUFFER_MASK] = args[i];
+  }
+
+  uint32_t header = SLI_DEBUG_LOG_RECORD_MAGIC | (truncated ? SLI_DEBUG_LOG_RECORD_TRUNCATED : 0)
+                    | (arg_words << 8) | length;
+  __atomic_store_n(&sli_debug_log_buffer[head & SLI_DEBUG_LOG_BUFFER_MASK], header, __ATOMIC_RELEASE);
+}
+
+uint32_t sl_debug_log_deferred_flush(void)
+{
+  uint32_t record[SLI_DEBUG_LOG_RECORD_MAX_WORDS];
+  uint32_t drained = 0;
+  uint32_t tail    = sli_debug_log_read_index;
+
+  while (tail != __atomic_load_n(&sli_debug_log_write_index, __ATOMIC_ACQUIRE)) {
+    uint32_t header = __atomic_load_n(&sli_debug_log_buffer[tail & SLI_DEBUG_LOG_BUFFER_MASK], __ATOMIC_ACQUIRE);
+
+    // The producer owning this slot has reserved it but not published it yet
+    if ((header & SLI_DEBUG_LOG_RECORD_MAGIC_MASK) != SLI_DEBUG_LOG_RECORD_MAGIC) {
+      break;
+    }
+
+    uint32_t length = header & 0xFF;
+    // Clear every word so a stale argument can never be mistaken for the header of a later record
+    for (uint32_t i = 0; i < length; i++) {
+      record[i]                                                  = sli_debug_log_buffer[(tail + i) & SLI_DEBUG_LOG_BUFFER_MASK];
+      sli_debug_log_buffer[(tail + i) & SLI_DEBUG_LOG_BUFFER_MASK] = 0;
+    }
+    tail += length;
+    __atomic_store_n(&sli_debug_log_read_index, tail, __ATOMIC_RELEASE);
+
+    sl_debug_log_deferred_output((const uint8_t *)record, length * sizeof(uint32_t));
+    drained++;
+  }
+  return drained;
+}
+
+uint32_t sl_debug_log_deferred_get_dropped(void)
+{
+  return __atomic_load_n(&sli_debug_log_dropped, __ATOMIC_RELAXED);
+}
+
+#endif // SL_DEBUG_LOG_DEFERRED
@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "sl_wlan_logger.h"
+}
+
+#define RECORD_MAGIC      0xA5000000UL
+#define RECORD_MAGIC_MASK 0xFF000000UL
+#define RECORD_TRUNCATED  (1UL << 23)
+#define HEADER_WORDS      3
+
+static const char test_format[]     = "%u %u";
+static const char wide_format[]     = "%u %u %u %u %u";
+static const char producer_format[] = "producer %u sequence %u";
+
+// Records handed to the output hook, as 32-bit words
+static std::vector<std::vector<uint32_t>> records;
+static std::mutex records_lock;
+static std::atomic<uint32_t> timestamp;
+
+extern "C" {
+uint32_t sl_debug_log_deferred_timestamp(void)
+{
+  return timestamp.fetch_add(1);
+}
+
+void sl_debug_log_deferred_output(const uint8_t *record, uint32_t length)
+{
+  const uint32_t *words = (const uint32_t *)record;
+  std::lock_guard<std::mutex> lock(records_lock);
+  records.emplace_back(words, words + length / sizeof(uint32_t));
+}
+}
+
+class sl_debug_log_deferred_test : public ::testing::Test {
+protected:
+  uint32_t dropped_at_start;
+
+  void SetUp() override
+  {
+    // The ring buffer is static, start every test from an empty one
+    sl_debug_log_deferred_flush();
+    records.clear();
+    timestamp        = 0;
+    dropped_at_start = sl_debug_log_deferred_get_dropped();
+  }
+
+  uint32_t dropped(void)
+  {
+    return sl_debug_log_deferred_get_dropped() - dropped_at_start;
+  }
+
+  // Checks a record of test_format carrying the two given arguments
+  static void expect_record(const std::vector<uint32_t> &record, uint32_t first, uint32_t second)
+  {
+    ASSERT_EQ(HEADER_WORDS + 2u, record.size());
+    EXPECT_EQ(RECORD_MAGIC | (2 << 8) | (HEADER_WORDS + 2), record[0]);
+    EXPECT_EQ((uint32_t)(uintptr_t)test_format, record[1]);
+    EXPECT_EQ(first, record[3]);
+    EXPECT_EQ(second, record[4]);
+  }
+};
+
+// Test case: A record holds the format string address, the timestamp and the raw argument words
+TEST_F(sl_debug_log_deferred_test, RecordCapturesArguments)
+{
+  timestamp = 42;
+  sl_debug_log_deferred(test_format, 7u, 0xFFFFFFFFu);
+
+  EXPECT_EQ(1u, sl_debug_log_deferred_flush());
+  ASSERT_EQ(1u, records.size());
+  expect_record(records[0], 7, 0xFFFFFFFF);
+  EXPECT_EQ(42u, records[0][2]);
+  EXPECT_EQ(0u, sl_debug_log_deferred_flush());
+}
+
+// Test case: Arguments past the record limit are left out and the record is flagged truncated
+TEST_F(sl_debug_log_deferred_test, ExtraArgumentsAreTruncated)
+{
+  sl_debug_log_deferred(wide_format, 1u, 2u, 3u, 4u, 5u);
+
+  EXPECT_EQ(1u, sl_debug_log_deferred_flush());
+  ASSERT_EQ(1u, records.size());
+  ASSERT_EQ(HEADER_WORDS + SL_DEBUG_LOG_DEFERRED_MAX_ARG_WORDS, records[0].size());
+  EXPECT_EQ(RECORD_MAGIC | RECORD_TRUNCATED | (SL_DEBUG_LOG_DEFERRED_MAX_ARG_WORDS << 8)
+              | (HEADER_WORDS + SL_DEBUG_LOG_DEFERRED_MAX_ARG_WORDS),
+            records[0][0]);
+  for (uint32_t i = 0; i < SL_DEBUG_LOG_DEFERRED_MAX_ARG_WORDS; i++) {
+    EXPECT_EQ(i + 1, records[0][HEADER_WORDS + i]);
+  }
+}
+
+// Test case: Records that wrap past the end of the buffer come out whole and in order
+TEST_F(sl_debug_log_deferred_test, RecordsWrapAroundTheBuffer)
+{
+  // Five word records do not divide the buffer, so records straddle its end at different offsets
+  const uint32_t per_round = (SL_DEBUG_LOG_DEFERRED_BUFFER_WORDS / (HEADER_WORDS + 2)) - 1;
+
+  for (uint32_t round = 0; round < 4; round++) {
+    records.clear();
+    for (uint32_t n = 0; n < per_round; n++) {
+      sl_debug_log_deferred(test_format, round, n);
+    }
+    EXPECT_EQ(per_round, sl_debug_log_deferred_flush());
+    ASSERT_EQ(per_round, records.size());
+    for (uint32_t n = 0; n < per_round; n++) {
+      expect_record(records[n], round, n);
+    }
+  }
+  EXPECT_EQ(0u, dropped());
+}
+
+// Test case: A record that does not fit is dropped and counted, and the space is usable again once drained
+TEST_F(sl_debug_log_deferred_test, OverflowDropsAndCountsRecords)
+{
+  const uint32_t fitting = SL_DEBUG_LOG_DEFERRED_BUFFER_WORDS / (HEADER_WORDS + 2);
+
+  for (uint32_t n = 0; n < fitting + 3; n++) {
+    sl_debug_log_deferred(test_format, 0u, n);
+  }
+  EXPECT_EQ(3u, dropped());
+
+  // The words left over still take a record that fits in them
+  const uint32_t spare = SL_DEBUG_LOG_DEFERRED_BUFFER_WORDS - fitting * (HEADER_WORDS + 2);
+  ASSERT_GE(spare, (uint32_t)HEADER_WORDS);
+  sl_debug_log_deferred("spare");
+  EXPECT_EQ(3u, dropped());
+
+  EXPECT_EQ(fitting + 1, sl_debug_log_deferred_flush());
+  for (uint32_t n = 0; n < fitting; n++) {
+    expect_record(records[n], 0, n);
+  }
+
+  sl_debug_log_deferred(test_format, 1u, 0u);
+  EXPECT_EQ(1u, sl_debug_log_deferred_flush());
+  EXPECT_EQ(3u, dropped());
+}
+
+// Test case: Records of concurrent producers are never torn, each producer's records stay in order and
+// every record is either delivered or counted as dropped
+TEST_F(sl_debug_log_deferred_test, ConcurrentProducersKeepOrder)
+{
+  const uint32_t producers    = 4;
+  const uint32_t per_producer = 20000;
+  std::atomic<uint32_t> running(producers);
+  std::vector<std::thread> threads;
+  uint32_t drained = 0;
+
+  for (uint32_t id = 0; id < producers; id++) {
+    threads.emplace_back([&running, id, per_producer] {
+      for (uint32_t sequence = 0; sequence < per_producer; sequence++) {
+        sl_debug_log_deferred(producer_format, id, sequence);
+      }
+      running--;
+    });
+  }
+  while (running > 0) {
+    drained += sl_debug_log_deferred_flush();
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  drained += sl_debug_log_deferred_flush();
+
+  std::vector<int64_t> last(producers, -1);
+  ASSERT_GT(drained, 0u);
+  ASSERT_EQ(drained, records.size());
+  for (const std::vector<uint32_t> &record : records) {
+    ASSERT_EQ(HEADER_WORDS + 2u, record.size());
+    ASSERT_EQ(RECORD_MAGIC | (2 << 8) | (HEADER_WORDS + 2), record[0]);
+    ASSERT_EQ((uint32_t)(uintptr_t)producer_format, record[1]);
+    uint32_t id = record[3];
+    ASSERT_LT(id, producers);
+    EXPECT_GT((int64_t)record[4], last[id]);
+    last[id] = record[4];
+  }
+  EXPECT_EQ(producers * per_producer, drained + dropped());
+}
@@ -39,6 +39,12 @@
 /// @note This is not a configurable value.
 #define SL_WIFI_MAX_SCANNED_AP 11
 
+/// Maximum number of Access Points kept by the host for a @ref SL_WIFI_SCAN_TYPE_EXTENDED scan.
+/// @note Define it in the project configuration to override the default; the valid range is 1 to 254.
+#ifndef SL_WIFI_EXTENDED_SCAN_MAX_RESULTS
+#define SL_WIFI_EXTENDED_SCAN_MAX_RESULTS 64
+#endif
+
 /**
   * @def SL_WIFI_MAX_SSID_LENGTH
   * @brief Defines the maximum length of a Wi-Fi SSID.
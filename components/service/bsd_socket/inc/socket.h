@@ -130,6 +130,25 @@ typedef	__sa_family_t	sa_family_t;	/* sockaddr address family type */
 #define SL_SO_SOCK_VAP_ID              0x102B  ///< Sets the VAP ID for a socket.
 #define SL_SO_MAXRETRY                 0x102C  ///< Sets the maximum number of retries for a socket.
 #define SL_SO_VERIFY_DOMAIN_NAME       0x102D  ///< Sets expected domain name for TLS certificate verification.
+#define SL_SO_TX_WEIGHT                0x102E  ///< Sets the TX scheduling weight (uint8_t, 1 to SL_SI91X_SOCKET_TX_MAX_WEIGHT) of a socket.
+#define SL_SO_TX_PRIORITY              0x102F  ///< Sets the TX priority class (uint8_t, SL_SI91X_SOCKET_TX_PRIORITY_*) of a socket.
+#define SL_SO_TX_STATISTICS            0x1030  ///< Gets the transmit counters (sl_si91x_socket_tx_statistics_t) of a socket.
+#define SL_SO_RCV_READ_AHEAD           0x1031  ///< Sets the host receive read-ahead window (uint16_t bytes, 0 disables) of a stream socket.
+#define SL_SO_TCP_NODELAY              0x1032  ///< Sends each write of a stream socket as its own frame (uint8_t, 1 by default), 0 appends small writes to a queued frame.
+#define SL_SO_TCP_CORK                 0x1033  ///< Holds partly filled frames of a stream socket until they reach the MSS or the flush timeout expires (uint8_t).
+/** @} */
+
+/**
+ * @addtogroup BSD_SOCKET_MESSAGE_FLAGS Socket Message Flags
+ * @ingroup BSD_SOCKET_FUNCTIONS
+ * @{ 
+ */
+#ifndef MSG_PEEK
+#define	MSG_PEEK	0x2		///< Returns buffered stream data without removing it from the socket.
+#endif
+#ifndef MSG_WAITALL
+#define	MSG_WAITALL	0x40		///< Blocks until the full request is satisfied, the peer closes, or the read times out.
+#endif
 /** @} */
 
 /*
@@ -256,6 +275,40 @@ struct sockaddr_storage {
 	unsigned char	__ss_pad3[240];	///< Pad to a total of 256 bytes. 
 };
 
+/**
+ * @addtogroup BSD_SOCKET_FUNCTIONS
+ * @{ 
+ */
+/**
+ * @struct msghdr
+ * @brief 
+ *     Message header for @ref sendmsg() and @ref sendmmsg().
+ * 
+ * @details
+ *     Describes the destination of a message and the buffers whose contents make up its payload, in order.
+ *     Ancillary data is not supported, `msg_control` and `msg_controllen` are ignored.
+ */
+struct msghdr {
+	void		*msg_name;	///< Optional destination address, used like the `to_addr` argument of @ref sendto().
+	socklen_t	msg_namelen;	///< Size of the address pointed to by `msg_name`, in bytes.
+	struct		iovec *msg_iov;	///< Array of buffers gathered into the payload.
+	unsigned int	msg_iovlen;	///< Number of entries in `msg_iov`.
+	void		*msg_control;	///< Ancillary data, not supported.
+	socklen_t	msg_controllen;	///< Length of the ancillary data buffer, not supported.
+	int		msg_flags;	///< Flags on received message, not used when sending.
+};
+
+/**
+ * @struct mmsghdr
+ * @brief 
+ *     One message of a @ref sendmmsg() batch.
+ */
+struct mmsghdr {
+	struct msghdr	msg_hdr;	///< Message to send.
+	unsigned int	msg_len;	///< Number of bytes sent for this message, set by @ref sendmmsg().
+};
+/** @} */
+
 /* __BEGIN_DECLS */
 
 /**
@@ -440,13 +493,14 @@ int connect(int socket_id, const struct sockaddr *addr, socklen_t addr_len);
  *   Length of the buffer pointed to by the `buf` parameter.
  * 
  * @param[in] flags
- *   Controls the reception of the data. Currently, no flags are supported and this parameter should be set to 0.
+ *   Controls the reception of the data. Accepts values from @ref BSD_SOCKET_MESSAGE_FLAGS, or 0.
  * 
  * @return
  *   ssize_t
  * 
  * @note 
- *   The @ref recv() system call does not support any flags.
+ *   @ref MSG_PEEK and @ref MSG_WAITALL are supported on stream sockets only. They are served from the host receive ring,
+ *   which also serves every read once read-ahead is enabled with @ref SL_SO_RCV_READ_AHEAD.
  ******************************************************************************/
 ssize_t recv(int socket_id, void *buf, size_t buf_len, int flags);
 
@@ -470,7 +524,7 @@ ssize_t recv(int socket_id, void *buf, size_t buf_len, int flags);
  *   The length of the buffer pointed to by the `buf` parameter, in bytes.
  * 
  * @param[in] flags
- *   Controls the reception of the data. Currently, no flags are supported and this parameter should be set to 0.
+ *   Controls the reception of the data. Accepts values from @ref BSD_SOCKET_MESSAGE_FLAGS, or 0.
  * 
  * @param[out] from_addr 
  *   Pointer to a socket address structure of type @ref sockaddr that will be filled with the source address of the received message. 
@@ -484,10 +538,36 @@ ssize_t recv(int socket_id, void *buf, size_t buf_len, int flags);
  *   Returns the length of the message on successful completion. Returns -1 on error and sets the global variable `errno` to indicate the error.
  * 
  * @note 
- *   The @ref recvfrom() system call does not support any flags.
+ *   @ref MSG_PEEK and @ref MSG_WAITALL are supported on stream sockets only, see @ref recv().
  ******************************************************************************/
 ssize_t recvfrom(int socket_id, void *buf, size_t buf_len, int flags, struct sockaddr *from_addr, socklen_t *from_addr_len);
 
+/***************************************************************************/ 
+/**
+ * @brief
+ *   Read data from a connected stream socket into multiple buffers.
+ * 
+ * @details
+ *   The @ref readv() function fills the buffers described by `iov` in order, like a single @ref recv() into their combined length.
+ *   At most one read request is sent to the firmware. When that request returns less than the combined length, the remaining buffers are left untouched.
+ * 
+ * @param[in] socket_id
+ *   The socket ID or file descriptor for the specified socket.
+ * 
+ * @param[in] iov
+ *   Array of @ref iovec structures describing the buffers to fill.
+ * 
+ * @param[in] iovcnt
+ *   Number of entries in `iov`.
+ * 
+ * @return
+ *   Returns the number of bytes read. Returns -1 on error and sets the global variable `errno` to indicate the error.
+ * 
+ * @note 
+ *   Only stream sockets are supported. The read goes through the host receive ring, see @ref SL_SO_RCV_READ_AHEAD.
+ ******************************************************************************/
+ssize_t readv(int socket_id, const struct iovec *iov, int iovcnt);
+
 /***************************************************************************/ 
 /**
  * @brief
@@ -562,6 +642,64 @@ ssize_t send(int socket_id, const void *buf, size_t buf_len, int flags);
  ******************************************************************************/
 ssize_t sendto(int socket_id, const void *buf, size_t buf_len, int flags, const struct sockaddr *to_addr, socklen_t to_addr_len);
 
+/***************************************************************************/ 
+/**
+ * @brief
+ *   Send a message gathered from multiple buffers on a socket.
+ * 
+ * @details
+ *   The @ref sendmsg() function sends the buffers described by `message->msg_iov` in order, like a single @ref sendto() of their combined length.
+ *   The buffers are copied straight into the transmit frame behind the request header, so callers do not have to assemble the payload first.
+ * 
+ * @param[in] socket_id
+ *   The socket ID or file descriptor for the specified socket.
+ * 
+ * @param[in] message
+ *   Pointer to a @ref msghdr structure describing the destination and the payload. `msg_name` and `msg_namelen` are used like `to_addr` and `to_addr_len` of @ref sendto().
+ * 
+ * @param[in] flags
+ *   Controls the transmission of the data. No flags are supported and this parameter should be set to 0.
+ * 
+ * @return
+ *   Returns the number of bytes sent on success. Returns -1 on error and sets the global variable `errno` to indicate the error.
+ * 
+ * @note 
+ *   - The combined length is limited like that of @ref sendto(), a longer message fails with `EMSGSIZE`.
+ *   - WebSocket sockets are not supported.
+ ******************************************************************************/
+ssize_t sendmsg(int socket_id, const struct msghdr *message, int flags);
+
+/***************************************************************************/ 
+/**
+ * @brief
+ *   Send multiple messages on a socket.
+ * 
+ * @details
+ *   The @ref sendmmsg() function sends each message of `messages` like @ref sendmsg(). All frames are built before any of them is queued, 
+ *   and they are handed to the socket transmit queue together, with one critical section and one wakeup of the transmit path.
+ *   The frames are queued early only when the socket runs out of transmit buffers, so the batch never waits for buffers held by its own frames.
+ * 
+ * @param[in] socket_id
+ *   The socket ID or file descriptor for the specified socket.
+ * 
+ * @param[in,out] messages
+ *   Array of @ref mmsghdr structures. The `msg_len` field of each message sent is set to the number of bytes sent.
+ * 
+ * @param[in] count
+ *   Number of entries in `messages`.
+ * 
+ * @param[in] flags
+ *   Controls the transmission of the data. No flags are supported and this parameter should be set to 0.
+ * 
+ * @return
+ *   Returns the number of messages sent. If an error occurs before any message is sent, returns -1 and sets the global variable `errno` to indicate the error.
+ * 
+ * @note 
+ *   - Stream sockets that append small writes to queued frames, see @ref SL_SO_TCP_NODELAY, send each message through the regular send path instead.
+ *   - WebSocket sockets are not supported.
+ ******************************************************************************/
+int sendmmsg(int socket_id, struct mmsghdr *messages, unsigned int count, int flags);
+
 /***************************************************************************/ 
 /**
  * @brief
@@ -594,6 +732,11 @@ ssize_t sendto(int socket_id, const void *buf, size_t buf_len, int flags, const
  *   - @ref SL_SO_TLS_SNI
  *   - @ref SL_SO_TLS_ALPN
  *   - @ref SL_SO_VERIFY_DOMAIN_NAME
+ *   - @ref SL_SO_TX_WEIGHT
+ *   - @ref SL_SO_TX_PRIORITY
+ *   - @ref SL_SO_RCV_READ_AHEAD
+ *   - @ref SL_SO_TCP_NODELAY
+ *   - @ref SL_SO_TCP_CORK
  *  
  * @param[in] option_value
  *   A pointer to the buffer containing the value for the option. Most socket-level options utilize an `int` argument for `option_value`. 
@@ -611,6 +754,11 @@ ssize_t sendto(int socket_id, const void *buf, size_t buf_len, int flags, const
  *   | @ref SL_SO_TLS_SNI                                | sl_si91x_socket_type_length_value_t  | Server name indication for the socket                                                                                      |
  *   | @ref SL_SO_TLS_ALPN                               | sl_si91x_socket_type_length_value_t  | Application layer protocol negotiation for the socket                                                                      |
  *   | @ref SL_SO_VERIFY_DOMAIN_NAME                     | uint8_t *                            | Expected domain name for TLS certificate verification; firmware uses this for server certificate CN/SAN check.             |
+ *   | @ref SL_SO_TX_WEIGHT                              | uint8_t                              | Share of the bus given to this socket relative to other sockets of the same TX priority class, 1 to 16                     |
+ *   | @ref SL_SO_TX_PRIORITY                            | uint8_t                              | TX priority class, one of SL_SI91X_SOCKET_TX_PRIORITY_LOW, _NORMAL (default) or _HIGH                                      |
+ *   | @ref SL_SO_RCV_READ_AHEAD                         | uint16_t                             | Host receive read-ahead window of a stream socket in bytes, 0 disables read-ahead. Fails with EBUSY while data is buffered |
+ *   | @ref SL_SO_TCP_NODELAY                            | uint8_t                              | 1 (default) sends each write as its own frame, 0 appends small writes to a frame still queued behind another one           |
+ *   | @ref SL_SO_TCP_CORK                               | uint8_t                              | 1 holds partly filled frames until they reach the MSS or SL_SI91X_SOCKET_CORK_FLUSH_TIMEOUT_MS expires, 0 sends them now   |
  * 
  * @param[in] option_length
  *   The length of the option data, in bytes, pointed to by `option_value`.
@@ -665,6 +813,9 @@ int setsockopt(int socket_id, int option_level, int option_name, const void *opt
  *   - `TCP_ULP`: TCP upper layer protocol.
  *   - `SO_MAX_RETRANSMISSION_TIMEOUT_VALUE`: Maximum retransmission timeout value.
  *   - `IP_TOS`: Type of service.
+ *   - `SL_SO_TX_STATISTICS`: Transmit counters, including the writes saved by `SL_SO_TCP_NODELAY` and `SL_SO_TCP_CORK`.
+ *   - `SL_SO_TCP_NODELAY`: Whether each write is sent as its own frame.
+ *   - `SL_SO_TCP_CORK`: Whether partly filled frames are held back.
  ******************************************************************************/
 int getsockopt(int socket_id, int option_level, int option_name, void *option_value, socklen_t *option_length);
 
@@ -378,25 +378,15 @@ ssize_t recv(int socket_id, void *buf, size_t buf_len, int flags)
   return recvfrom(socket_id, buf, buf_len, flags, NULL, NULL);
 }
 
-ssize_t sendto(int socket_id,
-               const void *data,
-               size_t data_len,
-               int flags,
-               const struct sockaddr *to_addr,
-               socklen_t to_addr_len)
+// Validate the destination of a send and fill the request header for data_len bytes of payload
+static int sli_build_send_request(sli_si91x_socket_t *si91x_socket,
+                                  int socket_id,
+                                  size_t data_len,
+                                  const struct sockaddr *to_addr,
+                                  socklen_t to_addr_len,
+                                  sli_si91x_socket_send_request_t *request)
 {
-  // Initialize variables and error handling
-  UNUSED_PARAMETER(flags);
-  errno = 0;
-
-  sl_status_t status                      = SL_STATUS_OK;
-  sli_si91x_socket_t *si91x_socket        = sli_get_si91x_socket(socket_id);
-  sli_si91x_socket_send_request_t request = { 0 };
-
-  // Check for various error conditions
-  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
-  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type == SOCK_STREAM && si91x_socket->state != CONNECTED, ENOTCONN);
-  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(!(si91x_socket->ssl_bitmap & SLI_SI91X_WEBSOCKET_FEAT) && data == NULL, EFAULT);
+  sl_status_t status = SL_STATUS_OK;
 
   SLI_SET_ERRNO_AND_RETURN_IF_TRUE(data_len > (size_t)sl_si91x_get_socket_mss(socket_id), EMSGSIZE);
 
@@ -418,8 +408,8 @@ ssize_t sendto(int socket_id,
   // create a socket send request
   if (si91x_socket->local_address.sin6_family == AF_INET6) {
     const struct sockaddr_in6 *socket_address = (const struct sockaddr_in6 *)to_addr;
-    request.ip_version                        = SL_IPV6_VERSION;
-    request.data_offset = (si91x_socket->type == SOCK_STREAM) ? SLI_TCP_V6_HEADER_LENGTH : SLI_UDP_V6_HEADER_LENGTH;
+    request->ip_version                       = SL_IPV6_VERSION;
+    request->data_offset = (si91x_socket->type == SOCK_STREAM) ? SLI_TCP_V6_HEADER_LENGTH : SLI_UDP_V6_HEADER_LENGTH;
     const uint8_t *destination_ip =
       (si91x_socket->state == UDP_UNCONNECTED_READY || to_addr_len >= sizeof(struct sockaddr_in6))
 #ifndef __ZEPHYR__
@@ -430,11 +420,11 @@ ssize_t sendto(int socket_id,
         : si91x_socket->remote_address.sin6_addr.s6_addr;
 #endif
 
-    memcpy(request.dest_ip_addr.ipv6_address, destination_ip, SL_IPV6_ADDRESS_LENGTH);
+    memcpy(request->dest_ip_addr.ipv6_address, destination_ip, SL_IPV6_ADDRESS_LENGTH);
   } else {
     const struct sockaddr_in *socket_address = (const struct sockaddr_in *)to_addr;
-    request.ip_version                       = SL_IPV4_VERSION;
-    request.data_offset = (si91x_socket->type == SOCK_STREAM) ? SLI_TCP_HEADER_LENGTH : SLI_UDP_HEADER_LENGTH;
+    request->ip_version                      = SL_IPV4_VERSION;
+    request->data_offset = (si91x_socket->type == SOCK_STREAM) ? SLI_TCP_HEADER_LENGTH : SLI_UDP_HEADER_LENGTH;
     const uint32_t *destination_ip =
       (si91x_socket->state == UDP_UNCONNECTED_READY || to_addr_len >= sizeof(struct sockaddr_in))
         ? &socket_address->sin_addr.s_addr
@@ -444,7 +434,7 @@ ssize_t sendto(int socket_id,
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Warray-bounds"
 #endif // __GNUC__
-    memcpy(request.dest_ip_addr.ipv4_address, destination_ip, SL_IPV4_ADDRESS_LENGTH);
+    memcpy(request->dest_ip_addr.ipv4_address, destination_ip, SL_IPV4_ADDRESS_LENGTH);
 #if defined(__GNUC__)
 #pragma GCC diagnostic pop
 #endif // __GNUC__
@@ -453,15 +443,42 @@ ssize_t sendto(int socket_id,
   // Set other parameters in the request structure
   // Check for Websocket feature bit
   if (si91x_socket->ssl_bitmap & SLI_SI91X_WEBSOCKET_FEAT) {
-    sli_si91x_set_websocket_offset(&request, data_len);
+    sli_si91x_set_websocket_offset(request, data_len);
   }
   // Set the socket_id with both the socket ID and the opcode of WebSocket in one line
-  request.socket_id = (uint16_t)((si91x_socket->id & 0x00FF) | ((uint16_t)(si91x_socket->opcode & 0xFF) << 8));
+  request->socket_id = (uint16_t)((si91x_socket->id & 0x00FF) | ((uint16_t)(si91x_socket->opcode & 0xFF) << 8));
+
+  request->dest_port = (si91x_socket->state == UDP_UNCONNECTED_READY || to_addr_len > 0)
+                         ? ((const struct sockaddr_in *)to_addr)->sin_port
+                         : si91x_socket->remote_address.sin6_port;
+  request->length    = data_len;
+
+  return 0;
+}
 
-  request.dest_port = (si91x_socket->state == UDP_UNCONNECTED_READY || to_addr_len > 0)
-                        ? ((const struct sockaddr_in *)to_addr)->sin_port
-                        : si91x_socket->remote_address.sin6_port;
-  request.length    = data_len;
+ssize_t sendto(int socket_id,
+               const void *data,
+               size_t data_len,
+               int flags,
+               const struct sockaddr *to_addr,
+               socklen_t to_addr_len)
+{
+  // Initialize variables and error handling
+  UNUSED_PARAMETER(flags);
+  errno = 0;
+
+  sl_status_t status                      = SL_STATUS_OK;
+  sli_si91x_socket_t *si91x_socket        = sli_get_si91x_socket(socket_id);
+  sli_si91x_socket_send_request_t request = { 0 };
+
+  // Check for various error conditions
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type == SOCK_STREAM && si91x_socket->state != CONNECTED, ENOTCONN);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(!(si91x_socket->ssl_bitmap & SLI_SI91X_WEBSOCKET_FEAT) && data == NULL, EFAULT);
+
+  if (sli_build_send_request(si91x_socket, socket_id, data_len, to_addr, to_addr_len, &request) < 0) {
+    return -1;
+  }
 
   // Send the socket data request
   status = sli_si91x_send_socket_data(si91x_socket, &request, data);
@@ -470,6 +487,112 @@ ssize_t sendto(int socket_id,
   return data_len;
 }
 
+// Validate a gather array and return the combined length of its buffers
+static int sli_get_iov_length(const struct iovec *iov, int iovcnt, size_t *length)
+{
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE((iov == NULL) && (iovcnt != 0), EFAULT);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(iovcnt < 0, EINVAL);
+
+  *length = 0;
+  for (int i = 0; i < iovcnt; i++) {
+    SLI_SET_ERRNO_AND_RETURN_IF_TRUE((iov[i].iov_base == NULL) && (iov[i].iov_len != 0), EFAULT);
+    *length += iov[i].iov_len;
+  }
+  return 0;
+}
+
+ssize_t sendmsg(int socket_id, const struct msghdr *message, int flags)
+{
+  UNUSED_PARAMETER(flags);
+  errno = 0;
+
+  sl_status_t status                      = SL_STATUS_OK;
+  sli_si91x_socket_t *si91x_socket        = sli_get_si91x_socket(socket_id);
+  sli_si91x_socket_send_request_t request = { 0 };
+  size_t data_len                         = 0;
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type == SOCK_STREAM && si91x_socket->state != CONNECTED, ENOTCONN);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(message == NULL, EFAULT);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->ssl_bitmap & SLI_SI91X_WEBSOCKET_FEAT, EOPNOTSUPP);
+
+  if ((sli_get_iov_length(message->msg_iov, (int)message->msg_iovlen, &data_len) < 0)
+      || (sli_build_send_request(si91x_socket,
+                                 socket_id,
+                                 data_len,
+                                 (const struct sockaddr *)message->msg_name,
+                                 message->msg_namelen,
+                                 &request)
+          < 0)) {
+    return -1;
+  }
+
+  // The fragments are gathered straight into the frame behind the request header
+  status = sli_si91x_send_socket_data_vector(si91x_socket, &request, message->msg_iov, (int)message->msg_iovlen);
+  SLI_SOCKET_VERIFY_STATUS_AND_RETURN(status, SL_STATUS_OK, ENOBUFS);
+
+  return data_len;
+}
+
+#ifndef __ZEPHYR__
+int sendmmsg(int socket_id, struct mmsghdr *messages, unsigned int count, int flags)
+{
+  UNUSED_PARAMETER(flags);
+  errno = 0;
+
+  sl_status_t status                      = SL_STATUS_OK;
+  sli_si91x_socket_t *si91x_socket        = sli_get_si91x_socket(socket_id);
+  sli_si91x_socket_send_request_t request = { 0 };
+  sli_si91x_socket_send_batch_t batch;
+  unsigned int sent = 0;
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type == SOCK_STREAM && si91x_socket->state != CONNECTED, ENOTCONN);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE((messages == NULL) && (count != 0), EFAULT);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->ssl_bitmap & SLI_SI91X_WEBSOCKET_FEAT, EOPNOTSUPP);
+
+  // Frames are built outside of any critical section and handed to the socket queue together, unless the socket
+  // appends small writes to queued frames, in which case each message goes through the regular send path
+  const bool coalesce = sli_si91x_socket_coalesces_writes(si91x_socket);
+  sli_si91x_socket_batch_init(&batch, si91x_socket, true);
+
+  for (; sent < count; sent++) {
+    const struct msghdr *message = &messages[sent].msg_hdr;
+    size_t data_len              = 0;
+
+    memset(&request, 0, sizeof(request));
+    if ((sli_get_iov_length(message->msg_iov, (int)message->msg_iovlen, &data_len) < 0)
+        || (sli_build_send_request(si91x_socket,
+                                   socket_id,
+                                   data_len,
+                                   (const struct sockaddr *)message->msg_name,
+                                   message->msg_namelen,
+                                   &request)
+            < 0)) {
+      break;
+    }
+
+    if (coalesce) {
+      status = sli_si91x_send_socket_data_vector(si91x_socket, &request, message->msg_iov, (int)message->msg_iovlen);
+    } else {
+      status = sli_si91x_socket_batch_add(&batch, &request, message->msg_iov, (int)message->msg_iovlen);
+    }
+    if (status != SL_STATUS_OK) {
+      errno = ENOBUFS;
+      break;
+    }
+    messages[sent].msg_len = (unsigned int)data_len;
+  }
+  sli_si91x_socket_batch_flush(&batch);
+
+  // Like sendmmsg() elsewhere, an error is only reported if no message was sent
+  if (sent == 0 && count != 0) {
+    return -1;
+  }
+  return (int)sent;
+}
+#endif
+
 // Validate socket and input parameters, initialize UDP socket if necessary, and adjust buffer length
 static sl_status_t sli_prepare_socket(sli_si91x_socket_t *si91x_socket, int socket_id, const void *buf, size_t *buf_len)
 {
@@ -544,7 +667,7 @@ static void sli_populate_source_address(struct sockaddr *addr,
 
 ssize_t recvfrom(int socket_id, void *buf, size_t buf_len, int flags, struct sockaddr *addr, socklen_t *addr_len)
 {
-  UNUSED_PARAMETER(flags); // Ignoring the 'flags' parameter
+  size_t requested_length          = buf_len;
   sli_wifi_wait_period_t wait_time = 0;
   errno                            = 0;
 
@@ -567,6 +690,16 @@ ssize_t recvfrom(int socket_id, void *buf, size_t buf_len, int flags, struct soc
   SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->state != CONNECTED && si91x_socket->state != UDP_UNCONNECTED_READY,
                                    EBADF);
 
+  // Stream data goes through the host receive ring when read-ahead is enabled or the flags need buffering
+  if ((si91x_socket->type == SOCK_STREAM)
+      && ((si91x_socket->rx_ring_size != 0) || ((flags & (MSG_PEEK | MSG_WAITALL)) != 0))) {
+    if ((addr != NULL) && (addr_len != NULL)) {
+      *addr_len = 0; // Not BSD compliant
+    }
+    return sli_si91x_socket_buffered_recv(si91x_socket, buf, requested_length, flags);
+  }
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE((flags & MSG_PEEK) != 0, EOPNOTSUPP);
+
   // Prepare the request
   request.socket_id = (uint8_t)si91x_socket->id;
   memcpy(request.requested_bytes, &buf_len, sizeof(buf_len));
@@ -602,6 +735,49 @@ ssize_t recvfrom(int socket_id, void *buf, size_t buf_len, int flags, struct soc
   return bytes_read;
 }
 
+ssize_t readv(int socket_id, const struct iovec *iov, int iovcnt)
+{
+  sli_si91x_socket_t *si91x_socket = sli_get_si91x_socket(socket_id);
+  size_t total                     = 0;
+  ssize_t bytes_read               = 0;
+  int first                        = 0;
+
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket == NULL, EBADF);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type != SOCK_STREAM, EOPNOTSUPP);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->state != CONNECTED, ENOTCONN);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE((iov == NULL) || (iovcnt <= 0), EINVAL);
+
+  for (int i = 0; i < iovcnt; i++) {
+    SLI_SET_ERRNO_AND_RETURN_IF_TRUE((iov[i].iov_base == NULL) && (iov[i].iov_len != 0), EFAULT);
+    total += iov[i].iov_len;
+  }
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(total == 0, EINVAL);
+
+  // The first non-empty buffer may block for data; the rest only take what that read left in the receive ring
+  while (iov[first].iov_len == 0) {
+    first++;
+  }
+  bytes_read = sli_si91x_socket_buffered_recv(si91x_socket, iov[first].iov_base, iov[first].iov_len, 0);
+  if ((bytes_read < 0) || ((size_t)bytes_read < iov[first].iov_len)) {
+    return bytes_read;
+  }
+
+  for (int i = first + 1; (i < iovcnt) && (si91x_socket->rx_ring_count > 0); i++) {
+    if (iov[i].iov_len == 0) {
+      continue;
+    }
+    ssize_t chunk = sli_si91x_socket_buffered_recv(si91x_socket, iov[i].iov_base, iov[i].iov_len, 0);
+    if (chunk <= 0) {
+      break;
+    }
+    bytes_read += chunk;
+    if ((size_t)chunk < iov[i].iov_len) {
+      break;
+    }
+  }
+  return bytes_read;
+}
+
 int getsockname(int socket_id, struct sockaddr *name, socklen_t *name_len)
 {
   return sli_si91x_get_sock_address(socket_id, name, name_len, SLI_SI91X_BSD_SOCKET_LOCAL_ADDRESS);
@@ -818,6 +994,72 @@ static int sli_handle_sl_so_verify_domain_name(sli_si91x_socket_t *si91x_socket,
   return SLI_SI91X_NO_ERROR;
 }
 
+static int sli_handle_sl_so_tx_weight(sli_si91x_socket_t *si91x_socket,
+                                      const void *option_value,
+                                      socklen_t option_length)
+{
+  // Set the share of the bus given to this socket within its TX priority class
+  if (option_length == sizeof(uint8_t)) {
+    const uint8_t weight = *(const uint8_t *)option_value;
+    SLI_SET_ERRNO_AND_RETURN_IF_TRUE((weight == 0) || (weight > SL_SI91X_SOCKET_TX_MAX_WEIGHT), EINVAL);
+    si91x_socket->tx_weight = weight;
+  } else {
+    errno = EINVAL;
+    return -1;
+  }
+  return SLI_SI91X_NO_ERROR;
+}
+
+static int sli_handle_sl_so_rcv_read_ahead(sli_si91x_socket_t *si91x_socket,
+                                           const void *option_value,
+                                           socklen_t option_length)
+{
+  // Set the host receive read-ahead window of a stream socket
+  if (option_length == sizeof(uint16_t)) {
+    uint16_t window = 0;
+    memcpy(&window, option_value, sizeof(window));
+    return sli_si91x_socket_set_read_ahead(si91x_socket, window);
+  }
+  errno = EINVAL;
+  return -1;
+}
+
+static int sli_handle_sl_so_tcp_nodelay(sli_si91x_socket_t *si91x_socket,
+                                        const void *option_value,
+                                        socklen_t option_length)
+{
+  // Send each write as its own frame, or append small writes to a frame still queued on the host
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(option_length != sizeof(uint8_t), EINVAL);
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(si91x_socket->type != SOCK_STREAM, EOPNOTSUPP);
+  si91x_socket->tx_nodelay = (*(const uint8_t *)option_value != 0);
+  return SLI_SI91X_NO_ERROR;
+}
+
+static int sli_handle_sl_so_tcp_cork(sli_si91x_socket_t *si91x_socket,
+                                     const void *option_value,
+                                     socklen_t option_length)
+{
+  // Hold partly filled frames back until they reach the MSS
+  SLI_SET_ERRNO_AND_RETURN_IF_TRUE(option_length != sizeof(uint8_t), EINVAL);
+  return sli_si91x_socket_set_cork(si91x_socket, *(const uint8_t *)option_value != 0);
+}
+
+static int sli_handle_sl_so_tx_priority(sli_si91x_socket_t *si91x_socket,
+                                        const void *option_value,
+                                        socklen_t option_length)
+{
+  // Set the TX priority class of the socket
+  if (option_length == sizeof(uint8_t)) {
+    const uint8_t priority = *(const uint8_t *)option_value;
+    SLI_SET_ERRNO_AND_RETURN_IF_TRUE(priority > SL_SI91X_SOCKET_TX_PRIORITY_HIGH, EINVAL);
+    si91x_socket->tx_priority = priority;
+  } else {
+    errno = EINVAL;
+    return -1;
+  }
+  return SLI_SI91X_NO_ERROR;
+}
+
 int setsockopt(int socket_id, int option_level, int option_name, const void *option_value, socklen_t option_length)
 {
   sli_si91x_socket_t *si91x_socket = sli_get_si91x_socket(socket_id);
@@ -866,6 +1108,21 @@ int setsockopt(int socket_id, int option_level, int option_name, const void *opt
     case SL_SO_VERIFY_DOMAIN_NAME:
       return sli_handle_sl_so_verify_domain_name(si91x_socket, option_value, option_length);
 
+    case SL_SO_TX_WEIGHT:
+      return sli_handle_sl_so_tx_weight(si91x_socket, option_value, option_length);
+
+    case SL_SO_TX_PRIORITY:
+      return sli_handle_sl_so_tx_priority(si91x_socket, option_value, option_length);
+
+    case SL_SO_RCV_READ_AHEAD:
+      return sli_handle_sl_so_rcv_read_ahead(si91x_socket, option_value, option_length);
+
+    case SL_SO_TCP_NODELAY:
+      return sli_handle_sl_so_tcp_nodelay(si91x_socket, option_value, option_length);
+
+    case SL_SO_TCP_CORK:
+      return sli_handle_sl_so_tcp_cork(si91x_socket, option_value, option_length);
+
     default: {
       // Unsupported option
       SLI_SET_ERROR_AND_RETURN(ENOPROTOOPT);
@@ -954,6 +1211,25 @@ int getsockopt(int socket_id, int option_level, int option_name, void *option_va
       break;
     }
 
+    case SL_SO_TX_STATISTICS: {
+      // Retrieve and copy the socket transmit counters
+      sl_si91x_socket_tx_statistics_t statistics = { .tx_bytes     = si91x_socket->tx_bytes,
+                                                     .tx_frames    = si91x_socket->tx_frames,
+                                                     .tx_coalesced = si91x_socket->tx_coalesced };
+      *option_length = SLI_GET_SAFE_MEMCPY_LENGTH(*option_length, sizeof(statistics));
+      memcpy(option_value, &statistics, *option_length);
+      break;
+    }
+
+    case SL_SO_TCP_NODELAY:
+    case SL_SO_TCP_CORK: {
+      // Retrieve whether writes are sent unmerged or held back by the cork
+      uint8_t enabled = (option_name == SL_SO_TCP_NODELAY) ? si91x_socket->tx_nodelay : si91x_socket->tx_cork;
+      *option_length  = SLI_GET_SAFE_MEMCPY_LENGTH(*option_length, sizeof(enabled));
+      memcpy(option_value, &enabled, *option_length);
+      break;
+    }
+
     default: {
       SLI_SET_ERROR_AND_RETURN(ENOPROTOOPT);
     }
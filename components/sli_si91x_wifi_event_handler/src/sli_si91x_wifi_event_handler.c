@@ -62,6 +62,7 @@
 #ifdef SLI_SI91X_OFFLOAD_NETWORK_STACK
 #include "sl_si91x_socket_types.h"
 #include "sl_si91x_socket_utility.h"
+#include "sl_si91x_socket_epoll.h"
 #include "sl_net_si91x_integration_handler.h"
 #else
 // This macro defines a handler for dispatching network events.
@@ -138,6 +139,24 @@ extern sli_wifi_buffer_queue_t sli_uart_bus_rx_queue;
 
 static uint16_t interrupt_status = 0;
 
+#ifndef SLI_SI91X_MCU_INTERFACE
+#if (SLI_SI91X_NWP_TX_CREDITS < 1) || (SLI_SI91X_NWP_TX_CREDITS > 255)
+#error "SLI_SI91X_NWP_TX_CREDITS must be between 1 and 255"
+#endif
+
+// Frames that may still be written per packet type before the interrupt status must be read again
+static uint8_t sli_wifi_tx_credits = 0;
+static uint8_t sli_ble_tx_credits  = 0;
+#endif
+
+static sl_si91x_bus_statistics_t sli_bus_statistics;
+
+// TX wake lock: keeps the NWP awake across a burst of frames in power save profiles
+static bool sli_wake_lock_held       = false;
+static bool sli_wake_lock_lingering  = false;
+static uint32_t sli_wake_lock_frames = 0;
+static uint32_t sli_wake_lock_expiry = 0;
+
 bool global_queue_block = false;
 
 // Define enum for wait times (can be represented with just 2 bits)
@@ -250,9 +269,26 @@ void sli_handle_wifi_events(const sli_si91x_queue_packet_t *data, sl_wifi_system
 
 #ifdef SLI_SI91X_OFFLOAD_NETWORK_STACK
 static sli_si91x_socket_t *get_socket_from_packet(sl_wifi_system_packet_t *socket_packet);
+
+// Outcome of one socket's turn in the socket data scheduler
+typedef enum {
+  SLI_SOCKET_TX_TURN_BUS_NOT_READY, // The bus stopped accepting frames, the turn resumes on the next pass
+  SLI_SOCKET_TX_TURN_SERVED,        // A socket of the class had its turn
+  SLI_SOCKET_TX_TURN_CLASS_IDLE,    // No socket of the class has data queued
+} sli_socket_tx_turn_t;
+
+static sli_socket_tx_turn_t sli_si91x_schedule_socket_data(uint8_t priority);
 #endif
 
 static bool sli_si91x_is_bus_ready(bool global_queue_block, uint8_t packet_type);
+
+static sl_status_t sli_si91x_read_interrupt_status(void);
+
+static sl_status_t sli_si91x_bus_wakeup(void);
+
+static void sli_si91x_bus_sleep(void);
+
+static void sli_si91x_wake_lock_release(void);
 void sli_si91x_process_common_events();
 void sli_si91x_process_wifi_events();
 void sli_si91x_process_network_events();
@@ -263,9 +299,96 @@ void sli_si91x_process_command_engine_status_events();
 void sli_si91x_process_ble_events();
 #endif
 
+static void sli_si91x_handle_wifi_event(sl_wifi_buffer_t *buffer);
+static void sli_si91x_handle_network_event(sl_wifi_buffer_t *buffer);
+static void sli_si91x_handle_socket_event(sl_wifi_buffer_t *buffer);
+#ifdef SLI_SI91X_OFFLOAD_NETWORK_STACK
+static void sli_si91x_handle_socket_data(uint8_t socket, sl_wifi_buffer_t *buffer);
+#endif
+#ifdef SLI_SI91X_ENABLE_BLE
+static void sli_si91x_handle_ble_event(sl_wifi_buffer_t *buffer);
+#endif
+
 /******************************************************
  *             Static Function Definitions
  ******************************************************/
+// Wakes the NWP for a bus transaction, unless the TX wake lock already holds it awake
+static sl_status_t sli_si91x_bus_wakeup(void)
+{
+  if ((current_performance_profile == HIGH_PERFORMANCE) || sli_wake_lock_held) {
+    return SL_STATUS_OK;
+  }
+  return sli_si91x_req_wakeup();
+}
+
+// Lets the NWP sleep after a bus transaction, unless the TX wake lock is held
+static void sli_si91x_bus_sleep(void)
+{
+  if ((current_performance_profile != HIGH_PERFORMANCE) && !sli_wake_lock_held) {
+    sl_si91x_host_clear_sleep_indicator();
+  }
+}
+
+// Wakes the NWP once for a whole TX burst; frames written while the lock is held skip the wakeup handshake
+static void sli_si91x_wake_lock_acquire(void)
+{
+  if (current_performance_profile == HIGH_PERFORMANCE) {
+    return;
+  }
+  if (!sli_wake_lock_held) {
+    if (sli_si91x_req_wakeup() != SL_STATUS_OK) {
+      // Fall back to a wakeup per frame
+      return;
+    }
+    sli_wake_lock_held   = true;
+    sli_wake_lock_frames = 0;
+  }
+  sli_wake_lock_lingering = false;
+}
+
+static void sli_si91x_wake_lock_release(void)
+{
+  sli_wake_lock_held      = false;
+  sli_wake_lock_lingering = false;
+  sl_si91x_host_clear_sleep_indicator();
+}
+
+// True once the burst under the held wake lock wrote SLI_SI91X_WAKE_LOCK_TX_BUDGET frames
+static bool sli_si91x_wake_lock_budget_spent(void)
+{
+  return sli_wake_lock_held && (sli_wake_lock_frames >= SLI_SI91X_WAKE_LOCK_TX_BUDGET);
+}
+
+/*
+ * Called after each TX pass. A pass stops writing as soon as the burst used up SLI_SI91X_WAKE_LOCK_TX_BUDGET
+ * frames, and the lock is then released so the NWP may sleep before the next pass wakes it again. The lock is
+ * also released when the queues are blocked. When every TX queue is drained the lock lingers for SLI_SI91X_WAKE_LOCK_LINGER_MS,
+ * so back-to-back sends from the application reuse the same wakeup.
+ */
+static void sli_si91x_wake_lock_update(uint32_t event)
+{
+  if (!sli_wake_lock_held) {
+    return;
+  }
+  if (sli_si91x_wake_lock_budget_spent() || global_queue_block) {
+    sli_si91x_wake_lock_release();
+  } else if (!(event & SL_SI91X_ALL_TX_PENDING_COMMAND_EVENTS)) {
+    if (!sli_wake_lock_lingering) {
+      sli_wake_lock_lingering = true;
+      sli_wake_lock_expiry    = osKernelGetTickCount() + SLI_SYSTEM_MS_TO_TICKS(SLI_SI91X_WAKE_LOCK_LINGER_MS);
+    }
+  } else {
+    sli_wake_lock_lingering = false;
+  }
+}
+
+// Ticks left before a lingering wake lock has to be released, 0 once it expired
+static uint32_t sli_si91x_wake_lock_remaining_ticks(void)
+{
+  int32_t remaining = (int32_t)(sli_wake_lock_expiry - osKernelGetTickCount());
+  return (remaining > 0) ? (uint32_t)remaining : 0;
+}
+
 static sl_status_t bus_write_frame(sli_wifi_command_queue_t *queue,
                                    sli_wifi_command_type_t command_type,
                                    sl_wifi_buffer_type_t buffer_type,
@@ -279,16 +402,14 @@ static sl_status_t bus_write_frame(sli_wifi_command_queue_t *queue,
   sli_si91x_queue_packet_t *node = NULL;
 
   // Wake up the device if not in high performance mode
-  if ((current_performance_profile != HIGH_PERFORMANCE) && (sli_si91x_req_wakeup() != SL_STATUS_OK)) {
+  if (sli_si91x_bus_wakeup() != SL_STATUS_OK) {
     return SL_STATUS_TIMEOUT;
   }
 
   // Remove a buffer from the TX queue
   status = sli_si91x_remove_from_queue(&queue->tx_queue, &buffer);
   if (status != SL_STATUS_OK) {
-    if (current_performance_profile != HIGH_PERFORMANCE) {
-      sl_si91x_host_clear_sleep_indicator();
-    }
+    sli_si91x_bus_sleep();
     VERIFY_STATUS_AND_RETURN(status);
   }
 
@@ -330,6 +451,9 @@ static sl_status_t bus_write_frame(sli_wifi_command_queue_t *queue,
 
   // Write the frame to the bus using packet data and length
   status = sli_si91x_bus_write_frame(packet, packet->data, length);
+  sli_bus_statistics.frames_written++;
+  sli_bus_statistics.payload_bytes += length;
+  sli_wake_lock_frames++;
 
 #ifdef SLI_SI91X_MCU_INTERFACE
   sli_si91x_update_tx_command_status(false);
@@ -392,9 +516,7 @@ static sl_status_t bus_write_frame(sli_wifi_command_queue_t *queue,
   }
 
   // Clear the sleep indicator if the current performance profile is not high performance
-  if (current_performance_profile != HIGH_PERFORMANCE) {
-    sl_si91x_host_clear_sleep_indicator();
-  }
+  sli_si91x_bus_sleep();
   return status;
 }
 
@@ -405,15 +527,13 @@ static sl_status_t bus_write_data_frame(sli_wifi_buffer_queue_t *queue)
   sl_wifi_buffer_t *buffer;
   sl_wifi_system_packet_t *packet;
 
-  if ((current_performance_profile != HIGH_PERFORMANCE) && (sli_si91x_req_wakeup() != SL_STATUS_OK)) {
+  if (sli_si91x_bus_wakeup() != SL_STATUS_OK) {
     return SL_STATUS_TIMEOUT;
   }
 
   status = sli_si91x_remove_from_queue(queue, &buffer);
   if (status != SL_STATUS_OK) {
-    if (current_performance_profile != HIGH_PERFORMANCE) {
-      sl_si91x_host_clear_sleep_indicator();
-    }
+    sli_si91x_bus_sleep();
     VERIFY_STATUS_AND_RETURN(status);
   }
 
@@ -429,6 +549,9 @@ static sl_status_t bus_write_data_frame(sli_wifi_buffer_queue_t *queue)
 
   // Write the frame to the bus using packet data and length
   status = sli_si91x_bus_write_frame(packet, packet->data, length);
+  sli_bus_statistics.frames_written++;
+  sli_bus_statistics.payload_bytes += length;
+  sli_wake_lock_frames++;
 
 #ifdef SLI_SI91X_MCU_INTERFACE
   sli_si91x_update_tx_command_status(false);
@@ -442,9 +565,7 @@ static sl_status_t bus_write_data_frame(sli_wifi_buffer_queue_t *queue)
     SL_PRINT_STRING_DEBUG("<>>>> Tx -> queueId : %u, frameId : 0x%x, length : %u\n", 5, 0, length);
   }
 
-  if (current_performance_profile != HIGH_PERFORMANCE) {
-    sl_si91x_host_clear_sleep_indicator();
-  }
+  sli_si91x_bus_sleep();
 
   sli_si91x_host_free_buffer(buffer);
   return status;
@@ -455,6 +576,42 @@ static void set_async_event(uint32_t event_mask)
   osEventFlagsSet(si91x_async_events, event_mask);
 }
 
+// Reads the interrupt status from the bus. On NCP hosts a fresh status is the NWP's buffer-free indication, so it
+// grants SLI_SI91X_NWP_TX_CREDITS to every packet type whose buffer is not reported full.
+static sl_status_t sli_si91x_read_interrupt_status(void)
+{
+  sl_status_t status = sli_si91x_bus_read_interrupt_status(&interrupt_status);
+  sli_bus_statistics.interrupt_status_reads++;
+
+#ifndef SLI_SI91X_MCU_INTERFACE
+  if (status != SL_STATUS_OK) {
+    sli_wifi_tx_credits = 0;
+    sli_ble_tx_credits  = 0;
+    return status;
+  }
+  sli_wifi_tx_credits = (interrupt_status & SLI_WIFI_BUFFER_FULL) ? 0 : SLI_SI91X_NWP_TX_CREDITS;
+  sli_ble_tx_credits  = (interrupt_status & SLI_BLE_BUFFER_FULL) ? 0 : SLI_SI91X_NWP_TX_CREDITS;
+#endif
+  return status;
+}
+
+void sl_si91x_get_bus_statistics(sl_si91x_bus_statistics_t *statistics)
+{
+  if (statistics == NULL) {
+    return;
+  }
+  CORE_irqState_t state = CORE_EnterAtomic();
+  *statistics           = sli_bus_statistics;
+  CORE_ExitAtomic(state);
+}
+
+void sl_si91x_reset_bus_statistics(void)
+{
+  CORE_irqState_t state = CORE_EnterAtomic();
+  memset(&sli_bus_statistics, 0, sizeof(sli_bus_statistics));
+  CORE_ExitAtomic(state);
+}
+
 // Function to check if the bus is ready for writing
 static bool sli_si91x_is_bus_ready(bool global_queue_block, uint8_t packet_type)
 {
@@ -463,23 +620,37 @@ static bool sli_si91x_is_bus_ready(bool global_queue_block, uint8_t packet_type)
     return false;
   }
 
+  // End the TX burst once it used up the wake lock budget, the remaining frames go out on the next pass
+  if (sli_si91x_wake_lock_budget_spent()) {
+    return false;
+  }
+
 #ifndef SLI_SI91X_MCU_INTERFACE
+  // Spend a credit instead of a register read while the NWP is known to have room for this packet type
+  uint8_t *credits = (packet_type == SLI_BLE_PACKET) ? &sli_ble_tx_credits : &sli_wifi_tx_credits;
+  if (*credits > 0) {
+    (*credits)--;
+    return true;
+  }
+
   // If the current performance profile is not high performance, request wakeup
-  if ((current_performance_profile != HIGH_PERFORMANCE) && (sli_si91x_req_wakeup() != SL_STATUS_OK)) {
+  if (sli_si91x_bus_wakeup() != SL_STATUS_OK) {
     return false;
   }
 #endif
 
-  // Read the interrupt status from the bus
-  sli_si91x_bus_read_interrupt_status(&interrupt_status);
+  // Read the interrupt status from the bus, a failed read leaves no fresh status to decide on
+  sl_status_t status = sli_si91x_read_interrupt_status();
 
 #ifndef SLI_SI91X_MCU_INTERFACE
   // Clear the sleep indicator if the current performance profile is not high performance
-  if (current_performance_profile != HIGH_PERFORMANCE) {
-    sl_si91x_host_clear_sleep_indicator();
-  }
+  sli_si91x_bus_sleep();
 #endif
 
+  if (status != SL_STATUS_OK) {
+    return false;
+  }
+
   // If the buffer is full for the given packet type, unmask the TA interrupt (if MCU interface) and return false
   if ((packet_type == SLI_WIFI_PACKET) && (interrupt_status & SLI_WIFI_BUFFER_FULL)) {
 #ifdef SLI_SI91X_MCU_INTERFACE
@@ -489,6 +660,12 @@ static bool sli_si91x_is_bus_ready(bool global_queue_block, uint8_t packet_type)
   } else if ((packet_type == SLI_BLE_PACKET) && (interrupt_status & SLI_BLE_BUFFER_FULL)) {
     return false;
   }
+#ifndef SLI_SI91X_MCU_INTERFACE
+  // The frame about to be written uses the first of the credits granted by the read
+  if (*credits > 0) {
+    (*credits)--;
+  }
+#endif
   // The bus is ready for writing
   return true;
 }
@@ -630,9 +807,7 @@ static inline void sli_si91x_wifi_handle_rx_events(uint32_t *event)
 #endif
       && (sli_si91x_bus_read_frame(&buffer) == SL_STATUS_OK)) { // Allocation from RX buffer type!
 
-    if (current_performance_profile != HIGH_PERFORMANCE) {
-      sl_si91x_host_clear_sleep_indicator();
-    }
+    sli_si91x_bus_sleep();
 
     // Check if the rx queue is empty
 #ifdef SLI_SI91X_MCU_INTERFACE
@@ -678,8 +853,12 @@ static inline void sli_si91x_wifi_handle_rx_events(uint32_t *event)
                 current_performance_profile = current_power_profile_mode.profile;
               }
               if (current_performance_profile != HIGH_PERFORMANCE) {
-                // Clear the sleep indicator if the device is not in high-performance mode
-                sl_si91x_host_clear_sleep_indicator();
+                // Clear the sleep indicator if the device is not in high-performance mode, ending any TX wake lock
+                sli_si91x_wake_lock_release();
+              } else {
+                // High performance keeps the NWP awake anyway, drop the lock without touching the indicator
+                sli_wake_lock_held      = false;
+                sli_wake_lock_lingering = false;
               }
               global_queue_block = false;
             }
@@ -1020,7 +1199,7 @@ static inline void sli_si91x_wifi_handle_rx_events(uint32_t *event)
           }
           case SLI_COMMON_RSP_ULP_NO_RAM_RETENTION: {
             //This frame will come, when the M4 is waken in without ram retention. This frame is equivalent to SLI_WIFI_RSP_CARDREADY
-            sl_si91x_host_clear_sleep_indicator();
+            sli_si91x_wake_lock_release();
           }
             // intentional fallthrough
             __attribute__((fallthrough));
@@ -1611,6 +1790,93 @@ static inline void sli_si91x_wifi_handle_rx_events(uint32_t *event)
   return;
 }
 
+#ifdef SLI_SI91X_OFFLOAD_NETWORK_STACK
+// Deficit round-robin position per priority class: the socket to serve next and whether its turn is in progress
+static uint8_t sli_tx_data_next_socket[SLI_SI91X_SOCKET_TX_PRIORITY_CLASSES];
+static bool sli_tx_data_turn_in_progress[SLI_SI91X_SOCKET_TX_PRIORITY_CLASSES];
+
+// Clears a socket's data pending bit unless the application queued more data since the queue was seen empty
+static void sli_si91x_clear_socket_data_pending(const sli_si91x_socket_t *socket, uint8_t index)
+{
+  CORE_irqState_t state = CORE_EnterAtomic();
+  if (socket == NULL || sli_si91x_buffer_queue_empty(&socket->tx_data_queue)) {
+    tx_socket_data_queues_status &= ~(1 << index);
+  }
+  CORE_ExitAtomic(state);
+}
+
+/*
+ * Gives the next socket of a priority class that has data queued, as flagged in tx_socket_data_queues_status,
+ * its deficit round-robin turn. The turn earns the socket tx_weight quanta of byte credit and lasts while the
+ * frame at the head of its queue fits in the credit. If the bus stops accepting frames the turn is suspended,
+ * and the next call resumes it without granting new credit, so no socket gains from being early in the table.
+ */
+static sli_socket_tx_turn_t sli_si91x_schedule_socket_data(uint8_t priority)
+{
+  uint8_t start = sli_tx_data_next_socket[priority];
+
+  for (uint8_t n = 0; n < SLI_NUMBER_OF_SOCKETS; n++) {
+    uint8_t i = (uint8_t)((start + n) % SLI_NUMBER_OF_SOCKETS);
+    if (!(tx_socket_data_queues_status & (1 << i))) {
+      continue;
+    }
+    sli_si91x_socket_t *socket = sli_si91x_sockets[i];
+    if (socket == NULL || sli_si91x_buffer_queue_empty(&socket->tx_data_queue)) {
+      sli_si91x_clear_socket_data_pending(socket, i);
+      continue;
+    }
+    if (socket->tx_priority != priority) {
+      continue;
+    }
+
+    if (!(sli_tx_data_turn_in_progress[priority] && (i == start))) {
+      uint8_t weight = (socket->tx_weight != 0) ? socket->tx_weight : SLI_SI91X_SOCKET_TX_DEFAULT_WEIGHT;
+      socket->tx_deficit += (int32_t)weight * SLI_SI91X_SOCKET_TX_QUANTUM;
+    }
+    sli_tx_data_next_socket[priority]      = i;
+    sli_tx_data_turn_in_progress[priority] = true;
+
+    while (!sli_si91x_buffer_queue_empty(&socket->tx_data_queue)) {
+      const sl_wifi_system_packet_t *packet = sli_wifi_host_get_buffer_data(socket->tx_data_queue.head, 0, NULL);
+      uint16_t length                       = packet->length;
+      if (length > socket->tx_deficit) {
+        break;
+      }
+
+      // Check if the bus is ready for a packet
+      if (!sli_si91x_is_bus_ready(global_queue_block, SLI_WIFI_PACKET)) {
+        return SLI_SOCKET_TX_TURN_BUS_NOT_READY;
+      }
+
+      sl_status_t status = bus_write_data_frame(&socket->tx_data_queue);
+      if (status == SL_STATUS_TIMEOUT) {
+        // The NWP did not wake up and the frame is still queued, resume this turn on the next pass
+        return SLI_SOCKET_TX_TURN_BUS_NOT_READY;
+      }
+      socket->tx_deficit -= length;
+      if (status == SL_STATUS_OK) {
+        socket->tx_bytes += length;
+        socket->tx_frames++;
+      }
+      // The frame has left the socket queue, written or dropped on a bus error, so its slot can be reused
+      sli_si91x_socket_release_tx_slot(socket);
+      // A freed data buffer lets a socket at its buffer limit queue data again
+      sli_si91x_epoll_notify(i, SL_SI91X_EPOLLOUT);
+    }
+
+    if (sli_si91x_buffer_queue_empty(&socket->tx_data_queue)) {
+      // An idle socket does not bank credit
+      socket->tx_deficit = 0;
+      sli_si91x_clear_socket_data_pending(socket, i);
+    }
+    sli_tx_data_next_socket[priority]      = (uint8_t)((i + 1) % SLI_NUMBER_OF_SOCKETS);
+    sli_tx_data_turn_in_progress[priority] = false;
+    return SLI_SOCKET_TX_TURN_SERVED;
+  }
+  return SLI_SOCKET_TX_TURN_CLASS_IDLE;
+}
+#endif
+
 static inline void sli_si91x_wifi_handle_tx_event(uint32_t *event)
 {
   if (*event & SL_SI91X_ALL_TX_PENDING_COMMAND_EVENTS) {
@@ -1672,32 +1938,19 @@ static inline void sli_si91x_wifi_handle_tx_event(uint32_t *event)
   }
 
   if (*event & SL_SI91X_SOCKET_DATA_TX_PENDING_EVENT) {
-    bool all_socket_data_sent = true;
-    // Check each socket if it has something to send
-    for (uint8_t i = 0; i < SLI_NUMBER_OF_SOCKETS; ++i) {
-      if (sli_si91x_sockets[i] != NULL && !sli_si91x_buffer_queue_empty(&sli_si91x_sockets[i]->tx_data_queue)) {
-        all_socket_data_sent = false;
-
-        // Check if the bus is ready for a packet
-        if (!sli_si91x_is_bus_ready(global_queue_block, SLI_WIFI_PACKET)) {
-          break;
-        }
-
-        sl_status_t status = bus_write_data_frame(&sli_si91x_sockets[i]->tx_data_queue);
-        if (status == SL_STATUS_OK) {
-          // Atomic protection for data_buffer_count to prevent race condition
-          CORE_irqState_t state1 = CORE_EnterAtomic();
-          --sli_si91x_sockets[i]->data_buffer_count;
-          CORE_ExitAtomic(state1);
-        }
-        if (sli_si91x_buffer_queue_empty(&sli_si91x_sockets[i]->tx_data_queue)) {
-          tx_socket_data_queues_status &= ~(1 << i);
-        }
+    // Strict priority between classes: every turn goes to the highest class that has data queued, so a lower
+    // class is only served while all higher classes are idle. Stop as soon as the bus is not ready
+    int8_t priority = SLI_SI91X_SOCKET_TX_PRIORITY_CLASSES - 1;
+    while (priority >= 0) {
+      sli_socket_tx_turn_t turn = sli_si91x_schedule_socket_data((uint8_t)priority);
+      if (turn == SLI_SOCKET_TX_TURN_BUS_NOT_READY) {
+        break;
       }
+      priority = (turn == SLI_SOCKET_TX_TURN_SERVED) ? (SLI_SI91X_SOCKET_TX_PRIORITY_CLASSES - 1) : (priority - 1);
     }
 
     // Clear event bit if we confirmed no more packets to send
-    if (all_socket_data_sent) {
+    if (tx_socket_data_queues_status == 0) {
       *event &= ~SL_SI91X_SOCKET_DATA_TX_PENDING_EVENT;
     }
   }
@@ -1801,7 +2054,17 @@ extern inline uint32_t sli_wifi_event_handler_get_wait_time(uint32_t *event)
 #endif
 
   // Use a lookup table to select the appropriate wait time based on buffer and queue status.
-  return sli_get_wait_time(wifi_buffer_full, wifi_tx_queues_pending, ble_buffer_full, ble_tx_queues_pending);
+  uint32_t wait_time =
+    sli_get_wait_time(wifi_buffer_full, wifi_tx_queues_pending, ble_buffer_full, ble_tx_queues_pending);
+
+  // Wake up in time to release a lingering TX wake lock
+  if (sli_wake_lock_lingering) {
+    uint32_t linger_time = sli_si91x_wake_lock_remaining_ticks();
+    if (linger_time < wait_time) {
+      wait_time = linger_time;
+    }
+  }
+  return wait_time;
 }
 
 /// Thread which handles the notification events.
@@ -1828,6 +2091,15 @@ void sli_si91x_async_rx_event_handler_thread(const void *args)
       sli_si91x_process_common_events();
     }
 
+#if SL_SI91X_RX_DISPATCH_WORKER_COUNT > 0
+    // Check and process command engine status notifications
+    if (event & SLI_SI91X_NCP_HOST_COMMAND_ENGINE_STATUS_NOTIFICATION_EVENT) {
+      sli_si91x_process_command_engine_status_events();
+    }
+
+    // Hand the remaining events to the dispatch workers, which run the application callbacks
+    sli_si91x_rx_dispatch_events(event);
+#else
     // Check and process WLAN notification events
     if (event & NCP_HOST_WLAN_NOTIFICATION_EVENT) {
       sli_si91x_process_wifi_events();
@@ -1856,6 +2128,7 @@ void sli_si91x_async_rx_event_handler_thread(const void *args)
     if (event & NCP_HOST_BLE_NOTIFICATION_EVENT) {
       sli_si91x_process_ble_events();
     }
+#endif
 #endif
   }
 }
@@ -1888,40 +2161,50 @@ void sli_si91x_process_wifi_events()
   while (sli_si91x_host_queue_status(&cmd_queues[SLI_WIFI_WLAN_CMD].event_queue) != 0) {
     // Remove packet from queue if available
     if (sli_si91x_remove_from_queue(&cmd_queues[SLI_WIFI_WLAN_CMD].event_queue, &buffer) == SL_STATUS_OK) {
-      sl_wifi_system_packet_t *packet = sli_wifi_host_get_buffer_data(buffer, 0, NULL);
-      uint16_t frame_status           = sli_get_si91x_frame_status(packet);
+      sli_si91x_handle_wifi_event(buffer);
+    }
+  }
+}
+
+// Handles one WLAN notification event and frees it
+static void sli_si91x_handle_wifi_event(sl_wifi_buffer_t *buffer)
+{
+  sl_wifi_system_packet_t *packet = sli_wifi_host_get_buffer_data(buffer, 0, NULL);
+  uint16_t frame_status           = sli_get_si91x_frame_status(packet);
 #ifdef SL_NET_COMPONENT_INCLUDED
-      // Check if the command received is a WLAN join response
-      if (packet->command == SLI_WIFI_RSP_JOIN) {
-        sli_network_manager_message_t message = { 0 };    // Create a new message for the network manager
-        message.interface = SL_NET_WIFI_CLIENT_INTERFACE; // Specify the network interface as the Wi-Fi client interface
-        message.event_flags = frame_status != SL_STATUS_OK
-                                ? SLI_NET_DISCONNECT_Q_EVENT
-                                : SLI_NET_CONNECT_Q_EVENT; // Set the event flags based on the frame status
-        osMessageQueuePut(sli_network_manager_request_queue,
-                          &message,
-                          SLI_NET_MSG_PRIO_NORMAL,
-                          0); // Add the message to the network manager queue
-      }
+  // Check if the command received is a WLAN join response
+  if (packet->command == SLI_WIFI_RSP_JOIN) {
+    sli_network_manager_message_t message = { 0 };    // Create a new message for the network manager
+    message.interface = SL_NET_WIFI_CLIENT_INTERFACE; // Specify the network interface as the Wi-Fi client interface
+    message.event_flags = frame_status != SL_STATUS_OK
+                            ? SLI_NET_DISCONNECT_Q_EVENT
+                            : SLI_NET_CONNECT_Q_EVENT; // Set the event flags based on the frame status
+    osMessageQueuePut(sli_network_manager_request_queue,
+                      &message,
+                      SLI_NET_MSG_PRIO_NORMAL,
+                      0); // Add the message to the network manager queue
+  }
 #endif // SL_NET_COMPONENT_INCLUDED
-      // Invoke registered event handler if it exists
-      if (si91x_event_handler != NULL) {
-        sl_wifi_event_t wifi_event = sli_convert_si91x_event_to_sl_wifi_event(packet->command, frame_status);
+  // Firmware chunks queued by the firmware update loader are acknowledged here
+  if (SLI_WLAN_RSP_FWUP == packet->command) {
+    sli_handle_fwup_response(frame_status);
+  }
+  // Invoke registered event handler if it exists
+  if (si91x_event_handler != NULL) {
+    sl_wifi_event_t wifi_event = sli_convert_si91x_event_to_sl_wifi_event(packet->command, frame_status);
 
-        // Special handling for scan results events
-        if (SLI_WLAN_RSP_SCAN_RESULTS == packet->command) {
-          sli_handle_wifi_beacon(packet);
-        }
+    // Special handling for scan results events
+    if (SLI_WLAN_RSP_SCAN_RESULTS == packet->command) {
+      sli_handle_wifi_beacon(packet);
+    }
 
-        // Only call handler if event is valid
-        if (wifi_event != SL_WIFI_INVALID_EVENT) {
-          si91x_event_handler(wifi_event, buffer);
-        }
-      }
-      // Free the buffer after processing the event
-      sli_si91x_host_free_buffer(buffer);
+    // Only call handler if event is valid
+    if (wifi_event != SL_WIFI_INVALID_EVENT) {
+      si91x_event_handler(wifi_event, buffer);
     }
   }
+  // Free the buffer after processing the event
+  sli_si91x_host_free_buffer(buffer);
 }
 
 /// Process Network notification events from the queue.
@@ -1931,20 +2214,26 @@ void sli_si91x_process_network_events()
   // Avoid memory leaks by freeing packets if firmware sends network events without `sl_net` component.
   while (sli_si91x_host_queue_status(&cmd_queues[SLI_SI91X_NETWORK_CMD].event_queue) != 0) {
     if (sli_si91x_remove_from_queue(&cmd_queues[SLI_SI91X_NETWORK_CMD].event_queue, &buffer) == SL_STATUS_OK) {
-      sli_si91x_queue_packet_t *data = (sli_si91x_queue_packet_t *)sli_wifi_host_get_buffer_data(buffer, 0, NULL);
-      sl_wifi_system_packet_t *packet =
-        (sl_wifi_system_packet_t *)sli_wifi_host_get_buffer_data(data->host_packet, 0, NULL);
+      sli_si91x_handle_network_event(buffer);
+    }
+  }
+}
 
-      sli_handle_wifi_events(data, packet);
+// Handles one Network notification event and frees it
+static void sli_si91x_handle_network_event(sl_wifi_buffer_t *buffer)
+{
+  sli_si91x_queue_packet_t *data = (sli_si91x_queue_packet_t *)sli_wifi_host_get_buffer_data(buffer, 0, NULL);
+  sl_wifi_system_packet_t *packet =
+    (sl_wifi_system_packet_t *)sli_wifi_host_get_buffer_data(data->host_packet, 0, NULL);
 
-      // Dispatch the network event to the appropriate handler.
-      SL_NET_EVENT_DISPATCH_HANDLER(data, packet);
+  sli_handle_wifi_events(data, packet);
 
-      // Free resources associated with the packet after processing
-      sli_si91x_host_free_buffer(data->host_packet);
-      sli_si91x_host_free_buffer(buffer);
-    }
-  }
+  // Dispatch the network event to the appropriate handler.
+  SL_NET_EVENT_DISPATCH_HANDLER(data, packet);
+
+  // Free resources associated with the packet after processing
+  sli_si91x_host_free_buffer(data->host_packet);
+  sli_si91x_host_free_buffer(buffer);
 }
 
 /// Process Socket notification events from the queue.
@@ -1954,20 +2243,26 @@ void sli_si91x_process_socket_events()
   // Process socket events in the queue
   while (sli_si91x_host_queue_status(&cmd_queues[SLI_SI91X_SOCKET_CMD].event_queue) != 0) {
     if (sli_si91x_remove_from_queue(&cmd_queues[SLI_SI91X_SOCKET_CMD].event_queue, &buffer) == SL_STATUS_OK) {
-      sli_si91x_queue_packet_t *data = (sli_si91x_queue_packet_t *)sli_wifi_host_get_buffer_data(buffer, 0, NULL);
-      sl_wifi_system_packet_t *packet =
-        (sl_wifi_system_packet_t *)sli_wifi_host_get_buffer_data(data->host_packet, 0, NULL);
-
-      // Dispatch the socket event to the appropriate handler.
-      SL_NET_EVENT_DISPATCH_HANDLER(data, packet);
-
-      // Free resources after processing the packet.
-      sli_si91x_host_free_buffer(data->host_packet);
-      sli_si91x_host_free_buffer(buffer);
+      sli_si91x_handle_socket_event(buffer);
     }
   }
 }
 
+// Handles one Socket notification event and frees it
+static void sli_si91x_handle_socket_event(sl_wifi_buffer_t *buffer)
+{
+  sli_si91x_queue_packet_t *data = (sli_si91x_queue_packet_t *)sli_wifi_host_get_buffer_data(buffer, 0, NULL);
+  sl_wifi_system_packet_t *packet =
+    (sl_wifi_system_packet_t *)sli_wifi_host_get_buffer_data(data->host_packet, 0, NULL);
+
+  // Dispatch the socket event to the appropriate handler.
+  SL_NET_EVENT_DISPATCH_HANDLER(data, packet);
+
+  // Free resources after processing the packet.
+  sli_si91x_host_free_buffer(data->host_packet);
+  sli_si91x_host_free_buffer(buffer);
+}
+
 /// Process command engine status notification events
 void sli_si91x_process_command_engine_status_events()
 {
@@ -1992,21 +2287,21 @@ void sli_si91x_process_socket_data_events()
     if (sli_si91x_sockets[i] != NULL) {
       // If data is available in the RX queue, remove and process it
       if (sli_si91x_remove_from_queue(&sli_si91x_sockets[i]->rx_data_queue, &buffer) == SL_STATUS_OK) {
-        if (sli_si91x_sockets[i]->recv_data_callback != NULL) {
-          sl_wifi_system_packet_t *packet = (sl_wifi_system_packet_t *)sli_wifi_host_get_buffer_data(buffer, 0, NULL);
-          sl_si91x_socket_metadata_t *receive_data = (sl_si91x_socket_metadata_t *)packet->data;
-          // Call the receive callback function with the received data
-          sli_si91x_sockets[i]->recv_data_callback(i,
-                                                   &packet->data[receive_data->offset],
-                                                   receive_data->length,
-                                                   receive_data);
-        }
-        // Free the buffer after data processing
-        sli_si91x_host_free_buffer(buffer);
+        sli_si91x_handle_socket_data(i, buffer);
       }
     }
   }
 }
+
+// Passes data received on a socket to its receive callback
+static void sli_si91x_handle_socket_data(uint8_t socket, sl_wifi_buffer_t *buffer)
+{
+  // Call the receive callback function with the received data. Free the buffer after data processing,
+  // unless the application kept it. A dispatch worker may find the socket closed in the meantime.
+  if ((sli_si91x_sockets[socket] == NULL) || !sli_si91x_socket_deliver_received_data(socket, buffer)) {
+    sli_si91x_host_free_buffer(buffer);
+  }
+}
 #endif
 
 #ifdef SLI_SI91X_ENABLE_BLE
@@ -2017,14 +2312,485 @@ void sli_si91x_process_ble_events()
   // Process Bluetooth (BLE) events in the queue
   while (sli_si91x_host_queue_status(&cmd_queues[SLI_SI91X_BT_CMD].event_queue) != 0) {
     if (sli_si91x_remove_from_queue(&cmd_queues[SLI_SI91X_BT_CMD].event_queue, &buffer) == SL_STATUS_OK) {
-      sl_wifi_system_packet_t *packet = (sl_wifi_system_packet_t *)sli_wifi_host_get_buffer_data(buffer, 0, NULL);
-      // Handle Bluetooth response and free the buffer
-      rsi_driver_process_bt_resp_handler(packet);
-      sli_si91x_host_free_buffer(buffer);
+      sli_si91x_handle_ble_event(buffer);
+    }
+  }
+}
+
+// Handles one BLE notification event and frees it
+static void sli_si91x_handle_ble_event(sl_wifi_buffer_t *buffer)
+{
+  sl_wifi_system_packet_t *packet = (sl_wifi_system_packet_t *)sli_wifi_host_get_buffer_data(buffer, 0, NULL);
+  // Handle Bluetooth response and free the buffer
+  rsi_driver_process_bt_resp_handler(packet);
+  sli_si91x_host_free_buffer(buffer);
+}
+#endif
+
+#if SL_SI91X_RX_DISPATCH_WORKER_COUNT > 0
+#if (SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH < 1) || (SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH > 255)
+#error "SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH must be between 1 and 255"
+#endif
+
+#if (SL_SI91X_RX_DISPATCH_DEFAULT_QUEUE_DEPTH < 1) \
+  || (SL_SI91X_RX_DISPATCH_DEFAULT_QUEUE_DEPTH > SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH)
+#error "SL_SI91X_RX_DISPATCH_DEFAULT_QUEUE_DEPTH must be between 1 and SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH"
+#endif
+
+// Socket events and socket data share a worker, so more workers than this are never used
+#define SLI_RX_DISPATCH_MAX_WORKERS 4
+#define SLI_RX_DISPATCH_WORKERS                                                                     \
+  ((SL_SI91X_RX_DISPATCH_WORKER_COUNT < SLI_RX_DISPATCH_MAX_WORKERS) ? SL_SI91X_RX_DISPATCH_WORKER_COUNT \
+                                                                      : SLI_RX_DISPATCH_MAX_WORKERS)
+
+// Thread flag asking a worker to stop, above the flags of the queues
+#define SLI_RX_DISPATCH_STOP_FLAG (1UL << SL_SI91X_RX_DISPATCH_QUEUE_COUNT)
+
+// Time sli_si91x_rx_dispatch_deinit() waits for each worker to finish the callback it is running
+#define SLI_RX_DISPATCH_STOP_TIMEOUT_MS 5000
+
+// Event waiting in an RX dispatch queue
+typedef struct {
+  sl_wifi_buffer_t *buffer; // Event packet
+  uint32_t enqueue_tick;    // Kernel tick at which the event was queued, for the latency counters
+  uint8_t socket;           // Host socket index, for socket data
+  uint8_t generation;       // Generation of the socket index when the data was queued
+} sli_si91x_rx_dispatch_entry_t;
+
+// Ring of events of one protocol, filled by the RX event thread and drained by one worker
+typedef struct {
+  sli_si91x_rx_dispatch_entry_t entries[SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH];
+  uint8_t head;                                             // Oldest entry
+  uint8_t count;                                            // Entries queued
+  bool holding;                                             // Events were left with the driver for lack of room
+  sl_si91x_rx_dispatch_queue_configuration_t configuration; // Depth and overload policy
+  sl_si91x_rx_dispatch_queue_statistics_t statistics;       // Counters, latencies are kept in ticks
+} sli_si91x_rx_dispatch_ring_t;
+
+// What to do with the next event of a queue
+typedef enum {
+  SLI_RX_DISPATCH_QUEUE_EVENT, // Queue the event
+  SLI_RX_DISPATCH_HOLD_EVENT,  // Leave the event with the driver
+  SLI_RX_DISPATCH_DROP_EVENT,  // Drop the event
+} sli_si91x_rx_dispatch_action_t;
+
+static sli_si91x_rx_dispatch_ring_t sli_rx_dispatch_rings[SL_SI91X_RX_DISPATCH_QUEUE_COUNT];
+static osThreadId_t sli_rx_dispatch_workers[SLI_RX_DISPATCH_WORKERS];
+static osSemaphoreId_t sli_rx_dispatch_stopped; // Released by each worker once it stopped
+
+// Async event that makes the RX event thread look at the events held back for each queue
+static const uint32_t sli_rx_dispatch_notification_events[SL_SI91X_RX_DISPATCH_QUEUE_COUNT] = {
+  [SL_SI91X_RX_DISPATCH_WIFI_QUEUE]        = NCP_HOST_WLAN_NOTIFICATION_EVENT,
+  [SL_SI91X_RX_DISPATCH_NETWORK_QUEUE]     = NCP_HOST_NETWORK_NOTIFICATION_EVENT,
+  [SL_SI91X_RX_DISPATCH_SOCKET_QUEUE]      = NCP_HOST_SOCKET_NOTIFICATION_EVENT,
+  [SL_SI91X_RX_DISPATCH_SOCKET_DATA_QUEUE] = NCP_HOST_SOCKET_DATA_NOTIFICATION_EVENT,
+  [SL_SI91X_RX_DISPATCH_BLE_QUEUE]         = NCP_HOST_BLE_NOTIFICATION_EVENT,
+};
+
+// Worker of each queue. Socket events and socket data share one, so a socket sees its events in order.
+static const uint8_t sli_rx_dispatch_queue_workers[SL_SI91X_RX_DISPATCH_QUEUE_COUNT] = {
+  [SL_SI91X_RX_DISPATCH_WIFI_QUEUE]        = 0 % SLI_RX_DISPATCH_WORKERS,
+  [SL_SI91X_RX_DISPATCH_NETWORK_QUEUE]     = 1 % SLI_RX_DISPATCH_WORKERS,
+  [SL_SI91X_RX_DISPATCH_SOCKET_QUEUE]      = 2 % SLI_RX_DISPATCH_WORKERS,
+  [SL_SI91X_RX_DISPATCH_SOCKET_DATA_QUEUE] = 2 % SLI_RX_DISPATCH_WORKERS,
+  [SL_SI91X_RX_DISPATCH_BLE_QUEUE]         = 3 % SLI_RX_DISPATCH_WORKERS,
+};
+
+// Frees an event without handling it
+static void sli_si91x_rx_dispatch_discard(sl_si91x_rx_dispatch_queue_t queue, sl_wifi_buffer_t *buffer)
+{
+  // Network and socket events wrap the packet received from the NWP
+  if ((queue == SL_SI91X_RX_DISPATCH_NETWORK_QUEUE) || (queue == SL_SI91X_RX_DISPATCH_SOCKET_QUEUE)) {
+    const sli_si91x_queue_packet_t *data = sli_wifi_host_get_buffer_data(buffer, 0, NULL);
+    sli_si91x_host_free_buffer(data->host_packet);
+  }
+  sli_si91x_host_free_buffer(buffer);
+}
+
+// Applies the overload policy of a queue before an event is added. The oldest event dropped to make room, if any,
+// is returned in dropped and must be discarded by the caller.
+static sli_si91x_rx_dispatch_action_t sli_si91x_rx_dispatch_make_room(sl_si91x_rx_dispatch_queue_t queue,
+                                                                      sl_wifi_buffer_t **dropped)
+{
+  sli_si91x_rx_dispatch_ring_t *ring    = &sli_rx_dispatch_rings[queue];
+  sli_si91x_rx_dispatch_action_t action = SLI_RX_DISPATCH_QUEUE_EVENT;
+
+  *dropped              = NULL;
+  CORE_irqState_t state = CORE_EnterAtomic();
+  if (ring->count >= ring->configuration.depth) {
+    switch (ring->configuration.overload_policy) {
+      case SL_SI91X_RX_DISPATCH_DROP_NEWEST:
+        ring->statistics.dropped++;
+        action = SLI_RX_DISPATCH_DROP_EVENT;
+        break;
+      case SL_SI91X_RX_DISPATCH_DROP_OLDEST:
+        *dropped   = ring->entries[ring->head].buffer;
+        ring->head = (uint8_t)((ring->head + 1) % SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH);
+        ring->count--;
+        ring->statistics.dropped++;
+        break;
+      default:
+        ring->holding = true;
+        ring->statistics.held++;
+        action = SLI_RX_DISPATCH_HOLD_EVENT;
+        break;
+    }
+  }
+  CORE_ExitAtomic(state);
+  return action;
+}
+
+// Adds an event to a queue that has room
+static void sli_si91x_rx_dispatch_push(sl_si91x_rx_dispatch_queue_t queue,
+                                       sl_wifi_buffer_t *buffer,
+                                       uint8_t socket,
+                                       uint8_t generation)
+{
+  sli_si91x_rx_dispatch_ring_t *ring = &sli_rx_dispatch_rings[queue];
+
+  CORE_irqState_t state = CORE_EnterAtomic();
+  uint8_t tail          = (uint8_t)((ring->head + ring->count) % SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH);
+  ring->entries[tail].buffer       = buffer;
+  ring->entries[tail].enqueue_tick = osKernelGetTickCount();
+  ring->entries[tail].socket       = socket;
+  ring->entries[tail].generation   = generation;
+  ring->count++;
+  if (ring->count > ring->statistics.high_watermark) {
+    ring->statistics.high_watermark = ring->count;
+  }
+  CORE_ExitAtomic(state);
+
+  osThreadFlagsSet(sli_rx_dispatch_workers[sli_rx_dispatch_queue_workers[queue]], (1UL << queue));
+}
+
+// Takes the oldest event of a queue, returns false if the queue is empty
+static bool sli_si91x_rx_dispatch_pop(sl_si91x_rx_dispatch_queue_t queue, sli_si91x_rx_dispatch_entry_t *entry)
+{
+  sli_si91x_rx_dispatch_ring_t *ring = &sli_rx_dispatch_rings[queue];
+  bool resume                        = false;
+
+  CORE_irqState_t state = CORE_EnterAtomic();
+  if (ring->count == 0) {
+    CORE_ExitAtomic(state);
+    return false;
+  }
+  *entry     = ring->entries[ring->head];
+  ring->head = (uint8_t)((ring->head + 1) % SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH);
+  ring->count--;
+
+  uint32_t latency = osKernelGetTickCount() - entry->enqueue_tick;
+  ring->statistics.dispatched++;
+  ring->statistics.total_latency_ms += latency;
+  if (latency > ring->statistics.max_latency_ms) {
+    ring->statistics.max_latency_ms = latency;
+  }
+  resume        = ring->holding;
+  ring->holding = false;
+  CORE_ExitAtomic(state);
+
+  // There is room again, let the RX event thread queue the events it held back
+  if (resume) {
+    set_async_event(sli_rx_dispatch_notification_events[queue]);
+  }
+  return true;
+}
+
+// Moves the events of a driver event queue into a dispatch queue
+static void sli_si91x_rx_dispatch_from_queue(sl_si91x_rx_dispatch_queue_t queue, sli_wifi_buffer_queue_t *source)
+{
+  sl_wifi_buffer_t *buffer  = NULL;
+  sl_wifi_buffer_t *dropped = NULL;
+
+  while (sli_si91x_host_queue_status(source) != 0) {
+    sli_si91x_rx_dispatch_action_t action = sli_si91x_rx_dispatch_make_room(queue, &dropped);
+    if (dropped != NULL) {
+      sli_si91x_rx_dispatch_discard(queue, dropped);
+    }
+    if (action == SLI_RX_DISPATCH_HOLD_EVENT) {
+      return;
+    }
+    if (sli_si91x_remove_from_queue(source, &buffer) != SL_STATUS_OK) {
+      return;
+    }
+    if (action == SLI_RX_DISPATCH_DROP_EVENT) {
+      sli_si91x_rx_dispatch_discard(queue, buffer);
+    } else {
+      sli_si91x_rx_dispatch_push(queue, buffer, 0, 0);
+    }
+  }
+}
+
+#ifdef SLI_SI91X_OFFLOAD_NETWORK_STACK
+// Moves the data received on asynchronous sockets into the socket data dispatch queue
+static void sli_si91x_rx_dispatch_socket_data(void)
+{
+  sl_wifi_buffer_t *buffer  = NULL;
+  sl_wifi_buffer_t *dropped = NULL;
+  bool moved                = true;
+
+  // One buffer per socket and pass, so a busy socket does not hold back the others
+  while (moved) {
+    moved = false;
+    for (uint8_t i = 0; i < SLI_NUMBER_OF_SOCKETS; ++i) {
+      if ((sli_si91x_sockets[i] == NULL) || (sli_si91x_host_queue_status(&sli_si91x_sockets[i]->rx_data_queue) == 0)) {
+        continue;
+      }
+      // Socket data is only ever held back, see sl_si91x_set_rx_dispatch_queue_configuration()
+      if (sli_si91x_rx_dispatch_make_room(SL_SI91X_RX_DISPATCH_SOCKET_DATA_QUEUE, &dropped)
+          != SLI_RX_DISPATCH_QUEUE_EVENT) {
+        return;
+      }
+      if (sli_si91x_remove_from_queue(&sli_si91x_sockets[i]->rx_data_queue, &buffer) == SL_STATUS_OK) {
+        sli_si91x_rx_dispatch_push(SL_SI91X_RX_DISPATCH_SOCKET_DATA_QUEUE, buffer, i, sli_si91x_socket_generations[i]);
+        moved = true;
+      }
+    }
+  }
+}
+#endif
+
+// Sorts the notified events into the dispatch queues
+void sli_si91x_rx_dispatch_events(uint32_t event)
+{
+  if (event & NCP_HOST_WLAN_NOTIFICATION_EVENT) {
+    sli_si91x_rx_dispatch_from_queue(SL_SI91X_RX_DISPATCH_WIFI_QUEUE, &cmd_queues[SLI_WIFI_WLAN_CMD].event_queue);
+  }
+  if (event & NCP_HOST_NETWORK_NOTIFICATION_EVENT) {
+    sli_si91x_rx_dispatch_from_queue(SL_SI91X_RX_DISPATCH_NETWORK_QUEUE,
+                                     &cmd_queues[SLI_SI91X_NETWORK_CMD].event_queue);
+  }
+  if (event & NCP_HOST_SOCKET_NOTIFICATION_EVENT) {
+    sli_si91x_rx_dispatch_from_queue(SL_SI91X_RX_DISPATCH_SOCKET_QUEUE, &cmd_queues[SLI_SI91X_SOCKET_CMD].event_queue);
+  }
+#ifdef SLI_SI91X_OFFLOAD_NETWORK_STACK
+  if (event & NCP_HOST_SOCKET_DATA_NOTIFICATION_EVENT) {
+    sli_si91x_rx_dispatch_socket_data();
+  }
+#endif
+#ifdef SLI_SI91X_ENABLE_BLE
+  if (event & NCP_HOST_BLE_NOTIFICATION_EVENT) {
+    sli_si91x_rx_dispatch_from_queue(SL_SI91X_RX_DISPATCH_BLE_QUEUE, &cmd_queues[SLI_SI91X_BT_CMD].event_queue);
+  }
+#endif
+}
+
+// Hands a dispatched event to the handler of its queue
+static void sli_si91x_rx_dispatch_handle(sl_si91x_rx_dispatch_queue_t queue, const sli_si91x_rx_dispatch_entry_t *entry)
+{
+  switch (queue) {
+    case SL_SI91X_RX_DISPATCH_WIFI_QUEUE:
+      sli_si91x_handle_wifi_event(entry->buffer);
+      break;
+    case SL_SI91X_RX_DISPATCH_NETWORK_QUEUE:
+      sli_si91x_handle_network_event(entry->buffer);
+      break;
+    case SL_SI91X_RX_DISPATCH_SOCKET_QUEUE:
+      sli_si91x_handle_socket_event(entry->buffer);
+      break;
+#ifdef SLI_SI91X_OFFLOAD_NETWORK_STACK
+    case SL_SI91X_RX_DISPATCH_SOCKET_DATA_QUEUE:
+      // The socket was closed after its data was queued, and the index may belong to a new socket by now
+      if (entry->generation != sli_si91x_socket_generations[entry->socket]) {
+        sli_si91x_host_free_buffer(entry->buffer);
+        break;
+      }
+      sli_si91x_handle_socket_data(entry->socket, entry->buffer);
+      break;
+#endif
+#ifdef SLI_SI91X_ENABLE_BLE
+    case SL_SI91X_RX_DISPATCH_BLE_QUEUE:
+      sli_si91x_handle_ble_event(entry->buffer);
+      break;
+#endif
+    default:
+      sli_si91x_rx_dispatch_discard(queue, entry->buffer);
+      break;
+  }
+}
+
+/// Thread which runs the callbacks of the queues assigned to one dispatch worker
+static void sli_si91x_rx_dispatch_worker_thread(void *args)
+{
+  uint8_t worker                      = (uint8_t)(uintptr_t)args;
+  uint32_t queue_mask                 = 0;
+  sli_si91x_rx_dispatch_entry_t entry = { 0 };
+
+  for (uint8_t queue = 0; queue < SL_SI91X_RX_DISPATCH_QUEUE_COUNT; queue++) {
+    if (sli_rx_dispatch_queue_workers[queue] == worker) {
+      queue_mask |= (1UL << queue);
+    }
+  }
+
+  while (1) {
+    uint32_t flags = osThreadFlagsWait(queue_mask | SLI_RX_DISPATCH_STOP_FLAG, osFlagsWaitAny, osWaitForever);
+    if (flags & osFlagsError) {
+      continue;
+    }
+    if (flags & SLI_RX_DISPATCH_STOP_FLAG) {
+      break;
+    }
+    for (uint8_t queue = 0; queue < SL_SI91X_RX_DISPATCH_QUEUE_COUNT; queue++) {
+      if ((queue_mask & (1UL << queue)) == 0) {
+        continue;
+      }
+      while (sli_si91x_rx_dispatch_pop((sl_si91x_rx_dispatch_queue_t)queue, &entry)) {
+        sli_si91x_rx_dispatch_handle((sl_si91x_rx_dispatch_queue_t)queue, &entry);
+      }
+    }
+  }
+
+  // Let sli_si91x_rx_dispatch_deinit() know no callback runs on this worker anymore
+  osSemaphoreRelease(sli_rx_dispatch_stopped);
+  osThreadExit();
+}
+#endif
+
+sl_status_t sli_si91x_rx_dispatch_init(void)
+{
+#if SL_SI91X_RX_DISPATCH_WORKER_COUNT > 0
+  for (uint8_t queue = 0; queue < SL_SI91X_RX_DISPATCH_QUEUE_COUNT; queue++) {
+    memset(&sli_rx_dispatch_rings[queue], 0, sizeof(sli_rx_dispatch_rings[queue]));
+    sli_rx_dispatch_rings[queue].configuration.depth           = SL_SI91X_RX_DISPATCH_DEFAULT_QUEUE_DEPTH;
+    sli_rx_dispatch_rings[queue].configuration.overload_policy = SL_SI91X_RX_DISPATCH_HOLD;
+  }
+
+  if (sli_rx_dispatch_stopped == NULL) {
+    sli_rx_dispatch_stopped = osSemaphoreNew(SLI_RX_DISPATCH_WORKERS, 0, NULL);
+    if (sli_rx_dispatch_stopped == NULL) {
+      return SL_STATUS_ALLOCATION_FAILED;
+    }
+  }
+
+  for (uint8_t worker = 0; worker < SLI_RX_DISPATCH_WORKERS; worker++) {
+    if (sli_rx_dispatch_workers[worker] != NULL) {
+      continue;
+    }
+    const osThreadAttr_t attr = {
+      .name       = "si91x_rx_dispatch",
+      .priority   = SL_SI91X_RX_DISPATCH_WORKER_PRIORITY,
+      .stack_mem  = 0,
+      .stack_size = SL_SI91X_RX_DISPATCH_WORKER_STACK_SIZE,
+      .cb_mem     = 0,
+      .cb_size    = 0,
+      .attr_bits  = 0u,
+      .tz_module  = 0u,
+    };
+    sli_rx_dispatch_workers[worker] =
+      osThreadNew(&sli_si91x_rx_dispatch_worker_thread, (void *)(uintptr_t)worker, &attr);
+    if (sli_rx_dispatch_workers[worker] == NULL) {
+      sli_si91x_rx_dispatch_deinit();
+      return SL_STATUS_ALLOCATION_FAILED;
+    }
+  }
+#endif
+  return SL_STATUS_OK;
+}
+
+void sli_si91x_rx_dispatch_deinit(void)
+{
+#if SL_SI91X_RX_DISPATCH_WORKER_COUNT > 0
+  sli_si91x_rx_dispatch_entry_t entry = { 0 };
+
+  // Ask every worker to stop, then wait until each one left the callback it may be running
+  for (uint8_t worker = 0; worker < SLI_RX_DISPATCH_WORKERS; worker++) {
+    if (sli_rx_dispatch_workers[worker] != NULL) {
+      osThreadFlagsSet(sli_rx_dispatch_workers[worker], SLI_RX_DISPATCH_STOP_FLAG);
+    }
+  }
+  for (uint8_t worker = 0; worker < SLI_RX_DISPATCH_WORKERS; worker++) {
+    if (sli_rx_dispatch_workers[worker] == NULL) {
+      continue;
+    }
+    // A worker stopping the dispatch from one of its callbacks exits once the callback returns
+    if (sli_rx_dispatch_workers[worker] != osThreadGetId()) {
+      osSemaphoreAcquire(sli_rx_dispatch_stopped, SLI_SYSTEM_MS_TO_TICKS(SLI_RX_DISPATCH_STOP_TIMEOUT_MS));
+    }
+    sli_rx_dispatch_workers[worker] = NULL;
+  }
+
+  // Free the events no worker will handle anymore
+  for (uint8_t queue = 0; queue < SL_SI91X_RX_DISPATCH_QUEUE_COUNT; queue++) {
+    sli_rx_dispatch_rings[queue].holding = false;
+    while (sli_si91x_rx_dispatch_pop((sl_si91x_rx_dispatch_queue_t)queue, &entry)) {
+      sli_si91x_rx_dispatch_discard((sl_si91x_rx_dispatch_queue_t)queue, entry.buffer);
     }
   }
+#endif
 }
+
+sl_status_t sl_si91x_set_rx_dispatch_queue_configuration(
+  sl_si91x_rx_dispatch_queue_t queue,
+  const sl_si91x_rx_dispatch_queue_configuration_t *configuration)
+{
+#if SL_SI91X_RX_DISPATCH_WORKER_COUNT > 0
+  SL_VERIFY_POINTER_OR_RETURN(configuration, SL_STATUS_NULL_POINTER);
+
+  if ((queue >= SL_SI91X_RX_DISPATCH_QUEUE_COUNT) || (configuration->depth == 0)
+      || (configuration->depth > SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH)
+      || (configuration->overload_policy > SL_SI91X_RX_DISPATCH_DROP_OLDEST)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  // Dropping part of a stream would corrupt it, so socket data can only be held back
+  if ((queue == SL_SI91X_RX_DISPATCH_SOCKET_DATA_QUEUE)
+      && (configuration->overload_policy != SL_SI91X_RX_DISPATCH_HOLD)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  sli_si91x_rx_dispatch_ring_t *ring = &sli_rx_dispatch_rings[queue];
+  CORE_irqState_t state              = CORE_EnterAtomic();
+  ring->configuration                = *configuration;
+  bool resume                        = ring->holding && (ring->count < ring->configuration.depth);
+  if (resume) {
+    ring->holding = false;
+  }
+  CORE_ExitAtomic(state);
+
+  // A larger queue may take the events held back right away
+  if (resume) {
+    set_async_event(sli_rx_dispatch_notification_events[queue]);
+  }
+  return SL_STATUS_OK;
+#else
+  UNUSED_PARAMETER(queue);
+  UNUSED_PARAMETER(configuration);
+  return SL_STATUS_NOT_SUPPORTED;
 #endif
+}
+
+sl_status_t sl_si91x_get_rx_dispatch_queue_statistics(sl_si91x_rx_dispatch_queue_t queue,
+                                                      sl_si91x_rx_dispatch_queue_statistics_t *statistics)
+{
+#if SL_SI91X_RX_DISPATCH_WORKER_COUNT > 0
+  SL_VERIFY_POINTER_OR_RETURN(statistics, SL_STATUS_NULL_POINTER);
+  if (queue >= SL_SI91X_RX_DISPATCH_QUEUE_COUNT) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  CORE_irqState_t state = CORE_EnterAtomic();
+  *statistics           = sli_rx_dispatch_rings[queue].statistics;
+  CORE_ExitAtomic(state);
+
+  // Latencies are accumulated in ticks
+  statistics->total_latency_ms = SLI_SYSTEM_TICKS_TO_MS(statistics->total_latency_ms);
+  statistics->max_latency_ms   = SLI_SYSTEM_TICKS_TO_MS(statistics->max_latency_ms);
+  return SL_STATUS_OK;
+#else
+  UNUSED_PARAMETER(queue);
+  UNUSED_PARAMETER(statistics);
+  return SL_STATUS_NOT_SUPPORTED;
+#endif
+}
+
+void sl_si91x_reset_rx_dispatch_statistics(void)
+{
+#if SL_SI91X_RX_DISPATCH_WORKER_COUNT > 0
+  CORE_irqState_t state = CORE_EnterAtomic();
+  for (uint8_t queue = 0; queue < SL_SI91X_RX_DISPATCH_QUEUE_COUNT; queue++) {
+    memset(&sli_rx_dispatch_rings[queue].statistics, 0, sizeof(sli_rx_dispatch_rings[queue].statistics));
+  }
+  CORE_ExitAtomic(state);
+#endif
+}
 
 uint32_t sli_wifi_command_engine_wait_for_event(uint32_t event_mask, uint32_t timeout)
 {
@@ -2039,24 +2805,28 @@ uint32_t sli_wifi_command_engine_set_event(uint32_t event_mask)
 
 void sli_wifi_handle_event(uint32_t *event)
 {
+  // Let the NWP sleep once a lingering TX wake lock saw no new data in time
+  if (sli_wake_lock_lingering && (sli_si91x_wake_lock_remaining_ticks() == 0)) {
+    sli_si91x_wake_lock_release();
+  }
+
 #ifndef SLI_SI91X_MCU_INTERFACE
   // Wake device, if needed
   if ((current_performance_profile != HIGH_PERFORMANCE)) {
-    while (sli_si91x_req_wakeup() != SL_STATUS_OK) {
+    while (sli_si91x_bus_wakeup() != SL_STATUS_OK) {
       osDelay(SLI_SYSTEM_MS_TO_TICKS(1));
     }
   }
 
-  if (sli_si91x_bus_read_interrupt_status(&interrupt_status) != SL_STATUS_OK) {
+  // Every event carries a fresh interrupt status, which also refreshes the TX credits
+  if (sli_si91x_read_interrupt_status() != SL_STATUS_OK) {
     return; // returning instead of continue.
   }
 
   // Check if there is no RX packet pending or the bus RX event is not set
   if (!((interrupt_status & SLI_RX_PKT_PENDING) || (*event & SL_SI91X_NCP_HOST_BUS_RX_EVENT))) {
-    if (current_performance_profile != HIGH_PERFORMANCE) {
-      // Clear the sleep indicator if the device is not in high-performance mode
-      sl_si91x_host_clear_sleep_indicator();
-    }
+    // Clear the sleep indicator if the device is not in high-performance mode
+    sli_si91x_bus_sleep();
   }
 #endif
 
@@ -2065,7 +2835,10 @@ void sli_wifi_handle_event(uint32_t *event)
   }
 
   if (*event & SL_SI91X_ALL_TX_PENDING_COMMAND_EVENTS) {
+    // Hold the NWP awake across the whole burst instead of a wakeup handshake around every frame
+    sli_si91x_wake_lock_acquire();
     sli_si91x_wifi_handle_tx_event(event);
+    sli_si91x_wake_lock_update(*event);
   }
 
   return;
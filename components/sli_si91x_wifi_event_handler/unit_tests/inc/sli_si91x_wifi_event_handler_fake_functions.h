@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#pragma once
+#include "fff.h"
+#include "cmsis_os2.h"
+#include "sl_core.h"
+#include "sl_si91x_host_interface.h"
+#include "sl_si91x_types.h"
+#include "sl_si91x_protocol_types.h"
+#include "sl_si91x_driver.h"
+#include "sl_rsi_utility.h"
+#include "sli_wifi_utility.h"
+#include "sl_si91x_socket_types.h"
+#include "sl_si91x_socket_utility.h"
+#include "sl_si91x_socket_epoll.h"
+#include "sl_net_si91x_integration_handler.h"
+
+// Not declared by the headers the event handler includes in this configuration
+sl_status_t sli_submit_rx_buffer(void);
+void sli_si91x_flush_third_party_station_dependent_sockets(const sli_si91x_ap_disconnect_resp_t *ap_disconnect_resp);
+extern sl_wifi_event_handler_t si91x_event_handler;
+extern sli_wifi_command_queue_t cmd_queues[SI91X_CMD_MAX];
+
+DECLARE_FAKE_VALUE_FUNC0(CORE_irqState_t, CORE_EnterAtomic);
+DECLARE_FAKE_VOID_FUNC1(CORE_ExitAtomic, CORE_irqState_t);
+DECLARE_FAKE_VALUE_FUNC1(osStatus_t, osDelay, uint32_t);
+DECLARE_FAKE_VALUE_FUNC2(uint32_t, osEventFlagsSet, osEventFlagsId_t, uint32_t);
+DECLARE_FAKE_VALUE_FUNC4(uint32_t, osEventFlagsWait, osEventFlagsId_t, uint32_t, uint32_t, uint32_t);
+DECLARE_FAKE_VALUE_FUNC0(uint32_t, osKernelGetTickCount);
+DECLARE_FAKE_VALUE_FUNC0(uint32_t, osKernelGetTickFreq);
+DECLARE_FAKE_VALUE_FUNC4(osStatus_t, osMessageQueueGet, osMessageQueueId_t, void *, uint8_t *, uint32_t);
+DECLARE_FAKE_VALUE_FUNC3(osSemaphoreId_t, osSemaphoreNew, uint32_t, uint32_t, const osSemaphoreAttr_t *);
+DECLARE_FAKE_VALUE_FUNC2(osStatus_t, osSemaphoreAcquire, osSemaphoreId_t, uint32_t);
+DECLARE_FAKE_VALUE_FUNC1(osStatus_t, osSemaphoreRelease, osSemaphoreId_t);
+DECLARE_FAKE_VALUE_FUNC2(uint32_t, osThreadFlagsSet, osThreadId_t, uint32_t);
+DECLARE_FAKE_VALUE_FUNC3(uint32_t, osThreadFlagsWait, uint32_t, uint32_t, uint32_t);
+DECLARE_FAKE_VALUE_FUNC0(osThreadId_t, osThreadGetId);
+DECLARE_FAKE_VALUE_FUNC3(osThreadId_t, osThreadNew, osThreadFunc_t, void *, const osThreadAttr_t *);
+DECLARE_FAKE_VOID_FUNC2(sl_net_si91x_event_dispatch_handler, sli_si91x_queue_packet_t *, sl_wifi_system_packet_t *);
+DECLARE_FAKE_VOID_FUNC0(sl_si91x_host_clear_sleep_indicator);
+DECLARE_FAKE_VALUE_FUNC1(sl_si91x_host_timestamp_t, sl_si91x_host_elapsed_time, uint32_t);
+DECLARE_FAKE_VOID_FUNC1(sli_command_engine_status_queue_enqueue_and_set_event, sl_status_t);
+DECLARE_FAKE_VALUE_FUNC2(sl_wifi_event_t, sli_convert_si91x_event_to_sl_wifi_event, uint32_t, uint16_t);
+DECLARE_FAKE_VOID_FUNC5(sli_flush_tx_packet,
+                        sli_wifi_command_queue_t *,
+                        sl_wifi_buffer_t *,
+                        sli_si91x_queue_packet_t *,
+                        uint16_t,
+                        uint32_t);
+DECLARE_FAKE_VOID_FUNC1(sli_handle_fwup_response, uint16_t);
+DECLARE_FAKE_VOID_FUNC2(sli_handle_nwp_log_packet, const uint8_t *, uint16_t);
+DECLARE_FAKE_VOID_FUNC1(sli_handle_wifi_beacon, sl_wifi_system_packet_t *);
+DECLARE_FAKE_VOID_FUNC0(sli_reset_coex_current_performance_profile);
+DECLARE_FAKE_VALUE_FUNC2(sl_status_t, sli_si91x_add_to_queue, sli_wifi_buffer_queue_t *, sl_wifi_buffer_t *);
+DECLARE_FAKE_VALUE_FUNC2(sl_status_t, sli_si91x_remove_from_queue, sli_wifi_buffer_queue_t *, sl_wifi_buffer_t **);
+DECLARE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_bus_read_frame, sl_wifi_buffer_t **);
+DECLARE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_bus_read_interrupt_status, uint16_t *);
+DECLARE_FAKE_VALUE_FUNC3(sl_status_t, sli_si91x_bus_write_frame, sl_wifi_system_packet_t *, const uint8_t *, uint16_t);
+DECLARE_FAKE_VOID_FUNC2(sli_si91x_epoll_notify, int, uint32_t);
+DECLARE_FAKE_VALUE_FUNC2(sl_status_t, sli_si91x_flush_all_socket_command_queues, uint16_t, uint8_t);
+DECLARE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_flush_all_socket_data_queues, uint8_t);
+DECLARE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_flush_all_tx_wifi_queues, uint16_t);
+DECLARE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_flush_select_request_table, uint16_t);
+DECLARE_FAKE_VOID_FUNC1(sli_si91x_flush_third_party_station_dependent_sockets, const sli_si91x_ap_disconnect_resp_t *);
+DECLARE_FAKE_VALUE_FUNC3(sli_si91x_socket_t *,
+                         sli_si91x_get_socket_from_id,
+                         int,
+                         sli_si91x_bsd_socket_state_t,
+                         int16_t);
+DECLARE_FAKE_VALUE_FUNC1(int, sli_si91x_get_socket_id, sl_wifi_system_packet_t *);
+DECLARE_FAKE_VOID_FUNC1(sli_si91x_set_socket_event, uint32_t);
+DECLARE_FAKE_VALUE_FUNC2(bool, sli_si91x_socket_deliver_received_data, int32_t, sl_wifi_buffer_t *);
+DECLARE_FAKE_VOID_FUNC1(sli_si91x_socket_release_tx_slot, sli_si91x_socket_t *);
+DECLARE_FAKE_VALUE_FUNC4(sl_status_t,
+                         sli_si91x_host_allocate_buffer,
+                         sl_wifi_buffer_t **,
+                         sl_wifi_buffer_type_t,
+                         uint32_t,
+                         uint32_t);
+DECLARE_FAKE_VOID_FUNC1(sli_si91x_host_free_buffer, sl_wifi_buffer_t *);
+DECLARE_FAKE_VALUE_FUNC1(uint32_t, sli_si91x_host_queue_status, const sli_wifi_buffer_queue_t *);
+DECLARE_FAKE_VALUE_FUNC0(sl_status_t, sli_si91x_req_wakeup);
+DECLARE_FAKE_VALUE_FUNC2(sl_status_t, sli_si91x_vap_shutdown, uint8_t, sli_si91x_bsd_disconnect_reason_t);
+DECLARE_FAKE_VALUE_FUNC2(uint32_t, sli_si91x_wait_for_event, uint32_t, uint32_t);
+DECLARE_FAKE_VALUE_FUNC0(sl_status_t, sli_submit_rx_buffer);
+DECLARE_FAKE_VOID_FUNC2(sli_wifi_append_to_buffer_queue, sli_wifi_buffer_queue_t *, sl_wifi_buffer_t *);
+DECLARE_FAKE_VOID_FUNC1(sli_wifi_get_current_performance_profile, sl_wifi_performance_profile_v2_t *);
+DECLARE_FAKE_VALUE_FUNC0(sl_wifi_operation_mode_t, sli_wifi_get_opermode);
+DECLARE_FAKE_VALUE_FUNC3(void *, sli_wifi_host_get_buffer_data, void *, uint16_t, uint16_t *);
+DECLARE_FAKE_VOID_FUNC1(sli_wifi_set_event, uint32_t);
+
+// osThreadExit() never returns, its fake ends the calling pthread
+extern unsigned int osThreadExit_call_count;
+
+// Custom fakes that give the queue and buffer fakes their real behaviour
+sl_status_t sli_si91x_remove_from_queue_custom_fake(sli_wifi_buffer_queue_t *queue, sl_wifi_buffer_t **buffer);
+void *sli_wifi_host_get_buffer_data_custom_fake(void *buffer, uint16_t offset, uint16_t *data_length);
@@ -0,0 +1,508 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "fff.h"
+
+extern "C" {
+#include "sli_si91x_wifi_event_handler_fake_functions.h"
+}
+
+#define TEST_WORKER_COUNT 4
+#define TEST_STOP_FLAG    (1UL << SL_SI91X_RX_DISPATCH_QUEUE_COUNT)
+#define TEST_WIFI_FLAG    (1UL << SL_SI91X_RX_DISPATCH_WIFI_QUEUE)
+#define TEST_WIFI_WORKER  0
+#define TEST_SOCKET_WORKER 2
+#define TEST_MAIN_THREAD  ((osThreadId_t)(uintptr_t)0xFF)
+
+// Notification of the WLAN event queue, as raised by the RX event thread
+#define TEST_WLAN_NOTIFICATION_EVENT (1 << SLI_WIFI_WLAN_CMD)
+
+// Notification of the data received on asynchronous sockets
+#define TEST_SOCKET_DATA_NOTIFICATION_EVENT (1 << SI91X_CMD_MAX)
+
+// Thread flags of the workers and the count of the stop semaphore, guarded so that a worker can run in a pthread
+static std::mutex os_mutex;
+static std::condition_variable os_condition;
+static uint32_t worker_flags[TEST_WORKER_COUNT];
+static bool worker_started[TEST_WORKER_COUNT];
+static osThreadFunc_t worker_function[TEST_WORKER_COUNT];
+static void *worker_argument[TEST_WORKER_COUNT];
+static uint32_t stopped_count;
+static bool stop_requested;
+static thread_local int current_worker = -1;
+
+// Wi-Fi events seen by the application, and whether the callback waits for the stop request before returning
+static std::vector<sl_wifi_buffer_t *> handled_events;
+static bool callback_waits_for_stop;
+
+// Buffers freed by the driver, so that a test can wait for a worker to drop an event
+static std::vector<sl_wifi_buffer_t *> freed_buffers;
+
+// Worker handles are the worker index plus one, so NULL still means no thread
+static osThreadId_t worker_handle(int worker)
+{
+  return (osThreadId_t)(uintptr_t)(worker + 1);
+}
+
+static osThreadId_t thread_new_record(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr)
+{
+  (void)attr;
+  int worker              = (int)(uintptr_t)argument;
+  worker_function[worker] = func;
+  worker_argument[worker] = argument;
+  return worker_handle(worker);
+}
+
+static uint32_t thread_flags_set(osThreadId_t thread_id, uint32_t flags)
+{
+  std::lock_guard<std::mutex> lock(os_mutex);
+  int worker = (int)(uintptr_t)thread_id - 1;
+  if (flags & TEST_STOP_FLAG) {
+    stop_requested = true;
+    // A worker that never ran has nothing to finish and stops right away
+    if (!worker_started[worker]) {
+      stopped_count++;
+      flags &= ~TEST_STOP_FLAG;
+    }
+  }
+  worker_flags[worker] |= flags;
+  os_condition.notify_all();
+  return worker_flags[worker];
+}
+
+static uint32_t thread_flags_wait(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  (void)options;
+  (void)timeout;
+  std::unique_lock<std::mutex> lock(os_mutex);
+  os_condition.wait(lock, [flags] {
+    return (worker_flags[current_worker] & flags) != 0;
+  });
+  uint32_t set = worker_flags[current_worker] & flags;
+  worker_flags[current_worker] &= ~set;
+  return set;
+}
+
+static osThreadId_t thread_get_id(void)
+{
+  return (current_worker < 0) ? TEST_MAIN_THREAD : worker_handle(current_worker);
+}
+
+static osStatus_t semaphore_acquire(osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+  (void)semaphore_id;
+  (void)timeout;
+  std::unique_lock<std::mutex> lock(os_mutex);
+  if (!os_condition.wait_for(lock, std::chrono::seconds(10), [] {
+        return stopped_count > 0;
+      })) {
+    return osErrorTimeout;
+  }
+  stopped_count--;
+  return osOK;
+}
+
+static osStatus_t semaphore_release(osSemaphoreId_t semaphore_id)
+{
+  (void)semaphore_id;
+  std::lock_guard<std::mutex> lock(os_mutex);
+  stopped_count++;
+  os_condition.notify_all();
+  return osOK;
+}
+
+static sl_status_t wifi_event_callback(sl_wifi_event_t event, sl_wifi_buffer_t *buffer)
+{
+  (void)event;
+  std::unique_lock<std::mutex> lock(os_mutex);
+  handled_events.push_back(buffer);
+  os_condition.notify_all();
+  if (callback_waits_for_stop) {
+    os_condition.wait(lock, [] {
+      return stop_requested;
+    });
+  }
+  return SL_STATUS_OK;
+}
+
+static void free_buffer_record(sl_wifi_buffer_t *buffer)
+{
+  std::lock_guard<std::mutex> lock(os_mutex);
+  freed_buffers.push_back(buffer);
+  os_condition.notify_all();
+}
+
+static void *worker_entry(void *args)
+{
+  current_worker = (int)(uintptr_t)args;
+  worker_function[current_worker](worker_argument[current_worker]);
+  return NULL;
+}
+
+class sli_si91x_rx_dispatch_test : public ::testing::Test {
+protected:
+  static std::vector<std::unique_ptr<uint8_t[]>> buffers;
+  pthread_t worker_thread;
+  bool worker_thread_started;
+
+  void SetUp() override
+  {
+    FFF_RESET_HISTORY();
+    RESET_FAKE(osThreadNew);
+    RESET_FAKE(osThreadFlagsSet);
+    RESET_FAKE(osThreadFlagsWait);
+    RESET_FAKE(osThreadGetId);
+    RESET_FAKE(osSemaphoreNew);
+    RESET_FAKE(osSemaphoreAcquire);
+    RESET_FAKE(osSemaphoreRelease);
+    RESET_FAKE(osEventFlagsSet);
+    RESET_FAKE(osKernelGetTickCount);
+    RESET_FAKE(sli_si91x_host_queue_status);
+    RESET_FAKE(sli_si91x_remove_from_queue);
+    RESET_FAKE(sli_si91x_host_free_buffer);
+    RESET_FAKE(sli_wifi_host_get_buffer_data);
+    RESET_FAKE(sli_convert_si91x_event_to_sl_wifi_event);
+    osKernelGetTickFreq_fake.return_val                      = 1000;
+    osSemaphoreNew_fake.return_val                           = (osSemaphoreId_t)&stopped_count;
+    osThreadNew_fake.custom_fake                             = thread_new_record;
+    osThreadFlagsSet_fake.custom_fake                        = thread_flags_set;
+    osThreadFlagsWait_fake.custom_fake                       = thread_flags_wait;
+    osThreadGetId_fake.custom_fake                           = thread_get_id;
+    osSemaphoreAcquire_fake.custom_fake                      = semaphore_acquire;
+    osSemaphoreRelease_fake.custom_fake                      = semaphore_release;
+    sli_si91x_host_queue_status_fake.custom_fake             = queue_status;
+    sli_si91x_remove_from_queue_fake.custom_fake             = sli_si91x_remove_from_queue_custom_fake;
+    sli_wifi_host_get_buffer_data_fake.custom_fake           = sli_wifi_host_get_buffer_data_custom_fake;
+    RESET_FAKE(sli_si91x_socket_deliver_received_data);
+    sli_convert_si91x_event_to_sl_wifi_event_fake.return_val = SL_WIFI_JOIN_EVENT;
+    si91x_event_handler                                      = wifi_event_callback;
+
+    memset(worker_flags, 0, sizeof(worker_flags));
+    memset(worker_started, 0, sizeof(worker_started));
+    stopped_count           = 0;
+    stop_requested          = false;
+    callback_waits_for_stop = false;
+    handled_events.clear();
+    freed_buffers.clear();
+    osThreadExit_call_count = 0;
+    worker_thread_started   = false;
+    memset(&cmd_queues[SLI_WIFI_WLAN_CMD].event_queue, 0, sizeof(cmd_queues[SLI_WIFI_WLAN_CMD].event_queue));
+
+    ASSERT_EQ(SL_STATUS_OK, sli_si91x_rx_dispatch_init());
+  }
+
+  void TearDown() override
+  {
+    sli_si91x_rx_dispatch_deinit();
+    if (worker_thread_started) {
+      pthread_join(worker_thread, NULL);
+    }
+    si91x_event_handler = NULL;
+    buffers.clear();
+  }
+
+  static uint32_t queue_status(const sli_wifi_buffer_queue_t *queue)
+  {
+    uint32_t count = 0;
+    for (const sl_wifi_buffer_t *buffer = queue->head; buffer != NULL;
+         buffer                         = (const sl_wifi_buffer_t *)buffer->node.node) {
+      count++;
+    }
+    return count;
+  }
+
+  // Queues Wi-Fi events on the driver's WLAN event queue, the way the RX path does
+  static std::vector<sl_wifi_buffer_t *> queue_wifi_events(uint8_t count)
+  {
+    std::vector<sl_wifi_buffer_t *> queued;
+    for (uint8_t n = 0; n < count; n++) {
+      buffers.emplace_back(new uint8_t[sizeof(sl_wifi_buffer_t) + sizeof(sl_wifi_system_packet_t)]());
+      sl_wifi_buffer_t *buffer = (sl_wifi_buffer_t *)buffers.back().get();
+      buffer->length           = sizeof(sl_wifi_system_packet_t);
+
+      sli_wifi_buffer_queue_t *queue = &cmd_queues[SLI_WIFI_WLAN_CMD].event_queue;
+      if (queue->tail == NULL) {
+        queue->head = buffer;
+      } else {
+        queue->tail->node.node = &buffer->node;
+      }
+      queue->tail = buffer;
+      queued.push_back(buffer);
+    }
+    return queued;
+  }
+
+  static void configure_wifi_queue(uint8_t depth, sl_si91x_rx_dispatch_overload_policy_t policy)
+  {
+    sl_si91x_rx_dispatch_queue_configuration_t configuration = { 0 };
+    configuration.depth                                      = depth;
+    configuration.overload_policy                            = policy;
+    ASSERT_EQ(SL_STATUS_OK,
+              sl_si91x_set_rx_dispatch_queue_configuration(SL_SI91X_RX_DISPATCH_WIFI_QUEUE, &configuration));
+  }
+
+  static sl_si91x_rx_dispatch_queue_statistics_t wifi_statistics(void)
+  {
+    sl_si91x_rx_dispatch_queue_statistics_t statistics = { 0 };
+    EXPECT_EQ(SL_STATUS_OK, sl_si91x_get_rx_dispatch_queue_statistics(SL_SI91X_RX_DISPATCH_WIFI_QUEUE, &statistics));
+    return statistics;
+  }
+
+  // Runs one dispatch worker in a pthread, as the RTOS would
+  void start_worker(int worker)
+  {
+    {
+      std::lock_guard<std::mutex> lock(os_mutex);
+      worker_started[worker] = true;
+    }
+    ASSERT_EQ(0, pthread_create(&worker_thread, NULL, worker_entry, (void *)(uintptr_t)worker));
+    worker_thread_started = true;
+  }
+
+  void start_wifi_worker(void)
+  {
+    start_worker(TEST_WIFI_WORKER);
+  }
+
+  // Queues one data buffer on the receive queue of a socket, the way the RX path does
+  static sl_wifi_buffer_t *queue_socket_data(sli_si91x_socket_t *socket)
+  {
+    buffers.emplace_back(new uint8_t[sizeof(sl_wifi_buffer_t)]());
+    sl_wifi_buffer_t *buffer = (sl_wifi_buffer_t *)buffers.back().get();
+    socket->rx_data_queue.head = buffer;
+    socket->rx_data_queue.tail = buffer;
+    return buffer;
+  }
+
+  static void wait_for_freed_buffers(size_t count)
+  {
+    std::unique_lock<std::mutex> lock(os_mutex);
+    ASSERT_TRUE(os_condition.wait_for(lock, std::chrono::seconds(10), [count] {
+      return freed_buffers.size() >= count;
+    }));
+  }
+
+  static void wait_for_handled_events(size_t count)
+  {
+    std::unique_lock<std::mutex> lock(os_mutex);
+    ASSERT_TRUE(os_condition.wait_for(lock, std::chrono::seconds(10), [count] {
+      return handled_events.size() >= count;
+    }));
+  }
+
+  static bool freed(const sl_wifi_buffer_t *buffer)
+  {
+    for (unsigned int i = 0; i < sli_si91x_host_free_buffer_fake.call_count; i++) {
+      if (sli_si91x_host_free_buffer_fake.arg0_history[i] == buffer) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+std::vector<std::unique_ptr<uint8_t[]>> sli_si91x_rx_dispatch_test::buffers;
+
+// Test case: Notified events move from the driver queue to the dispatch queue and wake the worker that serves it
+TEST_F(sli_si91x_rx_dispatch_test, EventsAreQueuedForTheirWorker)
+{
+  queue_wifi_events(2);
+
+  sli_si91x_rx_dispatch_events(TEST_WLAN_NOTIFICATION_EVENT);
+
+  EXPECT_EQ(NULL, cmd_queues[SLI_WIFI_WLAN_CMD].event_queue.head);
+  EXPECT_EQ(2u, osThreadFlagsSet_fake.call_count);
+  EXPECT_EQ(worker_handle(TEST_WIFI_WORKER), osThreadFlagsSet_fake.arg0_val);
+  EXPECT_EQ(TEST_WIFI_FLAG, osThreadFlagsSet_fake.arg1_val);
+  EXPECT_EQ(2u, wifi_statistics().high_watermark);
+  EXPECT_EQ(0u, sli_si91x_host_free_buffer_fake.call_count);
+}
+
+// Test case: The worker runs the application callback, and the stop request waits until the callback returned
+TEST_F(sli_si91x_rx_dispatch_test, DeinitJoinsWorkerAfterRunningCallback)
+{
+  std::vector<sl_wifi_buffer_t *> events = queue_wifi_events(1);
+  callback_waits_for_stop                = true;
+  sli_si91x_rx_dispatch_events(TEST_WLAN_NOTIFICATION_EVENT);
+  start_wifi_worker();
+  wait_for_handled_events(1);
+
+  sli_si91x_rx_dispatch_deinit();
+
+  // The worker left the callback and freed the event before it reported that it stopped
+  EXPECT_TRUE(freed(events[0]));
+  EXPECT_EQ(TEST_WORKER_COUNT, (int)osSemaphoreAcquire_fake.call_count);
+  EXPECT_EQ(1u, osSemaphoreRelease_fake.call_count);
+  pthread_join(worker_thread, NULL);
+  worker_thread_started            = false;
+  worker_started[TEST_WIFI_WORKER] = false;
+  EXPECT_EQ(1u, osThreadExit_call_count);
+  EXPECT_EQ(0u, stopped_count);
+
+  // Every worker handle was released, so starting again creates all workers anew
+  EXPECT_EQ(SL_STATUS_OK, sli_si91x_rx_dispatch_init());
+  EXPECT_EQ(2 * TEST_WORKER_COUNT, (int)osThreadNew_fake.call_count);
+}
+
+// Test case: A full queue with the hold policy leaves the event with the driver until the worker makes room
+TEST_F(sli_si91x_rx_dispatch_test, HoldLeavesEventWithDriverUntilThereIsRoom)
+{
+  configure_wifi_queue(2, SL_SI91X_RX_DISPATCH_HOLD);
+  std::vector<sl_wifi_buffer_t *> events = queue_wifi_events(3);
+
+  sli_si91x_rx_dispatch_events(TEST_WLAN_NOTIFICATION_EVENT);
+
+  EXPECT_EQ(events[2], cmd_queues[SLI_WIFI_WLAN_CMD].event_queue.head);
+  EXPECT_EQ(1u, wifi_statistics().held);
+  EXPECT_EQ(0u, osEventFlagsSet_fake.call_count);
+
+  start_wifi_worker();
+  wait_for_handled_events(2);
+
+  // Taking the first event resumes the RX event thread, which then queues the held event
+  EXPECT_EQ(1u, osEventFlagsSet_fake.call_count);
+  EXPECT_EQ((uint32_t)TEST_WLAN_NOTIFICATION_EVENT, osEventFlagsSet_fake.arg1_val);
+  EXPECT_EQ(0u, wifi_statistics().dropped);
+}
+
+// Test case: A full queue with the drop newest policy frees the incoming events
+TEST_F(sli_si91x_rx_dispatch_test, DropNewestFreesIncomingEvents)
+{
+  configure_wifi_queue(1, SL_SI91X_RX_DISPATCH_DROP_NEWEST);
+  std::vector<sl_wifi_buffer_t *> events = queue_wifi_events(3);
+
+  sli_si91x_rx_dispatch_events(TEST_WLAN_NOTIFICATION_EVENT);
+
+  EXPECT_EQ(NULL, cmd_queues[SLI_WIFI_WLAN_CMD].event_queue.head);
+  EXPECT_FALSE(freed(events[0]));
+  EXPECT_TRUE(freed(events[1]));
+  EXPECT_TRUE(freed(events[2]));
+  EXPECT_EQ(2u, wifi_statistics().dropped);
+  EXPECT_EQ(1u, osThreadFlagsSet_fake.call_count);
+}
+
+// Test case: A full queue with the drop oldest policy frees the oldest queued event to make room
+TEST_F(sli_si91x_rx_dispatch_test, DropOldestFreesOldestEvent)
+{
+  configure_wifi_queue(2, SL_SI91X_RX_DISPATCH_DROP_OLDEST);
+  std::vector<sl_wifi_buffer_t *> events = queue_wifi_events(3);
+
+  sli_si91x_rx_dispatch_events(TEST_WLAN_NOTIFICATION_EVENT);
+
+  EXPECT_EQ(NULL, cmd_queues[SLI_WIFI_WLAN_CMD].event_queue.head);
+  EXPECT_EQ(1u, sli_si91x_host_free_buffer_fake.call_count);
+  EXPECT_EQ(events[0], sli_si91x_host_free_buffer_fake.arg0_val);
+  EXPECT_EQ(1u, wifi_statistics().dropped);
+
+  // Stopping the dispatch frees the events no worker handled
+  sli_si91x_rx_dispatch_deinit();
+  EXPECT_TRUE(freed(events[1]));
+  EXPECT_TRUE(freed(events[2]));
+  EXPECT_TRUE(handled_events.empty());
+}
+
+// Test case: Out of range configurations are refused, and socket data can only be held back
+TEST_F(sli_si91x_rx_dispatch_test, ConfigurationIsValidated)
+{
+  sl_si91x_rx_dispatch_queue_configuration_t configuration = { 0 };
+  configuration.depth                                      = 1;
+  configuration.overload_policy                            = SL_SI91X_RX_DISPATCH_DROP_NEWEST;
+
+  EXPECT_EQ(SL_STATUS_NULL_POINTER,
+            sl_si91x_set_rx_dispatch_queue_configuration(SL_SI91X_RX_DISPATCH_WIFI_QUEUE, NULL));
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER,
+            sl_si91x_set_rx_dispatch_queue_configuration(SL_SI91X_RX_DISPATCH_QUEUE_COUNT, &configuration));
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER,
+            sl_si91x_set_rx_dispatch_queue_configuration(SL_SI91X_RX_DISPATCH_SOCKET_DATA_QUEUE, &configuration));
+
+  configuration.overload_policy = SL_SI91X_RX_DISPATCH_HOLD;
+  EXPECT_EQ(SL_STATUS_OK,
+            sl_si91x_set_rx_dispatch_queue_configuration(SL_SI91X_RX_DISPATCH_SOCKET_DATA_QUEUE, &configuration));
+
+  configuration.depth = 0;
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER,
+            sl_si91x_set_rx_dispatch_queue_configuration(SL_SI91X_RX_DISPATCH_WIFI_QUEUE, &configuration));
+  configuration.depth = SL_SI91X_RX_DISPATCH_MAX_QUEUE_DEPTH + 1;
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER,
+            sl_si91x_set_rx_dispatch_queue_configuration(SL_SI91X_RX_DISPATCH_WIFI_QUEUE, &configuration));
+}
+
+// Test case: Resetting the statistics clears the counters of every queue
+TEST_F(sli_si91x_rx_dispatch_test, ResetClearsStatistics)
+{
+  configure_wifi_queue(1, SL_SI91X_RX_DISPATCH_DROP_NEWEST);
+  queue_wifi_events(2);
+  sli_si91x_rx_dispatch_events(TEST_WLAN_NOTIFICATION_EVENT);
+  ASSERT_EQ(1u, wifi_statistics().dropped);
+
+  sl_si91x_reset_rx_dispatch_statistics();
+
+  sl_si91x_rx_dispatch_queue_statistics_t statistics = wifi_statistics();
+  EXPECT_EQ(0u, statistics.dropped);
+  EXPECT_EQ(0u, statistics.high_watermark);
+  EXPECT_EQ(0u, statistics.dispatched);
+}
+
+// Test case: Data queued for a socket that is closed before it is dispatched is dropped, not given to the new socket
+TEST_F(sli_si91x_rx_dispatch_test, DataOfClosedSocketIsNotDeliveredToReusedIndex)
+{
+  sli_si91x_socket_t closed_socket = {};
+  sli_si91x_socket_t open_socket   = {};
+  sli_si91x_sockets[1]             = &closed_socket;
+  sli_si91x_sockets[2]             = &open_socket;
+  sl_wifi_buffer_t *stale_data     = queue_socket_data(&closed_socket);
+  sl_wifi_buffer_t *data           = queue_socket_data(&open_socket);
+  sli_si91x_host_free_buffer_fake.custom_fake = free_buffer_record;
+
+  sli_si91x_rx_dispatch_events(TEST_SOCKET_DATA_NOTIFICATION_EVENT);
+
+  // Index 1 is closed and handed to a new socket while its data waits for the worker
+  sli_si91x_socket_t new_socket = {};
+  sli_si91x_socket_generations[1]++;
+  sli_si91x_sockets[1] = &new_socket;
+
+  start_worker(TEST_SOCKET_WORKER);
+  wait_for_freed_buffers(2);
+
+  EXPECT_EQ(1u, sli_si91x_socket_deliver_received_data_fake.call_count);
+  EXPECT_EQ(2, sli_si91x_socket_deliver_received_data_fake.arg0_val);
+  EXPECT_EQ(data, sli_si91x_socket_deliver_received_data_fake.arg1_val);
+  EXPECT_TRUE(freed(stale_data));
+
+  sli_si91x_sockets[1] = NULL;
+  sli_si91x_sockets[2] = NULL;
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <pthread.h>
+#include "sli_si91x_wifi_event_handler_fake_functions.h"
+
+DEFINE_FFF_GLOBALS;
+
+DEFINE_FAKE_VALUE_FUNC0(CORE_irqState_t, CORE_EnterAtomic);
+DEFINE_FAKE_VOID_FUNC1(CORE_ExitAtomic, CORE_irqState_t);
+DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osDelay, uint32_t);
+DEFINE_FAKE_VALUE_FUNC2(uint32_t, osEventFlagsSet, osEventFlagsId_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC4(uint32_t, osEventFlagsWait, osEventFlagsId_t, uint32_t, uint32_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC0(uint32_t, osKernelGetTickCount);
+DEFINE_FAKE_VALUE_FUNC0(uint32_t, osKernelGetTickFreq);
+DEFINE_FAKE_VALUE_FUNC4(osStatus_t, osMessageQueueGet, osMessageQueueId_t, void *, uint8_t *, uint32_t);
+DEFINE_FAKE_VALUE_FUNC3(osSemaphoreId_t, osSemaphoreNew, uint32_t, uint32_t, const osSemaphoreAttr_t *);
+DEFINE_FAKE_VALUE_FUNC2(osStatus_t, osSemaphoreAcquire, osSemaphoreId_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osSemaphoreRelease, osSemaphoreId_t);
+DEFINE_FAKE_VALUE_FUNC2(uint32_t, osThreadFlagsSet, osThreadId_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC3(uint32_t, osThreadFlagsWait, uint32_t, uint32_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC0(osThreadId_t, osThreadGetId);
+DEFINE_FAKE_VALUE_FUNC3(osThreadId_t, osThreadNew, osThreadFunc_t, void *, const osThreadAttr_t *);
+DEFINE_FAKE_VOID_FUNC2(sl_net_si91x_event_dispatch_handler, sli_si91x_queue_packet_t *, sl_wifi_system_packet_t *);
+DEFINE_FAKE_VOID_FUNC0(sl_si91x_host_clear_sleep_indicator);
+DEFINE_FAKE_VALUE_FUNC1(sl_si91x_host_timestamp_t, sl_si91x_host_elapsed_time, uint32_t);
+DEFINE_FAKE_VOID_FUNC1(sli_command_engine_status_queue_enqueue_and_set_event, sl_status_t);
+DEFINE_FAKE_VALUE_FUNC2(sl_wifi_event_t, sli_convert_si91x_event_to_sl_wifi_event, uint32_t, uint16_t);
+DEFINE_FAKE_VOID_FUNC5(sli_flush_tx_packet,
+                       sli_wifi_command_queue_t *,
+                       sl_wifi_buffer_t *,
+                       sli_si91x_queue_packet_t *,
+                       uint16_t,
+                       uint32_t);
+DEFINE_FAKE_VOID_FUNC1(sli_handle_fwup_response, uint16_t);
+DEFINE_FAKE_VOID_FUNC2(sli_handle_nwp_log_packet, const uint8_t *, uint16_t);
+DEFINE_FAKE_VOID_FUNC1(sli_handle_wifi_beacon, sl_wifi_system_packet_t *);
+DEFINE_FAKE_VOID_FUNC0(sli_reset_coex_current_performance_profile);
+DEFINE_FAKE_VALUE_FUNC2(sl_status_t, sli_si91x_add_to_queue, sli_wifi_buffer_queue_t *, sl_wifi_buffer_t *);
+DEFINE_FAKE_VALUE_FUNC2(sl_status_t, sli_si91x_remove_from_queue, sli_wifi_buffer_queue_t *, sl_wifi_buffer_t **);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_bus_read_frame, sl_wifi_buffer_t **);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_bus_read_interrupt_status, uint16_t *);
+DEFINE_FAKE_VALUE_FUNC3(sl_status_t, sli_si91x_bus_write_frame, sl_wifi_system_packet_t *, const uint8_t *, uint16_t);
+DEFINE_FAKE_VOID_FUNC2(sli_si91x_epoll_notify, int, uint32_t);
+DEFINE_FAKE_VALUE_FUNC2(sl_status_t, sli_si91x_flush_all_socket_command_queues, uint16_t, uint8_t);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_flush_all_socket_data_queues, uint8_t);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_flush_all_tx_wifi_queues, uint16_t);
+DEFINE_FAKE_VALUE_FUNC1(sl_status_t, sli_si91x_flush_select_request_table, uint16_t);
+DEFINE_FAKE_VOID_FUNC1(sli_si91x_flush_third_party_station_dependent_sockets, const sli_si91x_ap_disconnect_resp_t *);
+DEFINE_FAKE_VALUE_FUNC3(sli_si91x_socket_t *,
+                        sli_si91x_get_socket_from_id,
+                        int,
+                        sli_si91x_bsd_socket_state_t,
+                        int16_t);
+DEFINE_FAKE_VALUE_FUNC1(int, sli_si91x_get_socket_id, sl_wifi_system_packet_t *);
+DEFINE_FAKE_VOID_FUNC1(sli_si91x_set_socket_event, uint32_t);
+DEFINE_FAKE_VALUE_FUNC2(bool, sli_si91x_socket_deliver_received_data, int32_t, sl_wifi_buffer_t *);
+DEFINE_FAKE_VOID_FUNC1(sli_si91x_socket_release_tx_slot, sli_si91x_socket_t *);
+DEFINE_FAKE_VALUE_FUNC4(sl_status_t,
+                        sli_si91x_host_allocate_buffer,
+                        sl_wifi_buffer_t **,
+                        sl_wifi_buffer_type_t,
+                        uint32_t,
+                        uint32_t);
+DEFINE_FAKE_VOID_FUNC1(sli_si91x_host_free_buffer, sl_wifi_buffer_t *);
+DEFINE_FAKE_VALUE_FUNC1(uint32_t, sli_si91x_host_queue_status, const sli_wifi_buffer_queue_t *);
+DEFINE_FAKE_VALUE_FUNC0(sl_status_t, sli_si91x_req_wakeup);
+DEFINE_FAKE_VALUE_FUNC2(sl_status_t, sli_si91x_vap_shutdown, uint8_t, sli_si91x_bsd_disconnect_reason_t);
+DEFINE_FAKE_VALUE_FUNC2(uint32_t, sli_si91x_wait_for_event, uint32_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC0(sl_status_t, sli_submit_rx_buffer);
+DEFINE_FAKE_VOID_FUNC2(sli_wifi_append_to_buffer_queue, sli_wifi_buffer_queue_t *, sl_wifi_buffer_t *);
+DEFINE_FAKE_VOID_FUNC1(sli_wifi_get_current_performance_profile, sl_wifi_performance_profile_v2_t *);
+DEFINE_FAKE_VALUE_FUNC0(sl_wifi_operation_mode_t, sli_wifi_get_opermode);
+DEFINE_FAKE_VALUE_FUNC3(void *, sli_wifi_host_get_buffer_data, void *, uint16_t, uint16_t *);
+DEFINE_FAKE_VOID_FUNC1(sli_wifi_set_event, uint32_t);
+
+// Globals owned by the driver, the socket layer and the command engine
+bool bg_enabled                                                  = false;
+sl_wifi_event_handler_t si91x_event_handler                      = NULL;
+sl_wifi_system_performance_profile_t current_performance_profile = HIGH_PERFORMANCE;
+sli_wifi_command_queue_t cmd_queues[SI91X_CMD_MAX];
+sli_wifi_buffer_queue_t sli_tx_data_queue;
+osEventFlagsId_t si91x_async_events;
+osMessageQueueId_t sli_command_engine_status_msg_queue;
+sli_si91x_socket_t *sli_si91x_sockets[SLI_NUMBER_OF_SOCKETS];
+uint8_t sli_si91x_socket_generations[SLI_NUMBER_OF_SOCKETS];
+
+unsigned int osThreadExit_call_count;
+
+void osThreadExit(void)
+{
+  __atomic_fetch_add(&osThreadExit_call_count, 1, __ATOMIC_SEQ_CST);
+  pthread_exit(NULL);
+}
+
+sl_status_t sli_si91x_remove_from_queue_custom_fake(sli_wifi_buffer_queue_t *queue, sl_wifi_buffer_t **buffer)
+{
+  if (queue->head == NULL) {
+    return SL_STATUS_EMPTY;
+  }
+  *buffer     = queue->head;
+  queue->head = (sl_wifi_buffer_t *)queue->head->node.node;
+  if (queue->head == NULL) {
+    queue->tail = NULL;
+  }
+  (*buffer)->node.node = NULL;
+  return SL_STATUS_OK;
+}
+
+void *sli_wifi_host_get_buffer_data_custom_fake(void *buffer, uint16_t offset, uint16_t *data_length)
+{
+  sl_wifi_buffer_t *wifi_buffer = (sl_wifi_buffer_t *)buffer;
+  if (offset >= wifi_buffer->length) {
+    return NULL;
+  }
+  if (data_length != NULL) {
+    *data_length = (uint16_t)(wifi_buffer->length - offset);
+  }
+  return &wifi_buffer->data[offset];
+}
@@ -0,0 +1,288 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "fff.h"
+
+extern "C" {
+#include "sli_si91x_wifi_event_handler_fake_functions.h"
+void sli_wifi_handle_event(uint32_t *event);
+}
+
+// One quantum per frame, so a socket of weight 1 writes exactly one frame per turn
+#define TEST_FRAME_LENGTH SLI_SI91X_SOCKET_TX_QUANTUM
+
+// Socket of each data frame written to the bus, in write order
+static std::vector<uint8_t> written_frames;
+// Called after each data frame is written, lets a test queue more data while a pass is running
+static void (*on_frame_written)(uint8_t socket) = nullptr;
+
+static sl_status_t bus_write_frame_record(sl_wifi_system_packet_t *packet, const uint8_t *payload, uint16_t length)
+{
+  (void)payload;
+  (void)length;
+  written_frames.push_back(packet->data[0]);
+  if (on_frame_written != nullptr) {
+    on_frame_written(packet->data[0]);
+  }
+  return SL_STATUS_OK;
+}
+
+static sl_status_t read_interrupt_status_idle(uint16_t *interrupt_status)
+{
+  *interrupt_status = 0;
+  return SL_STATUS_OK;
+}
+
+// The NWP has room for one frame, then reports its buffer full
+static sl_status_t read_interrupt_status_one_free(uint16_t *interrupt_status)
+{
+  *interrupt_status = (sli_si91x_bus_read_interrupt_status_fake.call_count > 1) ? SLI_WIFI_BUFFER_FULL : 0;
+  return SL_STATUS_OK;
+}
+
+// The first read reports room for one frame, every later read fails
+static sl_status_t read_interrupt_status_then_fail(uint16_t *interrupt_status)
+{
+  if (sli_si91x_bus_read_interrupt_status_fake.call_count > 1) {
+    return SL_STATUS_FAIL;
+  }
+  *interrupt_status = 0;
+  return SL_STATUS_OK;
+}
+
+class sli_si91x_wifi_event_handler_test : public ::testing::Test {
+protected:
+  static sli_si91x_socket_t sockets[4];
+  static std::vector<std::unique_ptr<uint8_t[]>> buffers;
+
+  void SetUp() override
+  {
+    FFF_RESET_HISTORY();
+    RESET_FAKE(sli_si91x_bus_write_frame);
+    RESET_FAKE(sli_si91x_bus_read_interrupt_status);
+    RESET_FAKE(sli_si91x_remove_from_queue);
+    RESET_FAKE(sli_wifi_host_get_buffer_data);
+    RESET_FAKE(sli_si91x_socket_release_tx_slot);
+    RESET_FAKE(sli_si91x_epoll_notify);
+    RESET_FAKE(sli_si91x_req_wakeup);
+    RESET_FAKE(sl_si91x_host_clear_sleep_indicator);
+    RESET_FAKE(osKernelGetTickCount);
+    osKernelGetTickFreq_fake.return_val = 1000;
+    sli_si91x_bus_write_frame_fake.custom_fake           = bus_write_frame_record;
+    sli_si91x_bus_read_interrupt_status_fake.custom_fake = read_interrupt_status_idle;
+    sli_si91x_remove_from_queue_fake.custom_fake         = sli_si91x_remove_from_queue_custom_fake;
+    sli_wifi_host_get_buffer_data_fake.custom_fake       = sli_wifi_host_get_buffer_data_custom_fake;
+
+    current_performance_profile  = HIGH_PERFORMANCE;
+    tx_socket_data_queues_status = 0;
+    written_frames.clear();
+    on_frame_written = nullptr;
+
+    memset(sockets, 0, sizeof(sockets));
+    for (uint8_t i = 0; i < 4; i++) {
+      sockets[i].tx_priority = SL_SI91X_SOCKET_TX_PRIORITY_NORMAL;
+      sli_si91x_sockets[i]   = &sockets[i];
+    }
+  }
+
+  void TearDown() override
+  {
+    for (uint8_t i = 0; i < 4; i++) {
+      sli_si91x_sockets[i] = NULL;
+    }
+    buffers.clear();
+  }
+
+  // Queues data frames on a socket the way the socket layer does
+  static void queue_frames(uint8_t socket, uint8_t count)
+  {
+    for (uint8_t n = 0; n < count; n++) {
+      size_t size = sizeof(sl_wifi_buffer_t) + sizeof(sl_wifi_system_packet_t) + TEST_FRAME_LENGTH;
+      buffers.emplace_back(new uint8_t[size]());
+      sl_wifi_buffer_t *buffer        = (sl_wifi_buffer_t *)buffers.back().get();
+      buffer->length                  = sizeof(sl_wifi_system_packet_t) + TEST_FRAME_LENGTH;
+      sl_wifi_system_packet_t *packet = (sl_wifi_system_packet_t *)buffer->data;
+      packet->length                  = TEST_FRAME_LENGTH;
+      packet->data[0]                 = socket;
+
+      sli_wifi_buffer_queue_t *queue = &sockets[socket].tx_data_queue;
+      if (queue->tail == NULL) {
+        queue->head = buffer;
+      } else {
+        queue->tail->node.node = &buffer->node;
+      }
+      queue->tail = buffer;
+    }
+    tx_socket_data_queues_status |= (1 << socket);
+  }
+
+  static void run_tx_pass(void)
+  {
+    uint32_t event = SL_SI91X_SOCKET_DATA_TX_PENDING_EVENT;
+    sli_wifi_handle_event(&event);
+  }
+};
+
+sli_si91x_socket_t sli_si91x_wifi_event_handler_test::sockets[4];
+std::vector<std::unique_ptr<uint8_t[]>> sli_si91x_wifi_event_handler_test::buffers;
+
+// Test case: A higher class is drained before any frame of a lower class is written
+TEST_F(sli_si91x_wifi_event_handler_test, HigherClassDrainsFirst)
+{
+  sockets[0].tx_priority = SL_SI91X_SOCKET_TX_PRIORITY_LOW;
+  sockets[1].tx_priority = SL_SI91X_SOCKET_TX_PRIORITY_NORMAL;
+  sockets[2].tx_priority = SL_SI91X_SOCKET_TX_PRIORITY_HIGH;
+  queue_frames(0, 3);
+  queue_frames(1, 3);
+  queue_frames(2, 3);
+
+  run_tx_pass();
+
+  std::vector<uint8_t> expected = { 2, 2, 2, 1, 1, 1, 0, 0, 0 };
+  EXPECT_EQ(written_frames, expected);
+  EXPECT_EQ(tx_socket_data_queues_status, 0U);
+}
+
+// Test case: Data queued on a higher class while a lower class is being served preempts it at the next turn
+TEST_F(sli_si91x_wifi_event_handler_test, HigherClassPreemptsLowerClass)
+{
+  sockets[0].tx_priority = SL_SI91X_SOCKET_TX_PRIORITY_LOW;
+  sockets[3].tx_priority = SL_SI91X_SOCKET_TX_PRIORITY_HIGH;
+  queue_frames(0, 3);
+  on_frame_written = [](uint8_t socket) {
+    if (socket == 0 && written_frames.size() == 1) {
+      queue_frames(3, 2);
+    }
+  };
+
+  run_tx_pass();
+
+  std::vector<uint8_t> expected = { 0, 3, 3, 0, 0 };
+  EXPECT_EQ(written_frames, expected);
+}
+
+// Test case: Sockets of the same class take turns, one quantum each
+TEST_F(sli_si91x_wifi_event_handler_test, SameClassSharesRoundRobin)
+{
+  queue_frames(1, 3);
+  queue_frames(2, 3);
+
+  run_tx_pass();
+
+  ASSERT_EQ(written_frames.size(), 6U);
+  for (size_t n = 1; n < written_frames.size(); n++) {
+    EXPECT_NE(written_frames[n], written_frames[n - 1]);
+  }
+}
+
+// Test case: Within a class a socket's share follows its weight
+TEST_F(sli_si91x_wifi_event_handler_test, SameClassSharesByWeight)
+{
+  sockets[1].tx_weight = 2;
+  sockets[2].tx_weight = 1;
+  queue_frames(1, 6);
+  queue_frames(2, 3);
+
+  run_tx_pass();
+
+  ASSERT_EQ(written_frames.size(), 9U);
+  // Each turn of the heavier socket writes two frames, the lighter socket one
+  size_t run = 0;
+  for (size_t n = 0; n < written_frames.size(); n++) {
+    if (written_frames[n] == 1) {
+      run++;
+      continue;
+    }
+    if (run != 0) {
+      EXPECT_EQ(run, 2U);
+    }
+    run = 0;
+  }
+}
+
+// Test case: A clear buffer-full bit grants a single frame, the next one waits for a fresh interrupt status
+TEST_F(sli_si91x_wifi_event_handler_test, BufferFreeIndicationGrantsOneFrame)
+{
+  sli_si91x_bus_read_interrupt_status_fake.custom_fake = read_interrupt_status_one_free;
+  queue_frames(1, 3);
+
+  run_tx_pass();
+
+  EXPECT_EQ(written_frames.size(), 1U);
+  EXPECT_EQ(sli_si91x_bus_read_interrupt_status_fake.call_count, 2U);
+  EXPECT_EQ(tx_socket_data_queues_status, (1U << 1));
+
+  // Once the NWP frees its buffer the rest of the queue follows, one status read per frame
+  sli_si91x_bus_read_interrupt_status_fake.custom_fake = read_interrupt_status_idle;
+  sli_si91x_bus_read_interrupt_status_fake.call_count  = 0;
+  run_tx_pass();
+
+  EXPECT_EQ(written_frames.size(), 3U);
+  EXPECT_EQ(sli_si91x_bus_read_interrupt_status_fake.call_count, 2U);
+}
+
+// Test case: A failed interrupt status read writes nothing and does not wrap the credit count
+TEST_F(sli_si91x_wifi_event_handler_test, FailedStatusReadStopsTx)
+{
+  sli_si91x_bus_read_interrupt_status_fake.custom_fake = read_interrupt_status_then_fail;
+  queue_frames(1, 3);
+
+  run_tx_pass();
+
+  EXPECT_EQ(written_frames.size(), 1U);
+  EXPECT_EQ(tx_socket_data_queues_status, (1U << 1));
+}
+
+// Test case: A burst under one wakeup stops at the wake lock budget and the rest waits for a fresh wakeup
+TEST_F(sli_si91x_wifi_event_handler_test, WakeLockBudgetBoundsBurst)
+{
+  current_performance_profile = ASSOCIATED_POWER_SAVE;
+  queue_frames(1, SLI_SI91X_WAKE_LOCK_TX_BUDGET + 8);
+
+  run_tx_pass();
+
+  EXPECT_EQ(written_frames.size(), (size_t)SLI_SI91X_WAKE_LOCK_TX_BUDGET);
+  EXPECT_EQ(tx_socket_data_queues_status, (1U << 1));
+
+  unsigned int wakeups = sli_si91x_req_wakeup_fake.call_count;
+  run_tx_pass();
+
+  EXPECT_EQ(written_frames.size(), (size_t)SLI_SI91X_WAKE_LOCK_TX_BUDGET + 8);
+  EXPECT_GT(sli_si91x_req_wakeup_fake.call_count, wakeups);
+  EXPECT_EQ(tx_socket_data_queues_status, 0U);
+
+  // Let the lock that lingers after the drained burst expire
+  osKernelGetTickCount_fake.return_val = SLI_SI91X_WAKE_LOCK_LINGER_MS + 1;
+  uint32_t event                       = 0;
+  sli_wifi_handle_event(&event);
+}
@@ -0,0 +1,67 @@
+/***************************************************************************/ /**
+ * @file    sli_wifi_scan_database.h
+ * @brief   Fixed capacity store of extended scan results
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef SLI_WIFI_SCAN_DATABASE_H
+#define SLI_WIFI_SCAN_DATABASE_H
+#include <stdint.h>
+#include "sl_wifi_types.h"
+#include "sli_wifi_types.h"
+
+// SL_WIFI_EXTENDED_SCAN_MAX_RESULTS is defined in sl_wifi_constants.h. When full, a stronger BSS replaces the weakest one.
+#if (SL_WIFI_EXTENDED_SCAN_MAX_RESULTS < 1) || (SL_WIFI_EXTENDED_SCAN_MAX_RESULTS > 254)
+#error "SL_WIFI_EXTENDED_SCAN_MAX_RESULTS must be between 1 and 254"
+#endif
+
+/***************************************************************************/ /**
+ * @brief
+ *   Adds a BSS to the scan results database or updates the stored entry with the same BSSID.
+ * @param[in] info
+ *   Scan information parsed from a beacon or probe response.
+ * @note
+ *   A BSS that is not stronger than the weakest stored one is dropped when the database is full.
+ ******************************************************************************/
+void sli_wifi_scan_database_update(const sli_scan_info_t *info);
+
+/***************************************************************************/ /**
+ * @brief
+ *   Copies the stored scan results that match the filters, strongest first.
+ * @param[in] extended_scan_parameters
+ *   Result array, its length and the optional filters. The caller validates the result array.
+ * @return
+ *   Number of results copied.
+ ******************************************************************************/
+uint16_t sli_wifi_scan_database_get_results(const sl_wifi_extended_scan_result_parameters_t *extended_scan_parameters);
+
+/* Function returns the number of BSSs in the scan results database */
+uint16_t sli_wifi_scan_database_get_count(void);
+
+/* Function removes all the entries from the scan results database */
+void sli_wifi_scan_database_flush(void);
+
+#endif // SLI_WIFI_SCAN_DATABASE_H
@@ -379,6 +379,19 @@ typedef struct {
   sl_wifi_buffer_t *head; ///< Head
   sl_wifi_buffer_t *tail; ///< Tail
 } sli_wifi_buffer_queue_t;
+
+/// Thread blocked in a wait queue, lives on the stack of the waiting thread
+typedef struct sli_wifi_waiter_s {
+  struct sli_wifi_waiter_s *next; ///< Next waiter
+  void *thread;                   ///< Waiting thread, woken with SLI_WIFI_WAIT_QUEUE_THREAD_FLAG
+  volatile bool granted;          ///< Set once the awaited resource has been handed to this waiter
+} sli_wifi_waiter_t;
+
+/// FIFO of threads waiting for a resource to be released
+typedef struct {
+  sli_wifi_waiter_t *head; ///< Oldest waiter, served first
+  sli_wifi_waiter_t *tail; ///< Newest waiter
+} sli_wifi_wait_queue_t;
 /// Si91x specific command type
 typedef enum {
   SLI_WIFI_COMMON_CMD   = 0, ///< SI91X Common Command
@@ -425,8 +438,7 @@ typedef struct {
 } sli_wifi_command_queue_t;
 
 // Scan Information
-typedef struct sli_scan_info_s {
-  struct sli_scan_info_s *next;
+typedef struct {
   uint8_t channel;                                 ///< Channel number of the AP
   uint8_t security_mode;                           ///< Security mode of the AP
   uint8_t rssi;                                    ///< RSSI value of the AP
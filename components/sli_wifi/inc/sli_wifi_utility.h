@@ -33,6 +33,10 @@
 #include "sli_wifi_types.h"
 #include "sl_status.h"
 #include "sl_wifi_host_interface.h"
+#include "cmsis_os2.h"
+
+/// Thread flag a thread blocked in a wait queue sleeps on. Threads calling the Wi-Fi API must not use it.
+#define SLI_WIFI_WAIT_QUEUE_THREAD_FLAG (1UL << 30)
 #ifndef __ZEPHYR__
 /******************************************************************************
  * @brief
@@ -73,6 +77,49 @@ sl_status_t sli_wifi_allocate_command_buffer(sl_wifi_buffer_t **host_buffer,
  */
 void sli_wifi_append_to_buffer_queue(sli_wifi_buffer_queue_t *queue, sl_wifi_buffer_t *buffer);
 
+/**
+ * @brief Queue the calling thread on a wait queue.
+ *
+ * Must be called with interrupts disabled, in the same critical section that found the resource unavailable,
+ * so a release between the check and the wait cannot be missed. Follow with @ref sli_wifi_wait_queue_wait.
+ *
+ * @param[in] queue  Wait queue of the resource.
+ * @param[in] waiter Waiter owned by the calling thread, typically on its stack.
+ */
+void sli_wifi_wait_queue_append(sli_wifi_wait_queue_t *queue, sli_wifi_waiter_t *waiter);
+
+/**
+ * @brief Hand a released resource to the oldest waiter.
+ *
+ * Must be called with interrupts disabled. When it returns a thread the resource belongs to that thread and
+ * must not be returned to the free pool. Wake the thread with @ref sli_wifi_wait_queue_notify once interrupts
+ * are enabled again.
+ *
+ * @param[in] queue Wait queue of the resource.
+ * @return Thread the resource was handed to, or NULL if no thread is waiting.
+ */
+osThreadId_t sli_wifi_wait_queue_grant_one(sli_wifi_wait_queue_t *queue);
+
+/**
+ * @brief Wake a thread returned by @ref sli_wifi_wait_queue_grant_one.
+ *
+ * @param[in] thread Thread to wake, NULL is ignored.
+ */
+void sli_wifi_wait_queue_notify(osThreadId_t thread);
+
+/**
+ * @brief Block until the resource is handed to the waiter or the timeout expires.
+ *
+ * @param[in] queue         Wait queue the waiter was appended to.
+ * @param[in] waiter        Waiter passed to @ref sli_wifi_wait_queue_append.
+ * @param[in] timeout_ticks Time to wait in ticks, or osWaitForever.
+ * The thread sleeps on SLI_WIFI_WAIT_QUEUE_THREAD_FLAG, so the wait needs no allocation.
+ *
+ * @return SL_STATUS_OK if the resource was handed over, SL_STATUS_TIMEOUT otherwise. On timeout the waiter has
+ *         been removed from the queue.
+ */
+sl_status_t sli_wifi_wait_queue_wait(sli_wifi_wait_queue_t *queue, sli_wifi_waiter_t *waiter, uint32_t timeout_ticks);
+
 // Event API
 /* Function used to set specified flags for event */
 void sli_wifi_set_event(uint32_t event_mask);
@@ -255,8 +302,6 @@ sli_wifi_feature_frame_config_t sli_wifi_get_feature_frame_config(void);
 void sli_wifi_save_pll_mode(const sl_wifi_pll_mode_t pll_mode);
 void sli_wifi_save_power_chain(const sl_wifi_power_chain_t power_chain);
 
-// Accessor for the scan results database head pointer
-sli_scan_info_t **sli_get_scan_info_database(void);
 bool sli_wifi_packet_identification_function(const sl_wifi_buffer_t *buffer, const void *user_data);
 uint32_t sli_wifi_host_queue_status(const sli_wifi_buffer_queue_t *queue);
 uint32_t sl_wifi_host_elapsed_time(uint32_t starting_timestamp);
@@ -0,0 +1,330 @@
+/***************************************************************************/ /**
+ * @file    sli_wifi_scan_database.c
+ * @brief   Fixed capacity store of extended scan results
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include "sli_wifi_scan_database.h"
+#include <stdbool.h>
+#include <string.h>
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+#define SLI_SCAN_DATABASE_CAPACITY SL_WIFI_EXTENDED_SCAN_MAX_RESULTS
+
+// BSSID hash table size, a power of two of at least twice the capacity so probe sequences stay short
+#if SLI_SCAN_DATABASE_CAPACITY <= 32
+#define SLI_SCAN_DATABASE_HASH_SIZE 64
+#elif SLI_SCAN_DATABASE_CAPACITY <= 64
+#define SLI_SCAN_DATABASE_HASH_SIZE 128
+#elif SLI_SCAN_DATABASE_CAPACITY <= 128
+#define SLI_SCAN_DATABASE_HASH_SIZE 256
+#else
+#define SLI_SCAN_DATABASE_HASH_SIZE 512
+#endif
+#define SLI_SCAN_DATABASE_HASH_MASK (SLI_SCAN_DATABASE_HASH_SIZE - 1)
+
+#define SLI_SCAN_DATABASE_BITMAP_WORDS ((SLI_SCAN_DATABASE_CAPACITY + 31) / 32)
+#define SLI_SCAN_DATABASE_SLOT_WORD(slot) ((slot) / 32)
+#define SLI_SCAN_DATABASE_SLOT_BIT(slot)  (1UL << ((slot) % 32))
+
+// Channels, security modes and network types are indexed by their low bits, queries compare the exact value
+#define SLI_SCAN_DATABASE_INDEX_BUCKETS 16
+#define SLI_SCAN_DATABASE_BUCKET(value) ((value) & (SLI_SCAN_DATABASE_INDEX_BUCKETS - 1))
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+// One bit per slot
+typedef uint32_t sli_scan_bitmap_t[SLI_SCAN_DATABASE_BITMAP_WORDS];
+
+typedef struct {
+  sli_scan_info_t entries[SLI_SCAN_DATABASE_CAPACITY]; ///< Stored BSSs, slots 0 to count - 1 are in use
+  uint8_t order[SLI_SCAN_DATABASE_CAPACITY];           ///< Slots sorted by RSSI, strongest first
+  uint8_t hash_table[SLI_SCAN_DATABASE_HASH_SIZE];     ///< Slot + 1 hashed by BSSID, 0 for an empty bucket
+  sli_scan_bitmap_t channel_index[SLI_SCAN_DATABASE_INDEX_BUCKETS];       ///< Slots per channel
+  sli_scan_bitmap_t security_mode_index[SLI_SCAN_DATABASE_INDEX_BUCKETS]; ///< Slots per security mode
+  sli_scan_bitmap_t network_type_index[SLI_SCAN_DATABASE_INDEX_BUCKETS];  ///< Slots per network type
+  uint16_t count;                                                         ///< Number of stored BSSs
+} sli_wifi_scan_database_t;
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+static sli_wifi_scan_database_t scan_database;
+
+/******************************************************
+ *               Static Function Definitions
+ ******************************************************/
+static uint32_t sli_scan_bssid_hash(const uint8_t *bssid)
+{
+  // The first three bytes are the vendor OUI shared by many BSSs, so the last three carry most of the entropy
+  uint32_t key = ((uint32_t)bssid[2] << 24) | ((uint32_t)bssid[3] << 16) | ((uint32_t)bssid[4] << 8) | bssid[5];
+  key ^= ((uint32_t)bssid[0] << 8) | bssid[1];
+  return ((key * 0x9E3779B1UL) >> 16) & SLI_SCAN_DATABASE_HASH_MASK;
+}
+
+// Returns the bucket holding the BSSID, or the empty bucket where it would be inserted
+static uint32_t sli_scan_find_bucket(const uint8_t *bssid)
+{
+  uint32_t bucket = sli_scan_bssid_hash(bssid);
+
+  while ((0 != scan_database.hash_table[bucket])
+         && (0
+             != memcmp(scan_database.entries[scan_database.hash_table[bucket] - 1].bssid,
+                       bssid,
+                       SLI_WIFI_HARDWARE_ADDRESS_LENGTH))) {
+    bucket = (bucket + 1) & SLI_SCAN_DATABASE_HASH_MASK;
+  }
+  return bucket;
+}
+
+// Empties a bucket and moves back the following entries of the probe sequence, so no tombstones are needed
+static void sli_scan_hash_remove(uint32_t bucket)
+{
+  uint32_t next = bucket;
+
+  scan_database.hash_table[bucket] = 0;
+  while (true) {
+    next = (next + 1) & SLI_SCAN_DATABASE_HASH_MASK;
+    if (0 == scan_database.hash_table[next]) {
+      return;
+    }
+    uint32_t home = sli_scan_bssid_hash(scan_database.entries[scan_database.hash_table[next] - 1].bssid);
+    // Move the entry unless its home bucket lies after the empty bucket in its probe sequence
+    if (((next - home) & SLI_SCAN_DATABASE_HASH_MASK) >= ((next - bucket) & SLI_SCAN_DATABASE_HASH_MASK)) {
+      scan_database.hash_table[bucket] = scan_database.hash_table[next];
+      scan_database.hash_table[next]   = 0;
+      bucket                           = next;
+    }
+  }
+}
+
+static void sli_scan_indexes_update(uint8_t slot, bool add)
+{
+  const sli_scan_info_t *entry = &scan_database.entries[slot];
+  uint32_t *bitmaps[]          = {
+    scan_database.channel_index[SLI_SCAN_DATABASE_BUCKET(entry->channel)],
+    scan_database.security_mode_index[SLI_SCAN_DATABASE_BUCKET(entry->security_mode)],
+    scan_database.network_type_index[SLI_SCAN_DATABASE_BUCKET(entry->network_type)],
+  };
+
+  for (uint8_t index = 0; index < (sizeof(bitmaps) / sizeof(bitmaps[0])); index++) {
+    if (add) {
+      bitmaps[index][SLI_SCAN_DATABASE_SLOT_WORD(slot)] |= SLI_SCAN_DATABASE_SLOT_BIT(slot);
+    } else {
+      bitmaps[index][SLI_SCAN_DATABASE_SLOT_WORD(slot)] &= ~SLI_SCAN_DATABASE_SLOT_BIT(slot);
+    }
+  }
+}
+
+// Returns the first position of the RSSI order holding an entry weaker than rssi, or equal to it if inclusive
+static uint16_t sli_scan_order_search(uint8_t rssi, bool inclusive)
+{
+  uint16_t low  = 0;
+  uint16_t high = scan_database.count;
+
+  while (low < high) {
+    uint16_t middle     = (uint16_t)((low + high) / 2);
+    uint8_t middle_rssi = scan_database.entries[scan_database.order[middle]].rssi;
+    if ((middle_rssi < rssi) || (!inclusive && (middle_rssi == rssi))) {
+      low = (uint16_t)(middle + 1);
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+static void sli_scan_order_insert(uint8_t slot)
+{
+  // Entries with the same RSSI keep their arrival order
+  uint16_t position = sli_scan_order_search(scan_database.entries[slot].rssi, false);
+
+  memmove(&scan_database.order[position + 1], &scan_database.order[position], scan_database.count - position);
+  scan_database.order[position] = slot;
+  scan_database.count++;
+}
+
+static void sli_scan_order_remove(uint8_t slot)
+{
+  uint16_t position = sli_scan_order_search(scan_database.entries[slot].rssi, true);
+
+  while (scan_database.order[position] != slot) {
+    position++;
+  }
+  scan_database.count--;
+  memmove(&scan_database.order[position], &scan_database.order[position + 1], scan_database.count - position);
+}
+
+static bool sli_scan_info_matches(const sli_scan_info_t *scan_info,
+                                  const sl_wifi_extended_scan_result_parameters_t *extended_scan_parameters)
+{
+  if ((NULL != extended_scan_parameters->channel_filter)
+      && (*(extended_scan_parameters->channel_filter) != scan_info->channel)) {
+    return false;
+  }
+
+  if ((NULL != extended_scan_parameters->security_mode_filter)
+      && (*(extended_scan_parameters->security_mode_filter) != scan_info->security_mode)) {
+    return false;
+  }
+
+  if ((NULL != extended_scan_parameters->network_type_filter)
+      && (*(extended_scan_parameters->network_type_filter) != scan_info->network_type)) {
+    return false;
+  }
+
+  return true;
+}
+
+// Narrows the candidate slots to the index bucket of a filter value
+static void sli_scan_apply_filter(uint32_t *candidates, const sli_scan_bitmap_t *index, const uint8_t *filter)
+{
+  if (NULL == filter) {
+    return;
+  }
+
+  for (uint8_t word = 0; word < SLI_SCAN_DATABASE_BITMAP_WORDS; word++) {
+    candidates[word] &= index[SLI_SCAN_DATABASE_BUCKET(*filter)][word];
+  }
+}
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+void sli_wifi_scan_database_update(const sli_scan_info_t *info)
+{
+  uint8_t slot;
+
+  if (NULL == info) {
+    return;
+  }
+
+  uint32_t bucket = sli_scan_find_bucket(info->bssid);
+  if (0 != scan_database.hash_table[bucket]) {
+    // Known BSS, move it in the RSSI order only if its RSSI changed
+    slot = (uint8_t)(scan_database.hash_table[bucket] - 1);
+    sli_scan_indexes_update(slot, false);
+    if (scan_database.entries[slot].rssi != info->rssi) {
+      sli_scan_order_remove(slot);
+      memcpy(&scan_database.entries[slot], info, sizeof(sli_scan_info_t));
+      sli_scan_order_insert(slot);
+    } else {
+      memcpy(&scan_database.entries[slot], info, sizeof(sli_scan_info_t));
+    }
+    sli_scan_indexes_update(slot, true);
+    return;
+  }
+
+  if (SLI_SCAN_DATABASE_CAPACITY == scan_database.count) {
+    // Full, the new BSS replaces the weakest one if it is stronger
+    slot = scan_database.order[scan_database.count - 1];
+    if (info->rssi >= scan_database.entries[slot].rssi) {
+      return;
+    }
+    sli_scan_indexes_update(slot, false);
+    sli_scan_hash_remove(sli_scan_find_bucket(scan_database.entries[slot].bssid));
+    scan_database.count--;
+    // Removing shifted the probe sequence the new BSSID belongs to
+    bucket = sli_scan_find_bucket(info->bssid);
+  } else {
+    slot = (uint8_t)scan_database.count;
+  }
+
+  memcpy(&scan_database.entries[slot], info, sizeof(sli_scan_info_t));
+  scan_database.hash_table[bucket] = (uint8_t)(slot + 1);
+  sli_scan_indexes_update(slot, true);
+  sli_scan_order_insert(slot);
+}
+
+uint16_t sli_wifi_scan_database_get_results(const sl_wifi_extended_scan_result_parameters_t *extended_scan_parameters)
+{
+  sl_wifi_extended_scan_result_t *scan_results = extended_scan_parameters->scan_results;
+  uint16_t length                              = extended_scan_parameters->array_length;
+  uint16_t remaining                           = scan_database.count;
+  uint16_t result_count                        = 0;
+  uint32_t candidates[SLI_SCAN_DATABASE_BITMAP_WORDS];
+
+  memset(candidates, 0xFF, sizeof(candidates));
+  sli_scan_apply_filter(candidates, scan_database.channel_index, extended_scan_parameters->channel_filter);
+  sli_scan_apply_filter(candidates,
+                        scan_database.security_mode_index,
+                        extended_scan_parameters->security_mode_filter);
+  sli_scan_apply_filter(candidates, scan_database.network_type_index, extended_scan_parameters->network_type_filter);
+
+  if ((NULL != extended_scan_parameters->channel_filter) || (NULL != extended_scan_parameters->security_mode_filter)
+      || (NULL != extended_scan_parameters->network_type_filter)) {
+    // Stop the walk once every candidate has been visited
+    remaining = 0;
+    for (uint8_t word = 0; word < SLI_SCAN_DATABASE_BITMAP_WORDS; word++) {
+      for (uint32_t bits = candidates[word]; 0 != bits; bits &= bits - 1) {
+        remaining++;
+      }
+    }
+  }
+
+  for (uint16_t position = 0; (position < scan_database.count) && (0 != remaining) && (result_count < length);
+       position++) {
+    uint8_t slot                     = scan_database.order[position];
+    const sli_scan_info_t *scan_info = &scan_database.entries[slot];
+
+    // The order is sorted by RSSI, so no later entry passes the RSSI filter either
+    if ((NULL != extended_scan_parameters->rssi_filter)
+        && (*(extended_scan_parameters->rssi_filter) <= scan_info->rssi)) {
+      break;
+    }
+    if (0 == (candidates[SLI_SCAN_DATABASE_SLOT_WORD(slot)] & SLI_SCAN_DATABASE_SLOT_BIT(slot))) {
+      continue;
+    }
+    remaining--;
+    // Values that share an index bucket are told apart here
+    if (!sli_scan_info_matches(scan_info, extended_scan_parameters)) {
+      continue;
+    }
+
+    scan_results[result_count].rf_channel    = scan_info->channel;
+    scan_results[result_count].security_mode = scan_info->security_mode;
+    scan_results[result_count].rssi          = scan_info->rssi;
+    scan_results[result_count].network_type  = scan_info->network_type;
+    memcpy(scan_results[result_count].bssid, scan_info->bssid, SLI_WIFI_HARDWARE_ADDRESS_LENGTH);
+    memcpy(scan_results[result_count].ssid, scan_info->ssid, 34);
+    result_count++;
+  }
+
+  return result_count;
+}
+
+uint16_t sli_wifi_scan_database_get_count(void)
+{
+  return scan_database.count;
+}
+
+void sli_wifi_scan_database_flush(void)
+{
+  memset(&scan_database, 0, sizeof(scan_database));
+}
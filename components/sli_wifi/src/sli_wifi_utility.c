@@ -36,6 +36,7 @@
 #include "sl_wifi_credentials.h"
 #include "assert.h"
 #include "sli_wifi_memory_manager.h"
+#include "sli_wifi_scan_database.h"
 #include <string.h>
 #ifndef __ZEPHYR__
 #include "sli_cmsis_os2_ext_task_register.h"
@@ -44,6 +45,7 @@ extern sli_task_register_id_t sli_fw_status_storage_index;
 #endif
 #define DEFAULT_BEACON_MISS_IGNORE_LIMIT   1
 #define DEFAULT_LISTEN_INTERVAL_MULTIPLIER 1
+
 static uint32_t client_listen_interval            = 1000;
 static uint32_t client_listen_interval_multiplier = 1;
 
@@ -73,7 +75,6 @@ static bool is_card_ready_required         = true;
 static sl_wifi_rate_t saved_wifi_data_rate = SL_WIFI_AUTO_RATE;
 static sl_wifi_ap_configuration_t ap_configuration;
 sli_wifi_performance_profile_t performance_profile;
-static sli_scan_info_t *scan_info_database = NULL;
 
 extern osEventFlagsId_t sli_wifi_events;
 
@@ -168,37 +169,6 @@ sl_status_t sli_wifi_get_listen_interval_v2(sl_wifi_interface_t interface,
   return SL_STATUS_OK;
 }
 
-// Function to identify expected scan result based on filter
-static bool sli_filter_scan_info(const sli_scan_info_t *scan_info,
-                                 const sl_wifi_extended_scan_result_parameters_t *extended_scan_parameters)
-{
-  if (NULL == scan_info) {
-    return false;
-  }
-
-  if ((NULL != extended_scan_parameters->channel_filter)
-      && (*(extended_scan_parameters->channel_filter) != scan_info->channel)) {
-    return false;
-  }
-
-  if ((NULL != extended_scan_parameters->security_mode_filter)
-      && (*(extended_scan_parameters->security_mode_filter) != scan_info->security_mode)) {
-    return false;
-  }
-
-  if ((NULL != extended_scan_parameters->rssi_filter)
-      && (*(extended_scan_parameters->rssi_filter) <= scan_info->rssi)) {
-    return false;
-  }
-
-  if ((NULL != extended_scan_parameters->network_type_filter)
-      && (*(extended_scan_parameters->network_type_filter) != scan_info->network_type)) {
-    return false;
-  }
-
-  return true;
-}
-
 // Function to get the total count of stored extended scan results (for callback data_length)
 sl_status_t sli_wifi_get_stored_scan_result_count(sl_wifi_interface_t interface, uint16_t *scan_count)
 {
@@ -208,10 +178,7 @@ sl_status_t sli_wifi_get_stored_scan_result_count(sl_wifi_interface_t interface,
     return SL_STATUS_INVALID_PARAMETER;
   }
 
-  *scan_count = 0;
-  for (sli_scan_info_t *scan_info = scan_info_database; scan_info != NULL; scan_info = scan_info->next) {
-    (*scan_count)++;
-  }
+  *scan_count = sli_wifi_scan_database_get_count();
   return SL_STATUS_OK;
 }
 
@@ -227,26 +194,11 @@ sl_status_t sli_wifi_get_stored_scan_results(sl_wifi_interface_t interface,
   sl_wifi_extended_scan_result_t *scan_results = extended_scan_parameters->scan_results;
   uint16_t *result_count                       = extended_scan_parameters->result_count;
   uint16_t length                              = extended_scan_parameters->array_length;
-  sli_scan_info_t *scan_info                   = scan_info_database;
 
   if ((NULL == scan_results) || (NULL == result_count) || (0 == length)) {
     return SL_STATUS_INVALID_PARAMETER;
   }
-  *result_count = 0;
-
-  while ((0 != length) && (NULL != scan_info)) {
-    if (true == sli_filter_scan_info(scan_info, extended_scan_parameters)) {
-      scan_results[*result_count].rf_channel    = scan_info->channel;
-      scan_results[*result_count].security_mode = scan_info->security_mode;
-      scan_results[*result_count].rssi          = scan_info->rssi;
-      scan_results[*result_count].network_type  = scan_info->network_type;
-      memcpy(scan_results[*result_count].bssid, scan_info->bssid, SLI_WIFI_HARDWARE_ADDRESS_LENGTH);
-      memcpy(scan_results[*result_count].ssid, scan_info->ssid, 34);
-      (*result_count)++;
-      length--;
-    }
-    scan_info = scan_info->next;
-  }
+  *result_count = sli_wifi_scan_database_get_results(extended_scan_parameters);
 
   return SL_STATUS_OK;
 }
@@ -254,17 +206,7 @@ sl_status_t sli_wifi_get_stored_scan_results(sl_wifi_interface_t interface,
 // Function to Clean up all the scan results in scan result database
 void sli_wifi_flush_scan_results_database(void)
 {
-  sli_scan_info_t *scan_info = scan_info_database;
-  sli_scan_info_t *node      = NULL;
-
-  while (NULL != scan_info) {
-    node      = scan_info;
-    scan_info = scan_info->next;
-    free(node);
-  }
-  scan_info_database = NULL;
-
-  return;
+  sli_wifi_scan_database_flush();
 }
 
 sl_status_t sli_wifi_allocate_command_buffer(sl_wifi_buffer_t **host_buffer,
@@ -299,6 +241,85 @@ void sli_wifi_append_to_buffer_queue(sli_wifi_buffer_queue_t *queue, sl_wifi_buf
   CORE_ExitAtomic(state);
 }
 
+void sli_wifi_wait_queue_append(sli_wifi_wait_queue_t *queue, sli_wifi_waiter_t *waiter)
+{
+  waiter->next    = NULL;
+  waiter->thread  = osThreadGetId();
+  waiter->granted = false;
+
+  if (queue->tail == NULL) {
+    queue->head = waiter;
+  } else {
+    queue->tail->next = waiter;
+  }
+  queue->tail = waiter;
+}
+
+osThreadId_t sli_wifi_wait_queue_grant_one(sli_wifi_wait_queue_t *queue)
+{
+  sli_wifi_waiter_t *waiter = queue->head;
+
+  if (waiter == NULL) {
+    return NULL;
+  }
+  queue->head = waiter->next;
+  if (queue->head == NULL) {
+    queue->tail = NULL;
+  }
+  // The waiter may return as soon as it sees granted, so its thread is read before
+  waiter->next        = NULL;
+  osThreadId_t thread = (osThreadId_t)waiter->thread;
+  waiter->granted     = true;
+  return thread;
+}
+
+void sli_wifi_wait_queue_notify(osThreadId_t thread)
+{
+  if (thread != NULL) {
+    osThreadFlagsSet(thread, SLI_WIFI_WAIT_QUEUE_THREAD_FLAG);
+  }
+}
+
+sl_status_t sli_wifi_wait_queue_wait(sli_wifi_wait_queue_t *queue, sli_wifi_waiter_t *waiter, uint32_t timeout_ticks)
+{
+  uint32_t start_tick    = osKernelGetTickCount();
+  CORE_irqState_t state  = CORE_EnterAtomic();
+  uint32_t elapsed_ticks = 0;
+
+  // A flag left by the notification of an earlier wait of this thread only costs one more pass
+  while (!waiter->granted && ((timeout_ticks == osWaitForever) || (elapsed_ticks < timeout_ticks))) {
+    CORE_ExitAtomic(state);
+    osThreadFlagsWait(SLI_WIFI_WAIT_QUEUE_THREAD_FLAG,
+                      osFlagsWaitAny,
+                      (timeout_ticks == osWaitForever) ? osWaitForever : (timeout_ticks - elapsed_ticks));
+    state         = CORE_EnterAtomic();
+    elapsed_ticks = osKernelGetTickCount() - start_tick;
+  }
+  if (waiter->granted) {
+    CORE_ExitAtomic(state);
+    return SL_STATUS_OK;
+  }
+
+  // Timed out, leave the queue so the resource goes to the next waiter
+  sli_wifi_waiter_t *previous = NULL;
+  for (sli_wifi_waiter_t *entry = queue->head; entry != NULL; previous = entry, entry = entry->next) {
+    if (entry != waiter) {
+      continue;
+    }
+    if (previous == NULL) {
+      queue->head = entry->next;
+    } else {
+      previous->next = entry->next;
+    }
+    if (queue->tail == entry) {
+      queue->tail = previous;
+    }
+    break;
+  }
+  CORE_ExitAtomic(state);
+  return SL_STATUS_TIMEOUT;
+}
+
 void sli_wifi_set_event(uint32_t event_mask)
 {
   osEventFlagsSet(sli_wifi_events, event_mask);
@@ -693,20 +714,6 @@ void sli_wifi_save_firmware_status(sl_status_t converted_firmware_status)
 }
 #endif
 
-/***************************************************************************/ /**
- * @brief
- *   Returns a pointer to the scan information database.
- * @pre Pre-conditions:
- *   The Wi-Fi scan operation should be completed before accessing the scan information database.
- * @return
- *   Pointer to the scan information database.
- *   The returned pointer can be used to retrieve or manipulate scan information as needed.
- ******************************************************************************/
-sli_scan_info_t **sli_get_scan_info_database(void)
-{
-  return &scan_info_database;
-}
-
 bool sli_wifi_packet_identification_function(const sl_wifi_buffer_t *buffer, const void *user_data)
 {
   const uint8_t *packet_id = (const uint8_t *)user_data;
@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#pragma once
+#include "fff.h"
+#include "sl_status.h"
+#include "cmsis_os2.h"
+#include "sli_wifi.h"
+#include "sli_wifi_utility.h"
+#include "sli_wifi_power_profile.h"
+#include "sli_wifi_memory_manager.h"
+#include "sl_wifi_credentials.h"
+#include "sli_cmsis_os2_ext_task_register.h"
+
+DECLARE_FAKE_VALUE_FUNC(uint32_t, CORE_EnterAtomic);
+DECLARE_FAKE_VOID_FUNC1(CORE_ExitAtomic, uint32_t);
+DECLARE_FAKE_VALUE_FUNC(uint32_t, osKernelGetTickCount);
+DECLARE_FAKE_VALUE_FUNC2(uint32_t, osEventFlagsSet, osEventFlagsId_t, uint32_t);
+DECLARE_FAKE_VALUE_FUNC(osThreadId_t, osThreadGetId);
+DECLARE_FAKE_VALUE_FUNC2(uint32_t, osThreadFlagsSet, osThreadId_t, uint32_t);
+DECLARE_FAKE_VALUE_FUNC3(uint32_t, osThreadFlagsWait, uint32_t, uint32_t, uint32_t);
+DECLARE_FAKE_VOID_FUNC_VARARG(sl_redirect_log, const char *, ...);
+DECLARE_FAKE_VALUE_FUNC4(sl_status_t,
+                         sl_wifi_get_credential,
+                         sl_wifi_credential_id_t,
+                         sl_wifi_credential_type_t *,
+                         void *,
+                         uint32_t *);
+DECLARE_FAKE_VOID_FUNC2(sli_convert_performance_profile_to_power_save_command,
+                        sl_wifi_system_performance_profile_t,
+                        sli_wifi_power_save_request_t *);
+DECLARE_FAKE_VOID_FUNC1(sli_get_coex_performance_profile, sl_wifi_system_performance_profile_t *);
+DECLARE_FAKE_VOID_FUNC1(sli_save_bt_current_performance_profile, const sl_bt_performance_profile_t *);
+DECLARE_FAKE_VOID_FUNC1(sli_wifi_save_current_performance_profile, const sl_wifi_performance_profile_v2_t *);
+DECLARE_FAKE_VALUE_FUNC1(bool, sli_wifi_is_interface_up, sl_wifi_interface_t);
+DECLARE_FAKE_VALUE_FUNC4(sl_status_t,
+                         sli_wifi_memory_manager_allocate_buffer,
+                         sl_wifi_buffer_t **,
+                         sl_wifi_buffer_type_t,
+                         uint32_t,
+                         uint32_t);
+DECLARE_FAKE_VALUE_FUNC7(sl_status_t,
+                         sli_wifi_send_command,
+                         uint32_t,
+                         sli_wifi_command_type_t,
+                         const void *,
+                         uint32_t,
+                         sli_wifi_wait_period_t,
+                         void *,
+                         void **);
+DECLARE_FAKE_VALUE_FUNC3(void *, sli_wifi_host_get_buffer_data, void *, uint16_t, uint16_t *);
+DECLARE_FAKE_VALUE_FUNC3(sl_status_t,
+                         sli_osTaskRegisterSetValue,
+                         const osThreadId_t,
+                         const sli_task_register_id_t,
+                         const uint32_t);
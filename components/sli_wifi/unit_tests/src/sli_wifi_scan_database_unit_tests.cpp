@@ -0,0 +1,347 @@
+/*******************************************************************************
+ * @file
+ * @brief 
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+extern "C" {
+#include "sli_wifi_scan_database.h"
+}
+
+#define CAPACITY SL_WIFI_EXTENDED_SCAN_MAX_RESULTS
+
+static sli_scan_info_t make_info(uint32_t id, uint8_t rssi, uint8_t channel = 1, uint8_t security_mode = SL_WIFI_WPA2)
+{
+  sli_scan_info_t info = {};
+
+  info.rssi          = rssi;
+  info.channel       = channel;
+  info.security_mode = security_mode;
+  info.network_type  = 1;
+  info.bssid[0]      = 0x00;
+  info.bssid[1]      = 0x1A;
+  info.bssid[2]      = 0x11;
+  info.bssid[3]      = (uint8_t)(id >> 16);
+  info.bssid[4]      = (uint8_t)(id >> 8);
+  info.bssid[5]      = (uint8_t)id;
+  snprintf((char *)info.ssid, sizeof(info.ssid), "ap-%u", (unsigned)id);
+  return info;
+}
+
+class sli_wifi_scan_database_test : public ::testing::Test {
+protected:
+  sl_wifi_extended_scan_result_t results[CAPACITY + 8];
+  sl_wifi_extended_scan_result_parameters_t parameters;
+  uint8_t channel_filter;
+  uint8_t security_mode_filter;
+  uint8_t rssi_filter;
+  uint8_t network_type_filter;
+
+  void SetUp() override
+  {
+    sli_wifi_scan_database_flush();
+    memset(&parameters, 0, sizeof(parameters));
+    parameters.scan_results = results;
+    parameters.array_length = sizeof(results) / sizeof(results[0]);
+  }
+
+  std::vector<sl_wifi_extended_scan_result_t> query()
+  {
+    uint16_t count = sli_wifi_scan_database_get_results(&parameters);
+    return std::vector<sl_wifi_extended_scan_result_t>(results, results + count);
+  }
+
+  void add(uint32_t id, uint8_t rssi, uint8_t channel = 1, uint8_t security_mode = SL_WIFI_WPA2)
+  {
+    sli_scan_info_t info = make_info(id, rssi, channel, security_mode);
+    sli_wifi_scan_database_update(&info);
+  }
+};
+
+TEST_F(sli_wifi_scan_database_test, EmptyDatabase)
+{
+  EXPECT_EQ(sli_wifi_scan_database_get_count(), 0);
+  EXPECT_TRUE(query().empty());
+}
+
+TEST_F(sli_wifi_scan_database_test, ResultsAreSortedStrongestFirst)
+{
+  add(1, 50);
+  add(2, 30);
+  add(3, 70);
+  add(4, 30);
+
+  auto list = query();
+  ASSERT_EQ(list.size(), 4u);
+  EXPECT_EQ(list[0].bssid[5], 2);
+  EXPECT_EQ(list[1].bssid[5], 4);
+  EXPECT_EQ(list[2].bssid[5], 1);
+  EXPECT_EQ(list[3].bssid[5], 3);
+  EXPECT_STREQ((const char *)list[0].ssid, "ap-2");
+  EXPECT_EQ(sli_wifi_scan_database_get_count(), 4);
+}
+
+TEST_F(sli_wifi_scan_database_test, UpdateReordersByRssi)
+{
+  add(1, 40);
+  add(2, 50);
+  add(3, 60);
+  add(3, 20, 6);
+
+  auto list = query();
+  ASSERT_EQ(list.size(), 3u);
+  EXPECT_EQ(list[0].bssid[5], 3);
+  EXPECT_EQ(list[0].rssi, 20);
+  EXPECT_EQ(list[0].rf_channel, 6);
+
+  add(3, 90);
+  list = query();
+  ASSERT_EQ(list.size(), 3u);
+  EXPECT_EQ(list[2].bssid[5], 3);
+  EXPECT_EQ(sli_wifi_scan_database_get_count(), 3);
+}
+
+TEST_F(sli_wifi_scan_database_test, UpdateMovesEntryBetweenIndexes)
+{
+  add(1, 40, 1, SL_WIFI_OPEN);
+  add(1, 40, 11, SL_WIFI_WPA3);
+
+  channel_filter            = 1;
+  parameters.channel_filter = &channel_filter;
+  EXPECT_TRUE(query().empty());
+
+  channel_filter                  = 11;
+  security_mode_filter            = SL_WIFI_WPA3;
+  parameters.security_mode_filter = &security_mode_filter;
+  EXPECT_EQ(query().size(), 1u);
+}
+
+TEST_F(sli_wifi_scan_database_test, FullDatabaseEvictsWeakest)
+{
+  for (uint32_t id = 0; id < CAPACITY; id++) {
+    add(id, (uint8_t)(20 + id));
+  }
+  EXPECT_EQ(sli_wifi_scan_database_get_count(), CAPACITY);
+
+  // Not stronger than the weakest entry
+  add(1000, (uint8_t)(20 + CAPACITY - 1));
+  auto list = query();
+  ASSERT_EQ(list.size(), (size_t)CAPACITY);
+  EXPECT_EQ(list.back().bssid[5], (uint8_t)(CAPACITY - 1));
+
+  add(1000, 10);
+  list = query();
+  ASSERT_EQ(list.size(), (size_t)CAPACITY);
+  EXPECT_EQ(list[0].bssid[4], 1000 >> 8);
+  EXPECT_EQ(list.back().bssid[5], (uint8_t)(CAPACITY - 2));
+
+  // The evicted BSS comes back as a new entry
+  add(CAPACITY - 1, 5);
+  list = query();
+  EXPECT_EQ(list[0].bssid[5], (uint8_t)(CAPACITY - 1));
+  EXPECT_EQ(sli_wifi_scan_database_get_count(), CAPACITY);
+}
+
+TEST_F(sli_wifi_scan_database_test, Filters)
+{
+  add(1, 30, 1, SL_WIFI_OPEN);
+  add(2, 40, 6, SL_WIFI_WPA2);
+  add(3, 50, 6, SL_WIFI_WPA3);
+  add(4, 60, 11, SL_WIFI_WPA2);
+  add(5, 70, 36, SL_WIFI_WPA2);
+  // Same index bucket as channel 36
+  add(6, 80, 52, SL_WIFI_WPA2);
+
+  channel_filter            = 6;
+  parameters.channel_filter = &channel_filter;
+  auto list                 = query();
+  ASSERT_EQ(list.size(), 2u);
+  EXPECT_EQ(list[0].bssid[5], 2);
+  EXPECT_EQ(list[1].bssid[5], 3);
+
+  channel_filter = 36;
+  list           = query();
+  ASSERT_EQ(list.size(), 1u);
+  EXPECT_EQ(list[0].bssid[5], 5);
+
+  parameters.channel_filter       = NULL;
+  security_mode_filter            = SL_WIFI_WPA2;
+  parameters.security_mode_filter = &security_mode_filter;
+  rssi_filter                     = 70;
+  parameters.rssi_filter          = &rssi_filter;
+  list                            = query();
+  ASSERT_EQ(list.size(), 2u);
+  EXPECT_EQ(list[0].bssid[5], 2);
+  EXPECT_EQ(list[1].bssid[5], 4);
+
+  network_type_filter            = 0;
+  parameters.network_type_filter = &network_type_filter;
+  EXPECT_TRUE(query().empty());
+}
+
+TEST_F(sli_wifi_scan_database_test, ArrayLengthLimitsResults)
+{
+  for (uint32_t id = 0; id < 10; id++) {
+    add(id, (uint8_t)(90 - id));
+  }
+  parameters.array_length = 3;
+
+  auto list = query();
+  ASSERT_EQ(list.size(), 3u);
+  EXPECT_EQ(list[0].bssid[5], 9);
+  EXPECT_EQ(list[2].bssid[5], 7);
+}
+
+TEST_F(sli_wifi_scan_database_test, FlushRemovesAllEntries)
+{
+  add(1, 30);
+  add(2, 40);
+  sli_wifi_scan_database_flush();
+
+  EXPECT_EQ(sli_wifi_scan_database_get_count(), 0);
+  EXPECT_TRUE(query().empty());
+  add(2, 40);
+  EXPECT_EQ(sli_wifi_scan_database_get_count(), 1);
+}
+
+// Applies the same policy as the database to a plain vector
+static void model_update(std::vector<sli_scan_info_t> &model, const sli_scan_info_t &info)
+{
+  auto same_bssid = [&](const sli_scan_info_t &entry) {
+    return 0 == memcmp(entry.bssid, info.bssid, sizeof(info.bssid));
+  };
+  auto weaker = [](uint8_t rssi, const sli_scan_info_t &entry) {
+    return rssi < entry.rssi;
+  };
+  auto found = std::find_if(model.begin(), model.end(), same_bssid);
+
+  if (found != model.end()) {
+    if (found->rssi == info.rssi) {
+      *found = info;
+      return;
+    }
+    model.erase(found);
+  } else if (model.size() == CAPACITY) {
+    if (info.rssi >= model.back().rssi) {
+      return;
+    }
+    model.pop_back();
+  }
+  model.insert(std::upper_bound(model.begin(), model.end(), info.rssi, weaker), info);
+}
+
+TEST_F(sli_wifi_scan_database_test, MatchesReferenceModel)
+{
+  std::mt19937 random(1234);
+  std::vector<sli_scan_info_t> model;
+
+  for (uint32_t step = 0; step < 20000; step++) {
+    // Few distinct BSSIDs keep the table full and the probe sequences crowded
+    sli_scan_info_t info = make_info(random() % (CAPACITY * 3),
+                                     (uint8_t)(10 + random() % 80),
+                                     (uint8_t)(1 + random() % 13),
+                                     (uint8_t)(random() % 11));
+    sli_wifi_scan_database_update(&info);
+    model_update(model, info);
+
+    if (0 == (step % 97)) {
+      channel_filter            = (uint8_t)(1 + random() % 13);
+      parameters.channel_filter = (step % 2) ? &channel_filter : NULL;
+      auto list                 = query();
+      std::vector<const sli_scan_info_t *> expected;
+      for (const auto &entry : model) {
+        if ((NULL == parameters.channel_filter) || (entry.channel == channel_filter)) {
+          expected.push_back(&entry);
+        }
+      }
+      ASSERT_EQ(list.size(), expected.size());
+      for (size_t index = 0; index < list.size(); index++) {
+        ASSERT_EQ(0, memcmp(list[index].bssid, expected[index]->bssid, sizeof(list[index].bssid)));
+        ASSERT_EQ(list[index].rssi, expected[index]->rssi);
+      }
+      ASSERT_EQ(sli_wifi_scan_database_get_count(), model.size());
+    }
+  }
+}
+
+TEST_F(sli_wifi_scan_database_test, BenchmarkScanReplay)
+{
+  const uint32_t access_points = 500;
+  const uint32_t scans         = 200;
+  const uint8_t ouis[][3]      = {
+    { 0x00, 0x1A, 0x11 },
+    { 0xF0, 0x9F, 0xC2 },
+    { 0x3C, 0x84, 0x6A },
+    { 0x00, 0x0C, 0x42 },
+  };
+  std::mt19937 random(42);
+  std::vector<sli_scan_info_t> dump;
+  uint64_t beacons = 0;
+  uint64_t copied  = 0;
+
+  // One scan of a dense area: every AP answers on its channel with a few dB of jitter between scans
+  for (uint32_t id = 0; id < access_points; id++) {
+    sli_scan_info_t info = make_info(id,
+                                     (uint8_t)(30 + random() % 60),
+                                     (uint8_t)(1 + random() % 13),
+                                     (uint8_t)(random() % 11));
+    memcpy(info.bssid, ouis[id % 4], 3);
+    dump.push_back(info);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t scan = 0; scan < scans; scan++) {
+    sli_wifi_scan_database_flush();
+    for (uint32_t round = 0; round < 3; round++) {
+      for (auto &info : dump) {
+        info.rssi = (uint8_t)std::min(95, std::max(20, info.rssi + (int)(random() % 5) - 2));
+        sli_wifi_scan_database_update(&info);
+        beacons++;
+      }
+    }
+    for (uint8_t channel = 1; channel <= 13; channel++) {
+      channel_filter            = channel;
+      parameters.channel_filter = &channel_filter;
+      copied += sli_wifi_scan_database_get_results(&parameters);
+    }
+  }
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  EXPECT_EQ(sli_wifi_scan_database_get_count(), CAPACITY);
+  EXPECT_EQ(copied, (uint64_t)scans * CAPACITY);
+  printf("[ BENCH    ] %u AP scan replay, capacity %d: %.0f beacons/s, %.1f us per scan\n",
+         (unsigned)access_points,
+         CAPACITY,
+         beacons / elapsed,
+         elapsed * 1e6 / scans);
+}
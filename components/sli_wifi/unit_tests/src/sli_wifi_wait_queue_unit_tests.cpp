@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include "fff.h"
+
+extern "C" {
+#include "sli_wifi_utility_fake_functions.h"
+}
+
+static sli_wifi_wait_queue_t *woken_queue;
+static uint32_t first_thread;
+static uint32_t second_thread;
+static uint32_t current_tick;
+
+static uint32_t get_tick_count(void)
+{
+  return current_tick;
+}
+
+// Stands in for another thread handing the resource over while the waiter sleeps
+static uint32_t wake_while_blocked(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  (void)options;
+  (void)timeout;
+  uint32_t state      = CORE_EnterAtomic();
+  osThreadId_t thread = sli_wifi_wait_queue_grant_one(woken_queue);
+  CORE_ExitAtomic(state);
+  sli_wifi_wait_queue_notify(thread);
+  return flags;
+}
+
+// Sleeps until the timeout passes
+static uint32_t time_out(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  (void)flags;
+  (void)options;
+  current_tick += timeout;
+  return osFlagsErrorTimeout;
+}
+
+// Returns at once for a flag left by an earlier wait, then sleeps until the timeout passes
+static uint32_t stale_flag_then_time_out(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  if (osThreadFlagsWait_fake.call_count == 1) {
+    current_tick += 4;
+    return flags;
+  }
+  return time_out(flags, options, timeout);
+}
+
+class sli_wifi_wait_queue_test : public ::testing::Test {
+protected:
+  sli_wifi_wait_queue_t queue;
+  sli_wifi_waiter_t first;
+  sli_wifi_waiter_t second;
+
+  void SetUp() override
+  {
+    static osThreadId_t threads[] = { (osThreadId_t)&first_thread, (osThreadId_t)&second_thread };
+
+    RESET_FAKE(CORE_EnterAtomic);
+    RESET_FAKE(CORE_ExitAtomic);
+    RESET_FAKE(osKernelGetTickCount);
+    RESET_FAKE(osThreadGetId);
+    RESET_FAKE(osThreadFlagsSet);
+    RESET_FAKE(osThreadFlagsWait);
+    current_tick                          = 0;
+    osKernelGetTickCount_fake.custom_fake = get_tick_count;
+    osThreadFlagsWait_fake.custom_fake    = time_out;
+    SET_RETURN_SEQ(osThreadGetId, threads, 2);
+    memset(&queue, 0, sizeof(queue));
+    woken_queue = &queue;
+
+    sli_wifi_wait_queue_append(&queue, &first);
+    sli_wifi_wait_queue_append(&queue, &second);
+  }
+
+  void TearDown() override
+  {
+    osKernelGetTickCount_fake.custom_fake = NULL;
+    osThreadFlagsWait_fake.custom_fake    = NULL;
+  }
+};
+
+// Test case: Waiters are handed the resource in arrival order, without waking them inside the critical section
+TEST_F(sli_wifi_wait_queue_test, GrantsWaitersInArrivalOrder)
+{
+  EXPECT_EQ(sli_wifi_wait_queue_grant_one(&queue), (osThreadId_t)&first_thread);
+  EXPECT_TRUE(first.granted);
+  EXPECT_FALSE(second.granted);
+
+  EXPECT_EQ(sli_wifi_wait_queue_grant_one(&queue), (osThreadId_t)&second_thread);
+  EXPECT_TRUE(second.granted);
+
+  EXPECT_TRUE(sli_wifi_wait_queue_grant_one(&queue) == NULL);
+  EXPECT_TRUE(queue.head == NULL);
+  EXPECT_TRUE(queue.tail == NULL);
+  EXPECT_EQ(osThreadFlagsSet_fake.call_count, 0);
+}
+
+// Test case: Notifying no thread does nothing
+TEST_F(sli_wifi_wait_queue_test, NotifyIgnoresNoThread)
+{
+  sli_wifi_wait_queue_notify(NULL);
+
+  EXPECT_EQ(osThreadFlagsSet_fake.call_count, 0);
+}
+
+// Test case: A waiter served before it blocks returns at once
+TEST_F(sli_wifi_wait_queue_test, GrantedWaiterDoesNotBlock)
+{
+  sli_wifi_wait_queue_grant_one(&queue);
+
+  EXPECT_EQ(sli_wifi_wait_queue_wait(&queue, &first, 100), SL_STATUS_OK);
+  EXPECT_EQ(osThreadFlagsWait_fake.call_count, 0);
+}
+
+// Test case: A blocked waiter sleeps on the wait queue thread flag, which the notification sets
+TEST_F(sli_wifi_wait_queue_test, NotifyWakesBlockedWaiter)
+{
+  osThreadFlagsWait_fake.custom_fake = wake_while_blocked;
+
+  EXPECT_EQ(sli_wifi_wait_queue_wait(&queue, &first, osWaitForever), SL_STATUS_OK);
+  EXPECT_EQ(osThreadFlagsWait_fake.call_count, 1);
+  EXPECT_EQ(osThreadFlagsWait_fake.arg0_val, SLI_WIFI_WAIT_QUEUE_THREAD_FLAG);
+  EXPECT_EQ(osThreadFlagsWait_fake.arg2_val, osWaitForever);
+  EXPECT_EQ(osThreadFlagsSet_fake.call_count, 1);
+  EXPECT_EQ(osThreadFlagsSet_fake.arg0_val, (osThreadId_t)&first_thread);
+  EXPECT_EQ(osThreadFlagsSet_fake.arg1_val, SLI_WIFI_WAIT_QUEUE_THREAD_FLAG);
+  EXPECT_EQ(queue.head, &second);
+}
+
+// Test case: A timed out waiter leaves the queue and is not granted later
+TEST_F(sli_wifi_wait_queue_test, TimeoutRemovesWaiter)
+{
+  EXPECT_EQ(sli_wifi_wait_queue_wait(&queue, &first, 10), SL_STATUS_TIMEOUT);
+  EXPECT_EQ(osThreadFlagsWait_fake.call_count, 1);
+  EXPECT_EQ(osThreadFlagsWait_fake.arg2_val, 10U);
+  EXPECT_EQ(queue.head, &second);
+
+  // The next release goes to the remaining waiter
+  EXPECT_EQ(sli_wifi_wait_queue_grant_one(&queue), (osThreadId_t)&second_thread);
+  EXPECT_TRUE(second.granted);
+  EXPECT_FALSE(first.granted);
+}
+
+// Test case: A flag left by an earlier wait only costs another pass for the rest of the timeout
+TEST_F(sli_wifi_wait_queue_test, StaleFlagKeepsWaiting)
+{
+  osThreadFlagsWait_fake.custom_fake = stale_flag_then_time_out;
+
+  EXPECT_EQ(sli_wifi_wait_queue_wait(&queue, &second, 10), SL_STATUS_TIMEOUT);
+  EXPECT_EQ(osThreadFlagsWait_fake.call_count, 2);
+  EXPECT_EQ(osThreadFlagsWait_fake.arg2_history[0], 10U);
+  EXPECT_EQ(osThreadFlagsWait_fake.arg2_history[1], 6U);
+  EXPECT_EQ(queue.head, &first);
+  EXPECT_EQ(queue.tail, &first);
+}
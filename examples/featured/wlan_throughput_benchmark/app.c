@@ -0,0 +1,304 @@
+/***************************************************************************/ /**
+ * @file
+ * @brief WLAN Throughput Benchmark Example Application
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SLI_SI91X_MCU_INTERFACE
+#include "sl_iostream.h"
+#endif
+#include "console.h"
+#include "console_argument_types.h"
+#include "sl_board_configuration.h"
+#include "cmsis_os2.h"
+#include "sl_wifi.h"
+#include "sl_net.h"
+#include "sl_utility.h"
+#include "sl_si91x_driver.h"
+#include "sl_net_wifi_types.h"
+#include "cacert.pem.h"
+#include <stdbool.h>
+#include <string.h>
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+#define BUFFER_SIZE 256
+
+/*=======================================================================*/
+// NWP buffer allocation parameters
+/*=======================================================================*/
+
+#ifndef TX_POOL_RATIO
+#define TX_POOL_RATIO 1
+#endif
+
+#ifndef RX_POOL_RATIO
+#define RX_POOL_RATIO 1
+#endif
+
+#ifndef GLOBAL_POOL_RATIO
+#define GLOBAL_POOL_RATIO 1
+#endif
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+const osThreadAttr_t thread_attributes = {
+  .name       = "app",
+  .attr_bits  = 0,
+  .cb_mem     = 0,
+  .cb_size    = 0,
+  .stack_mem  = 0,
+  .stack_size = 3072,
+  .priority   = osPriorityLow,
+  .tz_module  = 0,
+  .reserved   = 0,
+};
+
+#ifndef SLI_SI91X_MCU_INTERFACE
+static bool end_of_cmd = false;
+#endif
+
+// TLS is always enabled so TLS streams can be added at run time
+static const sl_wifi_device_configuration_t benchmark_configuration = {
+  .boot_option = LOAD_NWP_FW,
+  .mac_address = NULL,
+  .band        = SL_SI91X_WIFI_BAND_2_4GHZ,
+  .region_code = US,
+  .boot_config = { .oper_mode       = SL_SI91X_CLIENT_MODE,
+                   .coex_mode       = SL_SI91X_WLAN_ONLY_MODE,
+                   .feature_bit_map = (SL_WIFI_FEAT_SECURITY_OPEN | SL_WIFI_FEAT_AGGREGATION | SL_WIFI_FEAT_WPS_DISABLE
+#ifdef ENABLE_UART_NCP_BITMAP
+                                       | SL_SI91X_FEAT_ULP_GPIO_BASED_HANDSHAKE
+#endif
+                                       ),
+                   .tcp_ip_feature_bit_map = (SL_SI91X_TCP_IP_FEAT_DHCPV4_CLIENT | SL_SI91X_TCP_IP_FEAT_EXTENSION_VALID
+                                              | SL_SI91X_TCP_IP_FEAT_SSL),
+                   .custom_feature_bit_map =
+                     (SL_WIFI_SYSTEM_CUSTOM_FEAT_EXTENSION_VALID | SL_SI91X_CUSTOM_FEAT_SOC_CLK_CONFIG_160MHZ),
+                   .ext_custom_feature_bit_map = (MEMORY_CONFIG
+#ifdef SLI_SI917
+                                                  | SL_SI91X_EXT_FEAT_FRONT_END_SWITCH_PINS_ULP_GPIO_4_5_0
+#endif
+                                                  ),
+                   .bt_feature_bit_map         = 0,
+                   .ext_tcp_ip_feature_bit_map = (SL_SI91X_EXT_TCP_IP_WINDOW_DIV | SL_SI91X_CONFIG_FEAT_EXTENTION_VALID
+                                                  | SL_SI91X_EXT_TCP_IP_WAIT_FOR_SOCKET_CLOSE
+                                                  | SL_SI91X_EXT_TCP_IP_FEAT_SSL_THREE_SOCKETS),
+                   .ble_feature_bit_map        = 0,
+                   .ble_ext_feature_bit_map    = 0,
+                   .config_feature_bit_map     = SL_SI91X_FEAT_SLEEP_GPIO_SEL_BITMAP },
+  .ta_pool     = { .tx_ratio_in_buffer_pool     = TX_POOL_RATIO,
+                   .rx_ratio_in_buffer_pool     = RX_POOL_RATIO,
+                   .global_ratio_in_buffer_pool = GLOBAL_POOL_RATIO }
+};
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+static void application_start(void *argument);
+static sl_status_t network_up(void);
+static void print_command_args(const console_descriptive_command_t *command);
+static void print_status(sl_status_t status, uint32_t duration);
+sl_status_t help_command_handler(console_args_t *arguments);
+extern void cache_uart_rx_data(const char character);
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+void app_init(void)
+{
+  osThreadNew((osThreadFunc_t)application_start, NULL, &thread_attributes);
+}
+
+#ifndef SLI_SI91X_MCU_INTERFACE
+static void iostream_usart_init(void)
+{
+  /* Prevent buffering of output/input.*/
+#if !defined(__CROSSWORKS_ARM) && defined(__GNUC__)
+  setvbuf(stdout, NULL, _IONBF, 0); /*Set unbuffered mode for stdout (newlib)*/
+  setvbuf(stdin, NULL, _IONBF, 0);  /*Set unbuffered mode for stdin (newlib)*/
+#endif
+}
+
+static void iostream_rx(void)
+{
+  char c = 0;
+  sl_iostream_getchar(SL_IOSTREAM_STDIN, &c);
+  if (c > 0) {
+    cache_uart_rx_data(c);
+    if (c == '\n') {
+      end_of_cmd = true;
+    }
+  }
+}
+#endif
+
+static sl_status_t network_up(void)
+{
+  sl_status_t status;
+  sl_ip_address_t ip_address                  = { 0 };
+  sl_net_wifi_client_profile_t profile        = { 0 };
+  sl_wifi_firmware_version_t firmware_version = { 0 };
+
+  status = sl_net_init(SL_NET_WIFI_CLIENT_INTERFACE, &benchmark_configuration, NULL, NULL);
+  if (status != SL_STATUS_OK) {
+    printf("\r\nFailed to start Wi-Fi Client interface: 0x%lx\r\n", status);
+    return status;
+  }
+  printf("\r\nWi-Fi client interface init success\r\n");
+
+  status = sl_wifi_get_firmware_version(&firmware_version);
+  if (status == SL_STATUS_OK) {
+    print_firmware_version(&firmware_version);
+  }
+
+  status = sl_net_up(SL_NET_WIFI_CLIENT_INTERFACE, SL_NET_DEFAULT_WIFI_CLIENT_PROFILE_ID);
+  if (status != SL_STATUS_OK) {
+    printf("\r\nFailed to connect to AP: 0x%lx\r\n", status);
+    return status;
+  }
+  printf("\r\nWi-Fi client connected\r\n");
+
+  status = sl_net_get_profile(SL_NET_WIFI_CLIENT_INTERFACE, SL_NET_DEFAULT_WIFI_CLIENT_PROFILE_ID, &profile);
+  if (status != SL_STATUS_OK) {
+    printf("Failed to get client profile: 0x%lx\r\n", status);
+    return status;
+  }
+  ip_address.type = SL_IPV4;
+  memcpy(&ip_address.ip.v4.bytes, &profile.ip.ip.v4.ip_address.bytes, sizeof(sl_ipv4_address_t));
+  print_sl_ip_address(&ip_address);
+
+  // Load SSL CA certificate
+  status =
+    sl_net_set_credential(SL_NET_TLS_SERVER_CREDENTIAL_ID(0), SL_NET_SIGNING_CERTIFICATE, cacert, sizeof(cacert) - 1);
+  if (status != SL_STATUS_OK) {
+    printf("\r\nLoading TLS CA certificate in to FLASH Failed, Error Code : 0x%lX\r\n", status);
+    return status;
+  }
+  printf("\r\nLoad SSL CA certificate at index %d Success\r\n", 0);
+  return SL_STATUS_OK;
+}
+
+static void application_start(void *argument)
+{
+  UNUSED_PARAMETER(argument);
+  console_args_t args;
+  const console_descriptive_command_t *command;
+#ifndef SLI_SI91X_MCU_INTERFACE
+  iostream_usart_init();
+#endif
+
+  if (network_up() != SL_STATUS_OK) {
+    return;
+  }
+
+  printf("\r\nReady, type help for the list of commands\r\n");
+  console_line_ready = 0;
+
+  while (1) {
+    printf("\r\n> \r\n");
+#ifndef SLI_SI91X_MCU_INTERFACE
+    while (!end_of_cmd) {
+      iostream_rx();
+    }
+    end_of_cmd = false;
+#endif
+    while (!console_line_ready) {
+      console_process_uart_data();
+      osDelay(20);
+    }
+
+    sl_status_t result = console_process_buffer(&console_command_database, &args, &command);
+    if (result == SL_STATUS_OK) {
+      if (command->handler) {
+        printf("\r\n");
+        uint32_t start_time = osKernelGetTickCount();
+        result              = command->handler(&args);
+        uint32_t duration   = osKernelGetTickCount() - start_time;
+        print_status(result, duration);
+      }
+    } else if (result == SL_STATUS_COMMAND_IS_INVALID) {
+      printf("\r\nArgs: ");
+      print_command_args(command);
+      print_status(SL_STATUS_INVALID_PARAMETER, 0);
+    } else {
+      printf("\r\nNot supported\r\n");
+    }
+    console_line_ready = 0;
+  }
+}
+
+static void print_status(sl_status_t status, uint32_t duration)
+{
+  printf("\r\n0x%05lX: (%lums) %s\r\n", status, duration, (status == SL_STATUS_OK) ? "Success" : "");
+}
+
+sl_status_t help_command_handler(console_args_t *arguments)
+{
+  UNUSED_PARAMETER(arguments);
+  for (uint8_t a = 0; a < console_command_database.length; ++a) {
+    const console_descriptive_command_t *command = console_command_database.entries[a].value;
+    printf("\r\n%s  ", console_command_database.entries[a].key);
+    print_command_args(command);
+    printf("\r\n   %s", command->description);
+  }
+  printf("\r\n");
+  return SL_STATUS_OK;
+}
+
+static void print_command_args(const console_descriptive_command_t *command)
+{
+  bool is_optional = false;
+  for (int a = 0; command->argument_list[a] != CONSOLE_ARG_END; ++a) {
+    if (command->argument_list[a] & CONSOLE_ARG_OPTIONAL) {
+      printf("[-%c ", (char)(command->argument_list[a] & CONSOLE_ARG_OPTIONAL_CHARACTER_MASK));
+      is_optional = true;
+      continue;
+    } else if (command->argument_list[a] & CONSOLE_ARG_ENUM) {
+      uint8_t enum_index = command->argument_list[a] & CONSOLE_ARG_ENUM_INDEX_MASK;
+      printf("{");
+      for (int b = 0; console_argument_types[enum_index][b] != NULL; ++b) {
+        printf("%s%s", (b == 0) ? "" : "|", console_argument_types[enum_index][b]);
+      }
+      printf("}");
+    } else {
+      if (command->argument_help && command->argument_help[a]) {
+        printf("<%s>", command->argument_help[a]);
+      } else {
+        printf("<%s>", console_argument_type_strings[command->argument_list[a] & CONSOLE_ARG_ENUM_INDEX_MASK]);
+      }
+    }
+    printf(is_optional ? "] " : " ");
+    is_optional = false;
+  }
+}
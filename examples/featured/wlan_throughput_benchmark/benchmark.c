@@ -0,0 +1,783 @@
+/***************************************************************************/ /**
+ * @file benchmark.c
+ * @brief WLAN throughput and latency benchmark engine
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include "benchmark.h"
+#include "console_argument_types.h"
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "socket.h"
+#include "errno.h"
+#include "sl_utility.h"
+#include "sl_si91x_driver.h"
+#include "sl_si91x_socket_utility.h"
+#include "sl_si91x_protocol_types.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+// Handshake sent by the device at the start of every stream, see resources/scripts/throughput_benchmark_peer.py
+#define BENCHMARK_HANDSHAKE_MAGIC   "SLBM"
+#define BENCHMARK_HANDSHAKE_VERSION 1
+#define BENCHMARK_HANDSHAKE_LENGTH  12
+
+// Receive timeout of RX and echo streams. An echo packet that is not back within this time counts as an error.
+#define BENCHMARK_RECEIVE_TIMEOUT_MS 1000
+
+// Time the peer gets to stop sending after the end of a run before the RX stream gives up
+#define BENCHMARK_DRAIN_TIME_MS 2000
+
+// Time the CPU load probe runs alone before a run to measure the rate of an idle CPU
+#define BENCHMARK_CPU_CALIBRATION_MS 500
+
+#define BENCHMARK_STREAM_STACK_SIZE 2048
+#define BENCHMARK_PROBE_STACK_SIZE  256
+
+#define BENCHMARK_START_FLAG              BIT(0)
+#define BENCHMARK_STREAM_DONE_FLAG(index) BIT(((index) + 1))
+#define BENCHMARK_ALL_FLAGS               (BIT((BENCHMARK_MAX_STREAMS + 1)) - 1)
+
+#define BENCHMARK_HIGH_PERFORMANCE_SOCKET BIT(7)
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct {
+  benchmark_stream_config_t config;
+  benchmark_stream_result_t result;
+  uint8_t index;
+  int socket_id;
+  uint8_t buffer[BENCHMARK_UDP_MAX_PACKET_SIZE];
+} benchmark_stream_t;
+
+typedef struct {
+  uint32_t duration_ms;
+  uint32_t elapsed_ms;
+  uint32_t idle_rate;          // Probe iterations per millisecond with an idle CPU
+  uint32_t busy_rate;          // Probe iterations per millisecond during the run
+  uint32_t free_heap_before;   // Free heap bytes when the run started
+  uint32_t free_heap_after;    // Free heap bytes when the run ended
+  uint32_t min_ever_free_heap; // Lowest free heap since boot, sampled at the end of the run
+  bool socket_config_applied;  // sl_si91x_config_socket() accepted the socket split of the run
+  sl_si91x_bus_statistics_t bus;
+  sl_si91x_rx_dispatch_queue_statistics_t rx_dispatch[SL_SI91X_RX_DISPATCH_QUEUE_COUNT];
+  bool rx_dispatch_supported;
+  bool valid;
+} benchmark_run_info_t;
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static benchmark_stream_t streams[BENCHMARK_MAX_STREAMS];
+static uint8_t stream_count;
+static benchmark_run_info_t run_info;
+static volatile bool run_active;
+static osEventFlagsId_t benchmark_events;
+static uint32_t run_start_tick;
+
+static volatile uint32_t probe_iterations;
+
+static const char *const rx_dispatch_queue_names[SL_SI91X_RX_DISPATCH_QUEUE_COUNT] = { "wifi",
+                                                                                       "network",
+                                                                                       "socket",
+                                                                                       "socket_data",
+                                                                                       "ble" };
+
+static const osThreadAttr_t stream_thread_attributes = {
+  .name       = "bench_stream",
+  .attr_bits  = 0,
+  .cb_mem     = 0,
+  .cb_size    = 0,
+  .stack_mem  = 0,
+  .stack_size = BENCHMARK_STREAM_STACK_SIZE,
+  .priority   = osPriorityNormal,
+  .tz_module  = 0,
+  .reserved   = 0,
+};
+
+// The probe shares the priority of the idle task, so it only gets the CPU time no other thread wants. The idle task
+// still gets its turns in between and frees the stacks of the finished threads.
+static const osThreadAttr_t probe_thread_attributes = {
+  .name       = "bench_cpu_probe",
+  .attr_bits  = 0,
+  .cb_mem     = 0,
+  .cb_size    = 0,
+  .stack_mem  = 0,
+  .stack_size = BENCHMARK_PROBE_STACK_SIZE,
+  .priority   = osPriorityIdle,
+  .tz_module  = 0,
+  .reserved   = 0,
+};
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+static uint16_t benchmark_max_packet_size(benchmark_protocol_t protocol)
+{
+  switch (protocol) {
+    case BENCHMARK_PROTOCOL_TLS:
+      return BENCHMARK_TLS_MAX_PACKET_SIZE;
+    case BENCHMARK_PROTOCOL_UDP:
+      return BENCHMARK_UDP_MAX_PACKET_SIZE;
+    default:
+      return BENCHMARK_TCP_MAX_PACKET_SIZE;
+  }
+}
+
+sl_status_t benchmark_add_stream(const benchmark_stream_config_t *config, uint8_t *index)
+{
+  if (run_active) {
+    return SL_STATUS_BUSY;
+  }
+  if (stream_count >= BENCHMARK_MAX_STREAMS) {
+    return SL_STATUS_FULL;
+  }
+  if ((config->protocol > BENCHMARK_PROTOCOL_UDP) || (config->direction > BENCHMARK_DIRECTION_TX)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  benchmark_stream_t *stream = &streams[stream_count];
+  uint16_t max_packet_size   = benchmark_max_packet_size(config->protocol);
+
+  memset(stream, 0, sizeof(*stream));
+  stream->config    = *config;
+  stream->index     = stream_count;
+  stream->socket_id = -1;
+  if ((stream->config.packet_size == 0) || (stream->config.packet_size > max_packet_size)) {
+    stream->config.packet_size = max_packet_size;
+  } else if (stream->config.packet_size < BENCHMARK_MIN_PACKET_SIZE) {
+    stream->config.packet_size = BENCHMARK_MIN_PACKET_SIZE;
+  }
+
+  if (index != NULL) {
+    *index = stream_count;
+  }
+  stream_count++;
+  run_info.valid = false;
+  return SL_STATUS_OK;
+}
+
+sl_status_t benchmark_clear_streams(void)
+{
+  if (run_active) {
+    return SL_STATUS_BUSY;
+  }
+  stream_count   = 0;
+  run_info.valid = false;
+  return SL_STATUS_OK;
+}
+
+uint8_t benchmark_get_stream_count(void)
+{
+  return stream_count;
+}
+
+const benchmark_stream_config_t *benchmark_get_stream(uint8_t index)
+{
+  return (index < stream_count) ? &streams[index].config : NULL;
+}
+
+/******************************************************
+ *                 Latency recording
+ ******************************************************/
+
+static uint32_t benchmark_elapsed_us(uint32_t start_count)
+{
+  uint32_t ticks = osKernelGetSysTimerCount() - start_count;
+  return (uint32_t)(((uint64_t)ticks * 1000000) / osKernelGetSysTimerFreq());
+}
+
+static void benchmark_record_latency(benchmark_latency_t *latency, uint32_t sample_us)
+{
+  uint8_t bucket = 0;
+  while ((bucket < (BENCHMARK_LATENCY_BUCKETS - 1)) && ((sample_us >> (bucket + 1)) != 0)) {
+    bucket++;
+  }
+  latency->buckets[bucket]++;
+
+  if ((latency->count == 0) || (sample_us < latency->min_us)) {
+    latency->min_us = sample_us;
+  }
+  if (sample_us > latency->max_us) {
+    latency->max_us = sample_us;
+  }
+  latency->total_us += sample_us;
+  latency->count++;
+}
+
+// Upper bound of the bucket holding the given percentile, capped by the largest sample
+static uint32_t benchmark_latency_percentile(const benchmark_latency_t *latency, uint8_t percentile)
+{
+  if (latency->count == 0) {
+    return 0;
+  }
+
+  uint32_t rank       = (uint32_t)(((uint64_t)latency->count * percentile + 99) / 100);
+  uint32_t cumulative = 0;
+  for (uint8_t bucket = 0; bucket < BENCHMARK_LATENCY_BUCKETS; bucket++) {
+    cumulative += latency->buckets[bucket];
+    if (cumulative >= rank) {
+      uint32_t upper_bound = (bucket == (BENCHMARK_LATENCY_BUCKETS - 1)) ? latency->max_us : (2UL << bucket);
+      return (upper_bound < latency->max_us) ? upper_bound : latency->max_us;
+    }
+  }
+  return latency->max_us;
+}
+
+/******************************************************
+ *                     Streams
+ ******************************************************/
+
+static void benchmark_put_le16(uint8_t *data, uint16_t value)
+{
+  data[0] = (uint8_t)value;
+  data[1] = (uint8_t)(value >> 8);
+}
+
+static void benchmark_put_le32(uint8_t *data, uint32_t value)
+{
+  benchmark_put_le16(data, (uint16_t)value);
+  benchmark_put_le16(&data[2], (uint16_t)(value >> 16));
+}
+
+static uint32_t benchmark_get_le32(const uint8_t *data)
+{
+  return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static sl_status_t benchmark_send_handshake(const benchmark_stream_t *stream)
+{
+  uint8_t handshake[BENCHMARK_HANDSHAKE_LENGTH];
+
+  memcpy(handshake, BENCHMARK_HANDSHAKE_MAGIC, 4);
+  handshake[4] = BENCHMARK_HANDSHAKE_VERSION;
+  handshake[5] = (uint8_t)stream->config.direction;
+  benchmark_put_le16(&handshake[6], stream->config.packet_size);
+  benchmark_put_le32(&handshake[8], run_info.duration_ms);
+
+  if (send(stream->socket_id, handshake, sizeof(handshake), 0) != (ssize_t)sizeof(handshake)) {
+    printf("\r\nStream %u: handshake send failed with bsd error: %d\r\n", stream->index, errno);
+    return SL_STATUS_FAIL;
+  }
+  return SL_STATUS_OK;
+}
+
+static sl_status_t benchmark_stream_open(benchmark_stream_t *stream)
+{
+  const benchmark_stream_config_t *config = &stream->config;
+  struct sockaddr_in server_address       = { 0 };
+  bool is_udp                             = (config->protocol == BENCHMARK_PROTOCOL_UDP);
+
+  stream->socket_id = socket(AF_INET, is_udp ? SOCK_DGRAM : SOCK_STREAM, is_udp ? IPPROTO_UDP : IPPROTO_TCP);
+  if (stream->socket_id < 0) {
+    printf("\r\nStream %u: socket create failed with bsd error: %d\r\n", stream->index, errno);
+    return SL_STATUS_FAIL;
+  }
+
+  if (config->protocol == BENCHMARK_PROTOCOL_TLS) {
+    if (setsockopt(stream->socket_id, SOL_TCP, TCP_ULP, TLS, sizeof(TLS)) < 0) {
+      printf("\r\nStream %u: enabling TLS failed with bsd error: %d\r\n", stream->index, errno);
+      return SL_STATUS_FAIL;
+    }
+  }
+
+  if ((config->direction == BENCHMARK_DIRECTION_RX) && !is_udp) {
+    uint32_t high_performance_socket = BENCHMARK_HIGH_PERFORMANCE_SOCKET;
+    if (setsockopt(stream->socket_id,
+                   SOL_SOCKET,
+                   SL_SO_HIGH_PERFORMANCE_SOCKET,
+                   &high_performance_socket,
+                   sizeof(high_performance_socket))
+        < 0) {
+      printf("\r\nStream %u: high performance option failed with bsd error: %d\r\n", stream->index, errno);
+    }
+  }
+
+  if (config->direction != BENCHMARK_DIRECTION_TX) {
+    sl_si91x_time_value timeout = { .tv_sec = 0, .tv_usec = BENCHMARK_RECEIVE_TIMEOUT_MS * 1000 };
+    if (setsockopt(stream->socket_id, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) < 0) {
+      printf("\r\nStream %u: receive timeout failed with bsd error: %d\r\n", stream->index, errno);
+      return SL_STATUS_FAIL;
+    }
+  }
+
+  server_address.sin_family = AF_INET;
+  server_address.sin_port   = config->server_port;
+  memcpy(&server_address.sin_addr.s_addr, &config->server_ip, sizeof(config->server_ip));
+
+  if (connect(stream->socket_id, (struct sockaddr *)&server_address, sizeof(server_address)) < 0) {
+    printf("\r\nStream %u: connect failed with bsd error: %d\r\n", stream->index, errno);
+    return SL_STATUS_FAIL;
+  }
+
+  return benchmark_send_handshake(stream);
+}
+
+static bool benchmark_run_expired(void)
+{
+  return (osKernelGetTickCount() - run_start_tick) >= run_info.duration_ms;
+}
+
+// Hold TX and echo streams to their configured rate
+static void benchmark_stream_pace(const benchmark_stream_t *stream, uint64_t bytes_sent)
+{
+  if (stream->config.rate_kbps == 0) {
+    return;
+  }
+  // 1 kbit/s is 1 bit per millisecond
+  while (!benchmark_run_expired()
+         && ((bytes_sent * 8) > ((uint64_t)stream->config.rate_kbps * (osKernelGetTickCount() - run_start_tick)))) {
+    osDelay(1);
+  }
+}
+
+static sl_status_t benchmark_stream_tx(benchmark_stream_t *stream)
+{
+  benchmark_stream_result_t *result = &stream->result;
+
+  while (!benchmark_run_expired()) {
+    benchmark_stream_pace(stream, result->bytes);
+
+    uint32_t start  = osKernelGetSysTimerCount();
+    ssize_t sent    = send(stream->socket_id, stream->buffer, stream->config.packet_size, 0);
+    uint32_t sample = benchmark_elapsed_us(start);
+    if (sent < 0) {
+      if (errno == ENOBUFS) {
+        continue;
+      }
+      result->errors++;
+      printf("\r\nStream %u: send failed with bsd error: %d\r\n", stream->index, errno);
+      return SL_STATUS_FAIL;
+    }
+    benchmark_record_latency(&result->latency, sample);
+    result->bytes += (uint64_t)sent;
+    result->packets++;
+  }
+  return SL_STATUS_OK;
+}
+
+static sl_status_t benchmark_stream_rx(benchmark_stream_t *stream)
+{
+  benchmark_stream_result_t *result = &stream->result;
+  bool is_udp                       = (stream->config.protocol == BENCHMARK_PROTOCOL_UDP);
+
+  // The peer sends for the duration of the run, give it some time to notice the end before giving up on it
+  while ((osKernelGetTickCount() - run_start_tick) < (run_info.duration_ms + BENCHMARK_DRAIN_TIME_MS)) {
+    uint32_t start  = osKernelGetSysTimerCount();
+    ssize_t length  = recv(stream->socket_id, stream->buffer, sizeof(stream->buffer), 0);
+    uint32_t sample = benchmark_elapsed_us(start);
+    if (length == 0) {
+      break;
+    }
+    if (length < 0) {
+      if (errno == ENOTCONN) {
+        break;
+      }
+      if (benchmark_run_expired()) {
+        break;
+      }
+      // A lost UDP handshake leaves the peer silent, so ask again until data arrives
+      if (is_udp && (result->packets == 0) && (benchmark_send_handshake(stream) != SL_STATUS_OK)) {
+        return SL_STATUS_FAIL;
+      }
+      result->errors++;
+      continue;
+    }
+    benchmark_record_latency(&result->latency, sample);
+    result->bytes += (uint64_t)length;
+    result->packets++;
+  }
+  return SL_STATUS_OK;
+}
+
+// Receive the echo of a packet. Returns the bytes echoed back, 0 on timeout and -1 if the stream broke.
+static int32_t benchmark_stream_receive_echo(benchmark_stream_t *stream, uint32_t sequence)
+{
+  uint16_t packet_size = stream->config.packet_size;
+
+  if (stream->config.protocol == BENCHMARK_PROTOCOL_UDP) {
+    // Late echoes of packets that already timed out are skipped
+    while (1) {
+      ssize_t length = recv(stream->socket_id, stream->buffer, sizeof(stream->buffer), 0);
+      if (length < 0) {
+        return 0;
+      }
+      if ((length >= BENCHMARK_MIN_PACKET_SIZE) && (benchmark_get_le32(stream->buffer) == sequence)) {
+        return (int32_t)length;
+      }
+    }
+  }
+
+  // TCP does not lose the echo, a receive timeout only means the round trip takes longer
+  uint16_t received = 0;
+  while (received < packet_size) {
+    ssize_t length = recv(stream->socket_id, &stream->buffer[received], packet_size - received, 0);
+    if (length == 0 || ((length < 0) && (errno == ENOTCONN))) {
+      return -1;
+    }
+    if (length < 0) {
+      if (benchmark_run_expired()) {
+        return 0;
+      }
+      continue;
+    }
+    received = (uint16_t)(received + length);
+  }
+  return (benchmark_get_le32(stream->buffer) == sequence) ? (int32_t)received : -1;
+}
+
+static sl_status_t benchmark_stream_echo(benchmark_stream_t *stream)
+{
+  benchmark_stream_result_t *result = &stream->result;
+  uint64_t bytes_sent               = 0;
+
+  for (uint32_t sequence = 0; !benchmark_run_expired(); sequence++) {
+    benchmark_stream_pace(stream, bytes_sent);
+
+    benchmark_put_le32(stream->buffer, sequence);
+    uint32_t start = osKernelGetSysTimerCount();
+    ssize_t sent   = send(stream->socket_id, stream->buffer, stream->config.packet_size, 0);
+    if (sent < 0) {
+      if (errno == ENOBUFS) {
+        continue;
+      }
+      result->errors++;
+      printf("\r\nStream %u: send failed with bsd error: %d\r\n", stream->index, errno);
+      return SL_STATUS_FAIL;
+    }
+    bytes_sent += (uint64_t)sent;
+
+    int32_t echoed = benchmark_stream_receive_echo(stream, sequence);
+    if (echoed < 0) {
+      result->errors++;
+      printf("\r\nStream %u: echo stream lost synchronization\r\n", stream->index);
+      return SL_STATUS_FAIL;
+    }
+    if (echoed == 0) {
+      result->errors++;
+      continue;
+    }
+    benchmark_record_latency(&result->latency, benchmark_elapsed_us(start));
+    result->bytes += (uint64_t)echoed;
+    result->packets++;
+  }
+  return SL_STATUS_OK;
+}
+
+static void benchmark_stream_thread(void *argument)
+{
+  benchmark_stream_t *stream = (benchmark_stream_t *)argument;
+
+  osEventFlagsWait(benchmark_events, BENCHMARK_START_FLAG, osFlagsWaitAny | osFlagsNoClear, osWaitForever);
+
+  stream->result.status = benchmark_stream_open(stream);
+  if (stream->result.status == SL_STATUS_OK) {
+    switch (stream->config.direction) {
+      case BENCHMARK_DIRECTION_TX:
+        stream->result.status = benchmark_stream_tx(stream);
+        break;
+      case BENCHMARK_DIRECTION_RX:
+        stream->result.status = benchmark_stream_rx(stream);
+        break;
+      default:
+        stream->result.status = benchmark_stream_echo(stream);
+        break;
+    }
+  }
+  stream->result.elapsed_ms = osKernelGetTickCount() - run_start_tick;
+
+  if (stream->socket_id >= 0) {
+    close(stream->socket_id);
+    stream->socket_id = -1;
+  }
+
+  osEventFlagsSet(benchmark_events, BENCHMARK_STREAM_DONE_FLAG(stream->index));
+  osThreadExit();
+}
+
+/******************************************************
+ *                 Run management
+ ******************************************************/
+
+static void benchmark_cpu_probe_thread(void *argument)
+{
+  UNUSED_PARAMETER(argument);
+  while (1) {
+    probe_iterations++;
+  }
+}
+
+// Split the NWP sockets the way the streams of this run use them
+static void benchmark_configure_sockets(void)
+{
+  sl_si91x_socket_config_t socket_config = { 0 };
+
+  for (uint8_t i = 0; i < stream_count; i++) {
+    const benchmark_stream_config_t *config = &streams[i].config;
+    bool is_udp                             = (config->protocol == BENCHMARK_PROTOCOL_UDP);
+    // Echo streams receive as much as they send. RX sockets can still send, while TX sockets only get a small
+    // receive window, so only pure TX streams count as TX sockets.
+    bool is_tx = (config->direction == BENCHMARK_DIRECTION_TX);
+
+    socket_config.total_sockets++;
+    if (is_udp) {
+      socket_config.total_udp_sockets++;
+      if (is_tx) {
+        socket_config.udp_tx_only_sockets++;
+      } else {
+        socket_config.udp_rx_only_sockets++;
+      }
+    } else {
+      socket_config.total_tcp_sockets++;
+      if (is_tx) {
+        socket_config.tcp_tx_only_sockets++;
+      } else {
+        socket_config.tcp_rx_only_sockets++;
+        if (config->direction == BENCHMARK_DIRECTION_RX) {
+          socket_config.tcp_rx_high_performance_sockets++;
+        }
+      }
+    }
+  }
+  if (socket_config.tcp_rx_only_sockets != 0) {
+    socket_config.tcp_rx_window_size_cap   = 44;
+    socket_config.tcp_rx_window_div_factor = 44;
+  }
+
+  sl_status_t status             = sl_si91x_config_socket(socket_config);
+  run_info.socket_config_applied = (status == SL_STATUS_OK);
+  if (status != SL_STATUS_OK) {
+    // The NWP may refuse a new split once sockets were created, the run continues with the current one
+    printf("\r\nSocket config not applied: 0x%lx\r\n", status);
+  }
+}
+
+sl_status_t benchmark_run(uint32_t duration_ms)
+{
+  osThreadId_t probe_thread;
+  uint32_t done_flags = 0;
+  sl_status_t status  = SL_STATUS_OK;
+
+  if (run_active) {
+    return SL_STATUS_BUSY;
+  }
+  if (stream_count == 0) {
+    return SL_STATUS_EMPTY;
+  }
+  if (benchmark_events == NULL) {
+    benchmark_events = osEventFlagsNew(NULL);
+    if (benchmark_events == NULL) {
+      return SL_STATUS_ALLOCATION_FAILED;
+    }
+  }
+
+  memset(&run_info, 0, sizeof(run_info));
+  run_info.duration_ms = duration_ms;
+  run_active           = true;
+  osEventFlagsClear(benchmark_events, BENCHMARK_ALL_FLAGS);
+
+  benchmark_configure_sockets();
+
+  // Measure how fast the probe counts while nothing else runs
+  probe_iterations = 0;
+  probe_thread     = osThreadNew(benchmark_cpu_probe_thread, NULL, &probe_thread_attributes);
+  if (probe_thread != NULL) {
+    uint32_t start = osKernelGetTickCount();
+    osDelay(BENCHMARK_CPU_CALIBRATION_MS);
+    uint32_t elapsed   = osKernelGetTickCount() - start;
+    run_info.idle_rate = probe_iterations / ((elapsed != 0) ? elapsed : 1);
+  }
+
+  for (uint8_t i = 0; i < stream_count; i++) {
+    benchmark_stream_t *stream = &streams[i];
+    memset(&stream->result, 0, sizeof(stream->result));
+    for (uint16_t j = 0; j < sizeof(stream->buffer); j++) {
+      stream->buffer[j] = (uint8_t)('A' + (j % 26));
+    }
+    if (osThreadNew(benchmark_stream_thread, stream, &stream_thread_attributes) == NULL) {
+      stream->result.status = SL_STATUS_ALLOCATION_FAILED;
+      done_flags |= BENCHMARK_STREAM_DONE_FLAG(i);
+    }
+  }
+
+  sl_si91x_reset_bus_statistics();
+  sl_si91x_reset_rx_dispatch_statistics();
+  run_info.free_heap_before = xPortGetFreeHeapSize();
+  probe_iterations          = 0;
+  run_start_tick            = osKernelGetTickCount();
+  osEventFlagsSet(benchmark_events, BENCHMARK_START_FLAG);
+
+  for (uint8_t i = 0; i < stream_count; i++) {
+    uint32_t flag = BENCHMARK_STREAM_DONE_FLAG(i);
+    if ((done_flags & flag) == 0) {
+      osEventFlagsWait(benchmark_events, flag, osFlagsWaitAny, osWaitForever);
+    }
+  }
+
+  run_info.elapsed_ms = osKernelGetTickCount() - run_start_tick;
+  run_info.busy_rate  = probe_iterations / ((run_info.elapsed_ms != 0) ? run_info.elapsed_ms : 1);
+  if (probe_thread != NULL) {
+    osThreadTerminate(probe_thread);
+  }
+
+  // Let the idle task release the stacks of the finished stream threads before sampling the heap
+  osDelay(10);
+  run_info.free_heap_after    = xPortGetFreeHeapSize();
+  run_info.min_ever_free_heap = xPortGetMinimumEverFreeHeapSize();
+
+  sl_si91x_get_bus_statistics(&run_info.bus);
+  run_info.rx_dispatch_supported = true;
+  for (uint8_t queue = 0; queue < SL_SI91X_RX_DISPATCH_QUEUE_COUNT; queue++) {
+    if (sl_si91x_get_rx_dispatch_queue_statistics((sl_si91x_rx_dispatch_queue_t)queue, &run_info.rx_dispatch[queue])
+        != SL_STATUS_OK) {
+      run_info.rx_dispatch_supported = false;
+      break;
+    }
+  }
+
+  for (uint8_t i = 0; i < stream_count; i++) {
+    if ((status == SL_STATUS_OK) && (streams[i].result.status != SL_STATUS_OK)) {
+      status = streams[i].result.status;
+    }
+  }
+  run_info.valid = true;
+  run_active     = false;
+  return status;
+}
+
+/******************************************************
+ *                     Report
+ ******************************************************/
+
+// Throughput in kbit/s. 1 byte per millisecond is 8 kbit/s.
+static uint32_t benchmark_throughput_kbps(uint64_t bytes, uint32_t elapsed_ms)
+{
+  return (elapsed_ms == 0) ? 0 : (uint32_t)((bytes * 8) / elapsed_ms);
+}
+
+static void benchmark_print_stream(const benchmark_stream_t *stream)
+{
+  const benchmark_stream_config_t *config = &stream->config;
+  const benchmark_stream_result_t *result = &stream->result;
+  const benchmark_latency_t *latency      = &result->latency;
+  const uint8_t *ip                       = (const uint8_t *)&config->server_ip;
+  uint32_t kbps                           = benchmark_throughput_kbps(result->bytes, result->elapsed_ms);
+
+  printf("\r\nStream %u: %s %s %u.%u.%u.%u:%u, %u bytes/packet",
+         stream->index,
+         bench_protocol_type[config->protocol],
+         bench_direction_type[config->direction],
+         ip[0],
+         ip[1],
+         ip[2],
+         ip[3],
+         config->server_port,
+         config->packet_size);
+  printf("\r\n  status 0x%lx, %" PRIu32 " packets, %" PRIu32 " errors, %" PRIu32 " ms",
+         result->status,
+         result->packets,
+         result->errors,
+         result->elapsed_ms);
+  printf("\r\n  throughput %" PRIu32 ".%03" PRIu32 " Mbps (%" PRIu32 " kB)",
+         kbps / 1000,
+         kbps % 1000,
+         (uint32_t)(result->bytes / 1000));
+  if (latency->count != 0) {
+    printf("\r\n  latency us: min %" PRIu32 " avg %" PRIu32 " p50 %" PRIu32 " p90 %" PRIu32 " p99 %" PRIu32
+           " max %" PRIu32,
+           latency->min_us,
+           (uint32_t)(latency->total_us / latency->count),
+           benchmark_latency_percentile(latency, 50),
+           benchmark_latency_percentile(latency, 90),
+           benchmark_latency_percentile(latency, 99),
+           latency->max_us);
+  }
+}
+
+void benchmark_print_report(void)
+{
+  uint64_t total_bytes = 0;
+
+  if (!run_info.valid) {
+    printf("\r\nNo benchmark results, use bench_run first\r\n");
+    return;
+  }
+
+  printf("\r\nBenchmark of %" PRIu32 " ms with %u streams", run_info.elapsed_ms, stream_count);
+  for (uint8_t i = 0; i < stream_count; i++) {
+    benchmark_print_stream(&streams[i]);
+    total_bytes += streams[i].result.bytes;
+  }
+
+  uint32_t total_kbps = benchmark_throughput_kbps(total_bytes, run_info.elapsed_ms);
+  printf("\r\n\r\nAggregate throughput %" PRIu32 ".%03" PRIu32 " Mbps", total_kbps / 1000, total_kbps % 1000);
+
+  if (run_info.idle_rate != 0) {
+    uint32_t idle_percent = (uint32_t)(((uint64_t)run_info.busy_rate * 100) / run_info.idle_rate);
+    printf("\r\nHost CPU load %" PRIu32 "%%", (idle_percent < 100) ? (100 - idle_percent) : 0);
+  } else {
+    printf("\r\nHost CPU load not measured");
+  }
+
+  printf("\r\nHeap free: %" PRIu32 " before, %" PRIu32 " after, %" PRIu32 " lowest since boot",
+         run_info.free_heap_before,
+         run_info.free_heap_after,
+         run_info.min_ever_free_heap);
+  printf("\r\nSocket config %s", run_info.socket_config_applied ? "applied" : "not applied");
+  printf("\r\nBus: %" PRIu32 " frames written, %" PRIu32 " status reads, %" PRIu32 " payload bytes",
+         run_info.bus.frames_written,
+         run_info.bus.interrupt_status_reads,
+         run_info.bus.payload_bytes);
+
+  if (run_info.rx_dispatch_supported) {
+    for (uint8_t queue = 0; queue < SL_SI91X_RX_DISPATCH_QUEUE_COUNT; queue++) {
+      const sl_si91x_rx_dispatch_queue_statistics_t *statistics = &run_info.rx_dispatch[queue];
+      if (statistics->dispatched == 0 && statistics->dropped == 0 && statistics->held == 0) {
+        continue;
+      }
+      printf("\r\nRX dispatch %s: %" PRIu32 " dispatched, %" PRIu32 " dropped, %" PRIu32 " held, watermark %u, "
+             "max latency %" PRIu32 " ms",
+             rx_dispatch_queue_names[queue],
+             statistics->dispatched,
+             statistics->dropped,
+             statistics->held,
+             statistics->high_watermark,
+             statistics->max_latency_ms);
+    }
+  }
+  printf("\r\n");
+}
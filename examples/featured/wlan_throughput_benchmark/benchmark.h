@@ -0,0 +1,156 @@
+/***************************************************************************/ /**
+ * @file benchmark.h
+ * @brief WLAN throughput and latency benchmark engine
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "sl_status.h"
+#include <stdint.h>
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+// Number of streams that can run at the same time
+#ifndef BENCHMARK_MAX_STREAMS
+#define BENCHMARK_MAX_STREAMS 4
+#endif
+
+// Largest payload per packet for each protocol
+#define BENCHMARK_TCP_MAX_PACKET_SIZE 1460
+#define BENCHMARK_UDP_MAX_PACKET_SIZE 1470
+#define BENCHMARK_TLS_MAX_PACKET_SIZE 1370
+
+// Smallest payload per packet, an echo packet carries a 4 byte sequence number
+#define BENCHMARK_MIN_PACKET_SIZE 4
+
+// Duration of a run when none is given
+#define BENCHMARK_DEFAULT_DURATION_MS 10000
+
+// Latency histogram buckets. Bucket n counts samples of [2^n, 2^(n+1)) microseconds, bucket 0 also counts 0 us
+#define BENCHMARK_LATENCY_BUCKETS 24
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+// Protocol of a stream. The order matches the sorted console option list.
+typedef enum {
+  BENCHMARK_PROTOCOL_TCP,
+  BENCHMARK_PROTOCOL_TLS,
+  BENCHMARK_PROTOCOL_UDP,
+} benchmark_protocol_t;
+
+// Data direction of a stream, seen from the device. The order matches the sorted console option list.
+typedef enum {
+  BENCHMARK_DIRECTION_ECHO, // Device sends packets and the peer returns them, latency is the round trip time
+  BENCHMARK_DIRECTION_RX,   // Peer sends packets, latency is the time spent waiting in recv()
+  BENCHMARK_DIRECTION_TX,   // Device sends packets, latency is the time spent in send()
+} benchmark_direction_t;
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+// Configuration of a stream
+typedef struct {
+  benchmark_protocol_t protocol;
+  benchmark_direction_t direction;
+  uint32_t server_ip;   // IPv4 address of the peer, in network byte order
+  uint16_t server_port; // Port of the peer
+  uint16_t packet_size; // Payload bytes per packet, 0 selects the largest size of the protocol
+  uint32_t rate_kbps;   // Paced send rate in kbit/s for TX and echo streams, 0 sends as fast as possible
+} benchmark_stream_config_t;
+
+// Latency samples of a stream
+typedef struct {
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t total_us;
+  uint32_t buckets[BENCHMARK_LATENCY_BUCKETS];
+} benchmark_latency_t;
+
+// Result of a stream for the last run
+typedef struct {
+  sl_status_t status;  // SL_STATUS_OK, or the reason the stream stopped early
+  uint64_t bytes;      // Payload bytes sent for TX, received for RX and echoed back for echo streams
+  uint32_t packets;    // Packets counted in bytes
+  uint32_t errors;     // Failed sends and receives, and echo packets that did not come back in time
+  uint32_t elapsed_ms; // Time from the start of the run until the stream stopped
+  benchmark_latency_t latency;
+} benchmark_stream_result_t;
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/***************************************************************************/ /**
+ * Add a stream to the next runs.
+ *
+ * @param[in] config Stream configuration. packet_size is clamped to the limits of the protocol.
+ * @param[out] index Index of the new stream, may be NULL.
+ * @return SL_STATUS_OK, SL_STATUS_FULL if BENCHMARK_MAX_STREAMS streams already exist,
+ *         or SL_STATUS_BUSY during a run.
+ ******************************************************************************/
+sl_status_t benchmark_add_stream(const benchmark_stream_config_t *config, uint8_t *index);
+
+/***************************************************************************/ /**
+ * Remove all streams.
+ *
+ * @return SL_STATUS_OK, or SL_STATUS_BUSY during a run.
+ ******************************************************************************/
+sl_status_t benchmark_clear_streams(void);
+
+/***************************************************************************/ /**
+ * Get the number of configured streams.
+ ******************************************************************************/
+uint8_t benchmark_get_stream_count(void);
+
+/***************************************************************************/ /**
+ * Get the configuration of a stream, or NULL if index is out of range.
+ ******************************************************************************/
+const benchmark_stream_config_t *benchmark_get_stream(uint8_t index);
+
+/***************************************************************************/ /**
+ * Run all configured streams concurrently and block until they finish.
+ *
+ * @param[in] duration_ms Length of the run. The peer is told the same duration in the stream handshake.
+ * @return SL_STATUS_OK if every stream ran to the end, SL_STATUS_EMPTY if no stream is configured,
+ *         or the status of the first stream that failed.
+ ******************************************************************************/
+sl_status_t benchmark_run(uint32_t duration_ms);
+
+/***************************************************************************/ /**
+ * Print the throughput, latency percentiles, CPU load and buffer statistics of the last run.
+ ******************************************************************************/
+void benchmark_print_report(void);
+
+#endif // BENCHMARK_H
@@ -0,0 +1,125 @@
+/***************************************************************************/ /**
+ * @file benchmark_commands.c
+ * @brief Console commands of the WLAN throughput benchmark
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include "console.h"
+#include "console_argument_types.h"
+#include "benchmark.h"
+#include "sl_utility.h"
+#include <stdio.h>
+#include <inttypes.h>
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+sl_status_t stream_add_command_handler(console_args_t *arguments)
+{
+  benchmark_stream_config_t config = { 0 };
+  uint32_t port                    = (uint32_t)GET_COMMAND_ARG(arguments, 3);
+  uint32_t packet_size             = GET_OPTIONAL_COMMAND_ARG(arguments, 4, 0, uint32_t);
+  uint8_t index                    = 0;
+
+  if ((port == 0) || (port > UINT16_MAX) || (packet_size > UINT16_MAX)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  config.protocol    = (benchmark_protocol_t)GET_COMMAND_ARG(arguments, 0);
+  config.direction   = (benchmark_direction_t)GET_COMMAND_ARG(arguments, 1);
+  config.server_ip   = (uint32_t)GET_COMMAND_ARG(arguments, 2);
+  config.server_port = (uint16_t)port;
+  config.packet_size = (uint16_t)packet_size;
+  config.rate_kbps   = GET_OPTIONAL_COMMAND_ARG(arguments, 5, 0, uint32_t);
+
+  sl_status_t status = benchmark_add_stream(&config, &index);
+  if (status == SL_STATUS_OK) {
+    printf("Stream %u added, %u bytes/packet\r\n", index, benchmark_get_stream(index)->packet_size);
+  }
+  return status;
+}
+
+sl_status_t stream_list_command_handler(console_args_t *arguments)
+{
+  UNUSED_PARAMETER(arguments);
+  uint8_t count = benchmark_get_stream_count();
+
+  if (count == 0) {
+    printf("No streams\r\n");
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    const benchmark_stream_config_t *config = benchmark_get_stream(i);
+    const uint8_t *ip                       = (const uint8_t *)&config->server_ip;
+
+    printf("%u: %s %s %u.%u.%u.%u:%u, %u bytes/packet, ",
+           i,
+           bench_protocol_type[config->protocol],
+           bench_direction_type[config->direction],
+           ip[0],
+           ip[1],
+           ip[2],
+           ip[3],
+           config->server_port,
+           config->packet_size);
+    if (config->rate_kbps == 0) {
+      printf("unpaced\r\n");
+    } else {
+      printf("%" PRIu32 " kbps\r\n", config->rate_kbps);
+    }
+  }
+  return SL_STATUS_OK;
+}
+
+sl_status_t stream_clear_command_handler(console_args_t *arguments)
+{
+  UNUSED_PARAMETER(arguments);
+  return benchmark_clear_streams();
+}
+
+sl_status_t bench_run_command_handler(console_args_t *arguments)
+{
+  uint32_t duration_ms = GET_OPTIONAL_COMMAND_ARG(arguments, 0, BENCHMARK_DEFAULT_DURATION_MS, uint32_t);
+
+  if (duration_ms == 0) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  printf("Running %u streams for %" PRIu32 " ms\r\n", benchmark_get_stream_count(), duration_ms);
+  sl_status_t status = benchmark_run(duration_ms);
+  if (status != SL_STATUS_EMPTY && status != SL_STATUS_BUSY) {
+    benchmark_print_report();
+  }
+  return status;
+}
+
+sl_status_t bench_report_command_handler(console_args_t *arguments)
+{
+  UNUSED_PARAMETER(arguments);
+  benchmark_print_report();
+  return SL_STATUS_OK;
+}
@@ -0,0 +1,38 @@
+
+#include "console_types.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************
+ *                     Macros
+ ******************************************************/
+
+#define CONSOLE_TYPE(name) CONSOLE_##name##_TYPE
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+typedef enum {
+  CONSOLE_TYPE(bench_direction),
+  CONSOLE_TYPE(bench_protocol),
+  CONSOLE_TYPE_COUNT // Equals the number of different types
+} console_type_t;
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+extern const char *bench_direction_type[];
+extern const char *bench_protocol_type[];
+
+extern const arg_list_t console_argument_types[];
+extern const value_list_t console_argument_values[];
+extern const uint8_t console_argument_counts[];
+
+#ifdef __cplusplus
+} /*extern "C" */
+#endif
@@ -0,0 +1,36 @@
+
+#include "console_types.h"
+#include "console_argument_types.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+const char *bench_direction_type[] = { "echo", "rx", "tx", NULL };
+const char *bench_protocol_type[]  = { "tcp", "tls", "udp", NULL };
+
+const arg_list_t console_argument_types[] = {
+  [CONSOLE_TYPE(bench_direction)] = bench_direction_type,
+  [CONSOLE_TYPE(bench_protocol)]  = bench_protocol_type,
+};
+
+// The option order matches benchmark_direction_t and benchmark_protocol_t, so the index is the value
+const value_list_t console_argument_values[] = {
+  [CONSOLE_TYPE(bench_direction)] = NULL,
+  [CONSOLE_TYPE(bench_protocol)]  = NULL,
+};
+
+const uint8_t console_argument_counts[] = {
+  [CONSOLE_TYPE(bench_direction)] = 3,
+  [CONSOLE_TYPE(bench_protocol)]  = 3,
+};
+
+#ifdef __cplusplus
+} /*extern "C" */
+#endif
@@ -0,0 +1,79 @@
+#include "console.h"
+#include "console_argument_types.h"
+
+extern sl_status_t bench_report_command_handler(console_args_t *arguments);
+static const char *_bench_report_arg_help[] = {};
+
+static const console_descriptive_command_t _bench_report_command = {
+  .description   = "Print the results of the last run",
+  .argument_help = _bench_report_arg_help,
+  .handler       = bench_report_command_handler,
+  .argument_list = { CONSOLE_ARG_END }
+};
+
+extern sl_status_t bench_run_command_handler(console_args_t *arguments);
+static const char *_bench_run_arg_help[] = {
+  0,
+  "duration_ms",
+};
+
+static const console_descriptive_command_t _bench_run_command = {
+  .description   = "Run all streams concurrently and print the results",
+  .argument_help = _bench_run_arg_help,
+  .handler       = bench_run_command_handler,
+  .argument_list = { CONSOLE_OPTIONAL_ARG('t', CONSOLE_ARG_UINT), CONSOLE_ARG_END }
+};
+
+extern sl_status_t help_command_handler(console_args_t *arguments);
+static const char *_help_arg_help[] = {};
+
+static const console_descriptive_command_t _help_command = { .description   = "Print help",
+                                                             .argument_help = _help_arg_help,
+                                                             .handler       = help_command_handler,
+                                                             .argument_list = { CONSOLE_ARG_END } };
+
+extern sl_status_t stream_add_command_handler(console_args_t *arguments);
+static const char *_stream_add_arg_help[] = {
+  0, 0, "peer_ip", "peer_port", 0, "packet_size", 0, "rate_kbps",
+};
+
+static const console_descriptive_command_t _stream_add_command = {
+  .description   = "Add a stream to the next runs",
+  .argument_help = _stream_add_arg_help,
+  .handler       = stream_add_command_handler,
+  .argument_list = { CONSOLE_ENUM_ARG(bench_protocol),
+                     CONSOLE_ENUM_ARG(bench_direction),
+                     CONSOLE_ARG_IP_ADDRESS,
+                     CONSOLE_ARG_UINT,
+                     CONSOLE_OPTIONAL_ARG('s', CONSOLE_ARG_UINT),
+                     CONSOLE_OPTIONAL_ARG('r', CONSOLE_ARG_UINT),
+                     CONSOLE_ARG_END }
+};
+
+extern sl_status_t stream_clear_command_handler(console_args_t *arguments);
+static const char *_stream_clear_arg_help[] = {};
+
+static const console_descriptive_command_t _stream_clear_command = {
+  .description   = "Remove all streams",
+  .argument_help = _stream_clear_arg_help,
+  .handler       = stream_clear_command_handler,
+  .argument_list = { CONSOLE_ARG_END }
+};
+
+extern sl_status_t stream_list_command_handler(console_args_t *arguments);
+static const char *_stream_list_arg_help[] = {};
+
+static const console_descriptive_command_t _stream_list_command = {
+  .description   = "List the configured streams",
+  .argument_help = _stream_list_arg_help,
+  .handler       = stream_list_command_handler,
+  .argument_list = { CONSOLE_ARG_END }
+};
+
+const console_database_t console_command_database = { CONSOLE_SORTED_DATABASE_ENTRIES(
+  { "bench_report", &_bench_report_command },
+  { "bench_run", &_bench_run_command },
+  { "help", &_help_command },
+  { "stream_add", &_stream_add_command },
+  { "stream_clear", &_stream_clear_command },
+  { "stream_list", &_stream_list_command }, ) };
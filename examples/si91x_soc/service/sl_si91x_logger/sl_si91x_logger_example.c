@@ -20,6 +20,7 @@
 #include "sl_si91x_logger_example.h"
 #include "FreeRTOS.h"
 #include "sl_log_helper.h"
+#include "sl_log_backend_si91x.h"
 
 /*******************************************************************************
  ***************************  Defines / Macros  ********************************
@@ -61,6 +62,13 @@ const osThreadAttr_t m4_thread_attributes = {
   .priority   = osPriorityLow2,
 };
 
+// The log drain runs below every other application task so flushing never delays them
+const osThreadAttr_t log_drain_thread_attributes = {
+  .name       = "log drain",
+  .stack_size = 1024,
+  .priority   = osPriorityLow,
+};
+
 // Structure grouping an M4 power state with a TA Wi-Fi performance profile
 typedef struct {
   sl_power_state_t m4_state;
@@ -216,6 +224,20 @@ static void m4_task_start(void *arg)
   }
 }
 
+/*******************************************************************************
+ **************************** Log Drain Task ***********************************
+ ******************************************************************************/
+// Flushes buffered logs to the UART, waiting longer between flushes while little is being logged
+static void log_drain_task_start(void *arg)
+{
+  (void)arg;
+
+  for (;;) {
+    uint32_t interval = sl_log_backend_si91x_drain();
+    osDelay((interval > 0) ? interval : 1);
+  }
+}
+
 /*******************************************************************************
  **************************** App (Orchestrator) *******************************
  ******************************************************************************/
@@ -264,6 +286,12 @@ static void application_start(void *argument)
   }
   SL_PRINT_STRING_INFO("m4_task_start thread created");
 
+  if (osThreadNew(log_drain_task_start, NULL, &log_drain_thread_attributes) == NULL) {
+    SL_PRINT_STRING_ERROR("log_drain_task_start thread creation failed");
+    while (1)
+      ;
+  }
+
   // Iterate through all M4/TA combinations in a loop
   uint32_t combination_index = 0;
   for (;;) {
@@ -285,11 +313,10 @@ static void application_start(void *argument)
     // Log timestamp counters from both cores
     SL_PRINT_STRING_INFO("M4_TS=%lu TA_TS=%lu", sl_log_get_timestamp_count(1), sl_log_get_timestamp_count(0));
 
-    // Move to next combination, flush logs when finishing full cycle
+    // Move to next combination; the log drain task flushes the logs to the uart
     combination_index++;
     if (combination_index == MAX_COMBINATIONS) {
       combination_index = 0;
-      sl_log_flush(); // Flush the logs to the uart
     }
   }
 }
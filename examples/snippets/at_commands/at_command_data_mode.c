@@ -43,16 +43,30 @@ typedef struct {
   uint32_t max_data;
   at_data_mode_handler_t handler;
   void *user_data;
+  // Streaming mode: buffer holds one chunk of max_data bytes out of total_length
+  at_data_mode_chunk_handler_t chunk_handler;
+  uint32_t total_length;
+  uint32_t received;
+  sl_status_t chunk_status;
 } at_command_data_mode_t;
 
 static at_command_data_mode_t data_mode = {
-  .enable     = false,
-  .buffer     = NULL,
-  .buff_index = 0,
-  .max_data   = 0,
-  .handler    = NULL,
+  .enable        = false,
+  .buffer        = NULL,
+  .buff_index    = 0,
+  .max_data      = 0,
+  .handler       = NULL,
+  .chunk_handler = NULL,
+  .total_length  = 0,
+  .received      = 0,
+  .chunk_status  = SL_STATUS_OK,
 };
 
+// Selected by the host with at+data-mode-chunk, 0 keeps every payload in one piece
+static uint32_t data_mode_chunk_size = 0;
+
+static bool at_command_streaming_data_mode_process(void);
+
 bool at_command_data_mode_is_enable()
 {
   return data_mode.enable;
@@ -63,6 +77,10 @@ bool at_command_data_mode_process()
   if (!data_mode.enable || !data_mode.buffer)
     return false;
 
+  if (data_mode.chunk_handler != NULL) {
+    return at_command_streaming_data_mode_process();
+  }
+
   uint32_t data_length = console_read_data_from_cache((char *)(data_mode.buffer + data_mode.buff_index),
                                                       data_mode.max_data - data_mode.buff_index);
 
@@ -77,22 +95,71 @@ bool at_command_data_mode_process()
       AT_PRINTF("\r\n> \r\n");
     }
 
-    data_mode.enable     = false;
-    data_mode.buff_index = 0;
-    data_mode.max_data   = 0;
-    data_mode.handler    = NULL;
-    SL_CLEANUP_MALLOC(data_mode.buffer);
+    at_command_exit_data_mode();
   }
 
   return true;
 }
 
+static bool at_command_streaming_data_mode_process(void)
+{
+  uint32_t chunk_length = data_mode.total_length - data_mode.received;
+  if (chunk_length > data_mode.max_data) {
+    chunk_length = data_mode.max_data;
+  }
+
+  // Drain everything the UART has cached so far, forwarding each chunk as soon as it is complete
+  while (true) {
+    uint32_t data_length = console_read_data_from_cache((char *)(data_mode.buffer + data_mode.buff_index),
+                                                        chunk_length - data_mode.buff_index);
+    data_mode.buff_index += data_length;
+
+    if (data_mode.buff_index < chunk_length) {
+      if (data_length == 0) {
+        return true;
+      }
+      continue;
+    }
+
+    bool is_last = (data_mode.received + chunk_length) == data_mode.total_length;
+
+    // After a failure the rest of the payload is still consumed, so it is not parsed as commands
+    if (data_mode.chunk_status == SL_STATUS_OK) {
+      data_mode.chunk_status =
+        data_mode.chunk_handler(data_mode.buffer, chunk_length, data_mode.received, is_last, data_mode.user_data);
+    }
+    data_mode.received += chunk_length;
+    data_mode.buff_index = 0;
+
+    if (is_last) {
+      if (data_mode.chunk_status != SL_STATUS_OK) {
+        AT_PRINTF("ERROR %" PRIi32 "", (int32_t)data_mode.chunk_status);
+      }
+      AT_PRINTF("\r\n> \r\n");
+      at_command_exit_data_mode();
+      return true;
+    }
+
+    // The host opted into chunked transfers and sends the next chunk only once it sees this prompt
+    AT_PRINTF("\r\n> %" PRIu32 "\r\n", data_mode.received);
+
+    chunk_length = data_mode.total_length - data_mode.received;
+    if (chunk_length > data_mode.max_data) {
+      chunk_length = data_mode.max_data;
+    }
+  }
+}
+
 void at_command_exit_data_mode()
 {
-  data_mode.enable     = false;
-  data_mode.buff_index = 0;
-  data_mode.max_data   = 0;
-  data_mode.handler    = NULL;
+  data_mode.enable        = false;
+  data_mode.buff_index    = 0;
+  data_mode.max_data      = 0;
+  data_mode.handler       = NULL;
+  data_mode.chunk_handler = NULL;
+  data_mode.total_length  = 0;
+  data_mode.received      = 0;
+  data_mode.chunk_status  = SL_STATUS_OK;
   SL_CLEANUP_MALLOC(data_mode.buffer);
 }
 
@@ -108,5 +175,51 @@ sl_status_t at_command_goto_data_mode(at_data_mode_handler_t handler, uint32_t m
   data_mode.handler    = handler;
   data_mode.user_data  = user_data;
 
+  data_mode.chunk_handler = NULL;
+
   return SL_STATUS_OK;
-}
\ No newline at end of file
+}
+
+sl_status_t at_command_goto_streaming_data_mode(at_data_mode_chunk_handler_t handler,
+                                                uint32_t total_length,
+                                                void *user_data)
+{
+  if ((handler == NULL) || (total_length == 0)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  // The UART cache is far smaller than a payload, so only a host that waits for each chunk prompt gets chunks
+  uint32_t chunk_size = total_length;
+  if ((data_mode_chunk_size != 0) && (data_mode_chunk_size < total_length)) {
+    chunk_size = data_mode_chunk_size;
+  }
+
+  data_mode.buffer = (uint8_t *)calloc(chunk_size, sizeof(uint8_t));
+  if (!data_mode.buffer) {
+    return SL_STATUS_ALLOCATION_FAILED;
+  }
+  data_mode.enable        = true;
+  data_mode.buff_index    = 0;
+  data_mode.max_data      = chunk_size;
+  data_mode.handler       = NULL;
+  data_mode.chunk_handler = handler;
+  data_mode.total_length  = total_length;
+  data_mode.received      = 0;
+  data_mode.chunk_status  = SL_STATUS_OK;
+  data_mode.user_data     = user_data;
+
+  return SL_STATUS_OK;
+}
+
+// at+data-mode-chunk=<chunk-size>
+sl_status_t data_mode_chunk_command_handler(console_args_t *arguments)
+{
+  uint32_t chunk_size = GET_OPTIONAL_COMMAND_ARG(arguments, 0, 0, uint32_t);
+  if (chunk_size > AT_DATA_MODE_CHUNK_SIZE) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  data_mode_chunk_size = chunk_size;
+  PRINT_AT_CMD_SUCCESS;
+  return SL_STATUS_OK;
+}
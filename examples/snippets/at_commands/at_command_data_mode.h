@@ -38,8 +38,20 @@
 extern "C" {
 #endif
 
+// Largest chunk size a host can select with at+data-mode-chunk, also the most RAM used by a chunked transfer
+#ifndef AT_DATA_MODE_CHUNK_SIZE
+#define AT_DATA_MODE_CHUNK_SIZE 1024
+#endif
+
 typedef sl_status_t (*at_data_mode_handler_t)(uint8_t *buffer, uint32_t length, void *user_data);
 
+// Called for every chunk of a streaming transfer, offset is the position of the chunk in the whole payload
+typedef sl_status_t (*at_data_mode_chunk_handler_t)(uint8_t *chunk,
+                                                    uint32_t length,
+                                                    uint32_t offset,
+                                                    bool is_last,
+                                                    void *user_data);
+
 bool at_command_data_mode_is_enable(void);
 
 bool at_command_data_mode_process(void);
@@ -48,6 +60,12 @@ void at_command_exit_data_mode(void);
 
 sl_status_t at_command_goto_data_mode(at_data_mode_handler_t handler, uint32_t max_data, void *user_data);
 
+// Hands the payload over in chunks once the host enabled chunked transfers with at+data-mode-chunk,
+// otherwise in one piece once all of it has arrived
+sl_status_t at_command_goto_streaming_data_mode(at_data_mode_chunk_handler_t handler,
+                                                uint32_t total_length,
+                                                void *user_data);
+
 #ifdef __cplusplus
 } /*extern "C" */
 #endif
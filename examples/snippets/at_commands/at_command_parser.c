@@ -72,7 +72,7 @@ static sl_status_t console_find_at_command(char **string,
 
 static bool escape(char *i, const char *end);
 
-static inline uint8_t at_command_parse_enum_arg(const char *line, const char *const *options);
+static inline uint8_t at_command_parse_enum_arg(const char *line, uint8_t enum_index);
 
 static sl_status_t at_command_strtoul(unsigned long *out_val, const char *str, int base);
 
@@ -84,6 +84,7 @@ static sl_status_t at_command_parse_arg(console_argument_type_t type, char *line
 
 extern const arg_list_t console_argument_types[];
 extern const value_list_t console_argument_values[];
+extern const uint8_t console_argument_counts[];
 
 /******************************************************
  *               Function Definitions
@@ -94,7 +95,7 @@ sl_status_t console_parse_at_command(char *command_line,
                                      console_args_t *args,
                                      const console_descriptive_command_t **output_command);
 
-// Simple linear database search. This function could be replaced with a more complicated version
+// Database search. Sorted databases use a binary search, otherwise fall back to a linear scan
 sl_status_t console_find_at_command(char **string,
                                     const char *string_end,
                                     const console_database_t *db,
@@ -122,15 +123,23 @@ sl_status_t console_find_at_command(char **string,
 
     size_t token_length = strlen(token);
 
-    for (uint32_t i = 0; i < db->length; i++) {
-      if (strncasecmp(token, db->entries[i].key, token_length) == 0 && db->entries[i].key[token_length] == 0) {
+    if (db->flags & CONSOLE_DATABASE_SORTED) {
+      uint32_t i = console_database_lower_bound(db, token);
+      if ((i < db->length) && (strcasecmp(token, db->entries[i].key) == 0)) {
         *entry          = &(db->entries[i]);
         *starting_index = i;
-
-        if (strlen(db->entries[i].key) == token_length) {
-          break;
-        } else {
-          return SL_STATUS_COMMAND_INCOMPLETE;
+      }
+    } else {
+      for (uint32_t i = 0; i < db->length; i++) {
+        if (strncasecmp(token, db->entries[i].key, token_length) == 0 && db->entries[i].key[token_length] == 0) {
+          *entry          = &(db->entries[i]);
+          *starting_index = i;
+
+          if (strlen(db->entries[i].key) == token_length) {
+            break;
+          } else {
+            return SL_STATUS_COMMAND_INCOMPLETE;
+          }
         }
       }
     }
@@ -267,14 +276,10 @@ static sl_status_t at_command_tokenize(char *start,
   return SL_STATUS_OK;
 }
 
-static inline uint8_t at_command_parse_enum_arg(const char *line, const char *const *options)
+// Generated option lists are sorted in strcmp() order and their lengths are emitted alongside them
+static inline uint8_t at_command_parse_enum_arg(const char *line, uint8_t enum_index)
 {
-  for (uint8_t a = 0; options[a] != NULL; ++a) {
-    if (strcmp(line, options[a]) == 0) {
-      return a;
-    }
-  }
-  return 0xFF;
+  return console_find_enum_option(line, console_argument_types[enum_index], console_argument_counts[enum_index]);
 }
 
 static sl_status_t at_command_strtoul(unsigned long *out_val, const char *str, int base)
@@ -308,7 +313,7 @@ static sl_status_t at_command_parse_arg(console_argument_type_t type, char *line
 
   if (type & CONSOLE_ARG_ENUM) {
     uint8_t enum_index  = type & CONSOLE_ARG_ENUM_INDEX_MASK;
-    uint8_t value_index = at_command_parse_enum_arg(line, console_argument_types[enum_index]);
+    uint8_t value_index = at_command_parse_enum_arg(line, enum_index);
     if (value_index == 0xFF) {
       return SL_STATUS_COMMAND_IS_INVALID;
     }
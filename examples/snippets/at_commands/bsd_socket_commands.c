@@ -470,6 +470,31 @@ static sl_status_t bsd_socket_send_buffer_handler(uint8_t *buffer, uint32_t leng
   return SL_STATUS_OK;
 }
 
+static sl_status_t bsd_socket_send_chunk_handler(uint8_t *chunk,
+                                                 uint32_t length,
+                                                 uint32_t offset,
+                                                 bool is_last,
+                                                 void *user_data)
+{
+  UNUSED_PARAMETER(offset);
+
+  server_info_t *info = (server_info_t *)user_data;
+  if (info == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  sl_status_t status = bsd_socket_sendto(info, chunk, (size_t)length);
+  if (is_last || (status != SL_STATUS_OK)) {
+    SL_CLEANUP_MALLOC(info->address);
+  }
+  VERIFY_STATUS_AND_RETURN(status);
+
+  if (is_last) {
+    PRINT_AT_CMD_SUCCESS;
+  }
+  return SL_STATUS_OK;
+}
+
 // Old: at+send=<socket-id>,<remote-ip-address>,<remote-port>,<data-length>,<data>
 // New: at+send=<socket-id>,<remote-ip-address>,<remote-port>,<data-length>
 sl_status_t bsd_socket_send_to_handler(console_args_t *arguments)
@@ -494,7 +519,15 @@ sl_status_t bsd_socket_send_to_handler(console_args_t *arguments)
   if (buffer == NULL) { // Data Mode
     status = setup_server_info(&sv_info, sock_fd, address, port);
     VERIFY_STATUS_AND_RETURN(status);
-    status = at_command_goto_data_mode(bsd_socket_send_buffer_handler, data_len, &sv_info);
+
+    int sock_type           = 0;
+    socklen_t option_length = sizeof(sock_type);
+    if ((getsockopt(sock_fd, SOL_SOCKET, SO_TYPE, &sock_type, &option_length) == 0) && (sock_type == SOCK_STREAM)) {
+      // A stream has no message boundaries, so the payload is sent chunk by chunk as it arrives over UART
+      status = at_command_goto_streaming_data_mode(bsd_socket_send_chunk_handler, (uint32_t)data_len, &sv_info);
+    } else {
+      status = at_command_goto_data_mode(bsd_socket_send_buffer_handler, data_len, &sv_info);
+    }
   } else { // Old version
     server_info_t info = { 0 };
     status             = setup_server_info(&info, sock_fd, address, port);
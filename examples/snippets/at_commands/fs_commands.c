@@ -122,10 +122,14 @@ void fs_init(void)
 }
 
 #ifndef LFS_READONLY
-static sl_status_t fs_fwrite_send_buffer_handler(uint8_t *buffer, uint32_t length, void *user_data)
+static sl_status_t fs_fwrite_send_chunk_handler(uint8_t *chunk,
+                                                uint32_t length,
+                                                uint32_t offset,
+                                                bool is_last,
+                                                void *user_data)
 {
   lfs_file_t *file = (lfs_file_t *)user_data;
-  if ((file == NULL) || (buffer == NULL)) {
+  if ((file == NULL) || (chunk == NULL)) {
     return SL_STATUS_NULL_POINTER;
   }
 
@@ -133,11 +137,13 @@ static sl_status_t fs_fwrite_send_buffer_handler(uint8_t *buffer, uint32_t lengt
     return SL_STATUS_INVALID_RANGE;
   }
 
-  lfs_ssize_t bytes_written = lfs_file_write(&lfs, file, buffer, length);
+  lfs_ssize_t bytes_written = lfs_file_write(&lfs, file, chunk, length);
   VERIFY_ERR_AND_RETURN(bytes_written);
 
-  PRINT_AT_CMD_SUCCESS;
-  AT_PRINTF("%" PRIi32 "\r\n", bytes_written);
+  if (is_last) {
+    PRINT_AT_CMD_SUCCESS;
+    AT_PRINTF("%" PRIi32 "\r\n", (int32_t)(offset + (uint32_t)bytes_written));
+  }
   return SL_STATUS_OK;
 }
 #endif
@@ -409,7 +415,7 @@ sl_status_t fs_fwrite_command_handler(console_args_t *arguments)
     return SL_STATUS_OBJECT_WRITE;
   }
 
-  sl_status_t status = at_command_goto_data_mode(fs_fwrite_send_buffer_handler, size, files[file_id]);
+  sl_status_t status = at_command_goto_streaming_data_mode(fs_fwrite_send_chunk_handler, size, files[file_id]);
   VERIFY_STATUS_AND_RETURN(status);
 
   PRINT_AT_CMD_SUCCESS;
@@ -211,8 +211,14 @@ static sl_status_t http_client_req_body_send_buffer_handler(uint8_t *buffer, uin
   return SL_STATUS_OK;
 }
 
-static sl_status_t http_client_send_chunk_send_buffer_handler(uint8_t *buffer, uint32_t length, void *user_data)
+static sl_status_t http_client_send_chunk_send_buffer_handler(uint8_t *buffer,
+                                                             uint32_t length,
+                                                             uint32_t data_offset,
+                                                             bool is_last,
+                                                             void *user_data)
 {
+  UNUSED_PARAMETER(data_offset);
+
   http_client_request_t *request = (http_client_request_t *)user_data;
   if (request == NULL) {
     return SL_STATUS_NULL_POINTER;
@@ -241,7 +247,9 @@ static sl_status_t http_client_send_chunk_send_buffer_handler(uint8_t *buffer, u
     osDelay(20);
   }
 
-  PRINT_AT_CMD_SUCCESS;
+  if (is_last) {
+    PRINT_AT_CMD_SUCCESS;
+  }
   return SL_STATUS_OK;
 }
 
@@ -713,7 +721,8 @@ sl_status_t http_client_send_chunk_command_handler(console_args_t *arguments)
 
   http_request.flush_now = flush_now;
 
-  status = at_command_goto_data_mode(http_client_send_chunk_send_buffer_handler, chunk_size, (void *)&http_request);
+  status =
+    at_command_goto_streaming_data_mode(http_client_send_chunk_send_buffer_handler, chunk_size, (void *)&http_request);
   VERIFY_STATUS_AND_RETURN(status);
 
   PRINT_AT_CMD_SUCCESS;
@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "fff.h"
+
+extern "C" {
+#include "at_command_data_mode_fake_functions.h"
+sl_status_t data_mode_chunk_command_handler(console_args_t *arguments);
+}
+
+// Bytes sent by the host that are still in the UART cache
+static std::string uart_cache;
+
+static uint32_t read_data_from_cache(char *buffer, uint32_t buffer_size)
+{
+  uint32_t length = std::min<uint32_t>(buffer_size, (uint32_t)uart_cache.size());
+  memcpy(buffer, uart_cache.data(), length);
+  uart_cache.erase(0, length);
+  return length;
+}
+
+typedef struct {
+  std::string data;
+  uint32_t offset;
+  bool is_last;
+} received_chunk_t;
+
+// Chunks handed to the command, and the status the command returns for them
+static std::vector<received_chunk_t> chunks;
+static sl_status_t chunk_status;
+
+static sl_status_t record_chunk(uint8_t *chunk, uint32_t length, uint32_t offset, bool is_last, void *user_data)
+{
+  (void)user_data;
+  chunks.push_back({ std::string((const char *)chunk, length), offset, is_last });
+  return chunk_status;
+}
+
+class at_command_data_mode_test : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    FFF_RESET_HISTORY();
+    RESET_FAKE(console_read_data_from_cache);
+    console_read_data_from_cache_fake.custom_fake = read_data_from_cache;
+
+    uart_cache.clear();
+    chunks.clear();
+    chunk_status = SL_STATUS_OK;
+    select_chunk_size(0);
+  }
+
+  void TearDown() override
+  {
+    at_command_exit_data_mode();
+    select_chunk_size(0);
+  }
+
+  // Runs at+data-mode-chunk=<chunk-size>
+  static sl_status_t select_chunk_size(uint32_t chunk_size)
+  {
+    console_args_t arguments = {};
+    arguments.bitmap         = 1;
+    arguments.arg[0]         = chunk_size;
+    testing::internal::CaptureStdout();
+    sl_status_t status = data_mode_chunk_command_handler(&arguments);
+    testing::internal::GetCapturedStdout();
+    return status;
+  }
+
+  // Lets data mode consume what the host sent, returns what the device printed
+  static std::string process(const std::string &data)
+  {
+    uart_cache += data;
+    testing::internal::CaptureStdout();
+    at_command_data_mode_process();
+    return testing::internal::GetCapturedStdout();
+  }
+};
+
+// Test case: Without at+data-mode-chunk the payload reaches the command in one piece and no chunk prompt is printed
+TEST_F(at_command_data_mode_test, DefaultKeepsPayloadInOnePiece)
+{
+  std::string payload(1200, 'a');
+  ASSERT_EQ(SL_STATUS_OK, at_command_goto_streaming_data_mode(record_chunk, (uint32_t)payload.size(), NULL));
+
+  EXPECT_EQ("", process(payload.substr(0, 700)));
+  EXPECT_TRUE(chunks.empty());
+  EXPECT_TRUE(at_command_data_mode_is_enable());
+
+  EXPECT_EQ("\r\n> \r\n", process(payload.substr(700)));
+  ASSERT_EQ(1u, chunks.size());
+  EXPECT_EQ(payload, chunks[0].data);
+  EXPECT_EQ(0u, chunks[0].offset);
+  EXPECT_TRUE(chunks[0].is_last);
+  EXPECT_FALSE(at_command_data_mode_is_enable());
+}
+
+// Test case: Once the host opted in, every chunk but the last is acknowledged with the number of bytes received
+TEST_F(at_command_data_mode_test, ChunkedTransferPromptsAfterEachChunk)
+{
+  std::string payload;
+  for (int i = 0; i < 1200; i++) {
+    payload += (char)('a' + (i % 26));
+  }
+  ASSERT_EQ(SL_STATUS_OK, select_chunk_size(512));
+  ASSERT_EQ(SL_STATUS_OK, at_command_goto_streaming_data_mode(record_chunk, (uint32_t)payload.size(), NULL));
+
+  EXPECT_EQ("\r\n> 512\r\n", process(payload.substr(0, 512)));
+  EXPECT_EQ("\r\n> 1024\r\n", process(payload.substr(512, 512)));
+  EXPECT_EQ("\r\n> \r\n", process(payload.substr(1024)));
+
+  ASSERT_EQ(3u, chunks.size());
+  EXPECT_EQ(payload.substr(0, 512), chunks[0].data);
+  EXPECT_EQ(payload.substr(512, 512), chunks[1].data);
+  EXPECT_EQ(payload.substr(1024), chunks[2].data);
+  EXPECT_EQ(1024u, chunks[2].offset);
+  EXPECT_FALSE(chunks[1].is_last);
+  EXPECT_TRUE(chunks[2].is_last);
+}
+
+// Test case: A chunk size above AT_DATA_MODE_CHUNK_SIZE is refused, and 0 restores payloads in one piece
+TEST_F(at_command_data_mode_test, ChunkSizeIsValidated)
+{
+  EXPECT_EQ(SL_STATUS_INVALID_PARAMETER, select_chunk_size(AT_DATA_MODE_CHUNK_SIZE + 1));
+  EXPECT_EQ(SL_STATUS_OK, select_chunk_size(AT_DATA_MODE_CHUNK_SIZE));
+  EXPECT_EQ(SL_STATUS_OK, select_chunk_size(0));
+
+  ASSERT_EQ(SL_STATUS_OK, at_command_goto_streaming_data_mode(record_chunk, AT_DATA_MODE_CHUNK_SIZE + 10, NULL));
+  process(std::string(AT_DATA_MODE_CHUNK_SIZE + 10, 'b'));
+  ASSERT_EQ(1u, chunks.size());
+  EXPECT_EQ((size_t)AT_DATA_MODE_CHUNK_SIZE + 10, chunks[0].data.size());
+}
+
+// Test case: After a failed chunk the rest of the payload is consumed, and the commands sent after it are left alone
+TEST_F(at_command_data_mode_test, FailedChunkConsumesRestOfPayload)
+{
+  chunk_status = SL_STATUS_FAIL;
+  ASSERT_EQ(SL_STATUS_OK, select_chunk_size(4));
+  ASSERT_EQ(SL_STATUS_OK, at_command_goto_streaming_data_mode(record_chunk, 10, NULL));
+
+  std::string output = process("0123456789at+ready?");
+
+  EXPECT_EQ(1u, chunks.size());
+  EXPECT_NE(std::string::npos, output.find("ERROR"));
+  EXPECT_EQ("at+ready?", uart_cache);
+  EXPECT_FALSE(at_command_data_mode_is_enable());
+}
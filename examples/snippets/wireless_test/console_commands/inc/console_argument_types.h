@@ -117,6 +117,7 @@ extern const char *wps_mode_type[];
 
 extern const arg_list_t console_argument_types[];
 extern const value_list_t console_argument_values[];
+extern const uint8_t console_argument_counts[];
 
 #ifdef __cplusplus
 } /*extern "C" */
@@ -42,11 +42,11 @@ const char *net_interface_type[]        = { "ap", "bluetooth", "client", "ethern
 const char *operating_band_type[]       = { "2.4g", "5g", "dual", NULL };
 const char *option_name_type[]          = { "SL_SO_CERT_INDEX", "SO_KEEPALIVE", "SO_MAX_RETRANSMISSION_TIMEOUT_VALUE",
                                             "SO_RCVTIMEO",      "TCP_ULP",      NULL };
-const char *performance_mode_type[]     = { "high_performance",
+const char *performance_mode_type[]     = { "deep_sleep_with_ram_retention",
+                                            "deep_sleep_without_ram_retention",
+                                            "high_performance",
                                             "power_save",
                                             "power_save_low_latency",
-                                            "deep_sleep_without_ram_retention",
-                                            "deep_sleep_with_ram_retention",
                                             NULL };
 const char *rate_protocol_type[]        = { "802.11ax", "802.11b", "802.11g", "802.11n", "auto", NULL };
 const char *set_option_id_type[]        = { "fionbio", "keepalivetimeout", "recvtimeout", "sendtimeout", NULL };
@@ -60,10 +60,10 @@ const char *wifi_ap_flag_type[]     = { "hidden_ssid", NULL };
 const char *wifi_band_type[]        = { "2.4g", "5g", "60g", "6g", "900m", "auto", NULL };
 const char *wifi_bandwidth_type[]   = { "10m", "160m", "20m", "40m", "80m", NULL };
 const char *wifi_encryption_type[]  = { "ccmp", "fast", "open", "peap", "tkip", "tls", "ttls", "wep", NULL };
-const char *wifi_init_mode_type[]   = { "ap",  "apsta",         "ble_coex", "client", "client_ipv6",
-                                        "eap", "transmit_test", "ble",      NULL };
-const char *wifi_init_region_type[] = { "default", "us", "eu", "jp", "world", "kr", "sg", "cn", NULL };
-const char *ble_user_gain_table_region_type[] = { "FCC", "ETSI", "TELEC", "WORLD_WIDE", "KCC", NULL };
+const char *wifi_init_mode_type[]   = { "ap",          "apsta", "ble",           "ble_coex", "client",
+                                        "client_ipv6", "eap",   "transmit_test", NULL };
+const char *wifi_init_region_type[] = { "cn", "default", "eu", "jp", "kr", "sg", "us", "world", NULL };
+const char *ble_user_gain_table_region_type[] = { "ETSI", "FCC", "KCC", "TELEC", "WORLD_WIDE", NULL };
 const char *wifi_interface_type[]             = { "ap", "ap_5g", "client", "client_5g", NULL };
 const char *wifi_pll_mode_type[]              = { "pll_mode_20mhz", "pll_mode_40mhz", NULL };
 const char *wifi_power_chain_type[]           = { "hp_chain", "lp_chain", NULL };
@@ -73,11 +73,11 @@ const char *wifi_security_type[]              = { "open",
                                                   "wpa2",
                                                   "wpa2_enterprise",
                                                   "wpa3",
+                                                  "wpa3_enterprise",
                                                   "wpa3_transition",
+                                                  "wpa3_transition_enterprise",
                                                   "wpa_enterprise",
                                                   "wpa_wpa2_mixed",
-                                                  "wpa3_enterprise",
-                                                  "wpa3_transition_enterprise",
                                                   NULL };
 const char *wps_mode_type[]                   = { "pin", "push_button", NULL };
 
@@ -149,11 +149,11 @@ const value_list_t console_argument_values[] = {
                                                          SL_NET_ZWAVE_INTERFACE },
   [CONSOLE_TYPE(operating_band)]   = (const uint32_t[]){ 0, 1, 2 },
   [CONSOLE_TYPE(option_name)]      = (const uint32_t[]){ 4134, 8, 12306, 4102, 31 },
-  [CONSOLE_TYPE(performance_mode)] = (const uint32_t[]){ HIGH_PERFORMANCE,
-                                                         ASSOCIATED_POWER_SAVE,
-                                                         ASSOCIATED_POWER_SAVE_LOW_LATENCY,
+  [CONSOLE_TYPE(performance_mode)] = (const uint32_t[]){ DEEP_SLEEP_WITH_RAM_RETENTION,
                                                          DEEP_SLEEP_WITHOUT_RAM_RETENTION,
-                                                         DEEP_SLEEP_WITH_RAM_RETENTION },
+                                                         HIGH_PERFORMANCE,
+                                                         ASSOCIATED_POWER_SAVE,
+                                                         ASSOCIATED_POWER_SAVE_LOW_LATENCY },
   [CONSOLE_TYPE(rate_protocol)]    = (const uint32_t[]){ SL_WIFI_RATE_PROTOCOL_AX_ONLY,
                                                          SL_WIFI_RATE_PROTOCOL_B_ONLY,
                                                          SL_WIFI_RATE_PROTOCOL_G_ONLY,
@@ -188,9 +188,9 @@ const value_list_t console_argument_values[] = {
                                                          SL_WIFI_EAP_TLS_ENCRYPTION,
                                                          SL_WIFI_EAP_TTLS_ENCRYPTION,
                                                          SL_WIFI_WEP_ENCRYPTION },
-  [CONSOLE_TYPE(wifi_init_mode)]   = (const uint32_t[]){ 1, 2, 4, 0, 5, 3, 6, 7 },
-  [CONSOLE_TYPE(wifi_init_region)] = (const uint32_t[]){ DEFAULT_REGION, US, EU, JP, WORLD_DOMAIN, KR, SG, CN },
-  [CONSOLE_TYPE(ble_user_gain_table_region)] = (const uint32_t[]){ FCC, ETSI, TELEC, WORLD_WIDE, KCC },
+  [CONSOLE_TYPE(wifi_init_mode)]   = (const uint32_t[]){ 1, 2, 7, 4, 0, 5, 3, 6 },
+  [CONSOLE_TYPE(wifi_init_region)] = (const uint32_t[]){ CN, DEFAULT_REGION, EU, JP, KR, SG, US, WORLD_DOMAIN },
+  [CONSOLE_TYPE(ble_user_gain_table_region)] = (const uint32_t[]){ ETSI, FCC, KCC, TELEC, WORLD_WIDE },
   [CONSOLE_TYPE(wifi_interface)]             = (const uint32_t[]){ SL_WIFI_AP_2_4GHZ_INTERFACE,
                                                                    SL_WIFI_AP_5GHZ_INTERFACE,
                                                                    SL_WIFI_CLIENT_2_4GHZ_INTERFACE,
@@ -203,14 +203,54 @@ const value_list_t console_argument_values[] = {
                                                                    SL_WIFI_WPA2,
                                                                    SL_WIFI_WPA2_ENTERPRISE,
                                                                    SL_WIFI_WPA3,
+                                                                   SL_WIFI_WPA3_ENTERPRISE,
                                                                    SL_WIFI_WPA3_TRANSITION,
+                                                                   SL_WIFI_WPA3_TRANSITION_ENTERPRISE,
                                                                    SL_WIFI_WPA_ENTERPRISE,
-                                                                   SL_WIFI_WPA_WPA2_MIXED,
-                                                                   SL_WIFI_WPA3_ENTERPRISE,
-                                                                   SL_WIFI_WPA3_TRANSITION_ENTERPRISE },
+                                                                   SL_WIFI_WPA_WPA2_MIXED },
   [CONSOLE_TYPE(wps_mode)]                   = (const uint32_t[]){ SL_WIFI_WPS_PIN_MODE, SL_WIFI_WPS_PUSH_BUTTON_MODE },
 };
 
+// Option lists above are in strcmp() order, as console_find_enum_option() expects
+const uint8_t console_argument_counts[] = {
+  [CONSOLE_TYPE(ap_client_deauth)]                = 2,
+  [CONSOLE_TYPE(boolean)]                         = 1,
+  [CONSOLE_TYPE(bsd_socket_family)]               = 2,
+  [CONSOLE_TYPE(bsd_socket_protocol)]             = 2,
+  [CONSOLE_TYPE(bsd_socket_type)]                 = 2,
+  [CONSOLE_TYPE(continuous_flag)]                 = 2,
+  [CONSOLE_TYPE(data_rate)]                       = 29,
+  [CONSOLE_TYPE(enable_bg_scan)]                  = 1,
+  [CONSOLE_TYPE(flags)]                           = 2,
+  [CONSOLE_TYPE(get_option_id)]                   = 4,
+  [CONSOLE_TYPE(ip_protocol)]                     = 2,
+  [CONSOLE_TYPE(ipv4_or_ipv6)]                    = 2,
+  [CONSOLE_TYPE(net_interface)]                   = 6,
+  [CONSOLE_TYPE(operating_band)]                  = 3,
+  [CONSOLE_TYPE(option_name)]                     = 5,
+  [CONSOLE_TYPE(performance_mode)]                = 5,
+  [CONSOLE_TYPE(rate_protocol)]                   = 5,
+  [CONSOLE_TYPE(set_option_id)]                   = 4,
+  [CONSOLE_TYPE(sl_ip_address_type_t)]            = 5,
+  [CONSOLE_TYPE(sl_ip_management_t)]              = 2,
+  [CONSOLE_TYPE(sl_net_dns_resolution_ip_type_t)] = 2,
+  [CONSOLE_TYPE(socket_domain)]                   = 2,
+  [CONSOLE_TYPE(socket_protocol)]                 = 6,
+  [CONSOLE_TYPE(socket_type)]                     = 2,
+  [CONSOLE_TYPE(wifi_ap_flag)]                    = 1,
+  [CONSOLE_TYPE(wifi_band)]                       = 6,
+  [CONSOLE_TYPE(wifi_bandwidth)]                  = 5,
+  [CONSOLE_TYPE(wifi_encryption)]                 = 8,
+  [CONSOLE_TYPE(wifi_init_mode)]                  = 8,
+  [CONSOLE_TYPE(wifi_init_region)]                = 8,
+  [CONSOLE_TYPE(ble_user_gain_table_region)]      = 5,
+  [CONSOLE_TYPE(wifi_interface)]                  = 4,
+  [CONSOLE_TYPE(wifi_pll_mode)]                   = 2,
+  [CONSOLE_TYPE(wifi_power_chain)]                = 2,
+  [CONSOLE_TYPE(wifi_security)]                   = 11,
+  [CONSOLE_TYPE(wps_mode)]                        = 2,
+};
+
 #ifdef __cplusplus
 } /*extern "C" */
 #endif
\ No newline at end of file
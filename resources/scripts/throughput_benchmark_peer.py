@@ -0,0 +1,235 @@
+"""Host peer of the wlan_throughput_benchmark example.
+
+Every stream of the device starts with a 12 byte handshake:
+
+    magic "SLBM" | version (1) | direction | packet size (u16 LE) | duration ms (u32 LE)
+
+The direction is seen from the device: 0 echo, 1 rx (this peer sends), 2 tx (this peer receives).
+TCP and TLS streams send the handshake first on their connection, UDP streams send it as a datagram.
+
+Run from the resources/certificates directory so the default TLS certificate and key are found:
+
+    python throughput_benchmark_peer.py [--tcp-port 5000] [--udp-port 5000] [--tls-port 443]
+"""
+
+import argparse
+import socket
+import ssl
+import struct
+import threading
+import time
+
+HANDSHAKE = struct.Struct("<4sBBHI")
+MAGIC = b"SLBM"
+VERSION = 1
+
+DIRECTION_ECHO = 0
+DIRECTION_RX = 1
+DIRECTION_TX = 2
+DIRECTION_NAMES = {DIRECTION_ECHO: "echo", DIRECTION_RX: "device rx", DIRECTION_TX: "device tx"}
+
+# Extra time a receiving or echoing peer waits for the device after the announced duration
+DRAIN_TIME = 3.0
+
+print_lock = threading.Lock()
+
+
+def log(message):
+    with print_lock:
+        print(message, flush=True)
+
+
+def parse_handshake(data):
+    if len(data) != HANDSHAKE.size:
+        return None
+    magic, version, direction, packet_size, duration_ms = HANDSHAKE.unpack(data)
+    if magic != MAGIC or version != VERSION or direction not in DIRECTION_NAMES:
+        return None
+    return direction, packet_size, duration_ms
+
+
+def report(label, direction, byte_count, packets, elapsed):
+    mbps = (byte_count * 8) / (elapsed * 1e6) if elapsed > 0 else 0.0
+    log("{} {}: {} bytes in {} packets, {:.3f} s, {:.2f} Mbps".format(
+        label, DIRECTION_NAMES[direction], byte_count, packets, elapsed, mbps))
+
+
+def recv_exact(connection, length):
+    data = bytearray()
+    while len(data) < length:
+        chunk = connection.recv(length - len(data))
+        if not chunk:
+            return None
+        data.extend(chunk)
+    return bytes(data)
+
+
+def payload(packet_size):
+    return bytes((ord("a") + (i % 26)) for i in range(packet_size))
+
+
+def serve_stream(connection, label):
+    """Run one TCP or TLS stream until the device closes it or the run is over."""
+    try:
+        handshake = recv_exact(connection, HANDSHAKE.size)
+        parsed = parse_handshake(handshake) if handshake else None
+        if parsed is None:
+            log("{}: invalid handshake".format(label))
+            return
+        direction, packet_size, duration_ms = parsed
+        duration = duration_ms / 1000.0
+        log("{}: {} stream, {} bytes/packet, {} ms".format(label, DIRECTION_NAMES[direction], packet_size, duration_ms))
+
+        byte_count = 0
+        packets = 0
+        start = time.monotonic()
+        connection.settimeout(1.0)
+
+        if direction == DIRECTION_RX:
+            data = payload(packet_size)
+            while time.monotonic() - start < duration:
+                connection.sendall(data)
+                byte_count += len(data)
+                packets += 1
+        else:
+            while time.monotonic() - start < duration + DRAIN_TIME:
+                try:
+                    if direction == DIRECTION_ECHO:
+                        data = recv_exact(connection, packet_size)
+                    else:
+                        data = connection.recv(65536)
+                except socket.timeout:
+                    continue
+                if not data:
+                    break
+                if direction == DIRECTION_ECHO:
+                    connection.sendall(data)
+                byte_count += len(data)
+                packets += 1
+        report(label, direction, byte_count, packets, time.monotonic() - start)
+    except (OSError, ssl.SSLError) as error:
+        log("{}: {}".format(label, error))
+    finally:
+        connection.close()
+
+
+def stream_server(port, tls_context, name):
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(("0.0.0.0", port))
+    server.listen(8)
+    log("{} server listening on port {}".format(name, port))
+    while True:
+        connection, address = server.accept()
+        label = "{} {}:{}".format(name, address[0], address[1])
+        if tls_context is not None:
+            try:
+                connection = tls_context.wrap_socket(connection, server_side=True)
+            except (OSError, ssl.SSLError) as error:
+                log("{}: TLS handshake failed: {}".format(label, error))
+                connection.close()
+                continue
+        threading.Thread(target=serve_stream, args=(connection, label), daemon=True).start()
+
+
+class UdpSession:
+    def __init__(self, address, direction, packet_size, duration_ms):
+        self.address = address
+        self.direction = direction
+        self.packet_size = packet_size
+        self.duration = duration_ms / 1000.0
+        self.start = time.monotonic()
+        self.byte_count = 0
+        self.packets = 0
+        self.label = "UDP {}:{}".format(address[0], address[1])
+
+    def expired(self):
+        return time.monotonic() - self.start >= self.duration + DRAIN_TIME
+
+
+def udp_source(server, session):
+    data = payload(session.packet_size)
+    while time.monotonic() - session.start < session.duration:
+        try:
+            server.sendto(data, session.address)
+        except OSError:
+            # The device ran out of buffers, give it a moment
+            time.sleep(0.001)
+            continue
+        session.byte_count += len(data)
+        session.packets += 1
+    report(session.label, session.direction, session.byte_count, session.packets, time.monotonic() - session.start)
+
+
+def udp_server(port):
+    server = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(("0.0.0.0", port))
+    server.settimeout(0.5)
+    log("UDP server listening on port {}".format(port))
+    sessions = {}
+
+    while True:
+        for address, session in list(sessions.items()):
+            if session.expired():
+                if session.direction != DIRECTION_RX:
+                    report(session.label, session.direction, session.byte_count, session.packets,
+                           session.duration)
+                del sessions[address]
+        try:
+            data, address = server.recvfrom(65536)
+        except socket.timeout:
+            continue
+
+        parsed = parse_handshake(data)
+        if parsed is not None:
+            # The device repeats the handshake of an RX stream until data arrives
+            if address in sessions and sessions[address].direction == DIRECTION_RX:
+                continue
+            session = UdpSession(address, *parsed)
+            sessions[address] = session
+            log("{}: {} stream, {} bytes/packet, {} ms".format(
+                session.label, DIRECTION_NAMES[session.direction], session.packet_size, parsed[2]))
+            if session.direction == DIRECTION_RX:
+                threading.Thread(target=udp_source, args=(server, session), daemon=True).start()
+            continue
+
+        session = sessions.get(address)
+        if session is None:
+            continue
+        if session.direction == DIRECTION_ECHO:
+            server.sendto(data, address)
+        session.byte_count += len(data)
+        session.packets += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Peer for the wlan_throughput_benchmark example")
+    parser.add_argument("--tcp-port", type=int, default=5000, help="TCP port, 0 disables TCP")
+    parser.add_argument("--udp-port", type=int, default=5000, help="UDP port, 0 disables UDP")
+    parser.add_argument("--tls-port", type=int, default=443, help="TLS port, 0 disables TLS")
+    parser.add_argument("--cert", default="server-cert.pem", help="TLS server certificate")
+    parser.add_argument("--key", default="server-key.pem", help="TLS server private key")
+    args = parser.parse_args()
+
+    threads = []
+    if args.tcp_port:
+        threads.append(threading.Thread(target=stream_server, args=(args.tcp_port, None, "TCP"), daemon=True))
+    if args.tls_port:
+        tls_context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        tls_context.load_cert_chain(certfile=args.cert, keyfile=args.key)
+        threads.append(threading.Thread(target=stream_server, args=(args.tls_port, tls_context, "TLS"), daemon=True))
+    if args.udp_port:
+        threads.append(threading.Thread(target=udp_server, args=(args.udp_port,), daemon=True))
+
+    for thread in threads:
+        thread.start()
+    try:
+        while True:
+            time.sleep(1)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
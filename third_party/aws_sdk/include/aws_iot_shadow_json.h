@@ -31,6 +31,27 @@ bool isJsonValidAndParse(const char *pJsonDocument, size_t jsonSize, void *pJson
 bool isJsonKeyMatchingAndUpdateValue(const char *pJsonDocument, void *pJsonHandler, int32_t tokenCount,
 									 jsonStruct_t *pDataStruct, uint32_t *pDataLength, int32_t *pDataPosition);
 
+/**
+ * @brief Called by dispatchJsonKeysOnDelta for every object key outside of "metadata"
+ *
+ * @param pJsonDocument document the key was found in
+ * @param pKey start of the key inside pJsonDocument, not null terminated
+ * @param keyLength length of the key in bytes
+ * @param keyHash jsonKeyHash() of the key
+ * @param valueTokenIndex token index of the key's value, to be passed to updateValueFromJsonToken
+ * @param pContext context given to dispatchJsonKeysOnDelta
+ */
+typedef void (*jsonKeyHandler_t)(const char *pJsonDocument, const char *pKey, size_t keyLength, uint32_t keyHash,
+								 int32_t valueTokenIndex, void *pContext);
+
+uint32_t jsonKeyHash(const char *pKey, size_t keyLength);
+
+void dispatchJsonKeysOnDelta(const char *pJsonDocument, void *pJsonHandler, int32_t tokenCount,
+							 jsonKeyHandler_t keyHandler, void *pContext);
+
+bool updateValueFromJsonToken(const char *pJsonDocument, void *pJsonHandler, int32_t valueTokenIndex,
+							  jsonStruct_t *pDataStruct, uint32_t *pDataLength, int32_t *pDataPosition);
+
 IoT_Error_t aws_iot_shadow_internal_get_request_json(char *pBuffer, size_t bufferSize);
 
 IoT_Error_t aws_iot_shadow_internal_delete_request_json(char *pBuffer, size_t bufferSize);
@@ -26,6 +26,8 @@ extern "C" {
  */
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 /**
  * @brief This is a static JSON object that could be used in code
@@ -68,10 +70,34 @@ struct jsonStruct {
 	jsonStructCallback_t cb; ///< callback to be executed on receiving the Key value pair
 };
 
+/**
+ * @brief Streaming writer for Shadow JSON documents
+ *
+ * Keeps a cursor into the document so every append is proportional to the data appended, instead of
+ * rescanning the document. The first error is kept and every later write is ignored, so a whole sequence
+ * can be checked once at the end.
+ */
+typedef struct {
+	char *pBuffer; ///< Buffer the document is written into, always null terminated
+	size_t bufferSize; ///< Size of pBuffer in bytes
+	size_t length; ///< Length of the document written so far, excluding the null terminator
+	uint16_t fieldCount; ///< Number of key value pairs written
+	IoT_Error_t error; ///< First error hit while writing
+} ShadowJsonWriter_t;
+
+/**
+ * @brief A jsonStruct_t with the value it was last written with, used to write only changed fields
+ */
+typedef struct {
+	jsonStruct_t *pStruct; ///< Field being tracked
+	uint64_t lastValue; ///< Snapshot of the last written value
+	bool isEmitted; ///< lastValue holds a written value, clear to force the field to be written again
+} ShadowTrackedField_t;
+
 /**
  * @brief Initialize the JSON document with Shadow expected name/value
  *
- * This Function will fill the JSON Buffer with a null terminated string. Internally it uses snprintf
+ * This Function will fill the JSON Buffer with a null terminated string.
  * This function should always be used First, followed by iot_shadow_add_reported and/or iot_shadow_add_desired.
  * Always finish the call sequence with iot_finalize_json_document
  *
@@ -130,6 +156,78 @@ IoT_Error_t aws_iot_shadow_add_desired(char *pJsonDocument, size_t maxSizeOfJson
  */
 IoT_Error_t aws_iot_finalize_json_document(char *pJsonDocument, size_t maxSizeOfJsonDocument);
 
+/**
+ * @brief Start a Shadow JSON document with a streaming writer
+ *
+ * Equivalent to aws_iot_shadow_init_json_document. Follow with one or more sections, each opened with
+ * aws_iot_shadow_json_writer_begin_section and closed with aws_iot_shadow_json_writer_end_section, and
+ * finish with aws_iot_shadow_json_writer_finalize. pWriter->length then holds the document length.
+ *
+ * @param pWriter writer to initialize
+ * @param pBuffer buffer the document is written into
+ * @param bufferSize size of pBuffer
+ * @return An IoT Error Type defining if the buffer was null or the entire string was not filled up
+ */
+IoT_Error_t aws_iot_shadow_json_writer_init(ShadowJsonWriter_t *pWriter, char *pBuffer, size_t bufferSize);
+
+/**
+ * @brief Open a section of the state, normally "reported" or "desired"
+ *
+ * @param pWriter writer initialized by aws_iot_shadow_json_writer_init
+ * @param pSectionKey key of the section
+ * @return The first error hit by the writer so far
+ */
+IoT_Error_t aws_iot_shadow_json_writer_begin_section(ShadowJsonWriter_t *pWriter, const char *pSectionKey);
+
+/**
+ * @brief Write one key value pair into the open section
+ *
+ * Numbers are formatted without the printf family, floating point values with six decimals.
+ *
+ * @param pWriter writer with an open section
+ * @param pStruct key value pair to write
+ * @return The first error hit by the writer so far
+ */
+IoT_Error_t aws_iot_shadow_json_writer_add(ShadowJsonWriter_t *pWriter, const jsonStruct_t *pStruct);
+
+/**
+ * @brief Write only the tracked fields whose value changed since they were last written
+ *
+ * The snapshot of a field is updated as soon as it is written. If the document is then not published,
+ * call aws_iot_shadow_mark_fields_changed so the fields are written again next time.
+ *
+ * @param pWriter writer with an open section
+ * @param pFields tracked fields, zero initialized before their first use
+ * @param count number of entries in pFields
+ * @return The first error hit by the writer so far
+ */
+IoT_Error_t aws_iot_shadow_json_writer_add_changed(ShadowJsonWriter_t *pWriter, ShadowTrackedField_t *pFields,
+												   uint8_t count);
+
+/**
+ * @brief Force the given tracked fields to be written by the next aws_iot_shadow_json_writer_add_changed
+ *
+ * @param pFields tracked fields
+ * @param count number of entries in pFields
+ */
+void aws_iot_shadow_mark_fields_changed(ShadowTrackedField_t *pFields, uint8_t count);
+
+/**
+ * @brief Close the section opened by aws_iot_shadow_json_writer_begin_section
+ *
+ * @param pWriter writer with an open section
+ * @return The first error hit by the writer so far
+ */
+IoT_Error_t aws_iot_shadow_json_writer_end_section(ShadowJsonWriter_t *pWriter);
+
+/**
+ * @brief Finish the document with the client token, like aws_iot_finalize_json_document
+ *
+ * @param pWriter writer with no open section
+ * @return The first error hit by the writer, SUCCESS if the whole document fit in the buffer
+ */
+IoT_Error_t aws_iot_shadow_json_writer_finalize(ShadowJsonWriter_t *pWriter);
+
 /**
  * @brief Fill the given buffer with client token for tracking the Repsonse.
  *
@@ -26,6 +26,8 @@ extern "C" {
 
 #include <string.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
 
 #include "aws_iot_json_utils.h"
 #include "aws_iot_log.h"
@@ -37,8 +39,6 @@ extern char mqttClientID[MAX_SIZE_OF_UNIQUE_CLIENT_ID_BYTES];
 static uint32_t clientTokenNum = 0;
 
 //helper functions
-static IoT_Error_t convertDataToString(char *pStringBuffer, size_t maxSizoStringBuffer, JsonPrimitiveType type,
-									   void *pData);
 int32_t FillWithClientTokenSize(char *pBufferToBeUpdatedWithClientToken, size_t maxSizeOfJsonDocument);
 
 void resetClientTokenSequenceNum(void) {
@@ -110,268 +110,386 @@ static inline IoT_Error_t checkReturnValueOfSnPrintf(int32_t snPrintfReturn, siz
 	return SUCCESS;
 }
 
-IoT_Error_t aws_iot_shadow_init_json_document(char *pJsonDocument, size_t maxSizeOfJsonDocument) {
+/* Largest magnitude formatted with integer arithmetic, beyond it doubles fall back to snprintf */
+#define JSON_WRITER_MAX_FIXED_DOUBLE 1e18
+#define JSON_WRITER_DOUBLE_DECIMALS 6
+#define JSON_WRITER_DOUBLE_SCALE 1000000u
 
-	IoT_Error_t ret_val = SUCCESS;
-	int32_t snPrintfReturn = 0;
+static void writerAppend(ShadowJsonWriter_t *pWriter, const char *pData, size_t dataLength) {
+	if(pWriter->error != SUCCESS) {
+		return;
+	}
+	/* Always keep room for the terminating null so the document stays a valid C string */
+	if(dataLength >= pWriter->bufferSize - pWriter->length) {
+		pWriter->error = SHADOW_JSON_BUFFER_TRUNCATED;
+		return;
+	}
+	memcpy(pWriter->pBuffer + pWriter->length, pData, dataLength);
+	pWriter->length += dataLength;
+	pWriter->pBuffer[pWriter->length] = '\0';
+}
 
-	if(pJsonDocument == NULL) {
-		return NULL_VALUE_ERROR;
+static void writerAppendString(ShadowJsonWriter_t *pWriter, const char *pString) {
+	writerAppend(pWriter, pString, strlen(pString));
+}
+
+/* Replaces the trailing comma of the last member, if any, with the closing brace */
+static void writerCloseObject(ShadowJsonWriter_t *pWriter) {
+	if(pWriter->error == SUCCESS && pWriter->length > 0 && pWriter->pBuffer[pWriter->length - 1] == ',') {
+		pWriter->length--;
 	}
-	snPrintfReturn = snprintf(pJsonDocument, maxSizeOfJsonDocument, "{\"state\":{");
+	writerAppend(pWriter, "}", 1);
+}
 
-	ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, maxSizeOfJsonDocument);
+static size_t formatUnsigned(char *pOut, uint64_t value) {
+	char digits[20];
+	size_t count = 0;
+	size_t i;
 
-	return ret_val;
+	do {
+		digits[count++] = (char) ('0' + (value % 10u));
+		value /= 10u;
+	} while(value != 0);
 
+	for(i = 0; i < count; i++) {
+		pOut[i] = digits[count - 1 - i];
+	}
+	return count;
 }
 
-IoT_Error_t aws_iot_shadow_add_desired(char *pJsonDocument, size_t maxSizeOfJsonDocument, uint8_t count, ...) {
-	IoT_Error_t ret_val = SUCCESS;
-	size_t tempSize = 0;
-	int8_t i;
-	size_t remSizeOfJsonBuffer = maxSizeOfJsonDocument;
-	int32_t snPrintfReturn = 0;
-	va_list pArgs;
-	jsonStruct_t *pTemporary = NULL;
-	va_start(pArgs, count);
+static void writerAppendUnsigned(ShadowJsonWriter_t *pWriter, uint64_t value) {
+	char number[20];
+	writerAppend(pWriter, number, formatUnsigned(number, value));
+}
 
-	if(pJsonDocument == NULL) {
-		va_end(pArgs);
-		return NULL_VALUE_ERROR;
-	}
+static void writerAppendSigned(ShadowJsonWriter_t *pWriter, int64_t value) {
+	char number[21];
+	size_t length = 0;
+	uint64_t magnitude = (uint64_t) value;
 
-	tempSize = maxSizeOfJsonDocument - strlen(pJsonDocument);
-	if(tempSize <= 1) {
-		va_end(pArgs);
-		return SHADOW_JSON_ERROR;
+	if(value < 0) {
+		number[length++] = '-';
+		magnitude = 0u - magnitude;
 	}
-	remSizeOfJsonBuffer = tempSize;
+	length += formatUnsigned(number + length, magnitude);
+	writerAppend(pWriter, number, length);
+}
 
-	snPrintfReturn = snprintf(pJsonDocument + strlen(pJsonDocument), remSizeOfJsonBuffer, "\"desired\":{");
-	ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, remSizeOfJsonBuffer);
+/* Fixed notation with six decimals, matching the "%f" output used so far */
+static void writerAppendDouble(ShadowJsonWriter_t *pWriter, double value) {
+	char number[1 + 20 + 1 + JSON_WRITER_DOUBLE_DECIMALS];
+	size_t length = 0;
+	uint64_t integerPart;
+	uint64_t fractionPart;
+	size_t i;
+	int32_t snPrintfReturn;
 
-	if(ret_val != SUCCESS) {
-		va_end(pArgs);
-		return ret_val;
+	if(isnan(value) || isinf(value)) {
+		/* JSON has no representation for these */
+		writerAppend(pWriter, "null", 4);
+		return;
 	}
 
-	for(i = 0; i < count; i++) {
-		tempSize = maxSizeOfJsonDocument - strlen(pJsonDocument);
-		if(tempSize <= 1) {
-			va_end(pArgs);
-			return SHADOW_JSON_ERROR;
-		}
-		remSizeOfJsonBuffer = tempSize;
-		pTemporary = va_arg (pArgs, jsonStruct_t *);
-		if(pTemporary != NULL) {
-			snPrintfReturn = snprintf(pJsonDocument + strlen(pJsonDocument), remSizeOfJsonBuffer, "\"%s\":",
-									  pTemporary->pKey);
-			ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, remSizeOfJsonBuffer);
-			if(ret_val != SUCCESS) {
-				va_end(pArgs);
-				return ret_val;
+	if(value >= JSON_WRITER_MAX_FIXED_DOUBLE || value <= -JSON_WRITER_MAX_FIXED_DOUBLE) {
+		if(pWriter->error == SUCCESS) {
+			snPrintfReturn = snprintf(pWriter->pBuffer + pWriter->length, pWriter->bufferSize - pWriter->length, "%f",
+									  value);
+			pWriter->error = checkReturnValueOfSnPrintf(snPrintfReturn, pWriter->bufferSize - pWriter->length);
+			if(pWriter->error == SUCCESS) {
+				pWriter->length += (size_t) snPrintfReturn;
 			}
-			if(pTemporary->pKey != NULL && pTemporary->pData != NULL) {
-				ret_val = convertDataToString(pJsonDocument + strlen(pJsonDocument), remSizeOfJsonBuffer,
-											  pTemporary->type, pTemporary->pData);
-			} else {
-				va_end(pArgs);
-				return NULL_VALUE_ERROR;
-			}
-			if(ret_val != SUCCESS) {
-				va_end(pArgs);
-				return ret_val;
-			}
-		} else {
-			va_end(pArgs);
-			return NULL_VALUE_ERROR;
 		}
+		return;
 	}
 
-	va_end(pArgs);
-	snPrintfReturn = snprintf(pJsonDocument + strlen(pJsonDocument) - 1, remSizeOfJsonBuffer, "},");
-	ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, remSizeOfJsonBuffer);
-	return ret_val;
-}
+	if(value < 0) {
+		number[length++] = '-';
+		value = -value;
+	}
 
-IoT_Error_t aws_iot_shadow_add_reported(char *pJsonDocument, size_t maxSizeOfJsonDocument, uint8_t count, ...) {
-	IoT_Error_t ret_val = SUCCESS;
+	integerPart = (uint64_t) value;
+	fractionPart = (uint64_t) ((value - (double) integerPart) * JSON_WRITER_DOUBLE_SCALE + 0.5);
+	if(fractionPart >= JSON_WRITER_DOUBLE_SCALE) {
+		integerPart++;
+		fractionPart -= JSON_WRITER_DOUBLE_SCALE;
+	}
 
-	int8_t i;
-	size_t remSizeOfJsonBuffer = maxSizeOfJsonDocument;
-	int32_t snPrintfReturn = 0;
-	size_t tempSize = 0;
-	jsonStruct_t *pTemporary;
-	va_list pArgs;
-	va_start(pArgs, count);
+	length += formatUnsigned(number + length, integerPart);
+	number[length++] = '.';
+	for(i = JSON_WRITER_DOUBLE_DECIMALS; i > 0; i--) {
+		number[length + i - 1] = (char) ('0' + (fractionPart % 10u));
+		fractionPart /= 10u;
+	}
+	length += JSON_WRITER_DOUBLE_DECIMALS;
+	writerAppend(pWriter, number, length);
+}
 
-	if(pJsonDocument == NULL) {
-		va_end(pArgs);
-		return NULL_VALUE_ERROR;
+static void writerAppendValue(ShadowJsonWriter_t *pWriter, JsonPrimitiveType type, const void *pData) {
+	if(type == SHADOW_JSON_INT32) {
+		writerAppendSigned(pWriter, *(const int32_t *) (pData));
+	} else if(type == SHADOW_JSON_INT16) {
+		writerAppendSigned(pWriter, *(const int16_t *) (pData));
+	} else if(type == SHADOW_JSON_INT8) {
+		writerAppendSigned(pWriter, *(const int8_t *) (pData));
+	} else if(type == SHADOW_JSON_UINT32) {
+		writerAppendUnsigned(pWriter, *(const uint32_t *) (pData));
+	} else if(type == SHADOW_JSON_UINT16) {
+		writerAppendUnsigned(pWriter, *(const uint16_t *) (pData));
+	} else if(type == SHADOW_JSON_UINT8) {
+		writerAppendUnsigned(pWriter, *(const uint8_t *) (pData));
+	} else if(type == SHADOW_JSON_DOUBLE) {
+		writerAppendDouble(pWriter, *(const double *) (pData));
+	} else if(type == SHADOW_JSON_FLOAT) {
+		writerAppendDouble(pWriter, *(const float *) (pData));
+	} else if(type == SHADOW_JSON_BOOL) {
+		writerAppendString(pWriter, *(const bool *) (pData) ? "true" : "false");
+	} else if(type == SHADOW_JSON_STRING) {
+		writerAppend(pWriter, "\"", 1);
+		writerAppendString(pWriter, (const char *) (pData));
+		writerAppend(pWriter, "\"", 1);
+	} else if(type == SHADOW_JSON_OBJECT) {
+		writerAppendString(pWriter, (const char *) (pData));
 	}
+}
 
+/* Snapshot used by the changed-field mode: raw bytes for numbers and bools, hash and length for strings */
+static uint64_t trackedValueOf(const jsonStruct_t *pStruct) {
+	uint64_t snapshot = 0;
+	size_t length;
+
+	switch(pStruct->type) {
+	case SHADOW_JSON_INT32:
+	case SHADOW_JSON_UINT32:
+	case SHADOW_JSON_FLOAT:
+		memcpy(&snapshot, pStruct->pData, sizeof(uint32_t));
+		break;
+	case SHADOW_JSON_INT16:
+	case SHADOW_JSON_UINT16:
+		memcpy(&snapshot, pStruct->pData, sizeof(uint16_t));
+		break;
+	case SHADOW_JSON_INT8:
+	case SHADOW_JSON_UINT8:
+		memcpy(&snapshot, pStruct->pData, sizeof(uint8_t));
+		break;
+	case SHADOW_JSON_DOUBLE:
+		memcpy(&snapshot, pStruct->pData, sizeof(double));
+		break;
+	case SHADOW_JSON_BOOL:
+		snapshot = *(const bool *) (pStruct->pData) ? 1u : 0u;
+		break;
+	case SHADOW_JSON_STRING:
+	case SHADOW_JSON_OBJECT:
+	default:
+		length = strlen((const char *) (pStruct->pData));
+		snapshot = ((uint64_t) jsonKeyHash((const char *) (pStruct->pData), length) << 32) | (uint32_t) length;
+		break;
+	}
+	return snapshot;
+}
 
-	tempSize = maxSizeOfJsonDocument - strlen(pJsonDocument);
-	if(tempSize <= 1) {
-		va_end(pArgs);
+IoT_Error_t aws_iot_shadow_json_writer_init(ShadowJsonWriter_t *pWriter, char *pBuffer, size_t bufferSize) {
+	if(pWriter == NULL || pBuffer == NULL) {
+		return NULL_VALUE_ERROR;
+	}
+	if(bufferSize == 0) {
 		return SHADOW_JSON_ERROR;
 	}
-	remSizeOfJsonBuffer = tempSize;
 
-	snPrintfReturn = snprintf(pJsonDocument + strlen(pJsonDocument), remSizeOfJsonBuffer, "\"reported\":{");
-	ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, remSizeOfJsonBuffer);
+	pWriter->pBuffer = pBuffer;
+	pWriter->bufferSize = bufferSize;
+	pWriter->length = 0;
+	pWriter->fieldCount = 0;
+	pWriter->error = SUCCESS;
+	pBuffer[0] = '\0';
 
-	if(ret_val != SUCCESS) {
-		va_end(pArgs);
-		return ret_val;
+	writerAppendString(pWriter, "{\"state\":{");
+	return pWriter->error;
+}
+
+IoT_Error_t aws_iot_shadow_json_writer_begin_section(ShadowJsonWriter_t *pWriter, const char *pSectionKey) {
+	if(pWriter == NULL || pSectionKey == NULL) {
+		return NULL_VALUE_ERROR;
 	}
 
-	for(i = 0; i < count; i++) {
-		tempSize = maxSizeOfJsonDocument - strlen(pJsonDocument);
-		if(tempSize <= 1) {
-			va_end(pArgs);
-			return SHADOW_JSON_ERROR;
-		}
-		remSizeOfJsonBuffer = tempSize;
-
-		pTemporary = va_arg (pArgs, jsonStruct_t *);
-		if(pTemporary != NULL) {
-			snPrintfReturn = snprintf(pJsonDocument + strlen(pJsonDocument), remSizeOfJsonBuffer, "\"%s\":",
-									  pTemporary->pKey);
-			ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, remSizeOfJsonBuffer);
-			if(ret_val != SUCCESS) {
-				va_end(pArgs);
-				return ret_val;
-			}
-			if(pTemporary->pKey != NULL && pTemporary->pData != NULL) {
-				ret_val = convertDataToString(pJsonDocument + strlen(pJsonDocument), remSizeOfJsonBuffer,
-											  pTemporary->type, pTemporary->pData);
-			} else {
-				va_end(pArgs);
-				return NULL_VALUE_ERROR;
-			}
-			if(ret_val != SUCCESS) {
-				va_end(pArgs);
-				return ret_val;
-			}
-		} else {
-			va_end(pArgs);
-			return NULL_VALUE_ERROR;
+	writerAppend(pWriter, "\"", 1);
+	writerAppendString(pWriter, pSectionKey);
+	writerAppend(pWriter, "\":{", 3);
+	return pWriter->error;
+}
+
+IoT_Error_t aws_iot_shadow_json_writer_add(ShadowJsonWriter_t *pWriter, const jsonStruct_t *pStruct) {
+	if(pWriter == NULL) {
+		return NULL_VALUE_ERROR;
+	}
+	if(pStruct == NULL || pStruct->pKey == NULL || pStruct->pData == NULL) {
+		if(pWriter->error == SUCCESS) {
+			pWriter->error = NULL_VALUE_ERROR;
 		}
+		return pWriter->error;
 	}
 
-	va_end(pArgs);
-	snPrintfReturn = snprintf(pJsonDocument + strlen(pJsonDocument) - 1, remSizeOfJsonBuffer, "},");
-	ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, remSizeOfJsonBuffer);
-	return ret_val;
+	writerAppend(pWriter, "\"", 1);
+	writerAppendString(pWriter, pStruct->pKey);
+	writerAppend(pWriter, "\":", 2);
+	writerAppendValue(pWriter, pStruct->type, pStruct->pData);
+	writerAppend(pWriter, ",", 1);
+	if(pWriter->error == SUCCESS) {
+		pWriter->fieldCount++;
+	}
+	return pWriter->error;
 }
 
+IoT_Error_t aws_iot_shadow_json_writer_add_changed(ShadowJsonWriter_t *pWriter, ShadowTrackedField_t *pFields,
+												   uint8_t count) {
+	uint8_t i;
+	uint64_t snapshot;
 
-int32_t FillWithClientTokenSize(char *pBufferToBeUpdatedWithClientToken, size_t maxSizeOfJsonDocument) {
-	int32_t snPrintfReturn;
-	snPrintfReturn = snprintf(pBufferToBeUpdatedWithClientToken, maxSizeOfJsonDocument, "%s-%d", mqttClientID,
-				  (int) clientTokenNum++);
+	if(pWriter == NULL || pFields == NULL) {
+		return NULL_VALUE_ERROR;
+	}
 
-	return snPrintfReturn;
+	for(i = 0; i < count && pWriter->error == SUCCESS; i++) {
+		if(pFields[i].pStruct == NULL || pFields[i].pStruct->pData == NULL) {
+			pWriter->error = NULL_VALUE_ERROR;
+			break;
+		}
+		snapshot = trackedValueOf(pFields[i].pStruct);
+		if(pFields[i].isEmitted && pFields[i].lastValue == snapshot) {
+			continue;
+		}
+		if(aws_iot_shadow_json_writer_add(pWriter, pFields[i].pStruct) == SUCCESS) {
+			pFields[i].lastValue = snapshot;
+			pFields[i].isEmitted = true;
+		}
+	}
+	return pWriter->error;
 }
 
-IoT_Error_t aws_iot_fill_with_client_token(char *pBufferToBeUpdatedWithClientToken, size_t maxSizeOfJsonDocument) {
-
-	int32_t snPrintfRet = 0;
-	snPrintfRet = FillWithClientTokenSize(pBufferToBeUpdatedWithClientToken, maxSizeOfJsonDocument);
-	return checkReturnValueOfSnPrintf(snPrintfRet, maxSizeOfJsonDocument);
+void aws_iot_shadow_mark_fields_changed(ShadowTrackedField_t *pFields, uint8_t count) {
+	uint8_t i;
 
+	if(pFields == NULL) {
+		return;
+	}
+	for(i = 0; i < count; i++) {
+		pFields[i].isEmitted = false;
+	}
 }
 
-IoT_Error_t aws_iot_finalize_json_document(char *pJsonDocument, size_t maxSizeOfJsonDocument) {
-	size_t remSizeOfJsonBuffer = maxSizeOfJsonDocument;
-	int32_t snPrintfReturn = 0;
-	size_t tempSize = 0;
-	IoT_Error_t ret_val = SUCCESS;
-
-	if(pJsonDocument == NULL) {
+IoT_Error_t aws_iot_shadow_json_writer_end_section(ShadowJsonWriter_t *pWriter) {
+	if(pWriter == NULL) {
 		return NULL_VALUE_ERROR;
 	}
 
-	tempSize = maxSizeOfJsonDocument - strlen(pJsonDocument);
-	if(tempSize <= 1) {
-		return SHADOW_JSON_ERROR;
+	writerCloseObject(pWriter);
+	writerAppend(pWriter, ",", 1);
+	return pWriter->error;
+}
+
+IoT_Error_t aws_iot_shadow_json_writer_finalize(ShadowJsonWriter_t *pWriter) {
+	if(pWriter == NULL) {
+		return NULL_VALUE_ERROR;
 	}
-	remSizeOfJsonBuffer = tempSize;
 
-	// strlen(ShadowTxBuffer) - 1 is to ensure we remove the last ,(comma) that was added
-	snPrintfReturn = snprintf(pJsonDocument + strlen(pJsonDocument) - 1, remSizeOfJsonBuffer, "}, \"%s\":\"",
-							  SHADOW_CLIENT_TOKEN_STRING);
-	ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, remSizeOfJsonBuffer);
+	writerCloseObject(pWriter);
+	writerAppendString(pWriter, ", \"" SHADOW_CLIENT_TOKEN_STRING "\":\"");
+	writerAppendString(pWriter, mqttClientID);
+	writerAppend(pWriter, "-", 1);
+	writerAppendSigned(pWriter, (int32_t) clientTokenNum++);
+	writerAppend(pWriter, "\"}", 2);
+	return pWriter->error;
+}
 
-	if(ret_val != SUCCESS) {
-		return ret_val;
+/* Continues a document built by earlier calls of the string based API, which only keep the null terminator */
+static IoT_Error_t writerResume(ShadowJsonWriter_t *pWriter, char *pJsonDocument, size_t maxSizeOfJsonDocument) {
+	size_t length;
+
+	if(pJsonDocument == NULL) {
+		return NULL_VALUE_ERROR;
 	}
-	// refactor this XXX repeated code
-	tempSize = maxSizeOfJsonDocument - strlen(pJsonDocument);
-	if(tempSize <= 1) {
+	length = strlen(pJsonDocument);
+	if(maxSizeOfJsonDocument - length <= 1) {
 		return SHADOW_JSON_ERROR;
 	}
-	remSizeOfJsonBuffer = tempSize;
 
+	pWriter->pBuffer = pJsonDocument;
+	pWriter->bufferSize = maxSizeOfJsonDocument;
+	pWriter->length = length;
+	pWriter->fieldCount = 0;
+	pWriter->error = SUCCESS;
+	return SUCCESS;
+}
 
-	snPrintfReturn = FillWithClientTokenSize(pJsonDocument + strlen(pJsonDocument), remSizeOfJsonBuffer);
-	ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, remSizeOfJsonBuffer);
+static IoT_Error_t addSection(char *pJsonDocument, size_t maxSizeOfJsonDocument, const char *pSectionKey,
+							  uint8_t count, va_list pArgs) {
+	ShadowJsonWriter_t writer;
+	IoT_Error_t ret_val;
+	uint8_t i;
 
+	ret_val = writerResume(&writer, pJsonDocument, maxSizeOfJsonDocument);
 	if(ret_val != SUCCESS) {
 		return ret_val;
 	}
-	tempSize = maxSizeOfJsonDocument - strlen(pJsonDocument);
-	if(tempSize <= 1) {
-		return SHADOW_JSON_ERROR;
+
+	aws_iot_shadow_json_writer_begin_section(&writer, pSectionKey);
+	for(i = 0; i < count && writer.error == SUCCESS; i++) {
+		aws_iot_shadow_json_writer_add(&writer, va_arg(pArgs, jsonStruct_t *));
 	}
-	remSizeOfJsonBuffer = tempSize;
+	return aws_iot_shadow_json_writer_end_section(&writer);
+}
+
+IoT_Error_t aws_iot_shadow_init_json_document(char *pJsonDocument, size_t maxSizeOfJsonDocument) {
+	ShadowJsonWriter_t writer;
 
+	return aws_iot_shadow_json_writer_init(&writer, pJsonDocument, maxSizeOfJsonDocument);
+}
 
-	snPrintfReturn = snprintf(pJsonDocument + strlen(pJsonDocument), remSizeOfJsonBuffer, "\"}");
-	ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, remSizeOfJsonBuffer);
+IoT_Error_t aws_iot_shadow_add_desired(char *pJsonDocument, size_t maxSizeOfJsonDocument, uint8_t count, ...) {
+	IoT_Error_t ret_val;
+	va_list pArgs;
 
+	va_start(pArgs, count);
+	ret_val = addSection(pJsonDocument, maxSizeOfJsonDocument, "desired", count, pArgs);
+	va_end(pArgs);
 	return ret_val;
 }
 
-static IoT_Error_t convertDataToString(char *pStringBuffer, size_t maxSizoStringBuffer, JsonPrimitiveType type,
-									   void *pData) {
-	int32_t snPrintfReturn = 0;
-	IoT_Error_t ret_val = SUCCESS;
+IoT_Error_t aws_iot_shadow_add_reported(char *pJsonDocument, size_t maxSizeOfJsonDocument, uint8_t count, ...) {
+	IoT_Error_t ret_val;
+	va_list pArgs;
 
-	if(maxSizoStringBuffer == 0) {
-		return SHADOW_JSON_ERROR;
-	}
+	va_start(pArgs, count);
+	ret_val = addSection(pJsonDocument, maxSizeOfJsonDocument, "reported", count, pArgs);
+	va_end(pArgs);
+	return ret_val;
+}
 
-	if(type == SHADOW_JSON_INT32) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "%li,", *(int32_t *) (pData));
-	} else if(type == SHADOW_JSON_INT16) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "%hi,", *(int16_t *) (pData));
-	} else if(type == SHADOW_JSON_INT8) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "%hhi,", *(int8_t *) (pData));
-	} else if(type == SHADOW_JSON_UINT32) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "%lu,", *(uint32_t *) (pData));
-	} else if(type == SHADOW_JSON_UINT16) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "%hu,", *(uint16_t *) (pData));
-	} else if(type == SHADOW_JSON_UINT8) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "%hhu,", *(uint8_t *) (pData));
-	} else if(type == SHADOW_JSON_DOUBLE) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "%f,", *(double *) (pData));
-	} else if(type == SHADOW_JSON_FLOAT) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "%f,", *(float *) (pData));
-	} else if(type == SHADOW_JSON_BOOL) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "%s,", *(bool *) (pData) ? "true" : "false");
-	} else if(type == SHADOW_JSON_STRING) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "\"%s\",", (char *) (pData));
-	} else if(type == SHADOW_JSON_OBJECT) {
-		snPrintfReturn = snprintf(pStringBuffer, maxSizoStringBuffer, "%s,", (char *) (pData));
-	}
 
+int32_t FillWithClientTokenSize(char *pBufferToBeUpdatedWithClientToken, size_t maxSizeOfJsonDocument) {
+	int32_t snPrintfReturn;
+	snPrintfReturn = snprintf(pBufferToBeUpdatedWithClientToken, maxSizeOfJsonDocument, "%s-%d", mqttClientID,
+				  (int) clientTokenNum++);
 
-	ret_val = checkReturnValueOfSnPrintf(snPrintfReturn, maxSizoStringBuffer);
+	return snPrintfReturn;
+}
+
+IoT_Error_t aws_iot_fill_with_client_token(char *pBufferToBeUpdatedWithClientToken, size_t maxSizeOfJsonDocument) {
+
+	int32_t snPrintfRet = 0;
+	snPrintfRet = FillWithClientTokenSize(pBufferToBeUpdatedWithClientToken, maxSizeOfJsonDocument);
+	return checkReturnValueOfSnPrintf(snPrintfRet, maxSizeOfJsonDocument);
 
-	return ret_val;
+}
+
+IoT_Error_t aws_iot_finalize_json_document(char *pJsonDocument, size_t maxSizeOfJsonDocument) {
+	ShadowJsonWriter_t writer;
+	IoT_Error_t ret_val;
+
+	ret_val = writerResume(&writer, pJsonDocument, maxSizeOfJsonDocument);
+	if(ret_val != SUCCESS) {
+		return ret_val;
+	}
+	return aws_iot_shadow_json_writer_finalize(&writer);
 }
 
 static jsmn_parser shadowJsonParser;
@@ -478,6 +596,69 @@ bool isJsonKeyMatchingAndUpdateValue(const char *pJsonDocument, void *pJsonHandl
 	return false;
 }
 
+uint32_t jsonKeyHash(const char *pKey, size_t keyLength) {
+	/* 32-bit FNV-1a */
+	uint32_t hash = 2166136261u;
+	size_t i;
+
+	for(i = 0; i < keyLength; i++) {
+		hash ^= (uint8_t) pKey[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+void dispatchJsonKeysOnDelta(const char *pJsonDocument, void *pJsonHandler, int32_t tokenCount,
+							 jsonKeyHandler_t keyHandler, void *pContext) {
+	int32_t i, metadataEnd;
+	size_t keyLength;
+	const char *pKey;
+
+	IOT_UNUSED(pJsonHandler);
+
+	for(i = 1; i < tokenCount - 1; ) {
+		/* Only object keys are dispatched: jsmn gives a key string exactly one child, its value. */
+		if(jsonTokenStruct[i].type != JSMN_STRING || jsonTokenStruct[i].size != 1) {
+			i++;
+			continue;
+		}
+
+		pKey = pJsonDocument + jsonTokenStruct[i].start;
+		keyLength = (size_t) (jsonTokenStruct[i].end - jsonTokenStruct[i].start);
+
+		if(keyLength == sizeof(SHADOW_METADATA_STRING) - 1
+		   && strncmp(pKey, SHADOW_METADATA_STRING, keyLength) == 0) {
+			/* Skip the whole "metadata" subtree by its extent instead of visiting its keys. */
+			metadataEnd = jsonTokenStruct[i + 1].end;
+			i += 2;
+			while(i < tokenCount && jsonTokenStruct[i].end < metadataEnd) {
+				i++;
+			}
+			continue;
+		}
+
+		keyHandler(pJsonDocument, pKey, keyLength, jsonKeyHash(pKey, keyLength), i + 1, pContext);
+		i++;
+	}
+}
+
+bool updateValueFromJsonToken(const char *pJsonDocument, void *pJsonHandler, int32_t valueTokenIndex,
+							  jsonStruct_t *pDataStruct, uint32_t *pDataLength, int32_t *pDataPosition) {
+	jsmntok_t dataToken;
+
+	IOT_UNUSED(pJsonHandler);
+
+	if(valueTokenIndex < 1 || valueTokenIndex >= MAX_JSON_TOKEN_EXPECTED) {
+		return false;
+	}
+
+	dataToken = jsonTokenStruct[valueTokenIndex];
+	UpdateValueIfNoObject(pJsonDocument, pDataStruct, dataToken);
+	*pDataPosition = dataToken.start;
+	*pDataLength = (uint32_t) (dataToken.end - dataToken.start);
+	return true;
+}
+
 bool isReceivedJsonValid(const char *pJsonDocument, size_t jsonSize ) {
 	int32_t tokenCount;
 
@@ -48,6 +48,10 @@ typedef struct {
 	void *pStruct;
 	jsonStructCallback_t callback;
 	bool isFree;
+	size_t keyLength;
+	uint32_t keyHash;
+	uint32_t nextEntry;        ///< 1-based index of the next entry in the same hash bucket, 0 terminates the chain
+	uint32_t dispatchSequence; ///< Delta sequence this entry was last dispatched in
 } JsonTokenTable_t;
 
 typedef struct {
@@ -76,8 +80,15 @@ SubscriptionRecord_t SubscriptionList[MAX_TOPICS_AT_ANY_GIVEN_TIME];
 #define SUBSCRIBE_SETTLING_TIME 2
 char shadowRxBuf[SHADOW_MAX_SIZE_OF_RX_BUFFER];
 
+#ifndef SHADOW_DELTA_KEY_HASH_BUCKETS
+#define SHADOW_DELTA_KEY_HASH_BUCKETS 64
+#endif
+
 static JsonTokenTable_t tokenTable[MAX_JSON_TOKEN_EXPECTED];
 static uint32_t tokenTableIndex = 0;
+/* Registered delta keys chained by jsonKeyHash(), so a delta is dispatched in a single pass over its tokens */
+static uint32_t deltaKeyBuckets[SHADOW_DELTA_KEY_HASH_BUCKETS];
+static uint32_t deltaDispatchSequence = 0;
 static bool deltaTopicSubscribedFlag = false;
 uint32_t shadowJsonVersionNum = 0;
 bool shadowDiscardOldDeltaFlag = true;
@@ -89,6 +100,9 @@ static void AckStatusCallback(AWS_IoT_Client *pClient, char *topicName,
 static void shadow_delta_callback(AWS_IoT_Client *pClient, char *topicName,
 								  uint16_t topicNameLen, IoT_Publish_Message_Params *params, void *pData);
 
+static void shadow_delta_key_handler(const char *pJsonDocument, const char *pKey, size_t keyLength,
+									 uint32_t keyHash, int32_t valueTokenIndex, void *pContext);
+
 static void topicNameFromThingAndAction(char *pTopic, const char *pThingName, ShadowActions_t action,
 										ShadowAckTopicTypes_t ackType);
 
@@ -101,6 +115,9 @@ void initDeltaTokens(void) {
 	for(i = 0; i < MAX_JSON_TOKEN_EXPECTED; i++) {
 		tokenTable[i].isFree = true;
 	}
+	for(i = 0; i < SHADOW_DELTA_KEY_HASH_BUCKETS; i++) {
+		deltaKeyBuckets[i] = 0;
+	}
 	tokenTableIndex = 0;
 	deltaTopicSubscribedFlag = false;
 }
@@ -108,6 +125,7 @@ void initDeltaTokens(void) {
 IoT_Error_t registerJsonTokenOnDelta(jsonStruct_t *pStruct) {
 
 	IoT_Error_t rc = SUCCESS;
+	uint32_t *pEntry;
 
 	if(!deltaTopicSubscribedFlag) {
 		snprintf(shadowDeltaTopic, MAX_SHADOW_TOPIC_LENGTH_BYTES, "$aws/things/%s/shadow/update/delta", myThingName);
@@ -124,6 +142,17 @@ IoT_Error_t registerJsonTokenOnDelta(jsonStruct_t *pStruct) {
 	tokenTable[tokenTableIndex].callback = pStruct->cb;
 	tokenTable[tokenTableIndex].pStruct = pStruct;
 	tokenTable[tokenTableIndex].isFree = false;
+	tokenTable[tokenTableIndex].keyLength = strlen(pStruct->pKey);
+	tokenTable[tokenTableIndex].keyHash = jsonKeyHash(pStruct->pKey, tokenTable[tokenTableIndex].keyLength);
+	tokenTable[tokenTableIndex].nextEntry = 0;
+	tokenTable[tokenTableIndex].dispatchSequence = deltaDispatchSequence;
+
+	/* Append to the end of the bucket so keys registered twice are still dispatched in registration order */
+	pEntry = &deltaKeyBuckets[tokenTable[tokenTableIndex].keyHash % SHADOW_DELTA_KEY_HASH_BUCKETS];
+	while(*pEntry != 0) {
+		pEntry = &tokenTable[*pEntry - 1].nextEntry;
+	}
+	*pEntry = tokenTableIndex + 1;
 	tokenTableIndex++;
 
 	return rc;
@@ -473,15 +502,12 @@ void HandleExpiredResponseCallbacks(void) {
 static void shadow_delta_callback(AWS_IoT_Client *pClient, char *topicName,
 								  uint16_t topicNameLen, IoT_Publish_Message_Params *params, void *pData) {
 	int32_t tokenCount;
-	uint32_t i = 0;
 	void *pJsonHandler = NULL;
-	int32_t DataPosition;
-	uint32_t dataLength;
 	uint32_t tempVersionNumber = 0;
+	char *pDeltaDocument;
 
 	FUNC_ENTRY;
 
-	IOT_UNUSED(pClient);
 	IOT_UNUSED(topicName);
 	IOT_UNUSED(topicNameLen);
 	IOT_UNUSED(pData);
@@ -491,16 +517,24 @@ static void shadow_delta_callback(AWS_IoT_Client *pClient, char *topicName,
 		return;
 	}
 
-	memcpy(shadowRxBuf, params->payload, params->payloadLen);
-	shadowRxBuf[params->payloadLen] = '\0';    // jsmn_parse relies on a string
+	/* Parse the delta in place when the MQTT read buffer has room for the terminator after the payload,
+	 * otherwise fall back to copying it into shadowRxBuf.
+	 */
+	pDeltaDocument = (char *) params->payload;
+	if(NULL == pClient || pDeltaDocument < (char *) pClient->clientData.readBuf
+	   || pDeltaDocument + params->payloadLen >= (char *) pClient->clientData.readBuf + pClient->clientData.readBufSize) {
+		memcpy(shadowRxBuf, params->payload, params->payloadLen);
+		pDeltaDocument = shadowRxBuf;
+	}
+	pDeltaDocument[params->payloadLen] = '\0';    // value parsers and callbacks rely on a string
 
-	if(!isJsonValidAndParse(shadowRxBuf, SHADOW_MAX_SIZE_OF_RX_BUFFER, pJsonHandler, &tokenCount)) {
+	if(!isJsonValidAndParse(pDeltaDocument, params->payloadLen, pJsonHandler, &tokenCount)) {
 		IOT_WARN("Received JSON is not valid");
 		return;
 	}
 
 	if(shadowDiscardOldDeltaFlag) {
-		if(extractVersionNumber(shadowRxBuf, pJsonHandler, tokenCount, &tempVersionNumber)) {
+		if(extractVersionNumber(pDeltaDocument, pJsonHandler, tokenCount, &tempVersionNumber)) {
 			if(tempVersionNumber > shadowJsonVersionNum) {
 				shadowJsonVersionNum = tempVersionNumber;
 			} else {
@@ -511,14 +545,35 @@ static void shadow_delta_callback(AWS_IoT_Client *pClient, char *topicName,
 		}
 	}
 
-	for(i = 0; i < tokenTableIndex; i++) {
-		if(!tokenTable[i].isFree) {
-			if(isJsonKeyMatchingAndUpdateValue(shadowRxBuf, pJsonHandler, tokenCount,
-											   (jsonStruct_t *) tokenTable[i].pStruct, &dataLength, &DataPosition)) {
-				if(tokenTable[i].callback != NULL) {
-					tokenTable[i].callback(shadowRxBuf + DataPosition, dataLength,
-										   (jsonStruct_t *) tokenTable[i].pStruct);
-				}
+	deltaDispatchSequence++;
+	dispatchJsonKeysOnDelta(pDeltaDocument, pJsonHandler, tokenCount, shadow_delta_key_handler, NULL);
+}
+
+static void shadow_delta_key_handler(const char *pJsonDocument, const char *pKey, size_t keyLength,
+									 uint32_t keyHash, int32_t valueTokenIndex, void *pContext) {
+	uint32_t entry;
+	JsonTokenTable_t *pToken;
+	int32_t DataPosition;
+	uint32_t dataLength;
+
+	IOT_UNUSED(pContext);
+
+	entry = deltaKeyBuckets[keyHash % SHADOW_DELTA_KEY_HASH_BUCKETS];
+	while(entry != 0) {
+		pToken = &tokenTable[entry - 1];
+		entry = pToken->nextEntry;
+
+		/* Only the first occurrence of a key in the delta updates its struct */
+		if(pToken->isFree || pToken->keyHash != keyHash || pToken->keyLength != keyLength
+		   || pToken->dispatchSequence == deltaDispatchSequence || strncmp(pToken->pKey, pKey, keyLength) != 0) {
+			continue;
+		}
+		pToken->dispatchSequence = deltaDispatchSequence;
+
+		if(updateValueFromJsonToken(pJsonDocument, NULL, valueTokenIndex, (jsonStruct_t *) pToken->pStruct,
+									&dataLength, &DataPosition)) {
+			if(pToken->callback != NULL) {
+				pToken->callback(pJsonDocument + DataPosition, dataLength, (jsonStruct_t *) pToken->pStruct);
 			}
 		}
 	}
@@ -14,7 +14,78 @@
 
 #include "sl_mqtt_client_types.h"
 
-/* Maps SL MQTT Client Context directly to AzureIoTMQTT */
-typedef sl_mqtt_client_t AzureIoTMQTT_t;
+/**
+ * @brief Number of operations that can wait for their acknowledgement at the same time.
+ *
+ * Every QoS 1 publish, subscribe and unsubscribe takes one entry until the NWP reports it complete.
+ * A publish that finds the table full fails with eAzureIoTMQTTNoMemory.
+ */
+#ifndef azureiotmqttMAX_IN_FLIGHT
+#define azureiotmqttMAX_IN_FLIGHT 8
+#endif
+
+/**
+ * @brief Maximum number of topic filters in one subscribe or unsubscribe request.
+ */
+#ifndef azureiotmqttMAX_TOPIC_FILTERS
+#define azureiotmqttMAX_TOPIC_FILTERS 4
+#endif
+
+struct AzureIoTMQTTPacketInfo;
+struct AzureIoTMQTTDeserializedInfo;
+
+/**
+ * @brief An operation waiting for its acknowledgement from the broker.
+ *
+ * ucRemainingData holds the packet identifier followed by one return code per
+ * topic filter, the same layout as the remaining data of a SUBACK packet.
+ *
+ * ulState packs the generation of the entry, a bit per refused topic filter and
+ * the number of topic filters still waiting, so a completion is counted with a
+ * single compare-and-swap and one that belongs to an earlier generation is ignored.
+ */
+typedef struct AzureIoTMQTTInFlight
+{
+  uint8_t ucPacketType;  /**< Type of the request, 0 when the entry is free. */
+  uint8_t ucFilterCount; /**< Topic filters in the request, 1 for a publish. */
+  bool xAborted;         /**< The request failed before it was sent completely and is not acknowledged. */
+  uint16_t usPacketId;   /**< Packet identifier reported with the acknowledgement. */
+  uint32_t ulState;      /**< Generation, refused topic filters and topic filters still waiting. */
+  uint8_t ucRemainingData[2 + azureiotmqttMAX_TOPIC_FILTERS];
+} AzureIoTMQTTInFlight_t;
+
+/**
+ * @brief Azure IoT MQTT context on top of SL MQTT.
+ *
+ * xClient must stay the first member, so the client pointer passed to the
+ * SL MQTT callbacks is also the context pointer.
+ */
+typedef struct AzureIoTMQTT
+{
+  sl_mqtt_client_t xClient;
+  void (*xEventCallback)(struct AzureIoTMQTT *pxContext,
+                         struct AzureIoTMQTTPacketInfo *pxPacketInfo,
+                         struct AzureIoTMQTTDeserializedInfo *pxDeserializedInfo);
+  sl_mqtt_broker_v2_t xBroker;
+  sl_mqtt_client_configuration_t xConfiguration;
+  uint16_t usNextPacketId;
+  AzureIoTMQTTInFlight_t xInFlight[azureiotmqttMAX_IN_FLIGHT];
+} AzureIoTMQTT_t;
+
+/**
+ * @brief Set the broker used by the next AzureIoTMQTT_Connect().
+ *
+ * The NWP needs the broker address, so resolve the IoT Hub hostname first.
+ * IoT Hub requires SNI, so set enable_sni and sni_host_name to the hostname.
+ * Call this after AzureIoTHubClient_Init() or AzureIoTProvisioningClient_Init(),
+ * which reset the MQTT context.
+ *
+ * @param[in] pxContext MQTT context of the client.
+ * @param[in] pxBroker Broker address, port and keep alive settings. Copied into the context.
+ * @param[in] xTlsFlags TLS options of the connection, see sl_mqtt_tls_flag_t.
+ */
+void AzureIoTMQTT_SetBroker(AzureIoTMQTT_t *pxContext,
+                            const sl_mqtt_broker_v2_t *pxBroker,
+                            sl_mqtt_tls_flag_t xTlsFlags);
 
 #endif /* AZURE_IOT_MQTT_PORT_H */
@@ -2,152 +2,370 @@
  * Licensed under the MIT License. */
 
 /**
- * @file azure_iot_core_mqtt.c
- * @brief Implements the port for Azure IoT MQTT based on coreMQTT.
+ * @file azure_iot_sl_si91x_mqtt.c
+ * @brief Implements the port for Azure IoT MQTT based on the SL MQTT client of the NWP.
  *
- * @note This interface is private and subjected to change. Currently, there is only
- *       one implementation for this interface, which uses coreMQTT as underlying MQTT stack.
+ * @note The NWP owns the socket, the TLS session and the keep alive, so the transport
+ *       interface and the network buffer given to AzureIoTMQTT_Init() are not used.
+ *
+ *       Requests are sent without waiting for their response. The NWP reports each
+ *       completion to the SL MQTT event handler, which reports it to the Azure client
+ *       as PUBACK, SUBACK or UNSUBACK with the packet identifier of the request.
+ *       Incoming messages are passed to the Azure client straight from the NWP buffer.
+ *       All Azure callbacks therefore run in the thread of the SL event handler.
  *
  */
 
-#include <assert.h>
-
 #include "azure_iot_mqtt.h"
 #include "sl_mqtt_client.h"
+#include "sl_net.h"
+#include "sl_cmsis_utility.h"
+#include <stdlib.h>
 #include <string.h>
 
 /******************************************************
  *                    Constants
  ******************************************************/
-//Resolve hostname <hostname>.azure-devices.net and store in azure_mqtt_broker_ip variable
-#define MQTT_BROKER_IP   "40.78.196.103"
-#define MQTT_BROKER_PORT 8886
-
-#define CLIENT_PORT 4002
-
-#define CLIENT_ID "WISECONNECT-SDK-MQTT-CLIENT-ID"
-
-#define TOPIC_TO_BE_SUBSCRIBED "THERMOSTAT-DATA\0"
-#define QOS_OF_SUBSCRIPTION    SL_MQTT_QOS_LEVEL_1
-
-#define PUBLISH_TOPIC          "WISECONNECT_SDK_TOPIC"
-#define PUBLISH_MESSAGE        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do"
-#define QOS_OF_PUBLISH_MESSAGE 0
-
-#define IS_DUPLICATE_MESSAGE 0
-#define IS_MESSAGE_RETAINED  1
-#define IS_CLEAN_SESSION     1
-
-#define LAST_WILL_TOPIC       "WISECONNECT-SDK-MQTT-CLIENT-LAST-WILL"
-#define LAST_WILL_MESSAGE     "WISECONNECT-SDK-MQTT-CLIENT has been disconnect from network"
-#define QOS_OF_LAST_WILL      1
-#define IS_LAST_WILL_RETAINED 1
-
-#define ENCRYPT_CONNECTION     0
-#define KEEP_ALIVE_INTERVAL    2000
-#define MQTT_CONNECT_TIMEOUT   5000
-#define MQTT_KEEPALIVE_RETRIES 0
 
-#define SEND_CREDENTIALS 0
+#ifndef azureiotmqttDISCONNECT_TIMEOUT_MS
+#define azureiotmqttDISCONNECT_TIMEOUT_MS 5000
+#endif
+
+/* Credential slot used for the user name and password of the connection */
+#ifndef azureiotmqttCREDENTIAL_ID
+#define azureiotmqttCREDENTIAL_ID SL_NET_MQTT_CLIENT_CREDENTIAL_ID(0)
+#endif
+
+/* Size of the packet identifier at the start of the acknowledgement data */
+#define azureiotmqttPACKET_ID_SIZE 2
+
+#if (azureiotmqttMAX_TOPIC_FILTERS > 8) || (azureiotmqttMAX_IN_FLIGHT > 256)
+#error "ulState has one byte for the refused topic filters and the SL context one byte for the entry"
+#endif
+
+/* Fields of AzureIoTMQTTInFlight_t::ulState */
+#define azureiotmqttSTATE(ucGeneration, ucRefused, ucPending) \
+  (((uint32_t)(uint8_t)(ucGeneration) << 16) | ((uint32_t)(ucRefused) << 8) | (uint32_t)(ucPending))
+#define azureiotmqttSTATE_GENERATION(ulState) ((uint8_t)((ulState) >> 16))
+#define azureiotmqttSTATE_REFUSED(ulState)    ((uint8_t)((ulState) >> 8))
+#define azureiotmqttSTATE_PENDING(ulState)    ((uint8_t)(ulState))
+
+/* SL context of a request: generation, entry and topic filter, with bit 0 set so it is never NULL */
+#define azureiotmqttTOKEN(ucGeneration, ulIndex, ucFilter)                           \
+  ((void *)(uintptr_t)(((uint32_t)(ucGeneration) << 16) | ((uint32_t)(ulIndex) << 8) \
+                       | ((uint32_t)(ucFilter) << 1) | 1U))
+#define azureiotmqttTOKEN_GENERATION(pvToken) ((uint8_t)((uintptr_t)(pvToken) >> 16))
+#define azureiotmqttTOKEN_INDEX(pvToken)      ((uint32_t)(((uintptr_t)(pvToken) >> 8) & 0xFFU))
+#define azureiotmqttTOKEN_FILTER(pvToken)     ((uint8_t)(((uintptr_t)(pvToken) >> 1) & 0x7FU))
 
-#define USERNAME "username"
-#define PASSWORD "password"
-
-/******************************************************
- *               Variable Definitions
- ******************************************************/
-
-sl_mqtt_client_credentials_t *client_credentails = NULL;
-
-sl_mqtt_client_configuration_t mqtt_client_configuration = { .is_clean_session = IS_CLEAN_SESSION,
-                                                             .client_id        = (uint8_t *)CLIENT_ID,
-                                                             .client_id_length = strlen(CLIENT_ID),
-                                                             .client_port      = CLIENT_PORT };
-
-sl_mqtt_broker_t mqtt_broker_configuration = {
-  .port                    = MQTT_BROKER_PORT,
-  .is_connection_encrypted = ENCRYPT_CONNECTION,
-  .connect_timeout         = MQTT_CONNECT_TIMEOUT,
-  .keep_alive_interval     = KEEP_ALIVE_INTERVAL,
-  .keep_alive_retries      = MQTT_KEEPALIVE_RETRIES,
-};
-
-sl_mqtt_client_message_t message_to_be_published = {
-  .qos_level            = QOS_OF_PUBLISH_MESSAGE,
-  .is_retained          = IS_MESSAGE_RETAINED,
-  .is_duplicate_message = IS_DUPLICATE_MESSAGE,
-  .topic                = (uint8_t *)PUBLISH_TOPIC,
-  .topic_length         = strlen(PUBLISH_TOPIC),
-  .content              = (uint8_t *)PUBLISH_MESSAGE,
-  .content_length       = strlen(PUBLISH_MESSAGE),
-};
-
-sl_mqtt_client_last_will_message_t last_will_message = {
-  .is_retained         = IS_LAST_WILL_RETAINED,
-  .will_qos_level      = QOS_OF_LAST_WILL,
-  .will_topic          = (uint8_t *)LAST_WILL_TOPIC,
-  .will_topic_length   = strlen(LAST_WILL_TOPIC),
-  .will_message        = (uint8_t *)LAST_WILL_MESSAGE,
-  .will_message_length = strlen(LAST_WILL_MESSAGE),
-};
 /**
- * Maps CoreMQTT errors to AzureIoTMQTT errors.
+ * Maps SL status codes to AzureIoTMQTT errors.
  **/
-static AzureIoTMQTTResult_t prvTranslateToAzureIoTMQTTResult(MQTTStatus_t xResult)
+static AzureIoTMQTTResult_t prvTranslateToAzureIoTMQTTResult(sl_status_t xStatus)
 {
   AzureIoTMQTTResult_t xReturn;
 
-  switch (xResult) {
-    case MQTTSuccess:
+  switch (xStatus) {
+    case SL_STATUS_OK:
+    case SL_STATUS_IN_PROGRESS:
       xReturn = eAzureIoTMQTTSuccess;
       break;
 
-    case MQTTBadParameter:
+    case SL_STATUS_INVALID_PARAMETER:
+    case SL_STATUS_NULL_POINTER:
       xReturn = eAzureIoTMQTTBadParameter;
       break;
 
-    case MQTTNoMemory:
+    case SL_STATUS_ALLOCATION_FAILED:
+    case SL_STATUS_NO_MORE_RESOURCE:
       xReturn = eAzureIoTMQTTNoMemory;
       break;
 
-    case MQTTSendFailed:
-      xReturn = eAzureIoTMQTTSendFailed;
+    case SL_STATUS_INVALID_STATE:
+    case SL_STATUS_NOT_INITIALIZED:
+      xReturn = eAzureIoTMQTTIllegalState;
       break;
 
-    case MQTTRecvFailed:
-      xReturn = eAzureIoTMQTTRecvFailed;
+    case SL_STATUS_TIMEOUT:
+      xReturn = eAzureIoTMQTTNoDataAvailable;
       break;
 
-    case MQTTBadResponse:
-      xReturn = eAzureIoTMQTTBadResponse;
+    default:
+      xReturn = eAzureIoTMQTTFailed;
       break;
+  }
 
-    case MQTTServerRefused:
-      xReturn = eAzureIoTMQTTServerRefused;
-      break;
+  return xReturn;
+}
 
-    case MQTTNoDataAvailable:
-      xReturn = eAzureIoTMQTTNoDataAvailable;
+/**
+ * Returns the generation of an in-flight entry.
+ **/
+static uint8_t prvGetGeneration(AzureIoTMQTTInFlight_t *pxInFlight)
+{
+  return azureiotmqttSTATE_GENERATION(__atomic_load_n(&pxInFlight->ulState, __ATOMIC_RELAXED));
+}
+
+/**
+ * Claims a free in-flight entry for a request with the given packet identifier.
+ *
+ * Every claim starts a new generation, so completions for an earlier request on the entry no longer match it.
+ **/
+static AzureIoTMQTTInFlight_t *prvReserveInFlight(AzureIoTMQTTHandle_t xContext,
+                                                  uint8_t ucPacketType,
+                                                  uint16_t usPacketId,
+                                                  uint8_t ucFilterCount)
+{
+  for (uint32_t ulIndex = 0; ulIndex < azureiotmqttMAX_IN_FLIGHT; ulIndex++) {
+    AzureIoTMQTTInFlight_t *pxInFlight = &xContext->xInFlight[ulIndex];
+    uint8_t ucFree                     = 0;
+
+    if (__atomic_compare_exchange_n(&pxInFlight->ucPacketType,
+                                    &ucFree,
+                                    ucPacketType,
+                                    false,
+                                    __ATOMIC_ACQUIRE,
+                                    __ATOMIC_RELAXED)) {
+      uint8_t ucGeneration = prvGetGeneration(pxInFlight);
+
+      pxInFlight->xAborted           = false;
+      pxInFlight->ucFilterCount      = ucFilterCount;
+      pxInFlight->usPacketId         = usPacketId;
+      pxInFlight->ucRemainingData[0] = (uint8_t)(usPacketId >> 8);
+      pxInFlight->ucRemainingData[1] = (uint8_t)(usPacketId & 0xFF);
+      memset(&pxInFlight->ucRemainingData[azureiotmqttPACKET_ID_SIZE], 0, azureiotmqttMAX_TOPIC_FILTERS);
+      __atomic_store_n(&pxInFlight->ulState,
+                       azureiotmqttSTATE(ucGeneration + 1, 0, ucFilterCount),
+                       __ATOMIC_RELEASE);
+      return pxInFlight;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * Reports a finished request to the Azure client and frees its entry.
+ *
+ * A publish or unsubscribe that failed is not acknowledged. A failed subscribe
+ * is acknowledged with eMQTTSubAckFailure for the filters the broker refused,
+ * unless the request never reached the NWP completely.
+ **/
+static void prvCompleteInFlight(AzureIoTMQTTHandle_t xContext, AzureIoTMQTTInFlight_t *pxInFlight, uint8_t ucRefused)
+{
+  AzureIoTMQTTPacketInfo_t xPacketInfo             = { 0 };
+  AzureIoTMQTTDeserializedInfo_t xDeserializedInfo = { 0 };
+  bool xFailed                                     = (ucRefused != 0);
+
+  for (uint8_t ucFilter = 0; ucFilter < pxInFlight->ucFilterCount; ucFilter++) {
+    if (ucRefused & (1U << ucFilter)) {
+      pxInFlight->ucRemainingData[azureiotmqttPACKET_ID_SIZE + ucFilter] = eMQTTSubAckFailure;
+    }
+  }
+
+  xPacketInfo.pucRemainingData = pxInFlight->ucRemainingData;
+  xPacketInfo.xRemainingLength = azureiotmqttPACKET_ID_SIZE;
+
+  switch (pxInFlight->ucPacketType) {
+    case azureiotmqttPACKET_TYPE_SUBSCRIBE:
+      xPacketInfo.ucType = azureiotmqttPACKET_TYPE_SUBACK;
+      xPacketInfo.xRemainingLength += pxInFlight->ucFilterCount;
+      xFailed = false;
       break;
 
-    case MQTTIllegalState:
-      xReturn = eAzureIoTMQTTIllegalState;
+    case azureiotmqttPACKET_TYPE_UNSUBSCRIBE:
+      xPacketInfo.ucType = azureiotmqttPACKET_TYPE_UNSUBACK;
       break;
 
-    case MQTTStateCollision:
-      xReturn = eAzureIoTMQTTStateCollision;
+    default:
+      xPacketInfo.ucType = azureiotmqttPACKET_TYPE_PUBACK;
       break;
+  }
+
+  if (!pxInFlight->xAborted && !xFailed && (xContext->xEventCallback != NULL)) {
+    xDeserializedInfo.usPacketIdentifier     = pxInFlight->usPacketId;
+    xDeserializedInfo.xDeserializationResult = eAzureIoTMQTTSuccess;
+    xContext->xEventCallback(xContext, &xPacketInfo, &xDeserializedInfo);
+  }
+
+  __atomic_store_n(&pxInFlight->ucPacketType, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * Returns the SL context for one topic filter of a request.
+ **/
+static void *prvGetToken(AzureIoTMQTTHandle_t xContext, AzureIoTMQTTInFlight_t *pxInFlight, uint8_t ucFilter)
+{
+  return azureiotmqttTOKEN(prvGetGeneration(pxInFlight), (uint32_t)(pxInFlight - xContext->xInFlight), ucFilter);
+}
+
+/**
+ * Counts down the filters of a request that have been answered and completes it after the last one.
+ *
+ * Nothing is counted if the entry has moved on to another generation, for example
+ * because AzureIoTMQTT_Disconnect() dropped the request and the entry was claimed again.
+ **/
+static void prvReleaseFilters(AzureIoTMQTTHandle_t xContext,
+                              AzureIoTMQTTInFlight_t *pxInFlight,
+                              uint8_t ucGeneration,
+                              uint8_t ucRefused,
+                              uint8_t ucCount)
+{
+  uint32_t ulState = __atomic_load_n(&pxInFlight->ulState, __ATOMIC_ACQUIRE);
+  uint32_t ulNext;
+
+  do {
+    if ((azureiotmqttSTATE_GENERATION(ulState) != ucGeneration) || (azureiotmqttSTATE_PENDING(ulState) < ucCount)) {
+      return;
+    }
+    ulNext = azureiotmqttSTATE(ucGeneration,
+                               azureiotmqttSTATE_REFUSED(ulState) | ucRefused,
+                               azureiotmqttSTATE_PENDING(ulState) - ucCount);
+  } while (!__atomic_compare_exchange_n(&pxInFlight->ulState,
+                                        &ulState,
+                                        ulNext,
+                                        false,
+                                        __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE));
+
+  if (azureiotmqttSTATE_PENDING(ulNext) == 0) {
+    prvCompleteInFlight(xContext, pxInFlight, azureiotmqttSTATE_REFUSED(ulNext));
+  }
+}
 
-    case MQTTKeepAliveTimeout:
-      xReturn = eAzureIoTMQTTKeepAliveTimeout;
+/**
+ * Frees an entry whose request is still waiting for completions.
+ *
+ * The entry moves on to the next generation, so completions the SL client reports
+ * for it later are ignored. An entry whose last completion is already being
+ * reported is left to prvCompleteInFlight(), which frees it.
+ **/
+static void prvCancelInFlight(AzureIoTMQTTInFlight_t *pxInFlight)
+{
+  uint32_t ulState = __atomic_load_n(&pxInFlight->ulState, __ATOMIC_ACQUIRE);
+
+  do {
+    if (azureiotmqttSTATE_PENDING(ulState) == 0) {
+      return;
+    }
+  } while (!__atomic_compare_exchange_n(&pxInFlight->ulState,
+                                        &ulState,
+                                        azureiotmqttSTATE(azureiotmqttSTATE_GENERATION(ulState) + 1, 0, 0),
+                                        false,
+                                        __ATOMIC_ACQ_REL,
+                                        __ATOMIC_ACQUIRE));
+
+  __atomic_store_n(&pxInFlight->ucPacketType, 0, __ATOMIC_RELEASE);
+}
+
+static void prvEventHandler(void *pvClient, sl_mqtt_client_event_t xEvent, void *pvEventData, void *pvContext)
+{
+  AzureIoTMQTTHandle_t xContext = (AzureIoTMQTTHandle_t)pvClient;
+  uint8_t ucFilter;
+
+  (void)pvEventData;
+
+  switch (xEvent) {
+    case SL_MQTT_CLIENT_MESSAGE_PUBLISHED_EVENT:
+    case SL_MQTT_CLIENT_SUBSCRIBED_EVENT:
+    case SL_MQTT_CLIENT_UNSUBSCRIBED_EVENT:
+    case SL_MQTT_CLIENT_ERROR_EVENT:
+      if (pvContext == NULL) {
+        /* QoS 0 publish */
+        break;
+      }
+      ucFilter = azureiotmqttTOKEN_FILTER(pvContext);
+      if ((azureiotmqttTOKEN_INDEX(pvContext) >= azureiotmqttMAX_IN_FLIGHT)
+          || (ucFilter >= azureiotmqttMAX_TOPIC_FILTERS)) {
+        break;
+      }
+      prvReleaseFilters(xContext,
+                        &xContext->xInFlight[azureiotmqttTOKEN_INDEX(pvContext)],
+                        azureiotmqttTOKEN_GENERATION(pvContext),
+                        (xEvent == SL_MQTT_CLIENT_ERROR_EVENT) ? (uint8_t)(1U << ucFilter) : 0,
+                        1);
       break;
 
     default:
-      xReturn = eAzureIoTMQTTFailed;
+      /* Connection state is read from the SL client */
       break;
   }
+}
 
-  return xReturn;
+/**
+ * Passes an incoming message to the Azure client without copying it.
+ *
+ * Topic and payload point into the NWP buffer and are valid only during the callback.
+ **/
+static void prvMessageHandler(void *pvClient, sl_mqtt_client_message_t *pxMessage, void *pvContext)
+{
+  AzureIoTMQTTHandle_t xContext                    = (AzureIoTMQTTHandle_t)pvClient;
+  AzureIoTMQTTPublishInfo_t xPublishInfo           = { 0 };
+  AzureIoTMQTTPacketInfo_t xPacketInfo             = { 0 };
+  AzureIoTMQTTDeserializedInfo_t xDeserializedInfo = { 0 };
+
+  (void)pvContext;
+
+  if (xContext->xEventCallback == NULL) {
+    return;
+  }
+
+  xPublishInfo.xQOS              = (AzureIoTMQTTQoS_t)pxMessage->qos_level;
+  xPublishInfo.xRetain           = pxMessage->is_retained;
+  xPublishInfo.xDup              = pxMessage->is_duplicate_message;
+  xPublishInfo.pcTopicName       = pxMessage->topic;
+  xPublishInfo.usTopicNameLength = pxMessage->topic_length;
+  xPublishInfo.pvPayload         = pxMessage->content;
+  xPublishInfo.xPayloadLength    = pxMessage->content_length;
+
+  xPacketInfo.ucType           = azureiotmqttPACKET_TYPE_PUBLISH;
+  xPacketInfo.xRemainingLength = (size_t)pxMessage->topic_length + pxMessage->content_length;
+
+  /* The NWP acknowledges QoS 1 messages itself and does not report their packet identifier */
+  xDeserializedInfo.pxPublishInfo          = &xPublishInfo;
+  xDeserializedInfo.xDeserializationResult = eAzureIoTMQTTSuccess;
+
+  xContext->xEventCallback(xContext, &xPacketInfo, &xDeserializedInfo);
+}
+
+/**
+ * Stores the user name and password of the connection in the NWP credential slot.
+ **/
+static sl_status_t prvSetCredentials(const AzureIoTMQTTConnectInfo_t *pxConnectInfo)
+{
+  sl_mqtt_client_credentials_t *pxCredentials;
+  uint32_t ulSize =
+    sizeof(sl_mqtt_client_credentials_t) + pxConnectInfo->usUserNameLength + pxConnectInfo->usPasswordLength;
+  sl_status_t xStatus;
+
+  pxCredentials = malloc(ulSize);
+  if (pxCredentials == NULL) {
+    return SL_STATUS_ALLOCATION_FAILED;
+  }
+
+  pxCredentials->username_length = pxConnectInfo->usUserNameLength;
+  pxCredentials->password_length = pxConnectInfo->usPasswordLength;
+  if (pxConnectInfo->usUserNameLength > 0) {
+    memcpy(&pxCredentials->data[0], pxConnectInfo->pcUserName, pxConnectInfo->usUserNameLength);
+  }
+  if (pxConnectInfo->usPasswordLength > 0) {
+    memcpy(&pxCredentials->data[pxConnectInfo->usUserNameLength],
+           pxConnectInfo->pcPassword,
+           pxConnectInfo->usPasswordLength);
+  }
+
+  xStatus = sl_net_set_credential(azureiotmqttCREDENTIAL_ID, SL_NET_MQTT_CLIENT_CREDENTIAL, pxCredentials, ulSize);
+  free(pxCredentials);
+
+  return xStatus;
+}
+
+void AzureIoTMQTT_SetBroker(AzureIoTMQTT_t *pxContext,
+                            const sl_mqtt_broker_v2_t *pxBroker,
+                            sl_mqtt_tls_flag_t xTlsFlags)
+{
+  pxContext->xBroker                  = *pxBroker;
+  pxContext->xConfiguration.tls_flags = xTlsFlags;
 }
 
 AzureIoTMQTTResult_t AzureIoTMQTT_Init(AzureIoTMQTTHandle_t xContext,
@@ -157,31 +375,19 @@ AzureIoTMQTTResult_t AzureIoTMQTT_Init(AzureIoTMQTTHandle_t xContext,
                                        uint8_t *pucNetworkBuffer,
                                        size_t xNetworkBufferLength)
 {
-  // MQTTFixedBuffer_t xBuffer = { pucNetworkBuffer, xNetworkBufferLength };
-  // MQTTStatus_t xResult;
-
-  // /* Check memory equivalence, but ordering is not guaranteed */
-  // assert(sizeof(AzureIoTMQTTConnectInfo_t) == sizeof(MQTTConnectInfo_t));
-  // assert(sizeof(AzureIoTMQTTSubscribeInfo_t) == sizeof(MQTTSubscribeInfo_t));
-  // assert(sizeof(AzureIoTMQTTPacketInfo_t) == sizeof(MQTTPacketInfo_t));
-  // assert(sizeof(AzureIoTMQTTPublishInfo_t) == sizeof(MQTTPublishInfo_t));
-  // assert(sizeof(AzureIoTMQTTResult_t) == sizeof(MQTTStatus_t));
-  // assert(sizeof(AzureIoTTransportInterface_t) == sizeof(TransportInterface_t));
-
-  // xResult = MQTT_Init(xContext,
-  //                     (const TransportInterface_t *)pxTransportInterface,
-  //                     (MQTTGetCurrentTimeFunc_t)xGetTimeFunction,
-  //                     (MQTTEventCallback_t)xUserCallback,
-  //                     &xBuffer);
-    ( void ) xContext;
-    ( void ) pxTransportInterface;
-    ( void ) xGetTimeFunction;
-    ( void ) pucNetworkBuffer;
-    ( void ) xNetworkBufferLength;
-
-  sl_status_t status = sl_mqtt_client_init((sl_mqtt_client_t *)xContext, (sl_mqtt_client_event_handler_t) xUserCallback);
-
-  return prvTranslateToAzureIoTMQTTResult(status);
+  (void)pxTransportInterface;
+  (void)xGetTimeFunction;
+  (void)pucNetworkBuffer;
+  (void)xNetworkBufferLength;
+
+  if ((xContext == NULL) || (xUserCallback == NULL)) {
+    return eAzureIoTMQTTBadParameter;
+  }
+
+  memset(xContext, 0, sizeof(*xContext));
+  xContext->xEventCallback = xUserCallback;
+
+  return prvTranslateToAzureIoTMQTTResult(sl_mqtt_client_init(&xContext->xClient, prvEventHandler));
 }
 
 AzureIoTMQTTResult_t AzureIoTMQTT_Connect(AzureIoTMQTTHandle_t xContext,
@@ -190,73 +396,110 @@ AzureIoTMQTTResult_t AzureIoTMQTT_Connect(AzureIoTMQTTHandle_t xContext,
                                           uint32_t ulMilliseconds,
                                           bool *pxSessionPresent)
 {
-  // MQTTStatus_t xResult;
-
-  // xResult = MQTT_Connect(xContext,
-  //                        (const MQTTConnectInfo_t *)pxConnectInfo,
-  //                        (const MQTTPublishInfo_t *)pxWillInfo,
-  //                        ulMilliseconds,
-  //                        pxSessionPresent);
-
-    ( void ) xContext;
-    ( void ) pxConnectInfo;
-    ( void ) pxWillInfo;
-    ( void ) ulMilliseconds;
-    ( void ) pxSessionPresent;
-
-// last_will_message.is_retained = pxWillInfo->xRetain;
-// last_will_message.will_message = pxWillInfo->pvPayload;
-// last_will_message.will_message_length = pxWillInfo->xPayloadLength  ;
-// last_will_message.will_topic = pxWillInfo->pcTopicName ;
-// last_will_message.will_topic_length = pxWillInfo->usTopicNameLength;
-// last_will_message.will_qos_level = pxWillInfo->xQOS;
-
-sl_status_t status;
-  status = sl_net_inet_addr(MQTT_BROKER_IP, &mqtt_broker_configuration.ip.ip.v4.value);
-  if (status != SL_STATUS_OK) {
-    printf("Failed to convert IP address \r\n");
-
-    //mqtt_client_cleanup();
-    return status;
+  sl_status_t xStatus;
+
+  /* Last Will and Testament is not used with Azure IoT Hub */
+  (void)pxWillInfo;
+
+  if ((xContext == NULL) || (pxConnectInfo == NULL) || (pxConnectInfo->pcClientIdentifier == NULL)
+      || (pxConnectInfo->usClientIdentifierLength == 0) || (pxConnectInfo->usClientIdentifierLength > UINT8_MAX)) {
+    return eAzureIoTMQTTBadParameter;
   }
- status = sl_mqtt_client_connect((sl_mqtt_client_t *)xContext,
-                                   (const sl_mqtt_broker_t *)&mqtt_broker_configuration,
-                                   (const sl_mqtt_client_last_will_message_t *)&last_will_message,
-                                   (const sl_mqtt_client_configuration_t *)&mqtt_client_configuration,
-                                   (uint32_t)ulMilliseconds);
-  return prvTranslateToAzureIoTMQTTResult(status);
-}
 
-void print_char_buffer(char *buffer, uint32_t buffer_length)
-{
-  for (uint32_t index = 0; index < buffer_length; index++) {
-    printf("%c", buffer[index]);
+  if (xContext->xBroker.port == 0) {
+    /* AzureIoTMQTT_SetBroker() was not called */
+    return eAzureIoTMQTTIllegalState;
   }
 
-  printf("\r\n");
+  xContext->xBroker.keep_alive_interval    = pxConnectInfo->usKeepAliveSeconds;
+  xContext->xConfiguration.is_clean_session = pxConnectInfo->xCleanSession;
+  xContext->xConfiguration.client_id        = (uint8_t *)pxConnectInfo->pcClientIdentifier;
+  xContext->xConfiguration.client_id_length = (uint8_t)pxConnectInfo->usClientIdentifierLength;
+  xContext->xConfiguration.credential_id    = 0;
+
+  if ((pxConnectInfo->usUserNameLength > 0) || (pxConnectInfo->usPasswordLength > 0)) {
+    xStatus = prvSetCredentials(pxConnectInfo);
+    if (xStatus != SL_STATUS_OK) {
+      return prvTranslateToAzureIoTMQTTResult(xStatus);
+    }
+    xContext->xConfiguration.credential_id = azureiotmqttCREDENTIAL_ID;
+  }
+
+  xStatus = sl_mqtt_client_connect_v2(&xContext->xClient,
+                                      &xContext->xBroker,
+                                      NULL,
+                                      &xContext->xConfiguration,
+                                      ulMilliseconds);
+
+  if (pxSessionPresent != NULL) {
+    /* The NWP does not report the session present flag of the CONNACK */
+    *pxSessionPresent = false;
+  }
+
+  return prvTranslateToAzureIoTMQTTResult(xStatus);
 }
 
-void mqtt_client_message_handler(void *client, sl_mqtt_client_message_t *message, void *context)
+/**
+ * Sends one SL request per topic filter for a subscribe or unsubscribe.
+ **/
+static AzureIoTMQTTResult_t prvSendTopicFilters(AzureIoTMQTTHandle_t xContext,
+                                                uint8_t ucPacketType,
+                                                const AzureIoTMQTTSubscribeInfo_t *pxSubscriptionList,
+                                                size_t xSubscriptionCount,
+                                                uint16_t usPacketId)
 {
-  (void)context;
-  sl_status_t status;
-  printf("Message Received on Topic: ");
-
-  print_char_buffer((char *)message->topic, message->topic_length);
-  print_char_buffer((char *)message->content, message->content_length);
-
-  // Unsubscribing to already subscribed topic.
-  status = sl_mqtt_client_unsubscribe(client,
-                                      (uint8_t *)TOPIC_TO_BE_SUBSCRIBED,
-                                      strlen(TOPIC_TO_BE_SUBSCRIBED),
-                                      0,
-                                      TOPIC_TO_BE_SUBSCRIBED);
-  if (status != SL_STATUS_IN_PROGRESS) {
-    printf("Failed to unsubscribe : 0x%lx\r\n", status);
-
-    //mqtt_client_cleanup();
-    return;
+  AzureIoTMQTTInFlight_t *pxInFlight;
+  sl_status_t xStatus = SL_STATUS_OK;
+  uint8_t ucSent;
+
+  if ((xContext == NULL) || (pxSubscriptionList == NULL) || (xSubscriptionCount == 0)
+      || (xSubscriptionCount > azureiotmqttMAX_TOPIC_FILTERS)) {
+    return eAzureIoTMQTTBadParameter;
+  }
+
+  pxInFlight = prvReserveInFlight(xContext, ucPacketType, usPacketId, (uint8_t)xSubscriptionCount);
+  if (pxInFlight == NULL) {
+    return eAzureIoTMQTTNoMemory;
+  }
+
+  for (ucSent = 0; ucSent < xSubscriptionCount; ucSent++) {
+    const AzureIoTMQTTSubscribeInfo_t *pxSubscription = &pxSubscriptionList[ucSent];
+
+    if (ucPacketType == azureiotmqttPACKET_TYPE_SUBSCRIBE) {
+      /* Granted QoS reported in the SUBACK unless the NWP reports a failure */
+      pxInFlight->ucRemainingData[azureiotmqttPACKET_ID_SIZE + ucSent] = (uint8_t)pxSubscription->xQoS;
+      xStatus = sl_mqtt_client_subscribe(&xContext->xClient,
+                                         pxSubscription->pcTopicFilter,
+                                         pxSubscription->usTopicFilterLength,
+                                         (sl_mqtt_qos_t)pxSubscription->xQoS,
+                                         0,
+                                         prvMessageHandler,
+                                         prvGetToken(xContext, pxInFlight, ucSent));
+    } else {
+      xStatus = sl_mqtt_client_unsubscribe(&xContext->xClient,
+                                           pxSubscription->pcTopicFilter,
+                                           pxSubscription->usTopicFilterLength,
+                                           0,
+                                           prvGetToken(xContext, pxInFlight, ucSent));
+    }
+
+    if (xStatus != SL_STATUS_IN_PROGRESS) {
+      break;
+    }
+  }
+
+  if (ucSent < xSubscriptionCount) {
+    /* The filters already sent still complete; the entry is freed silently after the last one */
+    pxInFlight->xAborted = true;
+    prvReleaseFilters(xContext,
+                      pxInFlight,
+                      prvGetGeneration(pxInFlight),
+                      0,
+                      (uint8_t)(xSubscriptionCount - ucSent));
+    return prvTranslateToAzureIoTMQTTResult((xStatus == SL_STATUS_OK) ? SL_STATUS_FAIL : xStatus);
   }
+
+  return eAzureIoTMQTTSuccess;
 }
 
 AzureIoTMQTTResult_t AzureIoTMQTT_Subscribe(AzureIoTMQTTHandle_t xContext,
@@ -264,60 +507,69 @@ AzureIoTMQTTResult_t AzureIoTMQTT_Subscribe(AzureIoTMQTTHandle_t xContext,
                                             size_t xSubscriptionCount,
                                             uint16_t usPacketId)
 {
-  // MQTTStatus_t xResult;
-
-  // xResult = MQTT_Subscribe(xContext, (const MQTTSubscribeInfo_t *)pxSubscriptionList, xSubscriptionCount, usPacketId);
-    ( void ) xContext;
-    ( void ) pxSubscriptionList;
-    ( void ) xSubscriptionCount;
-    ( void ) usPacketId;
-
-    sl_status_t status = sl_mqtt_client_subscribe((sl_mqtt_client_t *)xContext,
-                                     (const uint8_t *)pxSubscriptionList->pcTopicFilter,
-                                     (uint16_t) pxSubscriptionList->usTopicFilterLength,
-                                     (sl_mqtt_qos_t) pxSubscriptionList->xQoS,
-                                     (uint32_t) 0, // timeout,
-                                     (sl_mqtt_client_message_received_t) mqtt_client_message_handler,
-                                     (void *)pxSubscriptionList->pcTopicFilter);
-
-  return prvTranslateToAzureIoTMQTTResult(MQTTSuccess);
+  return prvSendTopicFilters(xContext,
+                             azureiotmqttPACKET_TYPE_SUBSCRIBE,
+                             pxSubscriptionList,
+                             xSubscriptionCount,
+                             usPacketId);
 }
 
 AzureIoTMQTTResult_t AzureIoTMQTT_Publish(AzureIoTMQTTHandle_t xContext,
                                           const AzureIoTMQTTPublishInfo_t *pxPublishInfo,
                                           uint16_t usPacketId)
 {
-  // MQTTStatus_t xResult;
-
-  // xResult = MQTT_Publish(xContext, (const MQTTPublishInfo_t *)pxPublishInfo, usPacketId);
+  AzureIoTMQTTInFlight_t *pxInFlight = NULL;
+  sl_mqtt_client_message_t xMessage  = { 0 };
+  sl_status_t xStatus;
 
-    ( void ) xContext;
-    ( void ) pxPublishInfo;
-    ( void ) usPacketId;
-    // message_to_be_published.is_retained = pxPublishInfo->xRetain;
-    // message_to_be_published.is_duplicate_message = pxPublishInfo->xDup;
-    // message_to_be_published.qos_level = pxPublishInfo->xQOS;
-    // message_to_be_published.content_length = pxPublishInfo->xPayloadLength;
-    // message_to_be_published.content = pxPublishInfo->pvPayload;
-    // message_to_be_published.topic = pxPublishInfo->pcTopicName;
-    // message_to_be_published.topic_length = pxPublishInfo->usTopicNameLength;
+  if ((xContext == NULL) || (pxPublishInfo == NULL) || (pxPublishInfo->pcTopicName == NULL)
+      || (pxPublishInfo->xQOS > eAzureIoTMQTTQoS1)) {
+    return eAzureIoTMQTTBadParameter;
+  }
 
-   sl_status_t status = sl_mqtt_client_publish((sl_mqtt_client_t *)xContext,
-                                   (const sl_mqtt_client_message_t *)&message_to_be_published,
-                                   0,  //(uint32_t) timeout,
-                                   (void *)&message_to_be_published);
+  /* QoS 1 publishes wait in the in-flight table for their PUBACK, QoS 0 publishes are not tracked */
+  if (pxPublishInfo->xQOS == eAzureIoTMQTTQoS1) {
+    pxInFlight = prvReserveInFlight(xContext, azureiotmqttPACKET_TYPE_PUBLISH, usPacketId, 1);
+    if (pxInFlight == NULL) {
+      return eAzureIoTMQTTNoMemory;
+    }
+  }
 
+  xMessage.qos_level            = (sl_mqtt_qos_t)pxPublishInfo->xQOS;
+  xMessage.packet_identifier    = usPacketId;
+  xMessage.is_retained          = pxPublishInfo->xRetain;
+  xMessage.is_duplicate_message = pxPublishInfo->xDup;
+  xMessage.topic                = (uint8_t *)pxPublishInfo->pcTopicName;
+  xMessage.topic_length         = pxPublishInfo->usTopicNameLength;
+  xMessage.content              = (uint8_t *)pxPublishInfo->pvPayload;
+  xMessage.content_length       = (uint32_t)pxPublishInfo->xPayloadLength;
+
+  /* The SL client copies topic and payload into the request, so the caller may reuse them on return */
+  xStatus = sl_mqtt_client_publish(&xContext->xClient,
+                                   &xMessage,
+                                   0,
+                                   (pxInFlight != NULL) ? prvGetToken(xContext, pxInFlight, 0) : NULL);
+
+  if (xStatus != SL_STATUS_IN_PROGRESS) {
+    if (pxInFlight != NULL) {
+      pxInFlight->xAborted = true;
+      prvReleaseFilters(xContext,
+                        pxInFlight,
+                        prvGetGeneration(pxInFlight),
+                        0,
+                        1);
+    }
+    return prvTranslateToAzureIoTMQTTResult((xStatus == SL_STATUS_OK) ? SL_STATUS_FAIL : xStatus);
+  }
 
-  return prvTranslateToAzureIoTMQTTResult(MQTTSuccess);
+  return eAzureIoTMQTTSuccess;
 }
 
 AzureIoTMQTTResult_t AzureIoTMQTT_Ping(AzureIoTMQTTHandle_t xContext)
 {
-  // MQTTStatus_t xResult;
-
-  // xResult = MQTT_Ping(xContext);
-    ( void ) xContext;
-  return prvTranslateToAzureIoTMQTTResult(MQTTSuccess);
+  /* The NWP sends PINGREQ on its own, see keep_alive_interval of the broker */
+  (void)xContext;
+  return eAzureIoTMQTTSuccess;
 }
 
 AzureIoTMQTTResult_t AzureIoTMQTT_Unsubscribe(AzureIoTMQTTHandle_t xContext,
@@ -325,58 +577,83 @@ AzureIoTMQTTResult_t AzureIoTMQTT_Unsubscribe(AzureIoTMQTTHandle_t xContext,
                                               size_t xSubscriptionCount,
                                               uint16_t usPacketId)
 {
-  // MQTTStatus_t xResult;
-
-  // xResult = MQTT_Unsubscribe(xContext, (const MQTTSubscribeInfo_t *)pxSubscriptionList, xSubscriptionCount, usPacketId);
-    ( void ) xContext;
-    ( void ) pxSubscriptionList;
-    ( void ) xSubscriptionCount;
-    ( void ) usPacketId;
-  
-   sl_status_t status = sl_mqtt_client_subscribe((sl_mqtt_client_t *)xContext,
-                                     (const uint8_t *)pxSubscriptionList->pcTopicFilter,
-                                     (uint16_t) pxSubscriptionList->usTopicFilterLength,
-                                     (sl_mqtt_qos_t) pxSubscriptionList->xQoS,
-                                     (uint32_t) 0, // timeout,
-                                     (sl_mqtt_client_message_received_t) mqtt_client_message_handler,
-                                     (void *)pxSubscriptionList->pcTopicFilter);
-  return prvTranslateToAzureIoTMQTTResult(MQTTSuccess);
+  return prvSendTopicFilters(xContext,
+                             azureiotmqttPACKET_TYPE_UNSUBSCRIBE,
+                             pxSubscriptionList,
+                             xSubscriptionCount,
+                             usPacketId);
 }
 
 AzureIoTMQTTResult_t AzureIoTMQTT_Disconnect(AzureIoTMQTTHandle_t xContext)
 {
-  // MQTTStatus_t xResult;
+  sl_status_t xStatus;
+
+  if (xContext == NULL) {
+    return eAzureIoTMQTTBadParameter;
+  }
 
-  // xResult = MQTT_Disconnect(xContext);
-    ( void ) xContext;
-  return prvTranslateToAzureIoTMQTTResult(MQTTSuccess);
+  xStatus = sl_mqtt_client_disconnect(&xContext->xClient, azureiotmqttDISCONNECT_TIMEOUT_MS);
+
+  /* Requests still in flight are never acknowledged once the session is gone */
+  for (uint32_t ulIndex = 0; ulIndex < azureiotmqttMAX_IN_FLIGHT; ulIndex++) {
+    prvCancelInFlight(&xContext->xInFlight[ulIndex]);
+  }
+
+  return prvTranslateToAzureIoTMQTTResult(xStatus);
 }
 
 AzureIoTMQTTResult_t AzureIoTMQTT_ProcessLoop(AzureIoTMQTTHandle_t xContext, uint32_t ulMilliseconds)
 {
-  // MQTTStatus_t xResult;
+  if (xContext == NULL) {
+    return eAzureIoTMQTTBadParameter;
+  }
 
-  // xResult = MQTT_ProcessLoop(xContext, ulMilliseconds);
-   ( void ) xContext;
-    ( void ) ulMilliseconds;
-  return prvTranslateToAzureIoTMQTTResult(MQTTSuccess);
+  /* Packets are dispatched by the SL event handler, so there is nothing to receive here */
+  if (ulMilliseconds > 0) {
+    osDelay(SLI_SYSTEM_MS_TO_TICKS(ulMilliseconds));
+  }
+
+  return (xContext->xClient.state == SL_MQTT_CLIENT_CONNECTED) ? eAzureIoTMQTTSuccess : eAzureIoTMQTTRecvFailed;
 }
 
 uint16_t AzureIoTMQTT_GetPacketId(AzureIoTMQTTHandle_t xContext)
 {
-    ( void ) xContext;
-  return MQTT_GetPacketId(MQTTSuccess);
+  uint16_t usPacketId;
+  bool xInUse;
+
+  /* Non-zero and not used by a request still waiting for its acknowledgement */
+  do {
+    usPacketId = ++xContext->usNextPacketId;
+    if (usPacketId == 0) {
+      usPacketId = ++xContext->usNextPacketId;
+    }
+
+    xInUse = false;
+    for (uint32_t ulIndex = 0; ulIndex < azureiotmqttMAX_IN_FLIGHT; ulIndex++) {
+      if ((__atomic_load_n(&xContext->xInFlight[ulIndex].ucPacketType, __ATOMIC_ACQUIRE) != 0)
+          && (xContext->xInFlight[ulIndex].usPacketId == usPacketId)) {
+        xInUse = true;
+        break;
+      }
+    }
+  } while (xInUse);
+
+  return usPacketId;
 }
 
 AzureIoTMQTTResult_t AzureIoTMQTT_GetSubAckStatusCodes(const AzureIoTMQTTPacketInfo_t *pxSubackPacket,
                                                        uint8_t **ppucPayloadStart,
                                                        size_t *pxPayloadSize)
 {
-  // MQTTStatus_t xResult;
+  if ((pxSubackPacket == NULL) || (ppucPayloadStart == NULL) || (pxPayloadSize == NULL)
+      || (azureiotmqttGET_PACKET_TYPE(pxSubackPacket->ucType) != azureiotmqttPACKET_TYPE_SUBACK)
+      || (pxSubackPacket->pucRemainingData == NULL)
+      || (pxSubackPacket->xRemainingLength <= azureiotmqttPACKET_ID_SIZE)) {
+    return eAzureIoTMQTTBadParameter;
+  }
+
+  *ppucPayloadStart = &pxSubackPacket->pucRemainingData[azureiotmqttPACKET_ID_SIZE];
+  *pxPayloadSize    = pxSubackPacket->xRemainingLength - azureiotmqttPACKET_ID_SIZE;
 
-  // xResult = MQTT_GetSubAckStatusCodes((const MQTTPacketInfo_t *)pxSubackPacket, ppucPayloadStart, pxPayloadSize);
-  ( void ) pxSubackPacket;
-  ( void ) ppucPayloadStart;
-  ( void ) pxPayloadSize;
-  return prvTranslateToAzureIoTMQTTResult(MQTTSuccess);
+  return eAzureIoTMQTTSuccess;
 }
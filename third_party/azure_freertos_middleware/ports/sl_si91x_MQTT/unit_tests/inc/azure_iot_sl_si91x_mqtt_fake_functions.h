@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#pragma once
+#include "fff.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include "sl_status.h"
+#include "sl_net.h"
+#include "sl_mqtt_client.h"
+#include "azure_iot_mqtt.h"
+
+DECLARE_FAKE_VALUE_FUNC0(uint32_t, osKernelGetTickFreq);
+DECLARE_FAKE_VALUE_FUNC1(osStatus_t, osDelay, uint32_t);
+DECLARE_FAKE_VALUE_FUNC4(sl_status_t, sl_net_set_credential, sl_net_credential_id_t, sl_net_credential_type_t, const void *, uint32_t);
+
+// SL MQTT client functions
+DECLARE_FAKE_VALUE_FUNC2(sl_status_t, sl_mqtt_client_init, sl_mqtt_client_t *, sl_mqtt_client_event_handler_t);
+DECLARE_FAKE_VALUE_FUNC5(sl_status_t,
+                         sl_mqtt_client_connect_v2,
+                         sl_mqtt_client_t *,
+                         const sl_mqtt_broker_v2_t *,
+                         const sl_mqtt_client_last_will_message_t *,
+                         const sl_mqtt_client_configuration_t *,
+                         uint32_t);
+DECLARE_FAKE_VALUE_FUNC2(sl_status_t, sl_mqtt_client_disconnect, sl_mqtt_client_t *, uint32_t);
+DECLARE_FAKE_VALUE_FUNC4(sl_status_t,
+                         sl_mqtt_client_publish,
+                         sl_mqtt_client_t *,
+                         const sl_mqtt_client_message_t *,
+                         uint32_t,
+                         void *);
+DECLARE_FAKE_VALUE_FUNC7(sl_status_t,
+                         sl_mqtt_client_subscribe,
+                         sl_mqtt_client_t *,
+                         const uint8_t *,
+                         uint16_t,
+                         sl_mqtt_qos_t,
+                         uint32_t,
+                         sl_mqtt_client_message_received_t,
+                         void *);
+DECLARE_FAKE_VALUE_FUNC5(sl_status_t,
+                         sl_mqtt_client_unsubscribe,
+                         sl_mqtt_client_t *,
+                         const uint8_t *,
+                         uint16_t,
+                         uint32_t,
+                         void *);
@@ -0,0 +1,580 @@
+/*******************************************************************************
+ * @file
+ * @brief
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2025 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <vector>
+extern "C" {
+#include "azure_iot_sl_si91x_mqtt_fake_functions.h"
+}
+
+namespace {
+
+// Completion the fake broker reports through the SL event handler
+struct FakeCompletion {
+  sl_mqtt_client_event_t event;
+  void *context;
+};
+
+// Packet the port reported to the Azure callback
+struct ReceivedPacket {
+  uint8_t type;
+  uint16_t packet_id;
+  std::vector<uint8_t> status_codes;
+  const void *topic;
+  const void *payload;
+  size_t payload_length;
+};
+
+sl_mqtt_client_event_handler_t broker_event_handler;
+sl_mqtt_client_message_received_t broker_message_handler;
+std::deque<FakeCompletion> broker_completions;
+std::vector<ReceivedPacket> received_packets;
+uint32_t received_publishes;
+
+sl_status_t fake_init(sl_mqtt_client_t *client, sl_mqtt_client_event_handler_t handler)
+{
+  client->client_event_handler = handler;
+  broker_event_handler         = handler;
+  return SL_STATUS_OK;
+}
+
+sl_status_t fake_connect(sl_mqtt_client_t *client,
+                         const sl_mqtt_broker_v2_t *broker,
+                         const sl_mqtt_client_last_will_message_t *last_will,
+                         const sl_mqtt_client_configuration_t *configuration,
+                         uint32_t timeout)
+{
+  (void)broker;
+  (void)last_will;
+  (void)configuration;
+  (void)timeout;
+  client->state = SL_MQTT_CLIENT_CONNECTED;
+  return SL_STATUS_OK;
+}
+
+sl_status_t fake_publish(sl_mqtt_client_t *client,
+                         const sl_mqtt_client_message_t *message,
+                         uint32_t timeout,
+                         void *context)
+{
+  (void)client;
+  (void)message;
+  (void)timeout;
+  broker_completions.push_back({ SL_MQTT_CLIENT_MESSAGE_PUBLISHED_EVENT, context });
+  return SL_STATUS_IN_PROGRESS;
+}
+
+sl_status_t fake_subscribe(sl_mqtt_client_t *client,
+                           const uint8_t *topic,
+                           uint16_t topic_length,
+                           sl_mqtt_qos_t qos,
+                           uint32_t timeout,
+                           sl_mqtt_client_message_received_t handler,
+                           void *context)
+{
+  (void)client;
+  (void)topic;
+  (void)topic_length;
+  (void)qos;
+  (void)timeout;
+  broker_message_handler = handler;
+  broker_completions.push_back({ SL_MQTT_CLIENT_SUBSCRIBED_EVENT, context });
+  return SL_STATUS_IN_PROGRESS;
+}
+
+sl_status_t fake_unsubscribe(sl_mqtt_client_t *client,
+                             const uint8_t *topic,
+                             uint16_t topic_length,
+                             uint32_t timeout,
+                             void *context)
+{
+  (void)client;
+  (void)topic;
+  (void)topic_length;
+  (void)timeout;
+  broker_completions.push_back({ SL_MQTT_CLIENT_UNSUBSCRIBED_EVENT, context });
+  return SL_STATUS_IN_PROGRESS;
+}
+
+void azure_event_callback(AzureIoTMQTTHandle_t context,
+                          AzureIoTMQTTPacketInfo_t *packet_info,
+                          AzureIoTMQTTDeserializedInfo_t *deserialized_info)
+{
+  ReceivedPacket packet = {};
+  uint8_t *codes        = nullptr;
+  size_t code_count     = 0;
+
+  (void)context;
+  packet.type      = azureiotmqttGET_PACKET_TYPE(packet_info->ucType);
+  packet.packet_id = deserialized_info->usPacketIdentifier;
+  if (packet.type == azureiotmqttPACKET_TYPE_PUBLISH) {
+    // The benchmark delivers many messages, only count them
+    received_publishes++;
+    if (received_publishes > 1) {
+      return;
+    }
+    packet.topic          = deserialized_info->pxPublishInfo->pcTopicName;
+    packet.payload        = deserialized_info->pxPublishInfo->pvPayload;
+    packet.payload_length = deserialized_info->pxPublishInfo->xPayloadLength;
+  } else if (packet.type == azureiotmqttPACKET_TYPE_SUBACK
+             && AzureIoTMQTT_GetSubAckStatusCodes(packet_info, &codes, &code_count) == eAzureIoTMQTTSuccess) {
+    packet.status_codes.assign(codes, codes + code_count);
+  }
+  received_packets.push_back(packet);
+}
+
+} // namespace
+
+class AzureIoTSlSi91xMqtt : public ::testing::Test {
+protected:
+  AzureIoTMQTT_t context;
+
+  void SetUp() override
+  {
+    RESET_FAKE(osKernelGetTickFreq);
+    RESET_FAKE(osDelay);
+    RESET_FAKE(sl_net_set_credential);
+    RESET_FAKE(sl_mqtt_client_init);
+    RESET_FAKE(sl_mqtt_client_connect_v2);
+    RESET_FAKE(sl_mqtt_client_disconnect);
+    RESET_FAKE(sl_mqtt_client_publish);
+    RESET_FAKE(sl_mqtt_client_subscribe);
+    RESET_FAKE(sl_mqtt_client_unsubscribe);
+    FFF_RESET_HISTORY();
+
+    broker_event_handler   = nullptr;
+    broker_message_handler = nullptr;
+    broker_completions.clear();
+    received_packets.clear();
+    received_publishes = 0;
+
+    osKernelGetTickFreq_fake.return_val         = 1000;
+    sl_mqtt_client_init_fake.custom_fake        = fake_init;
+    sl_mqtt_client_connect_v2_fake.custom_fake  = fake_connect;
+    sl_mqtt_client_publish_fake.custom_fake     = fake_publish;
+    sl_mqtt_client_subscribe_fake.custom_fake   = fake_subscribe;
+    sl_mqtt_client_unsubscribe_fake.custom_fake = fake_unsubscribe;
+
+    ASSERT_EQ(AzureIoTMQTT_Init(&context, nullptr, nullptr, azure_event_callback, nullptr, 0), eAzureIoTMQTTSuccess);
+  }
+
+  void connect()
+  {
+    sl_mqtt_broker_v2_t broker             = {};
+    AzureIoTMQTTConnectInfo_t connect_info = {};
+    static const uint8_t client_id[]       = "device-1";
+
+    broker.port = 8883;
+    AzureIoTMQTT_SetBroker(&context, &broker, SL_MQTT_TLS_ENABLE);
+    connect_info.pcClientIdentifier       = client_id;
+    connect_info.usClientIdentifierLength = sizeof(client_id) - 1;
+    connect_info.usKeepAliveSeconds       = 60;
+    ASSERT_EQ(AzureIoTMQTT_Connect(&context, &connect_info, nullptr, 1000, nullptr), eAzureIoTMQTTSuccess);
+  }
+
+  // Report every queued completion, a failure for the completion at fail_index
+  void complete_all(size_t fail_index = SIZE_MAX)
+  {
+    sl_mqtt_client_error_status_t error = SL_MQTT_CLIENT_UNKNOWN_ERROR;
+    size_t index                        = 0;
+
+    while (!broker_completions.empty()) {
+      FakeCompletion completion = broker_completions.front();
+      broker_completions.pop_front();
+      if (index++ == fail_index) {
+        broker_event_handler(&context.xClient, SL_MQTT_CLIENT_ERROR_EVENT, &error, completion.context);
+      } else {
+        broker_event_handler(&context.xClient, completion.event, nullptr, completion.context);
+      }
+    }
+  }
+
+  AzureIoTMQTTResult_t publish(AzureIoTMQTTQoS_t qos, uint16_t packet_id)
+  {
+    static const uint8_t topic[]   = "devices/device-1/messages/events/";
+    static const char payload[]    = "{\"temperature\":21.5}";
+    AzureIoTMQTTPublishInfo_t info = {};
+
+    info.xQOS              = qos;
+    info.pcTopicName       = topic;
+    info.usTopicNameLength = sizeof(topic) - 1;
+    info.pvPayload         = payload;
+    info.xPayloadLength    = sizeof(payload) - 1;
+    return AzureIoTMQTT_Publish(&context, &info, packet_id);
+  }
+};
+
+TEST_F(AzureIoTSlSi91xMqtt, InitRegistersPortEventHandler)
+{
+  EXPECT_EQ(sl_mqtt_client_init_fake.call_count, 1u);
+  EXPECT_EQ(sl_mqtt_client_init_fake.arg0_val, &context.xClient);
+  EXPECT_NE(broker_event_handler, nullptr);
+  EXPECT_EQ(AzureIoTMQTT_Init(&context, nullptr, nullptr, nullptr, nullptr, 0), eAzureIoTMQTTBadParameter);
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, ConnectWithoutBrokerFails)
+{
+  static const uint8_t client_id[]       = "device-1";
+  AzureIoTMQTTConnectInfo_t connect_info = {};
+
+  connect_info.pcClientIdentifier       = client_id;
+  connect_info.usClientIdentifierLength = sizeof(client_id) - 1;
+  EXPECT_EQ(AzureIoTMQTT_Connect(&context, &connect_info, nullptr, 1000, nullptr), eAzureIoTMQTTIllegalState);
+  EXPECT_EQ(sl_mqtt_client_connect_v2_fake.call_count, 0u);
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, ConnectPassesSessionAndCredentials)
+{
+  static const uint8_t client_id[]       = "device-1";
+  static const uint8_t user_name[]       = "hub.azure-devices.net/device-1/?api-version=2020-09-30";
+  static const uint8_t password[]        = "SharedAccessSignature sr=hub";
+  sl_mqtt_broker_v2_t broker             = {};
+  AzureIoTMQTTConnectInfo_t connect_info = {};
+  bool session_present                   = true;
+
+  broker.port = 8883;
+  AzureIoTMQTT_SetBroker(&context, &broker, SL_MQTT_TLS_ENABLE);
+  connect_info.xCleanSession            = true;
+  connect_info.usKeepAliveSeconds       = 240;
+  connect_info.pcClientIdentifier       = client_id;
+  connect_info.usClientIdentifierLength = sizeof(client_id) - 1;
+  connect_info.pcUserName               = user_name;
+  connect_info.usUserNameLength         = sizeof(user_name) - 1;
+  connect_info.pcPassword               = password;
+  connect_info.usPasswordLength         = sizeof(password) - 1;
+
+  EXPECT_EQ(AzureIoTMQTT_Connect(&context, &connect_info, nullptr, 1000, &session_present), eAzureIoTMQTTSuccess);
+  EXPECT_FALSE(session_present);
+  EXPECT_EQ(sl_net_set_credential_fake.call_count, 1u);
+  EXPECT_EQ(sl_net_set_credential_fake.arg1_val, SL_NET_MQTT_CLIENT_CREDENTIAL);
+  EXPECT_EQ(sl_net_set_credential_fake.arg3_val,
+            sizeof(sl_mqtt_client_credentials_t) + connect_info.usUserNameLength + connect_info.usPasswordLength);
+  EXPECT_EQ(sl_mqtt_client_connect_v2_fake.arg1_val->keep_alive_interval, 240);
+  EXPECT_EQ(sl_mqtt_client_connect_v2_fake.arg1_val->port, 8883);
+  EXPECT_TRUE(sl_mqtt_client_connect_v2_fake.arg3_val->is_clean_session);
+  EXPECT_EQ(sl_mqtt_client_connect_v2_fake.arg3_val->tls_flags, SL_MQTT_TLS_ENABLE);
+  EXPECT_EQ(sl_mqtt_client_connect_v2_fake.arg3_val->client_id_length, sizeof(client_id) - 1);
+  EXPECT_EQ(sl_mqtt_client_connect_v2_fake.arg3_val->credential_id, SL_NET_MQTT_CLIENT_CREDENTIAL_ID(0));
+  EXPECT_EQ(sl_mqtt_client_connect_v2_fake.arg4_val, 1000u);
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, PacketIdsAreNonZeroAndSkipInFlight)
+{
+  connect();
+  context.usNextPacketId = UINT16_MAX - 1;
+
+  uint16_t first = AzureIoTMQTT_GetPacketId(&context);
+  EXPECT_EQ(first, UINT16_MAX);
+  ASSERT_EQ(publish(eAzureIoTMQTTQoS1, 1), eAzureIoTMQTTSuccess);
+
+  // Wraps past 0, and 1 is still waiting for its PUBACK
+  EXPECT_EQ(AzureIoTMQTT_GetPacketId(&context), 2);
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, SubscribeSendsEveryFilterAndAcknowledgesOnce)
+{
+  static const uint8_t filters[][48] = { "devices/device-1/messages/devicebound/#",
+                                         "$iothub/methods/POST/#",
+                                         "$iothub/twin/res/#" };
+  AzureIoTMQTTSubscribeInfo_t subscriptions[3];
+
+  for (int i = 0; i < 3; i++) {
+    subscriptions[i].xQoS                = (i == 0) ? eAzureIoTMQTTQoS1 : eAzureIoTMQTTQoS0;
+    subscriptions[i].pcTopicFilter       = filters[i];
+    subscriptions[i].usTopicFilterLength = (uint16_t)strlen((const char *)filters[i]);
+  }
+
+  connect();
+  ASSERT_EQ(AzureIoTMQTT_Subscribe(&context, subscriptions, 3, 7), eAzureIoTMQTTSuccess);
+  EXPECT_EQ(sl_mqtt_client_subscribe_fake.call_count, 3u);
+  EXPECT_EQ(sl_mqtt_client_subscribe_fake.arg1_history[2], filters[2]);
+  EXPECT_EQ(sl_mqtt_client_subscribe_fake.arg3_history[0], SL_MQTT_QOS_LEVEL_1);
+
+  // The third filter is refused
+  complete_all(2);
+
+  ASSERT_EQ(received_packets.size(), 1u);
+  EXPECT_EQ(received_packets[0].type, azureiotmqttPACKET_TYPE_SUBACK);
+  EXPECT_EQ(received_packets[0].packet_id, 7);
+  EXPECT_EQ(received_packets[0].status_codes, (std::vector<uint8_t>{ 0x01, 0x00, 0x80 }));
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, SubscribeRejectsTooManyFilters)
+{
+  AzureIoTMQTTSubscribeInfo_t subscriptions[azureiotmqttMAX_TOPIC_FILTERS + 1] = {};
+
+  connect();
+  EXPECT_EQ(AzureIoTMQTT_Subscribe(&context, subscriptions, azureiotmqttMAX_TOPIC_FILTERS + 1, 1),
+            eAzureIoTMQTTBadParameter);
+  EXPECT_EQ(sl_mqtt_client_subscribe_fake.call_count, 0u);
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, SubscribeFailingMidwayIsNotAcknowledged)
+{
+  static const uint8_t filter[]                = "$iothub/twin/res/#";
+  AzureIoTMQTTSubscribeInfo_t subscriptions[2] = {};
+  sl_status_t results[]                        = { SL_STATUS_IN_PROGRESS, SL_STATUS_ALLOCATION_FAILED };
+
+  for (auto &subscription : subscriptions) {
+    subscription.pcTopicFilter       = filter;
+    subscription.usTopicFilterLength = sizeof(filter) - 1;
+  }
+
+  connect();
+  sl_mqtt_client_subscribe_fake.custom_fake = nullptr;
+  SET_RETURN_SEQ(sl_mqtt_client_subscribe, results, 2);
+
+  EXPECT_EQ(AzureIoTMQTT_Subscribe(&context, subscriptions, 2, 3), eAzureIoTMQTTNoMemory);
+  broker_completions.push_back({ SL_MQTT_CLIENT_SUBSCRIBED_EVENT, sl_mqtt_client_subscribe_fake.arg6_history[0] });
+  complete_all();
+  EXPECT_TRUE(received_packets.empty());
+  EXPECT_EQ(context.xInFlight[0].ucPacketType, 0);
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, UnsubscribeAcknowledgesAfterLastFilter)
+{
+  static const uint8_t filter[]                = "$iothub/methods/POST/#";
+  AzureIoTMQTTSubscribeInfo_t subscriptions[2] = {};
+
+  for (auto &subscription : subscriptions) {
+    subscription.pcTopicFilter       = filter;
+    subscription.usTopicFilterLength = sizeof(filter) - 1;
+  }
+
+  connect();
+  ASSERT_EQ(AzureIoTMQTT_Unsubscribe(&context, subscriptions, 2, 9), eAzureIoTMQTTSuccess);
+  EXPECT_EQ(sl_mqtt_client_unsubscribe_fake.call_count, 2u);
+
+  broker_event_handler(&context.xClient, broker_completions[0].event, nullptr, broker_completions[0].context);
+  EXPECT_TRUE(received_packets.empty());
+  broker_event_handler(&context.xClient, broker_completions[1].event, nullptr, broker_completions[1].context);
+
+  ASSERT_EQ(received_packets.size(), 1u);
+  EXPECT_EQ(received_packets[0].type, azureiotmqttPACKET_TYPE_UNSUBACK);
+  EXPECT_EQ(received_packets[0].packet_id, 9);
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, PublishQoS1IsLimitedByInFlightTable)
+{
+  connect();
+  for (uint16_t id = 1; id <= azureiotmqttMAX_IN_FLIGHT; id++) {
+    ASSERT_EQ(publish(eAzureIoTMQTTQoS1, id), eAzureIoTMQTTSuccess);
+  }
+  EXPECT_EQ(publish(eAzureIoTMQTTQoS1, 100), eAzureIoTMQTTNoMemory);
+  EXPECT_EQ(sl_mqtt_client_publish_fake.call_count, (unsigned)azureiotmqttMAX_IN_FLIGHT);
+  EXPECT_EQ(sl_mqtt_client_publish_fake.arg2_val, 0u);
+
+  // One PUBACK frees one entry
+  FakeCompletion completion = broker_completions.front();
+  broker_completions.pop_front();
+  broker_event_handler(&context.xClient, completion.event, nullptr, completion.context);
+  ASSERT_EQ(received_packets.size(), 1u);
+  EXPECT_EQ(received_packets[0].type, azureiotmqttPACKET_TYPE_PUBACK);
+  EXPECT_EQ(received_packets[0].packet_id, 1);
+
+  EXPECT_EQ(publish(eAzureIoTMQTTQoS1, 100), eAzureIoTMQTTSuccess);
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, PublishQoS0IsNotTracked)
+{
+  connect();
+  for (uint16_t i = 0; i < 2 * azureiotmqttMAX_IN_FLIGHT; i++) {
+    ASSERT_EQ(publish(eAzureIoTMQTTQoS0, 0), eAzureIoTMQTTSuccess);
+  }
+  EXPECT_EQ(sl_mqtt_client_publish_fake.arg3_val, nullptr);
+  complete_all();
+  EXPECT_TRUE(received_packets.empty());
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, FailedPublishIsNotAcknowledged)
+{
+  connect();
+  ASSERT_EQ(publish(eAzureIoTMQTTQoS1, 5), eAzureIoTMQTTSuccess);
+  complete_all(0);
+  EXPECT_TRUE(received_packets.empty());
+
+  sl_mqtt_client_publish_fake.custom_fake = nullptr;
+  sl_mqtt_client_publish_fake.return_val  = SL_STATUS_FAIL;
+  EXPECT_EQ(publish(eAzureIoTMQTTQoS1, 6), eAzureIoTMQTTFailed);
+  for (const auto &in_flight : context.xInFlight) {
+    EXPECT_EQ(in_flight.ucPacketType, 0);
+  }
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, IncomingPublishIsPassedWithoutCopy)
+{
+  static const uint8_t filter[]            = "devices/device-1/messages/devicebound/#";
+  AzureIoTMQTTSubscribeInfo_t subscription = {};
+  uint8_t topic[]                          = "devices/device-1/messages/devicebound/%24.to=x";
+  uint8_t payload[]                        = "hello";
+  sl_mqtt_client_message_t message         = {};
+
+  subscription.pcTopicFilter       = filter;
+  subscription.usTopicFilterLength = sizeof(filter) - 1;
+  connect();
+  ASSERT_EQ(AzureIoTMQTT_Subscribe(&context, &subscription, 1, 1), eAzureIoTMQTTSuccess);
+  complete_all();
+  received_packets.clear();
+
+  message.qos_level      = SL_MQTT_QOS_LEVEL_1;
+  message.topic          = topic;
+  message.topic_length   = sizeof(topic) - 1;
+  message.content        = payload;
+  message.content_length = sizeof(payload) - 1;
+  broker_message_handler(&context.xClient, &message, nullptr);
+
+  ASSERT_EQ(received_packets.size(), 1u);
+  EXPECT_EQ(received_packets[0].type, azureiotmqttPACKET_TYPE_PUBLISH);
+  EXPECT_EQ(received_packets[0].topic, topic);
+  EXPECT_EQ(received_packets[0].payload, payload);
+  EXPECT_EQ(received_packets[0].payload_length, sizeof(payload) - 1);
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, DisconnectDropsInFlightRequests)
+{
+  connect();
+  ASSERT_EQ(publish(eAzureIoTMQTTQoS1, 1), eAzureIoTMQTTSuccess);
+  EXPECT_EQ(AzureIoTMQTT_Disconnect(&context), eAzureIoTMQTTSuccess);
+  for (const auto &in_flight : context.xInFlight) {
+    EXPECT_EQ(in_flight.ucPacketType, 0);
+  }
+
+  complete_all();
+  EXPECT_TRUE(received_packets.empty());
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, LateCompletionDoesNotCompleteReusedEntry)
+{
+  connect();
+  ASSERT_EQ(publish(eAzureIoTMQTTQoS1, 1), eAzureIoTMQTTSuccess);
+  EXPECT_EQ(AzureIoTMQTT_Disconnect(&context), eAzureIoTMQTTSuccess);
+  connect();
+  ASSERT_EQ(publish(eAzureIoTMQTTQoS1, 2), eAzureIoTMQTTSuccess);
+  ASSERT_EQ(context.xInFlight[0].usPacketId, 2);
+
+  FakeCompletion late = broker_completions.front();
+  broker_completions.pop_front();
+  broker_event_handler(&context.xClient, late.event, nullptr, late.context);
+  EXPECT_TRUE(received_packets.empty());
+  EXPECT_NE(context.xInFlight[0].ucPacketType, 0);
+
+  complete_all();
+  ASSERT_EQ(received_packets.size(), 1u);
+  EXPECT_EQ(received_packets[0].type, azureiotmqttPACKET_TYPE_PUBACK);
+  EXPECT_EQ(received_packets[0].packet_id, 2);
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, LateErrorDoesNotRefuseReusedEntry)
+{
+  static const uint8_t filter[]            = "$iothub/twin/res/#";
+  AzureIoTMQTTSubscribeInfo_t subscription = {};
+  sl_mqtt_client_error_status_t error      = SL_MQTT_CLIENT_UNKNOWN_ERROR;
+
+  subscription.xQoS                = eAzureIoTMQTTQoS1;
+  subscription.pcTopicFilter       = filter;
+  subscription.usTopicFilterLength = sizeof(filter) - 1;
+
+  connect();
+  ASSERT_EQ(AzureIoTMQTT_Subscribe(&context, &subscription, 1, 1), eAzureIoTMQTTSuccess);
+  EXPECT_EQ(AzureIoTMQTT_Disconnect(&context), eAzureIoTMQTTSuccess);
+  connect();
+  ASSERT_EQ(AzureIoTMQTT_Subscribe(&context, &subscription, 1, 2), eAzureIoTMQTTSuccess);
+
+  FakeCompletion late = broker_completions.front();
+  broker_completions.pop_front();
+  broker_event_handler(&context.xClient, SL_MQTT_CLIENT_ERROR_EVENT, &error, late.context);
+  EXPECT_TRUE(received_packets.empty());
+
+  complete_all();
+  ASSERT_EQ(received_packets.size(), 1u);
+  EXPECT_EQ(received_packets[0].type, azureiotmqttPACKET_TYPE_SUBACK);
+  EXPECT_EQ(received_packets[0].packet_id, 2);
+  EXPECT_EQ(received_packets[0].status_codes, (std::vector<uint8_t>{ 0x01 }));
+}
+
+TEST_F(AzureIoTSlSi91xMqtt, ProcessLoopReportsLostConnection)
+{
+  connect();
+  EXPECT_EQ(AzureIoTMQTT_ProcessLoop(&context, 10), eAzureIoTMQTTSuccess);
+  EXPECT_EQ(osDelay_fake.arg0_val, 10u);
+
+  context.xClient.state = SL_MQTT_CLIENT_DISCONNECTED;
+  EXPECT_EQ(AzureIoTMQTT_ProcessLoop(&context, 10), eAzureIoTMQTTRecvFailed);
+}
+
+// Telemetry through the port against a broker that acknowledges a full window at a time
+TEST_F(AzureIoTSlSi91xMqtt, BenchmarkMessageRate)
+{
+  const uint32_t message_count             = 200000;
+  uint32_t sent                            = 0;
+  uint8_t topic[]                          = "devices/device-1/messages/devicebound/";
+  uint8_t payload[64]                      = {};
+  sl_mqtt_client_message_t message         = {};
+  static const uint8_t filter[]            = "devices/device-1/messages/devicebound/#";
+  AzureIoTMQTTSubscribeInfo_t subscription = {};
+
+  subscription.pcTopicFilter       = filter;
+  subscription.usTopicFilterLength = sizeof(filter) - 1;
+  connect();
+  ASSERT_EQ(AzureIoTMQTT_Subscribe(&context, &subscription, 1, AzureIoTMQTT_GetPacketId(&context)),
+            eAzureIoTMQTTSuccess);
+  complete_all();
+  received_packets.clear();
+
+  auto start = std::chrono::steady_clock::now();
+  while (sent < message_count) {
+    while ((sent < message_count)
+           && (publish(eAzureIoTMQTTQoS1, AzureIoTMQTT_GetPacketId(&context)) == eAzureIoTMQTTSuccess)) {
+      sent++;
+    }
+    complete_all();
+  }
+  auto publish_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_EQ(received_packets.size(), message_count);
+
+  message.topic          = topic;
+  message.topic_length   = sizeof(topic) - 1;
+  message.content        = payload;
+  message.content_length = sizeof(payload);
+  start                  = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < message_count; i++) {
+    broker_message_handler(&context.xClient, &message, nullptr);
+  }
+  auto receive_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_EQ(received_publishes, message_count);
+
+  printf("[ BENCH    ] QoS 1 publish, window %d: %.0f msg/s\n",
+         azureiotmqttMAX_IN_FLIGHT,
+         message_count / publish_time);
+  printf("[ BENCH    ] Incoming publish: %.0f msg/s\n", message_count / receive_time);
+}
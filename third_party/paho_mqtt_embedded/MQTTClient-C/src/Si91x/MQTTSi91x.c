@@ -65,19 +65,53 @@ void InitTimer(Timer *timer)
   timer->end_time = 0;
 }
 
-static int mqtt_tcp_read(Network *n, unsigned char *buffer, int len, int timeout_ms)
+// Drops buffered data and the cached receive timeout, for a new connection
+static void mqtt_reset_rx_buffer(Network *n)
+{
+  n->rx_timeout_ms = -1;
+  n->rx_offset     = 0;
+  n->rx_length     = 0;
+}
+
+// Sets the socket receive timeout, unless the socket already has it
+static void mqtt_set_rx_timeout(Network *n, int timeout_ms)
 {
   struct timeval timeout;
+
+  if (n->rx_timeout_ms == timeout_ms) {
+    return;
+  }
   timeout.tv_sec  = timeout_ms / 1000;
   timeout.tv_usec = (timeout_ms % 1000) * 1000;
 
   // Set socket receive timeout
-  setsockopt(n->socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  int rc           = setsockopt(n->socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  n->rx_timeout_ms = (rc < 0) ? -1 : timeout_ms;
+}
 
+// Reads exactly len bytes unless the connection fails. Reads are served from the receive buffer, which is refilled
+// with one large receive, so the byte-wise reads of the packet header do not each go through the socket.
+static int mqtt_buffered_read(Network *n, unsigned char *buffer, int len, int timeout_ms)
+{
   int total_bytes_read = 0;
   while (total_bytes_read < len) {
+    int remaining = len - total_bytes_read;
+
+    if (n->rx_length > 0) {
+      int chunk = (remaining < n->rx_length) ? remaining : n->rx_length;
+      memcpy(&buffer[total_bytes_read], &n->rx_buffer[n->rx_offset], chunk);
+      n->rx_offset += (uint16_t)chunk;
+      n->rx_length -= (uint16_t)chunk;
+      total_bytes_read += chunk;
+      continue;
+    }
 
-    int rc = recv(n->socket, &buffer[total_bytes_read], (len - total_bytes_read), 0);
+    mqtt_set_rx_timeout(n, timeout_ms);
+
+    // Reads that would fill the whole buffer go straight to the caller instead of being copied twice
+    bool direct = (remaining >= MQTT_SI91X_RX_BUFFER_SIZE);
+    int rc      = direct ? recv(n->socket, &buffer[total_bytes_read], remaining, 0)
+                         : recv(n->socket, n->rx_buffer, MQTT_SI91X_RX_BUFFER_SIZE, 0);
     if (rc == -1) {
       if (errno != ENOTCONN && errno != ECONNRESET)
         total_bytes_read = -1;
@@ -85,12 +119,21 @@ static int mqtt_tcp_read(Network *n, unsigned char *buffer, int len, int timeout
     } else if (rc == 0) {
       total_bytes_read = 0;
       break;
-    } else
+    } else if (direct) {
       total_bytes_read += rc;
+    } else {
+      n->rx_offset = 0;
+      n->rx_length = (uint16_t)rc;
+    }
   }
   return total_bytes_read;
 }
 
+static int mqtt_tcp_read(Network *n, unsigned char *buffer, int len, int timeout_ms)
+{
+  return mqtt_buffered_read(n, buffer, len, timeout_ms);
+}
+
 static int mqtt_tcp_write(Network *n, unsigned char *buffer, int len, int timeout_ms)
 {
   UNUSED_PARAMETER(timeout_ms);
@@ -102,6 +145,7 @@ static void mqtt_tcp_disconnect(Network *n)
   if (n->socket >= 0) {
     close(n->socket);
   }
+  mqtt_reset_rx_buffer(n);
 }
 
 static int mqtt_tcpconnection_handler(Network *n, uint8_t flags, char *addr, int dst_port, int src_port, bool ssl)
@@ -111,6 +155,8 @@ static int mqtt_tcpconnection_handler(Network *n, uint8_t flags, char *addr, int
   int rc   = -1;
   int status;
 
+  mqtt_reset_rx_buffer(n);
+
 #ifdef SLI_SI91X_ENABLE_IPV6
   struct sockaddr_in6 server_address_v6 = { 0 };
   struct sockaddr_in6 clientAddr_v6     = { 0 };
@@ -200,14 +246,8 @@ static int mqtt_tcpconnection_handler(Network *n, uint8_t flags, char *addr, int
 
 static int mqtt_ws_read(Network *n, unsigned char *buffer, int len, int timeout_ms)
 {
-  struct timeval timeout;
-
-  timeout.tv_sec  = timeout_ms / 1000;
-  timeout.tv_usec = (timeout_ms % 1000) * 1000;
-
-  // Set socket receive timeout
-  setsockopt(n->socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
-  int bytes = recv(n->socket, buffer, len, 0);
+  // Every receive on the socket asks for more than the WebSocket header, as the firmware requires
+  int bytes = mqtt_buffered_read(n, buffer, len, timeout_ms);
   return (bytes < 0) ? -1 : bytes;
 }
 
@@ -231,10 +271,9 @@ static int mqtt_ws_write(Network *n, unsigned char *buffer, int len, int timeout
 
 static void mqtt_ws_disconnect(Network *n)
 {
-  UNUSED_PARAMETER(n);
-
   sl_websocket_close(&ws_handle);
   sl_websocket_deinit(&ws_handle);
+  mqtt_reset_rx_buffer(n);
 }
 
 static int mqtt_websocketconnection_handler(Network *n, uint8_t flags, char *addr, int dst_port, int src_port, bool ssl)
@@ -272,6 +311,7 @@ static int mqtt_websocketconnection_handler(Network *n, uint8_t flags, char *add
   }
 
   n->socket = ws_handle.socket_fd;
+  mqtt_reset_rx_buffer(n);
   return 0;
 }
 
@@ -282,6 +322,7 @@ void NetworkInit(Network *n)
     return;
 
   n->socket = -1;
+  mqtt_reset_rx_buffer(n);
 
   if (n->transport_type == MQTT_TRANSPORT_TCP) {
     n->mqttread   = mqtt_tcp_read;
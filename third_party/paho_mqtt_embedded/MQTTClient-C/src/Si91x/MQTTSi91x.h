@@ -39,6 +39,15 @@
 #define MQTT_TLS_AVAILABLE 1 // Set to 1 to enable TLS support, 0 to disable
 #endif
 
+// Size of the per-connection receive buffer that serves the small reads of the MQTT client
+#ifndef MQTT_SI91X_RX_BUFFER_SIZE
+#define MQTT_SI91X_RX_BUFFER_SIZE 256
+#endif
+
+#if (MQTT_SI91X_RX_BUFFER_SIZE <= MQTT_WITH_WEBSOCKET_HEADER_LEN) || (MQTT_SI91X_RX_BUFFER_SIZE > 65535)
+#error "MQTT_SI91X_RX_BUFFER_SIZE must be larger than MQTT_WITH_WEBSOCKET_HEADER_LEN and at most 65535"
+#endif
+
 typedef struct Timer Timer;
 struct Timer {
   uint32_t systick_period;
@@ -71,6 +80,11 @@ typedef enum { MQTT_TRANSPORT_TCP, MQTT_TRANSPORT_WEBSOCKET } mqtt_transport_t;
  *     - `MQTT_TRANSPORT_TCP`: Indicates that the connection uses TCP transport.
  *     - `MQTT_TRANSPORT_WEBSOCKET`: Indicates that the connection uses WebSocket transport.
  *
+ * - `rx_timeout_ms`, `rx_offset`, `rx_length` and `rx_buffer`: Receive buffer state, managed by the transport.
+ *   The client decodes a packet header one byte at a time, so reads are served from `rx_buffer`, which is
+ *   refilled with a single socket receive of up to `MQTT_SI91X_RX_BUFFER_SIZE` bytes. The receive timeout is
+ *   only set on the socket when it changes.
+ *
  * @note
  * - The `Network` structure must be initialized using the `NetworkInit` function before use.
  * - The transport-specific function pointers (`mqttread`, `mqttwrite`, and `disconnect`) are assigned
@@ -84,6 +98,10 @@ struct Network {
   int (*mqttwrite)(Network *, unsigned char *, int, int);
   void (*disconnect)(Network *);
   mqtt_transport_t transport_type;
+  int rx_timeout_ms;                                  // Receive timeout set on the socket, -1 if unknown
+  uint16_t rx_offset;                                 // Offset of the first unread byte in rx_buffer
+  uint16_t rx_length;                                 // Number of unread bytes in rx_buffer
+  unsigned char rx_buffer[MQTT_SI91X_RX_BUFFER_SIZE]; // Data received from the socket, not read by the client yet
 };
 
 uint32_t osKernelGetTickCount(void);
@@ -47,6 +47,24 @@
 #include "mbedtls/platform.h"
 #endif
 
+#if MQTT_LWIP_ALTCP_ENABLE
+#include "lwip/altcp.h"
+#include "lwip/altcp_tcp.h"
+#include "lwip/altcp_tls.h"
+#include "lwip/pbuf.h"
+#include "lwip/tcpip.h"
+
+#if !LWIP_ALTCP
+#error "MQTT_LWIP_ALTCP_ENABLE requires LWIP_ALTCP"
+#endif
+#if !LWIP_TCPIP_CORE_LOCKING
+#error "MQTT_LWIP_ALTCP_ENABLE requires LWIP_TCPIP_CORE_LOCKING"
+#endif
+
+#define MQTT_ALTCP_RX_EVENT (1U << 0)
+#define MQTT_ALTCP_TX_EVENT (1U << 1)
+#endif
+
 // Configuration
 #define MQTT_SOCKET_TIMEOUT_MS 30000
 #define MQTT_SEND_TIMEOUT_MS   10000
@@ -580,7 +598,7 @@ static int mqtt_tcpconnection_handler(Network *n,
 #endif
   } else {
     printf("TCP connection without SSL established\n");
-#ifdef MQTT_TLS_ENABLE
+#if MQTT_TLS_ENABLE
     n->tls = NULL;
 #endif
   }
@@ -588,12 +606,340 @@ static int mqtt_tcpconnection_handler(Network *n,
   return 0; // Success
 }
 
+#if MQTT_LWIP_ALTCP_ENABLE
+// altcp callbacks, called from the tcpip thread
+
+static err_t mqtt_altcp_connected_cb(void *arg, struct altcp_pcb *pcb, err_t err)
+{
+  Network *n = (Network *)arg;
+  UNUSED_PARAMETER(pcb);
+
+  n->altcp_state = (err == ERR_OK) ? MQTT_ALTCP_CONNECTED : MQTT_ALTCP_CLOSED;
+  osEventFlagsSet(n->events, MQTT_ALTCP_RX_EVENT | MQTT_ALTCP_TX_EVENT);
+  return ERR_OK;
+}
+
+static err_t mqtt_altcp_recv_cb(void *arg, struct altcp_pcb *pcb, struct pbuf *p, err_t err)
+{
+  Network *n = (Network *)arg;
+  UNUSED_PARAMETER(pcb);
+
+  if (p == NULL) {
+    // Connection closed by the peer
+    n->altcp_state = MQTT_ALTCP_CLOSED;
+    osEventFlagsSet(n->events, MQTT_ALTCP_RX_EVENT | MQTT_ALTCP_TX_EVENT);
+    return ERR_OK;
+  }
+  if (err != ERR_OK) {
+    pbuf_free(p);
+    return ERR_OK;
+  }
+
+  // Keep the pbufs as they are, the reader copies straight out of them. The window is only
+  // reopened with altcp_recved once the data has been read.
+  if (n->rx_pending == NULL) {
+    n->rx_pending = p;
+  } else {
+    pbuf_cat(n->rx_pending, p);
+  }
+  osEventFlagsSet(n->events, MQTT_ALTCP_RX_EVENT);
+  return ERR_OK;
+}
+
+static err_t mqtt_altcp_sent_cb(void *arg, struct altcp_pcb *pcb, u16_t len)
+{
+  Network *n = (Network *)arg;
+  UNUSED_PARAMETER(pcb);
+  UNUSED_PARAMETER(len);
+
+  osEventFlagsSet(n->events, MQTT_ALTCP_TX_EVENT);
+  return ERR_OK;
+}
+
+static void mqtt_altcp_err_cb(void *arg, err_t err)
+{
+  Network *n = (Network *)arg;
+
+  // The pcb has already been freed by the stack
+  SL_DEBUG_LOG("altcp connection error: %d\n", err);
+  n->pcb         = NULL;
+  n->altcp_state = MQTT_ALTCP_CLOSED;
+  osEventFlagsSet(n->events, MQTT_ALTCP_RX_EVENT | MQTT_ALTCP_TX_EVENT);
+}
+
+// Takes the data received since the last call and reopens the window for the data already read.
+// This is the only place the read path enters the stack.
+static void mqtt_altcp_take_rx(Network *n)
+{
+  LOCK_TCPIP_CORE();
+  if (n->pcb != NULL) {
+    while (n->rx_consumed > 0) {
+      u16_t len = (n->rx_consumed > 0xFFFF) ? 0xFFFF : (u16_t)n->rx_consumed;
+      altcp_recved(n->pcb, len);
+      n->rx_consumed -= len;
+    }
+  }
+  n->rx_consumed = 0;
+  n->rx_chain    = n->rx_pending;
+  n->rx_pending  = NULL;
+  UNLOCK_TCPIP_CORE();
+}
+
+static int mqtt_altcp_read(Network *n, unsigned char *buffer, int len, int timeout_ms)
+{
+  Timer timer;
+  int total_bytes_read = 0;
+
+  countdown_ms_mqtt(&timer, timeout_ms);
+  while (total_bytes_read < len) {
+    if (n->rx_chain == NULL) {
+      mqtt_altcp_take_rx(n);
+    }
+
+    if (n->rx_chain != NULL) {
+      u16_t copy_len = (u16_t)(((len - total_bytes_read) > 0xFFFF) ? 0xFFFF : (len - total_bytes_read));
+      u16_t copied   = pbuf_copy_partial(n->rx_chain, &buffer[total_bytes_read], copy_len, 0);
+
+      // Releases the pbufs that have been read completely
+      n->rx_chain = pbuf_free_header(n->rx_chain, copied);
+      n->rx_consumed += copied;
+      total_bytes_read += copied;
+      continue;
+    }
+
+    if (n->altcp_state != MQTT_ALTCP_CONNECTED) {
+      return (total_bytes_read > 0) ? total_bytes_read : -1;
+    }
+    if (expired(&timer)
+        || (osEventFlagsWait(n->events, MQTT_ALTCP_RX_EVENT, osFlagsWaitAny, left_ms_mqtt(&timer)) & osFlagsError)) {
+      break;
+    }
+  }
+
+  return total_bytes_read;
+}
+
+static int mqtt_altcp_write(Network *n, unsigned char *buffer, int len, int timeout_ms)
+{
+  Timer timer;
+  int total_bytes_written = 0;
+  // TLS encrypts into its own records, so only plain TCP has to copy the paho send buffer
+  u8_t apiflags = (n->tls_config != NULL) ? 0 : TCP_WRITE_FLAG_COPY;
+
+  countdown_ms_mqtt(&timer, timeout_ms);
+  while (total_bytes_written < len) {
+    err_t err = ERR_CONN;
+
+    LOCK_TCPIP_CORE();
+    if (n->pcb != NULL && n->altcp_state == MQTT_ALTCP_CONNECTED) {
+      int chunk = LWIP_MIN(len - total_bytes_written, altcp_sndbuf(n->pcb));
+
+      err = ERR_MEM;
+      if (chunk > 0) {
+        err = altcp_write(n->pcb, &buffer[total_bytes_written], (u16_t)chunk, apiflags);
+        if (err == ERR_OK) {
+          total_bytes_written += chunk;
+        }
+      }
+      if (err == ERR_MEM || total_bytes_written == len) {
+        // Push out what is queued, either to finish or to make room
+        altcp_output(n->pcb);
+      }
+    }
+    UNLOCK_TCPIP_CORE();
+
+    if (err == ERR_MEM) {
+      if (expired(&timer)
+          || (osEventFlagsWait(n->events, MQTT_ALTCP_TX_EVENT, osFlagsWaitAny, left_ms_mqtt(&timer)) & osFlagsError)) {
+        break;
+      }
+    } else if (err != ERR_OK) {
+      SL_DEBUG_LOG("altcp_write failed: %d\n", err);
+      return -1;
+    }
+  }
+
+  return total_bytes_written;
+}
+
+static void mqtt_altcp_disconnect(Network *n)
+{
+  LOCK_TCPIP_CORE();
+  if (n->pcb != NULL) {
+    altcp_arg(n->pcb, NULL);
+    altcp_recv(n->pcb, NULL);
+    altcp_sent(n->pcb, NULL);
+    altcp_err(n->pcb, NULL);
+    if (altcp_close(n->pcb) != ERR_OK) {
+      altcp_abort(n->pcb);
+    }
+    n->pcb = NULL;
+  }
+  if (n->rx_pending != NULL) {
+    pbuf_free(n->rx_pending);
+    n->rx_pending = NULL;
+  }
+  UNLOCK_TCPIP_CORE();
+
+  if (n->rx_chain != NULL) {
+    pbuf_free(n->rx_chain);
+    n->rx_chain = NULL;
+  }
+  n->rx_consumed = 0;
+  n->altcp_state = MQTT_ALTCP_DISCONNECTED;
+
+#if LWIP_ALTCP_TLS
+  if (n->tls_config != NULL) {
+    altcp_tls_free_config(n->tls_config);
+    n->tls_config = NULL;
+  }
+#endif
+
+  if (n->events != NULL) {
+    osEventFlagsDelete(n->events);
+    n->events = NULL;
+  }
+
+  printf("MQTT connection closed\n");
+}
+
+#if MQTT_TLS_ENABLE && LWIP_ALTCP_TLS
+// Creates the altcp TLS configuration from the certificates of n->tls, which is released afterwards
+static struct altcp_tls_config *mqtt_altcp_tls_config(Network *n)
+{
+  struct altcp_tls_config *config = NULL;
+  TLS_cert_ctx_t cert_ctx         = { 0 };
+
+  if (n->tls != NULL) {
+    cert_ctx = n->tls->cert_ctx;
+    free(n->tls);
+    n->tls = NULL;
+  }
+
+  if (cert_ctx.client_cert != NULL && cert_ctx.client_key != NULL) {
+    config = altcp_tls_create_config_client_2wayauth(cert_ctx.cacert,
+                                                     cert_ctx.cacert_len,
+                                                     cert_ctx.client_key,
+                                                     cert_ctx.client_key_len,
+                                                     NULL,
+                                                     0,
+                                                     cert_ctx.client_cert,
+                                                     cert_ctx.client_cert_len);
+  } else {
+    if (cert_ctx.cacert == NULL || cert_ctx.cacert_len == 0) {
+      printf("Warning: CA certificate not set - using verify none\n");
+    }
+    config = altcp_tls_create_config_client(cert_ctx.cacert, cert_ctx.cacert_len);
+  }
+  return config;
+}
+#endif
+
+static int mqtt_altcp_connection_handler(Network *n,
+                                         uint8_t flags,
+                                         char *addr,
+                                         uint32_t dst_port,
+                                         uint32_t src_port,
+                                         bool ssl)
+{
+  UNUSED_PARAMETER(flags);
+  UNUSED_PARAMETER(src_port);
+  ip_addr_t server_address;
+  err_t err = ERR_MEM;
+
+#ifdef SLI_SI91X_ENABLE_IPV6
+  u8_t ip_type = IPADDR_TYPE_V6;
+  ip_addr_set_zero_ip6(&server_address);
+  memcpy(ip_2_ip6(&server_address)->addr, addr, SL_IPV6_ADDRESS_LENGTH);
+#else
+  u8_t ip_type = IPADDR_TYPE_V4;
+  ip_addr_set_zero_ip4(&server_address);
+  memcpy(&ip_2_ip4(&server_address)->addr, addr, sizeof(ip_2_ip4(&server_address)->addr));
+#endif
+
+  n->events = osEventFlagsNew(NULL);
+  if (n->events == NULL) {
+    return -1;
+  }
+
+  if (ssl) {
+#if MQTT_TLS_ENABLE && LWIP_ALTCP_TLS
+    n->tls_config = mqtt_altcp_tls_config(n);
+    if (n->tls_config == NULL) {
+      printf("Failed to create altcp TLS configuration\n");
+      mqtt_altcp_disconnect(n);
+      return -1;
+    }
+#else
+    SL_DEBUG_LOG("ERROR: TLS requested but altcp TLS not available!\n");
+    mqtt_altcp_disconnect(n);
+    return -1;
+#endif
+  }
+
+  SL_DEBUG_LOG("Connecting to MQTT broker on port %ld\n", dst_port);
+  n->altcp_state = MQTT_ALTCP_CONNECTING;
+
+  LOCK_TCPIP_CORE();
+#if LWIP_ALTCP_TLS
+  if (n->tls_config != NULL) {
+    n->pcb = altcp_tls_new(n->tls_config, ip_type);
+  } else
+#endif
+  {
+    n->pcb = altcp_tcp_new_ip_type(ip_type);
+  }
+  if (n->pcb != NULL) {
+    altcp_arg(n->pcb, n);
+    altcp_recv(n->pcb, mqtt_altcp_recv_cb);
+    altcp_sent(n->pcb, mqtt_altcp_sent_cb);
+    altcp_err(n->pcb, mqtt_altcp_err_cb);
+    err = altcp_connect(n->pcb, &server_address, (u16_t)dst_port, mqtt_altcp_connected_cb);
+  }
+  UNLOCK_TCPIP_CORE();
+
+  if (err != ERR_OK) {
+    printf("\r\naltcp connect failed with error: %d\r\n", err);
+    mqtt_altcp_disconnect(n);
+    return -1;
+  }
+
+  // For TLS, the connected callback runs once the handshake is complete
+  osEventFlagsWait(n->events, MQTT_ALTCP_TX_EVENT, osFlagsWaitAny, MQTT_SOCKET_TIMEOUT_MS);
+  if (n->altcp_state != MQTT_ALTCP_CONNECTED) {
+    printf("\r\naltcp connection failed\r\n");
+    mqtt_altcp_disconnect(n);
+    return -1;
+  }
+
+  printf("%s connection established\n", ssl ? "TLS" : "TCP");
+  return 0;
+}
+#endif
+
 // Initialize the network structure
 void NetworkInit(Network *n)
 {
   if (n == NULL)
     return;
 
+#if MQTT_LWIP_ALTCP_ENABLE
+  if (n->transport_type == MQTT_TRANSPORT_ALTCP) {
+    n->socket      = -1;
+    n->pcb         = NULL;
+    n->tls_config  = NULL;
+    n->rx_pending  = NULL;
+    n->rx_chain    = NULL;
+    n->rx_consumed = 0;
+    n->events      = NULL;
+    n->altcp_state = MQTT_ALTCP_DISCONNECTED;
+    n->mqttread    = mqtt_altcp_read;
+    n->mqttwrite   = mqtt_altcp_write;
+    n->disconnect  = mqtt_altcp_disconnect;
+    return;
+  }
+#endif
+
   n->socket     = -1;
   n->mqttread   = mqtt_tcp_read;
   n->mqttwrite  = mqtt_tcp_write;
@@ -614,6 +960,10 @@ int NetworkConnect(Network *n, uint8_t flags, char *addr, int dst_port, int src_
 
   if (n->transport_type == MQTT_TRANSPORT_TCP) {
     return mqtt_tcpconnection_handler(n, flags, addr, dst_port, src_port, ssl);
+#if MQTT_LWIP_ALTCP_ENABLE
+  } else if (n->transport_type == MQTT_TRANSPORT_ALTCP) {
+    return mqtt_altcp_connection_handler(n, flags, addr, dst_port, src_port, ssl);
+#endif
   } else {
     return NETWORK_ERROR_INVALID_TYPE; // Error: invalid transport type
   }
@@ -27,6 +27,13 @@
 #define MQTT_TLS_ENABLE 1 // Set to 1 to enable TLS support, 0 to disable
 #endif
 
+// MQTT altcp transport configuration
+// Set to 1 to build MQTT_TRANSPORT_ALTCP, which runs on the lwIP altcp callback API instead of BSD sockets.
+// Requires LWIP_ALTCP, and LWIP_ALTCP_TLS with LWIP_ALTCP_TLS_MBEDTLS for TLS connections.
+#ifndef MQTT_LWIP_ALTCP_ENABLE
+#define MQTT_LWIP_ALTCP_ENABLE 0
+#endif
+
 // mbedTLS includes (only when TLS is enabled)
 #if MQTT_TLS_ENABLE
 #include "mbedtls/mbedtls_config.h"
@@ -91,7 +98,26 @@ struct Timer {
   uint32_t end_time;
 };
 
-typedef enum { MQTT_TRANSPORT_TCP, MQTT_TRANSPORT_WEBSOCKET } mqtt_transport_t;
+typedef enum {
+  MQTT_TRANSPORT_TCP,
+  MQTT_TRANSPORT_WEBSOCKET,
+#if MQTT_LWIP_ALTCP_ENABLE
+  MQTT_TRANSPORT_ALTCP,
+#endif
+} mqtt_transport_t;
+
+#if MQTT_LWIP_ALTCP_ENABLE
+struct altcp_pcb;
+struct altcp_tls_config;
+struct pbuf;
+
+typedef enum {
+  MQTT_ALTCP_DISCONNECTED,
+  MQTT_ALTCP_CONNECTING,
+  MQTT_ALTCP_CONNECTED,
+  MQTT_ALTCP_CLOSED, // Closed by the peer or aborted by the stack
+} mqtt_altcp_state_t;
+#endif
 
 /**
  * @brief Represents the network abstraction layer for MQTT communication.
@@ -116,11 +142,21 @@ typedef enum { MQTT_TRANSPORT_TCP, MQTT_TRANSPORT_WEBSOCKET } mqtt_transport_t;
  *   - Possible values:
  *     - `MQTT_TRANSPORT_TCP`: Indicates that the connection uses TCP transport.
  *     - `MQTT_TRANSPORT_WEBSOCKET`: Indicates that the connection uses WebSocket transport.
+ *     - `MQTT_TRANSPORT_ALTCP`: Indicates that the connection uses TCP, or TLS over TCP, on the lwIP altcp API.
+ *
+ * - altcp fields (`MQTT_LWIP_ALTCP_ENABLE` only):
+ *   - `pcb` and `tls_config` hold the altcp connection and its TLS configuration.
+ *   - `rx_pending` holds the pbufs delivered by the tcpip thread, `rx_chain` those taken by the reader.
+ *   - `rx_consumed` counts the bytes read but not yet acknowledged to the stack with `altcp_recved`.
+ *   - `events` is set by the tcpip thread callbacks to wake the reader and the writer.
  *
  * @note
  * - The `Network` structure must be initialized using the `NetworkInit` function before use.
  * - The transport-specific function pointers (`mqttread`, `mqttwrite`, and `disconnect`) are assigned
  *   during initialization based on the `transport_type`.
+ * - `MQTT_TRANSPORT_ALTCP` calls lwIP under the tcpip core lock, so it requires `LWIP_TCPIP_CORE_LOCKING`.
+ *   Received data is served to paho from the pbufs delivered by the stack, without a socket receive buffer
+ *   or a `select()` per read.
  */
 
 typedef struct Network Network;
@@ -133,6 +169,15 @@ struct Network {
 #if MQTT_TLS_ENABLE
   mqtt_tls_context_t *tls; // Pointer to TLS context if TLS is enabled
 #endif
+#if MQTT_LWIP_ALTCP_ENABLE
+  struct altcp_pcb *pcb;               // altcp connection, plain TCP or TLS over TCP
+  struct altcp_tls_config *tls_config; // altcp TLS configuration, NULL for plain TCP
+  struct pbuf *rx_pending;             // Received data not yet taken by the reader, owned by the tcpip thread
+  struct pbuf *rx_chain;               // Received data taken by the reader, read without the core lock
+  uint32_t rx_consumed;                // Bytes read from rx_chain and not yet passed to altcp_recved
+  osEventFlagsId_t events;             // MQTT_ALTCP_RX_EVENT and MQTT_ALTCP_TX_EVENT
+  volatile mqtt_altcp_state_t altcp_state;
+#endif
 };
 
 void InitTimer(Timer *);
@@ -157,6 +202,7 @@ int mqtt_set_tls_certificates(Network *n, TLS_cert_ctx_t *tls_config);
  * - Supported transport types are:
  *   - `MQTT_TRANSPORT_TCP`: Initializes for TCP transport.
  *   - `MQTT_TRANSPORT_WEBSOCKET`: Initializes for WebSocket transport.
+ *   - `MQTT_TRANSPORT_ALTCP`: Initializes for the altcp transport.
  *
  * @note
  * - Ensure that the `Network` structure is allocated and valid before calling this function.
@@ -186,6 +232,8 @@ void NetworkInit(Network *n);
  * - It delegates the connection logic to transport-specific handlers:
  *   - `mqtt_tcpconnection_handler` for TCP.
  *   - `mqtt_websocketconnection_handler` for WebSocket.
+ *   - `mqtt_altcp_connection_handler` for altcp. With `ssl`, the connection uses altcp_tls_mbedtls and
+ *     the certificates of `n->tls->cert_ctx`.
  * - SSL can be enabled for secure connections by setting the `ssl` parameter to `true`.
  *
  * @note
@@ -28,6 +28,8 @@
  *
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
 extern "C" {
 #include "MQTTSi91x_fake_functions.h"
 }
@@ -118,4 +120,137 @@ TEST(MQTTSi91x_unit_tests, CallsDisconnectFunction)
   NetworkDisconnect(&n);
   EXPECT_EQ(mqtt_fake_disconnect_fake.call_count, 1);
   EXPECT_EQ(mqtt_fake_disconnect_fake.arg0_val, &n);
-}
\ No newline at end of file
+}
+// --- Buffered read Tests ---
+// PUBLISH packet for topic "bench/topic" with a 17 byte payload
+static const unsigned char publish_packet[] = { 0x30, 30,  0,   11,  'b', 'e', 'n', 'c', 'h', '/', 't',
+                                                'o',  'p', 'i', 'c', 'p', 'a', 'y', 'l', 'o', 'a', 'd',
+                                                '-',  'b', 'e', 'n', 'c', 'h', 'm', 'a', 'r', 'k' };
+static size_t stream_offset;
+
+// Delivers an endless stream of PUBLISH packets, as much as fits in the buffer
+static ssize_t publish_stream_recv(int socket, void *buffer, size_t length, int flags)
+{
+  (void)socket;
+  (void)flags;
+  unsigned char *data = (unsigned char *)buffer;
+  for (size_t i = 0; i < length; i++) {
+    data[i]       = publish_packet[stream_offset];
+    stream_offset = (stream_offset + 1) % sizeof(publish_packet);
+  }
+  return (ssize_t)length;
+}
+
+// Reads a packet the way the MQTT client does: the header byte, each remaining length byte, then the rest
+static int read_packet(Network *n, unsigned char *packet)
+{
+  int len            = 1;
+  int rem_len        = 0;
+  int multiplier     = 1;
+  unsigned char byte = 0;
+
+  if (n->mqttread(n, packet, 1, 1000) != 1) {
+    return -1;
+  }
+  do {
+    if (n->mqttread(n, &byte, 1, SINGLE_PKT_TCP_STREAM_TIMEOUT) != 1) {
+      return -1;
+    }
+    packet[len++] = byte;
+    rem_len += (byte & 127) * multiplier;
+    multiplier *= 128;
+  } while (byte & 128);
+  if (rem_len > 0 && n->mqttread(n, packet + len, rem_len, SINGLE_PKT_TCP_STREAM_TIMEOUT) != rem_len) {
+    return -1;
+  }
+  return len + rem_len;
+}
+
+TEST(MQTTSi91x_unit_tests, TCP_SmallReadsServedFromBuffer)
+{
+  Network n;
+  memset(&n, 0, sizeof(n));
+  n.transport_type = MQTT_TRANSPORT_TCP;
+  NetworkInit(&n);
+  RESET_FAKE(recv);
+  RESET_FAKE(setsockopt);
+  recv_fake.custom_fake = publish_stream_recv;
+  stream_offset         = 0;
+
+  unsigned char packet[64];
+  for (int i = 0; i < 8; i++) {
+    ASSERT_EQ(read_packet(&n, packet), (int)sizeof(publish_packet));
+    EXPECT_EQ(memcmp(packet, publish_packet, sizeof(publish_packet)), 0);
+  }
+
+  // 8 packets of 32 bytes fill the buffer exactly, the timeout only changes between reads served from memory
+  EXPECT_EQ(recv_fake.call_count, 1);
+  EXPECT_EQ(setsockopt_fake.call_count, 1);
+  recv_fake.custom_fake = NULL;
+}
+
+TEST(MQTTSi91x_unit_tests, WebSocket_SmallReadsServedFromBuffer)
+{
+  Network n;
+  memset(&n, 0, sizeof(n));
+  n.transport_type = MQTT_TRANSPORT_WEBSOCKET;
+  NetworkInit(&n);
+  RESET_FAKE(recv);
+  recv_fake.custom_fake = publish_stream_recv;
+  stream_offset         = 0;
+
+  unsigned char packet[64];
+  ASSERT_EQ(read_packet(&n, packet), (int)sizeof(publish_packet));
+
+  // The socket is never asked for fewer bytes than the WebSocket header needs
+  EXPECT_EQ(recv_fake.call_count, 1);
+  EXPECT_GT(recv_fake.arg2_val, (size_t)MQTT_WITH_WEBSOCKET_HEADER_LEN);
+  recv_fake.custom_fake = NULL;
+}
+
+TEST(MQTTSi91x_unit_tests, TCP_PeerCloseReturnsZero)
+{
+  Network n;
+  memset(&n, 0, sizeof(n));
+  n.transport_type = MQTT_TRANSPORT_TCP;
+  NetworkInit(&n);
+  RESET_FAKE(recv);
+  recv_fake.return_val = 0;
+
+  unsigned char byte = 0;
+  EXPECT_EQ(n.mqttread(&n, &byte, 1, 1000), 0);
+}
+
+// Benchmark: decodes PUBLISH packets through the transport and reports messages per second and socket receives
+// per message. Only the receives are asserted, the rate depends on the machine running the tests.
+TEST(MQTTSi91x_unit_tests, Benchmark_PublishMessagesPerSecond)
+{
+  const int message_count = 100000;
+  Network n;
+  memset(&n, 0, sizeof(n));
+  n.transport_type = MQTT_TRANSPORT_TCP;
+  NetworkInit(&n);
+  RESET_FAKE(recv);
+  RESET_FAKE(setsockopt);
+  recv_fake.custom_fake = publish_stream_recv;
+  stream_offset         = 0;
+
+  unsigned char packet[64];
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < message_count; i++) {
+    ASSERT_EQ(read_packet(&n, packet), (int)sizeof(publish_packet));
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  double messages_per_second  = message_count / elapsed.count();
+  double receives_per_message = (double)recv_fake.call_count / message_count;
+  printf("[ BENCHMARK] %.0f messages/s, %.3f receives and %.3f setsockopt calls per message\n",
+         messages_per_second,
+         receives_per_message,
+         (double)setsockopt_fake.call_count / message_count);
+  RecordProperty("messages_per_second", (int)messages_per_second);
+
+  // Without the buffer, each message took 3 receives: header byte, remaining length byte and the rest
+  EXPECT_LT(receives_per_message, 0.2);
+  recv_fake.custom_fake = NULL;
+}
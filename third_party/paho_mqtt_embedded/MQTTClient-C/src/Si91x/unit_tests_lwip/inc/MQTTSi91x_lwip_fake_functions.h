@@ -4,6 +4,9 @@
 #include <stdint.h>
 #include "sl_status.h"
 #include "../../MQTTSi91x_lwip.h"
+#include "lwip/altcp.h"
+#include "lwip/sys.h"
+#include "lwip/tcpip.h"
 
 #define socklen_t int
 
@@ -50,6 +53,27 @@ DECLARE_FAKE_VALUE_FUNC1(uint16_t, lwip_htons, uint16_t);
 DECLARE_FAKE_VALUE_FUNC4(ssize_t, lwip_recv, int, void *, size_t, int);
 DECLARE_FAKE_VALUE_FUNC4(ssize_t, lwip_send, int, const void *, size_t, int);
 
+// altcp transport: tcpip core lock, event flags, altcp and pbuf functions
+DECLARE_FAKE_VOID_FUNC1(sys_mutex_lock, sys_mutex_t *);
+DECLARE_FAKE_VOID_FUNC1(sys_mutex_unlock, sys_mutex_t *);
+DECLARE_FAKE_VALUE_FUNC1(osEventFlagsId_t, osEventFlagsNew, const osEventFlagsAttr_t *);
+DECLARE_FAKE_VALUE_FUNC2(uint32_t, osEventFlagsSet, osEventFlagsId_t, uint32_t);
+DECLARE_FAKE_VALUE_FUNC4(uint32_t, osEventFlagsWait, osEventFlagsId_t, uint32_t, uint32_t, uint32_t);
+DECLARE_FAKE_VALUE_FUNC1(osStatus_t, osEventFlagsDelete, osEventFlagsId_t);
+DECLARE_FAKE_VALUE_FUNC1(struct altcp_pcb *, altcp_tcp_new_ip_type, u8_t);
+DECLARE_FAKE_VOID_FUNC2(altcp_arg, struct altcp_pcb *, void *);
+DECLARE_FAKE_VOID_FUNC2(altcp_recv, struct altcp_pcb *, altcp_recv_fn);
+DECLARE_FAKE_VOID_FUNC2(altcp_sent, struct altcp_pcb *, altcp_sent_fn);
+DECLARE_FAKE_VOID_FUNC2(altcp_err, struct altcp_pcb *, altcp_err_fn);
+DECLARE_FAKE_VALUE_FUNC4(err_t, altcp_connect, struct altcp_pcb *, const ip_addr_t *, u16_t, altcp_connected_fn);
+DECLARE_FAKE_VALUE_FUNC4(err_t, altcp_write, struct altcp_pcb *, const void *, u16_t, u8_t);
+DECLARE_FAKE_VALUE_FUNC1(err_t, altcp_output, struct altcp_pcb *);
+DECLARE_FAKE_VOID_FUNC2(altcp_recved, struct altcp_pcb *, u16_t);
+DECLARE_FAKE_VALUE_FUNC1(u16_t, altcp_sndbuf, struct altcp_pcb *);
+DECLARE_FAKE_VALUE_FUNC1(err_t, altcp_close, struct altcp_pcb *);
+DECLARE_FAKE_VOID_FUNC1(altcp_abort, struct altcp_pcb *);
+DECLARE_FAKE_VALUE_FUNC1(u8_t, pbuf_free, struct pbuf *);
+
 DECLARE_FAKE_VOID_FUNC1(mbedtls_ssl_config_init, mbedtls_ssl_config *);
 DECLARE_FAKE_VOID_FUNC1(mbedtls_x509_crt_init, mbedtls_x509_crt *);
 DECLARE_FAKE_VOID_FUNC1(mbedtls_ssl_init, mbedtls_ssl_context *);
@@ -3,6 +3,7 @@
  * @brief Fake/stub functions for MQTTSi91x_lwip unit tests
  ******************************************************************************/
 #include "MQTTSi91x_lwip_fake_functions.h"
+#include <string.h>
 
 DEFINE_FFF_GLOBALS;
 
@@ -31,6 +32,78 @@ DEFINE_FAKE_VALUE_FUNC1(uint16_t, lwip_htons, uint16_t);
 DEFINE_FAKE_VALUE_FUNC4(ssize_t, lwip_recv, int, void *, size_t, int);
 DEFINE_FAKE_VALUE_FUNC4(ssize_t, lwip_send, int, const void *, size_t, int);
 
+// altcp transport: tcpip core lock, event flags, altcp and pbuf functions
+sys_mutex_t lock_tcpip_core;
+DEFINE_FAKE_VOID_FUNC1(sys_mutex_lock, sys_mutex_t *);
+DEFINE_FAKE_VOID_FUNC1(sys_mutex_unlock, sys_mutex_t *);
+DEFINE_FAKE_VALUE_FUNC1(osEventFlagsId_t, osEventFlagsNew, const osEventFlagsAttr_t *);
+DEFINE_FAKE_VALUE_FUNC2(uint32_t, osEventFlagsSet, osEventFlagsId_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC4(uint32_t, osEventFlagsWait, osEventFlagsId_t, uint32_t, uint32_t, uint32_t);
+DEFINE_FAKE_VALUE_FUNC1(osStatus_t, osEventFlagsDelete, osEventFlagsId_t);
+DEFINE_FAKE_VALUE_FUNC1(struct altcp_pcb *, altcp_tcp_new_ip_type, u8_t);
+DEFINE_FAKE_VOID_FUNC2(altcp_arg, struct altcp_pcb *, void *);
+DEFINE_FAKE_VOID_FUNC2(altcp_recv, struct altcp_pcb *, altcp_recv_fn);
+DEFINE_FAKE_VOID_FUNC2(altcp_sent, struct altcp_pcb *, altcp_sent_fn);
+DEFINE_FAKE_VOID_FUNC2(altcp_err, struct altcp_pcb *, altcp_err_fn);
+DEFINE_FAKE_VALUE_FUNC4(err_t, altcp_connect, struct altcp_pcb *, const ip_addr_t *, u16_t, altcp_connected_fn);
+DEFINE_FAKE_VALUE_FUNC4(err_t, altcp_write, struct altcp_pcb *, const void *, u16_t, u8_t);
+DEFINE_FAKE_VALUE_FUNC1(err_t, altcp_output, struct altcp_pcb *);
+DEFINE_FAKE_VOID_FUNC2(altcp_recved, struct altcp_pcb *, u16_t);
+DEFINE_FAKE_VALUE_FUNC1(u16_t, altcp_sndbuf, struct altcp_pcb *);
+DEFINE_FAKE_VALUE_FUNC1(err_t, altcp_close, struct altcp_pcb *);
+DEFINE_FAKE_VOID_FUNC1(altcp_abort, struct altcp_pcb *);
+DEFINE_FAKE_VALUE_FUNC1(u8_t, pbuf_free, struct pbuf *);
+
+// Minimal pbuf chain handling, so tests can pass pbufs built on the stack through the transport
+void pbuf_cat(struct pbuf *head, struct pbuf *tail)
+{
+  struct pbuf *p;
+  for (p = head; p->next != NULL; p = p->next) {
+    p->tot_len = (u16_t)(p->tot_len + tail->tot_len);
+  }
+  p->tot_len = (u16_t)(p->tot_len + tail->tot_len);
+  p->next    = tail;
+}
+
+u16_t pbuf_copy_partial(const struct pbuf *buf, void *dataptr, u16_t len, u16_t offset)
+{
+  u16_t copied = 0;
+  for (const struct pbuf *p = buf; p != NULL && copied < len; p = p->next) {
+    if (offset >= p->len) {
+      offset = (u16_t)(offset - p->len);
+      continue;
+    }
+    u16_t chunk = (u16_t)(p->len - offset);
+    if (chunk > len - copied) {
+      chunk = (u16_t)(len - copied);
+    }
+    memcpy((u8_t *)dataptr + copied, (const u8_t *)p->payload + offset, chunk);
+    copied = (u16_t)(copied + chunk);
+    offset = 0;
+  }
+  return copied;
+}
+
+struct pbuf *pbuf_free_header(struct pbuf *q, u16_t size)
+{
+  struct pbuf *p = q;
+  while (p != NULL && size > 0) {
+    if (size >= p->len) {
+      struct pbuf *f = p;
+      size           = (u16_t)(size - p->len);
+      p              = p->next;
+      f->next        = NULL;
+      pbuf_free(f);
+    } else {
+      p->payload = (u8_t *)p->payload + size;
+      p->len     = (u16_t)(p->len - size);
+      p->tot_len = (u16_t)(p->tot_len - size);
+      size       = 0;
+    }
+  }
+  return p;
+}
+
 // mbedTLS functions (required by MQTTSi91x_lwip.c)
 DEFINE_FAKE_VOID_FUNC1(mbedtls_ssl_config_init, mbedtls_ssl_config *);
 DEFINE_FAKE_VOID_FUNC1(mbedtls_x509_crt_init, mbedtls_x509_crt *);
@@ -74,4 +74,243 @@ TEST(MQTTSi91x_lwip, CallsDisconnectFunction)
     NetworkDisconnect(&n);
     EXPECT_EQ(mqtt_fake_disconnect_fake.call_count, 1);
     EXPECT_EQ(mqtt_fake_disconnect_fake.arg0_val, &n);
+}
+
+// --- altcp transport Tests ---
+static struct altcp_pcb test_pcb;
+static int test_events;
+
+class MQTTSi91x_lwip_altcp : public ::testing::Test {
+protected:
+    Network n;
+
+    void SetUp() override
+    {
+        RESET_FAKE(sys_mutex_lock);
+        RESET_FAKE(sys_mutex_unlock);
+        RESET_FAKE(osEventFlagsNew);
+        RESET_FAKE(osEventFlagsSet);
+        RESET_FAKE(osEventFlagsWait);
+        RESET_FAKE(osEventFlagsDelete);
+        RESET_FAKE(altcp_tcp_new_ip_type);
+        RESET_FAKE(altcp_arg);
+        RESET_FAKE(altcp_recv);
+        RESET_FAKE(altcp_sent);
+        RESET_FAKE(altcp_err);
+        RESET_FAKE(altcp_connect);
+        RESET_FAKE(altcp_write);
+        RESET_FAKE(altcp_output);
+        RESET_FAKE(altcp_recved);
+        RESET_FAKE(altcp_sndbuf);
+        RESET_FAKE(altcp_close);
+        RESET_FAKE(altcp_abort);
+        RESET_FAKE(pbuf_free);
+        RESET_FAKE(sys_now);
+
+        osEventFlagsNew_fake.return_val       = (osEventFlagsId_t)&test_events;
+        altcp_tcp_new_ip_type_fake.return_val = &test_pcb;
+        altcp_connect_fake.custom_fake        = connect_and_complete;
+        altcp_sndbuf_fake.return_val          = 0xFFFF;
+
+        memset(&n, 0, sizeof(n));
+        n.transport_type = MQTT_TRANSPORT_ALTCP;
+        NetworkInit(&n);
+    }
+
+    void TearDown() override
+    {
+        n.rx_pending = NULL;
+        n.rx_chain   = NULL;
+        NetworkDisconnect(&n);
+    }
+
+    // Completes the connection from within altcp_connect, as the stack would from the tcpip thread
+    static err_t connect_and_complete(struct altcp_pcb *conn, const ip_addr_t *ipaddr, u16_t port, altcp_connected_fn connected)
+    {
+        (void)ipaddr;
+        (void)port;
+        return connected(altcp_arg_fake.arg1_val, conn, ERR_OK);
+    }
+
+    void connect_broker()
+    {
+        uint8_t addr[4] = { 192, 168, 0, 10 };
+        ASSERT_EQ(NetworkConnect(&n, 0, (char *)addr, 1883, 0, false), 0);
+    }
+
+    // Delivers a pbuf through the recv callback registered with altcp_recv
+    static void deliver(struct pbuf *p, const void *data, u16_t len)
+    {
+        memset(p, 0, sizeof(*p));
+        p->payload = (void *)data;
+        p->len     = len;
+        p->tot_len = p->len;
+        altcp_recv_fake.arg1_val(altcp_arg_fake.arg1_val, &test_pcb, p, ERR_OK);
+    }
+};
+
+TEST_F(MQTTSi91x_lwip_altcp, SetsAltcpFunctionPointers)
+{
+    Network tcp = {};
+    NetworkInit(&tcp);
+    EXPECT_NE(n.mqttread, tcp.mqttread);
+    EXPECT_NE(n.mqttwrite, tcp.mqttwrite);
+    EXPECT_NE(n.disconnect, tcp.disconnect);
+}
+
+TEST_F(MQTTSi91x_lwip_altcp, ConnectCompletesOnConnectedCallback)
+{
+    connect_broker();
+    EXPECT_EQ(n.altcp_state, MQTT_ALTCP_CONNECTED);
+    EXPECT_EQ(n.pcb, &test_pcb);
+    EXPECT_EQ(altcp_connect_fake.arg2_val, 1883);
+    EXPECT_EQ(altcp_recv_fake.call_count, 1);
+    EXPECT_EQ(sys_mutex_lock_fake.call_count, sys_mutex_unlock_fake.call_count);
+}
+
+TEST_F(MQTTSi91x_lwip_altcp, ConnectFailsWithoutConnectedCallback)
+{
+    uint8_t addr[4] = { 192, 168, 0, 10 };
+    altcp_connect_fake.custom_fake = NULL;
+    altcp_connect_fake.return_val  = ERR_OK;
+    EXPECT_EQ(NetworkConnect(&n, 0, (char *)addr, 1883, 0, false), -1);
+    EXPECT_EQ(altcp_close_fake.call_count, 1);
+    EXPECT_EQ(n.pcb, nullptr);
+}
+
+TEST_F(MQTTSi91x_lwip_altcp, ReadServesDataAcrossPbufs)
+{
+    struct pbuf first, second;
+    unsigned char buffer[8] = { 0 };
+    connect_broker();
+    deliver(&first, "ab", 2);
+    deliver(&second, "cdef", 4);
+
+    EXPECT_EQ(n.mqttread(&n, buffer, 1, 100), 1);
+    EXPECT_EQ(n.mqttread(&n, buffer + 1, 4, 100), 4);
+    EXPECT_EQ(memcmp(buffer, "abcde", 5), 0);
+    EXPECT_EQ(pbuf_free_fake.call_count, 1);
+
+    EXPECT_EQ(n.mqttread(&n, buffer + 5, 1, 100), 1);
+    EXPECT_EQ(pbuf_free_fake.call_count, 2);
+    EXPECT_EQ(n.rx_consumed, 6u);
+
+    // The window is reopened when the reader next goes back to the stack
+    osEventFlagsWait_fake.return_val = osFlagsErrorTimeout;
+    EXPECT_EQ(n.mqttread(&n, buffer, 1, 100), 0);
+    EXPECT_EQ(altcp_recved_fake.call_count, 1);
+    EXPECT_EQ(altcp_recved_fake.arg1_val, 6);
+}
+
+TEST_F(MQTTSi91x_lwip_altcp, ReadTimesOutWithoutData)
+{
+    unsigned char buffer[4];
+    connect_broker();
+    osEventFlagsWait_fake.return_val = osFlagsErrorTimeout;
+    EXPECT_EQ(n.mqttread(&n, buffer, sizeof(buffer), 100), 0);
+    EXPECT_EQ(osEventFlagsWait_fake.arg1_val, 1u);
+}
+
+TEST_F(MQTTSi91x_lwip_altcp, ReadFailsWhenPeerCloses)
+{
+    unsigned char buffer[4];
+    connect_broker();
+    altcp_recv_fake.arg1_val(altcp_arg_fake.arg1_val, &test_pcb, NULL, ERR_OK);
+    EXPECT_EQ(n.mqttread(&n, buffer, sizeof(buffer), 100), -1);
+}
+
+TEST_F(MQTTSi91x_lwip_altcp, WriteCopiesPlainTcpIntoStack)
+{
+    unsigned char packet[10] = { 0x30, 0x08 };
+    connect_broker();
+    EXPECT_EQ(n.mqttwrite(&n, packet, sizeof(packet), 100), 10);
+    EXPECT_EQ(altcp_write_fake.call_count, 1);
+    EXPECT_EQ(altcp_write_fake.arg2_val, 10);
+    EXPECT_EQ(altcp_write_fake.arg3_val, TCP_WRITE_FLAG_COPY);
+    EXPECT_EQ(altcp_output_fake.call_count, 1);
+}
+
+TEST_F(MQTTSi91x_lwip_altcp, WriteWaitsForSendBuffer)
+{
+    unsigned char packet[10] = { 0 };
+    u16_t sndbuf[]           = { 4, 0, 6 };
+    connect_broker();
+    SET_RETURN_SEQ(altcp_sndbuf, sndbuf, 3);
+    EXPECT_EQ(n.mqttwrite(&n, packet, sizeof(packet), 100), 10);
+    EXPECT_EQ(altcp_write_fake.call_count, 2);
+    EXPECT_EQ(osEventFlagsWait_fake.call_count, 2); // Connect and the full send buffer
+    EXPECT_EQ(altcp_output_fake.call_count, 2);
+}
+
+// --- tcpip thread messages per MQTT message ---
+// Each socket call below is a call into the tcpip thread, the altcp transport only enters it with the core lock.
+static const unsigned char bench_publish[] = { 0x32, 0x0C, 0x00, 0x03, 'a', '/', 'b', 0x00, 0x01, 'h', 'e', 'l', 'l', 'o' };
+static const unsigned char *bench_rx;
+static size_t bench_rx_left;
+
+static ssize_t bench_lwip_recv(int s, void *mem, size_t len, int flags)
+{
+    (void)s;
+    (void)flags;
+    if (bench_rx_left == 0) {
+        errno = EAGAIN;
+        return -1;
+    }
+    size_t chunk = (len < bench_rx_left) ? len : bench_rx_left;
+    memcpy(mem, bench_rx, chunk);
+    bench_rx += chunk;
+    bench_rx_left -= chunk;
+    return (ssize_t)chunk;
+}
+
+// Reads one PUBLISH the way paho's readPacket does and answers with a PUBACK
+static void bench_exchange(Network *n)
+{
+    unsigned char buffer[32];
+    unsigned char puback[] = { 0x40, 0x02, 0x00, 0x01 };
+    ASSERT_EQ(n->mqttread(n, buffer, 1, 100), 1);
+    ASSERT_EQ(n->mqttread(n, buffer + 1, 1, 100), 1);
+    ASSERT_EQ(n->mqttread(n, buffer + 2, buffer[1], 100), buffer[1]);
+    ASSERT_EQ(memcmp(buffer, bench_publish, sizeof(bench_publish)), 0);
+    ASSERT_EQ(n->mqttwrite(n, puback, sizeof(puback), 100), (int)sizeof(puback));
+}
+
+TEST_F(MQTTSi91x_lwip_altcp, BenchmarkTcpipMessagesPerMqttMessage)
+{
+    const int messages = 100;
+
+    // Socket transport
+    Network tcp = {};
+    NetworkInit(&tcp);
+    tcp.socket = 0;
+    RESET_FAKE(lwip_select);
+    RESET_FAKE(lwip_recv);
+    RESET_FAKE(lwip_send);
+    lwip_select_fake.return_val = 1;
+    lwip_recv_fake.custom_fake  = bench_lwip_recv;
+    lwip_send_fake.return_val   = 4;
+    for (int i = 0; i < messages; i++) {
+        bench_rx      = bench_publish;
+        bench_rx_left = sizeof(bench_publish);
+        bench_exchange(&tcp);
+    }
+    double socket_calls =
+      (double)(lwip_select_fake.call_count + lwip_recv_fake.call_count + lwip_send_fake.call_count) / messages;
+
+    // altcp transport
+    struct pbuf p;
+    connect_broker();
+    RESET_FAKE(sys_mutex_lock);
+    for (int i = 0; i < messages; i++) {
+        LOCK_TCPIP_CORE();
+        deliver(&p, bench_publish, sizeof(bench_publish));
+        UNLOCK_TCPIP_CORE();
+        bench_exchange(&n);
+    }
+    // Leave out the lock taken above on behalf of the tcpip thread
+    double altcp_calls = (double)(sys_mutex_lock_fake.call_count - messages) / messages;
+
+    printf("[ BENCH    ] tcpip thread calls per MQTT message: socket %.1f, altcp %.1f\n", socket_calls, altcp_calls);
+    EXPECT_LT(altcp_calls, socket_calls);
+    EXPECT_LE(altcp_calls, 2.0);
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 from json import load as jload
 from sys import argv
+import re
+import struct
 
 # for testing only
 def tostrbits(data):
@@ -215,11 +217,160 @@ class Decoder:
         return str(self.cum_tsf).zfill(6) + " " + info["debug_id"] + "(" + parsee + ")"
 
 
+class DeferredDecoder:
+    """
+    Decoder for records produced by the SL_DEBUG_LOG_DEFERRED backend.
+
+    Each record is a sequence of little endian 32-bit words: a header, the
+    address of the format string, a timestamp and the raw argument words.
+    Format strings, and strings passed with %s, are resolved by address from
+    the allocated sections of the application ELF (32-bit target assumed).
+    """
+
+    RECORD_MAGIC = 0xA5
+    RECORD_TRUNCATED = 1 << 23
+    HEADER_WORDS = 3
+    SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t)?([diouxXcpsfFeEgGaAn%])")
+
+    def __init__(self, elf_path):
+        self.sections = []
+        self.records = []
+        self._load_elf(elf_path)
+
+    def _load_elf(self, path):
+        """Collect the address ranges and contents of the allocated ELF sections"""
+        with open(path, "rb") as file:
+            elf = file.read()
+        if elf[:4] != b"\x7fELF" or elf[4] != 1:
+            raise ValueError("Expected a 32-bit ELF file.")
+        shoff, = struct.unpack_from("<I", elf, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", elf, 0x2E)
+        SHF_ALLOC = 0x2
+        SHT_NOBITS = 8
+        for index in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from("<IIIIII", elf, shoff + index * shentsize)
+            if flags & SHF_ALLOC and sh_type != SHT_NOBITS and size:
+                self.sections.append((addr, elf[offset : offset + size]))
+
+    def _string_at(self, address):
+        """Return the NUL terminated string stored at address, if it is in the image"""
+        for base, content in self.sections:
+            if base <= address < base + len(content):
+                start = address - base
+                end = content.find(b"\0", start)
+                return content[start : end if end >= 0 else len(content)].decode("ascii", "replace")
+        return None
+
+    def load_file_bin(self, path):
+        """Load raw records as written by sl_debug_log_deferred_output()"""
+        with open(path, "rb") as file:
+            self._split_records(file.read())
+
+    def load_file_ascii(self, path):
+        """Load possibly polluted console output from the default "#@D" sink"""
+        data = bytearray()
+        with open(path) as file:
+            for line in file.readlines():
+                spline = line.split()
+                if spline and spline[0] == "#@D":
+                    data.extend(int(byte, 16) for byte in spline[1:])
+        self._split_records(bytes(data))
+
+    def _split_records(self, data):
+        pos = 0
+        while pos + 4 * self.HEADER_WORDS <= len(data):
+            header, = struct.unpack_from("<I", data, pos)
+            length = header & 0xFF
+            if header >> 24 != self.RECORD_MAGIC or length < self.HEADER_WORDS:
+                # Resynchronise on the next word
+                pos += 4
+                continue
+            words = struct.unpack_from("<%dI" % length, data, pos)
+            self.records.append(words)
+            pos += 4 * length
+
+    def _format(self, fmt, args, truncated):
+        out = []
+        last = 0
+        for spec in self.SPEC.finditer(fmt):
+            out.append(fmt[last : spec.start()])
+            last = spec.end()
+            flags, width, precision, length, conversion = spec.groups()
+            if conversion == "%":
+                out.append("%")
+                continue
+            if width == "*":
+                width = str(struct.unpack("<i", struct.pack("<I", args.pop(0)))[0]) if args else ""
+            if precision == "*":
+                precision = str(struct.unpack("<i", struct.pack("<I", args.pop(0)))[0]) if args else ""
+            wide = length in ("ll", "j") or conversion in "fFeEgGaA"
+            if conversion == "n":
+                continue
+            if len(args) < (2 if wide else 1):
+                out.append("<truncated>" if truncated else "<missing>")
+                continue
+            value = args.pop(0)
+            if wide:
+                value |= args.pop(0) << 32
+            pyspec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+            if conversion in "di":
+                bits = 64 if wide else 32
+                if length == "h":
+                    bits = 16
+                elif length == "hh":
+                    bits = 8
+                value &= (1 << bits) - 1
+                value -= (value >> (bits - 1)) << bits
+                out.append((pyspec + "d") % value)
+            elif conversion in "ouxX":
+                if length == "h":
+                    value &= 0xFFFF
+                elif length == "hh":
+                    value &= 0xFF
+                out.append((pyspec + conversion) % value)
+            elif conversion == "c":
+                out.append((pyspec + "c") % chr(value & 0xFF))
+            elif conversion == "p":
+                out.append("0x%08x" % value)
+            elif conversion == "s":
+                string = self._string_at(value)
+                out.append((pyspec + "s") % (string if string is not None else "<0x%08x>" % value))
+            else:
+                number = struct.unpack("<d", struct.pack("<Q", value))[0]
+                out.append((pyspec + (conversion if conversion not in "aA" else "e")) % number)
+        out.append(fmt[last:])
+        return "".join(out)
+
+    def data_to_be_read(self):
+        """Return true if there are records to be read"""
+        return len(self.records) > 0
+
+    def read_next(self):
+        """Format the next record"""
+        words = self.records.pop(0)
+        header, fmt_address, timestamp = words[: self.HEADER_WORDS]
+        fmt = self._string_at(fmt_address)
+        if fmt is None:
+            return "%s <unknown format 0x%08x>" % (str(timestamp).zfill(6), fmt_address)
+        text = self._format(fmt, list(words[self.HEADER_WORDS :]), header & self.RECORD_TRUNCATED)
+        return str(timestamp).zfill(6) + " " + text.rstrip("\r\n")
+
+
 def main():
 
     argc = len(argv)
+    if argc == 4 and argv[1] == "--deferred":
+        decoder = DeferredDecoder(argv[2])
+        if argv[3].endswith(".bin"):
+            decoder.load_file_bin(argv[3])
+        else:
+            decoder.load_file_ascii(argv[3])
+        while decoder.data_to_be_read():
+            print(decoder.read_next())
+        return
     if argc != 2:
         print("Usage: python log_decoder.py path/to/dbgdata.txt")
+        print("       python log_decoder.py --deferred path/to/app.out path/to/capture.{txt,bin}")
         exit(0)
     decoder = Decoder()
     decoder.load_file_json("manifest.json")